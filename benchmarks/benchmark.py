@@ -38,6 +38,7 @@ class Benchmark:
         """
         self._N = None
         self._t = 0
+        self._samples = []
 
     def bench_setup(self, N):
         """Setup function for benchmark.
@@ -113,18 +114,21 @@ class Benchmark:
                 (Default value = 0).
 
         Returns:
-            float: The minimum time out of :code:`repeat` many calls to
-                :py:meth:`~.bench_run`.
+            float: The median time out of :code:`repeat` many calls to
+                :py:meth:`~.bench_run`. The time of each repetition is kept
+                in :code:`self._samples` for statistical comparisons.
         """
         # Initialize timer
         timer = self.setup_timer(N, num_threads)
 
         # Run benchmark
-        t = numpy.median(timer.repeat(repeat, number))
+        times = timer.repeat(repeat, number)
+        t = numpy.median(times)
 
         # Save results for later summarization
         self._N = N
         self._t = t / number
+        self._samples = [time / number for time in times]
         if print_stats:
             self.print_stats()
 
@@ -186,7 +190,9 @@ class Benchmark:
                 :py:meth:`~.bench_run` (Default value = 1).
 
         Returns:
-            list of float: A list of average runtimes following N (in seconds)
+            list of float: A list of average runtimes following N (in seconds).
+            The runtimes of all repetitions for each N are stored in
+            :code:`self.size_scale_samples`.
         """
         if len(N_list) == 0:
             raise TypeError("N_list must be iterable")
@@ -196,6 +202,7 @@ class Benchmark:
 
         # Loop over N and run the benchmarks
         results = []
+        self.size_scale_samples = []
         for N in N_list:
             if print_stats:
                 print(f"{N:10d}", end=": ")
@@ -204,6 +211,7 @@ class Benchmark:
             current_number = max(int(size // N), 1)
             t = self.run_benchmark(N, current_number, print_stats, repeat)
             results.append(t)
+            self.size_scale_samples.append(self._samples)
 
         return results
 
@@ -230,7 +238,9 @@ class Benchmark:
         Returns:
             :math:`(N_{cores}, len(N_{list}))` :class:`numpy.ndarray`:
                 All the per iteration timings with respect to the number of
-                cores used (in seconds).
+                cores used (in seconds). The runtimes of all repetitions are
+                stored in :code:`self.thread_scale_samples`, indexed in the
+                same way.
         """  # noqa: E501
         if len(N_list) == 0:
             raise TypeError("N_list must be iterable")
@@ -250,6 +260,7 @@ class Benchmark:
 
         # loop over the cores
         times = numpy.zeros(shape=(nprocs + 1, len(N_list)))
+        self.thread_scale_samples = [[[] for N in N_list] for _ in range(nprocs + 1)]
 
         for ncores in range(1, nprocs + 1, nproc_increment):
             if print_stats:
@@ -267,6 +278,7 @@ class Benchmark:
                         repeat=repeat,
                         num_threads=ncores,
                     )
+                self.thread_scale_samples[ncores][j] = self._samples
 
                 if print_stats:
                     speedup = times[1, j] / times[ncores, j]
@@ -0,0 +1,35 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkDensitySphereVoxelization(Benchmark):
+    def __init__(self, L, width, r_max):
+        self.L = L
+        self.width = width
+        self.r_max = r_max
+
+    def bench_setup(self, N):
+        self.box, self.points = freud.data.make_random_system(self.L, N, seed=0)
+        self.voxelization = freud.density.SphereVoxelization(self.width, self.r_max)
+
+    def bench_run(self, N):
+        self.voxelization.compute((self.box, self.points))
+
+
+def run():
+    Ns = [1000, 10000]
+    number = 10
+    name = "freud.density.SphereVoxelization"
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkDensitySphereVoxelization, L=10, width=100, r_max=0.5
+    )
+
+
+if __name__ == "__main__":
+    run()
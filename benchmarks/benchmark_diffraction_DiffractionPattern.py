@@ -0,0 +1,34 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkDiffractionDiffractionPattern(Benchmark):
+    def __init__(self, L, grid_size):
+        self.L = L
+        self.grid_size = grid_size
+
+    def bench_setup(self, N):
+        self.box, self.points = freud.data.make_random_system(self.L, N, seed=0)
+        self.dp = freud.diffraction.DiffractionPattern(grid_size=self.grid_size)
+
+    def bench_run(self, N):
+        self.dp.compute((self.box, self.points))
+
+
+def run():
+    Ns = [1000, 10000]
+    number = 10
+    name = "freud.diffraction.DiffractionPattern"
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkDiffractionDiffractionPattern, L=10, grid_size=512
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,40 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkDiffractionStaticStructureFactorDebye(Benchmark):
+    def __init__(self, L, num_k_values, k_max):
+        self.L = L
+        self.num_k_values = num_k_values
+        self.k_max = k_max
+
+    def bench_setup(self, N):
+        self.box, self.points = freud.data.make_random_system(self.L, N, seed=0)
+        self.sf = freud.diffraction.StaticStructureFactorDebye(
+            self.num_k_values, self.k_max
+        )
+
+    def bench_run(self, N):
+        self.sf.compute((self.box, self.points))
+        self.sf.S_k
+
+
+def run():
+    Ns = [1000, 5000]
+    number = 10
+    name = "freud.diffraction.StaticStructureFactorDebye"
+
+    kwargs = {"L": 10, "num_k_values": 100, "k_max": 10}
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkDiffractionStaticStructureFactorDebye, **kwargs
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,41 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkDiffractionStaticStructureFactorDirect(Benchmark):
+    def __init__(self, L, bins, k_max, num_sampled_k_points):
+        self.L = L
+        self.bins = bins
+        self.k_max = k_max
+        self.num_sampled_k_points = num_sampled_k_points
+
+    def bench_setup(self, N):
+        self.box, self.points = freud.data.make_random_system(self.L, N, seed=0)
+        self.sf = freud.diffraction.StaticStructureFactorDirect(
+            self.bins, self.k_max, num_sampled_k_points=self.num_sampled_k_points
+        )
+
+    def bench_run(self, N):
+        self.sf.compute((self.box, self.points))
+        self.sf.S_k
+
+
+def run():
+    Ns = [1000, 10000]
+    number = 10
+    name = "freud.diffraction.StaticStructureFactorDirect"
+
+    kwargs = {"L": 10, "bins": 100, "k_max": 10, "num_sampled_k_points": 10000}
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkDiffractionStaticStructureFactorDirect, **kwargs
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,47 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkEnvironmentEnvironmentCluster(Benchmark):
+    def __init__(self, sigma_noise, threshold, num_neighbors):
+        self.sigma_noise = sigma_noise
+        self.threshold = threshold
+        self.num_neighbors = num_neighbors
+
+    def bench_setup(self, N):
+        # Replicate an FCC unit cell (4 points) to about N points.
+        num_replicas = max(int(round((N / 4) ** (1 / 3))), 1)
+        self.box, self.points = freud.data.UnitCell.fcc().generate_system(
+            num_replicas, sigma_noise=self.sigma_noise, seed=0
+        )
+        self.env_cluster = freud.environment.EnvironmentCluster()
+
+    def bench_run(self, N):
+        neighbors = {"num_neighbors": self.num_neighbors}
+        self.env_cluster.compute(
+            (self.box, self.points),
+            self.threshold,
+            cluster_neighbors=neighbors,
+            env_neighbors=neighbors,
+        )
+
+
+def run():
+    Ns = [500, 4000]
+    number = 10
+    name = "freud.environment.EnvironmentCluster"
+
+    kwargs = {"sigma_noise": 0.01, "threshold": 0.2, "num_neighbors": 12}
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkEnvironmentEnvironmentCluster, **kwargs
+    )
+
+
+if __name__ == "__main__":
+    run()
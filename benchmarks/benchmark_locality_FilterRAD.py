@@ -0,0 +1,35 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkLocalityFilterRAD(Benchmark):
+    def __init__(self, density, r_max):
+        self.density = density
+        self.r_max = r_max
+
+    def bench_setup(self, N):
+        L = (N / self.density) ** (1 / 3)
+        self.box, self.points = freud.data.make_random_system(L, N, seed=0)
+        self.filt = freud.locality.FilterRAD(allow_incomplete_shell=True)
+
+    def bench_run(self, N):
+        self.filt.compute((self.box, self.points), neighbors={"r_max": self.r_max})
+
+
+def run():
+    Ns = [1000, 10000]
+    number = 10
+    name = "freud.locality.FilterRAD"
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkLocalityFilterRAD, density=1.0, r_max=2.5
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,32 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkLocalityVoronoi(Benchmark):
+    def __init__(self, density):
+        self.density = density
+
+    def bench_setup(self, N):
+        L = (N / self.density) ** (1 / 3)
+        self.box, self.points = freud.data.make_random_system(L, N, seed=0)
+        self.voro = freud.locality.Voronoi()
+
+    def bench_run(self, N):
+        self.voro.compute((self.box, self.points))
+
+
+def run():
+    Ns = [1000, 10000]
+    number = 10
+    name = "freud.locality.Voronoi"
+
+    return run_benchmarks(name, Ns, number, BenchmarkLocalityVoronoi, density=1.0)
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,37 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+import freud
+
+
+class BenchmarkOrderContinuousCoordination(Benchmark):
+    def __init__(self, density, powers):
+        self.density = density
+        self.powers = powers
+
+    def bench_setup(self, N):
+        L = (N / self.density) ** (1 / 3)
+        self.box, self.points = freud.data.make_random_system(L, N, seed=0)
+        self.coord = freud.order.ContinuousCoordination(self.powers)
+
+    def bench_run(self, N):
+        self.coord.compute((self.box, self.points))
+
+
+def run():
+    Ns = [1000, 10000]
+    number = 10
+    name = "freud.order.ContinuousCoordination"
+
+    kwargs = {"density": 1.0, "powers": [2.0, 4.0]}
+
+    return run_benchmarks(
+        name, Ns, number, BenchmarkOrderContinuousCoordination, **kwargs
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -5,6 +5,8 @@ import argparse
 import importlib
 import json
 import os
+import random
+import statistics
 import sys
 
 import git
@@ -103,6 +105,8 @@ def run_benchmarks(name, Ns, number, classobj, print_stats=True, **kwargs):
         "Ns": Ns,
         "size_scale": {N: r for N, r in zip(Ns, ssr)},
         "thread_scale": tsr.tolist(),
+        "size_scale_samples": {N: r for N, r in zip(Ns, b.size_scale_samples)},
+        "thread_scale_samples": b.thread_scale_samples,
     }
 
 
@@ -224,11 +228,50 @@ def save_comparison_result(rev_this, rev_other, slowers, fasters, sames):
     data["slowers"] = slowers
     data["fasters"] = fasters
     data["sames"] = sames
+    data["regressions"] = [info for info in slowers if info["regression"]]
     filename = get_report_filename("benchmark_comp.json")
     with open(filename, "w") as outfile:
         json.dump(data, outfile, indent=4)
 
 
+def bootstrap_speedup_interval(
+    this_samples, other_samples, confidence=0.95, num_resamples=1000, seed=0
+):
+    """Function to compute a confidence interval of a speedup.
+
+    The speedup is the ratio of the median runtimes of the other and this
+    revision. Its interval is estimated with the percentile bootstrap:
+    the runtimes of both revisions are resampled with replacement, and the
+    interval contains the central fraction :code:`confidence` of the speedups
+    of the resamples.
+
+    Args:
+        this_samples (list of float): Runtimes of this revision.
+        other_samples (list of float): Runtimes of the other revision.
+        confidence (float): Confidence level of the interval.
+        num_resamples (int): Number of bootstrap resamples.
+        seed (int): Seed of the random number generator, so that
+            comparisons are reproducible.
+
+    Returns:
+        tuple of float: Lower and upper bounds of the speedup, or
+            :code:`None` if either revision has fewer than two runtimes.
+
+    """
+    if len(this_samples) < 2 or len(other_samples) < 2:
+        return None
+    rng = random.Random(seed)
+    speedups = sorted(
+        statistics.median(rng.choices(other_samples, k=len(other_samples)))
+        / statistics.median(rng.choices(this_samples, k=len(this_samples)))
+        for _ in range(num_resamples)
+    )
+    alpha = (1 - confidence) / 2
+    lower = speedups[int(alpha * (num_resamples - 1))]
+    upper = speedups[int(round((1 - alpha) * (num_resamples - 1)))]
+    return lower, upper
+
+
 def list_benchmark_modules():
     """Function to list all benchmark modules.
 
@@ -269,10 +312,17 @@ def main_run(args):
 def main_compare(args):
     """Function to compare benchmark results.
 
+    The speedup of each benchmark is the ratio of the median runtimes of
+    rev_other and rev_this, reported with a bootstrap confidence interval when
+    the runtimes of the individual repetitions were recorded. A benchmark is
+    flagged as a regression if its speedup is below the threshold, and, if an
+    interval is available, the whole interval is below the threshold, so that
+    noisy measurements are not reported as regressions.
+
     Exits:
         1: If the runtime of any one result of rev_this is
             slower than that of the runtime of rev_other by
-            more than the threshold ratio.
+            more than the ratio given by --fail-above.
 
     Returns:
         None: If does not exit.
@@ -289,30 +339,98 @@ def main_compare(args):
     with open(filename) as infile:
         data = json.load(infile)
 
-    rev_this_benchmark = data[rev_this]
-    rev_other_benchmark = data[rev_other]
+    for rev, name in ((rev_this, rt), (rev_other, ro)):
+        if rev not in data:
+            print(
+                f"No results for {name} ({rev:6.6}) in {args.filename}. Check out "
+                "and build this revision, then run `benchmarker.py run`."
+            )
+            sys.exit(2)
+
+    slowers, fasters, sames = compare_benchmark_results(
+        data[rev_this], data[rev_other], rt, ro, args.threshold, args.confidence
+    )
+
+    save_comparison_result(rt, ro, slowers, fasters, sames)
+
+    regressions = [info for info in slowers if info["regression"]]
+    print(
+        f"\n{len(regressions)} regressions (speedup below {args.threshold} "
+        f"with {args.confidence:.0%} confidence)"
+    )
+    for info in regressions:
+        print("\t" + format_comparison(info))
+
+    # exit 1 if too slow
+    if args.fail_above is not None and slowers:
+        worst = max(1 / info["ratio"] for info in slowers)
+        if worst > args.fail_above:
+            print(
+                f"TOO SLOW: runtime ratio {worst:0.2f} of the slowest "
+                f"benchmark is beyond the threshold of {args.fail_above}"
+            )
+            sys.exit(1)
+
+
+def format_comparison(info):
+    """Function to format the comparison of one benchmark run.
+
+    Args:
+        info (dict): Comparison result of one benchmark run.
 
+    Returns:
+        str: Speedup with its confidence interval and the run parameters.
+
+    """
+    s = "{}, N: {}".format(info["name"], info["N"])
+    if "threads" in info:
+        s += ", threads: {}".format(info["threads"])
+    s += ", speedup: {:0.2f}".format(info["ratio"])
+    if info["ci"] is not None:
+        s += " [{:0.2f}, {:0.2f}]".format(*info["ci"])
+    if info["regression"]:
+        s += " REGRESSION"
+    return s
+
+
+def compare_benchmark_results(
+    this_results, other_results, rt, ro, threshold=0.7, confidence=0.95
+):
+    """Function to compare the results of two revisions.
+
+    Args:
+        this_results (list of dict): Benchmark results of this revision.
+        other_results (list of dict): Benchmark results of the other revision.
+        rt (str): Name of this revision.
+        ro (str): Name of the other revision.
+        threshold (float): Speedup below which a benchmark is a regression.
+        confidence (float): Confidence level of the speedup intervals.
+
+    Returns:
+        tuple of list of dict: Comparisons of the benchmark runs that are
+            slower, faster, and the same in this revision.
+
+    """
     # lists to store results
     slowers = []
     fasters = []
     sames = []
 
     # helper function to print and store results
-    def compare_helper(_this_t, _other_t, _N, _thread):
+    def compare_helper(_this_t, _other_t, _this_samples, _other_samples, _N, _thread):
         ratio = _other_t / _this_t
+        ci = bootstrap_speedup_interval(_this_samples, _other_samples, confidence)
         info = {
             "name": this_res["name"],
             "params": this_res["params"],
             "N": _N,
             "ratio": ratio,
+            "ci": ci,
+            "regression": ratio < threshold and (ci is None or ci[1] < threshold),
         }
         if _thread:
             info["threads"] = _thread
-            print(
-                "Threads: {}, N: {}, " "ratio: {:0.2f}".format(str(_thread), _N, ratio)
-            )
-        else:
-            print(f"N: {_N}, ratio: {ratio:0.2f}")
+        print(format_comparison(info))
 
         if ratio < 1:
             print(
@@ -328,47 +446,66 @@ def main_compare(args):
             print("\t{:6.6} and {:6.6} " "have the same speed".format(rt, ro))
             sames.append(info)
 
-    for this_res in rev_this_benchmark:
-        for other_res in rev_other_benchmark:
+    for this_res in this_results:
+        for other_res in other_results:
             if (
                 this_res["name"] == other_res["name"]
                 and this_res["params"] == other_res["params"]
             ):
                 print(benchmark_desc(this_res["name"], this_res["params"]))
-                print(
-                    "\nShowing runtime "
-                    "{:6.6} ({:6.6}) / "
-                    "{:6.6} ({:6.6})".format(ro, rev_other, rt, rev_this)
-                )
+                print(f"\nShowing runtime {ro:6.6} / {rt:6.6}")
                 print()
 
+                # Results saved before the runtimes of the repetitions were
+                # recorded have no samples, and are compared without intervals.
+                this_size_samples = this_res.get("size_scale_samples", {})
+                other_size_samples = other_res.get("size_scale_samples", {})
+                this_thread_samples = this_res.get("thread_scale_samples", [])
+                other_thread_samples = other_res.get("thread_scale_samples", [])
+
                 # compare size scaling behavior
                 for N in this_res["Ns"]:
                     N = str(N)
-                    this_t = this_res["size_scale"][N]
-                    other_t = other_res["size_scale"][N]
-                    compare_helper(this_t, other_t, N, None)
-
-                # compare thread scaling behavior
-                num_threads = len(this_res["thread_scale"]) - 1
+                    if N not in other_res["size_scale"]:
+                        continue
+                    compare_helper(
+                        this_res["size_scale"][N],
+                        other_res["size_scale"][N],
+                        this_size_samples.get(N, []),
+                        other_size_samples.get(N, []),
+                        N,
+                        None,
+                    )
+
+                # compare thread scaling behavior, for the numbers of threads
+                # that both revisions were run with
+                num_threads = (
+                    min(len(this_res["thread_scale"]), len(other_res["thread_scale"]))
+                    - 1
+                )
                 for i in range(1, num_threads + 1):
                     for j, N in enumerate(this_res["Ns"]):
+                        if N not in other_res["Ns"]:
+                            continue
+                        k = other_res["Ns"].index(N)
                         this_t = this_res["thread_scale"][i][j]
-                        other_t = other_res["thread_scale"][i][j]
-                        compare_helper(this_t, other_t, N, i)
+                        other_t = other_res["thread_scale"][i][k]
+                        # Numbers of threads skipped by
+                        # BENCHMARK_NPROC_INCREMENT have no runtime.
+                        if this_t == 0 or other_t == 0:
+                            continue
+                        compare_helper(
+                            this_t,
+                            other_t,
+                            this_thread_samples[i][j] if this_thread_samples else [],
+                            other_thread_samples[i][k] if other_thread_samples else [],
+                            N,
+                            i,
+                        )
 
                 print("\n ----------------")
 
-    save_comparison_result(rt, ro, slowers, fasters, sames)
-
-    # exit 1 if too slow
-    threshold = 0.70
-    for info in slowers:
-        if info["ratio"] < threshold:
-            desc = benchmark_desc(info["name"], info["params"])
-            print(f"TOO SLOW (beyond threshold of {threshold})")
-            print("\t" + desc)
-            print("\t\tratio = {}".format(info["ratio"]))
+    return slowers, fasters, sames
 
 
 if __name__ == "__main__":
@@ -448,6 +585,21 @@ if __name__ == "__main__":
         "the worst tested category between this and the other revision "
         "is above this value.",
     )
+    parser_compare.add_argument(
+        "-t",
+        "--threshold",
+        type=float,
+        default=0.7,
+        help="Flag benchmarks as regressions if their speedup and its "
+        "confidence interval are below this value, default=0.7.",
+    )
+    parser_compare.add_argument(
+        "-c",
+        "--confidence",
+        type=float,
+        default=0.95,
+        help="Confidence level of the speedup intervals, default=0.95.",
+    )
     parser_compare.set_defaults(func=main_compare)
 
     args = parser.parse_args()
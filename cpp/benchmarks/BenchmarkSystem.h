@@ -0,0 +1,68 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BENCHMARK_SYSTEM_H
+#define BENCHMARK_SYSTEM_H
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Box.h"
+#include "VectorMath.h"
+#include "tbb_config.h"
+
+/*! \file BenchmarkSystem.h
+    \brief Systems and parameters shared by the C++ benchmarks.
+*/
+
+namespace freud { namespace benchmarks {
+
+//! Points placed uniformly at random in a cubic box.
+struct RandomSystem
+{
+    //! Constructor
+    /*! \param n_points Number of points.
+     *  \param density Number density of the points.
+     *  \param seed Seed of the random number generator.
+     */
+    explicit RandomSystem(unsigned int n_points, float density = 1, unsigned int seed = 0)
+        : box(std::cbrt(static_cast<float>(n_points) / density)), points(n_points)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> fractional(0, 1);
+        for (auto& point : points)
+        {
+            point = box.makeAbsolute(vec3<float>(fractional(rng), fractional(rng), fractional(rng)));
+        }
+    }
+
+    box::Box box;                    //!< Simulation box.
+    std::vector<vec3<float>> points; //!< Point positions.
+};
+
+//! Run benchmarks over numbers of points and numbers of threads.
+/*! The first argument of each run is the number of points, and the second
+ *  one the number of threads, which benchmarks apply with an
+ *  ExecutionContext. Thread counts are powers of two up to the number of
+ *  threads available. Times are wall clock times, since the CPU time of the
+ *  benchmark thread does not include the work of the other threads.
+ */
+inline void sizesAndThreads(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"N", "threads"});
+    for (const int n_points : {1 << 10, 1 << 14, 1 << 17})
+    {
+        for (int threads = 1; threads <= parallel::maxConcurrency(); threads *= 2)
+        {
+            b->Args({n_points, threads});
+        }
+    }
+    b->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+}
+
+}; }; // end namespace freud::benchmarks
+
+#endif // BENCHMARK_SYSTEM_H
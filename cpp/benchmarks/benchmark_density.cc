@@ -0,0 +1,49 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include "BenchmarkSystem.h"
+#include "GaussianDensity.h"
+#include "RawPoints.h"
+
+/*! \file benchmark_density.cc
+    \brief Benchmarks of density computations.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Number of grid points along each dimension of the density grid.
+constexpr unsigned int GRID_WIDTH = 64;
+
+void computeGaussianDensity(benchmark::State& state, bool use_fft)
+{
+    const RandomSystem system(state.range(0));
+    const parallel::ExecutionContext context(state.range(1));
+    const locality::RawPoints points(system.box, system.points.data(), system.points.size());
+    density::GaussianDensity gaussian_density(vec3<unsigned int>(GRID_WIDTH, GRID_WIDTH, GRID_WIDTH), 3, 1,
+                                              use_fft);
+    for (auto _ : state)
+    {
+        gaussian_density.compute(&points);
+        benchmark::DoNotOptimize(gaussian_density.getDensity().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_GaussianDensity(benchmark::State& state)
+{
+    computeGaussianDensity(state, false);
+}
+
+void BM_GaussianDensity_fft(benchmark::State& state)
+{
+    computeGaussianDensity(state, true);
+}
+
+} // namespace
+
+BENCHMARK(BM_GaussianDensity)->Apply(sizesAndThreads);
+BENCHMARK(BM_GaussianDensity_fft)->Apply(sizesAndThreads);
+
+}; }; // end namespace freud::benchmarks
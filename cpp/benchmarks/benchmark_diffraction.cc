@@ -0,0 +1,53 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include "BenchmarkSystem.h"
+#include "RawPoints.h"
+#include "StaticStructureFactorDirect.h"
+
+/*! \file benchmark_diffraction.cc
+    \brief Benchmarks of diffraction computations.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Number of k-vectors sampled, so that the time is dominated by computing F(k).
+constexpr unsigned int NUM_SAMPLED_K_POINTS = 10000;
+
+//! Number of grid points per dimension of the particle mesh.
+constexpr unsigned int MESH_GRID_SIZE = 64;
+
+void computeStaticStructureFactorDirect(benchmark::State& state, unsigned int grid_size)
+{
+    const RandomSystem system(state.range(0));
+    const parallel::ExecutionContext context(state.range(1));
+    const locality::RawPoints points(system.box, system.points.data(), system.points.size());
+    diffraction::StaticStructureFactorDirect structure_factor(100, 10, 0, NUM_SAMPLED_K_POINTS, grid_size);
+    for (auto _ : state)
+    {
+        // The k-vectors are sampled once, when the box is first seen.
+        structure_factor.accumulate(&points, system.points.data(), system.points.size(),
+                                    system.points.size());
+        benchmark::DoNotOptimize(structure_factor.getStructureFactor().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StaticStructureFactorDirect(benchmark::State& state)
+{
+    computeStaticStructureFactorDirect(state, 0);
+}
+
+void BM_StaticStructureFactorDirect_mesh(benchmark::State& state)
+{
+    computeStaticStructureFactorDirect(state, MESH_GRID_SIZE);
+}
+
+} // namespace
+
+BENCHMARK(BM_StaticStructureFactorDirect)->Apply(sizesAndThreads);
+BENCHMARK(BM_StaticStructureFactorDirect_mesh)->Apply(sizesAndThreads);
+
+}; }; // end namespace freud::benchmarks
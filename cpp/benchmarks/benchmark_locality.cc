@@ -0,0 +1,111 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <memory>
+
+#include "AABBQuery.h"
+#include "BenchmarkSystem.h"
+#include "LinkCell.h"
+#include "NeighborList.h"
+
+/*! \file benchmark_locality.cc
+    \brief Benchmarks of building and querying neighbor finding structures.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Cutoff of ball queries, enclosing about 34 neighbors at unit density.
+constexpr float BALL_R_MAX = 2;
+
+//! Number of neighbors of nearest neighbor queries.
+constexpr unsigned int NUM_NEIGHBORS = 12;
+
+template<typename NeighborQueryType> void buildNeighborQuery(benchmark::State& state)
+{
+    const RandomSystem system(state.range(0));
+    const parallel::ExecutionContext context(state.range(1));
+    for (auto _ : state)
+    {
+        NeighborQueryType neighbor_query(system.box, system.points.data(), system.points.size());
+        benchmark::DoNotOptimize(&neighbor_query);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename NeighborQueryType>
+void queryNeighborList(benchmark::State& state, const locality::QueryArgs& qargs)
+{
+    const RandomSystem system(state.range(0));
+    const parallel::ExecutionContext context(state.range(1));
+    const NeighborQueryType neighbor_query(system.box, system.points.data(), system.points.size());
+    size_t num_bonds = 0;
+    for (auto _ : state)
+    {
+        const std::unique_ptr<locality::NeighborList> nlist(
+            neighbor_query.query(system.points.data(), system.points.size(), qargs)->toNeighborList());
+        num_bonds = nlist->getNumBonds();
+    }
+    state.counters["bonds"] = static_cast<double>(num_bonds);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+locality::QueryArgs ballQuery()
+{
+    locality::QueryArgs qargs;
+    qargs.mode = locality::QueryType::ball;
+    qargs.r_max = BALL_R_MAX;
+    qargs.exclude_ii = true;
+    return qargs;
+}
+
+locality::QueryArgs nearestQuery()
+{
+    locality::QueryArgs qargs;
+    qargs.mode = locality::QueryType::nearest;
+    qargs.num_neighbors = NUM_NEIGHBORS;
+    qargs.exclude_ii = true;
+    return qargs;
+}
+
+void BM_AABBQuery_build(benchmark::State& state)
+{
+    buildNeighborQuery<locality::AABBQuery>(state);
+}
+
+void BM_LinkCell_build(benchmark::State& state)
+{
+    buildNeighborQuery<locality::LinkCell>(state);
+}
+
+void BM_AABBQuery_ball(benchmark::State& state)
+{
+    queryNeighborList<locality::AABBQuery>(state, ballQuery());
+}
+
+void BM_LinkCell_ball(benchmark::State& state)
+{
+    queryNeighborList<locality::LinkCell>(state, ballQuery());
+}
+
+void BM_AABBQuery_nearest(benchmark::State& state)
+{
+    queryNeighborList<locality::AABBQuery>(state, nearestQuery());
+}
+
+void BM_LinkCell_nearest(benchmark::State& state)
+{
+    queryNeighborList<locality::LinkCell>(state, nearestQuery());
+}
+
+} // namespace
+
+BENCHMARK(BM_AABBQuery_build)->Apply(sizesAndThreads);
+BENCHMARK(BM_LinkCell_build)->Apply(sizesAndThreads);
+BENCHMARK(BM_AABBQuery_ball)->Apply(sizesAndThreads);
+BENCHMARK(BM_LinkCell_ball)->Apply(sizesAndThreads);
+BENCHMARK(BM_AABBQuery_nearest)->Apply(sizesAndThreads);
+BENCHMARK(BM_LinkCell_nearest)->Apply(sizesAndThreads);
+
+}; }; // end namespace freud::benchmarks
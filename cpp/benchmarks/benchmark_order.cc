@@ -0,0 +1,55 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <vector>
+
+#include "AABBQuery.h"
+#include "BenchmarkSystem.h"
+#include "Steinhardt.h"
+
+/*! \file benchmark_order.cc
+    \brief Benchmarks of order parameters.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Cutoff of the neighbors of each point, about the first shell of a dense liquid.
+constexpr float STEINHARDT_R_MAX = 1.5;
+
+void computeSteinhardt(benchmark::State& state, order::Steinhardt& steinhardt)
+{
+    const RandomSystem system(state.range(0));
+    const parallel::ExecutionContext context(state.range(1));
+    const locality::AABBQuery neighbor_query(system.box, system.points.data(), system.points.size());
+    locality::QueryArgs qargs;
+    qargs.mode = locality::QueryType::ball;
+    qargs.r_max = STEINHARDT_R_MAX;
+    qargs.exclude_ii = true;
+    for (auto _ : state)
+    {
+        steinhardt.compute(nullptr, &neighbor_query, qargs);
+        benchmark::DoNotOptimize(steinhardt.getParticleOrder().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Steinhardt_ql(benchmark::State& state)
+{
+    order::Steinhardt steinhardt(6);
+    computeSteinhardt(state, steinhardt);
+}
+
+void BM_Steinhardt_wl_average(benchmark::State& state)
+{
+    order::Steinhardt steinhardt(std::vector<unsigned int> {4, 6, 8}, true, true);
+    computeSteinhardt(state, steinhardt);
+}
+
+} // namespace
+
+BENCHMARK(BM_Steinhardt_ql)->Apply(sizesAndThreads);
+BENCHMARK(BM_Steinhardt_wl_average)->Apply(sizesAndThreads);
+
+}; }; // end namespace freud::benchmarks
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BenchmarkSystem.h"
+#include "Histogram.h"
+#include "ThreadStorage.h"
+#include "utils.h"
+
+/*! \file benchmark_util.cc
+    \brief Benchmarks of histogram binning and reductions over threads.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Number of bins of the benchmarked histograms and arrays.
+constexpr size_t NUM_BINS = 1000;
+
+//! Number of values binned per point, about the number of bonds of a point in an RDF.
+constexpr size_t VALUES_PER_POINT = 32;
+
+void BM_Histogram_bin(benchmark::State& state)
+{
+    const size_t num_values = state.range(0) * VALUES_PER_POINT;
+    const parallel::ExecutionContext context(state.range(1));
+    std::vector<float> values(num_values);
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> distribution(0, 1);
+    for (auto& value : values)
+    {
+        value = distribution(rng);
+    }
+
+    util::Histogram<unsigned int> histogram(
+        util::Axes {std::make_shared<util::RegularAxis>(NUM_BINS, float(0), float(1))});
+    util::Histogram<unsigned int>::ThreadLocalHistogram local_histograms(histogram);
+    for (auto _ : state)
+    {
+        util::forLoopWrapper(0, num_values, [&](size_t begin, size_t end) {
+            auto& local_histogram = local_histograms.local();
+            for (size_t i = begin; i < end; ++i)
+            {
+                local_histogram(values[i]);
+            }
+        });
+        histogram.reduceOverThreads(local_histograms);
+        benchmark::DoNotOptimize(histogram.getBinCounts().get());
+    }
+    state.SetItemsProcessed(state.iterations() * num_values);
+}
+
+void BM_ThreadStorage_reduceInto(benchmark::State& state)
+{
+    // Each thread accumulates into an array with one element per point.
+    const size_t size = state.range(0);
+    const parallel::ExecutionContext context(state.range(1));
+    util::ThreadStorage<float> local_arrays(size);
+    util::ManagedArray<float> result(size);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        local_arrays.reset();
+        util::forLoopWrapper(0, size, [&](size_t begin, size_t end) {
+            auto& local_array = local_arrays.local();
+            for (size_t i = begin; i < end; ++i)
+            {
+                local_array[i] += 1;
+            }
+        });
+        state.ResumeTiming();
+        local_arrays.reduceInto(result);
+        benchmark::DoNotOptimize(result.get());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+} // namespace
+
+BENCHMARK(BM_Histogram_bin)->Apply(sizesAndThreads);
+BENCHMARK(BM_ThreadStorage_reduceInto)->Apply(sizesAndThreads);
+
+}; }; // end namespace freud::benchmarks
@@ -4,11 +4,14 @@
 #ifndef BOX_H
 #define BOX_H
 
+#include "CPUDispatch.h"
 #include "utils.h"
 #include <algorithm>
+#include <cmath>
 #include <complex>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 #include "VectorMath.h"
 
@@ -23,6 +26,21 @@ constexpr float TWO_PI = 2.0 * M_PI;
 
 namespace freud { namespace box {
 
+//! Compile-time description of the type of a box.
+/*! \tparam Dim Number of dimensions of the box, 2 or 3.
+ *  \tparam IsOrthorhombic Whether all tilt factors of the box are zero.
+ *
+ *  Box::withBoxTraits calls a function with the traits of a box, and the
+ *  coordinate methods of Box templated on the traits skip the terms that
+ *  vanish for that type of box.
+ */
+template<unsigned int Dim, bool IsOrthorhombic> struct BoxTraits
+{
+    static constexpr unsigned int dimensions = Dim;
+    static constexpr bool is_2d = (Dim == 2);
+    static constexpr bool is_orthorhombic = IsOrthorhombic;
+};
+
 //! Stores box dimensions and provides common routines for wrapping vectors back into the box
 /*! Box stores a standard HOOMD simulation box that goes from -L/2 to L/2 in each dimension, allowing Lx, Ly,
  Lz, and triclinic tilt factors xy, xz, and yz to be specified independently.
@@ -214,14 +232,9 @@ public:
      */
     vec3<float> makeAbsolute(const vec3<float>& f) const
     {
-        vec3<float> v = m_lo + f * m_L;
-        v.x += m_xy * v.y + m_xz * v.z;
-        v.y += m_yz * v.z;
-        if (m_2d)
-        {
-            v.z = float(0.0);
-        }
-        return v;
+        return withBoxTraits([&](auto traits) {
+            return makeAbsolute<decltype(traits)>(f);
+        });
     }
 
     //! Convert fractional coordinates into absolute coordinates in place
@@ -229,14 +242,21 @@ public:
      *         parallelepipedal box
      *  \param Nvecs Number of vectors
      *  \param out The array in which to place the wrapped vectors.
+     *  \param grain_size Minimum number of vectors processed by each task.
      */
-    void makeAbsolute(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
-    {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = makeAbsolute(vecs[i]);
-            }
+    void makeAbsolute(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out,
+                      size_t grain_size = util::CHEAP_LOOP_GRAIN_SIZE) const
+    {
+        withBoxTraits([&](auto traits) {
+            util::forLoopWrapper(
+                0, Nvecs,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        out[i] = makeAbsolute<decltype(traits)>(vecs[i]);
+                    }
+                },
+                util::LoopSchedule {grain_size});
         });
     }
 
@@ -246,30 +266,30 @@ public:
      */
     vec3<float> makeFractional(const vec3<float>& v) const
     {
-        vec3<float> delta = v - m_lo;
-        delta.x -= (m_xz - m_yz * m_xy) * v.z + m_xy * v.y;
-        delta.y -= m_yz * v.z;
-        delta = delta / m_L;
-
-        if (m_2d)
-        {
-            delta.z = float(0.0);
-        }
-        return delta;
+        return withBoxTraits([&](auto traits) {
+            return makeFractional<decltype(traits)>(v);
+        });
     }
 
     //! Convert point coordinates from absolute to fractional box coordinates.
     /*! \param vecs Vectors to convert
      *  \param Nvecs Number of vectors
      *  \param out The array in which to place the wrapped vectors.
+     *  \param grain_size Minimum number of vectors processed by each task.
      */
-    void makeFractional(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
-    {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = makeFractional(vecs[i]);
-            }
+    void makeFractional(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out,
+                        size_t grain_size = util::CHEAP_LOOP_GRAIN_SIZE) const
+    {
+        withBoxTraits([&](auto traits) {
+            util::forLoopWrapper(
+                0, Nvecs,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        out[i] = makeFractional<decltype(traits)>(vecs[i]);
+                    }
+                },
+                util::LoopSchedule {grain_size});
         });
     }
 
@@ -279,28 +299,30 @@ public:
      */
     inline void getImage(const vec3<float>& v, vec3<int>& image) const
     {
-        vec3<float> f = makeFractional(v) - vec3<float>(0.5, 0.5, 0.5);
-        if (m_2d)
-        {
-            f.z = float(0.0);
-        }
-        image.x = (int) ((f.x >= float(0.0)) ? f.x + float(0.5) : f.x - float(0.5));
-        image.y = (int) ((f.y >= float(0.0)) ? f.y + float(0.5) : f.y - float(0.5));
-        image.z = (int) ((f.z >= float(0.0)) ? f.z + float(0.5) : f.z - float(0.5));
+        withBoxTraits([&](auto traits) {
+            getImage<decltype(traits)>(v, image);
+        });
     }
 
     //! Get the periodic image vectors belongs to
     /*! \param vecs The vectors to check
      *  \param Nvecs Number of vectors
         \param res Array to save the images
+     *  \param grain_size Minimum number of vectors processed by each task.
      */
-    void getImages(vec3<float>* vecs, unsigned int Nvecs, vec3<int>* res) const
-    {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                getImage(vecs[i], res[i]);
-            }
+    void getImages(vec3<float>* vecs, unsigned int Nvecs, vec3<int>* res,
+                   size_t grain_size = util::CHEAP_LOOP_GRAIN_SIZE) const
+    {
+        withBoxTraits([&](auto traits) {
+            util::forLoopWrapper(
+                0, Nvecs,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        getImage<decltype(traits)>(vecs[i], res[i]);
+                    }
+                },
+                util::LoopSchedule {grain_size});
         });
     }
 
@@ -310,40 +332,32 @@ public:
      */
     vec3<float> wrap(const vec3<float>& v) const
     {
-        // Return quickly if the box is aperiodic
-        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
-        {
-            return v;
-        }
-
-        vec3<float> v_frac = makeFractional(v);
-        if (m_periodic.x)
-        {
-            v_frac.x = util::modulusPositive(v_frac.x, float(1.0));
-        }
-        if (m_periodic.y)
-        {
-            v_frac.y = util::modulusPositive(v_frac.y, float(1.0));
-        }
-        if (m_periodic.z)
-        {
-            v_frac.z = util::modulusPositive(v_frac.z, float(1.0));
-        }
-        return makeAbsolute(v_frac);
+        return withBoxTraits([&](auto traits) {
+            return wrap<decltype(traits)>(v);
+        });
     }
 
     //! Wrap vectors back into the box in place
     /*! \param vecs Vectors to wrap, updated to the minimum image obeying the periodic settings
      *  \param Nvecs Number of vectors
      *  \param out The array in which to place the wrapped vectors.
+     *  \param grain_size Minimum number of vectors processed by each task.
      */
-    void wrap(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
-    {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = wrap(vecs[i]);
-            }
+    void wrap(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out,
+              size_t grain_size = util::CHEAP_LOOP_GRAIN_SIZE) const
+    {
+        withBoxTraits([&](auto traits) {
+            util::forLoopWrapper(
+                0, Nvecs,
+                [&](size_t begin, size_t end) {
+                    util::dispatch([&]() FREUD_KERNEL {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            out[i] = wrap<decltype(traits)>(vecs[i]);
+                        }
+                    });
+                },
+                util::LoopSchedule {grain_size});
         });
     }
 
@@ -352,20 +366,25 @@ public:
      *  \param images images flags for this point
         \param Nvecs Number of vectors
      *  \param out The array in which to place the wrapped vectors.
+     *  \param grain_size Minimum number of vectors processed by each task.
     */
-    void unwrap(const vec3<float>* vecs, const vec3<int>* images, unsigned int Nvecs, vec3<float>* out) const
+    void unwrap(const vec3<float>* vecs, const vec3<int>* images, unsigned int Nvecs, vec3<float>* out,
+                size_t grain_size = util::CHEAP_LOOP_GRAIN_SIZE) const
     {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = vecs[i] + getLatticeVector(0) * float(images[i].x)
-                    + getLatticeVector(1) * float(images[i].y);
-                if (!m_2d)
+        util::forLoopWrapper(
+            0, Nvecs,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
                 {
-                    out[i] += getLatticeVector(2) * float(images[i].z);
+                    out[i] = vecs[i] + getLatticeVector(0) * float(images[i].x)
+                        + getLatticeVector(1) * float(images[i].y);
+                    if (!m_2d)
+                    {
+                        out[i] += getLatticeVector(2) * float(images[i].z);
+                    }
                 }
-            }
-        });
+            },
+            util::LoopSchedule {grain_size});
     }
 
     //! Compute center of mass for vectors
@@ -418,8 +437,9 @@ public:
     */
     inline float computeDistance(const vec3<float>& r_i, const vec3<float>& r_j) const
     {
-        const vec3<float> r_ij = wrap(r_j - r_i);
-        return std::sqrt(dot(r_ij, r_ij));
+        return withBoxTraits([&](auto traits) {
+            return computeDistance<decltype(traits)>(r_i, r_j);
+        });
     }
 
     //! Calculate distances between a set of query points and points.
@@ -437,11 +457,14 @@ public:
         {
             throw std::invalid_argument("The number of query points and points must match.");
         }
-        util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                distances[i] = computeDistance(query_points[i], points[i]);
-            }
+        withBoxTraits([&](auto traits) {
+            util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    distances[i] = computeDistance<decltype(traits)>(
+                        query_points[i], points[i]);
+                }
+            });
         });
     }
 
@@ -456,16 +479,110 @@ public:
     void computeAllDistances(const vec3<float>* query_points, const unsigned int n_query_points,
                              const vec3<float>* points, const unsigned int n_points, float* distances) const
     {
-        util::forLoopWrapper2D(
-            0, n_query_points, 0, n_points, [&](size_t begin_n, size_t end_n, size_t begin_m, size_t end_m) {
+        withBoxTraits([&](auto traits) {
+            const auto compute_block = [&](size_t begin_n, size_t end_n, size_t begin_m, size_t end_m) {
                 for (size_t i = begin_n; i < end_n; ++i)
                 {
                     for (size_t j = begin_m; j < end_m; ++j)
                     {
-                        distances[i * n_points + j] = computeDistance(query_points[i], points[j]);
+                        distances[i * n_points + j]
+                            = computeDistance<decltype(traits)>(
+                                query_points[i], points[j]);
                     }
                 }
-            });
+            };
+            util::forLoopWrapper2D(0, n_query_points, 0, n_points, compute_block);
+        });
+    }
+
+    //! Call a function with the BoxTraits of this box.
+    /*! Kernels that are templated on BoxTraits call this once at the compute
+     *  boundary, so the box type is a compile-time constant in their loops:
+     *  the tilt terms of orthorhombic boxes and the z terms of 2D boxes
+     *  vanish, and the loop bodies are free of branches on the box type.
+     */
+    template<typename Function>
+    auto withBoxTraits(const Function& function) const -> decltype(function(BoxTraits<3, true>()))
+    {
+        const bool orthorhombic = (m_xy == 0 && m_xz == 0 && m_yz == 0);
+        if (m_2d)
+        {
+            return orthorhombic ? function(BoxTraits<2, true>()) : function(BoxTraits<2, false>());
+        }
+        return orthorhombic ? function(BoxTraits<3, true>()) : function(BoxTraits<3, false>());
+    }
+
+    //! Convert fractional coordinates into absolute coordinates for a box with the given BoxTraits.
+    template<typename Traits> vec3<float> makeAbsolute(const vec3<float>& f) const
+    {
+        vec3<float> v = m_lo + f * m_L;
+        if (!Traits::is_orthorhombic)
+        {
+            v.x += m_xy * v.y + m_xz * v.z;
+            v.y += m_yz * v.z;
+        }
+        if (Traits::is_2d)
+        {
+            v.z = float(0.0);
+        }
+        return v;
+    }
+
+    //! Convert absolute coordinates into fractional coordinates for a box with the given BoxTraits.
+    template<typename Traits> vec3<float> makeFractional(const vec3<float>& v) const
+    {
+        vec3<float> delta = v - m_lo;
+        if (!Traits::is_orthorhombic)
+        {
+            delta.x -= (m_xz - m_yz * m_xy) * v.z + m_xy * v.y;
+            delta.y -= m_yz * v.z;
+        }
+        delta.x /= m_L.x;
+        delta.y /= m_L.y;
+        delta.z = Traits::is_2d ? float(0.0) : delta.z / m_L.z;
+        return delta;
+    }
+
+    //! Get the periodic image of a vector for a box with the given BoxTraits.
+    template<typename Traits> void getImage(const vec3<float>& v, vec3<int>& image) const
+    {
+        const vec3<float> f = makeFractional<Traits>(v) - vec3<float>(0.5, 0.5, 0.5);
+        image.x = (int) ((f.x >= float(0.0)) ? f.x + float(0.5) : f.x - float(0.5));
+        image.y = (int) ((f.y >= float(0.0)) ? f.y + float(0.5) : f.y - float(0.5));
+        image.z = Traits::is_2d ? 0 : (int) ((f.z >= float(0.0)) ? f.z + float(0.5) : f.z - float(0.5));
+    }
+
+    //! Wrap a vector back into a box with the given BoxTraits.
+    template<typename Traits> vec3<float> wrap(const vec3<float>& v) const
+    {
+        // Return quickly if the box is aperiodic
+        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
+        {
+            return v;
+        }
+
+        vec3<float> v_frac = makeFractional<Traits>(v);
+        if (m_periodic.x)
+        {
+            v_frac.x = wrapFractional(v_frac.x);
+        }
+        if (m_periodic.y)
+        {
+            v_frac.y = wrapFractional(v_frac.y);
+        }
+        if (!Traits::is_2d && m_periodic.z)
+        {
+            v_frac.z = wrapFractional(v_frac.z);
+        }
+        return makeAbsolute<Traits>(v_frac);
+    }
+
+    //! Calculate the distance between two points for a box with the given BoxTraits.
+    template<typename Traits>
+    float computeDistance(const vec3<float>& r_i, const vec3<float>& r_j) const
+    {
+        const vec3<float> r_ij = wrap<Traits>(r_j - r_i);
+        return std::sqrt(dot(r_ij, r_ij));
     }
 
     //! Get mask of points that fit inside the box.
@@ -597,6 +714,22 @@ public:
     }
 
 private:
+    //! Wrap a fractional coordinate into [0, 1).
+    /*! This returns exactly util::modulusPositive(f, 1), but f - trunc(f)
+     *  replaces the inner std::fmod call, which is exact for floats, and the
+     *  outer one only has to handle a sum in (0, 2].
+     */
+    static float wrapFractional(float f)
+    {
+        const float shifted = (f - std::trunc(f)) + float(1.0);
+        if (shifted >= float(1.0))
+        {
+            return (shifted >= float(2.0)) ? float(0.0) : shifted - float(1.0);
+        }
+        return shifted;
+    }
+
+
     vec3<float> m_lo;      //!< Minimum coords in the box
     vec3<float> m_hi;      //!< Maximum coords in the box
     vec3<float> m_L;       //!< L precomputed (used to avoid subtractions in boundary conditions)
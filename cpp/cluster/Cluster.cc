@@ -3,15 +3,25 @@
 
 #include <algorithm>
 #include <numeric>
+#include <tbb/parallel_sort.h>
+#include <utility>
 
 #include "Cluster.h"
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
 #include "dset/dset.h"
+#include "utils.h"
 
 //! Finds clusters using a network of neighbors.
 namespace freud { namespace cluster {
 
+namespace {
+
+//! Number of consecutive sorted points processed by each task when labeling clusters.
+constexpr size_t CLUSTER_BLOCK_SIZE = 4096;
+
+} // namespace
+
 void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
                       freud::locality::QueryArgs qargs, const unsigned int* keys)
 {
@@ -19,75 +29,111 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
     m_cluster_idx.prepare(num_points);
     DisjointSets dj(num_points);
 
+    // The disjoint sets are lock-free, so bonds are merged concurrently.
     freud::locality::loopOverNeighbors(
         nq, nq->getPoints(), num_points, qargs, nlist,
         [&dj](const freud::locality::NeighborBond& neighbor_bond) {
             // Merge the two sets using the disjoint set
-            if (!dj.same(neighbor_bond.getPointIdx(), neighbor_bond.getQueryPointIdx()))
-            {
-                dj.unite(neighbor_bond.getPointIdx(), neighbor_bond.getQueryPointIdx());
-            }
+            dj.unite(neighbor_bond.getPointIdx(), neighbor_bond.getQueryPointIdx());
         });
 
     // Done looping over points. All clusters are now determined.
-    // Next, we renumber clusters from zero to num_clusters-1.
-    // These new cluster indexes are then sorted by cluster size from largest
-    // to smallest, with equally-sized clusters sorted based on their minimum
-    // point index.
-    std::vector<size_t> cluster_label(num_points, num_points);
-    std::vector<size_t> cluster_label_count(num_points);
-    std::vector<size_t> cluster_min_id(num_points, num_points);
-
-    // Loop over every point.
-    m_num_clusters = 0;
-    for (size_t i = 0; i < num_points; i++)
-    {
-        size_t s = dj.find(i);
-
-        // Label this cluster if we haven't seen it yet.
-        if (cluster_label[s] == num_points)
+    // Next, the points are sorted by the root of their set and then by their
+    // index, so the points of each cluster are contiguous and the first point
+    // of each cluster is its minimum point index.
+    std::vector<std::pair<unsigned int, unsigned int>> sorted_points(num_points);
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
         {
-            // Label this cluster uniquely.
-            cluster_label[s] = m_num_clusters;
-            // Track the smallest point index in this cluster.
-            cluster_min_id[cluster_label[s]] = i;
-            // Increment the count of unique clusters.
-            m_num_clusters++;
+            sorted_points[i] = {dj.find(i), i};
         }
+    });
+    parallel::execute([&]() { tbb::parallel_sort(sorted_points.begin(), sorted_points.end()); });
+
+    // Count the clusters starting in each block of sorted points, so the
+    // clusters can be numbered in parallel in the order of their roots.
+    const auto is_cluster_begin = [&sorted_points](size_t k) {
+        return k == 0 || sorted_points[k].first != sorted_points[k - 1].first;
+    };
+    const size_t num_blocks = (num_points + CLUSTER_BLOCK_SIZE - 1) / CLUSTER_BLOCK_SIZE;
+    std::vector<size_t> block_offsets(num_blocks + 1, 0);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            const size_t block_end = std::min((block + 1) * CLUSTER_BLOCK_SIZE, size_t(num_points));
+            for (size_t k = block * CLUSTER_BLOCK_SIZE; k < block_end; ++k)
+            {
+                block_offsets[block + 1] += static_cast<size_t>(is_cluster_begin(k));
+            }
+        }
+    });
+    std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+    m_num_clusters = block_offsets[num_blocks];
 
-        // Increment the counter for this cluster label.
-        cluster_label_count[cluster_label[s]]++;
-    }
-
-    // Resize label counts and min ids to the number of unique clusters found.
-    cluster_label_count.resize(m_num_clusters);
-    cluster_label_count.shrink_to_fit();
-    cluster_min_id.resize(m_num_clusters);
-    cluster_min_id.shrink_to_fit();
+    // Find the range of sorted points of each cluster.
+    std::vector<size_t> cluster_begin(m_num_clusters + 1, num_points);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            const size_t block_end = std::min((block + 1) * CLUSTER_BLOCK_SIZE, size_t(num_points));
+            size_t cluster = block_offsets[block];
+            for (size_t k = block * CLUSTER_BLOCK_SIZE; k < block_end; ++k)
+            {
+                if (is_cluster_begin(k))
+                {
+                    cluster_begin[cluster++] = k;
+                }
+            }
+        }
+    });
 
-    // Get a permutation that reorders clusters, largest to smallest.
-    std::vector<size_t> cluster_reindex = sort_indexes_inverse(cluster_label_count, cluster_min_id);
+    // These cluster indexes are then sorted by cluster size from largest to
+    // smallest, with equally-sized clusters sorted based on their minimum
+    // point index.
+    std::vector<size_t> cluster_sizes(m_num_clusters);
+    std::vector<size_t> cluster_min_ids(m_num_clusters);
+    util::forLoopWrapper(0, m_num_clusters, [&](size_t begin, size_t end) {
+        for (size_t cluster = begin; cluster < end; ++cluster)
+        {
+            cluster_sizes[cluster] = cluster_begin[cluster + 1] - cluster_begin[cluster];
+            cluster_min_ids[cluster] = sorted_points[cluster_begin[cluster]].second;
+        }
+    });
+    std::vector<size_t> cluster_reindex = sort_indexes_inverse(cluster_sizes, cluster_min_ids);
 
     // Clear the cluster keys
     m_cluster_keys = std::vector<std::vector<unsigned int>>(m_num_clusters, std::vector<unsigned int>());
+    util::forLoopWrapper(0, m_num_clusters, [&](size_t begin, size_t end) {
+        for (size_t cluster = begin; cluster < end; ++cluster)
+        {
+            m_cluster_keys[cluster_reindex[cluster]].resize(cluster_sizes[cluster]);
+        }
+    });
 
-    /* Loop over all points, set their cluster ids and add them to a list of
-     * sets. Each set contains all the keys that are part of that cluster. If
-     * no keys are provided, the keys use point ids. Get the computed list
-     * with getClusterKeys().
+    /* Loop over all sorted points, set their cluster ids and add them to a
+     * list of sets. Each set contains all the keys that are part of that
+     * cluster, in the order of the point ids. If no keys are provided, the
+     * keys use point ids. Get the computed list with getClusterKeys().
      */
-    for (size_t i = 0; i < num_points; i++)
-    {
-        size_t s = dj.find(i);
-        size_t cluster_idx = cluster_reindex[cluster_label[s]];
-        m_cluster_idx[i] = cluster_idx;
-        unsigned int key = i;
-        if (keys != nullptr)
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
         {
-            key = keys[i];
+            const size_t block_end = std::min((block + 1) * CLUSTER_BLOCK_SIZE, size_t(num_points));
+            // The cluster containing the sorted point before this block.
+            size_t cluster = block_offsets[block] - 1;
+            for (size_t k = block * CLUSTER_BLOCK_SIZE; k < block_end; ++k)
+            {
+                if (is_cluster_begin(k))
+                {
+                    ++cluster;
+                }
+                const unsigned int i = sorted_points[k].second;
+                const size_t cluster_idx = cluster_reindex[cluster];
+                m_cluster_idx[i] = cluster_idx;
+                m_cluster_keys[cluster_idx][k - cluster_begin[cluster]] = (keys != nullptr) ? keys[i] : i;
+            }
         }
-        m_cluster_keys[cluster_idx].push_back(key);
-    }
+    });
 }
 
 // Returns inverse permutation of cluster indexes, sorted from largest to smallest.
@@ -100,23 +146,27 @@ std::vector<size_t> Cluster::sort_indexes_inverse(const std::vector<size_t>& cou
     std::iota(idx.begin(), idx.end(), 0);
 
     // Sort indexes based on comparing values in counts, min_ids.
-    std::sort(idx.begin(), idx.end(), [&counts, &min_ids](size_t i1, size_t i2) {
-        if (counts[i1] != counts[i2])
-        {
-            // If the counts are unequal, return the largest cluster first.
-            return counts[i1] > counts[i2];
-        }
-        // If the counts are equal, return the cluster with the smallest
-        // point id first.
-        return min_ids[i1] < min_ids[i2];
+    parallel::execute([&]() {
+        tbb::parallel_sort(idx.begin(), idx.end(), [&counts, &min_ids](size_t i1, size_t i2) {
+            if (counts[i1] != counts[i2])
+            {
+                // If the counts are unequal, return the largest cluster first.
+                return counts[i1] > counts[i2];
+            }
+            // If the counts are equal, return the cluster with the smallest
+            // point id first.
+            return min_ids[i1] < min_ids[i2];
+        });
     });
 
     // Invert the permutation.
     std::vector<size_t> inv_idx(idx.size());
-    for (size_t i = 0; i < idx.size(); i++)
-    {
-        inv_idx[idx[i]] = i;
-    }
+    util::forLoopWrapper(0, idx.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            inv_idx[idx[i]] = i;
+        }
+    });
     return inv_idx;
 }
 
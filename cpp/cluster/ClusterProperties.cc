@@ -1,10 +1,15 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
+#include <tbb/parallel_sort.h>
+#include <utility>
 #include <vector>
 
 #include "ClusterProperties.h"
 #include "NeighborComputeFunctional.h"
+#include "utils.h"
 
 /*! \file ClusterProperties.cc
     \brief Routines for computing properties of point clusters.
@@ -14,112 +19,142 @@ namespace freud { namespace cluster {
 
 /*! \param nq NeighborQuery containing the points making up the clusters
     \param cluster_idx Index of which cluster each point belongs to
-
-    compute loops over all points in the given array and determines the center
-    of mass of the cluster as well as the gyration tensor. These can be
-    accessed after the call to compute with getClusterCenters() and
-    getClusterInertiaMoments().
+    \param masses Mass of each point, or nullptr for unit masses
+
+    compute groups the points by cluster once and then determines the
+    properties of the clusters in parallel. For each cluster, the center and
+    center of mass are found with the circular mean used by
+    Box::centerOfMass, and then the gyration tensor, the moment of inertia
+    tensor and the radius of gyration are accumulated in a single pass over
+    the points of the cluster. These can be accessed after the call to
+    compute with getClusterCenters(), getClusterGyrations(), etc.
 */
 
 void ClusterProperties::compute(const freud::locality::NeighborQuery* nq, const unsigned int* cluster_idx,
                                 const float* masses)
 {
+    const unsigned int num_points = nq->getNPoints();
+
     // determine the number of clusters
-    const unsigned int* max_cluster_id = std::max_element(cluster_idx, cluster_idx + nq->getNPoints());
+    const unsigned int* max_cluster_id = std::max_element(cluster_idx, cluster_idx + num_points);
     const unsigned int num_clusters = *max_cluster_id + 1;
 
-    // allocate memory for the cluster properties and temporary arrays
-    // initialize arrays to 0
+    // allocate memory for the cluster properties
     m_cluster_centers.prepare(num_clusters);
     m_cluster_centers_of_mass.prepare(num_clusters);
     m_cluster_moments_of_inertia.prepare({num_clusters, 3, 3});
     m_cluster_gyrations.prepare({num_clusters, 3, 3});
+    m_cluster_radii_of_gyration.prepare(num_clusters);
     m_cluster_sizes.prepare(num_clusters);
     m_cluster_masses.prepare(num_clusters);
 
-    // Create a vector to store cluster points, used to compute center of mass
-    std::vector<std::vector<vec3<float>>> cluster_points(num_clusters, std::vector<vec3<float>>());
-
-    // Start by determining the center of mass of each cluster. Since we are
-    // given an array of points, the easiest way to do this is to loop over
-    // all points and add the appropriate information to m_cluster_centers as
-    // we go.
-    for (unsigned int i = 0; i < nq->getNPoints(); i++)
-    {
-        const unsigned int c = cluster_idx[i];
-        cluster_points[c].push_back((*nq)[i]);
-        m_cluster_sizes[c]++;
-        float mass = (masses != nullptr) ? masses[i] : float(1.0);
-        m_cluster_masses[c] += mass;
-    }
-
-    // Now that we have located all of the cluster vectors, compute the centers
-    const float* cluster_point_masses = masses;
-    for (unsigned int c = 0; c < num_clusters; c++)
-    {
-        m_cluster_centers[c] = nq->getBox().centerOfMass(cluster_points[c].data(), m_cluster_sizes[c]);
-        m_cluster_centers_of_mass[c]
-            = nq->getBox().centerOfMass(cluster_points[c].data(), m_cluster_sizes[c], cluster_point_masses);
-        if (masses == nullptr)
+    // Group the points by cluster, in order of their index within each
+    // cluster, by sorting them by their cluster index.
+    std::vector<std::pair<unsigned int, unsigned int>> sorted_points(num_points);
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            sorted_points[i] = {cluster_idx[i], i};
+        }
+    });
+    parallel::execute([&]() { tbb::parallel_sort(sorted_points.begin(), sorted_points.end()); });
+
+    // Find the range of sorted points of each cluster.
+    std::vector<size_t> cluster_begin(num_clusters + 1);
+    util::forLoopWrapper(0, num_clusters + 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
         {
-            cluster_point_masses = nullptr;
+            const std::pair<unsigned int, unsigned int> first_point(c, 0);
+            const auto cluster_first
+                = std::lower_bound(sorted_points.cbegin(), sorted_points.cend(), first_point);
+            cluster_begin[c] = cluster_first - sorted_points.cbegin();
         }
-        else
+    });
+
+    // Reduce over the points of each cluster. Every cluster is handled by a
+    // single thread, which accumulates its properties locally.
+    const box::Box& box = nq->getBox();
+    vec3<float>* centers = m_cluster_centers.get();
+    vec3<float>* centers_of_mass = m_cluster_centers_of_mass.get();
+    float* moments_of_inertia = m_cluster_moments_of_inertia.get();
+    float* gyrations = m_cluster_gyrations.get();
+    util::forLoopWrapper(0, num_clusters, [&](size_t begin, size_t end) {
+        std::vector<vec3<float>> cluster_points;
+        std::vector<float> cluster_point_masses;
+        for (size_t c = begin; c < end; ++c)
         {
-            cluster_point_masses = cluster_point_masses + m_cluster_sizes[c];
+            const size_t size = cluster_begin[c + 1] - cluster_begin[c];
+            cluster_points.resize(size);
+            cluster_point_masses.resize(size);
+            float cluster_mass = 0;
+            for (size_t k = 0; k < size; ++k)
+            {
+                const unsigned int i = sorted_points[cluster_begin[c] + k].second;
+                cluster_points[k] = (*nq)[i];
+                cluster_point_masses[k] = (masses != nullptr) ? masses[i] : float(1.0);
+                cluster_mass += cluster_point_masses[k];
+            }
+            m_cluster_sizes[c] = size;
+            m_cluster_masses[c] = cluster_mass;
+
+            const vec3<float> center = box.centerOfMass(cluster_points.data(), size);
+            const vec3<float> center_of_mass = (masses != nullptr)
+                ? box.centerOfMass(cluster_points.data(), size, cluster_point_masses.data())
+                : center;
+            centers[c] = center;
+            centers_of_mass[c] = center_of_mass;
+
+            // Tally up the moment of inertia and gyration tensors.
+            float inertia_xx = 0, inertia_xy = 0, inertia_xz = 0, inertia_yy = 0, inertia_yz = 0,
+                  inertia_zz = 0;
+            float gyration_xx = 0, gyration_xy = 0, gyration_xz = 0, gyration_yy = 0, gyration_yz = 0,
+                  gyration_zz = 0;
+            for (size_t k = 0; k < size; ++k)
+            {
+                const float mass = cluster_point_masses[k];
+                const vec3<float> mass_delta = box.wrap(cluster_points[k] - center_of_mass);
+                const vec3<float> delta = box.wrap(cluster_points[k] - center);
+
+                inertia_xx += (mass_delta.y * mass_delta.y + mass_delta.z * mass_delta.z) * mass;
+                inertia_xy -= mass_delta.x * mass_delta.y * mass;
+                inertia_xz -= mass_delta.x * mass_delta.z * mass;
+                inertia_yy += (mass_delta.x * mass_delta.x + mass_delta.z * mass_delta.z) * mass;
+                inertia_yz -= mass_delta.y * mass_delta.z * mass;
+                inertia_zz += (mass_delta.x * mass_delta.x + mass_delta.y * mass_delta.y) * mass;
+
+                gyration_xx += delta.x * delta.x;
+                gyration_xy += delta.x * delta.y;
+                gyration_xz += delta.x * delta.z;
+                gyration_yy += delta.y * delta.y;
+                gyration_yz += delta.y * delta.z;
+                gyration_zz += delta.z * delta.z;
+            }
+
+            // The tensors are symmetric. The gyration tensor is normalized by
+            // the cluster size.
+            float* inertia = moments_of_inertia + 9 * c;
+            inertia[0] = inertia_xx;
+            inertia[1] = inertia[3] = inertia_xy;
+            inertia[2] = inertia[6] = inertia_xz;
+            inertia[4] = inertia_yy;
+            inertia[5] = inertia[7] = inertia_yz;
+            inertia[8] = inertia_zz;
+
+            const auto s = static_cast<float>(size);
+            float* gyration = gyrations + 9 * c;
+            gyration[0] = gyration_xx / s;
+            gyration[1] = gyration[3] = gyration_xy / s;
+            gyration[2] = gyration[6] = gyration_xz / s;
+            gyration[4] = gyration_yy / s;
+            gyration[5] = gyration[7] = gyration_yz / s;
+            gyration[8] = gyration_zz / s;
+
+            // The trace of the inertia tensor is twice the mass-weighted sum
+            // of squared distances from the center of mass.
+            m_cluster_radii_of_gyration[c]
+                = std::sqrt((inertia_xx + inertia_yy + inertia_zz) / (float(2.0) * cluster_mass));
         }
-    }
-
-    // Now that we have determined the centers of mass for each cluster, tally
-    // up the moment of inertia tensor. This has to be done in a loop over the points.
-    for (unsigned int i = 0; i < nq->getNPoints(); i++)
-    {
-        float mass = (masses != nullptr) ? masses[i] : float(1.0);
-        unsigned int c = cluster_idx[i];
-        vec3<float> pos = (*nq)[i];
-        vec3<float> mass_delta = nq->getBox().wrap(pos - m_cluster_centers_of_mass[c]);
-        vec3<float> delta = nq->getBox().wrap(pos - m_cluster_centers[c]);
-
-        // get the start pointer for our 3x3 matrix
-        m_cluster_moments_of_inertia(c, 0, 0)
-            += (std::pow(mass_delta.y, 2) + std::pow(mass_delta.z, 2)) * mass;
-        m_cluster_moments_of_inertia(c, 0, 1) -= mass_delta.x * mass_delta.y * mass;
-        m_cluster_moments_of_inertia(c, 0, 2) -= mass_delta.x * mass_delta.z * mass;
-        m_cluster_moments_of_inertia(c, 1, 0) -= mass_delta.y * mass_delta.x * mass;
-        m_cluster_moments_of_inertia(c, 1, 1)
-            += (std::pow(mass_delta.x, 2) + std::pow(mass_delta.z, 2)) * mass;
-        m_cluster_moments_of_inertia(c, 1, 2) -= mass_delta.y * mass_delta.z * mass;
-        m_cluster_moments_of_inertia(c, 2, 0) -= mass_delta.z * mass_delta.x * mass;
-        m_cluster_moments_of_inertia(c, 2, 1) -= mass_delta.z * mass_delta.y * mass;
-        m_cluster_moments_of_inertia(c, 2, 2)
-            += (std::pow(mass_delta.x, 2) + std::pow(mass_delta.y, 2)) * mass;
-
-        // get the start pointer for our 3x3 matrix
-        m_cluster_gyrations(c, 0, 0) += delta.x * delta.x;
-        m_cluster_gyrations(c, 0, 1) += delta.x * delta.y;
-        m_cluster_gyrations(c, 0, 2) += delta.x * delta.z;
-        m_cluster_gyrations(c, 1, 0) += delta.y * delta.x;
-        m_cluster_gyrations(c, 1, 1) += delta.y * delta.y;
-        m_cluster_gyrations(c, 1, 2) += delta.y * delta.z;
-        m_cluster_gyrations(c, 2, 0) += delta.z * delta.x;
-        m_cluster_gyrations(c, 2, 1) += delta.z * delta.y;
-        m_cluster_gyrations(c, 2, 2) += delta.z * delta.z;
-    }
-
-    // Normalize by the cluster sizes.
-    for (unsigned int c = 0; c < num_clusters; c++)
-    {
-        auto s = static_cast<float>(m_cluster_sizes[c]);
-        m_cluster_gyrations(c, 0, 0) /= s;
-        m_cluster_gyrations(c, 0, 1) /= s;
-        m_cluster_gyrations(c, 0, 2) /= s;
-        m_cluster_gyrations(c, 1, 0) /= s;
-        m_cluster_gyrations(c, 1, 1) /= s;
-        m_cluster_gyrations(c, 1, 2) /= s;
-        m_cluster_gyrations(c, 2, 0) /= s;
-        m_cluster_gyrations(c, 2, 1) /= s;
-        m_cluster_gyrations(c, 2, 2) /= s;
-    }
+    });
 }
 
 }; }; // end namespace freud::cluster
@@ -19,6 +19,8 @@ namespace freud { namespace cluster {
     cluster:
      - Center of mass
      - Gyration tensor
+     - Moment of inertia tensor
+     - Radius of gyration
 
     m_cluster_centers stores the computed unweighted centers of mass for each cluster,
     properly handling periodic boundary conditions.
@@ -28,6 +30,7 @@ namespace freud { namespace cluster {
     tensors are symmetric.
     m_cluster_gyrations stores a 3x3 gyration tensor for each cluster. The tensors are
     symmetric.
+    m_cluster_radii_of_gyration stores the mass-weighted radius of gyration of each cluster.
 */
 class ClusterProperties
 {
@@ -63,6 +66,12 @@ public:
         return m_cluster_gyrations;
     }
 
+    //! Get a reference to the last computed cluster radii of gyration
+    const util::ManagedArray<float>& getClusterRadiiOfGyration() const
+    {
+        return m_cluster_radii_of_gyration;
+    }
+
     //! Get a reference to the last computed cluster sizes
     const util::ManagedArray<unsigned int>& getClusterSizes() const
     {
@@ -84,6 +93,8 @@ private:
                                                                //!< cluster (m_num_clusters x 3 x 3 array)
     util::ManagedArray<float> m_cluster_gyrations;             //!< Gyration tensor computed for each
                                                                //!< cluster (m_num_clusters x 3 x 3 array)
+    util::ManagedArray<float> m_cluster_radii_of_gyration;     //!< Radius of gyration computed for each
+                                                               //!< cluster (length: m_num_clusters)
     util::ManagedArray<unsigned int> m_cluster_sizes;          //!< Size per cluster
     util::ManagedArray<float> m_cluster_masses;                //!< Mass per cluster
 };
@@ -0,0 +1,379 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <iterator>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_sort.h>
+#include <tuple>
+
+#include "ClusterTracker.h"
+#include "NeighborBond.h"
+#include "NeighborComputeFunctional.h"
+#include "dset/dset.h"
+#include "utils.h"
+
+/*! \file ClusterTracker.cc
+    \brief Tracks clusters of points across the frames of a trajectory.
+*/
+
+namespace freud { namespace cluster {
+
+namespace {
+
+//! Marks a cluster or id that has not been assigned.
+constexpr unsigned int UNASSIGNED = std::numeric_limits<unsigned int>::max();
+
+//! How the clusters of the previous frame are touched by the bonds that changed.
+enum ClusterState : uint8_t
+{
+    UNCHANGED = 0, //!< No bond of the cluster changed.
+    GAINED = 1,    //!< The cluster only gained bonds, so its points stay connected.
+    LOST = 2       //!< The cluster lost a bond and may be split.
+};
+
+//! Encode a bond as its smaller point index in the upper and its larger point index in the lower 32 bits.
+inline uint64_t bondKey(unsigned int i, unsigned int j)
+{
+    return (i < j) ? ((uint64_t(i) << 32) | j) : ((uint64_t(j) << 32) | i);
+}
+
+inline unsigned int bondFirst(uint64_t key)
+{
+    return static_cast<unsigned int>(key >> 32);
+}
+
+inline unsigned int bondSecond(uint64_t key)
+{
+    return static_cast<unsigned int>(key & 0xFFFFFFFFULL);
+}
+
+//! Number the connected components of a set of points from its disjoint sets.
+/*! \returns The number of components. Components are numbered in the order
+ *  of their smallest point, which makes the numbering independent of the
+ *  order in which the sets were merged.
+ */
+unsigned int labelComponents(const DisjointSets& dj, unsigned int num_points,
+                             std::vector<unsigned int>& component)
+{
+    std::vector<unsigned int> root_component(num_points, UNASSIGNED);
+    component.resize(num_points);
+    unsigned int num_components = 0;
+    for (unsigned int i = 0; i < num_points; ++i)
+    {
+        const unsigned int root = dj.find(i);
+        if (root_component[root] == UNASSIGNED)
+        {
+            root_component[root] = num_components++;
+        }
+        component[i] = root_component[root];
+    }
+    return num_components;
+}
+
+//! Merge bonds into the disjoint sets in parallel.
+/*! \param map_point Maps a point index to its index in the disjoint sets.
+ *  \param accept Whether the bond should be merged.
+ */
+template<typename MapPoint, typename Accept>
+void uniteBonds(DisjointSets& dj, const std::vector<uint64_t>& bonds, const MapPoint& map_point,
+                const Accept& accept)
+{
+    util::forLoopWrapper(0, bonds.size(), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b)
+        {
+            const unsigned int i = bondFirst(bonds[b]);
+            const unsigned int j = bondSecond(bonds[b]);
+            if (accept(i, j))
+            {
+                dj.unite(map_point(i), map_point(j));
+            }
+        }
+    });
+}
+
+}; // end anonymous namespace
+
+void ClusterTracker::reset()
+{
+    m_num_points = 0;
+    m_num_frames = 0;
+    m_num_clusters = 0;
+    m_num_added_bonds = 0;
+    m_num_removed_bonds = 0;
+    m_num_relabeled_points = 0;
+    m_bonds.clear();
+    m_labels.clear();
+    m_cluster_sizes.clear();
+}
+
+void ClusterTracker::compute(const freud::locality::NeighborQuery* nq,
+                             const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    const unsigned int num_points = nq->getNPoints();
+    if (m_num_frames != 0 && num_points != m_num_points)
+    {
+        throw std::invalid_argument("ClusterTracker requires the same number of points in every frame, "
+                                    "call reset() before computing a different system.");
+    }
+
+    // Collect the bonds of this frame once per pair of points, so they can be
+    // compared with the bonds of the previous frame.
+    tbb::enumerable_thread_specific<std::vector<uint64_t>> local_bonds;
+    freud::locality::loopOverNeighbors(
+        nq, nq->getPoints(), num_points, qargs, nlist,
+        [&local_bonds](const freud::locality::NeighborBond& neighbor_bond) {
+            const unsigned int i = neighbor_bond.getQueryPointIdx();
+            const unsigned int j = neighbor_bond.getPointIdx();
+            if (i != j)
+            {
+                local_bonds.local().push_back(bondKey(i, j));
+            }
+        });
+    std::vector<uint64_t> bonds;
+    for (const auto& thread_bonds : local_bonds)
+    {
+        bonds.insert(bonds.end(), thread_bonds.begin(), thread_bonds.end());
+    }
+    parallel::execute([&]() { tbb::parallel_sort(bonds.begin(), bonds.end()); });
+    bonds.erase(std::unique(bonds.begin(), bonds.end()), bonds.end());
+
+    m_merges.prepare({0, 2});
+    m_splits.prepare({0, 2});
+    if (m_num_frames == 0)
+    {
+        m_num_points = num_points;
+        m_num_added_bonds = static_cast<unsigned int>(bonds.size());
+        m_num_removed_bonds = 0;
+        labelFirstFrame(bonds);
+    }
+    else
+    {
+        std::vector<uint64_t> added_bonds;
+        std::vector<uint64_t> removed_bonds;
+        std::set_difference(bonds.begin(), bonds.end(), m_bonds.begin(), m_bonds.end(),
+                            std::back_inserter(added_bonds));
+        std::set_difference(m_bonds.begin(), m_bonds.end(), bonds.begin(), bonds.end(),
+                            std::back_inserter(removed_bonds));
+        m_num_added_bonds = static_cast<unsigned int>(added_bonds.size());
+        m_num_removed_bonds = static_cast<unsigned int>(removed_bonds.size());
+        labelChangedClusters(bonds, added_bonds, removed_bonds);
+    }
+    m_bonds = std::move(bonds);
+    ++m_num_frames;
+
+    m_cluster_idx.prepare(num_points);
+    std::copy(m_labels.begin(), m_labels.end(), m_cluster_idx.get());
+}
+
+void ClusterTracker::labelFirstFrame(const std::vector<uint64_t>& bonds)
+{
+    const unsigned int num_points = m_num_points;
+    DisjointSets dj(num_points);
+    uniteBonds(
+        dj, bonds, [](unsigned int i) { return i; }, [](unsigned int, unsigned int) { return true; });
+
+    std::vector<unsigned int> component;
+    const unsigned int num_components = labelComponents(dj, num_points, component);
+    std::vector<unsigned int> component_sizes(num_components, 0);
+    for (unsigned int i = 0; i < num_points; ++i)
+    {
+        ++component_sizes[component[i]];
+    }
+
+    // Number the clusters from the largest to the smallest, with equally
+    // sized clusters in the order of their smallest point index.
+    std::vector<unsigned int> order(num_components);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&component_sizes](unsigned int a, unsigned int b) {
+        return component_sizes[a] > component_sizes[b];
+    });
+    std::vector<unsigned int> component_id(num_components);
+    m_cluster_sizes.resize(num_components);
+    for (unsigned int id = 0; id < num_components; ++id)
+    {
+        component_id[order[id]] = id;
+        m_cluster_sizes[id] = component_sizes[order[id]];
+    }
+
+    m_labels.resize(num_points);
+    for (unsigned int i = 0; i < num_points; ++i)
+    {
+        m_labels[i] = component_id[component[i]];
+    }
+    m_num_clusters = num_components;
+    m_num_relabeled_points = num_points;
+}
+
+void ClusterTracker::labelChangedClusters(const std::vector<uint64_t>& bonds,
+                                          const std::vector<uint64_t>& added_bonds,
+                                          const std::vector<uint64_t>& removed_bonds)
+{
+    const auto max_id = static_cast<unsigned int>(m_cluster_sizes.size());
+
+    // The two points of a removed bond were in the same cluster, which may
+    // be split. The clusters joined by an added bond stay connected.
+    std::vector<uint8_t> state(max_id, UNCHANGED);
+    for (const uint64_t bond : removed_bonds)
+    {
+        state[m_labels[bondFirst(bond)]] = LOST;
+    }
+    for (const uint64_t bond : added_bonds)
+    {
+        for (const unsigned int i : {bondFirst(bond), bondSecond(bond)})
+        {
+            state[m_labels[i]] = std::max<uint8_t>(state[m_labels[i]], GAINED);
+        }
+    }
+
+    // Gather the points of the touched clusters in the order of their index,
+    // and the first of them in each cluster.
+    std::vector<unsigned int> touched_points;
+    std::vector<unsigned int> local_idx(m_num_points);
+    std::vector<unsigned int> first_point(max_id, UNASSIGNED);
+    for (unsigned int i = 0; i < m_num_points; ++i)
+    {
+        const unsigned int id = m_labels[i];
+        if (state[id] != UNCHANGED)
+        {
+            local_idx[i] = static_cast<unsigned int>(touched_points.size());
+            if (first_point[id] == UNASSIGNED)
+            {
+                first_point[id] = local_idx[i];
+            }
+            touched_points.push_back(i);
+        }
+    }
+    const auto num_touched = static_cast<unsigned int>(touched_points.size());
+    m_num_relabeled_points = num_touched;
+    if (num_touched == 0)
+    {
+        return;
+    }
+
+    // Clusters that only gained bonds start out connected, while clusters
+    // that lost a bond are rebuilt from the bonds they still have. Bonds
+    // between different previous clusters are all added bonds.
+    DisjointSets dj(num_touched);
+    for (unsigned int l = 0; l < num_touched; ++l)
+    {
+        const unsigned int id = m_labels[touched_points[l]];
+        if (state[id] == GAINED)
+        {
+            dj.unite(first_point[id], l);
+        }
+    }
+    const auto map_point = [&local_idx](unsigned int i) { return local_idx[i]; };
+    uniteBonds(dj, bonds, map_point, [&](unsigned int i, unsigned int j) {
+        return m_labels[i] == m_labels[j] && state[m_labels[i]] == LOST;
+    });
+    uniteBonds(dj, added_bonds, map_point, [](unsigned int, unsigned int) { return true; });
+
+    std::vector<unsigned int> component;
+    const unsigned int num_components = labelComponents(dj, num_touched, component);
+
+    // Count the points each new component shares with each previous cluster.
+    std::vector<std::pair<unsigned int, unsigned int>> memberships(num_touched);
+    std::vector<unsigned int> component_sizes(num_components, 0);
+    for (unsigned int l = 0; l < num_touched; ++l)
+    {
+        memberships[l] = {component[l], m_labels[touched_points[l]]};
+        ++component_sizes[component[l]];
+    }
+    std::sort(memberships.begin(), memberships.end());
+    // Each overlap is (shared points, previous id, component).
+    std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> overlaps;
+    for (unsigned int k = 0; k < num_touched;)
+    {
+        unsigned int next = k + 1;
+        while (next < num_touched && memberships[next] == memberships[k])
+        {
+            ++next;
+        }
+        overlaps.emplace_back(next - k, memberships[k].second, memberships[k].first);
+        k = next;
+    }
+    std::sort(overlaps.begin(), overlaps.end(), [](const auto& a, const auto& b) {
+        if (std::get<0>(a) != std::get<0>(b))
+        {
+            return std::get<0>(a) > std::get<0>(b);
+        }
+        return std::make_pair(std::get<1>(a), std::get<2>(a))
+            < std::make_pair(std::get<1>(b), std::get<2>(b));
+    });
+
+    // Match the largest overlaps first. The first overlap of a component is
+    // the previous cluster it shares the most points with, and the first
+    // overlap of a previous cluster is the component holding most of it.
+    std::vector<unsigned int> component_id(num_components, UNASSIGNED);
+    std::vector<unsigned int> component_source(num_components, UNASSIGNED);
+    std::vector<unsigned int> id_component(max_id, UNASSIGNED);
+    std::vector<unsigned int> id_destination(max_id, UNASSIGNED);
+    for (const auto& [shared, id, c] : overlaps)
+    {
+        if (component_source[c] == UNASSIGNED)
+        {
+            component_source[c] = id;
+        }
+        if (id_destination[id] == UNASSIGNED)
+        {
+            id_destination[id] = c;
+        }
+        if (component_id[c] == UNASSIGNED && id_component[id] == UNASSIGNED)
+        {
+            component_id[c] = id;
+            id_component[id] = c;
+        }
+    }
+
+    // Components without a previous id are split off with a new id.
+    std::vector<unsigned int> splits;
+    for (unsigned int c = 0; c < num_components; ++c)
+    {
+        if (component_id[c] == UNASSIGNED)
+        {
+            component_id[c] = static_cast<unsigned int>(m_cluster_sizes.size());
+            m_cluster_sizes.push_back(0);
+            splits.push_back(component_id[c]);
+            splits.push_back(component_source[c]);
+        }
+    }
+
+    // Previous ids without a component were merged into another cluster.
+    std::vector<unsigned int> merges;
+    unsigned int num_touched_ids = 0;
+    for (unsigned int id = 0; id < max_id; ++id)
+    {
+        if (state[id] == UNCHANGED)
+        {
+            continue;
+        }
+        ++num_touched_ids;
+        m_cluster_sizes[id] = 0;
+        if (id_component[id] == UNASSIGNED)
+        {
+            merges.push_back(id);
+            merges.push_back(component_id[id_destination[id]]);
+        }
+    }
+
+    for (unsigned int c = 0; c < num_components; ++c)
+    {
+        m_cluster_sizes[component_id[c]] = component_sizes[c];
+    }
+    for (unsigned int l = 0; l < num_touched; ++l)
+    {
+        m_labels[touched_points[l]] = component_id[component[l]];
+    }
+    m_num_clusters = m_num_clusters - num_touched_ids + num_components;
+
+    m_merges.prepare({merges.size() / 2, 2});
+    std::copy(merges.begin(), merges.end(), m_merges.get());
+    m_splits.prepare({splits.size() / 2, 2});
+    std::copy(splits.begin(), splits.end(), m_splits.get());
+}
+
+}; }; // end namespace freud::cluster
@@ -0,0 +1,140 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef CLUSTER_TRACKER_H
+#define CLUSTER_TRACKER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file ClusterTracker.h
+    \brief Tracks clusters of points across the frames of a trajectory.
+*/
+
+namespace freud { namespace cluster {
+
+//! Tracks clusters across frames, keeping the id of each cluster while it persists.
+/*! Each frame, the bonds found by the neighbor query are compared with the
+ *  bonds of the previous frame. Clusters that neither lost nor gained a bond
+ *  keep their points and id without being visited. The clusters touched by
+ *  a changed bond are relabeled: the points of clusters that only gained
+ *  bonds start from their previous cluster and are merged along the added
+ *  bonds, while the clusters that lost a bond are split into the connected
+ *  components of their remaining bonds.
+ *
+ *  The new clusters inherit the previous ids by greedily matching the pairs
+ *  of previous and new clusters with the most points in common, so a cluster
+ *  that grows or shrinks keeps its id. A new cluster matched with no
+ *  previous id gets a new id and is recorded as split from the previous
+ *  cluster it shares the most points with, and a previous id matched with no
+ *  new cluster is recorded as merged into the cluster holding most of its
+ *  points. On the first frame, the ids are numbered from the largest to the
+ *  smallest cluster like those of Cluster.
+ *
+ *  The ids are not contiguous: they lie in [0, getMaxClusterId()) and are
+ *  never reused until reset.
+ */
+class ClusterTracker
+{
+public:
+    //! Constructor
+    ClusterTracker() = default;
+
+    //! Forget the clusters of the previous frame, so the next frame is numbered afresh.
+    void reset();
+
+    //! Compute the clusters of the next frame and match them with those of the previous frame.
+    /*! The number of points must not change between frames.
+     */
+    void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
+                 freud::locality::QueryArgs qargs);
+
+    //! Get the number of frames computed since the last reset.
+    unsigned int getNumFrames() const
+    {
+        return m_num_frames;
+    }
+
+    //! Get the number of clusters.
+    unsigned int getNumClusters() const
+    {
+        return m_num_clusters;
+    }
+
+    //! Get one more than the largest cluster id given out since the last reset.
+    unsigned int getMaxClusterId() const
+    {
+        return static_cast<unsigned int>(m_cluster_sizes.size());
+    }
+
+    //! Get a reference to the cluster id of each point.
+    const util::ManagedArray<unsigned int>& getClusterIdx() const
+    {
+        return m_cluster_idx;
+    }
+
+    //! Get the number of points with each cluster id, which is 0 for ids that are no longer used.
+    const std::vector<unsigned int>& getClusterSizes() const
+    {
+        return m_cluster_sizes;
+    }
+
+    //! Get the (previous id, id merged into) pairs of the clusters that disappeared in the last frame.
+    const util::ManagedArray<unsigned int>& getMerges() const
+    {
+        return m_merges;
+    }
+
+    //! Get the (new id, previous id split from) pairs of the clusters that appeared in the last frame.
+    const util::ManagedArray<unsigned int>& getSplits() const
+    {
+        return m_splits;
+    }
+
+    //! Get the number of bonds of the last frame that were not bonds of the previous frame.
+    unsigned int getNumAddedBonds() const
+    {
+        return m_num_added_bonds;
+    }
+
+    //! Get the number of bonds of the previous frame that are not bonds of the last frame.
+    unsigned int getNumRemovedBonds() const
+    {
+        return m_num_removed_bonds;
+    }
+
+    //! Get the number of points whose clusters were relabeled in the last frame.
+    unsigned int getNumRelabeledPoints() const
+    {
+        return m_num_relabeled_points;
+    }
+
+private:
+    //! Number the clusters of the first frame from the largest to the smallest.
+    void labelFirstFrame(const std::vector<uint64_t>& bonds);
+
+    //! Relabel the clusters touched by the bonds that changed since the previous frame.
+    void labelChangedClusters(const std::vector<uint64_t>& bonds, const std::vector<uint64_t>& added_bonds,
+                              const std::vector<uint64_t>& removed_bonds);
+
+    unsigned int m_num_points {0};                  //!< Number of points of each frame
+    unsigned int m_num_frames {0};                  //!< Number of frames since the last reset
+    unsigned int m_num_clusters {0};                //!< Number of clusters of the last frame
+    unsigned int m_num_added_bonds {0};             //!< Bonds added in the last frame
+    unsigned int m_num_removed_bonds {0};           //!< Bonds removed in the last frame
+    unsigned int m_num_relabeled_points {0};        //!< Points relabeled in the last frame
+    std::vector<uint64_t> m_bonds;                  //!< Sorted (smaller, larger) point index pairs
+    std::vector<unsigned int> m_labels;             //!< Cluster id of each point, kept between frames
+    std::vector<unsigned int> m_cluster_sizes;      //!< Number of points with each id
+    util::ManagedArray<unsigned int> m_cluster_idx; //!< Cluster id of each point
+    util::ManagedArray<unsigned int> m_merges;      //!< Merge events of the last frame
+    util::ManagedArray<unsigned int> m_splits;      //!< Split events of the last frame
+};
+
+}; }; // end namespace freud::cluster
+
+#endif // CLUSTER_TRACKER_H
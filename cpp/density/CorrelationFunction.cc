@@ -1,13 +1,17 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <limits>
 #include <stdexcept>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
 
 #include "CorrelationFunction.h"
+#include "FFT.h"
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
 
@@ -18,7 +22,8 @@
 namespace freud { namespace density {
 
 template<typename T>
-CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : BondHistogramCompute()
+CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max, vec3<unsigned int> mesh)
+    : BondHistogramCompute(), m_mesh(mesh)
 {
     if (bins == 0)
     {
@@ -28,6 +33,11 @@ CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : Bo
     {
         throw std::invalid_argument("CorrelationFunction requires r_max to be positive.");
     }
+    if ((mesh.x == 0 || mesh.y == 0 || mesh.z == 0) && (mesh.x != 0 || mesh.y != 0 || mesh.z != 0))
+    {
+        throw std::invalid_argument("CorrelationFunction requires a nonzero number of mesh cells in each "
+                                    "dimension.");
+    }
 
     // We must construct two separate histograms, one for the counts and one
     // for the actual correlation function. The counts are used to normalize
@@ -38,6 +48,20 @@ CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : Bo
 
     m_correlation_function = util::Histogram<T>(axes);
     m_local_correlation_function = CFThreadHistogram(m_correlation_function);
+
+    m_mesh_pair_counts = util::Histogram<double>(axes);
+    m_local_mesh_pair_counts = PairCountThreadHistogram(m_mesh_pair_counts);
+}
+
+// Define an overloaded pair of functions for the squared deviations of the batch estimates.
+inline double squaredMagnitude(const std::complex<double>& x)
+{
+    return std::norm(x);
+}
+
+inline double squaredMagnitude(double x)
+{
+    return x * x;
 }
 
 //! \internal
@@ -50,12 +74,66 @@ template<typename T> void CorrelationFunction<T>::reduce()
     // Reduce the bin counts over all threads, then use them to normalize the
     // RDF when computing.
     m_histogram.reduceOverThreads(m_local_histograms);
+    if (m_mesh.x != 0)
+    {
+        // The pair counts of a mesh exceed the range of the bin counts for
+        // large systems, so they are kept separately.
+        m_mesh_pair_counts.prepare(getAxisSizes()[0]);
+        m_mesh_pair_counts.reduceOverThreads(m_local_mesh_pair_counts);
+        const auto max_count = static_cast<double>(std::numeric_limits<unsigned int>::max());
+        for (size_t i = 0; i < getAxisSizes()[0]; ++i)
+        {
+            m_histogram[i] = static_cast<unsigned int>(std::min(m_mesh_pair_counts[i], max_count));
+        }
+        m_correlation_function.reduceOverThreadsPerBin(m_local_correlation_function, [&](size_t i) {
+            if (m_mesh_pair_counts[i] > 0)
+            {
+                m_correlation_function[i] /= m_mesh_pair_counts[i];
+            }
+        });
+        return;
+    }
     m_correlation_function.reduceOverThreadsPerBin(m_local_correlation_function, [&](size_t i) {
         if (m_histogram[i])
         {
             m_correlation_function[i] /= m_histogram[i];
         }
     });
+
+    // The correlation function of each batch of sampled query points is an
+    // independent estimate, whose spread gives the standard error.
+    const size_t num_bins = getAxisSizes()[0];
+    m_correlation_error.prepare(num_bins);
+    if (m_num_batches == 0)
+    {
+        return;
+    }
+    std::vector<util::ManagedArray<T>> batch_sums;
+    for (auto& batch_correlation_function : m_batch_correlation_functions)
+    {
+        batch_sums.emplace_back(num_bins);
+        batch_correlation_function.reduceInto(batch_sums.back());
+    }
+    for (size_t i = 0; i < num_bins; ++i)
+    {
+        unsigned int num_estimates = 0;
+        double sum_squares = 0;
+        for (unsigned int batch = 0; batch < m_num_batches; ++batch)
+        {
+            const unsigned int batch_count = m_batch_counts[batch][i];
+            if (batch_count != 0)
+            {
+                sum_squares += squaredMagnitude(batch_sums[batch][i] / static_cast<double>(batch_count)
+                                                - m_correlation_function[i]);
+                ++num_estimates;
+            }
+        }
+        if (num_estimates > 1)
+        {
+            m_correlation_error[i] = static_cast<float>(
+                std::sqrt(sum_squares / (static_cast<double>(num_estimates) * (num_estimates - 1))));
+        }
+    }
 }
 
 template<typename T> void CorrelationFunction<T>::reset()
@@ -65,6 +143,8 @@ template<typename T> void CorrelationFunction<T>::reset()
     // Zero the correlation function in addition to the bin counts that are
     // reset by the parent.
     m_local_correlation_function.reset();
+    m_local_mesh_pair_counts.reset();
+    m_batch_correlation_functions.clear();
 }
 
 // Define an overloaded pair of product functions to deal with complex conjugation if necessary.
@@ -78,6 +158,17 @@ inline double product(double x, double y)
     return x * y;
 }
 
+// Define an overloaded pair of functions to convert sums over the mesh to the value type.
+inline void fromMesh(const std::complex<double>& sum, std::complex<double>& value)
+{
+    value = sum;
+}
+
+inline void fromMesh(const std::complex<double>& sum, double& value)
+{
+    value = sum.real();
+}
+
 template<typename T>
 void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* neighbor_query, const T* values,
                                         const vec3<float>* query_points, const T* query_values,
@@ -85,6 +176,12 @@ void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* ne
                                         const freud::locality::NeighborList* nlist,
                                         freud::locality::QueryArgs qargs)
 {
+    if (m_mesh.x != 0)
+    {
+        accumulateMesh(neighbor_query, values, query_points, query_values, n_query_points, nlist, qargs);
+        return;
+    }
+    qargs = mirrorableQueryArgs(neighbor_query, query_points, n_query_points, qargs, values == query_values);
     accumulateGeneral(
         neighbor_query, query_points, n_query_points, nlist, qargs,
         [&](const freud::locality::NeighborBond& neighbor_bond) {
@@ -96,6 +193,172 @@ void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* ne
         });
 }
 
+template<typename T>
+void CorrelationFunction<T>::accumulateSampled(const freud::locality::NeighborQuery* neighbor_query,
+                                               const T* values, const vec3<float>* query_points,
+                                               const T* query_values, unsigned int n_query_points,
+                                               const freud::locality::NeighborList* nlist,
+                                               freud::locality::QueryArgs qargs,
+                                               const freud::locality::QuerySampling& sampling)
+{
+    if (m_mesh.x != 0)
+    {
+        throw std::invalid_argument(
+            "CorrelationFunction cannot sample query points when computed on a mesh.");
+    }
+    if (m_num_batches == 0)
+    {
+        m_batch_correlation_functions.clear();
+        for (unsigned int batch = 0; batch < sampling.num_batches; ++batch)
+        {
+            m_batch_correlation_functions.emplace_back(m_correlation_function);
+        }
+    }
+    accumulateSampledHistogramChunks(
+        neighbor_query, query_points, n_query_points, nlist, qargs, sampling,
+        [&](unsigned int batch, BondHistogram& histogram) {
+            return [&histogram, correlation_function = &m_local_correlation_function.local(),
+                    batch_correlation_function = &m_batch_correlation_functions[batch].local(), values,
+                    query_values, this](const freud::locality::NeighborBond& neighbor_bond) {
+                const size_t value_bin = m_histogram.bin({neighbor_bond.getDistance()});
+                histogram.increment(value_bin);
+                const auto value = product(values[neighbor_bond.getPointIdx()],
+                                           query_values[neighbor_bond.getQueryPointIdx()]);
+                correlation_function->increment(value_bin, value);
+                batch_correlation_function->increment(value_bin, value);
+            };
+        });
+}
+
+template<typename T>
+void CorrelationFunction<T>::accumulateMesh(const freud::locality::NeighborQuery* neighbor_query,
+                                            const T* values, const vec3<float>* query_points,
+                                            const T* query_values, unsigned int n_query_points,
+                                            const freud::locality::NeighborList* nlist,
+                                            const freud::locality::QueryArgs& qargs)
+{
+    if (nlist != nullptr)
+    {
+        throw std::invalid_argument(
+            "CorrelationFunction cannot use a neighbor list when computed on a mesh.");
+    }
+    m_box = neighbor_query->getBox();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    if (!periodic.x || !periodic.y || (!m_box.is2D() && !periodic.z))
+    {
+        throw std::invalid_argument(
+            "CorrelationFunction can only use a mesh for boxes that are periodic in all dimensions.");
+    }
+
+    const vec3<unsigned int> mesh(m_mesh.x, m_mesh.y, m_box.is2D() ? 1 : m_mesh.z);
+    const unsigned int n_points = neighbor_query->getNPoints();
+    const vec3<float>* points = neighbor_query->getPoints();
+
+    // Points are assigned to the cell holding their wrapped fractional coordinates.
+    const auto cell_coords = [&](const vec3<float>& point) {
+        const vec3<float> fraction = m_box.makeFractional(point);
+        const auto coord = [](float f, unsigned int n) {
+            return std::min(static_cast<unsigned int>((f - std::floor(f)) * static_cast<float>(n)), n - 1);
+        };
+        return vec3<unsigned int>(coord(fraction.x, mesh.x), coord(fraction.y, mesh.y),
+                                  m_box.is2D() ? 0 : coord(fraction.z, mesh.z));
+    };
+    const auto cell_index = [&](const vec3<unsigned int>& cell) {
+        return (static_cast<size_t>(cell.x) * mesh.y + cell.y) * mesh.z + cell.z;
+    };
+
+    // Sum the values and the numbers of points in each cell and transform the sums.
+    using Grid = util::ManagedArray<std::complex<double>>;
+    const auto transform_sums = [&](const vec3<float>* positions, const T* weights, unsigned int n,
+                                    Grid& value_grid, Grid& count_grid) {
+        value_grid.prepare({mesh.x, mesh.y, mesh.z});
+        count_grid.prepare({mesh.x, mesh.y, mesh.z});
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            const size_t cell = cell_index(cell_coords(positions[i]));
+            value_grid[cell] += std::complex<double>(weights[i]);
+            count_grid[cell] += 1.0;
+        }
+        util::fft3D(value_grid);
+        util::fft3D(count_grid);
+    };
+    Grid value_grid;
+    Grid count_grid;
+    transform_sums(points, values, n_points, value_grid, count_grid);
+    const bool same_sums = query_points == points && n_query_points == n_points && query_values == values;
+    Grid query_value_grid;
+    Grid query_count_grid;
+    if (!same_sums)
+    {
+        transform_sums(query_points, query_values, n_query_points, query_value_grid, query_count_grid);
+    }
+
+    // The inverse transform of conj(f(k)) g(k) gives the sum of conj(f(x)) g(x + d)
+    // over all cells x for each displacement d between cells.
+    util::forLoopWrapper(0, value_grid.size(), [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            const std::complex<double> query_value = same_sums ? value_grid[k] : query_value_grid[k];
+            const std::complex<double> query_count = same_sums ? count_grid[k] : query_count_grid[k];
+            value_grid[k] = std::conj(value_grid[k]) * query_value;
+            count_grid[k] = std::conj(count_grid[k]) * query_count;
+        }
+    });
+    util::fft3D(value_grid, true);
+    util::fft3D(count_grid, true);
+
+    // Remove the pairs of a point with itself, which lie at the displacement between their cells.
+    if (qargs.exclude_ii)
+    {
+        for (unsigned int i = 0; i < std::min(n_points, n_query_points); ++i)
+        {
+            const vec3<unsigned int> point_cell = cell_coords(points[i]);
+            const vec3<unsigned int> query_point_cell = cell_coords(query_points[i]);
+            const size_t displacement = cell_index(vec3<unsigned int>(
+                (query_point_cell.x + mesh.x - point_cell.x) % mesh.x,
+                (query_point_cell.y + mesh.y - point_cell.y) % mesh.y,
+                (query_point_cell.z + mesh.z - point_cell.z) % mesh.z));
+            value_grid[displacement] -= std::complex<double>(product(values[i], query_values[i]));
+            count_grid[displacement] -= 1.0;
+        }
+    }
+
+    // Bin each displacement by the length of its minimum image.
+    const vec3<float> origin = m_box.makeAbsolute(vec3<float>(0, 0, 0));
+    const auto signed_fraction = [](unsigned int m, unsigned int n) {
+        const int signed_m = (2 * m <= n) ? static_cast<int>(m) : static_cast<int>(m) - static_cast<int>(n);
+        return static_cast<float>(signed_m) / static_cast<float>(n);
+    };
+    util::forLoopWrapper(0, mesh.x, [&](size_t begin, size_t end) {
+        util::Histogram<T>& local_correlation_function = m_local_correlation_function.local();
+        util::Histogram<double>& local_pair_counts = m_local_mesh_pair_counts.local();
+        for (size_t a = begin; a < end; ++a)
+        {
+            for (unsigned int b = 0; b < mesh.y; ++b)
+            {
+                for (unsigned int c = 0; c < mesh.z; ++c)
+                {
+                    const vec3<float> fraction(signed_fraction(a, mesh.x), signed_fraction(b, mesh.y),
+                                               m_box.is2D() ? 0 : signed_fraction(c, mesh.z));
+                    const vec3<float> delta = m_box.wrap(m_box.makeAbsolute(fraction) - origin);
+                    const float distance = std::sqrt(dot(delta, delta));
+                    const size_t value_bin = m_histogram.bin(&distance, 1);
+                    const size_t cell = (a * mesh.y + b) * mesh.z + c;
+                    T value;
+                    fromMesh(value_grid[cell], value);
+                    local_correlation_function.increment(value_bin, value);
+                    local_pair_counts.increment(value_bin, std::round(count_grid[cell].real()));
+                }
+            }
+        }
+    });
+
+    m_frame_counter++;
+    m_n_points = n_points;
+    m_n_query_points = n_query_points;
+    m_reduce = true;
+}
+
 template class CorrelationFunction<std::complex<double>>;
 template class CorrelationFunction<double>;
 
@@ -42,12 +42,28 @@ namespace freud { namespace density {
     for both points and ref_points, we omit accumulating the
     self-correlation value in the first bin.
 
+    <b>Mesh:</b><br>
+    When a mesh is given, the values are instead summed on a grid of
+    cells spanning the periodic box, and the products of all pairs of
+    cells are computed at once as the circular cross-correlation of the
+    grids with FFTs. Each displacement between cells is binned by its
+    minimum image length, so distances are only resolved to the size of
+    a cell. The cost grows with the number of cells instead of the number
+    of pairs within r_max, which makes correlation functions that span
+    the whole box affordable for large systems. The pair counts of each
+    bin are accumulated in double precision and saturate in the bin
+    counts.
 */
 template<typename T> class CorrelationFunction : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    CorrelationFunction(unsigned int bins, float r_max);
+    /*! \param bins Number of bins.
+     *  \param r_max Maximum distance.
+     *  \param mesh Number of mesh cells in each dimension, or zeros to correlate the neighbor bonds.
+     */
+    CorrelationFunction(unsigned int bins, float r_max,
+                        vec3<unsigned int> mesh = vec3<unsigned int>(0, 0, 0));
 
     //! Destructor
     ~CorrelationFunction() override = default;
@@ -60,22 +76,59 @@ public:
                     const vec3<float>* query_points, const T* query_values, unsigned int n_query_points,
                     const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    //! accumulate the correlation function of a random sample of the query points
+    /*! The standard error of each bin is estimated from the batches of
+     *  sampled query points. Sampling cannot be combined with a mesh.
+     */
+    void accumulateSampled(const freud::locality::NeighborQuery* neighbor_query, const T* values,
+                           const vec3<float>* query_points, const T* query_values,
+                           unsigned int n_query_points, const freud::locality::NeighborList* nlist,
+                           freud::locality::QueryArgs qargs,
+                           const freud::locality::QuerySampling& sampling);
+
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     void reduce() override;
 
+    //! Get the number of mesh cells in each dimension, which are zero when neighbor bonds are correlated.
+    const vec3<unsigned int>& getMesh() const
+    {
+        return m_mesh;
+    }
+
     //! Get a reference to the last computed correlation function.
     const util::ManagedArray<T>& getCorrelation()
     {
         return reduceAndReturn(m_correlation_function.getBinCounts());
     }
 
+    //! Get the standard error of the correlation function estimated from the batches of sampled query points.
+    /*! The errors are zero if the query points were not sampled.
+     */
+    const util::ManagedArray<float>& getCorrelationStandardError()
+    {
+        return reduceAndReturn(m_correlation_error);
+    }
+
 private:
     // Typedef thread local histogram type for use in code.
     using CFThreadHistogram = typename util::Histogram<T>::ThreadLocalHistogram;
-
-    util::Histogram<T> m_correlation_function;      //!< The correlation function
-    CFThreadHistogram m_local_correlation_function; //!< Thread local copy of the correlation function
+    using PairCountThreadHistogram = util::Histogram<double>::ThreadLocalHistogram;
+
+    //! Accumulate the correlation function of all pairs of points from the cross-correlation of the mesh.
+    void accumulateMesh(const freud::locality::NeighborQuery* neighbor_query, const T* values,
+                        const vec3<float>* query_points, const T* query_values, unsigned int n_query_points,
+                        const freud::locality::NeighborList* nlist, const freud::locality::QueryArgs& qargs);
+
+    vec3<unsigned int> m_mesh; //!< Number of mesh cells in each dimension
+
+    util::Histogram<T> m_correlation_function;         //!< The correlation function
+    CFThreadHistogram m_local_correlation_function;    //!< Thread local copy of the correlation function
+    util::Histogram<double> m_mesh_pair_counts;        //!< Pair counts accumulated on the mesh
+    PairCountThreadHistogram m_local_mesh_pair_counts; //!< Thread local copy of the mesh pair counts
+    std::vector<CFThreadHistogram>
+        m_batch_correlation_functions;       //!< Thread local correlation sums of each batch of query points
+    util::ManagedArray<float> m_correlation_error; //!< Standard error of the correlation function
 };
 
 }; }; // end namespace freud::density
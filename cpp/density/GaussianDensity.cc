@@ -1,10 +1,15 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <stdexcept>
+#include <vector>
 
+#include "FFT.h"
 #include "GaussianDensity.h"
+#include "utils.h"
 
 /*! \file GaussianDensity.cc
     \brief Routines for computing Gaussian smeared densities from points.
@@ -12,8 +17,92 @@
 
 namespace freud { namespace density {
 
-GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma)
-    : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_has_computed(false)
+namespace {
+
+//! Deposit points on a grid in parallel over slabs of the first grid dimension.
+/*! Each task owns a contiguous range of layers of the grid along x and only
+ *  writes to voxels in those layers, so all tasks deposit into the same grid
+ *  and the memory used does not grow with the number of threads. The points
+ *  are bucketed by the x bin of their center, and each task is given the
+ *  points of every bucket within bin_cut layers of its own. Slabs are at
+ *  least bin_cut layers thick, so that each point is handed to only a few
+ *  slabs regardless of how finely the loop is split.
+ *
+ *  \param n_points The number of points.
+ *  \param width The number of grid layers along x.
+ *  \param periodic Whether the grid is periodic along x.
+ *  \param bin_cut The maximum distance in layers from the center bin of a point to the layers it touches.
+ *  \param center_bin Function returning the (possibly out of range) x bin of the center of a point.
+ *  \param deposit Function with signature (size_t slab_begin, size_t slab_end, const std::vector<unsigned
+ *         int>& slab_points) that deposits the given points on the layers in [slab_begin, slab_end) only.
+ */
+template<typename CenterBin, typename Deposit>
+void depositBySlabs(unsigned int n_points, unsigned int width, bool periodic, int bin_cut,
+                    const CenterBin& center_bin, const Deposit& deposit)
+{
+    const auto int_width = static_cast<int>(width);
+    std::vector<unsigned int> bucket_offsets(width + 1, 0);
+    std::vector<unsigned int> point_buckets(n_points);
+    for (unsigned int idx = 0; idx < n_points; ++idx)
+    {
+        // Points outside aperiodic grids are assigned to the nearest edge bucket.
+        const int bin = center_bin(idx);
+        point_buckets[idx] = static_cast<unsigned int>(
+            periodic ? util::modulusPositive(bin, int_width) : std::max(0, std::min(bin, int_width - 1)));
+        ++bucket_offsets[point_buckets[idx] + 1];
+    }
+    for (unsigned int bucket = 0; bucket < width; ++bucket)
+    {
+        bucket_offsets[bucket + 1] += bucket_offsets[bucket];
+    }
+    std::vector<unsigned int> bucket_points(n_points);
+    std::vector<unsigned int> bucket_ends(bucket_offsets.begin(), bucket_offsets.end() - 1);
+    for (unsigned int idx = 0; idx < n_points; ++idx)
+    {
+        bucket_points[bucket_ends[point_buckets[idx]]++] = idx;
+    }
+
+    const size_t slab_width = std::max(bin_cut, 1);
+    const size_t num_slabs = (width + slab_width - 1) / slab_width;
+    util::forLoopWrapper(0, num_slabs, [&](size_t begin, size_t end) {
+        const size_t slab_begin = begin * slab_width;
+        const size_t slab_end = std::min(end * slab_width, static_cast<size_t>(width));
+        std::vector<unsigned int> slab_points;
+        const auto add_bucket = [&](int bucket) {
+            slab_points.insert(slab_points.end(), bucket_points.begin() + bucket_offsets[bucket],
+                               bucket_points.begin() + bucket_offsets[bucket + 1]);
+        };
+        const int first_bucket = static_cast<int>(slab_begin) - bin_cut;
+        const int last_bucket = static_cast<int>(slab_end) + bin_cut;
+        if (periodic && last_bucket - first_bucket >= int_width)
+        {
+            for (int bucket = 0; bucket < int_width; ++bucket)
+            {
+                add_bucket(bucket);
+            }
+        }
+        else if (periodic)
+        {
+            for (int bucket = first_bucket; bucket < last_bucket; ++bucket)
+            {
+                add_bucket(util::modulusPositive(bucket, int_width));
+            }
+        }
+        else
+        {
+            for (int bucket = std::max(first_bucket, 0); bucket < std::min(last_bucket, int_width); ++bucket)
+            {
+                add_bucket(bucket);
+            }
+        }
+        deposit(slab_begin, slab_end, slab_points);
+    });
+}
+
+} // namespace
+
+GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma, bool use_fft)
+    : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_use_fft(use_fft), m_has_computed(false)
 {
     if (r_max <= 0)
     {
@@ -27,6 +116,22 @@ const util::ManagedArray<float>& GaussianDensity::getDensity() const
     return m_density_array;
 }
 
+size_t GaussianDensity::estimateMemory(const box::Box& box, unsigned int n_points,
+                                       unsigned int num_channels) const
+{
+    return getMemory(box, n_points, num_channels, useFFTWithinBudget(box, n_points, num_channels));
+}
+
+size_t GaussianDensity::getMemory(const box::Box& box, unsigned int n_points, unsigned int num_channels,
+                                  bool use_fft) const
+{
+    const size_t num_voxels = static_cast<size_t>(m_width.x) * m_width.y * (box.is2D() ? 1 : m_width.z);
+    const size_t grid_memory = num_voxels * std::max(num_channels, 1U)
+        * (use_fft ? sizeof(float) + sizeof(std::complex<float>) : sizeof(float));
+    // The points are bucketed by their slab of the grid.
+    return grid_memory + static_cast<size_t>(n_points) * 3 * sizeof(unsigned int);
+}
+
 //! Get width.
 vec3<unsigned int> GaussianDensity::getWidth()
 {
@@ -34,7 +139,8 @@ vec3<unsigned int> GaussianDensity::getWidth()
 }
 
 //! Compute the density array.
-void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const float* values)
+void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const float* values,
+                              unsigned int num_channels)
 {
     // set the number of dimensions for the calculation the first time it is done
     if (!m_has_computed || nq->getBox().is2D() == m_box.is2D())
@@ -49,8 +155,6 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
                                     "number of dimensions.");
     }
 
-    auto n_points = nq->getNPoints();
-
     // if the user gives a single number for width, but the nq box is 2D, and
     // we want a 2D calculation
     if (m_box.is2D())
@@ -58,8 +162,54 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
         m_width.z = 1;
     }
 
-    m_density_array.prepare({m_width.x, m_width.y, m_width.z});
-    util::ThreadStorage<float> local_bin_counts({m_width.x, m_width.y, m_width.z});
+    m_num_channels = num_channels;
+    if (m_num_channels == 0)
+    {
+        m_density_array.prepare({m_width.x, m_width.y, m_width.z});
+    }
+    else
+    {
+        m_density_array.prepare({m_num_channels, m_width.x, m_width.y, m_width.z});
+    }
+
+    const bool orthorhombic = m_box.getTiltFactorXY() == 0 && m_box.getTiltFactorXZ() == 0
+        && m_box.getTiltFactorYZ() == 0;
+    if (m_use_fft)
+    {
+        const vec3<bool> periodic = m_box.getPeriodic();
+        if (!orthorhombic || !periodic.x || !periodic.y || (!m_box.is2D() && !periodic.z))
+        {
+            throw std::invalid_argument("GaussianDensity can only use FFT convolution for orthorhombic boxes "
+                                        "that are periodic in all dimensions.");
+        }
+    }
+    if (useFFTWithinBudget(m_box, nq->getNPoints(), m_num_channels))
+    {
+        computeFFT(nq, values);
+    }
+    else
+    {
+        // The kernels are specialized for the type of box, so the
+        // dimensionality and tilt checks are resolved at compile time.
+        m_box.withBoxTraits([&](auto traits) {
+            using BoxTraits = decltype(traits);
+            if (BoxTraits::is_orthorhombic)
+            {
+                computeSeparable<BoxTraits>(nq, values);
+            }
+            else
+            {
+                computeStencil<BoxTraits>(nq, values);
+            }
+        });
+    }
+}
+
+//! Deposit the Gaussian of every point on the grid voxel by voxel.
+template<typename BoxTraits>
+void GaussianDensity::computeStencil(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    auto n_points = nq->getNPoints();
 
     // set up some constants first
     const float Lx = m_box.getLx();
@@ -69,46 +219,55 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
 
     const float grid_size_x = Lx / static_cast<float>(m_width.x);
     const float grid_size_y = Ly / static_cast<float>(m_width.y);
-    const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
+    const float grid_size_z = BoxTraits::is_2d ? 0 : Lz / static_cast<float>(m_width.z);
 
     // Find the number of bins within r_max
     const int bin_cut_x = int(m_r_max / grid_size_x);
     const int bin_cut_y = int(m_r_max / grid_size_y);
-    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    const int bin_cut_z = BoxTraits::is_2d ? 0 : int(m_r_max / grid_size_z);
     const float r_max_sq = m_r_max * m_r_max;
     const float sigmasq = m_sigma * m_sigma;
-    const float normalization_base = float(1.0) / std::sqrt(constants::TWO_PI * sigmasq);
-    const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
-    const float normalization = std::pow(normalization_base, dimensions);
+    const float normalization = getNormalization();
+    const unsigned int num_channels = std::max(m_num_channels, 1U);
+    const size_t channel_size = static_cast<size_t>(m_width.x) * m_width.y * m_width.z;
 
-    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
-        // for each reference point
-        for (size_t idx = begin; idx < end; ++idx)
+    float* const density = m_density_array.get();
+    const auto center_bin
+        = [&](unsigned int idx) { return int(((*nq)[idx].x + Lx / float(2.0)) / grid_size_x); };
+    const auto deposit = [&](size_t slab_begin, size_t slab_end, const std::vector<unsigned int>& points) {
+        // for each reference point near the slab
+        for (const auto idx : points)
         {
             const vec3<float> point = (*nq)[idx];
-            const float value = (values != nullptr) ? values[idx] : 1.0f;
+            const float* const point_values
+                = (values != nullptr) ? values + static_cast<size_t>(idx) * num_channels : nullptr;
 
             // Find which bin the particle is in
-            int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
-            int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
-            int bin_z = int((point.z + Lz / float(2.0)) / grid_size_z);
+            const int bin_x = center_bin(idx);
+            const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
 
             // In 2D, only loop over the z=0 plane
-            if (m_box.is2D())
-            {
-                bin_z = 0;
-            }
+            const int bin_z = BoxTraits::is_2d ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
 
-            // Reject bins that are outside the box in aperiodic directions
-            // Only evaluate over bins that are within the cutoff
-            for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+            // Reject bins that are outside the box in aperiodic directions or
+            // outside of this slab. Only evaluate over bins that are within the
+            // cutoff. The z dimension is contiguous in memory, so it is the innermost loop.
+            for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
             {
-                if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                {
+                    continue;
+                }
+
+                // Assure that out of range indices are corrected for storage
+                // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                const unsigned int ni = (i + m_width.x) % m_width.x;
+                if (ni < slab_begin || ni >= slab_end)
                 {
                     continue;
                 }
-                const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0)) - point.z
-                    - (Lz / float(2.0));
+                const float dx = (grid_size_x * static_cast<float>(i)) + (grid_size_x / float(2.0)) - point.x
+                    - (Lx / float(2.0));
 
                 for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
                 {
@@ -116,47 +275,324 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
                     {
                         continue;
                     }
+                    const unsigned int nj = (j + m_width.y) % m_width.y;
                     const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
                         - point.y - (Ly / float(2.0));
+                    float* const row = density + (static_cast<size_t>(ni) * m_width.y + nj) * m_width.z;
 
-                    for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                    for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
                     {
-                        if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                        if (!periodic.z && (k < 0 || k >= int(m_width.z)))
                         {
                             continue;
                         }
-                        const float dx = (grid_size_x * static_cast<float>(i)) + (grid_size_x / float(2.0))
-                            - point.x - (Lx / float(2.0));
+                        const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0))
+                            - point.z - (Lz / float(2.0));
 
                         // Calculate the distance from the particle to the grid cell
-                        const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                        const vec3<float> delta = m_box.wrap<BoxTraits>(vec3<float>(dx, dy, dz));
 
                         const float r_sq = dot(delta, delta);
 
                         // Check to see if this distance is within the specified r_max
                         if (r_sq < r_max_sq)
                         {
-                            // Evaluate the gaussian
-                            const float gaussian
-                                = value * normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
-
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
-                            const unsigned int nj = (j + m_width.y) % m_width.y;
-                            const unsigned int nk = (k + m_width.z) % m_width.z;
+                            // Evaluate the gaussian once for all channels
+                            const float exponential = std::exp(-r_sq / (float(2.0) * sigmasq));
 
                             // Store the gaussian contribution
-                            local_bin_counts.local()(ni, nj, nk) += gaussian;
+                            float* voxel = row + (k + m_width.z) % m_width.z;
+                            for (unsigned int c = 0; c < num_channels; ++c, voxel += channel_size)
+                            {
+                                const float value = (point_values != nullptr) ? point_values[c] : 1.0f;
+                                *voxel += value * normalization * exponential;
+                            }
                         }
                     }
                 }
             }
         }
-    });
+    };
+    depositBySlabs(n_points, m_width.x, periodic.x, bin_cut_x, center_bin, deposit);
+}
+
+//! Deposit the Gaussian of every point on the grid as a product of 1D Gaussians.
+/*! In an orthorhombic box the minimum image of the vector from a point to a
+ *  voxel can be found separately along each dimension, and the Gaussian is
+ *  the product of 1D Gaussians along each dimension. The 1D factors are
+ *  computed once per point, so no exponentials are evaluated per voxel.
+ */
+template<typename BoxTraits>
+void GaussianDensity::computeSeparable(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    auto n_points = nq->getNPoints();
+
+    const vec3<float> L = m_box.getL();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const vec3<float> grid_size(L.x / static_cast<float>(m_width.x), L.y / static_cast<float>(m_width.y),
+                                BoxTraits::is_2d ? 0 : L.z / static_cast<float>(m_width.z));
+    const vec3<int> bin_cut(int(m_r_max / grid_size.x), int(m_r_max / grid_size.y),
+                            BoxTraits::is_2d ? 0 : int(m_r_max / grid_size.z));
+    const float r_max_sq = m_r_max * m_r_max;
+    const float sigmasq = m_sigma * m_sigma;
+    const float normalization = getNormalization();
+    const unsigned int num_channels = std::max(m_num_channels, 1U);
+    const size_t channel_size = static_cast<size_t>(m_width.x) * m_width.y * m_width.z;
+
+    //! Voxels within the cutoff along one dimension, with their 1D Gaussian factors.
+    struct AxisWeights
+    {
+        std::vector<unsigned int> bin; //!< Index of the voxel.
+        std::vector<float> r_sq;       //!< Squared distance to the voxel along this dimension.
+        std::vector<float> weight;     //!< 1D Gaussian factor of the voxel.
+    };
 
-    // Parallel reduction over thread storage
-    local_bin_counts.reduceInto(m_density_array);
+    float* const density = m_density_array.get();
+    const auto center_bin
+        = [&](unsigned int idx) { return int(((*nq)[idx].x + L.x / float(2.0)) / grid_size.x); };
+    const auto deposit = [&](size_t slab_begin, size_t slab_end, const std::vector<unsigned int>& points) {
+        AxisWeights axes[3];
+        std::vector<float> channel_weights_x(num_channels);
+        std::vector<float> channel_weights_xy(num_channels);
+
+        // for each reference point near the slab
+        for (const auto idx : points)
+        {
+            const vec3<float> point = (*nq)[idx];
+            const float point_coords[3] = {point.x, point.y, point.z};
+            const float L_coords[3] = {L.x, L.y, L.z};
+            const float grid_size_coords[3] = {grid_size.x, grid_size.y, grid_size.z};
+            const int bin_cut_coords[3] = {bin_cut.x, bin_cut.y, bin_cut.z};
+            const bool periodic_coords[3] = {periodic.x, periodic.y, periodic.z};
+            const unsigned int width_coords[3] = {m_width.x, m_width.y, m_width.z};
+
+            for (unsigned int d = 0; d < 3; ++d)
+            {
+                auto& axis = axes[d];
+                axis.bin.clear();
+                axis.r_sq.clear();
+                axis.weight.clear();
+
+                // Find which bin the particle is in. In 2D, only the z=0 plane is used.
+                const int bin = (d == 2 && BoxTraits::is_2d)
+                    ? 0
+                    : int((point_coords[d] + L_coords[d] / float(2.0)) / grid_size_coords[d]);
+                for (int i = bin - bin_cut_coords[d]; i <= bin + bin_cut_coords[d]; i++)
+                {
+                    // Reject bins that are outside the box in aperiodic directions
+                    // or outside of this slab
+                    if (!periodic_coords[d] && (i < 0 || i >= int(width_coords[d])))
+                    {
+                        continue;
+                    }
+
+                    // Assure that out of range indices are corrected for storage
+                    // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                    const unsigned int ni = (i + width_coords[d]) % width_coords[d];
+                    if (d == 0 && (ni < slab_begin || ni >= slab_end))
+                    {
+                        continue;
+                    }
+                    vec3<float> delta(0, 0, 0);
+                    float* delta_coords[3] = {&delta.x, &delta.y, &delta.z};
+                    *delta_coords[d] = (grid_size_coords[d] * static_cast<float>(i))
+                        + (grid_size_coords[d] / float(2.0)) - point_coords[d] - (L_coords[d] / float(2.0));
+                    delta = m_box.wrap<BoxTraits>(delta);
+                    const float r_sq = *delta_coords[d] * *delta_coords[d];
+                    axis.bin.push_back(ni);
+                    axis.r_sq.push_back(r_sq);
+                    axis.weight.push_back(std::exp(-r_sq / (float(2.0) * sigmasq)));
+                }
+
+                // Points that do not reach this slab need no further work.
+                if (axes[0].bin.empty())
+                {
+                    break;
+                }
+            }
+
+            // The z dimension is contiguous in memory, so it is the innermost
+            // loop, and rows of the grid are indexed directly. The 1D factors
+            // are shared by all channels.
+            for (size_t i = 0; i < axes[0].bin.size(); ++i)
+            {
+                for (unsigned int c = 0; c < num_channels; ++c)
+                {
+                    const float value
+                        = (values != nullptr) ? values[static_cast<size_t>(idx) * num_channels + c] : 1.0f;
+                    channel_weights_x[c] = value * normalization * axes[0].weight[i];
+                }
+                for (size_t j = 0; j < axes[1].bin.size(); ++j)
+                {
+                    const float r_sq_xy = axes[0].r_sq[i] + axes[1].r_sq[j];
+                    for (unsigned int c = 0; c < num_channels; ++c)
+                    {
+                        channel_weights_xy[c] = channel_weights_x[c] * axes[1].weight[j];
+                    }
+                    float* row = density
+                        + (static_cast<size_t>(axes[0].bin[i]) * m_width.y + axes[1].bin[j]) * m_width.z;
+                    for (unsigned int c = 0; c < num_channels; ++c, row += channel_size)
+                    {
+                        for (size_t k = 0; k < axes[2].bin.size(); ++k)
+                        {
+                            // Check to see if this distance is within the specified r_max
+                            if (r_sq_xy + axes[2].r_sq[k] < r_max_sq)
+                            {
+                                row[axes[2].bin[k]] += channel_weights_xy[c] * axes[2].weight[k];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+    depositBySlabs(n_points, m_width.x, periodic.x, bin_cut.x, center_bin, deposit);
+}
+
+//! Convolve the points with a Gaussian using fast Fourier transforms.
+/*! The values of the points are assigned to the grid with the cloud-in-cell
+ *  (linear) window. The grid is transformed, divided by the transform of the
+ *  window, multiplied by the transform of the Gaussian, and transformed back.
+ *  The Gaussian is not truncated at r_max. This is accurate when sigma spans
+ *  a few voxels, and its cost does not depend on sigma.
+ */
+void GaussianDensity::computeFFT(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    auto n_points = nq->getNPoints();
+
+    const vec3<float> L = m_box.getL();
+    const unsigned int width_coords[3] = {m_width.x, m_width.y, m_width.z};
+    const float L_coords[3] = {L.x, L.y, L.z};
+    const unsigned int dimensions = m_box.is2D() ? 2 : 3;
+
+    // Voxel centers are at (n + 1/2) * grid_size - L / 2 along each dimension,
+    // so the lower voxel of a point along each dimension is floor(u).
+    const auto grid_coordinate = [&](const vec3<float>& point, unsigned int d) {
+        const float point_coords[3] = {point.x, point.y, point.z};
+        return (point_coords[d] / L_coords[d] + float(0.5)) * static_cast<float>(width_coords[d])
+            - float(0.5);
+    };
+    const auto center_bin = [&](unsigned int idx) {
+        return static_cast<int>(std::floor(grid_coordinate(m_box.wrap((*nq)[idx]), 0)));
+    };
+    const unsigned int num_channels = std::max(m_num_channels, 1U);
+    std::vector<util::ManagedArray<std::complex<float>>> grids;
+    grids.reserve(num_channels);
+    for (unsigned int c = 0; c < num_channels; ++c)
+    {
+        grids.emplace_back(std::vector<size_t> {m_width.x, m_width.y, m_width.z});
+    }
+    const auto deposit = [&](size_t slab_begin, size_t slab_end, const std::vector<unsigned int>& points) {
+        for (const auto idx : points)
+        {
+            const vec3<float> point = m_box.wrap((*nq)[idx]);
+            unsigned int bins[3][2] = {{0, 0}, {0, 0}, {0, 0}};
+            float weights[3][2] = {{1, 0}, {1, 0}, {1, 0}};
+            for (unsigned int d = 0; d < dimensions; ++d)
+            {
+                const auto width = static_cast<int>(width_coords[d]);
+                const float u = grid_coordinate(point, d);
+                const float lower = std::floor(u);
+                const int lower_bin = static_cast<int>(lower);
+                bins[d][0] = static_cast<unsigned int>(util::modulusPositive(lower_bin, width));
+                bins[d][1] = static_cast<unsigned int>(util::modulusPositive(lower_bin + 1, width));
+                weights[d][1] = u - lower;
+                weights[d][0] = float(1.0) - weights[d][1];
+            }
+            for (unsigned int i = 0; i < 2; ++i)
+            {
+                if (bins[0][i] < slab_begin || bins[0][i] >= slab_end)
+                {
+                    continue;
+                }
+                for (unsigned int j = 0; j < 2; ++j)
+                {
+                    for (unsigned int k = 0; k < 2; ++k)
+                    {
+                        const size_t voxel
+                            = (static_cast<size_t>(bins[0][i]) * m_width.y + bins[1][j]) * m_width.z
+                            + bins[2][k];
+                        for (unsigned int c = 0; c < num_channels; ++c)
+                        {
+                            const float value
+                                = (values != nullptr) ? values[static_cast<size_t>(idx) * num_channels + c]
+                                                      : 1.0f;
+                            grids[c][voxel] += value * weights[0][i] * weights[1][j] * weights[2][k];
+                        }
+                    }
+                }
+            }
+        }
+    };
+    depositBySlabs(n_points, m_width.x, true, 1, center_bin, deposit);
+
+    // Tabulate the Gaussian and the inverse of the window along each
+    // dimension for the signed frequency of each grid index.
+    const float sigmasq = m_sigma * m_sigma;
+    std::vector<float> factors[3];
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        const unsigned int width = width_coords[d];
+        factors[d].resize(width);
+        for (unsigned int n = 0; n < width; ++n)
+        {
+            if (d >= dimensions)
+            {
+                factors[d][n] = 1;
+                continue;
+            }
+            const int signed_n = static_cast<int>(n);
+            const int signed_width = static_cast<int>(width);
+            const auto m = static_cast<float>((2 * n < width) ? signed_n : signed_n - signed_width);
+            const float k = constants::TWO_PI * m / L_coords[d];
+            const float window = util::sinc(static_cast<float>(M_PI) * m / static_cast<float>(width));
+            factors[d][n] = std::exp(-sigmasq * k * k / float(2.0)) / (window * window);
+        }
+    }
+
+    // The inverse transform of the spectrum gives the density multiplied by the voxel volume.
+    float voxel_volume = 1;
+    for (unsigned int d = 0; d < dimensions; ++d)
+    {
+        voxel_volume *= L_coords[d] / static_cast<float>(width_coords[d]);
+    }
+
+    // Each channel is convolved separately, with FFTs parallelized over the lines of the grid.
+    for (unsigned int c = 0; c < num_channels; ++c)
+    {
+        auto& grid = grids[c];
+        util::fft3D(grid);
+        util::forLoopWrapper(0, m_width.x, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                for (size_t j = 0; j < m_width.y; ++j)
+                {
+                    const float factor_xy = factors[0][i] * factors[1][j];
+                    std::complex<float>* const row = grid.get() + (i * m_width.y + j) * m_width.z;
+                    for (size_t k = 0; k < m_width.z; ++k)
+                    {
+                        row[k] *= factor_xy * factors[2][k];
+                    }
+                }
+            }
+        });
+        util::fft3D(grid, true);
+
+        float* const density = m_density_array.get() + c * grid.size();
+        for (size_t i = 0; i < grid.size(); ++i)
+        {
+            density[i] = grid[i].real() / voxel_volume;
+        }
+    }
+}
+
+//! Get the normalization of the Gaussian in the dimensionality of the box.
+float GaussianDensity::getNormalization() const
+{
+    const float sigmasq = m_sigma * m_sigma;
+    const float normalization_base = float(1.0) / std::sqrt(constants::TWO_PI * sigmasq);
+    const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
+    return std::pow(normalization_base, dimensions);
 }
 
 }; }; // end namespace freud::density
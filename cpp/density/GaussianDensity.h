@@ -7,7 +7,7 @@
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
-#include "ThreadStorage.h"
+#include "tbb_config.h"
 #include "VectorMath.h"
 
 /*! \file GaussianDensity.h
@@ -19,13 +19,19 @@ namespace freud { namespace density {
 //! Computes the density of a system on a grid.
 /*! Replaces particle positions with a gaussian and calculates the
         contribution from the grid based upon the distance of the grid cell
-        from the center of the Gaussian.
+        from the center of the Gaussian. Alternatively, the points can be
+        convolved with an untruncated Gaussian using fast Fourier transforms,
+        which is faster when sigma spans many grid cells.
+
+        Several values per point can be smeared at once into a grid with one
+        channel per value. The Gaussian weight of each voxel is then computed
+        once and added to every channel.
 */
 class GaussianDensity
 {
 public:
     //! Constructor
-    GaussianDensity(vec3<unsigned int> width, float r_max, float sigma);
+    GaussianDensity(vec3<unsigned int> width, float r_max, float sigma, bool use_fft = false);
 
     // Destructor
     ~GaussianDensity() = default;
@@ -48,20 +54,78 @@ public:
         return m_r_max;
     }
 
-    //! Compute the density.
-    void compute(const freud::locality::NeighborQuery* nq, const float* values = nullptr);
+    //! Return whether the density is computed by FFT convolution.
+    bool getUseFFT() const
+    {
+        return m_use_fft;
+    }
 
-    //! Get a reference to the last computed density.
+    //! Compute the density.
+    /*! \param nq The points.
+     *  \param values The values of the points, with shape (N, num_channels), or
+     *         nullptr to smear a value of 1 for every point.
+     *  \param num_channels The number of values of each point, or 0 if values
+     *         holds one value per point and the density has no channel dimension.
+     */
+    void compute(const freud::locality::NeighborQuery* nq, const float* values = nullptr,
+                 unsigned int num_channels = 0);
+
+    //! Estimate the peak memory of compute in bytes.
+    /*! FFT convolution stores a complex grid per channel besides the
+     *  density. If that exceeds the memory budget (see
+     *  parallel::setMemoryBudget), compute deposits the Gaussians directly
+     *  into the density instead, truncated at r_max, and this estimates the
+     *  memory of the direct deposition.
+     *
+     *  \param box The box of the points.
+     *  \param n_points The number of points.
+     *  \param num_channels The number of values of each point, as in compute.
+     */
+    size_t estimateMemory(const box::Box& box, unsigned int n_points, unsigned int num_channels) const;
+
+    //! Get a reference to the last computed density, with shape ([num_channels,] w_x, w_y, w_z).
     const util::ManagedArray<float>& getDensity() const;
 
+    //! Get the number of channels of the last computed density (0 if it has no channel dimension).
+    unsigned int getNumChannels() const
+    {
+        return m_num_channels;
+    }
+
     vec3<unsigned int> getWidth();
 
 private:
-    box::Box m_box;             //!< Simulation box containing the points.
-    vec3<unsigned int> m_width; //!< Number of bins in the grid in each dimension.
-    float m_r_max;              //!< Max distance at which to compute density.
-    float m_sigma;              //!< Gaussian width sigma.
-    bool m_has_computed;        //!< Tracks whether a call to compute has been made.
+    //! Compute the density by evaluating the Gaussian at every grid cell within r_max.
+    template<typename BoxTraits>
+    void computeStencil(const freud::locality::NeighborQuery* nq, const float* values);
+
+    //! Compute the density in an orthorhombic box from 1D Gaussians along each dimension.
+    template<typename BoxTraits>
+    void computeSeparable(const freud::locality::NeighborQuery* nq, const float* values);
+
+    //! Compute the density by convolving the points with a Gaussian using FFTs.
+    void computeFFT(const freud::locality::NeighborQuery* nq, const float* values);
+
+    //! Get the memory of computing the density with or without FFT convolution.
+    size_t getMemory(const box::Box& box, unsigned int n_points, unsigned int num_channels,
+                     bool use_fft) const;
+
+    //! Get whether the density is computed by FFT convolution within the memory budget.
+    bool useFFTWithinBudget(const box::Box& box, unsigned int n_points, unsigned int num_channels) const
+    {
+        return m_use_fft && parallel::fitsMemoryBudget(getMemory(box, n_points, num_channels, true));
+    }
+
+    //! Get the normalization of the Gaussian.
+    float getNormalization() const;
+
+    box::Box m_box;                  //!< Simulation box containing the points.
+    vec3<unsigned int> m_width;      //!< Number of bins in the grid in each dimension.
+    float m_r_max;                   //!< Max distance at which to compute density.
+    float m_sigma;                   //!< Gaussian width sigma.
+    bool m_use_fft;                  //!< Whether to compute the density by FFT convolution.
+    bool m_has_computed;             //!< Tracks whether a call to compute has been made.
+    unsigned int m_num_channels {0}; //!< Number of values per point of the last compute.
 
     util::ManagedArray<float> m_density_array; //! Computed density array.
 };
@@ -1,6 +1,11 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "LocalDensity.h"
 #include "NeighborComputeFunctional.h"
 
@@ -10,6 +15,260 @@
 
 namespace freud { namespace density {
 
+namespace {
+
+//! Number of rows across the query cutoff along y and z in 3D.
+/*! Narrow rows leave fewer points to test near the cutoff, but more rows to visit.
+ */
+constexpr float ROWS_PER_R_MAX_3D = 3;
+
+//! Number of rows across the query cutoff along y in 2D, where far fewer rows are visited.
+constexpr float ROWS_PER_R_MAX_2D = 8;
+
+//! Fewest expected neighbors per query point for which counting in rows pays off.
+constexpr float MIN_NEIGHBORS_PER_QUERY = 128;
+
+//! Find the distances along one dimension between a point and the rows at an offset from its row.
+/*! \param offset Offset of the rows from the row of the point.
+ *  \param u Position of the point within its row, in [0, width].
+ *  \param width Width of the rows.
+ *  \param min_dist Smallest distance to the rows.
+ *  \param max_dist Largest distance to the rows.
+ */
+inline void getRowDistanceRange(int offset, float u, float width, float& min_dist, float& max_dist)
+{
+    const float lo = static_cast<float>(offset) * width - u;
+    const float hi = lo + width;
+    min_dist = (lo > 0) ? lo : ((hi < 0) ? -hi : 0);
+    max_dist = std::max(std::abs(lo), std::abs(hi));
+}
+
+//! Points of a periodic orthorhombic box sorted into rows along x.
+/*! The box is divided into rows of equal width along y and z that span the
+ *  box along x, and the points of each row are sorted by x. Positions are
+ *  wrapped into [0, L) along each dimension. The points of a row within any
+ *  range of x are contiguous, so they can be counted from the indices of the
+ *  ends of the range, which a lookup table of buckets along x finds within a
+ *  few steps. Indices are unrolled, i.e. they continue periodically across
+ *  the ends of a row.
+ */
+class PointRows
+{
+public:
+    //! Constructor
+    PointRows(const box::Box& box, const vec3<float>* points, unsigned int n_points, float width)
+        : m_box(box), m_L(box.getL()), m_Linv_x(box.getLinv().x),
+          m_dims(std::max(1U, static_cast<unsigned int>(m_L.y / width)),
+                 box.is2D() ? 1U : std::max(1U, static_cast<unsigned int>(m_L.z / width))),
+          m_widths(m_L.y / static_cast<float>(m_dims.x),
+                   box.is2D() ? 0 : m_L.z / static_cast<float>(m_dims.y)),
+          m_row_offsets(m_dims.x * m_dims.y + 1, 0), m_x(n_points), m_y(n_points), m_z(n_points),
+          m_positions(n_points), m_buckets(n_points + m_dims.x * m_dims.y)
+    {
+        // Counting sort of the points by row, followed by a sort of each row by x.
+        std::vector<vec3<float>> wrapped(n_points);
+        std::vector<unsigned int> rows(n_points);
+        for (unsigned int i = 0; i < n_points; ++i)
+        {
+            wrapped[i] = wrap(points[i]);
+            vec2<float> u;
+            const vec2<unsigned int> coords = getRowCoords(wrapped[i], u);
+            rows[i] = coords.x + m_dims.x * coords.y;
+            ++m_row_offsets[rows[i] + 1];
+        }
+        for (size_t row = 0; row < m_dims.x * m_dims.y; ++row)
+        {
+            m_row_offsets[row + 1] += m_row_offsets[row];
+        }
+        std::vector<unsigned int> indices(n_points);
+        std::vector<unsigned int> next(m_row_offsets.begin(), m_row_offsets.end() - 1);
+        for (unsigned int i = 0; i < n_points; ++i)
+        {
+            indices[next[rows[i]]++] = i;
+        }
+
+        util::forLoopWrapper(0, m_dims.x * m_dims.y, [&](size_t begin, size_t end) {
+            for (size_t row = begin; row < end; ++row)
+            {
+                const unsigned int row_begin = m_row_offsets[row];
+                const unsigned int row_end = m_row_offsets[row + 1];
+                std::sort(indices.begin() + row_begin, indices.begin() + row_end,
+                          [&](unsigned int i, unsigned int j) { return wrapped[i].x < wrapped[j].x; });
+                for (unsigned int k = row_begin; k < row_end; ++k)
+                {
+                    const unsigned int i = indices[k];
+                    m_x[k] = wrapped[i].x;
+                    m_y[k] = wrapped[i].y;
+                    m_z[k] = wrapped[i].z;
+                    m_positions[i] = k;
+                }
+
+                // Each row has as many buckets along x as points, so that a
+                // lookup lands within a few points of the searched position.
+                const float* x_begin = m_x.data() + row_begin;
+                const float* x_end = m_x.data() + row_end;
+                const unsigned int n_buckets = row_end - row_begin;
+                const float bucket_width = m_L.x / static_cast<float>(n_buckets);
+                for (unsigned int bucket = 0; bucket <= n_buckets; ++bucket)
+                {
+                    m_buckets[row_begin + row + bucket] = static_cast<unsigned int>(
+                        std::lower_bound(x_begin, x_end, static_cast<float>(bucket) * bucket_width)
+                        - x_begin);
+                }
+            }
+        });
+    }
+
+    //! Wrap a position into [0, L) along each dimension.
+    vec3<float> wrap(const vec3<float>& point) const
+    {
+        vec3<float> fraction = m_box.makeFractional(point);
+        fraction.x -= std::floor(fraction.x);
+        fraction.y -= std::floor(fraction.y);
+        fraction.z = m_box.is2D() ? 0 : fraction.z - std::floor(fraction.z);
+        return vec3<float>(fraction.x * m_L.x, fraction.y * m_L.y, fraction.z * m_L.z);
+    }
+
+    //! Get the row coordinates of a wrapped position and the position u within the row along y and z.
+    vec2<unsigned int> getRowCoords(const vec3<float>& wrapped, vec2<float>& u) const
+    {
+        u.y = 0;
+        return vec2<unsigned int>(getRowCoord(wrapped.y, m_dims.x, m_widths.x, u.x),
+                                  m_box.is2D() ? 0 : getRowCoord(wrapped.z, m_dims.y, m_widths.y, u.y));
+    }
+
+    //! Get the indices of a set of points ordered by the row they fall into.
+    std::vector<unsigned int> getRowOrder(const vec3<float>* points, unsigned int n_points) const
+    {
+        std::vector<unsigned int> rows(n_points);
+        std::vector<unsigned int> next(m_dims.x * m_dims.y + 1, 0);
+        for (unsigned int i = 0; i < n_points; ++i)
+        {
+            vec2<float> u;
+            const vec2<unsigned int> coords = getRowCoords(wrap(points[i]), u);
+            rows[i] = coords.x + m_dims.x * coords.y;
+            ++next[rows[i] + 1];
+        }
+        for (size_t row = 0; row < m_dims.x * m_dims.y; ++row)
+        {
+            next[row + 1] += next[row];
+        }
+        std::vector<unsigned int> order(n_points);
+        for (unsigned int i = 0; i < n_points; ++i)
+        {
+            order[next[rows[i]]++] = i;
+        }
+        return order;
+    }
+
+    //! Get the number of rows along y and z.
+    const vec2<unsigned int>& getDims() const
+    {
+        return m_dims;
+    }
+
+    //! Get the widths of the rows along y and z.
+    const vec2<float>& getWidths() const
+    {
+        return m_widths;
+    }
+
+    //! Get the unrolled index in a row of the first point at or beyond x along x.
+    /*! x must lie in [-L.x, 2 L.x). The row must not be empty.
+     */
+    int getUnrolledIndex(unsigned int row, float x) const
+    {
+        const int row_size = static_cast<int>(getRowSize(row));
+        int image = 0;
+        if (x < 0)
+        {
+            x += m_L.x;
+            image = -row_size;
+        }
+        else if (x >= m_L.x)
+        {
+            x -= m_L.x;
+            image = row_size;
+        }
+
+        // Start from the bucket of x and correct for the rounding of the bucket.
+        const float* row_x = m_x.data() + m_row_offsets[row];
+        const int bucket
+            = std::min(static_cast<int>(x * m_Linv_x * static_cast<float>(row_size)), row_size - 1);
+        int local = static_cast<int>(m_buckets[m_row_offsets[row] + row + bucket]);
+        while (local > 0 && row_x[local - 1] >= x)
+        {
+            --local;
+        }
+        while (local < row_size && row_x[local] < x)
+        {
+            ++local;
+        }
+        return local + image;
+    }
+
+    //! Get the number of points in a row.
+    unsigned int getRowSize(unsigned int row) const
+    {
+        return m_row_offsets[row + 1] - m_row_offsets[row];
+    }
+
+    //! Get the sorted index of the first point of a row.
+    unsigned int getRowOffset(unsigned int row) const
+    {
+        return m_row_offsets[row];
+    }
+
+    //! Get the sorted index of the point with the given index.
+    unsigned int getPosition(unsigned int point) const
+    {
+        return m_positions[point];
+    }
+
+    //! Get one wrapped coordinate (0, 1 or 2 for x, y or z) of the sorted points.
+    const float* getCoordinates(unsigned int dim) const
+    {
+        return (dim == 0) ? m_x.data() : ((dim == 1) ? m_y.data() : m_z.data());
+    }
+
+private:
+    //! Get the row coordinate along one dimension from a wrapped coordinate.
+    static unsigned int getRowCoord(float wrapped, unsigned int dim, float width, float& u)
+    {
+        const unsigned int coord = std::min(static_cast<unsigned int>(wrapped / width), dim - 1);
+        u = wrapped - static_cast<float>(coord) * width;
+        return coord;
+    }
+
+    box::Box m_box;                          //!< Box the points belong to.
+    vec3<float> m_L;                         //!< Box lengths.
+    float m_Linv_x;                          //!< Inverse of the box length along x.
+    vec2<unsigned int> m_dims;               //!< Number of rows along y and z.
+    vec2<float> m_widths;                    //!< Widths of the rows along y and z.
+    std::vector<unsigned int> m_row_offsets; //!< Sorted index of the first point of each row.
+    std::vector<float> m_x;                  //!< Wrapped x coordinates of the sorted points.
+    std::vector<float> m_y;                  //!< Wrapped y coordinates of the sorted points.
+    std::vector<float> m_z;                  //!< Wrapped z coordinates of the sorted points.
+    std::vector<unsigned int> m_positions;   //!< Sorted index of each point.
+    std::vector<unsigned int> m_buckets;     //!< First point of each row at or beyond each bucket.
+};
+
+//! Wrap a row coordinate that lies at most one box length outside the box.
+/*! \param coord Row coordinate.
+ *  \param n Number of rows along the dimension.
+ *  \param L Box length along the dimension.
+ *  \param shift Set to the shift of the periodic image of the row next to coord.
+ */
+inline unsigned int wrapRowCoord(int coord, unsigned int n, float L, float& shift)
+{
+    const int n_rows = static_cast<int>(n);
+    shift = (coord < 0) ? -L : ((coord >= n_rows) ? L : 0);
+    return static_cast<unsigned int>((coord < 0) ? coord + n_rows
+                                                 : ((coord >= n_rows) ? coord - n_rows : coord));
+}
+
+} // namespace
+
 LocalDensity::LocalDensity(float r_max, float diameter)
     : m_box(box::Box()), m_r_max(r_max), m_diameter(diameter)
 {
@@ -24,6 +283,219 @@ LocalDensity::LocalDensity(float r_max, float diameter)
     }
 }
 
+float LocalDensity::getNeighborWeight(float distance) const
+{
+    // count particles that are fully in the r_max sphere, which all point particles are
+    if (m_diameter == 0 || distance < (m_r_max - m_diameter / float(2.0)))
+    {
+        return float(1.0);
+    }
+    // partially count particles that intersect the r_max sphere
+    // this is not particularly accurate for a single particle, but works well on average for
+    // lots of them. It smooths out the neighbor count distributions and avoids noisy spikes
+    // that obscure data
+    return float(1.0) + (m_r_max - (distance + m_diameter / float(2.0))) / m_diameter;
+}
+
+bool LocalDensity::countNeighborsInRows(const freud::locality::NeighborQuery* neighbor_query,
+                                        const vec3<float>* query_points, unsigned int n_query_points,
+                                        const freud::locality::NeighborList* nlist,
+                                        const freud::locality::QueryArgs& qargs)
+{
+    const bool is_ball_query = (qargs.mode == freud::locality::QueryType::ball)
+        || (qargs.mode == freud::locality::QueryType::none
+            && qargs.num_neighbors == freud::locality::DEFAULT_NUM_NEIGHBORS
+            && qargs.r_max != freud::locality::DEFAULT_R_MAX);
+    const vec3<bool> periodic = m_box.getPeriodic();
+    if (nlist != nullptr || !is_ball_query || qargs.r_min != 0 || qargs.r_max <= 0
+        || !(periodic.x && periodic.y && (periodic.z || m_box.is2D())) || m_box.getTiltFactorXY() != 0
+        || m_box.getTiltFactorXZ() != 0 || m_box.getTiltFactorYZ() != 0)
+    {
+        return false;
+    }
+
+    // Only count in rows when there are enough neighbors to count in bulk, and
+    // leave cutoffs that a neighbor query would reject to the neighbor query.
+    const unsigned int n_points = neighbor_query->getNPoints();
+    const float r_cut = qargs.r_max;
+    const float ball_volume = m_box.is2D() ? static_cast<float>(M_PI) * r_cut * r_cut
+                                           : static_cast<float>(4.0 / 3.0 * M_PI) * r_cut * r_cut * r_cut;
+    const float expected_neighbors = static_cast<float>(n_points) / m_box.getVolume() * ball_volume;
+    const vec3<float> nearest_plane_distance = m_box.getNearestPlaneDistance();
+    const float min_plane_distance = m_box.is2D()
+        ? std::min(nearest_plane_distance.x, nearest_plane_distance.y)
+        : std::min(nearest_plane_distance.x, std::min(nearest_plane_distance.y, nearest_plane_distance.z));
+    if (!(expected_neighbors >= MIN_NEIGHBORS_PER_QUERY) || r_cut * 2 >= min_plane_distance)
+    {
+        return false;
+    }
+
+    const PointRows rows(m_box, neighbor_query->getPoints(), n_points,
+                         r_cut / (m_box.is2D() ? ROWS_PER_R_MAX_2D : ROWS_PER_R_MAX_3D));
+    const vec2<unsigned int> dims = rows.getDims();
+    const vec2<float> widths = rows.getWidths();
+    const vec3<float> L = m_box.getL();
+
+    // Points are only counted in bulk or skipped when they are clear of the
+    // cutoffs by a margin larger than the rounding of the distances between
+    // points, so only points within rounding of the cutoff may be counted
+    // differently than by a neighbor query.
+    const float margin = 1e-5F * (r_cut + std::max(L.x, std::max(L.y, L.z)));
+    const float half_diameter = m_diameter / float(2.0);
+    const float r_full
+        = (m_diameter > 0) ? m_r_max - half_diameter : std::numeric_limits<float>::infinity();
+    const float r_bulk = std::min(r_full, r_cut) - margin;
+    const float r_bulk_sq = (r_bulk > 0) ? r_bulk * r_bulk : -1;
+    const float r_skip_sq = (r_cut + margin) * (r_cut + margin);
+    const float r_cut_sq = r_cut * r_cut;
+    const vec2<int> ranges(static_cast<int>(std::ceil((r_cut + margin) / widths.x)),
+                           m_box.is2D() ? 0 : static_cast<int>(std::ceil((r_cut + margin) / widths.y)));
+    // Every row must be reached by a single offset, so that no row is visited twice.
+    if (2 * ranges.x + 1 > static_cast<int>(dims.x) || 2 * ranges.y + 1 > static_cast<int>(dims.y))
+    {
+        return false;
+    }
+
+    // Query points are visited by row, so that consecutive query points visit the same rows.
+    const std::vector<unsigned int> query_order = rows.getRowOrder(query_points, n_query_points);
+    const float* row_x = rows.getCoordinates(0);
+    const float* row_y = rows.getCoordinates(1);
+    const float* row_z = rows.getCoordinates(2);
+
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j)
+        {
+            const unsigned int i = query_order[j];
+            const vec3<float> query_point = rows.wrap(query_points[i]);
+            vec2<float> u;
+            const vec2<unsigned int> query_row = rows.getRowCoords(query_point, u);
+
+            // The point with the same index is not a neighbor when exclude_ii is set.
+            const bool exclude_self = qargs.exclude_ii && i < n_points;
+            const unsigned int self_position = exclude_self ? rows.getPosition(i) : 0;
+
+            unsigned int num_bulk = 0;
+            float num_boundary = 0;
+
+            // Test the points of a row with unrolled indices in [first, last),
+            // given the shift of the periodic image of the row next to the query point.
+            const auto test_points = [&](unsigned int row, int first, int last, const vec3<float>& shift) {
+                const int row_size = static_cast<int>(rows.getRowSize(row));
+                while (first < last)
+                {
+                    float shift_x = 0;
+                    int local = first;
+                    if (first < 0)
+                    {
+                        shift_x = -L.x;
+                        local += row_size;
+                    }
+                    else if (first >= row_size)
+                    {
+                        shift_x = L.x;
+                        local -= row_size;
+                    }
+                    const unsigned int n
+                        = static_cast<unsigned int>(std::min(last - first, row_size - local));
+                    const unsigned int offset = rows.getRowOffset(row) + static_cast<unsigned int>(local);
+                    const vec3<float> origin(query_point.x - shift.x - shift_x, query_point.y - shift.y,
+                                             query_point.z - shift.z);
+                    if (exclude_self && self_position - offset < n)
+                    {
+                        for (unsigned int k = offset; k < offset + n; ++k)
+                        {
+                            const vec3<float> delta(row_x[k] - origin.x, row_y[k] - origin.y,
+                                                    row_z[k] - origin.z);
+                            const float r_sq = dot(delta, delta);
+                            if (k != self_position && r_sq < r_cut_sq)
+                            {
+                                num_boundary += getNeighborWeight(std::sqrt(r_sq));
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // Same as getNeighborWeight, but without branches, since
+                        // whether a point is counted is unpredictable here.
+                        for (unsigned int k = offset; k < offset + n; ++k)
+                        {
+                            const vec3<float> delta(row_x[k] - origin.x, row_y[k] - origin.y,
+                                                    row_z[k] - origin.z);
+                            const float r_sq = dot(delta, delta);
+                            const float distance = std::sqrt(r_sq);
+                            const float partial
+                                = float(1.0) + (m_r_max - (distance + half_diameter)) / m_diameter;
+                            const float weight = (distance < r_full) ? float(1.0) : partial;
+                            num_boundary += (r_sq < r_cut_sq) ? weight : float(0.0);
+                        }
+                    }
+                    first += static_cast<int>(n);
+                }
+            };
+
+            for (int dz = -ranges.y; dz <= ranges.y; ++dz)
+            {
+                float min_z;
+                float max_z;
+                getRowDistanceRange(dz, u.y, widths.y, min_z, max_z);
+                vec3<float> shift;
+                const unsigned int row_z
+                    = wrapRowCoord(static_cast<int>(query_row.y) + dz, dims.y, L.z, shift.z);
+                for (int dy = -ranges.x; dy <= ranges.x; ++dy)
+                {
+                    float min_y;
+                    float max_y;
+                    getRowDistanceRange(dy, u.x, widths.x, min_y, max_y);
+                    const float min_yz_sq = min_y * min_y + min_z * min_z;
+                    if (min_yz_sq >= r_skip_sq)
+                    {
+                        continue;
+                    }
+                    const unsigned int row
+                        = wrapRowCoord(static_cast<int>(query_row.x) + dy, dims.x, L.y, shift.y)
+                        + dims.x * row_z;
+                    if (rows.getRowSize(row) == 0)
+                    {
+                        continue;
+                    }
+
+                    // Points of the row within s of the query point along x may be
+                    // neighbors, and those within t are neighbors.
+                    const float s = std::min(std::sqrt(r_skip_sq - min_yz_sq), L.x / 2);
+                    const int first = rows.getUnrolledIndex(row, query_point.x - s);
+                    const int last = rows.getUnrolledIndex(row, query_point.x + s);
+                    const float max_yz_sq = max_y * max_y + max_z * max_z;
+                    if (max_yz_sq >= r_bulk_sq)
+                    {
+                        test_points(row, first, last, shift);
+                        continue;
+                    }
+                    const float t = std::sqrt(r_bulk_sq - max_yz_sq);
+                    const int bulk_first = rows.getUnrolledIndex(row, query_point.x - t);
+                    const int bulk_last = rows.getUnrolledIndex(row, query_point.x + t);
+                    num_bulk += static_cast<unsigned int>(bulk_last - bulk_first);
+                    if (exclude_self && self_position - rows.getRowOffset(row) < rows.getRowSize(row))
+                    {
+                        // The range holds at most one periodic image of the point.
+                        const int local = static_cast<int>(self_position - rows.getRowOffset(row));
+                        const int row_size = static_cast<int>(rows.getRowSize(row));
+                        if ((local >= bulk_first && local < bulk_last)
+                            || (local - row_size >= bulk_first && local - row_size < bulk_last)
+                            || (local + row_size >= bulk_first && local + row_size < bulk_last))
+                        {
+                            --num_bulk;
+                        }
+                    }
+                    test_points(row, first, bulk_first, shift);
+                    test_points(row, bulk_last, last, shift);
+                }
+            }
+            m_num_neighbors_array[i] = static_cast<float>(num_bulk) + num_boundary;
+        }
+    });
+    return true;
+}
+
 void LocalDensity::compute(const freud::locality::NeighborQuery* neighbor_query,
                            const vec3<float>* query_points, unsigned int n_query_points,
                            const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
@@ -33,42 +505,28 @@ void LocalDensity::compute(const freud::locality::NeighborQuery* neighbor_query,
     m_density_array.prepare(n_query_points);
     m_num_neighbors_array.prepare(n_query_points);
 
+    if (!countNeighborsInRows(neighbor_query, query_points, n_query_points, nlist, qargs))
+    {
+        // Accumulate the number of neighbors of each query point. All bonds of a
+        // query point are visited by the same thread.
+        freud::locality::loopOverNeighborsByQueryPoint(
+            neighbor_query, query_points, n_query_points, qargs, nlist,
+            [&](const freud::locality::NeighborBond& nb) {
+                m_num_neighbors_array[nb.getQueryPointIdx()] += getNeighborWeight(nb.getDistance());
+            });
+    }
+
+    // local density is area (in 2D) or volume (in 3D) of particles divided by
+    // the area of the circle or the volume of the sphere
     const float area = M_PI * m_r_max * m_r_max;
     const float volume = static_cast<float>(4.0 / 3.0 * M_PI) * m_r_max * m_r_max * m_r_max;
-    // compute the local density
-    freud::locality::loopOverNeighborsIterator(
-        neighbor_query, query_points, n_query_points, qargs, nlist,
-        [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
-            float num_neighbors = 0;
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
-            {
-                // count particles that are fully in the r_max sphere
-                if (nb.getDistance() < (m_r_max - m_diameter / float(2.0)))
-                {
-                    num_neighbors += float(1.0);
-                }
-                else
-                {
-                    // partially count particles that intersect the r_max sphere
-                    // this is not particularly accurate for a single particle, but works well on average for
-                    // lots of them. It smooths out the neighbor count distributions and avoids noisy spikes
-                    // that obscure data
-                    num_neighbors
-                        += float(1.0) + (m_r_max - (nb.getDistance() + m_diameter / float(2.0))) / m_diameter;
-                }
-                m_num_neighbors_array[i] = num_neighbors;
-                if (m_box.is2D())
-                {
-                    // local density is area of particles divided by the area of the circle
-                    m_density_array[i] = m_num_neighbors_array[i] / area;
-                }
-                else
-                {
-                    // local density is volume of particles divided by the volume of the sphere
-                    m_density_array[i] = m_num_neighbors_array[i] / volume;
-                }
-            }
-        });
+    const float normalization = m_box.is2D() ? area : volume;
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_density_array[i] = m_num_neighbors_array[i] / normalization;
+        }
+    });
 }
 
 }; }; // end namespace freud::density
@@ -64,6 +64,25 @@ public:
     }
 
 private:
+    //! Get the contribution of a neighbor at the given distance to the number of neighbors.
+    float getNeighborWeight(float distance) const;
+
+    //! Count the neighbors of each query point in bulk from rows of points sorted along x.
+    /*! Points of a row that lie within r_max - diameter / 2 of a query point
+     *  for any position across the row each contribute one neighbor. They
+     *  form a contiguous range of the sorted row, so they are counted from
+     *  the indices of the ends of the range and only the points near the
+     *  ends need distance tests.
+     *
+     *  \returns Whether the neighbors were counted, which requires a ball
+     *           query without a neighbor list in a periodic orthorhombic box
+     *           with enough neighbors per query point to make the rows worthwhile.
+     */
+    bool countNeighborsInRows(const freud::locality::NeighborQuery* neighbor_query,
+                              const vec3<float>* query_points, unsigned int n_query_points,
+                              const freud::locality::NeighborList* nlist,
+                              const freud::locality::QueryArgs& qargs);
+
     box::Box m_box;   //!< Simulation box where the particles belong
     float m_r_max;    //!< Maximum neighbor distance
     float m_diameter; //!< Diameter of the particles
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <stdexcept>
+#include <utility>
+
+#include "PartialRDF.h"
+
+/*! \file PartialRDF.cc
+    \brief Routines for computing the radial density functions of all pairs of types.
+*/
+
+namespace freud { namespace density {
+
+PartialRDF::PartialRDF(unsigned int num_types, unsigned int bins, float r_max, float r_min)
+    : BondHistogramCompute(), m_num_types(num_types), m_bins(bins), m_n_points_of_type(num_types, 0),
+      m_n_query_points_of_type(num_types, 0)
+{
+    if (num_types == 0)
+    {
+        throw std::invalid_argument("PartialRDF requires a nonzero number of types.");
+    }
+    if (bins == 0)
+    {
+        throw std::invalid_argument("PartialRDF requires a nonzero number of bins.");
+    }
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("PartialRDF requires r_max to be positive.");
+    }
+    if (r_min < 0)
+    {
+        throw std::invalid_argument("PartialRDF requires r_min to be non-negative.");
+    }
+    if (r_max <= r_min)
+    {
+        throw std::invalid_argument("PartialRDF requires that r_max must be greater than r_min.");
+    }
+
+    // The types are binned on regular axes with one bin per type, so each
+    // bond is binned by its query point type, point type and length at once.
+    const auto num_types_f = static_cast<float>(num_types);
+    const auto axes = util::Axes {std::make_shared<util::RegularAxis>(num_types, 0, num_types_f),
+                                  std::make_shared<util::RegularAxis>(num_types, 0, num_types_f),
+                                  std::make_shared<util::RegularAxis>(bins, r_min, r_max)};
+    m_histogram = BondHistogram(axes);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+
+    // Precompute the cell volumes to speed up later calculations.
+    m_vol_array2D.resize(bins);
+    m_vol_array3D.resize(bins);
+    const float volume_prefactor = (float(4.0) / float(3.0)) * M_PI;
+    const std::vector<float> bin_boundaries = getBinEdges()[2];
+    for (unsigned int i = 0; i < bins; i++)
+    {
+        const float r = bin_boundaries[i];
+        const float nextr = bin_boundaries[i + 1];
+        m_vol_array2D[i] = M_PI * (nextr * nextr - r * r);
+        m_vol_array3D[i] = volume_prefactor * (nextr * nextr * nextr - r * r * r);
+    }
+}
+
+std::vector<unsigned int> PartialRDF::countTypes(const unsigned int* types, unsigned int n) const
+{
+    std::vector<unsigned int> counts(m_num_types, 0);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        if (types[i] >= m_num_types)
+        {
+            throw std::invalid_argument(
+                "PartialRDF requires all types to be less than the number of types.");
+        }
+        ++counts[types[i]];
+    }
+    return counts;
+}
+
+void PartialRDF::accumulate(const freud::locality::NeighborQuery* neighbor_query,
+                            const unsigned int* point_types, const vec3<float>* query_points,
+                            const unsigned int* query_point_types, unsigned int n_query_points,
+                            const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    auto n_points_of_type = countTypes(point_types, neighbor_query->getNPoints());
+    auto n_query_points_of_type = countTypes(query_point_types, n_query_points);
+
+    const util::RegularBins<3> bins(m_histogram.getAxes());
+    accumulateHistogram(
+        neighbor_query, query_points, n_query_points, nlist, qargs,
+        [&](BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+            histogram.increment(
+                bins.bin({static_cast<float>(query_point_types[neighbor_bond.getQueryPointIdx()]),
+                          static_cast<float>(point_types[neighbor_bond.getPointIdx()]),
+                          neighbor_bond.getDistance()}));
+        });
+    m_n_points_of_type = std::move(n_points_of_type);
+    m_n_query_points_of_type = std::move(n_query_points_of_type);
+}
+
+void PartialRDF::reduce()
+{
+    const std::vector<size_t> shape {m_num_types, m_num_types, m_bins};
+    m_pcf.prepare(shape);
+    m_histogram.prepare(shape);
+    m_N_r.prepare(shape);
+
+    // Each partial RDF is normalized like RDF, with the number of query
+    // points of type a and the number density of points of type b.
+    const auto volume = m_box.getVolume();
+    const auto nf = static_cast<float>(m_frame_counter);
+    std::vector<float> prefactors(static_cast<size_t>(m_num_types) * m_num_types, 0);
+    for (unsigned int a = 0; a < m_num_types; ++a)
+    {
+        for (unsigned int b = 0; b < m_num_types; ++b)
+        {
+            const auto n_pairs = static_cast<float>(m_n_query_points_of_type[a])
+                * static_cast<float>(m_n_points_of_type[b]);
+            if (n_pairs > 0)
+            {
+                prefactors[a * m_num_types + b] = volume / (n_pairs * nf);
+            }
+        }
+    }
+
+    const std::vector<float>& vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
+    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+        m_pcf[i] = static_cast<float>(m_histogram[i]) * prefactors[i / m_bins] / vol_array[i % m_bins];
+    });
+
+    // The cumulative sums of each pair of types are computed in sequence
+    // after the reduction, in double precision as in RDF.
+    for (unsigned int a = 0; a < m_num_types; ++a)
+    {
+        const unsigned int n_query_points_a = m_n_query_points_of_type[a];
+        const double N_r_prefactor = n_query_points_a == 0
+            ? 0.0
+            : 1.0 / (static_cast<double>(n_query_points_a) * static_cast<double>(m_frame_counter));
+        for (unsigned int b = 0; b < m_num_types; ++b)
+        {
+            const size_t first_bin = (static_cast<size_t>(a) * m_num_types + b) * m_bins;
+            double N_r = 0;
+            for (size_t i = first_bin; i < first_bin + m_bins; ++i)
+            {
+                N_r += static_cast<double>(m_histogram[i]) * N_r_prefactor;
+                m_N_r[i] = static_cast<float>(N_r);
+            }
+        }
+    }
+}
+
+}; }; // end namespace freud::density
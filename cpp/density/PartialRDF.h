@@ -0,0 +1,95 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef PARTIAL_RDF_H
+#define PARTIAL_RDF_H
+
+#include <vector>
+
+#include "BondHistogramCompute.h"
+#include "Box.h"
+#include "Histogram.h"
+
+/*! \file PartialRDF.h
+    \brief Routines for computing the radial density functions of all pairs of types.
+*/
+
+namespace freud { namespace density {
+
+//! Computes the partial RDFs g_ab(r) of all pairs of types of a mixture.
+/*! The bonds are binned by the type of their query point, the type of their
+ *  point and their length, so a single neighbor traversal accumulates the
+ *  RDFs of all pairs of types. The histogram has the shape
+ *  (num_types, num_types, bins), indexed by the query point type a and the
+ *  point type b. Each partial RDF is normalized like RDF with the numbers of
+ *  query points of type a and points of type b:
+ *
+ *  g_ab(r) = V n_ab(r) / (N_a N_b V_shell(r) N_frames)
+ *
+ *  so the partial RDFs of a single type are identical to RDF.
+ */
+class PartialRDF : public locality::BondHistogramCompute
+{
+public:
+    //! Constructor
+    PartialRDF(unsigned int num_types, unsigned int bins, float r_max, float r_min = 0);
+
+    //! Destructor
+    ~PartialRDF() override = default;
+
+    //! Compute the partial RDFs
+    /*! \param neighbor_query The points.
+     *  \param point_types The type of each point.
+     *  \param query_points The query points.
+     *  \param query_point_types The type of each query point.
+     *  \param n_query_points The number of query points.
+     *  \param nlist Neighbor list to use, or nullptr to query neighbor_query with qargs.
+     *  \param qargs Query arguments.
+     */
+    void accumulate(const freud::locality::NeighborQuery* neighbor_query, const unsigned int* point_types,
+                    const vec3<float>* query_points, const unsigned int* query_point_types,
+                    unsigned int n_query_points, const freud::locality::NeighborList* nlist,
+                    freud::locality::QueryArgs qargs);
+
+    //! Reduce thread-local arrays onto the primary data arrays.
+    void reduce() override;
+
+    //! Get the number of types.
+    unsigned int getNumTypes() const
+    {
+        return m_num_types;
+    }
+
+    //! Get the partial RDFs, with shape (num_types, num_types, bins).
+    const util::ManagedArray<float>& getRDF()
+    {
+        return reduceAndReturn(m_pcf);
+    }
+
+    //! Get the cumulative bin sums N_ab(r), with shape (num_types, num_types, bins).
+    /*! m_N_r(a, b, i) is the average number of points of type b within a ball
+     * of radius getBinEdges()[2][i+1] centered at a query point of type a.
+     */
+    const util::ManagedArray<float>& getNr()
+    {
+        return reduceAndReturn(m_N_r);
+    }
+
+private:
+    //! Count the number of values of each type, throwing if any type is out of range.
+    std::vector<unsigned int> countTypes(const unsigned int* types, unsigned int n) const;
+
+    unsigned int m_num_types;                     //!< Number of types.
+    unsigned int m_bins;                          //!< Number of bins of distances.
+    std::vector<unsigned int> m_n_points_of_type; //!< Number of points of each type in the last frame.
+    std::vector<unsigned int>
+        m_n_query_points_of_type;     //!< Number of query points of each type in the last frame.
+    util::ManagedArray<float> m_pcf;  //!< The computed partial pair correlation functions.
+    util::ManagedArray<float> m_N_r;  //!< Cumulative bin sums N_ab(r).
+    std::vector<float> m_vol_array2D; //!< Areas of the rings of the histogram bins in 2D.
+    std::vector<float> m_vol_array3D; //!< Volumes of the spherical shells of the histogram bins in 3D.
+};
+
+}; }; // end namespace freud::density
+
+#endif // PARTIAL_RDF_H
@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 
+#include "AABBQuery.h"
 #include "RDF.h"
 
 /*! \file RDF.cc
@@ -11,8 +12,8 @@
 
 namespace freud { namespace density {
 
-RDF::RDF(unsigned int bins, float r_max, float r_min, NormalizationMode normalization_mode)
-    : BondHistogramCompute(), m_norm_mode(normalization_mode)
+RDF::RDF(unsigned int bins, float r_max, float r_min, NormalizationMode normalization_mode, bool log_bins)
+    : BondHistogramCompute(), m_norm_mode(normalization_mode), m_log_bins(log_bins)
 {
     if (bins == 0)
     {
@@ -30,9 +31,14 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, NormalizationMode normaliz
     {
         throw std::invalid_argument("RDF requires that r_max must be greater than r_min.");
     }
+    if (log_bins && r_min <= 0)
+    {
+        throw std::invalid_argument("RDF requires r_min to be positive for logarithmic bins.");
+    }
 
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
-    const auto axes = util::Axes {std::make_shared<util::RegularAxis>(bins, r_min, r_max)};
+    const auto axes = log_bins ? util::Axes {std::make_shared<util::LogAxis>(bins, r_min, r_max)}
+                               : util::Axes {std::make_shared<util::RegularAxis>(bins, r_min, r_max)};
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
 
@@ -54,6 +60,7 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, NormalizationMode normaliz
 void RDF::reduce()
 {
     m_pcf.prepare(getAxisSizes()[0]);
+    m_pcf_error.prepare(getAxisSizes()[0]);
     m_histogram.prepare(getAxisSizes()[0]);
     m_N_r.prepare(getAxisSizes()[0]);
 
@@ -62,7 +69,10 @@ void RDF::reduce()
     float number_density = nqp / m_box.getVolume();
     if (m_norm_mode == NormalizationMode::finite_size)
     {
-        number_density *= static_cast<float>(m_n_query_points - 1) / static_cast<float>(m_n_query_points);
+        // The query points are the points, which are all counted even if
+        // only a sample of them was queried.
+        const unsigned int n = m_num_batches != 0 ? m_n_points : m_n_query_points;
+        number_density *= static_cast<float>(n - 1) / static_cast<float>(n);
     }
     auto np = static_cast<float>(m_n_points);
     auto nf = static_cast<float>(m_frame_counter);
@@ -72,14 +82,22 @@ void RDF::reduce()
     m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &vol_array](size_t i) {
         m_pcf[i] = m_histogram[i] * prefactor / vol_array[i];
     });
+    const auto bin_count_errors = getBinCountStandardErrors();
+    for (unsigned int i = 0; i < getAxisSizes()[0]; i++)
+    {
+        m_pcf_error[i] = bin_count_errors[i] * prefactor / vol_array[i];
+    }
 
     // The accumulation of the cumulative density must be performed in
-    // sequence, so it is done after the reduction.
-    prefactor = float(1.0) / (nqp * static_cast<float>(m_frame_counter));
-    m_N_r[0] = m_histogram[0] * prefactor;
-    for (unsigned int i = 1; i < getAxisSizes()[0]; i++)
+    // sequence, so it is done after the reduction. The running sum is kept in
+    // double precision so that it does not lose the counts of the outer bins.
+    const double N_r_prefactor
+        = 1.0 / (static_cast<double>(m_n_query_points) * static_cast<double>(m_frame_counter));
+    double N_r = 0;
+    for (unsigned int i = 0; i < getAxisSizes()[0]; i++)
     {
-        m_N_r[i] = m_N_r[i - 1] + m_histogram[i] * prefactor;
+        N_r += static_cast<double>(m_histogram[i]) * N_r_prefactor;
+        m_N_r[i] = static_cast<float>(N_r);
     }
 }
 
@@ -87,10 +105,58 @@ void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, const
                      unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                      freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          m_local_histograms(neighbor_bond.getDistance());
-                      });
+    if (accumulateDistancesOnDevice(neighbor_query, query_points, n_query_points, nlist, qargs))
+    {
+        return;
+    }
+    accumulateHistogram(neighbor_query, query_points, n_query_points, nlist, qargs,
+                        [&](BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+                            histogram(neighbor_bond.getDistance());
+                        });
+}
+
+void RDF::accumulateSampled(const freud::locality::NeighborQuery* neighbor_query,
+                            const vec3<float>* query_points, unsigned int n_query_points,
+                            const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs,
+                            const freud::locality::QuerySampling& sampling)
+{
+    accumulateSampledHistogramChunks(
+        neighbor_query, query_points, n_query_points, nlist, qargs, sampling,
+        [](unsigned int /*batch*/, BondHistogram& histogram) {
+            return [&histogram](const freud::locality::NeighborBond& neighbor_bond) {
+                histogram(neighbor_bond.getDistance());
+            };
+        });
+}
+
+void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                     const freud::locality::CompressedNeighborList* nlist)
+{
+    accumulateHistogramChunks(neighbor_query, n_query_points, nlist, [](BondHistogram& histogram) {
+        return [&histogram](const freud::locality::NeighborBond& neighbor_bond) {
+            histogram(neighbor_bond.getDistance());
+        };
+    });
+}
+
+void RDF::accumulateFrames(const std::vector<const freud::locality::NeighborQuery*>& neighbor_queries,
+                           const std::vector<const vec3<float>*>& query_points,
+                           const std::vector<unsigned int>& n_query_points, freud::locality::QueryArgs qargs)
+{
+    accumulateHistogramFrames(
+        neighbor_queries, query_points, n_query_points, qargs,
+        [&](size_t /*frame*/, BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+            histogram(neighbor_bond.getDistance());
+        });
+}
+
+void RDF::accumulateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first, uint64_t last,
+                               uint64_t stride, freud::locality::QueryArgs qargs)
+{
+    trajectory.forEachFrame(first, last, stride, [&](const util::GSDFrame& frame) {
+        const locality::AABBQuery neighbor_query(frame.box, frame.positions.data(), frame.getNumParticles());
+        accumulate(&neighbor_query, frame.positions.data(), frame.getNumParticles(), nullptr, qargs);
+    });
 }
 
 }; }; // end namespace freud::density
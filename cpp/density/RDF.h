@@ -6,6 +6,7 @@
 
 #include "BondHistogramCompute.h"
 #include "Box.h"
+#include "GSDTrajectory.h"
 #include "Histogram.h"
 
 /*! \file RDF.h
@@ -24,8 +25,16 @@ public:
     };
 
     //! Constructor
+    /*! \param log_bins Whether the bins are logarithmically spaced between r_min > 0 and r_max.
+     */
     RDF(unsigned int bins, float r_max, float r_min = 0,
-        NormalizationMode normalization_mode = NormalizationMode::exact);
+        NormalizationMode normalization_mode = NormalizationMode::exact, bool log_bins = false);
+
+    //! Get whether the bins are logarithmically spaced.
+    bool getLogBins() const
+    {
+        return m_log_bins;
+    }
 
     //! Destructor
     ~RDF() override = default;
@@ -39,6 +48,37 @@ public:
                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    //! Compute the RDF from a random sample of the query points.
+    /*! Only the bonds of the sampled query points are accumulated, and the
+     * RDF is normalized by the number of sampled query points. The sampled
+     * query points are dealt into batches, from which the standard error of
+     * each bin is estimated.
+     */
+    void accumulateSampled(const freud::locality::NeighborQuery* neighbor_query,
+                           const vec3<float>* query_points, unsigned int n_query_points,
+                           const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs,
+                           const freud::locality::QuerySampling& sampling);
+
+    //! Compute the RDF from the bonds of a CompressedNeighborList.
+    void accumulate(const freud::locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                    const freud::locality::CompressedNeighborList* nlist);
+
+    //! Compute the RDF of several frames
+    /*! Accumulate the given frames to the histogram, as if accumulate were
+     * called for each frame. The frames are processed concurrently.
+     */
+    void accumulateFrames(const std::vector<const freud::locality::NeighborQuery*>& neighbor_queries,
+                          const std::vector<const vec3<float>*>& query_points,
+                          const std::vector<unsigned int>& n_query_points, freud::locality::QueryArgs qargs);
+
+    //! Compute the RDF of the frames of a GSD trajectory
+    /*! Accumulate the frames first, first + stride, ... before last, using
+     * each frame's particles as both points and query points. Each frame is
+     * read while the previous one is accumulated.
+     */
+    void accumulateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first, uint64_t last,
+                              uint64_t stride, freud::locality::QueryArgs qargs);
+
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
 
@@ -48,6 +88,14 @@ public:
         return reduceAndReturn(m_pcf);
     }
 
+    //! Get the standard error of the RDF estimated from the batches of sampled query points.
+    /*! The errors are zero if the query points were not sampled.
+     */
+    const util::ManagedArray<float>& getRDFStandardError()
+    {
+        return reduceAndReturn(m_pcf_error);
+    }
+
     //! Get a reference to the N_r array.
     /*! Mathematically, m_N_r[i] is the average number of points
      * contained within a ball of radius getBinEdges()[i+1] centered at a given
@@ -59,9 +107,11 @@ public:
     }
 
 private:
-    NormalizationMode m_norm_mode;   //!< Whether to enforce that the RDF should tend to 1 (instead of
-                                     //!< num_query_points/num_points).
-    util::ManagedArray<float> m_pcf; //!< The computed pair correlation function.
+    NormalizationMode m_norm_mode;         //!< Whether to enforce that the RDF should tend to 1 (instead of
+                                           //!< num_query_points/num_points).
+    bool m_log_bins;                       //!< Whether the bins are logarithmically spaced.
+    util::ManagedArray<float> m_pcf;       //!< The computed pair correlation function.
+    util::ManagedArray<float> m_pcf_error; //!< Standard error of the pair correlation function.
     util::ManagedArray<float>
         m_N_r; //!< Cumulative bin sum N(r) (the average number of points in a ball of radius r).
     util::ManagedArray<float>
@@ -1,8 +1,10 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <utility>
 
 #include "SphereVoxelization.h"
 
@@ -12,6 +14,75 @@
 
 namespace freud { namespace density {
 
+namespace {
+
+//! Axis of the voxel grid.
+struct VoxelAxis
+{
+    float spacing; //!< Width of a voxel.
+    int width;     //!< Number of voxels.
+    bool periodic; //!< Whether the voxels wrap around the box.
+};
+
+//! Get the first and last voxel whose center lies closer than extent to coord.
+/*! The coordinate is measured from the lower edge of the box. The indices are
+    not wrapped, so every periodic image within the extent is included, and
+    they are clamped to the grid along aperiodic axes.
+*/
+std::pair<int, int> getVoxelRange(const VoxelAxis& axis, float coord, float extent)
+{
+    const float center = coord / axis.spacing - float(0.5);
+    const float half_width = extent / axis.spacing;
+    int first = static_cast<int>(std::floor(center - half_width)) + 1;
+    int last = static_cast<int>(std::ceil(center + half_width)) - 1;
+    if (!axis.periodic)
+    {
+        first = std::max(first, 0);
+        last = std::min(last, axis.width - 1);
+    }
+    return {first, last};
+}
+
+//! Get the offset from coord to the center of an unwrapped voxel.
+inline float getVoxelOffset(const VoxelAxis& axis, float coord, int index)
+{
+    return axis.spacing * (static_cast<float>(index) + float(0.5)) - coord;
+}
+
+//! Wrap an unwrapped voxel index into the grid.
+inline int wrapVoxelIndex(const VoxelAxis& axis, int index)
+{
+    index %= axis.width;
+    return index < 0 ? index + axis.width : index;
+}
+
+//! Fill a contiguous run of voxels, splitting it where it wraps around the box.
+void fillVoxelRun(unsigned int* row, const VoxelAxis& axis, std::pair<int, int> range)
+{
+    const int count = range.second - range.first + 1;
+    if (count <= 0)
+    {
+        return;
+    }
+    if (count >= axis.width)
+    {
+        std::fill(row, row + axis.width, 1);
+        return;
+    }
+    const int first = wrapVoxelIndex(axis, range.first);
+    if (first + count <= axis.width)
+    {
+        std::fill(row + first, row + first + count, 1);
+    }
+    else
+    {
+        std::fill(row + first, row + axis.width, 1);
+        std::fill(row, row + first + count - axis.width, 1);
+    }
+}
+
+} // namespace
+
 SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max)
     : m_box(), m_width(width), m_r_max(r_max), m_has_computed(false)
 {
@@ -49,8 +120,6 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
                                     "number of dimensions.");
     }
 
-    auto n_points = nq->getNPoints();
-
     // if the user gives a single number for width, but the nq box is 2D, and
     // we want a 2D calculation
     if (m_box.is2D())
@@ -60,6 +129,76 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
 
     m_voxels_array.prepare({m_width.x, m_width.y, m_width.z});
 
+    // The voxels are written from all threads at once. This is only safe
+    // because all threads are writing the same value (1).
+    if (m_box.withBoxTraits([](auto traits) { return decltype(traits)::is_orthorhombic; }))
+    {
+        computeRows(nq);
+    }
+    else
+    {
+        computeVoxels(nq);
+    }
+}
+
+void SphereVoxelization::computeRows(const freud::locality::NeighborQuery* nq)
+{
+    const vec3<float> L = m_box.getL();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const bool is2D = m_box.is2D();
+    const VoxelAxis axis_x {L.x / static_cast<float>(m_width.x), static_cast<int>(m_width.x), periodic.x};
+    const VoxelAxis axis_y {L.y / static_cast<float>(m_width.y), static_cast<int>(m_width.y), periodic.y};
+    const VoxelAxis axis_z {is2D ? float(1.0) : L.z / static_cast<float>(m_width.z),
+                            static_cast<int>(m_width.z), periodic.z};
+    const float r_max_sq = m_r_max * m_r_max;
+    unsigned int* voxels = m_voxels_array.get();
+
+    // Each row of voxels along the last axis of the grid (z in 3D, y in 2D)
+    // is contiguous, and the voxels of a row covered by a sphere are given
+    // by the chord of the sphere through that row.
+    util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const vec3<float> coord = (*nq)[idx] + L / float(2.0);
+            const std::pair<int, int> range_x = getVoxelRange(axis_x, coord.x, m_r_max);
+            for (int i = range_x.first; i <= range_x.second; ++i)
+            {
+                const float dx = getVoxelOffset(axis_x, coord.x, i);
+                const float remainder_x = r_max_sq - dx * dx;
+                if (remainder_x <= 0)
+                {
+                    continue;
+                }
+                const size_t offset_x = static_cast<size_t>(wrapVoxelIndex(axis_x, i)) * m_width.y;
+                if (is2D)
+                {
+                    fillVoxelRun(voxels + offset_x, axis_y,
+                                 getVoxelRange(axis_y, coord.y, std::sqrt(remainder_x)));
+                    continue;
+                }
+
+                const std::pair<int, int> range_y = getVoxelRange(axis_y, coord.y, std::sqrt(remainder_x));
+                for (int j = range_y.first; j <= range_y.second; ++j)
+                {
+                    const float dy = getVoxelOffset(axis_y, coord.y, j);
+                    const float remainder = remainder_x - dy * dy;
+                    if (remainder <= 0)
+                    {
+                        continue;
+                    }
+                    const size_t offset = (offset_x + wrapVoxelIndex(axis_y, j)) * m_width.z;
+                    fillVoxelRun(voxels + offset, axis_z,
+                                 getVoxelRange(axis_z, coord.z, std::sqrt(remainder)));
+                }
+            }
+        }
+    });
+}
+
+void SphereVoxelization::computeVoxels(const freud::locality::NeighborQuery* nq)
+{
+    const auto n_points = nq->getNPoints();
+
     // set up some constants first
     const float Lx = m_box.getLx();
     const float Ly = m_box.getLy();
@@ -70,74 +209,77 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
     const float grid_size_y = Ly / static_cast<float>(m_width.y);
     const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
 
-    // Find the number of bins within r_max
-    const int bin_cut_x = int(m_r_max / grid_size_x);
-    const int bin_cut_y = int(m_r_max / grid_size_y);
-    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    // Find the number of bins within r_max. The centers of bins one past the
+    // cutoff can still be within r_max of a point in the far side of its bin.
+    const int bin_cut_x = int(m_r_max / grid_size_x) + 1;
+    const int bin_cut_y = int(m_r_max / grid_size_y) + 1;
+    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z) + 1;
     const float r_max_sq = m_r_max * m_r_max;
 
-    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
-        // for each reference point
-        for (size_t idx = begin; idx < end; ++idx)
-        {
-            const vec3<float> point = (*nq)[idx];
-            // Find which bin the particle is in
-            const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
-            const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
-            // In 2D, only loop over the z=0 plane
-            const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
-
-            // Only evaluate over bins that are within the cutoff, rejecting bins
-            // that are outside the box in aperiodic directions.
-            for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+    // The kernel is specialized for the type of box, so the wrapping of
+    // each voxel vector has no branches on the box type.
+    m_box.withBoxTraits([&](auto traits) {
+        using BoxTraits = decltype(traits);
+        util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+            // for each reference point
+            for (size_t idx = begin; idx < end; ++idx)
             {
-                if (!periodic.z && (k < 0 || k >= int(m_width.z)))
-                {
-                    continue;
-                }
-                const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0)) - point.z
-                    - (Lz / float(2.0));
+                const vec3<float> point = (*nq)[idx];
+                // Find which bin the particle is in
+                const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+                const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+                // In 2D, only loop over the z=0 plane
+                const int bin_z = BoxTraits::is_2d ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
 
-                for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+                // Only evaluate over bins that are within the cutoff, rejecting bins
+                // that are outside the box in aperiodic directions.
+                for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
                 {
-                    if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                    if (!periodic.z && (k < 0 || k >= int(m_width.z)))
                     {
                         continue;
                     }
-                    const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
-                        - point.y - (Ly / float(2.0));
+                    const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0))
+                        - point.z - (Lz / float(2.0));
 
-                    for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                    for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
                     {
-                        if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                        if (!periodic.y && (j < 0 || j >= int(m_width.y)))
                         {
                             continue;
                         }
-                        const float dx = ((grid_size_x * static_cast<float>(i)) + (grid_size_x / 2.0f)
-                                          - point.x - (Lx / float(2.0)));
+                        const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
+                            - point.y - (Ly / float(2.0));
 
-                        // Calculate the distance from the particle to the grid cell
-                        const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                        for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                        {
+                            if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                            {
+                                continue;
+                            }
+                            const float dx = ((grid_size_x * static_cast<float>(i)) + (grid_size_x / 2.0f)
+                                              - point.x - (Lx / float(2.0)));
 
-                        const float r_sq = dot(delta, delta);
+                            // Calculate the distance from the particle to the grid cell
+                            const vec3<float> delta = m_box.wrap<BoxTraits>(vec3<float>(dx, dy, dz));
 
-                        // Check to see if this distance is within the specified r_max
-                        if (r_sq < r_max_sq)
-                        {
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
-                            const unsigned int nj = (j + m_width.y) % m_width.y;
-                            const unsigned int nk = (k + m_width.z) % m_width.z;
-
-                            // This array value could be written by multiple threads in parallel.
-                            // This is only safe because all threads are writing the same value (1).
-                            m_voxels_array(ni, nj, nk) = 1;
+                            const float r_sq = dot(delta, delta);
+
+                            // Check to see if this distance is within the specified r_max
+                            if (r_sq < r_max_sq)
+                            {
+                                // Assure that out of range indices are corrected for storage
+                                // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                                const unsigned int ni = (i + m_width.x) % m_width.x;
+                                const unsigned int nj = (j + m_width.y) % m_width.y;
+                                const unsigned int nk = (k + m_width.z) % m_width.z;
+                                m_voxels_array(ni, nj, nk) = 1;
+                            }
                         }
                     }
                 }
             }
-        }
+        });
     });
 }
 
@@ -53,6 +53,12 @@ public:
     vec3<unsigned int> getWidth() const;
 
 private:
+    //! Fill the row segments covered by each sphere in an orthorhombic box.
+    void computeRows(const freud::locality::NeighborQuery* nq);
+
+    //! Test every voxel near each sphere, for boxes with tilt factors.
+    void computeVoxels(const freud::locality::NeighborQuery* nq);
+
     box::Box m_box;             //!< Simulation box containing the points.
     vec3<unsigned int> m_width; //!< Number of bins in the grid in each dimension.
     float m_r_max;              //!< Sphere radius used for voxelization.
@@ -0,0 +1,188 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "AABBQuery.h"
+#include "VanHove.h"
+#include "utils.h"
+
+/*! \file VanHove.cc
+    \brief Routines for computing the self and distinct parts of the Van Hove correlation function.
+*/
+
+namespace freud { namespace density {
+
+VanHove::VanHove(const std::vector<unsigned int>& lags, unsigned int bins, float r_max, float r_min)
+    : BondHistogramCompute(), m_lags(lags), m_bins(bins), m_r_max(r_max), m_num_origins(lags.size(), 0)
+{
+    if (lags.empty())
+    {
+        throw std::invalid_argument("VanHove requires at least one lag.");
+    }
+    if (bins == 0)
+    {
+        throw std::invalid_argument("VanHove requires a nonzero number of bins.");
+    }
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("VanHove requires r_max to be positive.");
+    }
+    if (r_min < 0)
+    {
+        throw std::invalid_argument("VanHove requires r_min to be non-negative.");
+    }
+    if (r_max <= r_min)
+    {
+        throw std::invalid_argument("VanHove requires that r_max must be greater than r_min.");
+    }
+
+    // The lags are binned on a regular axis with one bin per lag, so each
+    // pair is binned by its lag and distance at once.
+    const auto num_lags = static_cast<float>(lags.size());
+    const auto axes = util::Axes {std::make_shared<util::RegularAxis>(lags.size(), 0, num_lags),
+                                  std::make_shared<util::RegularAxis>(bins, r_min, r_max)};
+    m_histogram = BondHistogram(axes);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_self_histogram = BondHistogram(axes);
+    m_local_self_histograms = BondHistogram::ThreadLocalHistogram(m_self_histogram);
+
+    // Precompute the cell volumes to speed up later calculations.
+    m_vol_array2D.resize(bins);
+    m_vol_array3D.resize(bins);
+    const float volume_prefactor = (float(4.0) / float(3.0)) * M_PI;
+    const std::vector<float> bin_boundaries = getBinEdges()[1];
+    for (unsigned int i = 0; i < bins; i++)
+    {
+        const float r = bin_boundaries[i];
+        const float nextr = bin_boundaries[i + 1];
+        m_vol_array2D[i] = M_PI * (nextr * nextr - r * r);
+        m_vol_array3D[i] = volume_prefactor * (nextr * nextr * nextr - r * r * r);
+    }
+}
+
+void VanHove::reset()
+{
+    BondHistogramCompute::reset();
+    m_local_self_histograms.reset();
+    std::fill(m_num_origins.begin(), m_num_origins.end(), 0);
+}
+
+void VanHove::accumulate(const box::Box& box, const vec3<float>* positions, unsigned int num_frames,
+                         unsigned int num_particles)
+{
+    if (num_particles == 0)
+    {
+        throw std::invalid_argument("VanHove requires at least one particle.");
+    }
+
+    // The distinct part is found with periodic neighbor queries of the
+    // wrapped positions, and the self part from the unwrapped displacements.
+    const size_t num_positions = static_cast<size_t>(num_frames) * num_particles;
+    std::vector<vec3<float>> wrapped_positions(num_positions);
+    box.wrap(positions, static_cast<unsigned int>(num_positions), wrapped_positions.data());
+
+    const util::RegularBins<2> bins(m_histogram.getAxes());
+    locality::QueryArgs qargs;
+    qargs.mode = locality::QueryType::ball;
+    qargs.r_max = m_r_max;
+    qargs.exclude_ii = false;
+
+    for (unsigned int origin = 0; origin < num_frames; ++origin)
+    {
+        std::vector<unsigned int> lag_indices;
+        for (unsigned int lag_index = 0; lag_index < m_lags.size(); ++lag_index)
+        {
+            if (m_lags[lag_index] < num_frames - origin)
+            {
+                lag_indices.push_back(lag_index);
+                ++m_num_origins[lag_index];
+            }
+        }
+        if (lag_indices.empty())
+        {
+            continue;
+        }
+
+        // The tree of the origin frame is queried by the frames of all lags.
+        const vec3<float>* origin_positions = wrapped_positions.data() + size_t(origin) * num_particles;
+        const locality::AABBQuery neighbor_query(box, origin_positions, num_particles);
+        const std::vector<const locality::NeighborQuery*> neighbor_queries(lag_indices.size(),
+                                                                           &neighbor_query);
+        std::vector<const vec3<float>*> query_points;
+        for (const auto lag_index : lag_indices)
+        {
+            query_points.push_back(wrapped_positions.data()
+                                   + size_t(origin + m_lags[lag_index]) * num_particles);
+        }
+        const std::vector<unsigned int> n_query_points(lag_indices.size(), num_particles);
+        accumulateHistogramFrames(
+            neighbor_queries, query_points, n_query_points, qargs,
+            [&](size_t frame, BondHistogram& histogram, const locality::NeighborBond& neighbor_bond) {
+                if (neighbor_bond.getPointIdx() != neighbor_bond.getQueryPointIdx())
+                {
+                    histogram.increment(bins.bin(
+                        {static_cast<float>(lag_indices[frame]), neighbor_bond.getDistance()}));
+                }
+            });
+
+        const vec3<float>* unwrapped_origin = positions + size_t(origin) * num_particles;
+        util::forLoopWrapper(0, num_particles, [&](size_t begin, size_t end) {
+            auto& histogram = m_local_self_histograms.local();
+            for (const auto lag_index : lag_indices)
+            {
+                const vec3<float>* unwrapped_frame
+                    = positions + size_t(origin + m_lags[lag_index]) * num_particles;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const vec3<float> displacement = unwrapped_frame[i] - unwrapped_origin[i];
+                    histogram.increment(bins.bin(
+                        {static_cast<float>(lag_index), std::sqrt(dot(displacement, displacement))}));
+                }
+            }
+        });
+    }
+    m_box = box;
+    m_n_points = num_particles;
+    m_n_query_points = num_particles;
+    m_reduce = true;
+}
+
+void VanHove::reduce()
+{
+    const std::vector<size_t> shape {m_lags.size(), m_bins};
+    m_distinct.prepare(shape);
+    m_self.prepare(shape);
+    m_histogram.prepare(shape);
+    m_self_histogram.prepare(shape);
+
+    // The distinct part is normalized like RDF and the self part like a
+    // probability density, each with the number of time origins of its lag.
+    const auto n = static_cast<float>(m_n_points);
+    const auto volume = m_box.getVolume();
+    std::vector<float> distinct_prefactors(m_lags.size(), 0);
+    std::vector<float> self_prefactors(m_lags.size(), 0);
+    for (size_t lag_index = 0; lag_index < m_lags.size(); ++lag_index)
+    {
+        if (m_num_origins[lag_index] != 0)
+        {
+            const auto num_origins = static_cast<float>(m_num_origins[lag_index]);
+            distinct_prefactors[lag_index] = volume / (n * n * num_origins);
+            self_prefactors[lag_index] = float(1.0) / (n * num_origins);
+        }
+    }
+
+    const std::vector<float>& vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
+    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+        m_distinct[i] = static_cast<float>(m_histogram[i]) * distinct_prefactors[i / m_bins]
+            / vol_array[i % m_bins];
+    });
+    m_self_histogram.reduceOverThreadsPerBin(m_local_self_histograms, [&](size_t i) {
+        m_self[i] = static_cast<float>(m_self_histogram[i]) * self_prefactors[i / m_bins]
+            / vol_array[i % m_bins];
+    });
+}
+
+}; }; // end namespace freud::density
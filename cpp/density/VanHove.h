@@ -0,0 +1,115 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef VAN_HOVE_H
+#define VAN_HOVE_H
+
+#include <vector>
+
+#include "BondHistogramCompute.h"
+#include "Box.h"
+#include "Histogram.h"
+
+/*! \file VanHove.h
+    \brief Routines for computing the self and distinct parts of the Van Hove correlation function.
+*/
+
+namespace freud { namespace density {
+
+//! Computes the self and distinct parts of the Van Hove correlation function G(r, t).
+/*! For each lag t, the distinct part G_d(r, t) is the density of particles j
+ *  at a distance r at time t0 + t from a different particle i at time t0,
+ *  normalized like RDF so that G_d(r, 0) is the RDF and G_d(r, t) tends to 1
+ *  at large r:
+ *
+ *  G_d(r, t) = V n_d(r, t) / (N^2 V_shell(r) N_origins(t))
+ *
+ *  The self part G_s(r, t) is the probability density of the displacement of
+ *  a particle over a time t:
+ *
+ *  G_s(r, t) = n_s(r, t) / (N V_shell(r) N_origins(t))
+ *
+ *  Every frame of a trajectory is a time origin t0 for each lag that fits in
+ *  the trajectory. One NeighborQuery is built from each reference frame and
+ *  queried with the frames of all lags at once, so the tree of a frame is
+ *  built once rather than once per pair of frames. The histograms have the
+ *  shape (lags, bins).
+ */
+class VanHove : public locality::BondHistogramCompute
+{
+public:
+    //! Constructor
+    /*! \param lags The lags, in frames, at which G(r, t) is computed.
+     *  \param bins Number of bins of distances.
+     *  \param r_max Largest distance.
+     *  \param r_min Smallest distance.
+     */
+    VanHove(const std::vector<unsigned int>& lags, unsigned int bins, float r_max, float r_min = 0);
+
+    //! Destructor
+    ~VanHove() override = default;
+
+    //! Reset the histograms to all zeros
+    void reset() override;
+
+    //! Accumulate the pairs of frames of a trajectory separated by each lag.
+    /*! \param box The box, which must not change between frames.
+     *  \param positions Unwrapped positions of the particles with shape (num_frames, num_particles).
+     *  \param num_frames Number of frames.
+     *  \param num_particles Number of particles in each frame.
+     */
+    void accumulate(const box::Box& box, const vec3<float>* positions, unsigned int num_frames,
+                    unsigned int num_particles);
+
+    //! Reduce thread-local arrays onto the primary data arrays.
+    void reduce() override;
+
+    //! Get the lags, in frames.
+    const std::vector<unsigned int>& getLags() const
+    {
+        return m_lags;
+    }
+
+    //! Get the number of time origins averaged over for each lag.
+    const std::vector<unsigned int>& getNumOrigins() const
+    {
+        return m_num_origins;
+    }
+
+    //! Get the distinct part G_d(r, t), with shape (lags, bins).
+    const util::ManagedArray<float>& getDistinct()
+    {
+        return reduceAndReturn(m_distinct);
+    }
+
+    //! Get the self part G_s(r, t), with shape (lags, bins).
+    const util::ManagedArray<float>& getSelf()
+    {
+        return reduceAndReturn(m_self);
+    }
+
+    //! Get the histogram of particle displacements, with shape (lags, bins).
+    const util::ManagedArray<unsigned int>& getSelfBinCounts()
+    {
+        return reduceAndReturn(m_self_histogram.getBinCounts());
+    }
+
+private:
+    std::vector<unsigned int> m_lags;        //!< Lags, in frames.
+    unsigned int m_bins;                     //!< Number of bins of distances.
+    float m_r_max;                           //!< Largest distance.
+    std::vector<unsigned int> m_num_origins; //!< Number of time origins of each lag.
+
+    BondHistogram m_self_histogram; //!< Histogram of particle displacements.
+    BondHistogram::ThreadLocalHistogram
+        m_local_self_histograms; //!< Thread local histograms of particle displacements.
+
+    util::ManagedArray<float> m_distinct; //!< The distinct part of the Van Hove function.
+    util::ManagedArray<float> m_self;     //!< The self part of the Van Hove function.
+    std::vector<float> m_vol_array2D;     //!< Areas of the rings of the histogram bins in 2D.
+    std::vector<float> m_vol_array3D;     //!< Volumes of the spherical shells of the histogram bins in 3D.
+};
+
+}; }; // end namespace freud::density
+
+#endif // VAN_HOVE_H
@@ -0,0 +1,274 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+#include "DiffractionPattern.h"
+#include "FFT.h"
+#include "utils.h"
+
+/*! \file DiffractionPattern.cc
+    \brief Computes 2D diffraction patterns viewed along several orientations.
+*/
+
+namespace freud { namespace diffraction {
+
+namespace {
+
+//! A 2x2 matrix acting on the in-plane coordinates of a view.
+struct Matrix2
+{
+    double xx, xy, yx, yy;
+
+    Matrix2 inverse() const
+    {
+        const double det = xx * yy - xy * yx;
+        return {yy / det, -xy / det, -yx / det, xx / det};
+    }
+};
+
+//! Compute the inverse of the shear of the box face with the largest area along the view axis.
+/*! The face spanned by two of the rotated lattice vectors whose normal has
+ *  the largest z component is projected onto the image plane, and the
+ *  inverse of its in-plane lattice vectors maps the rotated points to
+ *  fractional coordinates of that face.
+ */
+Matrix2 inverseProjectedShear(const box::Box& box, const quat<double>& view_orientation)
+{
+    vec3<double> lattice_vectors[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        lattice_vectors[i] = rotate(view_orientation, vec3<double>(box.getLatticeVector(i)));
+    }
+
+    unsigned int best_axis = 0;
+    double best_projection = -1;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const double projection
+            = std::abs(cross(lattice_vectors[(i + 2) % 3], lattice_vectors[(i + 1) % 3]).z);
+        if (projection > best_projection)
+        {
+            best_projection = projection;
+            best_axis = i;
+        }
+    }
+
+    const vec3<double>& a = lattice_vectors[(best_axis + 1) % 3];
+    const vec3<double>& b = lattice_vectors[(best_axis + 2) % 3];
+    return Matrix2 {a.x, b.x, a.y, b.y}.inverse();
+}
+
+//! Get the signed frequency of index i of an FFT of size n.
+inline double fftFrequency(unsigned int i, unsigned int n)
+{
+    return i < (n + 1) / 2 ? static_cast<double>(i) : static_cast<double>(i) - static_cast<double>(n);
+}
+
+//! Get the largest element of the box matrix, whose columns are the lattice vectors.
+double maxBoxMatrixElement(const box::Box& box)
+{
+    double max_element = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const vec3<float> v = box.getLatticeVector(i);
+        max_element = std::max({max_element, static_cast<double>(v.x), static_cast<double>(v.y),
+                                static_cast<double>(v.z)});
+    }
+    return max_element;
+}
+
+}; // end anonymous namespace
+
+DiffractionPattern::DiffractionPattern(unsigned int grid_size, unsigned int output_size)
+    : m_grid_size(grid_size), m_output_size(output_size),
+      m_local_diffraction({output_size, output_size})
+{
+    if (grid_size == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires a nonzero grid_size.");
+    }
+    if (output_size == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires a nonzero output_size.");
+    }
+}
+
+void DiffractionPattern::reset()
+{
+    m_local_diffraction.reset();
+    m_frame_counter = 0;
+    m_n_points = 0;
+    m_reduce = true;
+}
+
+void DiffractionPattern::accumulate(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                                    const quat<float>* view_orientations, unsigned int n_views, float zoom,
+                                    float peak_width)
+{
+    if (box.is2D())
+    {
+        throw std::invalid_argument("DiffractionPattern requires a 3D box.");
+    }
+    if (n_points == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires at least one point.");
+    }
+    if (zoom <= 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires a positive zoom.");
+    }
+
+    // Each view is one task, and the FFT of each view is split further
+    // over the lines of its grid, so a single view still uses all threads.
+    util::forLoopWrapper(0, n_views, [&](size_t begin, size_t end) {
+        auto& image = m_local_diffraction.local();
+        for (size_t view = begin; view < end; ++view)
+        {
+            accumulateView(box, points, n_points, view_orientations[view], zoom, peak_width, image);
+        }
+    });
+    m_n_points = n_points;
+    m_frame_counter += n_views;
+    m_reduce = true;
+}
+
+void DiffractionPattern::accumulateView(const box::Box& box, const vec3<float>* points,
+                                        unsigned int n_points, const quat<float>& view_orientation,
+                                        float zoom, float peak_width, util::ManagedArray<double>& image)
+{
+    const quat<double> q(view_orientation);
+    const quat<double> unit_q = q * (1.0 / std::sqrt(norm2(q)));
+    const Matrix2 inv_shear = inverseProjectedShear(box, unit_q);
+
+    // Deposit the points onto the grid of fractional coordinates of the
+    // projected box face.
+    const unsigned int g = m_grid_size;
+    util::ManagedArray<std::complex<double>> grid({g, g, 1});
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        const vec3<double> r = rotate(unit_q, vec3<double>(points[i]));
+        double fx = inv_shear.xx * r.x + inv_shear.xy * r.y + 0.5;
+        double fy = inv_shear.yx * r.x + inv_shear.yy * r.y + 0.5;
+        fx -= std::floor(fx);
+        fy -= std::floor(fy);
+        const auto bx = std::min(static_cast<unsigned int>(fx * g), g - 1);
+        const auto by = std::min(static_cast<unsigned int>(fy * g), g - 1);
+        grid[static_cast<size_t>(bx) * g + by] += 1.0;
+    }
+
+    util::fft3D(grid);
+
+    // Convolve with a Gaussian of width peak_width / zoom grid cells, then
+    // take the squared modulus with k = 0 shifted to the center of the grid.
+    const double sigma = static_cast<double>(peak_width) / zoom;
+    const double gaussian_prefactor = -2.0 * (sigma * M_PI / g) * (sigma * M_PI / g);
+    std::vector<double> intensity(static_cast<size_t>(g) * g);
+    for (unsigned int i = 0; i < g; ++i)
+    {
+        const double ki = fftFrequency(i, g);
+        const unsigned int si = (i + g / 2) % g;
+        for (unsigned int j = 0; j < g; ++j)
+        {
+            const double kj = fftFrequency(j, g);
+            const unsigned int sj = (j + g / 2) % g;
+            const double weight = std::exp(gaussian_prefactor * (ki * ki + kj * kj));
+            intensity[static_cast<size_t>(si) * g + sj]
+                = std::norm(grid[static_cast<size_t>(i) * g + j]) * weight * weight;
+        }
+    }
+
+    // The output pixel o shows the intensity at i = A^-1 (o - b), where A
+    // zooms and shears the grid and b keeps k = 0 at the center of a pixel
+    // of both the grid and the output for odd and even sizes.
+    const double roll = static_cast<double>(g / 2);
+    const double roll_shift = static_cast<double>(m_output_size / 2) / zoom;
+    const double scale = maxBoxMatrixElement(box);
+    const Matrix2 ss {scale * inv_shear.xx, scale * inv_shear.xy, scale * inv_shear.yx,
+                      scale * inv_shear.yy};
+    const Matrix2 forward {zoom * ss.yx, zoom * ss.xx, zoom * ss.yy, zoom * ss.xy};
+    const double bx = zoom * (roll_shift - roll * (ss.yx + ss.xx));
+    const double by = zoom * (roll_shift - roll * (ss.yy + ss.xy));
+    const Matrix2 backward = forward.inverse();
+
+    const double max_index = static_cast<double>(g - 1);
+    const double inv_n_points = 1.0 / static_cast<double>(n_points);
+    for (unsigned int oi = 0; oi < m_output_size; ++oi)
+    {
+        for (unsigned int oj = 0; oj < m_output_size; ++oj)
+        {
+            const double di = oi - bx;
+            const double dj = oj - by;
+            const double ci = backward.xx * di + backward.xy * dj;
+            const double cj = backward.yx * di + backward.yy * dj;
+            if (ci < 0 || cj < 0 || ci > max_index || cj > max_index)
+            {
+                continue;
+            }
+            const auto i0 = static_cast<unsigned int>(ci);
+            const auto j0 = static_cast<unsigned int>(cj);
+            const unsigned int i1 = std::min(i0 + 1, g - 1);
+            const unsigned int j1 = std::min(j0 + 1, g - 1);
+            const double ti = ci - i0;
+            const double tj = cj - j0;
+            const double value = (1 - ti) * ((1 - tj) * intensity[static_cast<size_t>(i0) * g + j0]
+                                             + tj * intensity[static_cast<size_t>(i0) * g + j1])
+                + ti
+                    * ((1 - tj) * intensity[static_cast<size_t>(i1) * g + j0]
+                       + tj * intensity[static_cast<size_t>(i1) * g + j1]);
+            image[static_cast<size_t>(oi) * m_output_size + oj] += value * inv_n_points;
+        }
+    }
+}
+
+void DiffractionPattern::reduce()
+{
+    if (!m_reduce)
+    {
+        return;
+    }
+    m_reduce = false;
+
+    const unsigned int n = m_output_size;
+    m_diffraction.prepare({n, n});
+    m_local_diffraction.reduceInto(m_diffraction);
+    if (m_frame_counter != 0)
+    {
+        const double inv_frames = 1.0 / m_frame_counter;
+        for (size_t i = 0; i < m_diffraction.size(); ++i)
+        {
+            m_diffraction[i] *= inv_frames;
+        }
+    }
+
+    const unsigned int num_rings = n / 2 + 1;
+    m_radial_average.prepare(num_rings);
+    std::vector<unsigned int> ring_counts(num_rings, 0);
+    const auto center = static_cast<int>(n / 2);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            const double di = static_cast<int>(i) - center;
+            const double dj = static_cast<int>(j) - center;
+            const auto ring = static_cast<unsigned int>(std::lround(std::sqrt(di * di + dj * dj)));
+            if (ring < num_rings)
+            {
+                m_radial_average[ring] += m_diffraction[static_cast<size_t>(i) * n + j];
+                ++ring_counts[ring];
+            }
+        }
+    }
+    for (unsigned int ring = 0; ring < num_rings; ++ring)
+    {
+        if (ring_counts[ring] != 0)
+        {
+            m_radial_average[ring] /= ring_counts[ring];
+        }
+    }
+}
+
+}; }; // end namespace freud::diffraction
@@ -0,0 +1,117 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DIFFRACTION_PATTERN_H
+#define DIFFRACTION_PATTERN_H
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "ThreadStorage.h"
+#include "VectorMath.h"
+
+/*! \file DiffractionPattern.h
+    \brief Computes 2D diffraction patterns viewed along several orientations.
+*/
+
+namespace freud { namespace diffraction {
+
+//! Computes the 2D diffraction pattern of a system viewed along one or more orientations.
+/*! For each view orientation, the points are rotated, projected onto the
+ *  face of the rotated box with the largest area along the view axis, and
+ *  deposited onto a grid_size x grid_size grid of fractional coordinates.
+ *  The grid is Fourier transformed, convolved with a Gaussian of width
+ *  peak_width by a multiplication in Fourier space, and its squared modulus
+ *  S(k) is sheared, zoomed and bilinearly interpolated onto an
+ *  output_size x output_size image with k = 0 at (output_size / 2,
+ *  output_size / 2), normalized so that S(0) = N.
+ *
+ *  The views are processed concurrently, and the FFT of each view is itself
+ *  parallelized over the lines of its grid. The images of all views and
+ *  frames accumulated since the last reset are averaged.
+ */
+class DiffractionPattern
+{
+public:
+    //! Constructor
+    /*! \param grid_size Resolution of the grid the points are deposited onto.
+     *  \param output_size Resolution of the output image.
+     */
+    DiffractionPattern(unsigned int grid_size, unsigned int output_size);
+
+    //! Reset the accumulated diffraction pattern.
+    void reset();
+
+    //! Accumulate the diffraction patterns of a frame viewed along several orientations.
+    /*! \param box The box of the frame.
+     *  \param points The points of the frame.
+     *  \param n_points The number of points.
+     *  \param view_orientations The view orientations, each counted as one frame of the average.
+     *  \param n_views The number of view orientations.
+     *  \param zoom Scaling factor of the incident wavevectors.
+     *  \param peak_width Width of the Gaussian convolved with the points, in units of length.
+     */
+    void accumulate(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                    const quat<float>* view_orientations, unsigned int n_views, float zoom, float peak_width);
+
+    unsigned int getGridSize() const
+    {
+        return m_grid_size;
+    }
+
+    unsigned int getOutputSize() const
+    {
+        return m_output_size;
+    }
+
+    //! Get the number of points of the last frame.
+    unsigned int getNPoints() const
+    {
+        return m_n_points;
+    }
+
+    //! Get the number of views accumulated since the last reset.
+    unsigned int getFrameCounter() const
+    {
+        return m_frame_counter;
+    }
+
+    //! Get the diffraction pattern averaged over the accumulated views, with shape (output_size, output_size).
+    const util::ManagedArray<double>& getDiffraction()
+    {
+        reduce();
+        return m_diffraction;
+    }
+
+    //! Get the average of the diffraction pattern over rings of pixels around k = 0.
+    /*! Ring i holds the pixels whose distance from the k = 0 pixel rounds
+     *  to i, for i up to output_size / 2.
+     */
+    const util::ManagedArray<double>& getRadialAverage()
+    {
+        reduce();
+        return m_radial_average;
+    }
+
+private:
+    //! Compute the diffraction image of one view and add it to the thread local image.
+    void accumulateView(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                        const quat<float>& view_orientation, float zoom, float peak_width,
+                        util::ManagedArray<double>& image);
+
+    //! Sum the thread local images and compute the averages.
+    void reduce();
+
+    unsigned int m_grid_size;         //!< Resolution of the grid the points are deposited onto.
+    unsigned int m_output_size;       //!< Resolution of the output image.
+    unsigned int m_n_points {0};      //!< Number of points of the last frame.
+    unsigned int m_frame_counter {0}; //!< Number of views accumulated since the last reset.
+    bool m_reduce {true};             //!< Whether the thread local images must be summed again.
+
+    util::ThreadStorage<double> m_local_diffraction; //!< Thread local sums of the images.
+    util::ManagedArray<double> m_diffraction;        //!< Diffraction pattern averaged over the views.
+    util::ManagedArray<double> m_radial_average;     //!< Radial average of the diffraction pattern.
+};
+
+}; }; // end namespace freud::diffraction
+
+#endif // DIFFRACTION_PATTERN_H
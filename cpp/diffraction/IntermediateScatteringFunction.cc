@@ -0,0 +1,187 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "IntermediateScatteringFunction.h"
+#include "RawPoints.h"
+#include "ThreadStorage.h"
+#include "utils.h"
+
+/*! \file IntermediateScatteringFunction.cc
+    \brief Accumulates the intermediate scattering function of a trajectory frame by frame.
+*/
+
+namespace freud { namespace diffraction {
+
+IntermediateScatteringFunction::IntermediateScatteringFunction(unsigned int bins, float k_max, float k_min,
+                                                               unsigned int num_sampled_k_points,
+                                                               unsigned int grid_size,
+                                                               unsigned int points_per_level,
+                                                               unsigned int level_factor, bool self_part)
+    : m_structure_factor(bins, k_max, k_min, num_sampled_k_points, grid_size), m_self_part(self_part),
+      m_bins(bins), m_collective(points_per_level, level_factor, bins),
+      m_self(points_per_level, level_factor, bins)
+{}
+
+void IntermediateScatteringFunction::reset()
+{
+    m_structure_factor.reset();
+    m_collective.reset();
+    m_self.reset();
+    m_reduce = true;
+}
+
+void IntermediateScatteringFunction::binKPoints()
+{
+    m_k_points = m_structure_factor.getKPoints();
+    const auto bin_edges = m_structure_factor.getBinEdges();
+    const util::RegularAxis k_axis(m_bins, bin_edges.front(), bin_edges.back());
+    m_k_bins.resize(m_k_points.size());
+    std::vector<unsigned int> k_bin_counts(m_bins, 0);
+    for (size_t k_index = 0; k_index < m_k_points.size(); ++k_index)
+    {
+        const auto& k_vec = m_k_points[k_index];
+        const size_t k_bin = k_axis.bin(std::sqrt(dot(k_vec, k_vec)));
+        m_k_bins[k_index] = k_bin < m_bins ? static_cast<unsigned int>(k_bin) : m_bins;
+        if (k_bin < m_bins)
+        {
+            ++k_bin_counts[k_bin];
+        }
+    }
+    m_inverse_k_bin_counts.assign(m_bins, 0);
+    for (unsigned int k_bin = 0; k_bin < m_bins; ++k_bin)
+    {
+        if (k_bin_counts[k_bin] != 0)
+        {
+            m_inverse_k_bin_counts[k_bin] = 1.0 / static_cast<double>(k_bin_counts[k_bin]);
+        }
+    }
+}
+
+void IntermediateScatteringFunction::update(const box::Box& box, const vec3<float>* positions,
+                                            unsigned int num_particles)
+{
+    const bool first_frame = getNumFrames() == 0;
+    if (!first_frame && box != m_box)
+    {
+        throw std::invalid_argument("IntermediateScatteringFunction requires the same box in every frame.");
+    }
+    if (!first_frame && num_particles != m_num_particles)
+    {
+        throw std::invalid_argument(
+            "IntermediateScatteringFunction requires the same number of particles in every frame.");
+    }
+
+    // The amplitudes are computed at the k-vectors sampled for the first
+    // frame, which the structure factor reuses as long as the box is the same.
+    const locality::RawPoints points(box, positions, num_particles);
+    m_structure_factor.computeAmplitudes(&points, nullptr, 0, num_particles);
+    if (first_frame)
+    {
+        m_box = box;
+        m_num_particles = num_particles;
+        binKPoints();
+    }
+
+    const auto& amplitudes = m_structure_factor.getPointAmplitudes();
+    m_collective.updateValues(
+        amplitudes.get(), amplitudes.size(),
+        [this](const std::complex<float>* frame, const std::complex<float>* origin, double* values) {
+            for (size_t k_index = 0; k_index < m_k_points.size(); ++k_index)
+            {
+                const unsigned int k_bin = m_k_bins[k_index];
+                if (k_bin < m_bins)
+                {
+                    const auto product = frame[k_index] * std::conj(origin[k_index]);
+                    values[k_bin] += static_cast<double>(product.real()) * m_inverse_k_bin_counts[k_bin];
+                }
+            }
+        });
+
+    if (m_self_part)
+    {
+        const double inverse_num_particles = 1.0 / static_cast<double>(num_particles);
+        m_self.updateValues(
+            positions, num_particles,
+            [this, num_particles, inverse_num_particles](const vec3<float>* frame, const vec3<float>* origin,
+                                                         double* values) {
+                util::ThreadStorage<double> local_values(m_bins);
+                util::forLoopWrapper(0, num_particles, [&](size_t begin, size_t end) {
+                    auto& local = local_values.local();
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const vec3<float> displacement = frame[i] - origin[i];
+                        for (size_t k_index = 0; k_index < m_k_points.size(); ++k_index)
+                        {
+                            const unsigned int k_bin = m_k_bins[k_index];
+                            if (k_bin < m_bins)
+                            {
+                                local[k_bin] += std::cos(dot(m_k_points[k_index], displacement));
+                            }
+                        }
+                    }
+                });
+                util::ManagedArray<double> sums(m_bins);
+                local_values.reduceInto(sums);
+                for (unsigned int k_bin = 0; k_bin < m_bins; ++k_bin)
+                {
+                    values[k_bin] += sums[k_bin] * m_inverse_k_bin_counts[k_bin] * inverse_num_particles;
+                }
+            });
+    }
+    m_reduce = true;
+}
+
+void IntermediateScatteringFunction::updateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first,
+                                                      uint64_t last, uint64_t stride)
+{
+    std::vector<vec3<float>> unwrapped;
+    trajectory.forEachFrame(first, last, stride, [&](const util::GSDFrame& frame) {
+        unwrapped.resize(frame.getNumParticles());
+        frame.box.unwrap(frame.positions.data(), frame.images.data(), frame.getNumParticles(),
+                         unwrapped.data());
+        update(frame.box, unwrapped.data(), frame.getNumParticles());
+    });
+}
+
+void IntermediateScatteringFunction::reduce()
+{
+    if (!m_reduce)
+    {
+        return;
+    }
+    m_reduce = false;
+
+    std::vector<unsigned int> lags;
+    std::vector<double> isf;
+    std::vector<unsigned int> counts;
+    m_collective.reduce(lags, isf, counts);
+
+    m_lags.prepare(lags.size());
+    m_counts.prepare(counts.size());
+    m_isf.prepare({lags.size(), m_bins});
+    std::copy(lags.begin(), lags.end(), m_lags.get());
+    std::copy(counts.begin(), counts.end(), m_counts.get());
+    std::transform(isf.begin(), isf.end(), m_isf.get(),
+                   [](double value) { return static_cast<float>(value); });
+
+    if (m_self_part)
+    {
+        std::vector<unsigned int> self_lags;
+        std::vector<double> self_isf;
+        std::vector<unsigned int> self_counts;
+        m_self.reduce(self_lags, self_isf, self_counts);
+        m_self_isf.prepare({self_lags.size(), m_bins});
+        std::transform(self_isf.begin(), self_isf.end(), m_self_isf.get(),
+                       [](double value) { return static_cast<float>(value); });
+    }
+    else
+    {
+        m_self_isf.prepare({0, m_bins});
+    }
+}
+
+}; }; // end namespace freud::diffraction
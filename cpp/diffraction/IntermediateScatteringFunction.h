@@ -0,0 +1,179 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef INTERMEDIATE_SCATTERING_FUNCTION_H
+#define INTERMEDIATE_SCATTERING_FUNCTION_H
+
+#include <complex>
+#include <vector>
+
+#include "Box.h"
+#include "GSDTrajectory.h"
+#include "ManagedArray.h"
+#include "MultipleTauCorrelator.h"
+#include "StaticStructureFactorDirect.h"
+#include "VectorMath.h"
+
+/*! \file IntermediateScatteringFunction.h
+    \brief Accumulates the intermediate scattering function of a trajectory frame by frame.
+*/
+
+namespace freud { namespace diffraction {
+
+//! Accumulates the intermediate scattering function F(k, t) with a multiple-tau correlator.
+/*! The scattering amplitudes rho(k) = N^{-1/2} sum_j exp(i k \cdot r_j) of
+ *  each frame are computed once at the k-vectors sampled by
+ *  StaticStructureFactorDirect (directly or with its particle mesh) and
+ *  stored in a util::MultipleTauCorrelator. The collective intermediate
+ *  scattering function
+ *
+ *  F(k, t) = < Re rho(k, t0 + t) rho*(k, t0) >
+ *
+ *  is accumulated at logarithmically spaced lags and averaged over the
+ *  k-vectors of each bin of |k|, so F(k, 0) is the static structure factor.
+ *  Each lag costs O(N_k) per pair of frames instead of the O(N N_k) of
+ *  recomputing the amplitudes.
+ *
+ *  If the self part is requested, the positions of each frame are also
+ *  stored, and
+ *
+ *  F_s(k, t) = < N^{-1} sum_j cos(k \cdot (r_j(t0 + t) - r_j(t0))) >
+ *
+ *  is accumulated at the same lags from the displacements of the particles,
+ *  which must be unwrapped. This costs O(N N_k) per pair of frames.
+ *
+ *  The k-vectors are sampled for the box of the first frame, which must not
+ *  change between frames.
+ */
+class IntermediateScatteringFunction
+{
+public:
+    //! Constructor
+    /*! \param bins Number of bins of |k|.
+     *  \param k_max Largest |k|.
+     *  \param k_min Smallest |k|.
+     *  \param num_sampled_k_points Number of k-vectors to sample, or 0 for all.
+     *  \param grid_size Grid points per dimension of the particle mesh, or 0 to compute F(k) directly.
+     *  \param points_per_level Number of frames held in each level of the correlators.
+     *  \param level_factor Ratio of the frame spacings of consecutive levels.
+     *  \param self_part Whether to accumulate the self part F_s(k, t).
+     */
+    IntermediateScatteringFunction(unsigned int bins, float k_max, float k_min = 0,
+                                   unsigned int num_sampled_k_points = 0, unsigned int grid_size = 0,
+                                   unsigned int points_per_level = 16, unsigned int level_factor = 2,
+                                   bool self_part = false);
+
+    //! Reset the accumulated correlations and stored frames.
+    void reset();
+
+    //! Add the next frame of the trajectory.
+    /*! \param box The box, which must not change between frames.
+     *  \param positions Positions of the particles in this frame, unwrapped if the self part is computed.
+     *  \param num_particles Number of particles, which must not change between frames.
+     */
+    void update(const box::Box& box, const vec3<float>* positions, unsigned int num_particles);
+
+    //! Add the frames first, first + stride, ... before last of a GSD trajectory.
+    /*! The positions are unwrapped with the particle images stored in the
+     *  file, and each frame is read while the previous one is added.
+     */
+    void updateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first, uint64_t last,
+                          uint64_t stride);
+
+    unsigned int getPointsPerLevel() const
+    {
+        return m_collective.getPointsPerLevel();
+    }
+
+    unsigned int getLevelFactor() const
+    {
+        return m_collective.getLevelFactor();
+    }
+
+    //! Get whether the self part is accumulated.
+    bool getSelfPart() const
+    {
+        return m_self_part;
+    }
+
+    //! Get the number of frames added since the last reset.
+    unsigned int getNumFrames() const
+    {
+        return m_collective.getNumFrames();
+    }
+
+    //! Get the edges of the bins of |k|.
+    std::vector<float> getBinEdges() const
+    {
+        return m_structure_factor.getBinEdges();
+    }
+
+    //! Get the centers of the bins of |k|.
+    std::vector<float> getBinCenters() const
+    {
+        return m_structure_factor.getBinCenters();
+    }
+
+    //! Get the k-vectors sampled for the box of the first frame.
+    std::vector<vec3<float>> getKPoints() const
+    {
+        return m_structure_factor.getKPoints();
+    }
+
+    //! Get the lags (in frames) at which the correlations have been accumulated.
+    const util::ManagedArray<unsigned int>& getLags()
+    {
+        reduce();
+        return m_lags;
+    }
+
+    //! Get the collective intermediate scattering function, with shape (lags, bins).
+    const util::ManagedArray<float>& getISF()
+    {
+        reduce();
+        return m_isf;
+    }
+
+    //! Get the self part of the intermediate scattering function, with shape (lags, bins).
+    const util::ManagedArray<float>& getSelfISF()
+    {
+        reduce();
+        return m_self_isf;
+    }
+
+    //! Get the number of pairs of frames averaged over for each lag.
+    const util::ManagedArray<unsigned int>& getCounts()
+    {
+        reduce();
+        return m_counts;
+    }
+
+private:
+    //! Collect the accumulated lags into the result arrays.
+    void reduce();
+
+    //! Bin the k-vectors sampled for the first frame.
+    void binKPoints();
+
+    StaticStructureFactorDirect m_structure_factor; //!< Samples the k-vectors and computes the amplitudes.
+    bool m_self_part;                               //!< Whether the self part is accumulated.
+    unsigned int m_bins;                            //!< Number of bins of |k|.
+    box::Box m_box;                                 //!< Box of the first frame.
+    unsigned int m_num_particles {0};               //!< Number of particles of the first frame.
+    std::vector<vec3<float>> m_k_points;            //!< Sampled k-vectors.
+    std::vector<unsigned int> m_k_bins;             //!< Bin of each k-vector, or m_bins if out of range.
+    std::vector<double> m_inverse_k_bin_counts;     //!< Inverse of the number of k-vectors in each bin.
+
+    util::MultipleTauCorrelator<std::complex<float>> m_collective; //!< Correlator of the amplitudes.
+    util::MultipleTauCorrelator<vec3<float>> m_self;               //!< Correlator of the positions.
+    bool m_reduce {true}; //!< Whether the results must be collected again.
+
+    util::ManagedArray<unsigned int> m_lags;   //!< Lags with accumulated pairs.
+    util::ManagedArray<float> m_isf;           //!< Collective intermediate scattering function.
+    util::ManagedArray<float> m_self_isf;      //!< Self part of the intermediate scattering function.
+    util::ManagedArray<unsigned int> m_counts; //!< Number of pairs of each lag.
+};
+
+}; }; // end namespace freud::diffraction
+
+#endif // INTERMEDIATE_SCATTERING_FUNCTION_H
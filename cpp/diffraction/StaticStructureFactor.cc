@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include "Histogram.h"
+#include "RawPoints.h"
 #include "StaticStructureFactor.h"
 
 /*! \file StaticStructureFactor.cc
@@ -22,4 +23,14 @@ StaticStructureFactor::StaticStructureFactor(unsigned int bins, float k_max, flo
     // lowest bin center, not the lowest bin's lower edge.
 }
 
+void StaticStructureFactor::accumulateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first,
+                                                 uint64_t last, uint64_t stride)
+{
+    trajectory.forEachFrame(first, last, stride, [&](const util::GSDFrame& frame) {
+        const unsigned int n_points = frame.getNumParticles();
+        const locality::RawPoints neighbor_query(frame.box, frame.positions.data(), n_points);
+        accumulate(&neighbor_query, frame.positions.data(), n_points, n_points);
+    });
+}
+
 }; }; // namespace freud::diffraction
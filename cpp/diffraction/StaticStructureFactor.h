@@ -7,6 +7,7 @@
 #include <limits>
 #include <vector>
 
+#include "GSDTrajectory.h"
 #include "Histogram.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
@@ -22,6 +23,13 @@ class StaticStructureFactor
 protected:
     using StructureFactorHistogram = util::Histogram<float>;
 
+    //! Thread local histograms in which the structure factor is summed over frames.
+    /*! The sums are kept in double precision, since the per-frame values
+     *  added to each bin over long trajectories would otherwise lose
+     *  precision in float.
+     */
+    using StructureFactorAccumulator = util::Histogram<double>::ThreadLocalHistogram;
+
     StaticStructureFactor(unsigned int bins, float k_max, float k_min = 0);
 
 public:
@@ -32,6 +40,13 @@ public:
                             unsigned int n_total)
         = 0;
 
+    //! Accumulate the frames first, first + stride, ... before last of a GSD trajectory.
+    /*! Each frame's particles are used as both points and query points, and
+     *  each frame is read while the previous one is accumulated.
+     */
+    void accumulateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first, uint64_t last,
+                              uint64_t stride);
+
     virtual void reset() = 0;
 
     //! Get the structure factor
@@ -72,9 +87,8 @@ protected:
         return thing_to_return;
     }
 
-    StructureFactorHistogram m_structure_factor; //!< Histogram to hold computed structure factor
-    StructureFactorHistogram::ThreadLocalHistogram
-        m_local_structure_factor; //!< Thread local histograms for TBB parallelism
+    StructureFactorHistogram m_structure_factor;         //!< Histogram to hold computed structure factor
+    StructureFactorAccumulator m_local_structure_factor; //!< Thread local histograms for TBB parallelism
 
     bool m_reduce {true};                                         //! Whether to reduce local histograms
     float m_min_valid_k {std::numeric_limits<float>::infinity()}; //! Minimum valid k-vector magnitude
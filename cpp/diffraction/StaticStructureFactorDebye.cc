@@ -5,12 +5,16 @@
 #include <bessel-library.hpp>
 #endif
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 
 #include "NeighborQuery.h"
 #include "StaticStructureFactorDebye.h"
+#include "ThreadStorage.h"
+#include "tbb_config.h"
 #include "utils.h"
 
 /*! \file StaticStructureFactorDebye.cc
@@ -20,6 +24,9 @@
 namespace freud { namespace diffraction {
 
 namespace {
+//! Number of pair distances computed at once before they are accumulated into all k bins.
+constexpr unsigned int DEBYE_TILE_SIZE = 2048;
+
 //! Given the desired k_max bin center, find the upper edge of the bin.
 float k_max_center_to_upper_edge(unsigned int bins, float k_min, float k_max)
 {
@@ -31,11 +38,55 @@ float k_min_center_to_lower_edge(unsigned int bins, float k_min, float k_max)
 {
     return k_min - (k_max - k_min) / static_cast<float>(2 * (bins - 1));
 }
+
+//! Get the number of bins of the pair distance histogram for distances up to r_bound.
+size_t numDistanceBins(float r_bound, float distance_bin_width)
+{
+    return static_cast<size_t>(std::ceil(r_bound / distance_bin_width)) + 1;
+}
+
+//! Get the sum of the lengths of the lattice vectors of a box.
+float latticeLengthSum(const box::Box& box)
+{
+    float length_sum = 0;
+    for (unsigned int d = 0; d < (box.is2D() ? 2 : 3); ++d)
+    {
+        const vec3<float> lattice_vector = box.getLatticeVector(d);
+        length_sum += std::sqrt(dot(lattice_vector, lattice_vector));
+    }
+    return length_sum;
+}
+
+//! Evaluate the term of the Debye scattering equation for a pair at distance r.
+template<bool is_2d> inline double debye_kernel(float k, float r)
+{
+    if (is_2d)
+    {
+        // floating point precision errors can cause k to be
+        // slightly negative, and make evaluating the cylindrical
+        // bessel function impossible.
+        auto nonnegative_k = std::max(float(0.0), k);
+
+#ifdef __clang__
+        // clang doesn't support the special math functions in
+        // C++17, so we use another library instead. The cast is
+        // needed because the other library's implementation is
+        // unique only for complex numbers, otherwise it just tries
+        // to call std::cyl_bessel_j.
+        return std::real(bessel::cyl_j0(std::complex<double>(nonnegative_k * r)));
+#else
+        return std::cyl_bessel_j(0, nonnegative_k * r);
+#endif
+    }
+    return util::sinc(k * r);
+}
 } // namespace
 
-StaticStructureFactorDebye::StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min)
+StaticStructureFactorDebye::StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min,
+                                                       float distance_bin_width)
     : StaticStructureFactor(bins, k_max_center_to_upper_edge(bins, k_min, k_max),
-                            k_min_center_to_lower_edge(bins, k_min, k_max))
+                            k_min_center_to_lower_edge(bins, k_min, k_max)),
+      m_distance_bin_width(distance_bin_width)
 {
     if (bins == 0)
     {
@@ -54,6 +105,11 @@ StaticStructureFactorDebye::StaticStructureFactorDebye(unsigned int bins, float
         throw std::invalid_argument(
             "StaticStructureFactorDebye requires that k_max must be greater than k_min.");
     }
+    if (distance_bin_width < 0)
+    {
+        throw std::invalid_argument(
+            "StaticStructureFactorDebye requires distance_bin_width to be non-negative.");
+    }
 }
 
 void StaticStructureFactorDebye::accumulate(const freud::locality::NeighborQuery* neighbor_query,
@@ -70,47 +126,189 @@ void StaticStructureFactorDebye::accumulate(const freud::locality::NeighborQuery
     const auto* const points = neighbor_query->getPoints();
     const auto n_points = neighbor_query->getNPoints();
 
-    std::vector<float> distances(n_points * n_query_points);
-    box.computeAllDistances(points, n_points, query_points, n_query_points, distances.data());
+    // The pair loops are specialized for the type of box.
+    util::ManagedArray<double> S_k;
+    const unsigned int num_threads
+        = parallel::getBudgetedNumThreads(getSharedMemory(box), getThreadMemory(box));
+    parallel::executeWithNumThreads(num_threads, [&]() {
+        S_k = box.withBoxTraits([&](auto traits) {
+            using BoxTraits = decltype(traits);
+            return m_distance_bin_width > 0
+                ? accumulateBinned<BoxTraits>(box, points, n_points, query_points, n_query_points)
+                : accumulateExact<BoxTraits>(box, points, n_points, query_points, n_query_points);
+        });
+    });
+    for (size_t k_index = 0; k_index < S_k.size(); ++k_index)
+    {
+        m_local_structure_factor.increment(k_index, S_k[k_index] / static_cast<double>(n_total));
+    }
+    m_frame_counter++;
+    m_reduce = true;
+}
+
+size_t StaticStructureFactorDebye::estimateMemory(const box::Box& box) const
+{
+    const size_t shared_memory = getSharedMemory(box);
+    const size_t thread_memory = getThreadMemory(box);
+    return shared_memory + parallel::getBudgetedNumThreads(shared_memory, thread_memory) * thread_memory;
+}
 
+size_t StaticStructureFactorDebye::getSharedMemory(const box::Box& box) const
+{
+    const size_t n_bins = m_structure_factor.getAxisSizes()[0];
+    size_t memory = 2 * n_bins * sizeof(double);
+    if (m_distance_bin_width > 0)
+    {
+        // The wrapped points lie within the parallelepiped spanned by the
+        // lattice vectors, which bounds the range of the distance histogram.
+        const float r_bound = float(1.5) * latticeLengthSum(box);
+        memory += numDistanceBins(r_bound, m_distance_bin_width) * (sizeof(double) + sizeof(float));
+    }
+    return memory;
+}
+
+size_t StaticStructureFactorDebye::getThreadMemory(const box::Box& box) const
+{
+    if (m_distance_bin_width > 0)
+    {
+        const float r_bound = float(1.5) * latticeLengthSum(box);
+        return numDistanceBins(r_bound, m_distance_bin_width) * sizeof(double) + sizeof(double);
+    }
+    return m_structure_factor.getAxisSizes()[0] * sizeof(double) + DEBYE_TILE_SIZE * sizeof(float);
+}
+
+template<typename BoxTraits>
+util::ManagedArray<double> StaticStructureFactorDebye::accumulateExact(const box::Box& box,
+                                                                       const vec3<float>* points,
+                                                                       unsigned int n_points,
+                                                                       const vec3<float>* query_points,
+                                                                       unsigned int n_query_points) const
+{
     const auto k_bin_centers = m_structure_factor.getBinCenters()[0];
+    const auto n_bins = k_bin_centers.size();
 
-    util::forLoopWrapper(0, m_structure_factor.getAxisSizes()[0], [&](size_t begin, size_t end) {
-        for (size_t k_index = begin; k_index < end; ++k_index)
+    // Rather than storing all n_points * n_query_points distances, the pairs
+    // are processed in tiles that stay in cache. Each tile of distances is
+    // accumulated into all k bins before the next one is computed.
+    util::ThreadStorage<double> local_S_k(n_bins);
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        auto& S_k = local_S_k.local();
+        std::array<float, DEBYE_TILE_SIZE> distances;
+        size_t i = begin;
+        unsigned int j = 0;
+        while (i < end)
         {
-            const auto k = k_bin_centers[k_index];
-            double S_k = 0.0;
-            for (const auto& distance : distances)
+            unsigned int n_tile = 0;
+            for (; n_tile < DEBYE_TILE_SIZE && i < end; ++n_tile)
             {
-                if (box.is2D())
+                distances[n_tile] = box.computeDistance<BoxTraits>(query_points[i], points[j]);
+                if (++j == n_points)
                 {
-                    // floating point precision errors can cause k to be
-                    // slightly negative, and make evaluating the cylindrical
-                    // bessel function impossible.
-                    auto nonnegative_k = std::max(float(0.0), k);
+                    j = 0;
+                    ++i;
+                }
+            }
 
-#ifdef __clang__
-                    // clang doesn't support the special math functions in
-                    // C++17, so we use another library instead. The cast is
-                    // needed because the other library's implementation is
-                    // unique only for complex numbers, otherwise it just tries
-                    // to call std::cyl_bessel_j.
-                    S_k += std::real(bessel::cyl_j0(std::complex<double>(nonnegative_k * distance)));
-#else
-                    S_k += std::cyl_bessel_j(0, nonnegative_k * distance);
-#endif
+            for (size_t k_index = 0; k_index < n_bins; ++k_index)
+            {
+                const auto k = k_bin_centers[k_index];
+                double S_k_tile = 0.0;
+                for (unsigned int n = 0; n < n_tile; ++n)
+                {
+                    S_k_tile += debye_kernel<BoxTraits::is_2d>(k, distances[n]);
+                }
+                S_k[k_index] += S_k_tile;
+            }
+        }
+    });
+
+    util::ManagedArray<double> S_k(n_bins);
+    local_S_k.reduceInto(S_k);
+    return S_k;
+}
+
+template<typename BoxTraits>
+util::ManagedArray<double> StaticStructureFactorDebye::accumulateBinned(const box::Box& box,
+                                                                        const vec3<float>* points,
+                                                                        unsigned int n_points,
+                                                                        const vec3<float>* query_points,
+                                                                        unsigned int n_query_points) const
+{
+    const auto k_bin_centers = m_structure_factor.getBinCenters()[0];
+    const auto n_bins = k_bin_centers.size();
+    if (n_points == 0 || n_query_points == 0)
+    {
+        return util::ManagedArray<double>(n_bins);
+    }
+
+    // A wrapped distance is at most the extent of all points plus half of the
+    // box lattice vectors, which bounds the range of the distance histogram.
+    vec3<float> lower(points[0]);
+    vec3<float> upper(points[0]);
+    const auto extend = [&](const vec3<float>& point) {
+        lower.x = std::min(lower.x, point.x);
+        lower.y = std::min(lower.y, point.y);
+        lower.z = std::min(lower.z, point.z);
+        upper.x = std::max(upper.x, point.x);
+        upper.y = std::max(upper.y, point.y);
+        upper.z = std::max(upper.z, point.z);
+    };
+    std::for_each(points, points + n_points, extend);
+    std::for_each(query_points, query_points + n_query_points, extend);
+    const vec3<float> extent = upper - lower;
+    const float r_bound = std::sqrt(dot(extent, extent)) + float(0.5) * latticeLengthSum(box);
+    const size_t n_distance_bins = numDistanceBins(r_bound, m_distance_bin_width);
+
+    util::Histogram<double> distance_histogram({std::make_shared<util::RegularAxis>(
+        n_distance_bins, 0, static_cast<float>(n_distance_bins) * m_distance_bin_width)});
+    util::Histogram<double>::ThreadLocalHistogram local_distance_histograms(distance_histogram);
+    // Coincident pairs, such as each point with itself, are counted exactly
+    // rather than at the center of the first bin.
+    util::ThreadStorage<double> local_n_coincident(1);
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        auto& histogram = local_distance_histograms.local();
+        auto& n_coincident = local_n_coincident.local()[0];
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (unsigned int j = 0; j < n_points; ++j)
+            {
+                const float distance = box.computeDistance<BoxTraits>(query_points[i], points[j]);
+                if (distance == 0)
+                {
+                    n_coincident += 1;
                 }
                 else
                 {
-                    S_k += util::sinc(k * distance);
+                    histogram(distance);
                 }
             }
-            S_k /= static_cast<double>(n_total);
-            m_local_structure_factor.increment(k_index, S_k);
-        };
+        }
     });
-    m_frame_counter++;
-    m_reduce = true;
+
+    util::ManagedArray<double> distance_counts(n_distance_bins);
+    local_distance_histograms.reduceInto(distance_counts);
+    util::ManagedArray<double> n_coincident(1);
+    local_n_coincident.reduceInto(n_coincident);
+    const auto distance_bin_centers = distance_histogram.getBinCenters()[0];
+
+    util::ManagedArray<double> S_k(n_bins);
+    util::forLoopWrapper(0, n_bins, [&](size_t begin, size_t end) {
+        for (size_t k_index = begin; k_index < end; ++k_index)
+        {
+            const auto k = k_bin_centers[k_index];
+            double S_k_value = n_coincident[0];
+            for (size_t r_index = 0; r_index < n_distance_bins; ++r_index)
+            {
+                if (distance_counts[r_index] != 0)
+                {
+                    S_k_value += distance_counts[r_index]
+                        * debye_kernel<BoxTraits::is_2d>(k, distance_bin_centers[r_index]);
+                }
+            }
+            S_k[k_index] = S_k_value;
+        }
+    });
+    return S_k;
 }
 
 void StaticStructureFactorDebye::reduce()
@@ -15,6 +15,11 @@
 
     This method is not capable of resolving k-vectors smaller than the magnitude 4 * pi / L, where L is the
     smallest side length of the system's periodic box.
+
+    If a distance bin width is given, the pair distances are binned into a histogram with bins of that width
+    and S(k) is evaluated from the histogram, which reduces the cost from O(N^2 * n_k) to
+    O(N^2 + n_r * n_k). Every distance is replaced by the center of its bin, so each term of the Debye sum
+    changes by at most k * distance_bin_width / 2.
 */
 
 namespace freud { namespace diffraction {
@@ -23,7 +28,12 @@ class StaticStructureFactorDebye : public StaticStructureFactor
 {
 public:
     //! Constructor
-    StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min = 0);
+    /*! \param bins The number of k values.
+     *  \param k_max The largest k value.
+     *  \param k_min The smallest k value.
+     *  \param distance_bin_width The width of the pair distance histogram bins, or zero for the exact sum.
+     */
+    StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min = 0, float distance_bin_width = 0);
 
     //! Compute the structure factor S(k) using the Debye formula
     void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
@@ -38,11 +48,45 @@ public:
         m_reduce = true;
     }
 
+    //! Estimate the peak memory of accumulate in bytes for points in the given box.
+    /*! The pair distances are never stored, so the memory does not depend
+     *  on the number of points. Each thread accumulates into its own copy of
+     *  S(k) (and of the pair distance histogram if distances are binned),
+     *  and accumulate uses fewer threads if the copies would not fit in the
+     *  memory budget (see parallel::setMemoryBudget).
+     */
+    size_t estimateMemory(const box::Box& box) const;
+
+    //! Get the width of the pair distance histogram bins (zero if the exact sum is computed)
+    float getDistanceBinWidth() const
+    {
+        return m_distance_bin_width;
+    }
+
 private:
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
 
+    //! Get the memory of accumulate that does not depend on the number of threads.
+    size_t getSharedMemory(const box::Box& box) const;
+
+    //! Get the memory of the thread local copies of each thread of accumulate.
+    size_t getThreadMemory(const box::Box& box) const;
+
+    //! Compute the unnormalized Debye sum for each k value from all pair distances.
+    template<typename BoxTraits>
+    util::ManagedArray<double> accumulateExact(const box::Box& box, const vec3<float>* points,
+                                               unsigned int n_points, const vec3<float>* query_points,
+                                               unsigned int n_query_points) const;
+
+    //! Compute the unnormalized Debye sum for each k value from a histogram of pair distances.
+    template<typename BoxTraits>
+    util::ManagedArray<double> accumulateBinned(const box::Box& box, const vec3<float>* points,
+                                                unsigned int n_points, const vec3<float>* query_points,
+                                                unsigned int n_query_points) const;
+
     unsigned int m_frame_counter {0}; //!< Number of frames calculated
+    float m_distance_bin_width;       //!< Width of the pair distance histogram bins, zero for the exact sum
 };
 
 }; }; // namespace freud::diffraction
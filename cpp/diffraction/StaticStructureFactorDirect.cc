@@ -1,19 +1,22 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <limits>
 #include <random>
 #include <stdexcept>
-#include <tbb/concurrent_vector.h>
 
 #include "Eigen/Eigen/Dense"
 
 #include "Box.h"
+#include "CPUDispatch.h"
+#include "FFT.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
 #include "StaticStructureFactorDirect.h"
+#include "ThreadStorage.h"
 #include "utils.h"
 
 /*! \file StaticStructureFactorDirect.cc
@@ -22,9 +25,44 @@
 
 namespace freud { namespace diffraction {
 
+namespace {
+
+//! Number of points whose phase factors are tabulated together in compute_F_k.
+constexpr size_t F_K_BLOCK_SIZE = 64;
+
+//! Number of independent partial sums per k-vector in compute_F_k.
+constexpr size_t F_K_LANES = 8;
+
+//! Get the indices of k-vectors sampled by reciprocal_isotropic in the reciprocal lattice.
+/*! Each k-vector is k = m_x b_x + m_y b_y + m_z b_z, where the reciprocal
+ *  lattice vectors b_i satisfy a_i \cdot b_j = 2 pi delta_ij for the lattice
+ *  vectors a_i. The sampled indices m_i are all non-negative.
+ */
+std::vector<vec3<unsigned int>> reciprocal_lattice_indices(const box::Box& box,
+                                                           const std::vector<vec3<float>>& k_points)
+{
+    const auto a1 = box.getLatticeVector(0);
+    const auto a2 = box.getLatticeVector(1);
+    const auto a3 = box.getLatticeVector(2);
+    std::vector<vec3<unsigned int>> k_indices(k_points.size());
+    for (size_t k_index = 0; k_index < k_points.size(); ++k_index)
+    {
+        const auto& k_vec = k_points[k_index];
+        k_indices[k_index] = vec3<unsigned int>(
+            static_cast<unsigned int>(std::lround(dot(k_vec, a1) / freud::constants::TWO_PI)),
+            static_cast<unsigned int>(std::lround(dot(k_vec, a2) / freud::constants::TWO_PI)),
+            static_cast<unsigned int>(std::lround(dot(k_vec, a3) / freud::constants::TWO_PI)));
+    }
+    return k_indices;
+}
+
+} // namespace
+
 StaticStructureFactorDirect::StaticStructureFactorDirect(unsigned int bins, float k_max, float k_min,
-                                                         unsigned int num_sampled_k_points)
+                                                         unsigned int num_sampled_k_points,
+                                                         unsigned int grid_size)
     : StaticStructureFactor(bins, k_max, k_min), m_num_sampled_k_points(num_sampled_k_points),
+      m_grid_size(grid_size),
       m_k_histogram(KBinHistogram(m_structure_factor.getAxes())),
       m_local_k_histograms(KBinHistogram::ThreadLocalHistogram(m_k_histogram))
 {
@@ -45,26 +83,107 @@ StaticStructureFactorDirect::StaticStructureFactorDirect(unsigned int bins, floa
         throw std::invalid_argument(
             "StaticStructureFactorDirect requires that k_max must be greater than k_min.");
     }
+    if (grid_size == 1)
+    {
+        throw std::invalid_argument(
+            "StaticStructureFactorDirect requires grid_size to be zero or at least 2.");
+    }
 }
 
 void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuery* neighbor_query,
                                              const vec3<float>* query_points, unsigned int n_query_points,
                                              unsigned int n_total)
 {
-    // Compute k vectors by sampling reciprocal space.
     const auto& box = neighbor_query->getBox();
+    updateKPoints(box);
+    accumulateFrame(box, neighbor_query->getPoints(), neighbor_query->getNPoints(), query_points,
+                    n_query_points, n_total);
+    m_reduce = true;
+}
+
+void StaticStructureFactorDirect::accumulateFrames(
+    const std::vector<const freud::locality::NeighborQuery*>& neighbor_queries,
+    const std::vector<const vec3<float>*>& query_points, unsigned int n_query_points, unsigned int n_total)
+{
+    if (!query_points.empty() && query_points.size() != neighbor_queries.size())
+    {
+        throw std::invalid_argument(
+            "StaticStructureFactorDirect requires one set of query points per frame, if any are given.");
+    }
+
+    // Consecutive frames in the same box share their k-vectors, so they are
+    // computed concurrently. A new set of k-vectors is sampled whenever the box changes.
+    size_t run_begin = 0;
+    while (run_begin < neighbor_queries.size())
+    {
+        const auto& box = neighbor_queries[run_begin]->getBox();
+        size_t run_end = run_begin + 1;
+        while (run_end < neighbor_queries.size() && neighbor_queries[run_end]->getBox() == box)
+        {
+            ++run_end;
+        }
+        updateKPoints(box);
+        util::forLoopWrapper(run_begin, run_end, [&](size_t begin, size_t end) {
+            for (size_t frame = begin; frame < end; ++frame)
+            {
+                const auto* neighbor_query = neighbor_queries[frame];
+                accumulateFrame(box, neighbor_query->getPoints(), neighbor_query->getNPoints(),
+                                query_points.empty() ? nullptr : query_points[frame], n_query_points,
+                                n_total);
+            }
+        });
+        run_begin = run_end;
+    }
+    m_reduce = true;
+}
+
+void StaticStructureFactorDirect::updateKPoints(const box::Box& box)
+{
     if (box.is2D())
     {
         throw std::invalid_argument("2D boxes are not currently supported.");
     }
-    const auto k_bin_edges = m_structure_factor.getBinEdges()[0];
-    const auto k_min = k_bin_edges.front();
-    const auto k_max = k_bin_edges.back();
+
+    // Compute k vectors by sampling reciprocal space. The k vectors, their
+    // bins, and the number of k vectors in each bin are reused for as long as
+    // the box does not change.
     if ((!box_assigned) || (box != previous_box))
     {
-        previous_box = box;
+        const auto k_bin_edges = m_structure_factor.getBinEdges()[0];
+        const auto k_min = k_bin_edges.front();
+        const auto k_max = k_bin_edges.back();
         m_k_points
             = StaticStructureFactorDirect::reciprocal_isotropic(box, k_max, k_min, m_num_sampled_k_points);
+        m_k_indices = reciprocal_lattice_indices(box, m_k_points);
+        m_k_bins.resize(m_k_points.size());
+        m_k_bin_counts.assign(m_structure_factor.getAxisSizes()[0], 0);
+        for (size_t k_index = 0; k_index < m_k_points.size(); ++k_index)
+        {
+            const auto& k_vec = m_k_points[k_index];
+            const auto k_magnitude = std::sqrt(dot(k_vec, k_vec));
+            m_k_bins[k_index] = m_structure_factor.bin({k_magnitude});
+            if (m_k_bins[k_index] < m_k_bin_counts.size())
+            {
+                ++m_k_bin_counts[m_k_bins[k_index]];
+            }
+        }
+        if (m_grid_size != 0)
+        {
+            // The grid frequencies of each k-vector along the lattice vectors
+            // are its reciprocal lattice indices. These must lie below the
+            // Nyquist frequency of the grid.
+            for (const auto& m : m_k_indices)
+            {
+                if (2 * std::max(m.x, std::max(m.y, m.z)) >= m_grid_size)
+                {
+                    throw std::invalid_argument(
+                        "The grid_size of StaticStructureFactorDirect is too small to resolve k_max in this "
+                        "box. The grid_size must be larger than 2 k_max L / (2 pi) along every box "
+                        "dimension L.");
+                }
+            }
+        }
+        previous_box = box;
         box_assigned = true;
     }
 
@@ -73,36 +192,91 @@ void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuer
     const auto min_box_length
         = box.is2D() ? std::min(box_L.x, box_L.y) : std::min(box_L.x, std::min(box_L.y, box_L.z));
     m_min_valid_k = std::min(m_min_valid_k, freud::constants::TWO_PI / min_box_length);
+}
+
+void StaticStructureFactorDirect::computeAmplitudes(const freud::locality::NeighborQuery* neighbor_query,
+                                                    const vec3<float>* query_points,
+                                                    unsigned int n_query_points, unsigned int n_total)
+{
+    const auto& box = neighbor_query->getBox();
+    updateKPoints(box);
+    const auto F_k_points
+        = computeFrameAmplitudes(box, neighbor_query->getPoints(), neighbor_query->getNPoints(), n_total);
+    m_F_k_points.prepare(F_k_points.size());
+    std::copy(F_k_points.begin(), F_k_points.end(), m_F_k_points.get());
+    if (query_points != nullptr)
+    {
+        const auto F_k_query_points = computeFrameAmplitudes(box, query_points, n_query_points, n_total);
+        m_F_k_query_points.prepare(F_k_query_points.size());
+        std::copy(F_k_query_points.begin(), F_k_query_points.end(), m_F_k_query_points.get());
+    }
+    else
+    {
+        m_F_k_query_points.prepare(0);
+    }
+}
+
+void StaticStructureFactorDirect::accumulateAmplitudes(const std::complex<float>* F_k_points,
+                                                       const std::complex<float>* F_k_query_points)
+{
+    const std::vector<std::complex<float>> F_k_points_vec(F_k_points, F_k_points + m_k_points.size());
+    if (F_k_query_points != nullptr)
+    {
+        const std::vector<std::complex<float>> F_k_query_points_vec(F_k_query_points,
+                                                                    F_k_query_points + m_k_points.size());
+        binStructureFactor(StaticStructureFactorDirect::compute_S_k(F_k_points_vec, F_k_query_points_vec));
+    }
+    else
+    {
+        binStructureFactor(StaticStructureFactorDirect::compute_S_k(F_k_points_vec, F_k_points_vec));
+    }
+    m_reduce = true;
+}
+
+std::vector<std::complex<float>>
+StaticStructureFactorDirect::computeFrameAmplitudes(const box::Box& box, const vec3<float>* points,
+                                                    unsigned int n_points, unsigned int n_total) const
+{
+    if (m_grid_size == 0)
+    {
+        return StaticStructureFactorDirect::compute_F_k(box, points, n_points, n_total, m_k_indices);
+    }
+    return StaticStructureFactorDirect::compute_F_k_mesh(box, points, n_points, n_total, m_k_indices,
+                                                         m_grid_size);
+}
 
+void StaticStructureFactorDirect::accumulateFrame(const box::Box& box, const vec3<float>* points,
+                                                  unsigned int n_points, const vec3<float>* query_points,
+                                                  unsigned int n_query_points, unsigned int n_total)
+{
     // Compute F_k for the points.
-    const auto F_k_points = StaticStructureFactorDirect::compute_F_k(
-        neighbor_query->getPoints(), neighbor_query->getNPoints(), n_total, m_k_points);
+    const auto F_k_points = computeFrameAmplitudes(box, points, n_points, n_total);
 
     // Compute F_k for the query points (if necessary) and compute the product S_k.
-    std::vector<float> S_k_all_points;
     if (query_points != nullptr)
     {
-        const auto F_k_query_points
-            = StaticStructureFactorDirect::compute_F_k(query_points, n_query_points, n_total, m_k_points);
-        S_k_all_points = StaticStructureFactorDirect::compute_S_k(F_k_points, F_k_query_points);
+        const auto F_k_query_points = computeFrameAmplitudes(box, query_points, n_query_points, n_total);
+        binStructureFactor(StaticStructureFactorDirect::compute_S_k(F_k_points, F_k_query_points));
     }
     else
     {
-        S_k_all_points = StaticStructureFactorDirect::compute_S_k(F_k_points, F_k_points);
+        binStructureFactor(StaticStructureFactorDirect::compute_S_k(F_k_points, F_k_points));
     }
+}
 
+void StaticStructureFactorDirect::binStructureFactor(const std::vector<float>& S_k)
+{
     // Bin the S_k values and track the number of k values in each bin.
     util::forLoopWrapper(0, m_k_points.size(), [&](size_t begin, size_t end) {
         for (size_t k_index = begin; k_index < end; ++k_index)
         {
-            const auto& k_vec = m_k_points[k_index];
-            const auto k_magnitude = std::sqrt(dot(k_vec, k_vec));
-            const auto k_bin = m_structure_factor.bin({k_magnitude});
-            m_local_structure_factor.increment(k_bin, S_k_all_points[k_index]);
-            m_local_k_histograms.increment(k_bin);
+            m_local_structure_factor.increment(m_k_bins[k_index], S_k[k_index]);
         };
     });
-    m_reduce = true;
+    for (size_t k_bin = 0; k_bin < m_k_bin_counts.size(); ++k_bin)
+    {
+        m_local_k_histograms.increment(k_bin, m_k_bin_counts[k_bin]);
+    }
 }
 
 void StaticStructureFactorDirect::reduce()
@@ -121,25 +295,195 @@ void StaticStructureFactorDirect::reduce()
 }
 
 std::vector<std::complex<float>>
-StaticStructureFactorDirect::compute_F_k(const vec3<float>* points, unsigned int n_points,
-                                         unsigned int n_total, const std::vector<vec3<float>>& k_points)
+StaticStructureFactorDirect::compute_F_k(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                                         unsigned int n_total,
+                                         const std::vector<vec3<unsigned int>>& k_indices)
 {
-    const auto n_k_points = k_points.size();
+    // Every k-vector is k = m_x b_x + m_y b_y + m_z b_z for reciprocal lattice
+    // vectors b_i, so exp(i k \cdot r) is the product of integer powers of
+    // exp(i b_i \cdot r). For each block of points, these powers are tabulated
+    // with a recurrence that needs one sincos per point and dimension. Every
+    // term of F(k) is then a product of three table entries, and no
+    // transcendental functions are evaluated in the loop over k-vectors.
+    const auto n_k_points = k_indices.size();
+    vec3<unsigned int> max_index(0, 0, 0);
+    for (const auto& m : k_indices)
+    {
+        max_index.x = std::max(max_index.x, m.x);
+        max_index.y = std::max(max_index.y, m.y);
+        max_index.z = std::max(max_index.z, m.z);
+    }
+    const size_t table_rows[3] = {max_index.x + 1, max_index.y + 1, max_index.z + 1};
+    const size_t n_blocks = (n_points + F_K_BLOCK_SIZE - 1) / F_K_BLOCK_SIZE;
+
+    util::ThreadStorage<std::complex<double>> local_F_k(n_k_points);
+    util::forLoopWrapper2D(0, n_blocks, 0, n_k_points,
+                           [&](size_t begin_block, size_t end_block, size_t begin_k, size_t end_k) {
+        auto& F_k_local = local_F_k.local();
+
+        // Real and imaginary parts of exp(i m b_d \cdot r_j) for each
+        // dimension d, stored at m * F_K_BLOCK_SIZE + j.
+        std::vector<float> table_re[3];
+        std::vector<float> table_im[3];
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            table_re[d].resize(table_rows[d] * F_K_BLOCK_SIZE);
+            table_im[d].resize(table_rows[d] * F_K_BLOCK_SIZE);
+        }
+
+        for (size_t block = begin_block; block < end_block; ++block)
+        {
+            const size_t first_point = block * F_K_BLOCK_SIZE;
+            const size_t block_size = std::min<size_t>(F_K_BLOCK_SIZE, n_points - first_point);
+            for (size_t j = 0; j < F_K_BLOCK_SIZE; ++j)
+            {
+                // Padding points get a phase factor of zero so they do not contribute.
+                vec3<float> f(0, 0, 0);
+                std::complex<double> power_initial(0);
+                if (j < block_size)
+                {
+                    f = box.makeFractional(points[first_point + j]) - vec3<float>(0.5, 0.5, 0.5);
+                    power_initial = 1;
+                }
+                const float fractional[3] = {f.x, f.y, f.z};
+                for (unsigned int d = 0; d < 3; ++d)
+                {
+                    // The recurrence is carried out in double precision so
+                    // that rounding errors do not accumulate in high powers.
+                    const auto theta = freud::constants::TWO_PI * static_cast<double>(fractional[d]);
+                    const std::complex<double> step(std::cos(theta), std::sin(theta));
+                    std::complex<double> power = power_initial;
+                    for (size_t m = 0; m < table_rows[d]; ++m)
+                    {
+                        table_re[d][m * F_K_BLOCK_SIZE + j] = static_cast<float>(power.real());
+                        table_im[d][m * F_K_BLOCK_SIZE + j] = static_cast<float>(power.imag());
+                        power *= step;
+                    }
+                }
+            }
+
+            // The products of the table entries are the hot loop, and are
+            // compiled for the instruction set of the CPU.
+            util::dispatch([&]() FREUD_KERNEL {
+                for (size_t k_index = begin_k; k_index < end_k; ++k_index)
+                {
+                    const auto& m = k_indices[k_index];
+                    const float* x_re = table_re[0].data() + m.x * F_K_BLOCK_SIZE;
+                    const float* x_im = table_im[0].data() + m.x * F_K_BLOCK_SIZE;
+                    const float* y_re = table_re[1].data() + m.y * F_K_BLOCK_SIZE;
+                    const float* y_im = table_im[1].data() + m.y * F_K_BLOCK_SIZE;
+                    const float* z_re = table_re[2].data() + m.z * F_K_BLOCK_SIZE;
+                    const float* z_im = table_im[2].data() + m.z * F_K_BLOCK_SIZE;
+
+                    // Partial sums are kept per lane so that the compiler can
+                    // vectorize the loop without reassociating a reduction.
+                    float sum_re[F_K_LANES] = {};
+                    float sum_im[F_K_LANES] = {};
+                    for (size_t j0 = 0; j0 < F_K_BLOCK_SIZE; j0 += F_K_LANES)
+                    {
+                        for (size_t lane = 0; lane < F_K_LANES; ++lane)
+                        {
+                            const size_t j = j0 + lane;
+                            const float xy_re = x_re[j] * y_re[j] - x_im[j] * y_im[j];
+                            const float xy_im = x_re[j] * y_im[j] + x_im[j] * y_re[j];
+                            sum_re[lane] += xy_re * z_re[j] - xy_im * z_im[j];
+                            sum_im[lane] += xy_re * z_im[j] + xy_im * z_re[j];
+                        }
+                    }
+                    std::complex<double> F_ki(0);
+                    for (size_t lane = 0; lane < F_K_LANES; ++lane)
+                    {
+                        F_ki += std::complex<double>(sum_re[lane], sum_im[lane]);
+                    }
+                    F_k_local[k_index] += F_ki;
+                }
+            });
+        }
+    });
+
+    util::ManagedArray<std::complex<double>> F_k_sum(n_k_points);
+    local_F_k.reduceInto(F_k_sum);
     auto F_k = std::vector<std::complex<float>>(n_k_points);
-    const std::complex<float> normalization(1.0F / std::sqrt(static_cast<float>(n_total)));
+    const double normalization(1.0 / std::sqrt(static_cast<double>(n_total)));
+    for (size_t k_index = 0; k_index < n_k_points; ++k_index)
+    {
+        F_k[k_index] = std::complex<float>(F_k_sum[k_index] * normalization);
+    }
+    return F_k;
+}
 
-    util::forLoopWrapper(0, n_k_points, [&](size_t begin, size_t end) {
-        for (size_t k_index = begin; k_index < end; ++k_index)
+std::vector<std::complex<float>> StaticStructureFactorDirect::compute_F_k_mesh(
+    const box::Box& box, const vec3<float>* points, unsigned int n_points, unsigned int n_total,
+    const std::vector<vec3<unsigned int>>& k_indices, unsigned int grid_size)
+{
+    const auto n_k_points = k_indices.size();
+
+    // Assign the points to the grid with a triangular-shaped cloud window.
+    // Grid point n along each dimension sits at fractional coordinate n / grid_size.
+    const auto M = static_cast<int>(grid_size);
+    util::ThreadStorage<float> local_density({grid_size, grid_size, grid_size});
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        auto& density = local_density.local();
+        for (size_t r_index = begin; r_index < end; ++r_index)
         {
-            std::complex<float> F_ki(0);
-            for (size_t r_index = 0; r_index < n_points; ++r_index)
+            const vec3<float> grid_coord
+                = box.makeFractional(box.wrap(points[r_index])) * static_cast<float>(grid_size);
+            int nearest[3];
+            float weights[3][3];
+            const float coords[3] = {grid_coord.x, grid_coord.y, grid_coord.z};
+            for (unsigned int d = 0; d < 3; ++d)
+            {
+                const auto center = std::round(coords[d]);
+                const auto dx = coords[d] - center;
+                nearest[d] = static_cast<int>(center);
+                weights[d][0] = 0.5F * (0.5F - dx) * (0.5F - dx);
+                weights[d][1] = 0.75F - dx * dx;
+                weights[d][2] = 0.5F * (0.5F + dx) * (0.5F + dx);
+            }
+            for (int i = 0; i < 3; ++i)
             {
-                const auto& k_vec(k_points[k_index]);
-                const auto& r_vec(points[r_index]);
-                const auto alpha(dot(k_vec, r_vec));
-                F_ki += std::exp(std::complex<float>(0, alpha));
+                const auto ni = static_cast<size_t>(util::modulusPositive(nearest[0] + i - 1, M));
+                for (int j = 0; j < 3; ++j)
+                {
+                    const auto nj = static_cast<size_t>(util::modulusPositive(nearest[1] + j - 1, M));
+                    const auto w_ij = weights[0][i] * weights[1][j];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const auto nk = static_cast<size_t>(util::modulusPositive(nearest[2] + k - 1, M));
+                        density(ni, nj, nk) += w_ij * weights[2][k];
+                    }
+                }
             }
-            F_k[k_index] = F_ki * normalization;
+        }
+    });
+    util::ManagedArray<float> density({grid_size, grid_size, grid_size});
+    local_density.reduceInto(density);
+
+    util::ManagedArray<std::complex<float>> F_grid({grid_size, grid_size, grid_size});
+    for (size_t i = 0; i < density.size(); ++i)
+    {
+        F_grid[i] = density[i];
+    }
+    util::fft3D(F_grid);
+
+    // The forward FFT uses the phase exp(-i k \cdot r), so the amplitudes are
+    // the complex conjugate of the transform divided by the window function.
+    std::vector<float> window(grid_size / 2 + 1);
+    window[0] = 1;
+    for (size_t m = 1; m < window.size(); ++m)
+    {
+        const auto x = static_cast<float>(M_PI) * static_cast<float>(m) / static_cast<float>(grid_size);
+        const auto sinc = std::sin(x) / x;
+        window[m] = sinc * sinc * sinc;
+    }
+    auto F_k = std::vector<std::complex<float>>(n_k_points);
+    const float normalization(1.0F / std::sqrt(static_cast<float>(n_total)));
+    util::forLoopWrapper(0, n_k_points, [&](size_t begin, size_t end) {
+        for (size_t k_index = begin; k_index < end; ++k_index)
+        {
+            const auto& m = k_indices[k_index];
+            F_k[k_index] = std::conj(F_grid(m.x, m.y, m.z)) * normalization
+                / (window[m.x] * window[m.y] * window[m.z]);
         }
     });
     return F_k;
@@ -223,27 +567,26 @@ std::vector<vec3<float>> StaticStructureFactorDirect::reciprocal_isotropic(const
 
     // The maximum number of k points is a guideline. The true number of sampled
     // k points can be less or greater than num_sampled_k_points, depending on the
-    // result of the random pruning procedure. Therefore, we cannot allocate a
-    // fixed size for the data. Also, reserving capacity for the concurrent
-    // vector had no measureable effect on performance.
-    tbb::concurrent_vector<vec3<float>> k_points;
-
-    // This is a 3D loop but we parallelize in 1D because we only need to seed
-    // the random number generators once per block and there is no benefit of
-    // locality if we parallelize in 2D or 3D.
-    util::forLoopWrapper(0, N_kx, [&](size_t begin, size_t end) {
-        // Set up thread-local random number generator for k point pruning.
-        const auto thread_start = static_cast<unsigned int>(begin);
-        std::random_device rd;
-        std::seed_seq seed {thread_start, rd(), rd(), rd()};
-        std::mt19937 rng(seed);
-        std::uniform_real_distribution<float> base_dist(0, 1);
-        auto random_prune = [&]() { return base_dist(rng); };
+    // result of the random pruning procedure. Therefore, the k points of each
+    // kx value are collected separately and concatenated in order.
+    std::vector<std::vector<vec3<float>>> k_point_rows(N_kx);
 
+    // This is a 3D loop but we parallelize in 1D because there is no benefit
+    // of locality if we parallelize in 2D or 3D. The random number generator
+    // for k point pruning is seeded with the kx value, so the sampled k points
+    // only depend on the box and not on the number of threads or the call.
+    // Separate processes holding parts of a system therefore sample the same k
+    // points, so their scattering amplitudes can be summed.
+    util::forLoopWrapper(0, N_kx, [&](size_t begin, size_t end) {
         const auto add_all_k_points = std::isinf(q_prune_distance);
 
         for (unsigned int kx = begin; kx < end; ++kx)
         {
+            std::seed_seq seed {kx};
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> base_dist(0, 1);
+            auto random_prune = [&]() { return base_dist(rng); };
+            auto& k_points = k_point_rows[kx];
             const auto k_vec_x = static_cast<float>(kx) * bx;
             for (unsigned int ky = 0; ky < N_ky; ++ky)
             {
@@ -289,7 +632,12 @@ std::vector<vec3<float>> StaticStructureFactorDirect::reciprocal_isotropic(const
             }
         }
     });
-    return std::vector<vec3<float>>(k_points.cbegin(), k_points.cend());
+    std::vector<vec3<float>> k_points;
+    for (const auto& row : k_point_rows)
+    {
+        k_points.insert(k_points.end(), row.cbegin(), row.cend());
+    }
+    return k_points;
 }
 
 }; }; // namespace freud::diffraction
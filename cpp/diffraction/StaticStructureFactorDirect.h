@@ -28,6 +28,13 @@
     according to their k-vector's magnitude and normalized by the number of
     samples in each radial bin in k-space.
 
+    If a nonzero grid size is given, the scattering amplitudes are instead
+    computed with a particle-mesh method: the particles are assigned to a
+    periodic grid of fractional coordinates with a triangular-shaped cloud
+    (TSC) window, the grid is Fourier transformed, and the amplitudes at the
+    sampled k-vectors are read off the transform after dividing out the
+    window. This costs O(N + M^3 log M) instead of O(N n_k).
+
     Note that k-vectors are in the physics convention, and q-vectors are in the
     crystallographic convention. These conventions differ by a factor of 2\pi.
 
@@ -48,12 +55,60 @@ class StaticStructureFactorDirect : public StaticStructureFactor
 public:
     //! Constructor
     StaticStructureFactorDirect(unsigned int bins, float k_max, float k_min = 0,
-                                unsigned int num_sampled_k_points = 0);
+                                unsigned int num_sampled_k_points = 0, unsigned int grid_size = 0);
 
     //! Compute the structure factor S(k) using the direct formula
     void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                     unsigned int n_query_points, unsigned int n_total) override;
 
+    //! Compute the structure factor S(k) of several frames using the direct formula
+    /*! Frames in the same box reuse the sampled k-vectors and are computed concurrently.
+     *
+     *  \param neighbor_queries The points of each frame.
+     *  \param query_points The query points of each frame, or empty to use the points.
+     *  \param n_query_points The number of query points in each frame.
+     *  \param n_total The total number of points in each frame.
+     */
+    void accumulateFrames(const std::vector<const freud::locality::NeighborQuery*>& neighbor_queries,
+                          const std::vector<const vec3<float>*>& query_points, unsigned int n_query_points,
+                          unsigned int n_total);
+
+    //! Compute the scattering amplitudes F(k) of the points of one domain of a system
+    /*! When the points of a system are split into domains held by separate
+     *  processes, F(k) of the system is the sum of F(k) of the domains. Each
+     *  process computes the amplitudes of its points with this method, the
+     *  amplitudes are summed across processes, and the sums are passed to
+     *  accumulateAmplitudes. The k-vectors only depend on the box, so every
+     *  process samples the same k-vectors.
+     *
+     *  \param neighbor_query The points of this domain, in the box of the whole system.
+     *  \param query_points The query points of this domain, or nullptr to use the points.
+     *  \param n_query_points The number of query points of this domain.
+     *  \param n_total The total number of points in the whole system.
+     */
+    void computeAmplitudes(const freud::locality::NeighborQuery* neighbor_query,
+                           const vec3<float>* query_points, unsigned int n_query_points,
+                           unsigned int n_total);
+
+    //! Accumulate the structure factor S(k) from the scattering amplitudes of a whole system
+    /*! \param F_k_points The amplitudes of the points at each k-vector of the last computeAmplitudes call.
+     *  \param F_k_query_points The amplitudes of the query points, or nullptr to use the points.
+     */
+    void accumulateAmplitudes(const std::complex<float>* F_k_points,
+                              const std::complex<float>* F_k_query_points);
+
+    //! Get the scattering amplitudes of the points from the last call to computeAmplitudes
+    const util::ManagedArray<std::complex<float>>& getPointAmplitudes() const
+    {
+        return m_F_k_points;
+    }
+
+    //! Get the scattering amplitudes of the query points from the last call to computeAmplitudes
+    const util::ManagedArray<std::complex<float>>& getQueryPointAmplitudes() const
+    {
+        return m_F_k_query_points;
+    }
+
     //! Reset the histogram to all zeros
     void reset() override
     {
@@ -70,6 +125,12 @@ public:
         return m_num_sampled_k_points;
     }
 
+    //! Get the number of grid points per dimension of the particle mesh, zero if F(k) is computed directly
+    unsigned int getGridSize() const
+    {
+        return m_grid_size;
+    }
+
     //! Get the k points last used
     std::vector<vec3<float>> getKPoints() const
     {
@@ -80,10 +141,30 @@ private:
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
 
+    //! Sample the k points for a box, unless they were already sampled for it
+    void updateKPoints(const box::Box& box);
+
+    //! Accumulate the structure factor of one frame using the current k points
+    void accumulateFrame(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                         const vec3<float>* query_points, unsigned int n_query_points, unsigned int n_total);
+
+    //! Compute F(k) of a set of points at the current k points, directly or with the particle mesh
+    std::vector<std::complex<float>> computeFrameAmplitudes(const box::Box& box, const vec3<float>* points,
+                                                            unsigned int n_points, unsigned int n_total) const;
+
+    //! Bin the structure factor S(k) at the current k points
+    void binStructureFactor(const std::vector<float>& S_k);
+
     //! Compute the complex amplitude F(k) for a set of points and k points
-    static std::vector<std::complex<float>> compute_F_k(const vec3<float>* points, unsigned int n_points,
-                                                        unsigned int n_total,
-                                                        const std::vector<vec3<float>>& k_points);
+    static std::vector<std::complex<float>> compute_F_k(const box::Box& box, const vec3<float>* points,
+                                                        unsigned int n_points, unsigned int n_total,
+                                                        const std::vector<vec3<unsigned int>>& k_indices);
+
+    //! Compute the complex amplitude F(k) for a set of points and k points using a particle mesh
+    static std::vector<std::complex<float>> compute_F_k_mesh(const box::Box& box, const vec3<float>* points,
+                                                             unsigned int n_points, unsigned int n_total,
+                                                             const std::vector<vec3<unsigned int>>& k_indices,
+                                                             unsigned int grid_size);
 
     //! Compute the static structure factor S(k) for all k points
     static std::vector<float> compute_S_k(const std::vector<std::complex<float>>& F_k_points,
@@ -93,11 +174,19 @@ private:
     static std::vector<vec3<float>> reciprocal_isotropic(const box::Box& box, float k_max, float k_min,
                                                          unsigned int num_sampled_k_points);
 
-    unsigned int m_num_sampled_k_points; //!< Target number of k-vectors to sample
-    std::vector<vec3<float>> m_k_points; //!< k-vectors used for sampling
-    KBinHistogram m_k_histogram;         //!< Histogram of sampled k bins, used to normalize S(q)
+    unsigned int m_num_sampled_k_points;         //!< Target number of k-vectors to sample
+    unsigned int m_grid_size;                    //!< Grid points per dimension of the mesh (0 for direct)
+    std::vector<vec3<float>> m_k_points;         //!< k-vectors used for sampling
+    std::vector<vec3<unsigned int>> m_k_indices; //!< Reciprocal lattice indices of the k-vectors
+    std::vector<size_t> m_k_bins;                //!< Histogram bin of each k-vector
+    std::vector<unsigned int> m_k_bin_counts;    //!< Number of k-vectors in each histogram bin
+    KBinHistogram m_k_histogram;                 //!< Histogram of sampled k bins, used to normalize S(q)
     KBinHistogram::ThreadLocalHistogram
         m_local_k_histograms;  //!< Thread local histograms of sampled k bins for TBB parallelism
+    util::ManagedArray<std::complex<float>>
+        m_F_k_points; //!< Amplitudes of the points from the last computeAmplitudes call
+    util::ManagedArray<std::complex<float>>
+        m_F_k_query_points;    //!< Amplitudes of the query points from the last computeAmplitudes call
     box::Box previous_box;     //!< box assigned to the system
     bool box_assigned {false}; //!< Whether to reuse the box
 };
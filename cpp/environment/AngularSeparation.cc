@@ -1,6 +1,15 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#if defined(__SSE__)
+#include <immintrin.h>
+#endif
+
 #include "AngularSeparation.h"
 #include "NeighborComputeFunctional.h"
 #include "utils.h"
@@ -11,44 +20,103 @@
 
 namespace freud { namespace environment {
 
-float computeSeparationAngle(const quat<float>& ref_q, const quat<float>& q)
+namespace {
+
+//! Convert the largest overlap between two sets of orientations into their separation angle.
+inline float overlapToAngle(float overlap)
 {
-    quat<float> R = q * conj(ref_q);
-    auto theta = float(2.0 * std::acos(util::clamp(R.s, -1, 1)));
-    return theta;
+    return float(2.0 * std::acos(util::clamp(overlap, -1, 1)));
 }
 
-// The set of all equivalent quaternions equiv_qs is the set that takes the particle as it
-// is defined to some global reference orientation. Thus, to be safe, we must include
-// a rotation by qconst as defined below when doing the calculation.
-// Important: equiv_qs must include both q and -q, for all included quaternions
-float computeMinSeparationAngle(const quat<float>& ref_q, const quat<float>& q, const quat<float>* equiv_qs,
-                                unsigned int n_equiv_quats)
+//! A set of quaternions stored by component to evaluate their overlaps with a quaternion together.
+/*! The overlap of two unit quaternions is the scalar part of q * conj(p), so
+ *  the smallest separation angle over a set of quaternions is given by the
+ *  largest overlap, and only one arccosine has to be evaluated per pair. The
+ *  components are padded to a multiple of four with copies of the first
+ *  quaternion so that overlaps can be evaluated four at a time.
+ */
+class QuaternionSet
 {
-    quat<float> qconst = equiv_qs[0];
-    // here we undo a rotation represented by one of the equivalent orientations
-    quat<float> qtemp = q * conj(qconst);
-
-    // start with the quaternion before it has been rotated by equivalent rotations
-    float min_angle = computeSeparationAngle(ref_q, q);
-
-    // loop through all equivalent rotations and see if they have smaller angles with ref_q
-    for (unsigned int i = 0; i < n_equiv_quats; ++i)
+public:
+    QuaternionSet(const quat<float>* qs, unsigned int n_qs, const quat<float>& left)
     {
-        quat<float> qe = equiv_qs[i];
-        quat<float> qtest = qtemp * qe;
-
-        float angle_test = computeSeparationAngle(ref_q, qtest);
+        const size_t n_padded = (n_qs + 3) / 4 * 4;
+        m_s.resize(n_padded);
+        m_x.resize(n_padded);
+        m_y.resize(n_padded);
+        m_z.resize(n_padded);
+        for (size_t i = 0; i < n_padded; ++i)
+        {
+            const quat<float> q = left * qs[i < n_qs ? i : 0];
+            m_s[i] = q.s;
+            m_x[i] = q.v.x;
+            m_y[i] = q.v.y;
+            m_z[i] = q.v.z;
+        }
+    }
 
-        if (angle_test < min_angle)
+    //! Get the largest overlap of any quaternion of the set with p, or -infinity for an empty set.
+    float maxOverlap(const quat<float>& p) const
+    {
+        float best = -std::numeric_limits<float>::infinity();
+#if defined(__SSE__)
+        const __m128 p_s = _mm_set1_ps(p.s);
+        const __m128 p_x = _mm_set1_ps(p.v.x);
+        const __m128 p_y = _mm_set1_ps(p.v.y);
+        const __m128 p_z = _mm_set1_ps(p.v.z);
+        __m128 best_v = _mm_set1_ps(best);
+        for (size_t i = 0; i < m_s.size(); i += 4)
+        {
+            const __m128 overlap = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_s[i]), p_s), _mm_mul_ps(_mm_loadu_ps(&m_x[i]), p_x)),
+                _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_y[i]), p_y), _mm_mul_ps(_mm_loadu_ps(&m_z[i]), p_z)));
+            // NaN overlaps are ignored because _mm_max_ps returns its second argument for them.
+            best_v = _mm_max_ps(overlap, best_v);
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, best_v);
+        for (const float lane : lanes)
+        {
+            best = std::max(best, lane);
+        }
+#else
+        for (size_t i = 0; i < m_s.size(); ++i)
         {
-            min_angle = angle_test;
+            const float overlap = (m_s[i] * p.s + m_x[i] * p.v.x) + (m_y[i] * p.v.y + m_z[i] * p.v.z);
+            if (overlap > best)
+            {
+                best = overlap;
+            }
         }
+#endif
+        return best;
     }
 
-    return min_angle;
+private:
+    std::vector<float> m_s; //!< Scalar parts of the quaternions.
+    std::vector<float> m_x; //!< x components of the quaternions.
+    std::vector<float> m_y; //!< y components of the quaternions.
+    std::vector<float> m_z; //!< z components of the quaternions.
+};
+
+//! Overlap of two quaternions, the scalar part of q * conj(ref_q).
+inline float overlap(const quat<float>& ref_q, const quat<float>& q)
+{
+    return (q * conj(ref_q)).s;
 }
 
+} // namespace
+
+// The set of all equivalent quaternions equiv_qs is the set that takes the particle as it
+// is defined to some global reference orientation. Thus, to be safe, we must include
+// a rotation by qconst = equiv_qs[0] when doing the calculation, and a quaternion q is
+// compared to ref_q through the quaternions q * conj(qconst) * qe for every qe in equiv_qs.
+// Important: equiv_qs must include both q and -q, for all included quaternions
+//
+// The overlap of q * conj(qconst) * qe with ref_q equals the overlap of qe with
+// conj(q * conj(qconst)) * ref_q, so each pair only needs one quaternion product
+// followed by a dot product with every equivalent quaternion.
+
 void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const quat<float>* orientations,
                                         const vec3<float>* query_points,
                                         const quat<float>* query_orientations, unsigned int n_query_points,
@@ -59,22 +127,35 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
     // This function requires a NeighborList object, so we always make one and store it locally.
     m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs);
 
+    // Bonds read orientations by query point index and query_orientations by point index.
+    if (m_nlist.getNumQueryPoints() != nq->getNPoints())
+    {
+        throw std::invalid_argument("AngularSeparationNeighbor requires as many query points as points.");
+    }
+
     const size_t tot_num_neigh = m_nlist.getNumBonds();
     m_angles.prepare(tot_num_neigh);
 
-    util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
-        size_t bond(m_nlist.find_first_index(begin));
+    const QuaternionSet equiv_qs(equiv_orientations, n_equiv_orientations, quat<float>());
+    const quat<float> qconst_conj
+        = (n_equiv_orientations == 0) ? quat<float>() : conj(equiv_orientations[0]);
+
+    m_nlist.updateSegmentCounts();
+    util::forLoopWrapper(0, m_nlist.getNumQueryPoints(), [&](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
         {
-            quat<float> q = orientations[i];
+            const quat<float>& q = orientations[i];
 
-            for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+            const locality::NeighborListSegment segment(m_nlist.getSegment(i));
+            for (unsigned int k = 0; k < segment.size(); ++k)
             {
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
-                quat<float> query_q = query_orientations[j];
+                const size_t j(segment.getPointIdx(k));
+                const quat<float>& query_q = query_orientations[j];
 
-                float theta = computeMinSeparationAngle(q, query_q, equiv_orientations, n_equiv_orientations);
-                m_angles[bond] = theta;
+                // start with the quaternion before it has been rotated by equivalent rotations
+                const float best
+                    = std::max(overlap(q, query_q), equiv_qs.maxOverlap(conj(query_q * qconst_conj) * q));
+                m_angles[segment.begin() + k] = overlapToAngle(best);
             }
         }
     });
@@ -87,16 +168,26 @@ void AngularSeparationGlobal::compute(const quat<float>* global_orientations, un
 {
     m_angles.prepare({n_points, n_global});
 
+    // The equivalent orientations of each global orientation are only generated once.
+    const quat<float> qconst_conj
+        = (n_equiv_orientations == 0) ? quat<float>() : conj(equiv_orientations[0]);
+    std::vector<QuaternionSet> global_equiv_qs;
+    global_equiv_qs.reserve(n_global);
+    for (unsigned int j = 0; j < n_global; ++j)
+    {
+        global_equiv_qs.emplace_back(equiv_orientations, n_equiv_orientations,
+                                     global_orientations[j] * qconst_conj);
+    }
+
     util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
         {
-            quat<float> q = orientations[i];
+            const quat<float>& q = orientations[i];
             for (unsigned int j = 0; j < n_global; j++)
             {
-                quat<float> global_q = global_orientations[j];
-                float theta
-                    = computeMinSeparationAngle(q, global_q, equiv_orientations, n_equiv_orientations);
-                m_angles(i, j) = theta;
+                const float best
+                    = std::max(overlap(q, global_orientations[j]), global_equiv_qs[j].maxOverlap(q));
+                m_angles(i, j) = overlapToAngle(best);
             }
         }
     });
@@ -1,6 +1,7 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #ifdef __SSE2__
@@ -17,8 +18,32 @@
 
 namespace freud { namespace environment {
 
+namespace {
+
+//! Number of lookup cells per bin used to find the starting bin of a direction.
+constexpr unsigned int LOOKUP_CELLS_PER_BIN = 4;
+
+//! Map the azimuthal angle of (x, y) monotonically onto [0, 4) without trigonometric functions.
+/*! Each quadrant is mapped onto a unit interval by the ratio of one coordinate
+ *  to the L1 norm. As with atan2, the origin is mapped onto 0.
+ */
+template<typename Real> inline Real pseudoAngle(Real x, Real y)
+{
+    if (x == 0 && y == 0)
+    {
+        return 0;
+    }
+    if (y >= 0)
+    {
+        return (x >= 0) ? y / (x + y) : 1 - x / (y - x);
+    }
+    return (x < 0) ? 2 - y / (-x - y) : 3 + x / (x - y);
+}
+
+} // namespace
+
 BondOrder::BondOrder(unsigned int n_bins_theta, unsigned int n_bins_phi, BondOrderMode mode)
-    : BondHistogramCompute(), m_mode(mode)
+    : BondHistogramCompute(), m_mode(mode), m_n_bins_theta(n_bins_theta), m_n_bins_phi(n_bins_phi)
 {
     // sanity checks, but this is actually kinda dumb if these values are 1
     if (n_bins_theta < 2)
@@ -61,6 +86,83 @@ BondOrder::BondOrder(unsigned int n_bins_theta, unsigned int n_bins_phi, BondOrd
     m_histogram = BondHistogram(axes);
 
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+
+    // Bonds are binned from their Cartesian components. The theta edges are
+    // stored as pseudo-angles and the phi edges as cosines, both of which are
+    // monotonic in the angle, and a uniform lookup table over each gives a
+    // bin at or below the true bin so that a short forward scan finds it.
+    m_theta_edges.resize(n_bins_theta + 1);
+    for (unsigned int i = 0; i < n_bins_theta; ++i)
+    {
+        const double theta = static_cast<double>(static_cast<float>(i) * dt);
+        m_theta_edges[i] = static_cast<float>(pseudoAngle(std::cos(theta), std::sin(theta)));
+    }
+    m_theta_edges[n_bins_theta] = 4;
+    m_theta_lookup.resize(LOOKUP_CELLS_PER_BIN * n_bins_theta);
+    m_theta_lookup_scale = static_cast<float>(m_theta_lookup.size()) / 4;
+    unsigned int theta_bin = 0;
+    for (unsigned int k = 0; k < m_theta_lookup.size(); ++k)
+    {
+        const float pseudo_angle = static_cast<float>(k) / m_theta_lookup_scale;
+        while (theta_bin + 1 < n_bins_theta && pseudo_angle >= m_theta_edges[theta_bin + 1])
+        {
+            ++theta_bin;
+        }
+        // Start one bin low to absorb the rounding of the cell index.
+        m_theta_lookup[k] = (theta_bin == 0) ? 0 : theta_bin - 1;
+    }
+
+    m_phi_edges.resize(n_bins_phi + 1);
+    for (unsigned int j = 0; j < n_bins_phi; ++j)
+    {
+        m_phi_edges[j] = static_cast<float>(std::cos(static_cast<double>(static_cast<float>(j) * dp)));
+    }
+    m_phi_edges[n_bins_phi] = -1;
+    m_phi_lookup.resize(LOOKUP_CELLS_PER_BIN * n_bins_phi);
+    m_phi_lookup_scale = static_cast<float>(m_phi_lookup.size()) / 2;
+    unsigned int phi_bin = 0;
+    for (unsigned int k = 0; k < m_phi_lookup.size(); ++k)
+    {
+        const float cos_phi = 1 - static_cast<float>(k) / m_phi_lookup_scale;
+        while (phi_bin + 1 < n_bins_phi && cos_phi <= m_phi_edges[phi_bin + 1])
+        {
+            ++phi_bin;
+        }
+        m_phi_lookup[k] = (phi_bin == 0) ? 0 : phi_bin - 1;
+    }
+}
+
+size_t BondOrder::getBin(const vec3<float>& v) const
+{
+    const float r = std::sqrt(dot(v, v));
+    // Zero and non-finite vectors have no direction.
+    if (!(r > 0) || !std::isfinite(r))
+    {
+        return util::Axis::OVERFLOW_BIN;
+    }
+
+    // NOTE that angles are defined in the "mathematical" way, rather than how
+    // most physics textbooks do it: theta is the azimuthal angle and phi the
+    // polar angle.
+    const float pseudo_angle = pseudoAngle(v.x, v.y);
+    const auto theta_cell = std::min(static_cast<size_t>(pseudo_angle * m_theta_lookup_scale),
+                                     m_theta_lookup.size() - 1);
+    unsigned int theta_bin = m_theta_lookup[theta_cell];
+    while (theta_bin + 1 < m_n_bins_theta && pseudo_angle >= m_theta_edges[theta_bin + 1])
+    {
+        ++theta_bin;
+    }
+
+    const float cos_phi = v.z / r;
+    const auto phi_cell = std::min(static_cast<size_t>(std::max(1 - cos_phi, 0.0F) * m_phi_lookup_scale),
+                                   m_phi_lookup.size() - 1);
+    unsigned int phi_bin = m_phi_lookup[phi_cell];
+    while (phi_bin + 1 < m_n_bins_phi && cos_phi <= m_phi_edges[phi_bin + 1])
+    {
+        ++phi_bin;
+    }
+
+    return static_cast<size_t>(theta_bin) * m_n_bins_phi + phi_bin;
 }
 
 void BondOrder::reduce()
@@ -78,53 +180,75 @@ const util::ManagedArray<float>& BondOrder::getBondOrder()
     return reduceAndReturn(m_bo_array);
 }
 
+void BondOrder::binBond(BondHistogram& histogram, const locality::NeighborBond& neighbor_bond,
+                        const quat<float>* orientations, const quat<float>* query_orientations) const
+{
+    const quat<float>& ref_q(orientations[neighbor_bond.getPointIdx()]);
+    vec3<float> v(neighbor_bond.getVector());
+    const quat<float>& q(query_orientations[neighbor_bond.getQueryPointIdx()]);
+    if (m_mode == obcd)
+    {
+        // give bond directions of neighboring particles rotated by the matrix
+        // that takes the orientation of particle neighbor_bond.id to the
+        // orientation of particle neighbor_bond.ref_id.
+        v = rotate(conj(ref_q), v);
+        v = rotate(q, v);
+    }
+    else if (m_mode == lbod)
+    {
+        // give bond directions of neighboring particles rotated into the
+        // local orientation of the central particle.
+        v = rotate(conj(ref_q), v);
+    }
+    else if (m_mode == oocd)
+    {
+        // give the directors of neighboring particles rotated into the local
+        // orientation of the central particle. pick a (random vector)
+        vec3<float> z(0, 0, 1);
+        // rotate that vector by the orientation of the neighboring particle
+        z = rotate(q, z);
+        // get the direction of this vector with respect to the orientation of
+        // the central particle
+        v = rotate(conj(ref_q), z);
+    }
+
+    histogram.increment(getBin(v));
+}
+
 void BondOrder::accumulate(const locality::NeighborQuery* neighbor_query, quat<float>* orientations,
                            vec3<float>* query_points, quat<float>* query_orientations,
                            unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                            freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          const quat<float>& ref_q(orientations[neighbor_bond.getPointIdx()]);
-                          vec3<float> v(neighbor_bond.getVector());
-                          const quat<float>& q(query_orientations[neighbor_bond.getQueryPointIdx()]);
-                          if (m_mode == obcd)
-                          {
-                              // give bond directions of neighboring particles rotated by the matrix
-                              // that takes the orientation of particle neighbor_bond.id to the orientation of
-                              // particle neighbor_bond.ref_id.
-                              v = rotate(conj(ref_q), v);
-                              v = rotate(q, v);
-                          }
-                          else if (m_mode == lbod)
-                          {
-                              // give bond directions of neighboring particles rotated into the
-                              // local orientation of the central particle.
-                              v = rotate(conj(ref_q), v);
-                          }
-                          else if (m_mode == oocd)
-                          {
-                              // give the directors of neighboring particles rotated into the local
-                              // orientation of the central particle. pick a (random vector)
-                              vec3<float> z(0, 0, 1);
-                              // rotate that vector by the orientation of the neighboring particle
-                              z = rotate(q, z);
-                              // get the direction of this vector with respect to the orientation of
-                              // the central particle
-                              v = rotate(conj(ref_q), z);
-                          }
-
-                          // NOTE that angles are defined in the "mathematical" way, rather than how
-                          // most physics textbooks do it. get theta (azimuthal angle), phi (polar
-                          // angle)
-                          float theta = std::atan2(v.y, v.x); //-Pi..Pi
-                          theta = util::modulusPositive(theta, constants::TWO_PI);
-
-                          // NOTE that the below has replaced the commented out expression for phi.
-                          float phi = std::acos(v.z / std::sqrt(dot(v, v))); // 0..Pi
-
-                          m_local_histograms(theta, phi);
-                      });
+    qargs = mirrorableQueryArgs(neighbor_query, query_points, n_query_points, qargs,
+                                orientations == query_orientations);
+    accumulateHistogram(neighbor_query, query_points, n_query_points, nlist, qargs,
+                        [&](BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+                            binBond(histogram, neighbor_bond, orientations, query_orientations);
+                        });
+}
+
+void BondOrder::accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                                 const std::vector<const quat<float>*>& orientations,
+                                 const std::vector<const vec3<float>*>& query_points,
+                                 const std::vector<const quat<float>*>& query_orientations,
+                                 const std::vector<unsigned int>& n_query_points,
+                                 freud::locality::QueryArgs qargs)
+{
+    if (orientations.size() != neighbor_queries.size()
+        || query_orientations.size() != neighbor_queries.size())
+    {
+        throw std::invalid_argument("BondOrder requires orientations for every frame.");
+    }
+    if (orientations != query_orientations)
+    {
+        qargs.half_list = false;
+    }
+    accumulateHistogramFrames(
+        neighbor_queries, query_points, n_query_points, qargs,
+        [&](size_t frame, BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+            binBond(histogram, neighbor_bond, orientations[frame], query_orientations[frame]);
+        });
 }
 
 }; }; // end namespace freud::environment
@@ -4,6 +4,8 @@
 #ifndef BOND_ORDER_H
 #define BOND_ORDER_H
 
+#include <vector>
+
 #include "BondHistogramCompute.h"
 #include "Box.h"
 #include "Histogram.h"
@@ -44,6 +46,16 @@ public:
                     vec3<float>* query_points, quat<float>* query_orientations, unsigned int n_query_points,
                     const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    //! Accumulate the bond order of several frames in a single parallel pass.
+    /*! Each frame is queried with qargs against its own NeighborQuery, and
+     *  the result is the same as accumulating the frames one at a time.
+     */
+    void accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                          const std::vector<const quat<float>*>& orientations,
+                          const std::vector<const vec3<float>*>& query_points,
+                          const std::vector<const quat<float>*>& query_orientations,
+                          const std::vector<unsigned int>& n_query_points, freud::locality::QueryArgs qargs);
+
     void reduce() override;
 
     //! Get a reference to the last computed bond order
@@ -55,9 +67,25 @@ public:
     }
 
 private:
+    //! Rotate a bond according to the mode and add it to the histogram.
+    void binBond(BondHistogram& histogram, const locality::NeighborBond& neighbor_bond,
+                 const quat<float>* orientations, const quat<float>* query_orientations) const;
+
+    //! Find the (theta, phi) bin of a direction without inverse trigonometric functions.
+    size_t getBin(const vec3<float>& v) const;
+
     util::ManagedArray<float> m_bo_array; //!< bond order array computed
     util::ManagedArray<float> m_sa_array; //!< surface area array computed
     BondOrderMode m_mode;                 //!< The mode to calculate with.
+
+    unsigned int m_n_bins_theta;              //!< Number of bins in theta.
+    unsigned int m_n_bins_phi;                //!< Number of bins in phi.
+    std::vector<float> m_theta_edges;         //!< Pseudo-angles of the theta bin edges.
+    std::vector<unsigned int> m_theta_lookup; //!< Lowest theta bin of each pseudo-angle cell.
+    float m_theta_lookup_scale;               //!< Number of theta lookup cells per unit pseudo-angle.
+    std::vector<float> m_phi_edges;           //!< Cosines of the phi bin edges.
+    std::vector<unsigned int> m_phi_lookup;   //!< Lowest phi bin of each 1 - cos(phi) cell.
+    float m_phi_lookup_scale;                 //!< Number of phi lookup cells per unit of 1 - cos(phi).
 };
 
 }; }; // end namespace freud::environment
@@ -1,6 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <vector>
+#if defined(__SSE__)
+#include <immintrin.h>
+#endif
+
 #include "LocalBondProjection.h"
 #include "NeighborComputeFunctional.h"
 
@@ -46,6 +52,95 @@ float computeMaxProjection(const vec3<float>& proj_vec, const vec3<float>& local
     return max_proj;
 }
 
+namespace {
+
+//! All symmetrically equivalent projection vectors, stored by component for evaluating them together.
+/*! The vectors are rotated once per compute instead of once per bond. Entry
+ *  (e, k) holds the projection vector k rotated by the e-th equivalent
+ *  rotation, where e = 0 is the unrotated vector as in computeMaxProjection.
+ *  The projection vectors are the fastest index and are padded to a multiple
+ *  of four, so the maximal projections onto four vectors are found together.
+ */
+class ProjectionSet
+{
+public:
+    ProjectionSet(const vec3<float>* proj_vecs, unsigned int n_proj, const quat<float>* equiv_qs,
+                  unsigned int n_equiv_qs)
+        : m_n_proj(n_proj), m_n_padded((n_proj + 3) / 4 * 4), m_n_rotations(n_equiv_qs + 1)
+    {
+        m_x.resize(m_n_rotations * m_n_padded);
+        m_y.resize(m_n_rotations * m_n_padded);
+        m_z.resize(m_n_rotations * m_n_padded);
+        for (unsigned int e = 0; e < m_n_rotations; ++e)
+        {
+            for (unsigned int k = 0; k < m_n_padded; ++k)
+            {
+                vec3<float> proj_vec = (k < n_proj) ? proj_vecs[k] : vec3<float>();
+                if (e != 0)
+                {
+                    // here we undo a rotation represented by one of the equivalent orientations
+                    const quat<float> qtest = conj(equiv_qs[0]) * equiv_qs[e - 1];
+                    proj_vec = rotate(qtest, proj_vec);
+                }
+                m_x[e * m_n_padded + k] = proj_vec.x;
+                m_y[e * m_n_padded + k] = proj_vec.y;
+                m_z[e * m_n_padded + k] = proj_vec.z;
+            }
+        }
+    }
+
+    //! Write the maximal projection of a bond onto each equivalent set of projection vectors.
+    void computeMaxProjections(const vec3<float>& local_bond, float* max_projs) const
+    {
+        for (unsigned int k0 = 0; k0 < m_n_padded; k0 += 4)
+        {
+            float block[4];
+#if defined(__SSE__)
+            const __m128 bond_x = _mm_set1_ps(local_bond.x);
+            const __m128 bond_y = _mm_set1_ps(local_bond.y);
+            const __m128 bond_z = _mm_set1_ps(local_bond.z);
+            __m128 best = _mm_setzero_ps();
+            for (unsigned int e = 0; e < m_n_rotations; ++e)
+            {
+                const size_t idx = e * m_n_padded + k0;
+                const __m128 proj = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_x[idx]), bond_x),
+                               _mm_mul_ps(_mm_loadu_ps(&m_y[idx]), bond_y)),
+                    _mm_mul_ps(_mm_loadu_ps(&m_z[idx]), bond_z));
+                // _mm_max_ps(a, b) is a > b ? a : b, so ties and NaNs keep the earlier projection.
+                best = (e == 0) ? proj : _mm_max_ps(proj, best);
+            }
+            _mm_storeu_ps(block, best);
+#else
+            for (unsigned int lane = 0; lane < 4; ++lane)
+            {
+                for (unsigned int e = 0; e < m_n_rotations; ++e)
+                {
+                    const size_t idx = e * m_n_padded + k0 + lane;
+                    const float proj = m_x[idx] * local_bond.x + m_y[idx] * local_bond.y
+                        + m_z[idx] * local_bond.z;
+                    if (e == 0 || proj > block[lane])
+                    {
+                        block[lane] = proj;
+                    }
+                }
+            }
+#endif
+            std::copy(block, block + std::min(4U, m_n_proj - k0), max_projs + k0);
+        }
+    }
+
+private:
+    unsigned int m_n_proj;      //!< Number of projection vectors.
+    unsigned int m_n_padded;    //!< Number of projection vectors padded to a multiple of four.
+    unsigned int m_n_rotations; //!< Number of equivalent rotations, including the identity.
+    std::vector<float> m_x;     //!< x components of the rotated projection vectors.
+    std::vector<float> m_y;     //!< y components of the rotated projection vectors.
+    std::vector<float> m_z;     //!< z components of the rotated projection vectors.
+};
+
+} // namespace
+
 void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<float>* orientations,
                                   const vec3<float>* query_points, unsigned int n_query_points,
                                   const vec3<float>* proj_vecs, unsigned int n_proj,
@@ -58,33 +153,39 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
     // Get the maximum total number of bonds in the neighbor list
     const unsigned int tot_num_neigh = m_nlist.getNumBonds();
 
-    m_local_bond_proj.prepare({tot_num_neigh, n_proj});
+    m_local_bond_proj.prepare({m_compute_projections ? tot_num_neigh : 0, n_proj});
     m_local_bond_proj_norm.prepare({tot_num_neigh, n_proj});
 
+    const ProjectionSet projection_set(proj_vecs, n_proj, equiv_orientations, n_equiv_orientations);
+
     // compute the order parameter
+    m_nlist.updateSegmentCounts();
     util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
-        size_t bond(m_nlist.find_first_index(begin));
+        std::vector<float> max_projs(n_proj);
         for (size_t i = begin; i < end; ++i)
         {
-            for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+            const locality::NeighborListSegment segment(m_nlist.getSegment(i));
+            for (unsigned int n = 0; n < segment.size(); ++n)
             {
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
+                const size_t bond(segment.begin() + n);
+                const size_t j(segment.getPointIdx(n));
 
                 // compute bond vector between the two particles
-                vec3<float> local_bond(m_nlist.getVectors()[bond]);
+                vec3<float> local_bond(segment.getVector(n));
 
                 // rotate bond vector into the local frame of particle p
                 local_bond = rotate(conj(orientations[j]), local_bond);
                 // store the length of this local bond
-                float local_bond_len = m_nlist.getDistances()[bond];
+                float local_bond_len = segment.getDistance(n);
 
+                projection_set.computeMaxProjections(local_bond, max_projs.data());
                 for (unsigned int k = 0; k < n_proj; k++)
                 {
-                    vec3<float> proj_vec = proj_vecs[k];
-                    float max_proj = computeMaxProjection(proj_vec, local_bond, equiv_orientations,
-                                                          n_equiv_orientations);
-                    m_local_bond_proj(bond, k) = max_proj;
-                    m_local_bond_proj_norm(bond, k) = max_proj / local_bond_len;
+                    if (m_compute_projections)
+                    {
+                        m_local_bond_proj(bond, k) = max_projs[k];
+                    }
+                    m_local_bond_proj_norm(bond, k) = max_projs[k] / local_bond_len;
                 }
             }
         }
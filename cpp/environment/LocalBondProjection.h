@@ -26,7 +26,11 @@ class LocalBondProjection
 {
 public:
     //! Constructor
-    LocalBondProjection() = default;
+    /*! \param compute_projections Whether to store the unnormalized
+     *         projections in addition to the normalized ones.
+     */
+    explicit LocalBondProjection(bool compute_projections = true) : m_compute_projections(compute_projections)
+    {}
 
     //! Destructor
     ~LocalBondProjection() = default;
@@ -38,6 +42,12 @@ public:
                  unsigned int n_equiv_orientations, const freud::locality::NeighborList* nlist,
                  locality::QueryArgs qargs);
 
+    //! Return whether the unnormalized projections are stored.
+    bool getComputeProjections() const
+    {
+        return m_compute_projections;
+    }
+
     //! Get a reference to the last computed maximal local bond projection array
     const util::ManagedArray<float>& getProjections() const
     {
@@ -58,6 +68,7 @@ public:
 
 private:
     locality::NeighborList m_nlist; //!< The NeighborList used in the last call to compute.
+    bool m_compute_projections;     //!< Whether to store the unnormalized projections.
 
     util::ManagedArray<float> m_local_bond_proj;      //!< Local bond projection array computed
     util::ManagedArray<float> m_local_bond_proj_norm; //!< Normalized local bond projection array computed
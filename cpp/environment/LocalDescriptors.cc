@@ -1,6 +1,8 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <array>
+#include <stdexcept>
 #include <vector>
 
 #include "LocalDescriptors.h"
@@ -26,19 +28,27 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
     // This function requires a NeighborList object, so we always make one and store it locally.
     m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs);
 
+    // Particle orientations are read by query point index.
+    if ((m_orientation == ParticleLocal) && (m_nlist.getNumQueryPoints() > nq->getNPoints()))
+    {
+        throw std::invalid_argument(
+            "LocalDescriptors with particle orientations requires at most as many query points as points.");
+    }
+
     if (max_num_neighbors == 0)
     {
         max_num_neighbors = std::numeric_limits<unsigned int>::max();
     }
     m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
 
-    util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
+    m_nlist.updateSegmentCounts();
+    util::forLoopWrapper(0, m_nlist.getNumQueryPoints(), [&](size_t begin, size_t end) {
         fsph::PointSPHEvaluator<float> sph_eval(m_l_max);
 
         for (size_t i = begin; i < end; ++i)
         {
-            size_t bond(m_nlist.find_first_index(i));
-            unsigned int neighbor_count(0);
+            const locality::NeighborListSegment segment(m_nlist.getSegment(i));
+            const unsigned int num_neighbors(std::min(segment.size(), max_num_neighbors));
 
             vec3<float> rotation_0;
             vec3<float> rotation_1;
@@ -46,39 +56,39 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
 
             if (m_orientation == LocalNeighborhood)
             {
-                util::ManagedArray<float> inertiaTensor = util::ManagedArray<float>({3, 3});
+                // The inertia tensor is a row-major 3x3 matrix on the stack,
+                // since allocating it would cost more than the math.
+                std::array<float, 9> inertiaTensor {};
 
-                for (size_t bond_copy(bond); bond_copy < m_nlist.getNumBonds()
-                     && m_nlist.getNeighbors()(bond_copy, 0) == i && neighbor_count < max_num_neighbors;
-                     ++bond_copy, ++neighbor_count)
+                for (unsigned int n = 0; n < num_neighbors; ++n)
                 {
-                    const vec3<float> r_ij(m_nlist.getVectors()[bond_copy]);
+                    const vec3<float> r_ij(segment.getVector(n));
                     const float r_sq(dot(r_ij, r_ij));
 
                     for (size_t ii(0); ii < 3; ++ii)
                     {
-                        inertiaTensor(ii, ii) += r_sq;
+                        inertiaTensor[3 * ii + ii] += r_sq;
                     }
 
-                    inertiaTensor(0, 0) -= r_ij.x * r_ij.x;
-                    inertiaTensor(0, 1) -= r_ij.x * r_ij.y;
-                    inertiaTensor(0, 2) -= r_ij.x * r_ij.z;
-                    inertiaTensor(1, 0) -= r_ij.x * r_ij.y;
-                    inertiaTensor(1, 1) -= r_ij.y * r_ij.y;
-                    inertiaTensor(1, 2) -= r_ij.y * r_ij.z;
-                    inertiaTensor(2, 0) -= r_ij.x * r_ij.z;
-                    inertiaTensor(2, 1) -= r_ij.y * r_ij.z;
-                    inertiaTensor(2, 2) -= r_ij.z * r_ij.z;
+                    inertiaTensor[0] -= r_ij.x * r_ij.x;
+                    inertiaTensor[1] -= r_ij.x * r_ij.y;
+                    inertiaTensor[2] -= r_ij.x * r_ij.z;
+                    inertiaTensor[3] -= r_ij.x * r_ij.y;
+                    inertiaTensor[4] -= r_ij.y * r_ij.y;
+                    inertiaTensor[5] -= r_ij.y * r_ij.z;
+                    inertiaTensor[6] -= r_ij.x * r_ij.z;
+                    inertiaTensor[7] -= r_ij.y * r_ij.z;
+                    inertiaTensor[8] -= r_ij.z * r_ij.z;
                 }
 
-                util::ManagedArray<float> eigenvalues = util::ManagedArray<float>(3);
-                util::ManagedArray<float> eigenvectors = util::ManagedArray<float>({3, 3});
+                std::array<float, 3> eigenvalues {};
+                std::array<float, 9> eigenvectors {};
 
                 freud::util::diagonalize33SymmetricMatrix(inertiaTensor, eigenvalues, eigenvectors);
 
-                rotation_0 = vec3<float>(eigenvectors(0, 0), eigenvectors(0, 1), eigenvectors(0, 2));
-                rotation_1 = vec3<float>(eigenvectors(1, 0), eigenvectors(1, 1), eigenvectors(1, 2));
-                rotation_2 = vec3<float>(eigenvectors(2, 0), eigenvectors(2, 1), eigenvectors(2, 2));
+                rotation_0 = vec3<float>(eigenvectors[0], eigenvectors[1], eigenvectors[2]);
+                rotation_1 = vec3<float>(eigenvectors[3], eigenvectors[4], eigenvectors[5]);
+                rotation_2 = vec3<float>(eigenvectors[6], eigenvectors[7], eigenvectors[8]);
             }
             else if (m_orientation == ParticleLocal)
             {
@@ -98,14 +108,11 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
                 throw std::runtime_error("Uncaught orientation mode in LocalDescriptors::compute");
             }
 
-            neighbor_count = 0;
-            for (; bond < m_nlist.getNumBonds() && m_nlist.getNeighbors()(bond, 0) == i
-                 && neighbor_count < max_num_neighbors;
-                 ++bond, ++neighbor_count)
+            for (unsigned int n = 0; n < num_neighbors; ++n)
             {
-                const unsigned int sphCount(bond * getSphWidth());
-                const vec3<float> r_ij(m_nlist.getVectors()[bond]);
-                const float magR(m_nlist.getDistances()[bond]);
+                const unsigned int sphCount((segment.begin() + n) * getSphWidth());
+                const vec3<float> r_ij(segment.getVector(n));
+                const float magR(segment.getDistance(n));
                 const vec3<float> bond_ij(dot(rotation_0, r_ij), dot(rotation_1, r_ij),
                                           dot(rotation_2, r_ij));
 
@@ -2,12 +2,17 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
 
 #include "MatchEnv.h"
 
 #include "NeighborComputeFunctional.h"
+#include "dset/dset.h"
+#include "utils.h"
 
 namespace freud { namespace environment {
 
@@ -266,41 +271,77 @@ std::vector<vec3<float>> EnvDisjointSet::getIndividualEnv(const unsigned int m)
 /*************************
  * Convenience functions *
  *************************/
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
-                                                                       float threshold_sq, bool registration)
+namespace {
+
+//! Tolerance on the norms relative to their magnitude, which covers the rounding of the rotations.
+constexpr float NORM_TOLERANCE = 1e-4F;
+
+//! Return whether the vectors of two environments of equal size could be paired within the threshold.
+/*! Rotations preserve the norms of the vectors, so a pairing of the vectors
+ * within the threshold pairs their norms within the threshold as well. If any
+ * pairing of the norms does, pairing them in sorted order does too, so this is
+ * a necessary condition for a match that does not require registration.
+ */
+bool normsCanMatch(const Environment& e1, const Environment& e2, float threshold_sq)
 {
-    BiMap<unsigned int, unsigned int> vec_map;
-    rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
-
-    // If the vector sets do not have equal numbers of vectors, just return
-    // an empty map since the 1-1 bimapping will be too weird in this case.
-    if (e1.vecs.size() != e2.vecs.size())
+    const float threshold = std::sqrt(threshold_sq);
+    for (unsigned int m = 0; m < e1.sorted_norms.size(); m++)
     {
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        const float norm1 = e1.sorted_norms[m];
+        const float norm2 = e2.sorted_norms[m];
+        if (std::abs(norm1 - norm2) > threshold + NORM_TOLERANCE * std::max(norm1, norm2))
+        {
+            return false;
+        }
     }
+    return true;
+}
 
-    std::vector<vec3<float>> v1(e1.vecs.size());
-    std::vector<vec3<float>> v2(e2.vecs.size());
+//! Return whether two environments could match, which requires as many vectors and matching norms.
+bool canMatch(const Environment& e1, const Environment& e2, float threshold_sq)
+{
+    // If the vector sets do not have equal numbers of vectors, the 1-1
+    // bimapping would be too weird. Most dissimilar environments are ruled
+    // out by the norms of their vectors, which skips the expensive
+    // registration.
+    return e1.vecs.size() == e2.vecs.size() && normsCanMatch(e1, e2, threshold_sq);
+}
 
-    // get the vectors into the proper orientation and order with respect to
-    // their parent environment
-    for (unsigned int m = 0; m < e1.vecs.size(); m++)
+//! Get the vectors of an environment in the proper orientation and order with respect to its parent.
+std::vector<vec3<float>> getProperVectors(const Environment& e)
+{
+    std::vector<vec3<float>> v(e.vecs.size());
+    for (unsigned int m = 0; m < e.vecs.size(); m++)
     {
-        v1[m] = e1.proper_rot * e1.vecs[e1.vec_ind[m]];
-        v2[m] = e2.proper_rot * e2.vecs[e2.vec_ind[m]];
+        v[m] = e.proper_rot * e.vecs[e.vec_ind[m]];
     }
+    return v;
+}
+
+//! Pair the vectors of e2 with the vectors v1 of a first environment, as in isSimilar.
+/*! \param registration If not null, the registration with reference points
+ *                      v1 used to orient the vectors of e2 first. Its
+ *                      reference data does not depend on e2, so it can be
+ *                      reused for many environments.
+ */
+std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>
+pairVectors(const std::vector<vec3<float>>& v1, const Environment& e2, float threshold_sq,
+            RegisterBruteForce* registration)
+{
+    BiMap<unsigned int, unsigned int> vec_map;
+    rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
+    std::vector<vec3<float>> v2 = getProperVectors(e2);
 
     // If we have to register, first find the rotated set of v2 that best maps
     // to v1. The Fit operation CHANGES v2.
-    if (registration)
+    if (registration != nullptr)
     {
-        RegisterBruteForce r = RegisterBruteForce(v1);
-        r.Fit(v2);
+        registration->Fit(v2);
         // get the optimal rotation to take v2 to v1
-        std::vector<vec3<float>> rot = r.getRotation();
+        std::vector<vec3<float>> rot = registration->getRotation();
         // rot must be a 3x3 matrix. if it isn't, something has gone wrong.
         rotation = rotmat3<float>(rot[0], rot[1], rot[2]);
-        BiMap<unsigned int, unsigned int> tmp_vec_map = r.getVecMap();
+        BiMap<unsigned int, unsigned int> tmp_vec_map = registration->getVecMap();
 
         for (const auto* registered_pair : tmp_vec_map)
         {
@@ -320,9 +361,9 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
     // if we didn't have to register, compare all combinations of vectors
     else
     {
-        for (unsigned int i = 0; i < e1.vecs.size(); i++)
+        for (unsigned int i = 0; i < v1.size(); i++)
         {
-            for (unsigned int j = 0; j < e2.vecs.size(); j++)
+            for (unsigned int j = 0; j < v2.size(); j++)
             {
                 vec3<float> delta = v1[i] - v2[j];
                 float r_sq = dot(delta, delta);
@@ -339,7 +380,7 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
     }
 
     // if every vector has been paired with every other vector, return this bimap
-    if (vec_map.size() == e1.vecs.size())
+    if (vec_map.size() == v1.size())
     {
         return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
     }
@@ -348,6 +389,26 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
     return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, empty_map);
 }
 
+} // namespace
+
+std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
+                                                                       float threshold_sq, bool registration)
+{
+    if (!canMatch(e1, e2, threshold_sq))
+    {
+        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(
+            rotmat3<float>(), BiMap<unsigned int, unsigned int>());
+    }
+
+    std::vector<vec3<float>> v1 = getProperVectors(e1);
+    if (registration)
+    {
+        RegisterBruteForce r = RegisterBruteForce(v1);
+        return pairVectors(v1, e2, threshold_sq, &r);
+    }
+    return pairVectors(v1, e2, threshold_sq, nullptr);
+}
+
 std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<float>* refPoints1,
                                                vec3<float>* refPoints2, unsigned int numRef,
                                                float threshold_sq, bool registration)
@@ -400,8 +461,8 @@ std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const
     return std::pair<Environment, Environment>(e0, e1);
 }
 
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
-                                                                          float& min_rmsd, bool registration)
+std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>
+minimizeRMSD(Environment& e1, Environment& e2, float& min_rmsd, bool registration, bool exact_assignment)
 {
     BiMap<unsigned int, unsigned int> vec_map;
     rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
@@ -428,6 +489,7 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Enviro
 
     // call RegisterBruteForce::Fit and update min_rmsd accordingly
     RegisterBruteForce r = RegisterBruteForce(v1);
+    r.setExactAssignment(exact_assignment);
     // If we have to register, first find the rotated set of v2 that best
     // maps to v1. The Fit operation CHANGES v2.
     if (registration)
@@ -488,20 +550,21 @@ MatchEnv::~MatchEnv() = default;
 
 EnvironmentCluster::~EnvironmentCluster() = default;
 
-Environment MatchEnv::buildEnv(const freud::locality::NeighborList* nlist, size_t num_bonds, size_t& bond,
-                               unsigned int i, unsigned int env_ind)
+Environment MatchEnv::buildEnv(const freud::locality::NeighborList* nlist, unsigned int i,
+                               unsigned int env_ind)
 {
     Environment ei = Environment();
     // set the environment index equal to the particle index
     ei.env_ind = env_ind;
 
-    for (; bond < num_bonds && nlist->getNeighbors()(bond, 0) == i; ++bond)
+    const locality::NeighborListSegment segment(nlist->getSegment(i));
+    for (unsigned int k = 0; k < segment.size(); ++k)
     {
         // compute vec{r} between the two particles
-        const size_t j(nlist->getNeighbors()(bond, 1));
+        const size_t j(segment.getPointIdx(k));
         if (i != j)
         {
-            vec3<float> delta(nlist->getVectors()[bond]);
+            vec3<float> delta(segment.getVector(k));
             ei.addVec(delta);
         }
     }
@@ -526,109 +589,186 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
 
     nlist.validate(Np, Np);
     env_nlist.validate(Np, Np);
-    size_t env_bond(0);
-    const size_t env_num_bonds(env_nlist.getNumBonds());
-
-    // create a disjoint set where all particles belong in their own cluster
-    EnvDisjointSet dj(Np);
-
-    // add all the environments to the set
-    // take care, here: set things up s.t. the env_ind of every environment
-    // matches its location in the disjoint set.
-    // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        Environment ei = buildEnv(&env_nlist, env_num_bonds, env_bond, i, i);
-        dj.s.push_back(ei);
-    }
-
-    size_t bond(0);
-    // loop through points
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        // loop over the neighbors
-        for (; bond < nlist.getNumBonds() && nlist.getNeighbors()(bond, 0) == i; ++bond)
+    nlist.updateSegmentCounts();
+    env_nlist.updateSegmentCounts();
+
+    // build the environment of every particle. The env_ind of every
+    // environment matches its particle index.
+    std::vector<Environment> envs(Np);
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
         {
-            const size_t j(nlist.getNeighbors()(bond, 1));
+            envs[i] = buildEnv(&env_nlist, i, i);
+        }
+    });
+
+    // Compare the environments of the two points of every bond. The
+    // comparisons use the environments as built, so they are independent of
+    // each other, and the lock-free disjoint sets merge the points of the
+    // matching bonds concurrently. The environments of every cluster are
+    // aligned to each other afterwards.
+    const unsigned int* neighbors = nlist.getNeighbors().get();
+    std::vector<BondMatch> matches(nlist.getNumBonds());
+    DisjointSets dj(Np);
+    util::forLoopWrapper(0, nlist.getNumBonds(), [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            const unsigned int i = neighbors[2 * bond];
+            const unsigned int j = neighbors[2 * bond + 1];
             std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-                = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
-            rotmat3<float> rotation = mapping.first;
-            BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+                = isSimilar(envs[i], envs[j], m_threshold_sq, registration);
             // if the mapping between the vectors of the environments
             // is NOT empty, then the environments are similar, so
             // merge them.
-            if (!vec_map.empty())
+            if (!mapping.second.empty())
             {
-                // merge the two sets using the disjoint set
-                unsigned int a = dj.find(i);
-                unsigned int b = dj.find(j);
-                if (a != b)
+                matches[bond].rotation = mapping.first;
+                matches[bond].vec_map.resize(mapping.second.size());
+                for (const auto* matched_pair : mapping.second)
                 {
-                    dj.merge(i, j, vec_map, rotation);
+                    matches[bond].vec_map[matched_pair->first] = matched_pair->second;
                 }
+                dj.unite(i, j);
             }
         }
+    });
+
+    // All clusters are now determined. Number them from zero to
+    // num_clusters-1 in the order of their lowest point index.
+    std::vector<unsigned int> root_labels(Np, Np);
+    std::vector<std::vector<unsigned int>> cluster_points;
+    for (unsigned int i = 0; i < Np; i++)
+    {
+        const unsigned int root = dj.find(i);
+        if (root_labels[root] == Np)
+        {
+            root_labels[root] = cluster_points.size();
+            cluster_points.emplace_back();
+        }
+        m_env_index[i] = root_labels[root];
+        cluster_points[root_labels[root]].push_back(i);
     }
+    m_num_clusters = cluster_points.size();
 
-    // done looping over points. All clusters are now determined. Renumber
-    // them from zero to num_clusters-1.
-    m_num_clusters = populateEnv(dj);
+    populateEnv(envs, nlist, matches, cluster_points);
 }
 
-unsigned int EnvironmentCluster::populateEnv(EnvDisjointSet dj)
+void EnvironmentCluster::populateEnv(std::vector<Environment>& envs,
+                                     const freud::locality::NeighborList& nlist,
+                                     const std::vector<BondMatch>& matches,
+                                     const std::vector<std::vector<unsigned int>>& cluster_points)
 {
-    std::map<unsigned int, unsigned int> label_map;
-    std::map<unsigned int, std::vector<vec3<float>>> cluster_env;
-
-    // loop over all environments
-    unsigned int label_ind;
-    unsigned int cur_set = 0;
-    unsigned int particle_ind = 0;
-    for (unsigned int i = 0; i < dj.s.size(); i++)
+    const unsigned int Np = envs.size();
+    const unsigned int* neighbors = nlist.getNeighbors().get();
+
+    // Collect the matching bonds of every point in both directions.
+    std::vector<size_t> match_offsets(Np + 1, 0);
+    for (size_t bond = 0; bond < matches.size(); ++bond)
     {
-        // only count this if the environment is physical
-        if (!dj.s[i].ghost)
+        if (!matches[bond].vec_map.empty() && neighbors[2 * bond] != neighbors[2 * bond + 1])
+        {
+            ++match_offsets[neighbors[2 * bond] + 1];
+            ++match_offsets[neighbors[2 * bond + 1] + 1];
+        }
+    }
+    std::partial_sum(match_offsets.begin(), match_offsets.end(), match_offsets.begin());
+    std::vector<size_t> point_matches(match_offsets[Np]);
+    std::vector<size_t> match_cursors(match_offsets.begin(), match_offsets.end() - 1);
+    for (size_t bond = 0; bond < matches.size(); ++bond)
+    {
+        if (!matches[bond].vec_map.empty() && neighbors[2 * bond] != neighbors[2 * bond + 1])
+        {
+            point_matches[match_cursors[neighbors[2 * bond]]++] = bond;
+            point_matches[match_cursors[neighbors[2 * bond + 1]]++] = bond;
+        }
+    }
+
+    // Walk the matching bonds out from the lowest point index of every
+    // cluster, aligning the environment at the far end of every bond to the
+    // already aligned one. Then average the aligned environments of the
+    // cluster in the order of the point indices.
+    m_cluster_environments.assign(cluster_points.size(), std::vector<vec3<float>>());
+    util::forLoopWrapper(0, cluster_points.size(), [&](size_t begin, size_t end) {
+        std::vector<unsigned int> queue;
+        std::vector<unsigned int> inverse_map;
+        for (size_t cluster = begin; cluster < end; ++cluster)
         {
-            // grab the set of vectors that define this individual environment
-            std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(i);
+            const std::vector<unsigned int>& points = cluster_points[cluster];
+            queue.assign(1, points[0]);
+            for (size_t head = 0; head < queue.size(); ++head)
+            {
+                const unsigned int p = queue[head];
+                for (size_t m = match_offsets[p]; m < match_offsets[p + 1]; ++m)
+                {
+                    const size_t bond = point_matches[m];
+                    const unsigned int i = neighbors[2 * bond];
+                    const unsigned int j = neighbors[2 * bond + 1];
+                    const unsigned int q = (p == i) ? j : i;
+                    // every point but the first is reached from an aligned one
+                    if (q == points[0] || envs[q].env_ind != q)
+                    {
+                        continue;
+                    }
+                    envs[q].env_ind = points[0];
+                    queue.push_back(q);
+
+                    // The rotation and vector map take the environment of j
+                    // to that of i, so they are inverted when reaching i.
+                    const BondMatch& match = matches[bond];
+                    const std::vector<unsigned int>& old_vec_ind = envs[p].vec_ind;
+                    if (p == i)
+                    {
+                        envs[q].proper_rot = envs[p].proper_rot * match.rotation;
+                        for (unsigned int proper_ind = 0; proper_ind < old_vec_ind.size(); proper_ind++)
+                        {
+                            envs[q].vec_ind[proper_ind] = match.vec_map[old_vec_ind[proper_ind]];
+                        }
+                    }
+                    else
+                    {
+                        envs[q].proper_rot = envs[p].proper_rot * transpose(match.rotation);
+                        inverse_map.resize(match.vec_map.size());
+                        for (unsigned int a = 0; a < match.vec_map.size(); a++)
+                        {
+                            inverse_map[match.vec_map[a]] = a;
+                        }
+                        for (unsigned int proper_ind = 0; proper_ind < old_vec_ind.size(); proper_ind++)
+                        {
+                            envs[q].vec_ind[proper_ind] = inverse_map[old_vec_ind[proper_ind]];
+                        }
+                    }
+                }
+            }
 
-            unsigned int c = dj.find(i);
-            // insert the set into the mapping if we haven't seen it before.
-            // also grab the vectors that define the set and insert them into cluster_env
-            if (label_map.count(c) == 0)
+            std::vector<vec3<float>>& cluster_env = m_cluster_environments[cluster];
+            cluster_env.assign(envs[points[0]].vecs.size(), vec3<float>());
+            for (const unsigned int p : points)
             {
-                label_map[c] = cur_set;
-                std::vector<vec3<float>> vecs = dj.getAvgEnv(c);
-                label_ind = label_map[c];
-                cluster_env[label_ind] = vecs;
-                cur_set++;
+                for (unsigned int proper_ind = 0; proper_ind < cluster_env.size(); proper_ind++)
+                {
+                    cluster_env[proper_ind]
+                        += envs[p].proper_rot * envs[p].vecs[envs[p].vec_ind[proper_ind]];
+                }
             }
-            else
+            for (auto& vec : cluster_env)
             {
-                label_ind = label_map[c];
+                vec /= static_cast<float>(points.size());
             }
+        }
+    });
 
-            // label this particle in m_env_index
-            m_env_index[particle_ind] = label_ind;
-
-            m_point_environments.emplace_back();
-            for (const auto& part_vec : part_vecs)
+    // grab the set of vectors that define every individual environment
+    m_point_environments.assign(Np, std::vector<vec3<float>>());
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (unsigned int proper_ind = 0; proper_ind < envs[i].vecs.size(); proper_ind++)
             {
-                m_point_environments[particle_ind].push_back(part_vec);
+                m_point_environments[i].push_back(envs[i].proper_rot
+                                                  * envs[i].vecs[envs[i].vec_ind[proper_ind]]);
             }
-            particle_ind++;
         }
-    }
-
-    // Now update the vector of environments from the map.
-    m_cluster_environments.resize(cluster_env.size());
-    for (const auto& it : cluster_env)
-    {
-        m_cluster_environments[it.first] = it.second;
-    }
-
-    // specify the number of cluster environments
-    return cur_set;
+    });
 }
 
 /*************************
@@ -638,6 +778,15 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
                                     const freud::locality::NeighborList* nlist_arg, locality::QueryArgs qargs,
                                     const vec3<float>* motif, unsigned int motif_size, float threshold,
                                     bool registration)
+{
+    computeMotifs(nq, nlist_arg, qargs, motif, &motif_size, 1, threshold, registration);
+}
+
+void EnvironmentMotifMatch::computeMotifs(const freud::locality::NeighborQuery* nq,
+                                          const freud::locality::NeighborList* nlist_arg,
+                                          locality::QueryArgs qargs, const vec3<float>* motifs,
+                                          const unsigned int* motif_sizes, unsigned int num_motifs,
+                                          float threshold, bool registration)
 {
     const locality::NeighborList nlist
         = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
@@ -646,66 +795,77 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
     float m_threshold_sq = threshold * threshold;
 
     nlist.validate(Np, Np);
-
-    // create a disjoint set where all particles belong in their own cluster.
-    // this has to have ONE MORE environment than there are actual particles,
-    // because we're inserting the motif into it.
-    EnvDisjointSet dj(Np + 1);
-
-    // create the environment characterized by motif. Index it as 0.
-    // set the IGNORE flag to true, since this is not an environment we have
-    // actually encountered in the simulation.
-    Environment e0 = Environment(true);
-
-    // loop through all the vectors in motif and add them to the environment.
-    // wrap all the vectors back into the box. I think this is necessary since
-    // all the vectors that will be added to actual particle environments will
-    // be wrapped into the box as well.
-    for (unsigned int i = 0; i < motif_size; i++)
+    nlist.updateSegmentCounts();
+
+    // create the environment characterized by each motif. set the IGNORE
+    // flag to true, since these are not environments we have actually
+    // encountered in the simulation. wrap all the vectors back into the box,
+    // since all the vectors of actual particle environments are wrapped into
+    // the box as well.
+    std::vector<Environment> motif_envs(num_motifs, Environment(true));
+    std::vector<std::vector<vec3<float>>> motif_vecs(num_motifs);
+    const vec3<float>* motif = motifs;
+    for (unsigned int m = 0; m < num_motifs; m++)
     {
-        vec3<float> p = nq->getBox().wrap(motif[i]);
-        e0.addVec(p);
+        for (unsigned int k = 0; k < motif_sizes[m]; k++)
+        {
+            motif_envs[m].addVec(nq->getBox().wrap(motif[k]));
+        }
+        motif_vecs[m] = getProperVectors(motif_envs[m]);
+        motif += motif_sizes[m];
     }
 
-    // add this environment to the set
-    dj.s.push_back(e0);
-
-    size_t bond(0);
-    const size_t num_bonds(nlist.getNumBonds());
-
-    m_matches.prepare(Np);
-
-    // loop through the particles and add their environments to the set
-    // take care, here: set things up s.t. the env_ind of every environment
-    // matches its location in the disjoint set.
-    // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        unsigned int dummy = i + 1;
-        Environment ei = buildEnv(&nlist, num_bonds, bond, i, dummy);
-        dj.s.push_back(ei);
-
-        // if the environment matches e0, merge it into the e0 environment set
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = isSimilar(dj.s[0], dj.s[dummy], m_threshold_sq, registration);
-        rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-        // if the mapping between the vectors of the environments is NOT empty,
-        // then the environments are similar.
-        if (!vec_map.empty())
+    // The reference data of the registration only depends on the motif, so
+    // every thread registers against its own copy for all of its particles.
+    tbb::enumerable_thread_specific<std::vector<RegisterBruteForce>> local_registrations([&]() {
+        std::vector<RegisterBruteForce> registrations;
+        registrations.reserve(num_motifs);
+        for (auto& vecs : motif_vecs)
         {
-            dj.merge(0, dummy, vec_map, rotation);
-            m_matches[i] = true;
+            registrations.emplace_back(vecs);
         }
-        // grab the set of vectors that define this individual environment
-        std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
+        return registrations;
+    });
 
-        m_point_environments.emplace_back();
-        for (const auto& part_vec : part_vecs)
+    m_matches.prepare(Np);
+    m_motif_indices.prepare(Np);
+    m_point_environments.assign(Np, std::vector<vec3<float>>());
+
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        std::vector<RegisterBruteForce>* registrations
+            = registration ? &local_registrations.local() : nullptr;
+        for (size_t i = begin; i < end; ++i)
         {
-            m_point_environments[i].push_back(part_vec);
+            const Environment ei = buildEnv(&nlist, i, i + 1);
+            std::vector<vec3<float>>& point_env = m_point_environments[i];
+            point_env = ei.vecs;
+            for (unsigned int m = 0; m < num_motifs; m++)
+            {
+                if (!canMatch(motif_envs[m], ei, m_threshold_sq))
+                {
+                    continue;
+                }
+                RegisterBruteForce* motif_registration
+                    = registrations != nullptr ? &(*registrations)[m] : nullptr;
+                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+                    = pairVectors(motif_vecs[m], ei, m_threshold_sq, motif_registration);
+                BiMap<unsigned int, unsigned int>& vec_map = mapping.second;
+                // if the mapping between the vectors of the environments is
+                // NOT empty, then the environments are similar. the vectors
+                // are then put in the order and orientation of the motif.
+                if (!vec_map.empty())
+                {
+                    for (unsigned int proper_ind = 0; proper_ind < vec_map.size(); proper_ind++)
+                    {
+                        point_env[proper_ind] = mapping.first * ei.vecs[vec_map.left[proper_ind]];
+                    }
+                    m_matches[i] = true;
+                    m_motif_indices[i] = m;
+                    break;
+                }
+            }
         }
-    }
+    });
 }
 
 /****************************
@@ -714,7 +874,7 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
 void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
                                        const freud::locality::NeighborList* nlist_arg,
                                        locality::QueryArgs qargs, const vec3<float>* motif,
-                                       unsigned int motif_size, bool registration)
+                                       unsigned int motif_size, bool registration, bool exact_assignment)
 {
     const locality::NeighborList nlist
         = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
@@ -744,8 +904,7 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
     // add this environment to the set
     dj.s.push_back(e0);
 
-    size_t bond(0);
-    const size_t num_bonds(nlist.getNumBonds());
+    nlist.updateSegmentCounts();
 
     m_rmsds.prepare(Np);
 
@@ -756,13 +915,13 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
     for (unsigned int i = 0; i < Np; i++)
     {
         unsigned int dummy = i + 1;
-        Environment ei = buildEnv(&nlist, num_bonds, bond, i, dummy);
+        Environment ei = buildEnv(&nlist, i, dummy);
         dj.s.push_back(ei);
 
         // if the environment matches e0, merge it into the e0 environment set
         float min_rmsd = -1.0;
         std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = minimizeRMSD(dj.s[0], dj.s[dummy], min_rmsd, registration);
+            = minimizeRMSD(dj.s[0], dj.s[dummy], min_rmsd, registration, exact_assignment);
         rotmat3<float> rotation = mapping.first;
         BiMap<unsigned int, unsigned int> vec_map = mapping.second;
         // populate the min_rmsd vector
@@ -4,6 +4,8 @@
 #ifndef MATCH_ENV_H
 #define MATCH_ENV_H
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <vector>
 
@@ -35,6 +37,8 @@ struct Environment
         vecs.push_back(vec);
         vec_ind.push_back(num_vecs);
         num_vecs++;
+        const float norm = std::sqrt(dot(vec, vec));
+        sorted_norms.insert(std::upper_bound(sorted_norms.begin(), sorted_norms.end(), norm), norm);
     }
 
     unsigned int env_ind {0};      //!< The index of the environment
@@ -47,6 +51,9 @@ struct Environment
     std::vector<unsigned int> vec_ind;
     //! The rotation that defines the proper orientation of the environment
     rotmat3<float> proper_rot {};
+    //! The sorted norms of the vectors, which do not depend on the orientation
+    //! or order of the vectors and are used to rule out matches cheaply
+    std::vector<float> sorted_norms;
 };
 
 //! General disjoint set class, taken mostly from Cluster.h
@@ -119,9 +126,13 @@ std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const
  * \param registration Controls whether we first use brute force registration to
  *                     orient the second set of vectors such that it
  *                     minimizes the RMSD between the two sets
+ * \param exact_assignment Controls whether the vectors are paired by solving
+ *                         the assignment problem exactly rather than greedily,
+ *                         which gives the minimal RMSD for every rotation tried.
  */
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
-                                                                          float& min_rmsd, bool registration);
+std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>
+minimizeRMSD(Environment& e1, Environment& e2, float& min_rmsd, bool registration,
+             bool exact_assignment = false);
 
 //! Overload of the above minimizeRMSD function that provides an easier interface to Python.
 /*! Construct the environments accordingly, and utilize minimizeRMSD() as
@@ -161,6 +172,11 @@ std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec
  * \param registration Controls whether we first use brute force registration to
  *                     orient the second set of vectors such that it
  *                     minimizes the RMSD between the two sets
+ *
+ * Matching vectors have norms within the threshold of each other, so
+ * environments whose sorted norms differ by at least the threshold are
+ * rejected without registration. The rotation returned for them is the
+ * identity.
  */
 std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
                                                                        float threshold_sq, bool registration);
@@ -204,8 +220,10 @@ public:
 
     //! Construct and return a local environment surrounding the particle indexed by i. Set the environment
     //! index to env_ind.
-    static Environment buildEnv(const freud::locality::NeighborList* nlist, size_t num_bonds, size_t& bond,
-                                unsigned int i, unsigned int env_ind);
+    /*! The segment offsets of nlist must be up to date, see NeighborList::updateSegmentCounts.
+     */
+    static Environment buildEnv(const freud::locality::NeighborList* nlist, unsigned int i,
+                                unsigned int env_ind);
 
     //! Returns the entire Np by m_num_neighbors by 3 matrix of all environments for all particles
     const std::vector<std::vector<vec3<float>>>& getPointEnvironments()
@@ -246,7 +264,9 @@ public:
     /*! This is the primary interface to EnvironmentCluster. It computes particle
      * environments and then attempts to cluster nearby particles with similar
      * environments. It performs a pairwise comparison of all particle environments
-     * to perform the match.
+     * to perform the match. The comparisons of the bonds are independent, so
+     * they run in parallel and merge the matching points with lock-free
+     * disjoint sets.
      *
      * \param nq The NeighborQuery used to hold system data and query for neighbors.
      * \param nlist_arg The NeighborList used to determine the neighbors against which to
@@ -285,23 +305,30 @@ public:
     }
 
 private:
-    //! Populate the env_index, env and tot_env arrays (updated by reference) based on the contents of an
-    //! EnvDisjointSet.
-    /*! T
-     * \param dj The object encoding the set of clusters found.
-     * \param env_index An array indexed by point id indicating the cluster id for each point.
-     * \param cluster_env A mapping from cluster id to a list of vectors composing
-     *                    that cluster's environment. A null pointer may be passed
-     *                    indicating that we do not need to keep track of cluster
-     *                    environments.
-     * \param tot_env An array indexed by point id indicating the environment of each point.
-     * \param reLabel If true, the cluster ids are relabeled to ensur contiguous
-     *                ordering from 0 to the number of clusters. Otherwise, the
-     *                cluster ids will match the point id of the first point found
-     *                with that environment (which defines the cluster).
-     * \return The number of clusters found.
+    //! Result of comparing the environments of the two points of a bond.
+    struct BondMatch
+    {
+        //! Rotation taking the environment of the point to that of the query point.
+        rotmat3<float> rotation;
+        //! Index of the vector of the point matching each vector of the query
+        //! point. Empty if the environments do not match.
+        std::vector<unsigned int> vec_map;
+    };
+
+    //! Align the environments of every cluster and populate the point and cluster environments.
+    /*! Every cluster is aligned to the environment of its lowest point index
+     * by walking the matching bonds out from that point, so the result is
+     * independent of the order in which the bonds were merged. The clusters
+     * are independent and are processed in parallel.
+     *
+     * \param envs The environment of every point, aligned in place.
+     * \param nlist The NeighborList whose bonds were compared.
+     * \param matches The result of comparing the environments of every bond.
+     * \param cluster_points The points of every cluster, sorted by point index.
      */
-    unsigned int populateEnv(EnvDisjointSet dj);
+    void populateEnv(std::vector<Environment>& envs, const freud::locality::NeighborList& nlist,
+                     const std::vector<BondMatch>& matches,
+                     const std::vector<std::vector<unsigned int>>& cluster_points);
 
     unsigned int m_num_clusters {0};              //!< Last number of local environments computed
     util::ManagedArray<unsigned int> m_env_index; //!< Cluster index determined for each particle
@@ -354,15 +381,47 @@ public:
                  locality::QueryArgs qargs, const vec3<float>* motif, unsigned int motif_size,
                  float threshold, bool registration = false);
 
+    //! Determine which of several motifs the environment of each particle matches.
+    /*! The environment of every particle is built once and tested against
+     *  the motifs in order, stopping at the first match, so the order of the
+     *  motifs sets their precedence. The particles are matched in parallel,
+     *  and with registration every thread reuses its registration of each
+     *  motif for all of its particles. The point_environments array holds
+     *  the environment of every particle in the order and orientation of its
+     *  matched motif.
+     *
+     * \param nq The NeighborQuery used to hold system data and query for neighbors.
+     * \param nlist_arg The NeighborList defining particle environments.
+     * \param qargs Query arguments used to define nlist_args.
+     * \param motifs The vectors of all motifs, one motif after the other.
+     * \param motif_sizes The number of vectors of each motif.
+     * \param num_motifs The number of motifs.
+     * \param threshold The maximum magnitude of the vector difference between
+     *                  two matching vectors, as in compute.
+     * \param registration Controls whether we first use brute force registration to
+     *                     orient the environments with respect to each motif.
+     */
+    void computeMotifs(const freud::locality::NeighborQuery* nq,
+                       const freud::locality::NeighborList* nlist_arg, locality::QueryArgs qargs,
+                       const vec3<float>* motifs, const unsigned int* motif_sizes, unsigned int num_motifs,
+                       float threshold, bool registration = false);
+
     //! Return the array indicating whether each particle matched the motif or not.
     const util::ManagedArray<bool>& getMatches()
     {
         return m_matches;
     }
 
+    //! Return the index of the motif that each particle matched, which is 0 for particles without a match.
+    const util::ManagedArray<unsigned int>& getMotifIndices()
+    {
+        return m_motif_indices;
+    }
+
 private:
     util::ManagedArray<bool>
         m_matches; //!< Boolean array indicating whether or not a particle's environment matches the motif.
+    util::ManagedArray<unsigned int> m_motif_indices; //!< Index of the motif matched by each particle.
 };
 
 //! Compute RMSDs of the local particle environments.
@@ -411,10 +470,13 @@ public:
      * \param registration Controls whether we first use brute force registration to
      *                     orient the second set of vectors such that it
      *                     minimizes the RMSD between the two sets
+     * \param exact_assignment Controls whether the vectors are paired by
+     *                         solving the assignment problem exactly rather
+     *                         than greedily.
      */
     void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist_arg,
                  locality::QueryArgs qargs, const vec3<float>* motif, unsigned int motif_size,
-                 bool registration = false);
+                 bool registration = false, bool exact_assignment = false);
 
     //! Return the array indicating whether or not a successful mapping was found between each particle and
     //! the provided motif.
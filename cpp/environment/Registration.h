@@ -4,8 +4,11 @@
 #ifndef REGISTRATION_H
 #define REGISTRATION_H
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <sstream>
 #include <vector>
@@ -108,10 +111,34 @@ inline matrix Rotate(const matrix& R, const matrix& P)
 // some helpful references:
 // http://cnx.org/contents/HV-RsdwL@23/Molecular-Distance-Measures
 // http://btk.sourceforge.net/html_docs/0.8.1/rmsd_theory.html
+//! Find the rotation that minimizes the MSD between two 3D point sets from their covariance.
+/*! The covariance is P^T Q for the Nx3 point sets P and Q. The fixed-size
+ *  SVD does not allocate, which matters in the inner loop of
+ *  RegisterBruteForce::Fit.
+ */
+inline Eigen::Matrix3d KabschRotation(const Eigen::Matrix3d& covariance)
+{
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(covariance, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const Eigen::Matrix3d U = svd.matrixU();
+    Eigen::Matrix3d V = svd.matrixV();
+
+    // if the rotation is IMPROPER, reflect the smallest principal axis
+    if ((V * U.transpose()).determinant() < 0)
+    {
+        V.col(2) *= -1.0;
+    }
+    return V * U.transpose();
+}
+
 inline void KabschAlgorithm(const matrix& P, const matrix& Q, matrix& Rotation)
 {
     // Preconditions: P and Q have been translated to have the same center of mass.
     matrix A = P.transpose() * Q;
+    if (A.rows() == 3 && A.cols() == 3)
+    {
+        Rotation = KabschRotation(A);
+        return;
+    }
     // singular value decomposition (~ eigen decomposition)
     Eigen::JacobiSVD<matrix> svd(A, Eigen::ComputeFullU | Eigen::ComputeFullV);
     // A = USV^T
@@ -155,19 +182,21 @@ inline void AlignVectorSets(matrix& P, matrix& Q, matrix* pRotation = nullptr)
 class RegisterBruteForce
 {
 public:
-    explicit RegisterBruteForce(std::vector<vec3<float>>& vecs) : m_ref_points(makeEigenMatrix(vecs)) {};
+    explicit RegisterBruteForce(std::vector<vec3<float>>& vecs)
+        : m_ref_points(makeEigenMatrix(vecs)), m_ref_vecs(vecs), m_ref_rows(vecs.size())
+    {
+        for (unsigned int i = 0; i < vecs.size(); i++)
+        {
+            m_ref_rows[i] = m_ref_points.row(i).transpose();
+        }
+    };
 
     ~RegisterBruteForce() = default;
 
     void Fit(std::vector<vec3<float>>& pts)
     {
-        matrix points;
-        matrix p;
-        matrix q;
-        matrix r;
         // make the Eigen matrix from pts
-        points = makeEigenMatrix(pts);
-        int num_pts;
+        const matrix points = makeEigenMatrix(pts);
 
         int N = points.rows();
         if (N != m_ref_points.rows())
@@ -178,8 +207,15 @@ public:
                 << std::endl;
             throw std::invalid_argument(msg.str());
         }
+        std::vector<Eigen::Vector3d> point_rows(N);
+        for (int i = 0; i < N; i++)
+        {
+            point_rows[i] = points.row(i).transpose();
+        }
 
-        RandomNumber<std::mt19937_64> rng;
+        // Seeding from std::random_device is expensive, so every thread keeps
+        // its generator across fits.
+        thread_local RandomNumber<std::mt19937_64> rng;
         double rmsd_min = -1.0;
         for (size_t shuffles = 0; shuffles < m_shuffles; shuffles++)
         {
@@ -197,7 +233,6 @@ public:
                 {
                     p1 = rng.random_int(0, N - 1);
                 }
-
                 if (N == 2 || N == 1)
                 {
                     p2 = -1;
@@ -211,69 +246,30 @@ public:
             // We should switch this to using something other than C-style
             // arrays, but we need to be careful to preserve the right behavior
             // (particularly wrt NextCombination).
-            size_t comb[3] = {0, 1, 2}; // NOLINT(modernize-avoid-c-arrays)
-            if (N == 2)
-            {
-                num_pts = 2;
-                p.resize(num_pts, m_ref_points.cols());
-                p.row(0) = m_ref_points.row(p0);
-                p.row(1) = m_ref_points.row(p1);
-                q.resize(num_pts, m_ref_points.cols());
-            }
-            else if (N == int(1))
-            {
-                num_pts = 1;
-                p.resize(num_pts, m_ref_points.cols());
-                p.row(0) = m_ref_points.row(p0);
-                q.resize(num_pts, m_ref_points.cols());
-            }
-            else
-            {
-                num_pts = 3;
-                p.resize(num_pts, m_ref_points.cols());
-                p.row(0) = m_ref_points.row(p0);
-                p.row(1) = m_ref_points.row(p1);
-                p.row(2) = m_ref_points.row(p2);
-                q.resize(num_pts, m_ref_points.cols());
-            }
+            size_t comb[3] = {0, 1, 2};              // NOLINT(modernize-avoid-c-arrays)
+            const int ref_indices[3] = {p0, p1, p2}; // NOLINT(modernize-avoid-c-arrays)
+            const int num_pts = std::min(N, 3);
             do
             {
                 do
                 {
-                    if (N == int(2))
-                    {
-                        q.row(0) = points.row(comb[0]);
-                        q.row(1) = points.row(comb[1]);
-                    }
-                    else if (N == int(1))
-                    {
-                        q.row(0) = points.row(comb[0]);
-                    }
-                    else
-                    {
-                        q.row(0) = points.row(comb[0]);
-                        q.row(1) = points.row(comb[1]);
-                        q.row(2) = points.row(comb[2]);
-                    }
-
                     // finds the optimal rotation of the FIRST input set
                     // of points such that they match the SECOND input
-                    // set of points
-                    KabschAlgorithm(q, p, r);
-
-                    // The rotation that we've found from the
-                    // KabschAlgorithm actually acts on P^T.
-                    matrix rot_points = Rotate(r, points.transpose());
+                    // set of points. The covariance of the two sets is
+                    // always 3x3, so nothing is allocated here.
+                    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+                    for (int k = 0; k < num_pts; k++)
+                    {
+                        covariance += point_rows[comb[k]] * m_ref_rows[ref_indices[k]].transpose();
+                    }
+                    const Eigen::Matrix3d r = KabschRotation(covariance);
 
-                    // feed back in the TRANSPOSE of rot_points such that
-                    // the input matrix is (Nx3).
-                    BiMap<unsigned int, unsigned int> vec_map;
-                    float rmsd = AlignedRMSDTree(rot_points.transpose(), vec_map);
+                    float rmsd = pairPoints(r, point_rows, rmsd_min);
                     if (rmsd < rmsd_min || rmsd_min < 0.0)
                     {
                         m_rmsd = rmsd;
                         m_rotation = r;
-                        m_vec_map = vec_map;
+                        m_vec_map = makeVecMap();
                         rmsd_min = m_rmsd;
                         if (rmsd_min < m_tol)
                         {
@@ -329,76 +325,208 @@ public:
         m_tol = tol;
     }
 
+    //! Set whether points are paired by solving the assignment problem exactly.
+    /*! By default, every point is greedily paired with its nearest unused
+     *  reference point, which may not give the minimal RMSD for a rotation.
+     *  The exact assignment is found with the Hungarian algorithm in
+     *  O(N^3) rather than O(N^2) operations per candidate rotation.
+     */
+    void setExactAssignment(bool exact_assignment)
+    {
+        m_exact_assignment = exact_assignment;
+    }
+
     // This uses an R-tree to efficiently determine pairs of points that
     // are closest, next closest, etc to each other. NOTE that this does
     // not guarantee an absolutely minimal RMSD. It doesn't figure out the
     // optimal permutation of BOTH sets of vectors to minimize the RMSD.
     // Rather, it just figures out the optimal permutation of the second
     // set, the vector set used in the argument below.
-    // To fully solve this, we need to use the Hungarian algorithm or some
-    // other way of solving the so-called assignment problem.
+    // To fully solve this, the Hungarian algorithm is used instead if exact
+    // assignment is enabled with setExactAssignment.
     float AlignedRMSDTree(const matrix& points, BiMap<unsigned int, unsigned int>& m)
     {
-        // Also brute force.
-        float rmsd = 0.0;
-
-        // a mapping between the vectors of m_ref_points and the vectors of points
-        BiMap<unsigned int, unsigned int> vec_map;
+        std::vector<Eigen::Vector3d> point_rows(points.rows());
+        for (int i = 0; i < points.rows(); i++)
+        {
+            point_rows[i] = points.row(i).transpose();
+        }
+        float rmsd = pairPoints(Eigen::Matrix3d::Identity(), point_rows, -1.0);
+        m = makeVecMap();
+        return rmsd;
+    }
 
-        // keeps track of whether m_ref_points have been matched to any point in points
-        // guarantees 1-1 mapping
-        std::set<unsigned int> unused_indices;
-        for (int i = 0; i < m_ref_points.rows(); i++)
+private:
+    //! Pair every rotated point with a reference point, greedily or exactly.
+    float pairPoints(const Eigen::Matrix3d& rotation, const std::vector<Eigen::Vector3d>& points,
+                     double max_rmsd)
+    {
+        if (m_exact_assignment)
         {
-            unused_indices.insert(i);
+            return pairOptimal(rotation, points);
         }
+        return pairNearest(rotation, points, max_rmsd);
+    }
 
-        // loop through all the points
-        for (int r = 0; r < points.rows(); r++)
+    //! Greedily pair every rotated point, in order, with its nearest unused reference point.
+    /*! The reference point paired with point r is stored in m_pairs[r], and
+     *  the RMSD of the pairs is returned. Since the RMSD only grows as points
+     *  are paired, the pairing stops as soon as the RMSD reaches max_rmsd,
+     *  unless max_rmsd is negative, and the partial RMSD is returned.
+     */
+    float pairNearest(const Eigen::Matrix3d& rotation, const std::vector<Eigen::Vector3d>& points,
+                      double max_rmsd)
+    {
+        // A value of 1 marks the reference points that have been paired,
+        // which guarantees a 1-1 mapping.
+        m_ref_used.assign(m_ref_vecs.size(), 0);
+        m_pairs.resize(points.size());
+        float rmsd = 0.0;
+        for (unsigned int r = 0; r < points.size(); r++)
         {
             // get the rotated point
-            vec3<float> pfit = make_point(points.row(r));
-            // compute squared distances to all unused reference points
-            std::vector<std::pair<unsigned int, float>> ref_distances;
-            for (auto ref_index : unused_indices)
+            const Eigen::Vector3d rotated = rotation * points[r];
+            const vec3<float> pfit(rotated[0], rotated[1], rotated[2]);
+            // find the nearest unused reference point
+            unsigned int nearest = 0;
+            float nearest_r_sq = -1.0;
+            for (unsigned int ref_index = 0; ref_index < m_ref_vecs.size(); ref_index++)
             {
-                vec3<float> ref_point = make_point(m_ref_points.row(ref_index));
-                vec3<float> delta = ref_point - pfit;
-                float r_sq = dot(delta, delta);
-                ref_distances.emplace_back(ref_index, r_sq);
+                if (m_ref_used[ref_index] != 0)
+                {
+                    continue;
+                }
+                const vec3<float> delta = m_ref_vecs[ref_index] - pfit;
+                const float r_sq = dot(delta, delta);
+                if (nearest_r_sq < 0 || r_sq < nearest_r_sq)
+                {
+                    nearest = ref_index;
+                    nearest_r_sq = r_sq;
+                }
             }
-            // sort the ref_distances from nearest to farthest
-            sort(ref_distances.begin(), ref_distances.end(), compare_ref_distances);
-            // take the first (nearest) ref_point found and mark it as used
-            unused_indices.erase(ref_distances[0].first);
-            // add this pairing to the mapping between vectors
-            vec_map.emplace(ref_distances[0].first, r);
+            m_ref_used[nearest] = 1;
+            m_pairs[r] = nearest;
             // add this squared distance to the rmsd
-            rmsd += ref_distances[0].second;
+            rmsd += nearest_r_sq;
+            if (max_rmsd >= 0 && std::sqrt(rmsd / static_cast<float>(points.size())) >= max_rmsd)
+            {
+                return std::sqrt(rmsd / static_cast<float>(points.size()));
+            }
         }
-
-        m = vec_map;
-        return std::sqrt(rmsd / static_cast<float>(points.rows()));
+        return std::sqrt(rmsd / static_cast<float>(points.size()));
     }
 
-private:
-    static vec3<float> make_point(const Eigen::VectorXd& row)
+    //! Pair the rotated points with the reference points to minimize the RMSD.
+    /*! This solves the assignment problem on the squared distances with the
+     *  Hungarian algorithm, using shortest augmenting paths and potentials u
+     *  on the points and v on the reference points. The reference point
+     *  paired with point r is stored in m_pairs[r], and the RMSD of the pairs
+     *  is returned.
+     */
+    float pairOptimal(const Eigen::Matrix3d& rotation, const std::vector<Eigen::Vector3d>& points)
     {
-        if (row.rows() == 2)
+        const unsigned int N = points.size();
+        const unsigned int num_refs = m_ref_vecs.size();
+        m_costs.resize(static_cast<size_t>(N) * num_refs);
+        for (unsigned int r = 0; r < N; r++)
+        {
+            const Eigen::Vector3d rotated = rotation * points[r];
+            const vec3<float> pfit(rotated[0], rotated[1], rotated[2]);
+            for (unsigned int ref_index = 0; ref_index < num_refs; ref_index++)
+            {
+                const vec3<float> delta = m_ref_vecs[ref_index] - pfit;
+                m_costs[r * num_refs + ref_index] = dot(delta, delta);
+            }
+        }
+
+        // Points and reference points are numbered from 1 here, and index 0
+        // is the root of the augmenting paths. m_ref_owners[j] is the point
+        // currently assigned to reference point j, or 0 if it is free.
+        const double infinity = std::numeric_limits<double>::infinity();
+        m_point_potentials.assign(N + 1, 0.0);
+        m_ref_potentials.assign(num_refs + 1, 0.0);
+        m_ref_owners.assign(num_refs + 1, 0);
+        m_path.assign(num_refs + 1, 0);
+        for (unsigned int r = 1; r <= N; r++)
+        {
+            m_ref_owners[0] = r;
+            unsigned int j0 = 0;
+            m_min_slack.assign(num_refs + 1, infinity);
+            m_ref_used.assign(num_refs + 1, 0);
+            do
+            {
+                m_ref_used[j0] = 1;
+                const unsigned int r0 = m_ref_owners[j0];
+                double delta = infinity;
+                unsigned int j1 = 0;
+                for (unsigned int j = 1; j <= num_refs; j++)
+                {
+                    if (m_ref_used[j] != 0)
+                    {
+                        continue;
+                    }
+                    const double slack = m_costs[(r0 - 1) * num_refs + (j - 1)] - m_point_potentials[r0]
+                        - m_ref_potentials[j];
+                    if (slack < m_min_slack[j])
+                    {
+                        m_min_slack[j] = slack;
+                        m_path[j] = j0;
+                    }
+                    if (m_min_slack[j] < delta)
+                    {
+                        delta = m_min_slack[j];
+                        j1 = j;
+                    }
+                }
+                for (unsigned int j = 0; j <= num_refs; j++)
+                {
+                    if (m_ref_used[j] != 0)
+                    {
+                        m_point_potentials[m_ref_owners[j]] += delta;
+                        m_ref_potentials[j] -= delta;
+                    }
+                    else
+                    {
+                        m_min_slack[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            } while (m_ref_owners[j0] != 0);
+
+            // flip the augmenting path back to the root
+            do
+            {
+                const unsigned int j1 = m_path[j0];
+                m_ref_owners[j0] = m_ref_owners[j1];
+                j0 = j1;
+            } while (j0 != 0);
+        }
+
+        m_pairs.resize(N);
+        for (unsigned int j = 1; j <= num_refs; j++)
         {
-            return vec3<float>(row[0], row[1], 0.0);
+            if (m_ref_owners[j] != 0)
+            {
+                m_pairs[m_ref_owners[j] - 1] = j - 1;
+            }
         }
-        if (row.rows() == 3)
+        float rmsd = 0.0;
+        for (unsigned int r = 0; r < N; r++)
         {
-            return vec3<float>(row[0], row[1], row[2]);
+            rmsd += m_costs[r * num_refs + m_pairs[r]];
         }
-        throw(std::runtime_error("points must 2 or 3 dimensions"));
+        return std::sqrt(rmsd / static_cast<float>(N));
     }
 
-    static bool compare_ref_distances(const std::pair<unsigned int, float>& a,
-                                      const std::pair<unsigned int, float>& b)
+    //! Build the mapping between the vectors from the last complete pairing.
+    BiMap<unsigned int, unsigned int> makeVecMap() const
     {
-        return (a.second < b.second);
+        BiMap<unsigned int, unsigned int> vec_map;
+        for (unsigned int r = 0; r < m_pairs.size(); r++)
+        {
+            vec_map.emplace(m_pairs[r], r);
+        }
+        return vec_map;
     }
 
     static inline bool NextCombination(size_t* comb, int N, int k)
@@ -466,11 +594,22 @@ private:
     };
 
     matrix m_ref_points;
+    std::vector<vec3<float>> m_ref_vecs;     //!< Reference points, for the distances to the points.
+    std::vector<Eigen::Vector3d> m_ref_rows; //!< Reference points, for the covariances.
+    std::vector<unsigned int> m_pairs;       //!< Scratch: reference point paired with each point.
+    std::vector<unsigned char> m_ref_used;   //!< Scratch: marks the paired reference points.
+    std::vector<float> m_costs;              //!< Scratch: squared distances of all pairs.
+    std::vector<double> m_point_potentials;  //!< Scratch: potentials of the points.
+    std::vector<double> m_ref_potentials;    //!< Scratch: potentials of the reference points.
+    std::vector<double> m_min_slack;         //!< Scratch: minimal slack of each reference point.
+    std::vector<unsigned int> m_ref_owners;  //!< Scratch: point assigned to each reference point.
+    std::vector<unsigned int> m_path;        //!< Scratch: previous reference point on the augmenting path.
     matrix m_rotation;
     matrix m_translation;
     float m_rmsd {0.0};
     double m_tol {1e-6};
     size_t m_shuffles {1};
+    bool m_exact_assignment {false}; //!< Whether points are paired by solving the assignment problem.
     BiMap<unsigned int, unsigned int>
         m_vec_map; //! The mapping between indices of the two sets of points ref_points->points (where
                    //! "ref_points" are those that RegisterBruteForce was constructed with and "points" are
@@ -2,17 +2,23 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 
 #include "AABBQuery.h"
 
 namespace freud { namespace locality {
 
+static_assert(NODE_CAPACITY <= BALL_BATCH_SIZE, "A leaf of the tree must fit in a single distance batch.");
+
 AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points)
     : NeighborQuery(box, points, n_points)
 {
     // Allocate memory and create image vectors
     setupTree(m_n_points);
+    setupImages();
 
     // Build the tree
     buildTree(m_points, m_n_points);
@@ -20,14 +26,48 @@ AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned in
 
 AABBQuery::~AABBQuery() = default;
 
+void AABBQuery::updatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+{
+    validatePoints(box, points, n_points);
+    const bool same_size = (n_points == m_n_points) && (m_aabb_tree.getNumNodes() != 0);
+    setPoints(box, points, n_points);
+    setupImages();
+    if (same_size)
+    {
+        refitTree(m_points, m_n_points);
+    }
+    else
+    {
+        setupTree(m_n_points);
+        buildTree(m_points, m_n_points);
+    }
+}
+
+void AABBQuery::setupImages()
+{
+    // Within half of the smallest nearest plane distance, each point has at
+    // most one periodic image, so nearest neighbor searches within that
+    // distance need no deduplication of images.
+    m_n_images = getImageVectors(0, false, m_image_list.data(), MAX_NUM_IMAGES);
+    vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    float min_plane_distance = std::min(plane_distance.x, plane_distance.y);
+    if (!m_box.is2D())
+    {
+        min_plane_distance = std::min(min_plane_distance, plane_distance.z);
+    }
+    m_r_unique_image = min_plane_distance / float(2.0);
+}
+
 std::shared_ptr<NeighborQueryPerPointIterator>
 AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const
 {
     this->validateQueryArgs(args);
     if (args.mode == QueryType::ball)
     {
-        return std::make_shared<AABBQueryBallIterator>(this, query_point, query_point_idx, args.r_max,
-                                                       args.r_min, args.exclude_ii);
+        auto iter = std::make_shared<AABBQueryBallIterator>(this, query_point, query_point_idx, args.r_max,
+                                                            args.r_min, args.exclude_ii);
+        iter->setHalfList(args.half_list);
+        return iter;
     }
     if (args.mode == QueryType::nearest)
     {
@@ -38,6 +78,45 @@ AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_i
     throw std::runtime_error("Invalid query mode provided to query function in AABBQuery.");
 }
 
+float AABBQuery::estimateDensity(const vec3<float>& point) const
+{
+    if (m_aabb_tree.getNumNodes() == 0)
+    {
+        return NeighborQuery::estimateDensity(point);
+    }
+
+    // Descend from the root (node 0) to the leaf containing the point, or
+    // the nearest one if no leaf contains it.
+    const auto distance_sq = [&point](const AABB& aabb) {
+        const vec3<float> lower = aabb.getLower();
+        const vec3<float> upper = aabb.getUpper();
+        const vec3<float> d(std::max({lower.x - point.x, point.x - upper.x, float(0.0)}),
+                            std::max({lower.y - point.y, point.y - upper.y, float(0.0)}),
+                            std::max({lower.z - point.z, point.z - upper.z, float(0.0)}));
+        return dot(d, d);
+    };
+    unsigned int node = 0;
+    while (!m_aabb_tree.isNodeLeaf(node))
+    {
+        const unsigned int left = m_aabb_tree.getNodeLeft(node);
+        const unsigned int right = m_aabb_tree.getNodeRight(node);
+        node = distance_sq(m_aabb_tree.getNodeAABB(left)) <= distance_sq(m_aabb_tree.getNodeAABB(right))
+            ? left
+            : right;
+    }
+
+    // The extents of the leaf are padded by half the mean spacing of the
+    // points, so flat leaves and leaves of nearly coincident points do not
+    // give unbounded densities.
+    const bool is2D = m_box.is2D();
+    const float spacing = is2D ? std::sqrt(m_box.getVolume() / static_cast<float>(m_n_points))
+                               : std::cbrt(m_box.getVolume() / static_cast<float>(m_n_points));
+    const AABB& leaf = m_aabb_tree.getNodeAABB(node);
+    const vec3<float> extent = leaf.getUpper() - leaf.getLower() + vec3<float>(1, 1, 1) * (spacing / 2);
+    const float volume = is2D ? extent.x * extent.y : extent.x * extent.y * extent.z;
+    return static_cast<float>(m_aabb_tree.getNodeNumParticles(node)) / volume;
+}
+
 void AABBQuery::setupTree(unsigned int Np)
 {
     m_aabbs.resize(Np);
@@ -46,51 +125,141 @@ void AABBQuery::setupTree(unsigned int Np)
 void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
 {
     // Construct a point AABB for each point
-    for (unsigned int i = 0; i < Np; ++i)
-    {
-        // Make a point AABB
-        vec3<float> my_pos(points[i]);
-        if (m_box.is2D())
+    const bool is2D = m_box.is2D();
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
         {
-            my_pos.z = 0;
+            // Make a point AABB
+            vec3<float> my_pos(points[i]);
+            if (is2D)
+            {
+                my_pos.z = 0;
+            }
+            m_aabbs[i] = AABB(my_pos, static_cast<unsigned int>(i));
         }
-        m_aabbs[i] = AABB(my_pos, i);
-    }
+    });
 
     // Call the tree build routine, one tree per type
     m_aabb_tree.buildTree(m_aabbs.data(), Np);
-}
 
-void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
-{
-    box::Box box = m_neighbor_query->getBox();
-    vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
-    vec3<bool> periodic = box.getPeriodic();
-    if (_check_r_max)
+    // Store the positions in the order of the leaves. This is the order in
+    // which traversals visit points, and it is also spatially coherent. The
+    // tree build leaves the AABBs sorted in this order.
+    const unsigned int num_nodes = m_aabb_tree.getNumNodes();
+    m_leaf_offsets.assign(num_nodes, 0);
+    unsigned int offset = 0;
+    for (unsigned int node = 0; node < num_nodes; ++node)
     {
-        if ((periodic.x && nearest_plane_distance.x <= r_max * 2.0)
-            || (periodic.y && nearest_plane_distance.y <= r_max * 2.0)
-            || (!box.is2D() && periodic.z && nearest_plane_distance.z <= r_max * 2.0))
+        m_leaf_offsets[node] = offset;
+        if (m_aabb_tree.isNodeLeaf(node))
         {
-            throw std::runtime_error("The AABBQuery r_max is too large for this box.");
+            offset += m_aabb_tree.getNodeNumParticles(node);
         }
     }
 
-    // Now compute the image vectors
-    // Each dimension increases by one power of 3
-    unsigned int n_dim_periodic = static_cast<unsigned int>(periodic.x)
-        + static_cast<unsigned int>(periodic.y)
-        + static_cast<unsigned int>(!box.is2D()) * static_cast<unsigned int>(periodic.z);
-    m_n_images = 1;
-    for (unsigned int dim = 0; dim < n_dim_periodic; ++dim)
+    m_leaf_positions.resize(static_cast<size_t>(3) * Np);
+    m_spatial_order.prepare(Np);
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            const unsigned int tag = m_aabbs[k].tag;
+            m_leaf_positions[k] = points[tag].x;
+            m_leaf_positions[Np + k] = points[tag].y;
+            m_leaf_positions[2 * Np + k] = is2D ? 0 : points[tag].z;
+            m_spatial_order.get()[k] = tag;
+        }
+    });
+    m_build_cost = getRelativeTreeCost();
+    ++m_num_builds;
+}
+
+void AABBQuery::refitTree(const vec3<float>* points, unsigned int Np)
+{
+    // A point crossing a periodic boundary would stretch the AABB of its
+    // leaf across the box. Instead, each point is stored at its periodic
+    // image closest to its previous position. Queries search the periodic
+    // images of query points in neighboring boxes, so they find the same
+    // bonds as long as the stored points are within a quarter of the box
+    // lengths outside the box. Unlike for a build, the AABBs are stored in
+    // the order of the points.
+    const bool is2D = m_box.is2D();
+    const unsigned int* spatial_order = m_spatial_order.get();
+    float* leaf_x = m_leaf_positions.data();
+    float* leaf_y = leaf_x + Np;
+    float* leaf_z = leaf_y + Np;
+    std::atomic<bool> outside_box(false);
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            const unsigned int tag = spatial_order[k];
+            const vec3<float> previous(leaf_x[k], leaf_y[k], leaf_z[k]);
+            vec3<float> my_pos(points[tag]);
+            if (is2D)
+            {
+                my_pos.z = 0;
+            }
+            my_pos = previous + m_box.wrap(my_pos - previous);
+            const vec3<float> fractional = m_box.makeFractional(my_pos);
+            if (std::abs(fractional.x - float(0.5)) > float(0.75)
+                || std::abs(fractional.y - float(0.5)) > float(0.75)
+                || (!is2D && std::abs(fractional.z - float(0.5)) > float(0.75)))
+            {
+                outside_box = true;
+            }
+            m_aabbs[tag] = AABB(my_pos, tag);
+            leaf_x[k] = my_pos.x;
+            leaf_y[k] = my_pos.y;
+            leaf_z[k] = my_pos.z;
+        }
+    });
+    m_aabb_tree.refit(m_aabbs.data());
+
+    // Points that moved far from the points of their leaves enlarge the
+    // nodes, so queries visit more of the tree. Once that outweighs the cost
+    // of a build, the tree is partitioned again.
+    if (outside_box || getRelativeTreeCost() > REBUILD_COST_FACTOR * m_build_cost)
     {
-        m_n_images *= 3;
+        buildTree(points, Np);
     }
+}
 
-    // Reallocate memory if necessary
-    if (m_n_images > m_image_list.size())
+float AABBQuery::getRelativeTreeCost() const
+{
+    const vec3<float> L = m_box.getL();
+    const float box_size = L.x + L.y + (m_box.is2D() ? 0 : L.z);
+    return m_aabb_tree.getCost() / box_size;
+}
+
+unsigned int AABBQuery::getImageVectors(float r_max, bool all_images, vec3<float>* image_list,
+                                        unsigned int max_images) const
+{
+    const box::Box& box = m_box;
+    vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
+    vec3<bool> periodic = box.getPeriodic();
+    periodic.z = periodic.z && !box.is2D();
+
+    // Points in the box differ by less than one box length along each
+    // lattice vector, so images up to floor(r_max / plane distance) + 1 box
+    // lengths away may hold neighbors. Below the plane distance this is the
+    // single shell of nearest images.
+    const auto num_shells = [&](bool is_periodic, float plane_distance) {
+        if (!is_periodic)
+        {
+            return 0.0;
+        }
+        return all_images ? std::floor(double(r_max) / plane_distance) + 1 : 1.0;
+    };
+    const double shells_x = num_shells(periodic.x, nearest_plane_distance.x);
+    const double shells_y = num_shells(periodic.y, nearest_plane_distance.y);
+    const double shells_z = num_shells(periodic.z, nearest_plane_distance.z);
+    const double num_images = (2 * shells_x + 1) * (2 * shells_y + 1) * (2 * shells_z + 1);
+    if (!(num_images <= double(std::numeric_limits<unsigned int>::max())))
     {
-        m_image_list.resize(m_n_images);
+        throw std::runtime_error("The AABBQuery r_max is too large for this box.");
+    }
+    if (num_images > max_images)
+    {
+        return static_cast<unsigned int>(num_images);
     }
 
     auto latt_a = vec3<float>(box.getLatticeVector(0));
@@ -102,31 +271,266 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
     }
 
     // There is always at least 1 image, which we put as our first thing to look at
-    m_image_list[0] = vec3<float>(0.0, 0.0, 0.0);
+    image_list[0] = vec3<float>(0.0, 0.0, 0.0);
 
     // Iterate over all other combinations of images
+    const auto max_i = static_cast<int>(shells_x);
+    const auto max_j = static_cast<int>(shells_y);
+    const auto max_k = static_cast<int>(shells_z);
     unsigned int n_images = 1;
-    for (int i = -1; i <= 1 && n_images < m_n_images; ++i)
+    for (int i = -max_i; i <= max_i; ++i)
     {
-        for (int j = -1; j <= 1 && n_images < m_n_images; ++j)
+        for (int j = -max_j; j <= max_j; ++j)
         {
-            for (int k = -1; k <= 1 && n_images < m_n_images; ++k)
+            for (int k = -max_k; k <= max_k; ++k)
             {
                 if (!(i == 0 && j == 0 && k == 0))
                 {
-                    // Skip any periodic images if we don't have periodicity
-                    if ((i != 0 && !periodic.x) || (j != 0 && !periodic.y)
-                        || (k != 0 && (box.is2D() || !periodic.z)))
-                    {
-                        continue;
-                    }
-
-                    m_image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
+                    image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
                     ++n_images;
                 }
             }
         }
     }
+
+    return n_images;
+}
+
+bool AABBQuery::findNearestNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                                     unsigned int num_neighbors, float r_max, float r_min, float r_guess,
+                                     float scale, bool exclude_ii, NearestNeighborSearch& search) const
+{
+    const bool bounded_by_r_max = r_max <= m_r_unique_image;
+    const float r_bound = bounded_by_r_max ? r_max : m_r_unique_image;
+    const float r_guess_bound = std::min(r_guess * scale, r_bound);
+
+    if (num_neighbors == 0 || m_aabb_tree.getNumNodes() == 0 || getNPoints() == 0)
+    {
+        search.candidates.clear();
+        return true;
+    }
+
+    // Until num_neighbors candidates are found, only nodes within the search
+    // bound need to be visited. A tight first guess prunes far more of the
+    // tree than the largest safe bound, and only rarely finds too few points.
+    findNearestNeighborsWithin(query_point, query_point_idx, num_neighbors, r_guess_bound, r_min, exclude_ii,
+                               search);
+    if (search.candidates.size() < num_neighbors && r_guess_bound < r_bound)
+    {
+        findNearestNeighborsWithin(query_point, query_point_idx, num_neighbors, r_bound, r_min, exclude_ii,
+                                   search);
+    }
+    return bounded_by_r_max || search.candidates.size() == num_neighbors;
+}
+
+void AABBQuery::findNearestNeighborsWithin(const vec3<float>& query_point, unsigned int query_point_idx,
+                                           unsigned int num_neighbors, float r_bound, float r_min,
+                                           bool exclude_ii, NearestNeighborSearch& search) const
+{
+    search.candidates.clear();
+    search.nodes.clear();
+
+    const float r_bound_sq = r_bound * r_bound;
+    const float r_min_sq = r_min * r_min;
+
+    vec3<float> pos_i(query_point);
+    if (m_box.is2D())
+    {
+        pos_i.z = 0;
+    }
+
+    // Nodes farther away than the current worst candidate (or the search
+    // bound, until num_neighbors candidates are found) cannot contain a
+    // better candidate.
+    const auto is_pruned = [&](float node_r_sq) {
+        if (search.candidates.size() < num_neighbors)
+        {
+            return node_r_sq >= r_bound_sq;
+        }
+        return node_r_sq > search.candidates.back().r_sq;
+    };
+
+    // Descend from a node to a leaf, always continuing into the closer child
+    // and deferring the farther one, then offer the points of the leaf as
+    // candidates.
+    BallBatch batch;
+    const auto visit = [&](unsigned int node, unsigned int image) {
+        const vec3<float> pos_i_image = pos_i + m_image_list[image];
+        while (!m_aabb_tree.isNodeLeaf(node))
+        {
+            unsigned int near_child = m_aabb_tree.getNodeLeft(node);
+            unsigned int far_child = m_aabb_tree.getNodeRight(node);
+            float near_r_sq = distanceSquared(m_aabb_tree.getNodeAABB(near_child), pos_i_image);
+            float far_r_sq = distanceSquared(m_aabb_tree.getNodeAABB(far_child), pos_i_image);
+            if (far_r_sq < near_r_sq)
+            {
+                std::swap(near_child, far_child);
+                std::swap(near_r_sq, far_r_sq);
+            }
+            if (!is_pruned(far_r_sq))
+            {
+                search.nodes.push_back({far_r_sq, far_child, image});
+                std::push_heap(search.nodes.begin(), search.nodes.end());
+            }
+            if (is_pruned(near_r_sq))
+            {
+                return;
+            }
+            node = near_child;
+        }
+
+        // Only points at most as far as the current worst candidate can
+        // replace it.
+        const float r_cut_sq = (search.candidates.size() < num_neighbors)
+            ? r_bound_sq
+            : std::nextafter(search.candidates.back().r_sq, std::numeric_limits<float>::infinity());
+        computeBallBatch(getLeafCoordinates(node, 0), getLeafCoordinates(node, 1), getLeafCoordinates(node, 2),
+                         m_aabb_tree.getNodeNumParticles(node), pos_i_image, r_min_sq, r_cut_sq, nullptr,
+                         batch);
+        const unsigned int* leaf_points = getLeafPoints(node);
+        for (unsigned int k = 0; k < batch.size; ++k)
+        {
+            const NearestNeighborCandidate candidate {batch.r_sq[k], leaf_points[batch.index[k]],
+                                                      batch.r_ij[k]};
+            if (exclude_ii && query_point_idx == candidate.point_idx)
+            {
+                continue;
+            }
+
+            // The candidates are kept sorted, with the worst one last. Since
+            // nodes are visited roughly in order of distance, new candidates
+            // are mostly inserted near the end, which is cheaper than sifting
+            // through a binary heap.
+            if (search.candidates.size() < num_neighbors)
+            {
+                search.candidates.push_back(candidate);
+            }
+            else if (candidate < search.candidates.back())
+            {
+                search.candidates.back() = candidate;
+            }
+            else
+            {
+                continue;
+            }
+            auto slot = search.candidates.end() - 1;
+            while (slot != search.candidates.begin() && candidate < *(slot - 1))
+            {
+                *slot = *(slot - 1);
+                --slot;
+            }
+            *slot = candidate;
+        }
+    };
+
+    // The query point itself is visited first, so that the candidates found
+    // near it prune most of the other periodic images right away.
+    visit(0, 0);
+    for (unsigned int image = 1; image < m_n_images; ++image)
+    {
+        const float root_r_sq = distanceSquared(m_aabb_tree.getNodeAABB(0), pos_i + m_image_list[image]);
+        if (!is_pruned(root_r_sq))
+        {
+            search.nodes.push_back({root_r_sq, 0, image});
+            std::push_heap(search.nodes.begin(), search.nodes.end());
+        }
+    }
+
+    // Visit the deferred nodes in order of distance. Once the closest one
+    // cannot contain a better candidate, no remaining node can either.
+    while (!search.nodes.empty())
+    {
+        std::pop_heap(search.nodes.begin(), search.nodes.end());
+        const NearestNeighborSearch::PendingNode pending = search.nodes.back();
+        search.nodes.pop_back();
+        if (is_pruned(pending.r_sq))
+        {
+            break;
+        }
+        visit(pending.node, pending.image);
+    }
+
+}
+
+void AABBQuery::queryNearest(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                             util::ManagedArray<unsigned int>& point_indices,
+                             util::ManagedArray<float>& distances) const
+{
+    args.mode = QueryType::nearest;
+    validateQueryArgs(args);
+    const unsigned int num_neighbors = args.num_neighbors;
+
+    point_indices.prepare({n_query_points, num_neighbors});
+    distances.prepare({n_query_points, num_neighbors});
+
+    // Visit the query points in the order of the leaves of the tree when they
+    // are the points of the tree, as NeighborQueryIterator does.
+    const unsigned int* query_order = nullptr;
+    if (query_points == m_points && n_query_points == m_n_points && m_spatial_order.size() == n_query_points)
+    {
+        query_order = m_spatial_order.get();
+    }
+
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        NearestNeighborSearch search;
+        std::shared_ptr<NeighborQueryPerPointIterator> iter;
+        for (size_t n = begin; n < end; ++n)
+        {
+            const size_t i = (query_order != nullptr) ? query_order[n] : n;
+            const auto query_point_idx = static_cast<unsigned int>(i);
+            unsigned int* row_indices = point_indices.get() + i * num_neighbors;
+            float* row_distances = distances.get() + i * num_neighbors;
+            unsigned int num_found = 0;
+            if (findNearestNeighbors(query_points[i], query_point_idx, num_neighbors, args.r_max, args.r_min,
+                                     args.r_guess, args.scale, args.exclude_ii, search))
+            {
+                for (const NearestNeighborCandidate& candidate : search.candidates)
+                {
+                    row_indices[num_found] = candidate.point_idx;
+                    row_distances[num_found] = std::sqrt(candidate.r_sq);
+                    ++num_found;
+                }
+            }
+            else
+            {
+                if (iter == nullptr)
+                {
+                    iter = querySingle(query_points[i], query_point_idx, args);
+                }
+                else
+                {
+                    iter->reset(query_points[i], query_point_idx);
+                }
+                for (NeighborBond nb = iter->next(); !iter->end(); nb = iter->next())
+                {
+                    row_indices[num_found] = nb.getPointIdx();
+                    row_distances[num_found] = nb.getDistance();
+                    ++num_found;
+                }
+            }
+            for (; num_found < num_neighbors; ++num_found)
+            {
+                row_indices[num_found] = getNPoints();
+                row_distances[num_found] = std::numeric_limits<float>::infinity();
+            }
+        }
+    });
+}
+
+void AABBIterator::updateImageVectors(float r_max, bool all_images)
+{
+    // Reallocate memory if necessary
+    if (m_image_list.size() < MAX_NUM_IMAGES)
+    {
+        m_image_list.resize(MAX_NUM_IMAGES);
+    }
+    const auto capacity = static_cast<unsigned int>(m_image_list.size());
+    m_n_images = m_aabb_query->getImageVectors(r_max, all_images, m_image_list.data(), capacity);
+    if (m_n_images > capacity)
+    {
+        m_image_list.resize(m_n_images);
+        m_aabb_query->getImageVectors(r_max, all_images, m_image_list.data(), m_n_images);
+    }
 }
 
 NeighborBond AABBQueryBallIterator::next()
@@ -155,36 +559,31 @@ NeighborBond AABBQueryBallIterator::next()
             {
                 if (m_aabb_query->m_aabb_tree.isNodeLeaf(cur_node_idx))
                 {
-                    while (cur_ref_p < m_aabb_query->m_aabb_tree.getNodeNumParticles(cur_node_idx))
+                    // Compute the distances to all points of the leaf at
+                    // once, then return the ones within the ball in order.
+                    if (!cur_leaf_evaluated)
                     {
-                        // Neighbor j
-                        const unsigned int j
-                            = m_aabb_query->m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
-                        // Increment before possible return.
-                        cur_ref_p++;
-
-                        // Skip ii matches immediately if requested.
-                        if (m_exclude_ii && m_query_point_idx == j)
-                        {
-                            continue;
-                        }
-
-                        // Read in the position of j
-                        vec3<float> pos_j((*m_neighbor_query)[j]);
-                        if (m_neighbor_query->getBox().is2D())
-                        {
-                            pos_j.z = 0;
-                        }
-
-                        // Compute distance
-                        const vec3<float> r_ij = pos_j - pos_i_image;
-                        const float r_sq = dot(r_ij, r_ij);
+                        computeBallBatch(m_aabb_query->getLeafCoordinates(cur_node_idx, 0),
+                                         m_aabb_query->getLeafCoordinates(cur_node_idx, 1),
+                                         m_aabb_query->getLeafCoordinates(cur_node_idx, 2),
+                                         m_aabb_query->m_aabb_tree.getNodeNumParticles(cur_node_idx),
+                                         pos_i_image, r_min_sq, r_max_sq, nullptr, m_batch);
+                        cur_leaf_evaluated = true;
+                    }
+                    const unsigned int* leaf_points = m_aabb_query->getLeafPoints(cur_node_idx);
+                    while (!m_batch.empty())
+                    {
+                        const unsigned int k = m_batch.pos++;
+                        const unsigned int j = leaf_points[m_batch.index[k]];
 
-                        // Check ii exclusion before including the pair.
-                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                        // Skip ii matches and mirrored bonds if requested.
+                        if (m_aabb_query->isBondExcluded(m_query_point_idx, j, m_batch.r_sq[k],
+                                                         m_batch.r_ij[k], m_exclude_ii, m_half_list))
                         {
-                            return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq), 1, r_ij);
+                            continue;
                         }
+                        return NeighborBond(m_query_point_idx, j, std::sqrt(m_batch.r_sq[k]), 1,
+                                            m_batch.r_ij[k]);
                     }
                 }
             }
@@ -194,7 +593,7 @@ NeighborBond AABBQueryBallIterator::next()
                 cur_node_idx += m_aabb_query->m_aabb_tree.getNodeSkip(cur_node_idx);
             }
             cur_node_idx++;
-            cur_ref_p = 0;
+            cur_leaf_evaluated = false;
         } // end stackless search
         cur_image++;
         cur_node_idx = 0;
@@ -221,98 +620,104 @@ NeighborBond AABBQueryIterator::next()
     // search for new neighbors the first time next is called.
     if (m_current_neighbors.empty())
     {
-        // Continually perform ball queries until the termination conditions are met.
-        while (true)
+        // Most searches are answered by a best-first traversal of the tree.
+        // The expanding ball queries below are only needed if the neighbors
+        // may lie beyond the distance within which each point has a unique
+        // periodic image.
+        if (m_aabb_query->findNearestNeighbors(m_query_point, m_query_point_idx, m_num_neighbors, m_r_max,
+                                               m_r_min, m_r_guess, m_scale, m_exclude_ii, m_search))
         {
-            // Perform a ball query to get neighbors. To ensure that we allow
-            // ball queries to exceed their normal boundaries, we pass false as
-            // the _check_r_max. We also can't depend on the ball query for
-            // r_min filtering because we're querying beyond the normally safe
-            // bounds, so we have to do it in this class.
-            m_current_neighbors.clear();
-            m_all_bonds_minimum_distance.clear();
-            m_query_points_below_r_min.clear();
-            std::shared_ptr<NeighborQueryPerPointIterator> ball_it = std::make_shared<AABBQueryBallIterator>(
-                static_cast<const AABBQuery*>(m_neighbor_query), m_query_point, m_query_point_idx,
-                std::min(m_r_cur, m_r_max), 0, m_exclude_ii, false);
-            while (!ball_it->end())
+            for (const NearestNeighborCandidate& candidate : m_search.candidates)
             {
-                NeighborBond nb = ball_it->next();
-                if (nb == ITERATOR_TERMINATOR)
-                {
-                    continue;
-                }
-
-                if (!m_exclude_ii || m_query_point_idx != nb.getPointIdx())
-                {
-                    nb.setQueryPointIdx(m_query_point_idx);
-                    // If we've expanded our search radius beyond safe
-                    // distance, use the map instead of the vector.
-                    if (m_search_extended)
-                    {
-                        const unsigned int nb_point_idx = nb.getPointIdx();
-                        const float nb_distance = nb.getDistance();
-                        if ((m_all_bonds_minimum_distance.count(nb_point_idx) == 0)
-                            || m_all_bonds_minimum_distance[nb_point_idx].getDistance() > nb_distance)
+                m_current_neighbors.emplace_back(m_query_point_idx, candidate.point_idx,
+                                                 std::sqrt(candidate.r_sq), 1, candidate.r_ij);
+            }
+        }
+        else
+        {
+            // Continually perform ball queries until the termination conditions are met.
+            while (true)
+            {
+                // Perform a ball query to get neighbors. To ensure that we allow
+                // ball queries to exceed their normal boundaries while
+                // only searching the nearest images, we pass false as
+                // all_images. We also can't depend on the ball query for
+                // r_min filtering because we're querying beyond the normally safe
+                // bounds, so we have to do it in this class.
+                m_current_neighbors.clear();
+                m_all_bonds_minimum_distance.clear();
+                m_query_points_below_r_min.clear();
+                m_aabb_query->forEachBallNeighbor(
+                    m_query_point, m_query_point_idx, std::min(m_r_cur, m_r_max), 0, m_exclude_ii, false,
+                    [this](const NeighborBond& nb) {
+                        // If we've expanded our search radius beyond safe
+                        // distance, use the map instead of the vector.
+                        if (m_search_extended)
                         {
-                            m_all_bonds_minimum_distance[nb_point_idx] = nb;
-                            if (nb_distance < m_r_min)
+                            const unsigned int nb_point_idx = nb.getPointIdx();
+                            const float nb_distance = nb.getDistance();
+                            if ((m_all_bonds_minimum_distance.count(nb_point_idx) == 0)
+                                || m_all_bonds_minimum_distance[nb_point_idx].getDistance() > nb_distance)
                             {
-                                m_query_points_below_r_min.insert(nb_point_idx);
+                                m_all_bonds_minimum_distance[nb_point_idx] = nb;
+                                if (nb_distance < m_r_min)
+                                {
+                                    m_query_points_below_r_min.insert(nb_point_idx);
+                                }
                             }
                         }
-                    }
-                    else
-                    {
-                        if (nb.getDistance() >= m_r_min)
+                        else
                         {
-                            m_current_neighbors.emplace_back(nb);
+                            if (nb.getDistance() >= m_r_min)
+                            {
+                                m_current_neighbors.emplace_back(nb);
+                            }
                         }
-                    }
-                }
-            }
+                    },
+                    false);
 
-            // Break if there are enough neighbors, or if we are querying beyond the limits of
-            // the periodic box.
-            m_r_cur *= m_scale;
+                // Break if there are enough neighbors, or if we are querying beyond the limits of
+                // the periodic box.
+                m_r_cur *= m_scale;
 
-            if (m_current_neighbors.size() >= m_num_neighbors)
-            {
-                std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
-                break;
-            }
+                if (m_current_neighbors.size() >= m_num_neighbors)
+                {
+                    std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
+                    break;
+                }
 
-            if ((m_r_cur >= m_r_max) || (m_r_cur >= max_plane_distance)
-                || ((m_all_bonds_minimum_distance.size() - m_query_points_below_r_min.size())
-                    >= m_num_neighbors))
-            {
-                // Once this condition is reached, either we found enough
-                // neighbors beyond the normal min_plane_distance
-                // condition or we conclude that there are not enough
-                // neighbors left in the system.
-                for (const auto& minimum_distance_bond : m_all_bonds_minimum_distance)
+                if ((m_r_cur >= m_r_max) || (m_r_cur >= max_plane_distance)
+                    || ((m_all_bonds_minimum_distance.size() - m_query_points_below_r_min.size())
+                        >= m_num_neighbors))
                 {
-                    if (minimum_distance_bond.second.getDistance() >= m_r_min)
+                    // Once this condition is reached, either we found enough
+                    // neighbors beyond the normal min_plane_distance
+                    // condition or we conclude that there are not enough
+                    // neighbors left in the system.
+                    for (const auto& minimum_distance_bond : m_all_bonds_minimum_distance)
                     {
-                        m_current_neighbors.emplace_back(minimum_distance_bond.second);
+                        if (minimum_distance_bond.second.getDistance() >= m_r_min)
+                        {
+                            m_current_neighbors.emplace_back(minimum_distance_bond.second);
+                        }
                     }
+                    std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
+                    break;
                 }
-                std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
-                break;
-            }
 
-            if (m_r_cur > min_plane_distance / 2)
-            {
-                // If we have to go beyond the cutoff radius, we need to
-                // start tracking what particles are already in the set so
-                // that we can make sure that we find the closest image
-                // because we now run the risk of finding duplicates.
-                //
-                // We could make this marginally more efficient by checking
-                // whether we've exactly hit the limit, or if there's a
-                // rescaling that would let us try the exact limit once
-                // before going beyond the min plane distance.
-                m_search_extended = true;
+                if (m_r_cur > min_plane_distance / 2)
+                {
+                    // If we have to go beyond the cutoff radius, we need to
+                    // start tracking what particles are already in the set so
+                    // that we can make sure that we find the closest image
+                    // because we now run the risk of finding duplicates.
+                    //
+                    // We could make this marginally more efficient by checking
+                    // whether we've exactly hit the limit, or if there's a
+                    // rescaling that would let us try the exact limit once
+                    // before going beyond the min plane distance.
+                    m_search_extended = true;
+                }
             }
         }
     }
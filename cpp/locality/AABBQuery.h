@@ -4,6 +4,7 @@
 #ifndef AABBQUERY_H
 #define AABBQUERY_H
 
+#include <array>
 #include <cmath>
 #include <map>
 #include <memory>
@@ -12,6 +13,7 @@
 
 #include "AABBTree.h"
 #include "Box.h"
+#include "DistanceKernel.h"
 #include "NeighborQuery.h"
 
 /*! \file AABBQuery.h
@@ -29,6 +31,47 @@
 
 namespace freud { namespace locality {
 
+//! Maximum number of periodic images searched by a query (3 per periodic dimension).
+constexpr unsigned int MAX_NUM_IMAGES = 27;
+
+//! A candidate neighbor found by a nearest neighbor search.
+struct NearestNeighborCandidate
+{
+    float r_sq;             //!< Squared distance to the query point.
+    unsigned int point_idx; //!< Index of the point.
+    vec3<float> r_ij;       //!< Vector from the query point to the point.
+
+    //! Order candidates by distance, breaking ties by point index.
+    bool operator<(const NearestNeighborCandidate& other) const
+    {
+        return (r_sq < other.r_sq) || (r_sq == other.r_sq && point_idx < other.point_idx);
+    }
+};
+
+//! Reusable storage for the nearest neighbor searches of AABBQuery.
+/*! Searches for many query points can share one instance so that the
+ *  storage is only allocated once.
+ */
+struct NearestNeighborSearch
+{
+    //! A node of the tree waiting to be visited, keyed by its distance to the query point.
+    struct PendingNode
+    {
+        float r_sq;         //!< Squared distance from the node's AABB to the query point image.
+        unsigned int node;  //!< Index of the node.
+        unsigned int image; //!< Index of the periodic image of the query point.
+
+        //! Order nodes so that the standard heap functions pop the closest node first.
+        bool operator<(const PendingNode& other) const
+        {
+            return r_sq > other.r_sq;
+        }
+    };
+
+    std::vector<NearestNeighborCandidate> candidates; //!< The best candidates found, sorted by distance.
+    std::vector<PendingNode> nodes;                   //!< Min-heap of the nodes to visit.
+};
+
 class AABBQuery : public NeighborQuery
 {
 public:
@@ -41,6 +84,22 @@ public:
     //! Destructor
     ~AABBQuery() override;
 
+    //! Replace the box and points, refitting the tree (see NeighborQuery::updatePoints).
+    /*! If the number of points is unchanged, the AABBs of the existing tree
+     *  are recomputed for the new points without changing its topology. The
+     *  tree is only rebuilt if the number of points changed or if refitting
+     *  made its nodes so much larger (relative to the box) that queries would
+     *  become slower than rebuilding (see REBUILD_COST_FACTOR). The storage of
+     *  the tree is reused in either case.
+     */
+    void updatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points) override;
+
+    //! Get the number of times the tree has been built, including by the constructor.
+    unsigned int getNumBuilds() const
+    {
+        return m_num_builds;
+    }
+
     //! Implementation of per-particle query for AABBQuery (see NeighborQuery.h for documentation).
     /*! \param query_point The point to find neighbors for.
      *  \param n_query_points The number of query points.
@@ -49,6 +108,188 @@ public:
     std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
+    //! Estimate the number density of the points around a position from the leaf of the tree nearest to it.
+    float estimateDensity(const vec3<float>& point) const override;
+
+    //! Apply a function to all neighbors of a query point within a ball.
+    /*! This finds the same bonds in the same order as a ball query through
+     *  querySingle, but passes them directly to cf instead of creating an
+     *  iterator, so it performs no allocations. The query arguments must
+     *  already have been validated.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param r_max The maximum distance of neighbors.
+     *  \param r_min The minimum distance of neighbors.
+     *  \param exclude_ii Whether to exclude bonds between points with the same index.
+     *  \param half_list Whether to only find bonds to points with a larger index.
+     *  \param cf An object with operator(const NeighborBond&).
+     *  \param all_images Whether to search every periodic image within r_max,
+     *         rather than only the nearest images.
+     */
+    template<typename ComputeBondType>
+    void forEachBallNeighbor(const vec3<float>& query_point, unsigned int query_point_idx, float r_max,
+                             float r_min, bool exclude_ii, bool half_list, const ComputeBondType& cf,
+                             bool all_images = true) const
+    {
+        const float r_max_sq = r_max * r_max;
+        const float r_min_sq = r_min * r_min;
+        std::array<vec3<float>, MAX_NUM_IMAGES> image_array;
+        std::vector<vec3<float>> image_vector;
+        const vec3<float>* image_list = image_array.data();
+        const unsigned int n_images = getImageVectors(r_max, all_images, image_array.data(), MAX_NUM_IMAGES);
+        if (n_images > MAX_NUM_IMAGES)
+        {
+            // r_max reaches beyond the nearest images of the box.
+            image_vector.resize(n_images);
+            getImageVectors(r_max, all_images, image_vector.data(), n_images);
+            image_list = image_vector.data();
+        }
+
+        vec3<float> pos_i(query_point);
+        if (m_box.is2D())
+        {
+            pos_i.z = 0;
+        }
+
+        BallBatch batch;
+        const unsigned int num_nodes = m_aabb_tree.getNumNodes();
+        for (unsigned int image = 0; image < n_images; ++image)
+        {
+            const vec3<float> pos_i_image = pos_i + image_list[image];
+            const AABBSphere asphere(pos_i_image, r_max);
+
+            // Stackless traversal of the tree
+            for (unsigned int node = 0; node < num_nodes; ++node)
+            {
+                if (!overlap(m_aabb_tree.getNodeAABB(node), asphere))
+                {
+                    node += m_aabb_tree.getNodeSkip(node);
+                    continue;
+                }
+                if (!m_aabb_tree.isNodeLeaf(node))
+                {
+                    continue;
+                }
+                computeBallBatch(getLeafCoordinates(node, 0), getLeafCoordinates(node, 1),
+                                 getLeafCoordinates(node, 2), m_aabb_tree.getNodeNumParticles(node),
+                                 pos_i_image, r_min_sq, r_max_sq, nullptr, batch);
+                const unsigned int* leaf_points = getLeafPoints(node);
+                for (unsigned int k = 0; k < batch.size; ++k)
+                {
+                    const unsigned int j = leaf_points[batch.index[k]];
+                    if (isBondExcluded(query_point_idx, j, batch.r_sq[k], batch.r_ij[k], exclude_ii,
+                                       half_list))
+                    {
+                        continue;
+                    }
+                    cf(NeighborBond(query_point_idx, j, std::sqrt(batch.r_sq[k]), 1, batch.r_ij[k]));
+                }
+            }
+        }
+    }
+
+    //! Find the nearest neighbors of a query point by a best-first traversal of the tree.
+    /*! Nodes are visited in order of their distance to the query point
+     *  (over all periodic images), and only the best num_neighbors
+     *  candidates are kept, so the search stops as soon as no unvisited node
+     *  can contain a closer point. On return, search.candidates holds the
+     *  neighbors sorted by distance.
+     *
+     *  Until num_neighbors candidates are found, the search is limited to
+     *  r_guess * scale. If that finds too few points, the search is repeated
+     *  up to half of the smallest nearest plane distance of the box, within
+     *  which every point has a unique periodic image. If fewer than
+     *  num_neighbors points lie within that distance (and r_max is larger),
+     *  the result may be incomplete and false is returned; callers must then
+     *  fall back to AABBQueryIterator's expanding ball queries.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param num_neighbors The number of neighbors to find.
+     *  \param r_max The maximum distance of neighbors.
+     *  \param r_min The minimum distance of neighbors.
+     *  \param r_guess The estimated distance of the farthest neighbor.
+     *  \param scale The factor by which r_guess is enlarged to bound the first search.
+     *  \param exclude_ii Whether to exclude bonds between points with the same index.
+     *  \param search Storage for the search, which also holds the results.
+     *  \returns Whether the result is complete.
+     */
+    bool findNearestNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                              unsigned int num_neighbors, float r_max, float r_min, float r_guess, float scale,
+                              bool exclude_ii, NearestNeighborSearch& search) const;
+
+    //! Find the nearest neighbors of many query points as dense arrays.
+    /*! This performs a nearest neighbor query without creating bonds or a
+     *  NeighborList. Row i of the outputs holds the neighbors of query point
+     *  i sorted by distance. If fewer than num_neighbors neighbors are found,
+     *  the remaining entries have the index getNPoints() and an infinite
+     *  distance.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param n_query_points The number of query points.
+     *  \param args The query arguments. The mode is always nearest.
+     *  \param point_indices Output array of shape (n_query_points, num_neighbors).
+     *  \param distances Output array of shape (n_query_points, num_neighbors).
+     */
+    void queryNearest(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                      util::ManagedArray<unsigned int>& point_indices,
+                      util::ManagedArray<float>& distances) const;
+
+    //! Compute the periodic image vectors to search for a given cutoff.
+    /*! With all_images, as many shells of images are included along each
+     *  periodic dimension as r_max spans nearest plane distances, so ball
+     *  queries need no PeriodicBuffer for large r_max. Otherwise, only the
+     *  3^d nearest images are included.
+     *
+     *  \param r_max The query distance.
+     *  \param all_images Whether to include every image within r_max.
+     *  \param image_list Output array of max_images vectors.
+     *  \param max_images The capacity of image_list.
+     *  \returns The number of image vectors, which are only written if there are at most max_images.
+     */
+    unsigned int getImageVectors(float r_max, bool all_images, vec3<float>* image_list,
+                                 unsigned int max_images) const;
+
+    //! Check whether a bond of a ball query is excluded by exclude_ii or half_list.
+    /*! Beyond m_r_unique_image, a point may be bonded to its own periodic
+     *  images. These bonds are kept by exclude_ii, and half_list keeps the
+     *  one of each pair of opposite images whose bond vector is positive in
+     *  lexicographic order.
+     */
+    bool isBondExcluded(unsigned int query_point_idx, unsigned int point_idx, float r_sq,
+                        const vec3<float>& r_ij, bool exclude_ii, bool half_list) const
+    {
+        if (point_idx != query_point_idx)
+        {
+            return half_list && point_idx < query_point_idx;
+        }
+        if (r_sq < m_r_unique_image * m_r_unique_image)
+        {
+            return exclude_ii || half_list;
+        }
+        const bool positive = r_ij.x > 0 || (r_ij.x == 0 && (r_ij.y > 0 || (r_ij.y == 0 && r_ij.z > 0)));
+        return half_list && !positive;
+    }
+
+    //! Get the indices of the points in a leaf node of the tree
+    const unsigned int* getLeafPoints(unsigned int node) const
+    {
+        return m_spatial_order.get() + m_leaf_offsets[node];
+    }
+
+    //! Get one coordinate of the points in a leaf node of the tree
+    /*! Positions are stored as structure-of-arrays in the order of the
+     *  leaves, with z set to zero in 2D, so traversals evaluate a whole leaf
+     *  at once from contiguous memory.
+     *  \param node The leaf node.
+     *  \param dim The coordinate (0, 1 or 2 for x, y or z).
+     */
+    const float* getLeafCoordinates(unsigned int node, unsigned int dim) const
+    {
+        return m_leaf_positions.data() + dim * m_leaf_positions.size() / 3 + m_leaf_offsets[node];
+    }
+
     AABBTree m_aabb_tree; //!< AABB tree of points
 
 protected:
@@ -92,6 +333,10 @@ protected:
 
                 args.r_guess = std::min(r_guess, min_plane_distance / float(2.0));
             }
+            else if (args.r_guess <= 0)
+            {
+                throw std::runtime_error("The r_guess query argument must be positive.");
+            }
             if (args.r_guess > args.r_max)
             {
                 // No need to search past the requested bounds even if requested.
@@ -101,6 +346,12 @@ protected:
     }
 
 private:
+    //! Factor by which the cost of a refitted tree may exceed that of a new tree before it is rebuilt
+    static constexpr float REBUILD_COST_FACTOR = 1.5;
+
+    //! Compute the periodic images used by nearest neighbor searches
+    void setupImages();
+
     //! Driver for tree configuration
     void setupTree(unsigned int N);
 
@@ -110,7 +361,26 @@ private:
     //! Driver to build AABB trees
     void buildTree(const vec3<float>* points, unsigned int N);
 
-    std::vector<AABB> m_aabbs; //!< Flat array of AABBs of all types
+    //! Recompute the AABBs of the tree for new points, rebuilding it if its cost grew too much
+    void refitTree(const vec3<float>* points, unsigned int N);
+
+    //! Get the cost of the tree (see AABBTree::getCost) relative to the size of the box
+    float getRelativeTreeCost() const;
+
+    //! Best-first search for the nearest neighbors within a distance (see findNearestNeighbors).
+    void findNearestNeighborsWithin(const vec3<float>& query_point, unsigned int query_point_idx,
+                                    unsigned int num_neighbors, float r_bound, float r_min, bool exclude_ii,
+                                    NearestNeighborSearch& search) const;
+
+    std::vector<AABB> m_aabbs;                //!< Flat array of AABBs of all types
+    std::vector<unsigned int> m_leaf_offsets; //!< Offset of each leaf node into the leaf order
+    std::vector<float> m_leaf_positions;      //!< Point coordinates (x, then y, then z) in leaf order
+
+    std::array<vec3<float>, MAX_NUM_IMAGES> m_image_list; //!< Periodic images searched for nearest neighbors
+    unsigned int m_n_images {0};                          //!< The number of periodic images
+    float m_r_unique_image {0};    //!< Distance within which every point has a unique periodic image
+    float m_build_cost {0};        //!< Relative cost of the tree when it was last built
+    unsigned int m_num_builds {0}; //!< Number of times the tree has been built
 };
 
 //! Parent class of AABB iterators that knows how to traverse general AABB tree structures.
@@ -129,7 +399,7 @@ public:
     ~AABBIterator() override = default;
 
     //! Computes the image vectors to query for
-    void updateImageVectors(float r_max, bool _check_r_max = true);
+    void updateImageVectors(float r_max, bool all_images = true);
 
 protected:
     const AABBQuery* m_aabb_query;         //!< Link to the AABBQuery object
@@ -146,8 +416,8 @@ public:
                       unsigned int query_point_idx, unsigned int num_neighbors, float r_guess, float r_max,
                       float r_min, float scale, bool exclude_ii)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), m_count(0),
-          m_num_neighbors(num_neighbors), m_search_extended(false), m_r_cur(r_guess), m_scale(scale),
-          m_all_bonds_minimum_distance(), m_query_points_below_r_min()
+          m_num_neighbors(num_neighbors), m_search_extended(false), m_r_guess(r_guess), m_r_cur(r_guess),
+          m_scale(scale), m_all_bonds_minimum_distance(), m_query_points_below_r_min()
     {
         updateImageVectors(0);
     }
@@ -155,6 +425,18 @@ public:
     //! Empty Destructor
     ~AABBQueryIterator() override = default;
 
+    //! Reset the iterator to find the neighbors of another query point.
+    void reset(const vec3<float>& query_point, unsigned int query_point_idx) override
+    {
+        AABBIterator::reset(query_point, query_point_idx);
+        m_count = 0;
+        m_current_neighbors.clear();
+        m_search_extended = false;
+        m_r_cur = m_r_guess;
+        m_all_bonds_minimum_distance.clear();
+        m_query_points_below_r_min.clear();
+    }
+
     //! Get the next element.
     NeighborBond next() override;
 
@@ -164,9 +446,11 @@ protected:
     std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
     bool m_search_extended; //!< Flag to see whether we've gone past the safe cutoff distance and have to be
                             //!< worried about finding duplicates.
+    float m_r_guess; //!< Initial search ball cutoff distance.
     float
         m_r_cur; //!< Current search ball cutoff distance in use for the current particle (expands as needed).
     float m_scale; //!< The amount to scale m_r by when the current ball is too small.
+    NearestNeighborSearch m_search; //!< Storage for the best-first search of the tree.
     std::map<unsigned int, NeighborBond>
         m_all_bonds_minimum_distance; //!< Hash map of minimum distances found for a given point,
                                       //!< used when searching beyond maximum safe AABB distance.
@@ -181,24 +465,35 @@ public:
     //! Constructor
     AABBQueryBallIterator(const AABBQuery* neighbor_query, const vec3<float>& query_point,
                           unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
-                          bool _check_r_max = true)
+                          bool all_images = true)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), cur_image(0),
-          cur_node_idx(0), cur_ref_p(0)
+          cur_node_idx(0)
     {
-        updateImageVectors(m_r_max, _check_r_max);
+        updateImageVectors(m_r_max, all_images);
     }
 
     //! Empty Destructor
     ~AABBQueryBallIterator() override = default;
 
+    //! Reset the iterator to find the neighbors of another query point.
+    void reset(const vec3<float>& query_point, unsigned int query_point_idx) override
+    {
+        AABBIterator::reset(query_point, query_point_idx);
+        cur_image = 0;
+        cur_node_idx = 0;
+        cur_leaf_evaluated = false;
+        m_batch.size = 0;
+        m_batch.pos = 0;
+    }
+
     //! Get the next element.
     NeighborBond next() override;
 
 private:
-    unsigned int cur_image;    //!< The current node in the tree.
-    unsigned int cur_node_idx; //!< The current node in the tree.
-    unsigned int
-        cur_ref_p; //!< The current index into the reference particles in the current node of the tree.
+    unsigned int cur_image;          //!< The current node in the tree.
+    unsigned int cur_node_idx;       //!< The current node in the tree.
+    bool cur_leaf_evaluated {false}; //!< Whether the distances to the current leaf were computed.
+    BallBatch m_batch;               //!< The points of the current leaf within the ball.
 };
 }; }; // end namespace freud::locality
 
@@ -4,14 +4,18 @@
 #ifndef AABB_TREE_H
 #define AABB_TREE_H
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <memory>
 #include <stack>
 #include <stdexcept>
+#include <tbb/parallel_invoke.h>
 #include <vector>
 
 #include "AABB.h"
 #include "VectorMath.h"
+#include "utils.h"
 
 /*! \file AABBTree.h
     \brief AABBTree build and query methods
@@ -30,6 +34,7 @@ namespace freud { namespace locality {
 
 constexpr unsigned int NODE_CAPACITY = 16;        //!< Maximum number of particles in a node
 constexpr unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
+constexpr unsigned int PARALLEL_BUILD_SIZE = 4096; //!< Minimum number of particles in a node built in parallel
 
 //! Node in an AABBTree
 /*! Stores data for a node in the AABB tree
@@ -68,14 +73,18 @@ struct CACHE_ALIGN AABBNode
    will only increase the volume of nodes. The tree should be rebuilt periodically instead of continually
    updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - refit : recompute the AABBs of all nodes for new particle AABBs, keeping the tree topology. Runs in
+   O(N) time without any allocation, but the tree becomes less efficient as particles move away from the
+   particles they were partitioned with (see getCost).
 
     **Implementation details**
 
-    AABBTree stores all nodes in a flat array managed by std::vector. To easily locate particle leaf nodes for
+    AABBTree stores all nodes in a flat, 32-byte aligned array. To easily locate particle leaf nodes for
    update, a reverse mapping is stored to locate the leaf node containing a particle. m_root tracks the index
-   of the root node as the tree is built. The nodes store the indices of their left and right children along
-   with their AABB. Nodes are allocated as needed with allocate(). With multiple particles per leaf node, the
-   total number of internal nodes needed is not known (but can be estimated) until build time.
+   of the root node. The nodes store the indices of their left and right children along with their AABB.
+   With multiple particles per leaf node, the total number of nodes needed is not known until the
+   particles have been partitioned, so buildTree partitions them first and then allocates exactly the
+   nodes needed.
 
     For performance, no recursive calls are used. Instead, each function is either turned into a loop if it
    uses tail recursion, or it uses a local stack to traverse the tree. The stack is cached between calls to
@@ -164,6 +173,12 @@ public:
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Recompute the AABBs of all nodes from new AABBs of the particles
+    inline void refit(const AABB* aabbs);
+
+    //! Get the sum of the edge lengths of the AABBs of all nodes
+    inline float getCost() const;
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
@@ -213,6 +228,14 @@ public:
         return (m_nodes[node].left);
     }
 
+    //! Get the right child of a given node
+    /*! \param node Index of the node (not the particle) to query
+     */
+    inline unsigned int getNodeRight(unsigned int node) const
+    {
+        return (m_nodes[node].right);
+    }
+
     //! Get the number of particles in a given node
     /*! \param node Index of the node (not the particle) to query
      */
@@ -248,15 +271,26 @@ private:
     //! Initialize the tree to hold N particles
     inline void init(unsigned int N);
 
-    //! Build a node of the tree recursively
-    inline unsigned int buildNode(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
-                                  unsigned int len, unsigned int parent);
-
-    //! Allocate a new node
-    inline unsigned int allocateNode();
-
-    //! Update the skip value for a node
-    inline unsigned int updateSkip(unsigned int idx);
+    //! Topology of a node recorded while building the tree
+    struct BuildNode
+    {
+        AABB aabb;                        //!< The box bounding this node's volume
+        unsigned int start {0};           //!< First AABB owned by this node
+        unsigned int len {0};             //!< Number of AABBs owned by this node
+        unsigned int num_nodes {0};       //!< Number of nodes in the subtree of this node, including itself
+        std::unique_ptr<BuildNode> left;  //!< The left child, null for leaves
+        std::unique_ptr<BuildNode> right; //!< The right child, null for leaves
+    };
+
+    //! Merge a list of AABBs into one
+    static inline AABB mergeAABBs(const AABB* aabbs, unsigned int N);
+
+    //! Partition the AABBs of a node recursively
+    inline void partitionNode(AABB* aabbs, unsigned int* idx, BuildNode& node);
+
+    //! Write a node and its subtree into the node array
+    inline void writeNode(const AABB* aabbs, const unsigned int* idx, const BuildNode& node,
+                          unsigned int node_idx, unsigned int parent);
 };
 
 /*! \param N Number of particles to allocate space for
@@ -349,6 +383,57 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
     }
 }
 
+/*! \param aabbs List of AABBs for each particle, indexed by particle index
+
+    Recomputes the AABB of every leaf node from the AABBs of its particles, and then the AABBs of the internal
+   nodes bottom up. Children are always stored after their parent, so visiting the nodes in reverse order
+   visits every child before its parent. Unlike update(), the AABBs shrink as well as grow.
+*/
+inline void AABBTree::refit(const AABB* aabbs)
+{
+    util::forLoopWrapper(0, m_num_nodes, [&](size_t begin, size_t end) {
+        for (size_t node_idx = begin; node_idx < end; ++node_idx)
+        {
+            AABBNode& node = m_nodes[node_idx];
+            if (node.left == INVALID_NODE && node.num_particles > 0)
+            {
+                AABB merged = aabbs[node.particles[0]];
+                for (unsigned int i = 1; i < node.num_particles; i++)
+                {
+                    merged = merge(merged, aabbs[node.particles[i]]);
+                }
+                node.aabb = merged;
+            }
+        }
+    });
+
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0;)
+    {
+        AABBNode& node = m_nodes[node_idx];
+        if (node.left != INVALID_NODE)
+        {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+        }
+    }
+}
+
+/*! \returns The sum of the edge lengths of the AABBs of all nodes
+
+    Queries visit the nodes whose AABBs overlap the query volume, so the cost of a query grows with the size
+   of the node AABBs. Edge lengths rather than volumes or surface areas are summed so that the cost is also
+   meaningful for the flat AABBs of 2D systems.
+*/
+inline float AABBTree::getCost() const
+{
+    double cost = 0;
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+    {
+        const vec3<float> extent = m_nodes[node_idx].aabb.getUpper() - m_nodes[node_idx].aabb.getLower();
+        cost += double(extent.x) + double(extent.y) + double(extent.z);
+    }
+    return static_cast<float>(cost);
+}
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -380,74 +465,131 @@ inline unsigned int AABBTree::height(unsigned int idx)
     \param N Number of AABBs in the list
 
     Builds a balanced tree from a given list of AABBs for each particle. Data in \a aabbs will be modified
-   during the construction process.
+   during the construction process: on return, the AABBs are sorted in the order of the leaves of the tree.
+
+    The build runs in two passes. The first pass recursively partitions the AABBs (see partitionNode),
+   processing the two halves of large nodes in parallel, and records the resulting topology. The second pass
+   writes the nodes into the flat node array in the same depth-first order as always used, so that the skip
+   of each node is simply the size of its subtree. Both passes produce exactly the same tree as a serial
+   build.
 */
 inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
 {
     init(N);
 
-    std::vector<unsigned int> idx;
+    std::vector<unsigned int> idx(N);
     for (unsigned int i = 0; i < N; i++)
     {
-        idx.push_back(i);
+        idx[i] = i;
+    }
+
+    BuildNode root;
+    root.start = 0;
+    root.len = N;
+    parallel::execute([&]() { partitionNode(aabbs, idx.data(), root); });
+
+    // allocate exactly the number of nodes in the tree
+    if (root.num_nodes > m_node_capacity)
+    {
+        if (m_nodes != nullptr)
+        {
+            posix_memalign_free(m_nodes);
+            m_nodes = nullptr;
+        }
+        // cppcheck-suppress AssignmentAddressToInteger
+        int retval = posix_memalign((void**) &m_nodes, 32, root.num_nodes * sizeof(AABBNode));
+        if (retval != 0)
+        {
+            throw std::runtime_error("Error allocating AABBTree memory");
+        }
+        m_node_capacity = root.num_nodes;
+    }
+    m_num_nodes = root.num_nodes;
+
+    parallel::execute([&]() { writeNode(aabbs, idx.data(), root, 0, INVALID_NODE); });
+    m_root = 0;
+}
+
+/*! \param aabbs List of AABBs
+    \param N Number of aabbs to merge
+    \returns The AABB enclosing all of the aabbs
+
+    Large lists are merged in parallel chunks. Merging is exact, so the result does not depend on the
+   chunking.
+*/
+inline AABB AABBTree::mergeAABBs(const AABB* aabbs, unsigned int N)
+{
+    if (N < PARALLEL_BUILD_SIZE)
+    {
+        AABB merged = aabbs[0];
+        for (unsigned int i = 1; i < N; i++)
+        {
+            merged = merge(merged, aabbs[i]);
+        }
+        return merged;
     }
 
-    m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
-    updateSkip(m_root);
+    const size_t num_chunks = (N + PARALLEL_BUILD_SIZE - 1) / PARALLEL_BUILD_SIZE;
+    std::vector<AABB> chunk_aabbs(num_chunks);
+    util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk)
+        {
+            const size_t chunk_begin = chunk * PARALLEL_BUILD_SIZE;
+            const size_t chunk_end = std::min<size_t>(chunk_begin + PARALLEL_BUILD_SIZE, N);
+            AABB merged = aabbs[chunk_begin];
+            for (size_t i = chunk_begin + 1; i < chunk_end; i++)
+            {
+                merged = merge(merged, aabbs[i]);
+            }
+            chunk_aabbs[chunk] = merged;
+        }
+    });
+
+    AABB merged = chunk_aabbs[0];
+    for (size_t chunk = 1; chunk < num_chunks; chunk++)
+    {
+        merged = merge(merged, chunk_aabbs[chunk]);
+    }
+    return merged;
 }
 
 /*! \param aabbs List of AABBs
     \param idx List of indices
-    \param start Start point in aabbs and idx to examine
-    \param len Number of aabbs to examine
-    \param parent Index of the parent node
+    \param node The node to partition, with its start and len set
 
-    buildNode is the main driver of the smart AABB tree build algorithm. Each call produces a node, given a
-   set of AABBs. If there are fewer AABBs than fit in a leaf, a leaf is generated. If there are too many, the
-   total AABB is computed and split on the largest length axis. The total tree is built by recursive
+    partitionNode is the main driver of the smart AABB tree build algorithm. Each call produces a node, given
+   a set of AABBs. If there are fewer AABBs than fit in a leaf, a leaf is generated. If there are too many,
+   the total AABB is computed and split on the largest length axis. The total tree is built by recursive
    splitting.
 
-    The aabbs and idx lists are passed in by reference. Each node is given a subrange of the list to own
-   (start to start + len). When building the node, it partitions its subrange into two sides (like quick
-   sort).
+    Each node is given a subrange of the aabbs and idx lists to own (start to start + len). When building the
+   node, it partitions its subrange into two sides (like quick sort). Since the subranges of the two children
+   are disjoint, large children are partitioned in parallel.
 */
-inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
-                                        unsigned int len, unsigned int parent)
+inline void AABBTree::partitionNode(AABB* aabbs, unsigned int* idx, BuildNode& node)
 {
+    const unsigned int start = node.start;
+    const unsigned int len = node.len;
+
     // merge all the AABBs into one
-    AABB my_aabb = aabbs[start];
-    for (unsigned int i = 1; i < len; i++)
+    if (len == 0)
     {
-        my_aabb = merge(my_aabb, aabbs[start + i]);
+        node.aabb = AABB();
+        node.num_nodes = 1;
+        return;
     }
-    vec3<float> my_radius = my_aabb.getUpper() - my_aabb.getLower();
+    const AABB my_aabb = mergeAABBs(aabbs + start, len);
+    const vec3<float> my_radius = my_aabb.getUpper() - my_aabb.getLower();
+    node.aabb = my_aabb;
 
     // handle the case of a leaf node creation
     if (len <= NODE_CAPACITY)
     {
-        unsigned int new_node = allocateNode();
-        m_nodes[new_node].aabb = my_aabb;
-        m_nodes[new_node].parent = parent;
-        m_nodes[new_node].num_particles = len;
-
-        for (unsigned int i = 0; i < len; i++)
-        {
-            // assign the particle indices into the leaf node
-            m_nodes[new_node].particles[i] = idx[start + i];
-            m_nodes[new_node].particle_tags[i] = aabbs[start + i].tag;
-
-            // assign the reverse mapping from particle indices to leaf node indices
-            m_mapping[idx[start + i]] = new_node;
-        }
-
-        return new_node;
+        node.num_nodes = 1;
+        return;
     }
 
-    // otherwise, we are creating an internal node - allocate an index
-    unsigned int my_idx = allocateNode();
-
     // need to split the list of aabbs into two sets for left and right
-    unsigned int start_left = 0;
     unsigned int start_right = len;
 
     // if there are only 2 aabbs, put one on each side
@@ -458,73 +600,33 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
     if (len != 2)
     {
         // otherwise, we need to split them based on a heuristic. split the longest dimension in half
+        unsigned int axis = 2;
         if (my_radius.x > my_radius.y && my_radius.x > my_radius.z)
         {
-            // split on x direction
-            for (unsigned int i = 0; i < start_right; i++)
-            {
-                if (aabbs[start + i].getPosition().x < my_aabb.getPosition().x)
-                {
-                    // if on the left side, everything is happy, just continue on
-                }
-                else
-                {
-                    // if on the right side, need to swap the current aabb with the one at
-                    // start_right-1, subtract one off of start_right to indicate the addition
-                    // of one to the right side and subtract 1 from i to look at the current
-                    // index (new aabb). This is quick and easy to write, but will randomize
-                    // indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
-                    std::swap(idx[start + i], idx[start + start_right - 1]);
-                    start_right--;
-                    i--;
-                }
-            }
+            axis = 0;
         }
         else if (my_radius.y > my_radius.z)
         {
-            // split on y direction
-            for (unsigned int i = 0; i < start_right; i++)
-            {
-                if (aabbs[start + i].getPosition().y < my_aabb.getPosition().y)
-                {
-                    // if on the left side, everything is happy, just continue on
-                }
-                else
-                {
-                    // if on the right side, need to swap the current aabb with the one at
-                    // start_right-1, subtract one off of start_right to indicate the addition
-                    // of one to the right side and subtract 1 from i to look at the current
-                    // index (new aabb). This is quick and easy to write, but will randomize
-                    // indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
-                    std::swap(idx[start + i], idx[start + start_right - 1]);
-                    start_right--;
-                    i--;
-                }
-            }
+            axis = 1;
         }
-        else
+        const auto coordinate = [axis](const vec3<float>& v) {
+            return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+        };
+        const float split = coordinate(my_aabb.getPosition());
+
+        for (unsigned int i = 0; i < start_right; i++)
         {
-            // split on z direction
-            for (unsigned int i = 0; i < start_right; i++)
+            if (!(coordinate(aabbs[start + i].getPosition()) < split))
             {
-                if (aabbs[start + i].getPosition().z < my_aabb.getPosition().z)
-                {
-                    // if on the left side, everything is happy, just continue on
-                }
-                else
-                {
-                    // if on the right side, need to swap the current aabb with the one at
-                    // start_right-1, subtract one off of start_right to indicate the addition
-                    // of one to the right side and subtract 1 from i to look at the current
-                    // index (new aabb). This is quick and easy to write, but will randomize
-                    // indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
-                    std::swap(idx[start + i], idx[start + start_right - 1]);
-                    start_right--;
-                    i--;
-                }
+                // if on the right side, need to swap the current aabb with the one at
+                // start_right-1, subtract one off of start_right to indicate the addition
+                // of one to the right side and subtract 1 from i to look at the current
+                // index (new aabb). This is quick and easy to write, but will randomize
+                // indices - might need to look into a stable partitioning algorithm!
+                std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
+                std::swap(idx[start + i], idx[start + start_right - 1]);
+                start_right--;
+                i--;
             }
         }
     }
@@ -539,81 +641,75 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
         start_right = 1;
     }
 
-    // note: calling buildNode has side effects, the m_nodes array may be reallocated. So we need to determine
-    // the left and right children, then build our node (can't say m_nodes[my_idx].left = buildNode(...))
-    unsigned int new_left = buildNode(aabbs, idx, start + start_left, start_right - start_left, my_idx);
-    unsigned int new_right = buildNode(aabbs, idx, start + start_right, len - start_right, my_idx);
-
-    // now, create the children and connect them up
-    m_nodes[my_idx].aabb = my_aabb;
-    m_nodes[my_idx].parent = parent;
-    m_nodes[my_idx].left = new_left;
-    m_nodes[my_idx].right = new_right;
+    node.left = std::make_unique<BuildNode>();
+    node.left->start = start;
+    node.left->len = start_right;
+    node.right = std::make_unique<BuildNode>();
+    node.right->start = start + start_right;
+    node.right->len = len - start_right;
 
-    return my_idx;
+    if (len >= PARALLEL_BUILD_SIZE)
+    {
+        tbb::parallel_invoke([&]() { partitionNode(aabbs, idx, *node.left); },
+                             [&]() { partitionNode(aabbs, idx, *node.right); });
+    }
+    else
+    {
+        partitionNode(aabbs, idx, *node.left);
+        partitionNode(aabbs, idx, *node.right);
+    }
+    node.num_nodes = 1 + node.left->num_nodes + node.right->num_nodes;
 }
 
-/*! \param idx Index of the node to update
+/*! \param aabbs List of AABBs, partitioned by partitionNode
+    \param idx List of indices, partitioned by partitionNode
+    \param node The node to write
+    \param node_idx Index of the node in the node array
+    \param parent Index of the parent node
 
-    updateSkip() updates the skip field of every node in the tree. The skip field is used in the stackless
-    implementation of query. Each node's skip field lists the number of nodes that are children to this node.
-   Because of the order in which nodes are built in buildNode(), this number is the number of elements to skip
-   in a search if a box-box test does not overlap.
+    Nodes are written depth first, with each node followed by its left and then its right subtree. The skip
+   field used in the stackless implementation of query is the number of nodes that are children of a node,
+   i.e. the number of elements to skip in a search if a box-box test does not overlap.
 */
-inline unsigned int AABBTree::updateSkip(unsigned int idx)
+inline void AABBTree::writeNode(const AABB* aabbs, const unsigned int* idx, const BuildNode& node,
+                                unsigned int node_idx, unsigned int parent)
 {
-    // leaf nodes have no nodes under them
-    if (isNodeLeaf(idx))
-    {
-        return 1;
-    }
-    // node idx needs to skip all the nodes underneath it (determined recursively)
-    unsigned int left_idx = m_nodes[idx].left;
-    unsigned int right_idx = m_nodes[idx].right;
-
-    unsigned int skip = updateSkip(left_idx) + updateSkip(right_idx);
-    m_nodes[idx].skip = skip;
-    return skip + 1;
-}
+    AABBNode& out = m_nodes[node_idx];
+    out = AABBNode();
+    out.aabb = node.aabb;
+    out.parent = parent;
 
-/*! Allocates a new node in the tree and return its index.
- */
-inline unsigned int AABBTree::allocateNode()
-{
-    // grow the memory if needed
-    if (m_num_nodes >= m_node_capacity)
+    if (!node.left)
     {
-        // determine new capacity
-        AABBNode* m_new_nodes = nullptr;
-        unsigned int m_new_node_capacity = m_node_capacity * 2;
-        if (m_new_node_capacity == 0)
-        {
-            m_new_node_capacity = 16;
-        }
-
-        // allocate new memory
-        // cppcheck-suppress AssignmentAddressToInteger
-        int retval = posix_memalign((void**) &m_new_nodes, 32, m_new_node_capacity * sizeof(AABBNode));
-        if (retval != 0)
+        out.num_particles = node.len;
+        for (unsigned int i = 0; i < node.len; i++)
         {
-            throw std::runtime_error("Error allocating AABBTree memory");
-        }
+            // assign the particle indices into the leaf node
+            out.particles[i] = idx[node.start + i];
+            out.particle_tags[i] = aabbs[node.start + i].tag;
 
-        // if we have old memory, copy it over
-        if (m_nodes != nullptr)
-        {
-            // cppcheck doesn't recognize that posix_memalign allocates memory for m_new_nodes above.
-            // cppcheck-suppress nullPointer
-            std::memcpy((void*) m_new_nodes, (void*) m_nodes, sizeof(AABBNode) * m_num_nodes);
-            posix_memalign_free(m_nodes);
+            // assign the reverse mapping from particle indices to leaf node indices
+            m_mapping[idx[node.start + i]] = node_idx;
         }
-        m_nodes = m_new_nodes;
-        m_node_capacity = m_new_node_capacity;
+        return;
     }
 
-    m_nodes[m_num_nodes] = AABBNode();
-    m_num_nodes++;
-    return m_num_nodes - 1;
+    const unsigned int left_idx = node_idx + 1;
+    const unsigned int right_idx = left_idx + node.left->num_nodes;
+    out.left = left_idx;
+    out.right = right_idx;
+    out.skip = node.num_nodes - 1;
+
+    if (node.len >= PARALLEL_BUILD_SIZE)
+    {
+        tbb::parallel_invoke([&]() { writeNode(aabbs, idx, *node.left, left_idx, node_idx); },
+                             [&]() { writeNode(aabbs, idx, *node.right, right_idx, node_idx); });
+    }
+    else
+    {
+        writeNode(aabbs, idx, *node.left, left_idx, node_idx);
+        writeNode(aabbs, idx, *node.right, right_idx, node_idx);
+    }
 }
 
 }; }; // end namespace freud::locality
@@ -4,13 +4,37 @@
 #ifndef BOND_HISTOGRAM_COMPUTE_H
 #define BOND_HISTOGRAM_COMPUTE_H
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <tbb/partitioner.h>
+
 #include "Box.h"
+#include "DeviceBackend.h"
 #include "Histogram.h"
 #include "NeighborComputeFunctional.h"
 #include "NeighborQuery.h"
+#include "Profiler.h"
 
 namespace freud { namespace locality {
 
+//! Selection of a random subset of the query points of each frame.
+/*! Accumulating a fraction of the query points of each frame reduces the
+ *  cost of a histogram proportionally. The sampled query points are dealt
+ *  into batches whose bin counts are kept separately, so the standard error
+ *  of each bin can be estimated from the spread of the batch means.
+ */
+struct QuerySampling
+{
+    float fraction {1};            //!< Fraction of the query points accumulated in each frame.
+    bool stratified {true};        //!< Whether to sample one query point of each run of consecutive indices.
+    unsigned int seed {0};         //!< Seed of the random number generator.
+    unsigned int num_batches {10}; //!< Number of batches for the standard error.
+};
+
 //! Perform parallel histogram computations.
 /*! The BondHistogramCompute class serves as a parent class for freud computes
  * that compute histograms of neighbor bonds. It encapsulates a Histogram
@@ -34,6 +58,10 @@ public:
         m_local_histograms.reset();
         m_frame_counter = 0;
         m_reduce = true;
+        m_num_batches = 0;
+        m_batch_histograms.clear();
+        m_batch_counts.clear();
+        m_batch_query_points.clear();
     }
 
     //! Reduce thread-local arrays onto the primary data arrays.
@@ -50,6 +78,7 @@ public:
     {
         if (m_reduce)
         {
+            foldBatchHistograms();
             reduce();
         }
         m_reduce = false;
@@ -90,6 +119,52 @@ public:
         return m_histogram.getAxisSizes();
     }
 
+    //! Get the number of points of the last accumulated frame.
+    unsigned int getNPoints() const
+    {
+        return m_n_points;
+    }
+
+    //! Get the number of query points of the last accumulated frame.
+    unsigned int getNQueryPoints() const
+    {
+        return m_n_query_points;
+    }
+
+    //! Get the number of batches of sampled query points, or 0 if every query point was accumulated.
+    unsigned int getNumBatches() const
+    {
+        return m_num_batches;
+    }
+
+    //! Replace the histogram with bin counts summed over the domains of a system.
+    /*! When the query points of a system are split into domains (see
+     *  DomainDecomposition) that are accumulated by separate processes, the
+     *  histogram of the system is the sum of the histograms of the domains.
+     *  This replaces the accumulated bin counts with that sum and the numbers
+     *  of points with those of the whole system, so the histogram is
+     *  normalized as if the whole system had been accumulated here. The
+     *  number of frames is kept, since every domain accumulates the same
+     *  frames. Computes that accumulate more than bin counts cannot be
+     *  combined this way.
+     *
+     *  \param bin_counts The summed bin counts, in the layout of getBinCounts.
+     *  \param n_points The total number of points.
+     *  \param n_query_points The total number of query points.
+     */
+    void setDomainTotals(const unsigned int* bin_counts, unsigned int n_points, unsigned int n_query_points)
+    {
+        m_local_histograms.reset();
+        const size_t num_bins = m_histogram.getBinCounts().size();
+        for (size_t bin = 0; bin < num_bins; ++bin)
+        {
+            m_local_histograms.increment(bin, bin_counts[bin]);
+        }
+        m_n_points = n_points;
+        m_n_query_points = n_query_points;
+        m_reduce = true;
+    }
+
     //! \internal
     // Wrapper to do accumulation.
     /*! \param neighbor_query NeighborQuery object to iterate over
@@ -105,14 +180,475 @@ public:
                            unsigned int n_query_points, const locality::NeighborList* nlist,
                            locality::QueryArgs qargs, Func cf)
     {
+        checkNotSampled();
+        m_box = neighbor_query->getBox();
+        // Each pair of a half neighbor list is counted in both directions.
+        qargs = mirrorableQueryArgs(neighbor_query, query_points, n_query_points, qargs);
+        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist,
+                                    locality::mirrorBonds(cf, qargs.half_list && nlist == nullptr));
+        m_frame_counter++;
+        m_n_points = neighbor_query->getNPoints();
+        m_n_query_points = n_query_points;
+        m_reduce = true;
+    }
+
+    //! \internal
+    // Wrapper to do accumulation directly into the thread-local histograms.
+    /*! This behaves like accumulateGeneral, except that the thread-local
+        histogram is looked up once per chunk of work and passed to the compute
+        function along with each bond.
+
+        \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Query points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
+           appropriately with given qargs.
+        \param qargs Query arguments
+        \param cf An object with operator(BondHistogram&, NeighborBond) as input.
+    */
+    template<typename Func>
+    void accumulateHistogram(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                             unsigned int n_query_points, const locality::NeighborList* nlist,
+                             locality::QueryArgs qargs, Func cf)
+    {
+        accumulateHistogramChunks(neighbor_query, query_points, n_query_points, nlist, qargs,
+                                  [&cf](BondHistogram& local_histogram) {
+                                      return [&cf, &local_histogram](const NeighborBond& neighbor_bond) {
+                                          cf(local_histogram, neighbor_bond);
+                                      };
+                                  });
+    }
+
+    //! \internal
+    // Wrapper to do accumulation into the thread-local histograms with a compute function per chunk.
+    /*! This behaves like accumulateHistogram, except that a new compute
+        function is made for each chunk of work from the thread-local
+        histogram. The bonds of a query point are passed to the compute
+        function of a chunk consecutively, so it may keep per-query-point
+        state (e.g. a rotation matrix) across the bonds of the chunk.
+
+        \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Query points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
+           appropriately with given qargs.
+        \param qargs Query arguments
+        \param make_cf An object with operator(BondHistogram&) returning an
+           object with operator(NeighborBond) as input.
+        \param local_histograms Thread local histograms to accumulate into. If
+           NULL, m_local_histograms is used.
+    */
+    template<typename MakeFunc>
+    void accumulateHistogramChunks(const locality::NeighborQuery* neighbor_query,
+                                   const vec3<float>* query_points, unsigned int n_query_points,
+                                   const locality::NeighborList* nlist, locality::QueryArgs qargs,
+                                   MakeFunc make_cf,
+                                   util::Histogram<unsigned int>::ThreadLocalHistogram* local_histograms
+                                   = nullptr)
+    {
+        FREUD_PROFILE_SCOPE("BondHistogramCompute::accumulate");
+        FREUD_PROFILE_COUNT("BondHistogramCompute::accumulate::query_points", n_query_points);
+        checkNotSampled();
+        if (local_histograms == nullptr)
+        {
+            local_histograms = &m_local_histograms;
+        }
+        m_box = neighbor_query->getBox();
+        // Replaying the mapping of query points to threads of the previous
+        // frame lets each thread find its points and histogram in its cache.
+        // Each pair of a half neighbor list is counted in both directions.
+        qargs = mirrorableQueryArgs(neighbor_query, query_points, n_query_points, qargs);
+        const bool mirror = qargs.half_list && nlist == nullptr;
+        locality::loopOverNeighborChunks(
+            neighbor_query, query_points, n_query_points, qargs, nlist,
+            [&]() { return locality::mirrorBonds(make_cf(local_histograms->local()), mirror); }, true,
+            util::LoopSchedule {1, &m_affinity});
+        m_frame_counter++;
+        m_n_points = neighbor_query->getNPoints();
+        m_n_query_points = n_query_points;
+        m_reduce = true;
+    }
+
+    //! \internal
+    // Wrapper to bin the bond distances of a ball query with the device backend.
+    /*! Computes whose histogram has a single axis of bond distances can call
+        this before accumulateHistogram. Nothing is accumulated and false is
+        returned if freud was built without a device backend (see
+        DeviceBackend), or if the bonds are not those of a ball query:
+        a neighbor list is given, the query is not a ball query, or it only
+        finds half of the bonds.
+
+        \param neighbor_query NeighborQuery object providing the box and points
+        \param query_points Query points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List, or NULL to find the bonds with qargs.
+        \param qargs Query arguments
+
+        \return Whether the bonds were binned by the device backend.
+    */
+    bool accumulateDistancesOnDevice(const locality::NeighborQuery* neighbor_query,
+                                     const vec3<float>* query_points, unsigned int n_query_points,
+                                     const locality::NeighborList* nlist, const locality::QueryArgs& qargs)
+    {
+        const locality::DeviceBackend* device = locality::getDeviceBackend();
+        if (device == nullptr || nlist != nullptr || qargs.mode != locality::QueryType::ball
+            || qargs.half_list)
+        {
+            return false;
+        }
+        checkNotSampled();
+        const util::Axis& axis = *m_histogram.getAxes()[0];
+        util::ManagedArray<unsigned int> bin_counts(axis.size());
+        device->binBondDistances(neighbor_query->getBox(), neighbor_query->getPoints(),
+                                 neighbor_query->getNPoints(), query_points, n_query_points, qargs, axis,
+                                 bin_counts.get());
+        for (size_t bin = 0; bin < bin_counts.size(); ++bin)
+        {
+            m_local_histograms.increment(bin, bin_counts[bin]);
+        }
+        m_box = neighbor_query->getBox();
+        m_frame_counter++;
+        m_n_points = neighbor_query->getNPoints();
+        m_n_query_points = n_query_points;
+        m_reduce = true;
+        return true;
+    }
+
+    //! \internal
+    // Wrapper to do accumulation from a CompressedNeighborList with a compute function per chunk.
+    /*! This behaves like accumulateHistogramChunks, except that the bonds are
+        decoded from the compressed list while they are binned.
+
+        \param neighbor_query NeighborQuery object providing the box and points
+        \param n_query_points Number of query_points
+        \param nlist Compressed neighbor list to loop over.
+        \param make_cf An object with operator(BondHistogram&) returning an
+           object with operator(NeighborBond) as input.
+    */
+    template<typename MakeFunc>
+    void accumulateHistogramChunks(const locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                                   const locality::CompressedNeighborList* nlist, MakeFunc make_cf)
+    {
+        FREUD_PROFILE_SCOPE("BondHistogramCompute::accumulate");
+        FREUD_PROFILE_COUNT("BondHistogramCompute::accumulate::query_points", n_query_points);
+        checkNotSampled();
+        nlist->validate(n_query_points, neighbor_query->getNPoints());
         m_box = neighbor_query->getBox();
-        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
+        locality::loopOverNeighborChunks(
+            nlist, [&]() { return make_cf(m_local_histograms.local()); }, true,
+            util::LoopSchedule {1, &m_affinity});
         m_frame_counter++;
         m_n_points = neighbor_query->getNPoints();
         m_n_query_points = n_query_points;
         m_reduce = true;
     }
 
+    //! \internal
+    // Wrapper to do accumulation of several frames directly into the thread-local histograms.
+    /*! This behaves like calling accumulateHistogram on each frame, except
+        that the frames are processed concurrently. A RawPoints constructs the
+        tree it queries on its first query, so the tree of one frame is built
+        while the bonds of other frames are binned. The box and numbers of
+        points of the last frame are kept for normalization, as when frames are
+        accumulated one at a time.
+
+        \param neighbor_queries NeighborQuery object of each frame.
+        \param query_points Query points of each frame.
+        \param n_query_points Number of query_points of each frame.
+        \param qargs Query arguments used for all frames.
+        \param cf An object with operator(size_t frame, BondHistogram&, NeighborBond) as input.
+    */
+    template<typename Func>
+    void accumulateHistogramFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                                   const std::vector<const vec3<float>*>& query_points,
+                                   const std::vector<unsigned int>& n_query_points, locality::QueryArgs qargs,
+                                   Func cf)
+    {
+        accumulateHistogramFramesChunks(
+            neighbor_queries, query_points, n_query_points, qargs,
+            [&cf](size_t frame, BondHistogram& local_histogram) {
+                return [&cf, &local_histogram, frame](const NeighborBond& neighbor_bond) {
+                    cf(frame, local_histogram, neighbor_bond);
+                };
+            });
+    }
+
+    //! \internal
+    // Wrapper to do accumulation of several frames with a compute function per chunk.
+    /*! This is accumulateHistogramFrames with a compute function made for
+        each chunk of work, as in accumulateHistogramChunks.
+
+        \param neighbor_queries NeighborQuery object of each frame.
+        \param query_points Query points of each frame.
+        \param n_query_points Number of query_points of each frame.
+        \param qargs Query arguments used for all frames.
+        \param make_cf An object with operator(size_t frame, BondHistogram&)
+           returning an object with operator(NeighborBond) as input.
+        \param local_histograms Thread local histograms to accumulate into. If
+           NULL, m_local_histograms is used.
+    */
+    template<typename MakeFunc>
+    void accumulateHistogramFramesChunks(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                                         const std::vector<const vec3<float>*>& query_points,
+                                         const std::vector<unsigned int>& n_query_points,
+                                         locality::QueryArgs qargs, MakeFunc make_cf,
+                                         util::Histogram<unsigned int>::ThreadLocalHistogram*
+                                             local_histograms
+                                         = nullptr)
+    {
+        FREUD_PROFILE_SCOPE("BondHistogramCompute::accumulateFrames");
+        checkNotSampled();
+        if (local_histograms == nullptr)
+        {
+            local_histograms = &m_local_histograms;
+        }
+        const size_t n_frames = neighbor_queries.size();
+        if (query_points.size() != n_frames || n_query_points.size() != n_frames)
+        {
+            throw std::invalid_argument("Query points must be provided for every frame.");
+        }
+        if (n_frames == 0)
+        {
+            return;
+        }
+        FREUD_PROFILE_COUNT("BondHistogramCompute::accumulateFrames::frames", n_frames);
+        util::forLoopWrapper(0, n_frames, [&](size_t begin, size_t end) {
+            for (size_t frame = begin; frame < end; ++frame)
+            {
+                const locality::QueryArgs frame_qargs = mirrorableQueryArgs(
+                    neighbor_queries[frame], query_points[frame], n_query_points[frame], qargs);
+                locality::loopOverNeighborChunks(
+                    neighbor_queries[frame], query_points[frame], n_query_points[frame], frame_qargs, nullptr,
+                    [&, frame]() {
+                        return locality::mirrorBonds(make_cf(frame, local_histograms->local()),
+                                                     frame_qargs.half_list);
+                    });
+            }
+        });
+        m_box = neighbor_queries.back()->getBox();
+        m_frame_counter += n_frames;
+        m_n_points = neighbor_queries.back()->getNPoints();
+        m_n_query_points = n_query_points.back();
+        m_reduce = true;
+    }
+
+    //! \internal
+    // Wrapper to do accumulation of a sample of the query points into the histograms of their batches.
+    /*! This behaves like accumulateHistogramChunks, except that only the
+        query points selected by sampling are visited, and the bonds of each
+        batch of query points are binned into the thread-local histograms of
+        that batch. The batches are added to the histogram before it is
+        reduced. The number of query points used for normalization is the
+        number of sampled query points, so the histogram estimates the one of
+        all query points.
+
+        \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Query points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
+           appropriately with given qargs.
+        \param qargs Query arguments
+        \param sampling Selection of the query points.
+        \param make_cf An object with operator(unsigned int batch, BondHistogram&)
+           returning an object with operator(NeighborBond) as input.
+    */
+    template<typename MakeFunc>
+    void accumulateSampledHistogramChunks(const locality::NeighborQuery* neighbor_query,
+                                          const vec3<float>* query_points, unsigned int n_query_points,
+                                          const locality::NeighborList* nlist, locality::QueryArgs qargs,
+                                          const QuerySampling& sampling, MakeFunc make_cf)
+    {
+        FREUD_PROFILE_SCOPE("BondHistogramCompute::accumulateSampled");
+        if (qargs.half_list && nlist == nullptr)
+        {
+            throw std::invalid_argument("Sampled query points cannot be used with half neighbor lists.");
+        }
+        const auto batches = sampleQueryPoints(n_query_points, sampling);
+        unsigned int n_sampled = 0;
+        for (unsigned int batch = 0; batch < batches.size(); ++batch)
+        {
+            locality::loopOverSampledNeighborChunks(
+                neighbor_query, query_points, n_query_points, batches[batch], qargs, nlist,
+                [&]() { return make_cf(batch, m_batch_histograms[batch].local()); });
+            m_batch_query_points[batch] += static_cast<double>(batches[batch].size());
+            n_sampled += static_cast<unsigned int>(batches[batch].size());
+        }
+        m_box = neighbor_query->getBox();
+        m_frame_counter++;
+        m_n_points = neighbor_query->getNPoints();
+        m_n_query_points = n_sampled;
+        m_reduce = true;
+    }
+
+    //! Select the sampled query points of a frame, dealt into batches.
+    /*! With stratified sampling the query points are split into runs of
+        consecutive indices of length about 1 / fraction, and one query point
+        is picked at random from each run; otherwise the query points are
+        picked at random without replacement. The random number generator is
+        seeded with the seed and the frame number, so every frame samples
+        different query points reproducibly.
+    */
+    std::vector<std::vector<unsigned int>> sampleQueryPoints(unsigned int n_query_points,
+                                                             const QuerySampling& sampling)
+    {
+        if (!(sampling.fraction > 0 && sampling.fraction <= 1))
+        {
+            throw std::invalid_argument("The sampled fraction of query points must be in (0, 1].");
+        }
+        if (sampling.num_batches < 2)
+        {
+            throw std::invalid_argument("Sampled query points require at least 2 batches.");
+        }
+        if (m_frame_counter != 0 && m_num_batches != sampling.num_batches)
+        {
+            throw std::invalid_argument(
+                "Frames accumulated with and without sampled query points (or with different numbers of "
+                "batches) cannot be combined; reset the computation first.");
+        }
+        const auto n_sampled = static_cast<unsigned int>(
+            std::lround(static_cast<double>(sampling.fraction) * static_cast<double>(n_query_points)));
+        if (n_sampled < sampling.num_batches)
+        {
+            throw std::invalid_argument("Too few query points are sampled to fill every batch.");
+        }
+
+        std::seed_seq seed {sampling.seed, m_frame_counter};
+        std::mt19937 rng(seed);
+        std::vector<unsigned int> sample(n_sampled);
+        if (sampling.stratified)
+        {
+            for (unsigned int stratum = 0; stratum < n_sampled; ++stratum)
+            {
+                const auto begin = static_cast<unsigned int>(uint64_t(stratum) * n_query_points / n_sampled);
+                const auto end
+                    = static_cast<unsigned int>(uint64_t(stratum + 1) * n_query_points / n_sampled);
+                sample[stratum] = std::uniform_int_distribution<unsigned int>(begin, end - 1)(rng);
+            }
+        }
+        else
+        {
+            std::vector<unsigned int> indices(n_query_points);
+            std::iota(indices.begin(), indices.end(), 0);
+            std::sample(indices.begin(), indices.end(), sample.begin(), n_sampled, rng);
+        }
+
+        if (m_num_batches == 0)
+        {
+            m_num_batches = sampling.num_batches;
+            for (unsigned int batch = 0; batch < m_num_batches; ++batch)
+            {
+                m_batch_histograms.emplace_back(m_histogram);
+            }
+            const size_t num_bins = m_histogram.getBinCounts().size();
+            m_batch_counts.assign(m_num_batches, std::vector<unsigned int>(num_bins, 0));
+            m_batch_query_points.assign(m_num_batches, 0);
+        }
+
+        // Consecutive sampled query points are dealt to different batches.
+        std::vector<std::vector<unsigned int>> batches(m_num_batches);
+        for (unsigned int k = 0; k < n_sampled; ++k)
+        {
+            batches[k % m_num_batches].push_back(sample[k]);
+        }
+        return batches;
+    }
+
+    //! Add the bonds binned into the batch histograms since the last reduction to the histogram.
+    void foldBatchHistograms()
+    {
+        const size_t num_bins = m_histogram.getBinCounts().size();
+        for (unsigned int batch = 0; batch < m_num_batches; ++batch)
+        {
+            util::ManagedArray<unsigned int> batch_counts(num_bins);
+            m_batch_histograms[batch].reduceInto(batch_counts);
+            auto& local_histogram = m_local_histograms.local();
+            for (size_t bin = 0; bin < num_bins; ++bin)
+            {
+                const unsigned int added = batch_counts[bin] - m_batch_counts[batch][bin];
+                if (added != 0)
+                {
+                    local_histogram.increment(bin, added);
+                }
+                m_batch_counts[batch][bin] = batch_counts[bin];
+            }
+        }
+    }
+
+    //! Estimate the standard error of each bin count from the spread of the batch means.
+    /*! The bin counts per sampled query point of each batch are independent
+        estimates of their mean, so the standard error of the bin count is
+        the standard error of the mean of the batch estimates times the
+        number of sampled query points. All bins are zero if the query points
+        were not sampled. The batch histograms must have been folded.
+    */
+    std::vector<float> getBinCountStandardErrors() const
+    {
+        const size_t num_bins = m_histogram.getBinCounts().size();
+        std::vector<float> errors(num_bins, 0);
+        if (m_num_batches == 0)
+        {
+            return errors;
+        }
+        const double n_sampled
+            = std::accumulate(m_batch_query_points.begin(), m_batch_query_points.end(), 0.0);
+        const double num_batches = m_num_batches;
+        for (size_t bin = 0; bin < num_bins; ++bin)
+        {
+            double total = 0;
+            for (unsigned int batch = 0; batch < m_num_batches; ++batch)
+            {
+                total += m_batch_counts[batch][bin];
+            }
+            const double mean = total / n_sampled;
+            double sum_squares = 0;
+            for (unsigned int batch = 0; batch < m_num_batches; ++batch)
+            {
+                const double deviation = m_batch_counts[batch][bin] / m_batch_query_points[batch] - mean;
+                sum_squares += deviation * deviation;
+            }
+            errors[bin] = static_cast<float>(n_sampled
+                                             * std::sqrt(sum_squares / (num_batches * (num_batches - 1))));
+        }
+        return errors;
+    }
+
+    //! Throw if the query points of earlier frames were sampled.
+    void checkNotSampled() const
+    {
+        if (m_num_batches != 0)
+        {
+            throw std::invalid_argument(
+                "Frames accumulated with and without sampled query points cannot be combined; reset the "
+                "computation first.");
+        }
+    }
+
+    //! Get the query arguments to find bonds that can be binned in both directions.
+    /*! A bond (i, j) of a half neighbor list is mirrored into the bond
+        (j, i) of query point j. This is only correct if the query points are
+        the points, and if the per-point data of the query points (e.g. their
+        orientations) is that of the points. Otherwise half_list is cleared,
+        so that all bonds are found by a full query.
+
+        \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Query points
+        \param n_query_points Number of query_points
+        \param qargs Query arguments
+        \param same_query_data Whether the query points have the per-point data of the points.
+    */
+    static locality::QueryArgs mirrorableQueryArgs(const locality::NeighborQuery* neighbor_query,
+                                                   const vec3<float>* query_points,
+                                                   unsigned int n_query_points, locality::QueryArgs qargs,
+                                                   bool same_query_data = true)
+    {
+        if (qargs.half_list
+            && (!same_query_data || !neighbor_query->hasPoints(query_points, n_query_points)))
+        {
+            qargs.half_list = false;
+        }
+        return qargs;
+    }
+
 protected:
     box::Box m_box;
     unsigned int m_frame_counter {0};  //!< Number of frames calculated.
@@ -123,6 +659,14 @@ protected:
     util::Histogram<unsigned int> m_histogram; //!< Histogram of interparticle distances (bond lengths).
     util::Histogram<unsigned int>::ThreadLocalHistogram
         m_local_histograms; //!< Thread local bin counts for TBB parallelism
+    tbb::affinity_partitioner m_affinity; //!< Mapping of query points to threads of the last frame.
+
+    unsigned int m_num_batches {0}; //!< Number of batches of sampled query points, or 0 if not sampled.
+    std::vector<util::Histogram<unsigned int>::ThreadLocalHistogram>
+        m_batch_histograms; //!< Thread local bin counts of each batch of sampled query points.
+    std::vector<std::vector<unsigned int>>
+        m_batch_counts;                       //!< Bin counts of each batch added to the histogram.
+    std::vector<double> m_batch_query_points; //!< Number of sampled query points of each batch.
 
     using BondHistogram = util::Histogram<unsigned int>;
 };
@@ -0,0 +1,166 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "CompressedNeighborList.h"
+#include "utils.h"
+
+/*! \file CompressedNeighborList.cc
+    \brief Stores neighbor lists with quantized vectors and delta-encoded indices.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+
+//! Number of bytes used to encode an index difference.
+size_t encodedSize(unsigned int delta)
+{
+    size_t size = 1;
+    while (delta >= 0x80)
+    {
+        delta >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+//! Encode an index difference at the given byte, advancing byte past it.
+void encodeDelta(unsigned int delta, uint8_t* indices, size_t& byte)
+{
+    while (delta >= 0x80)
+    {
+        indices[byte++] = static_cast<uint8_t>(delta & 0x7F) | 0x80;
+        delta >>= 7;
+    }
+    indices[byte++] = static_cast<uint8_t>(delta);
+}
+
+//! Get the (point index, bond index) pairs of a query point, sorted by point index.
+void sortedSegment(const NeighborListSegment& segment, std::vector<std::pair<unsigned int, unsigned int>>& bonds)
+{
+    bonds.resize(segment.size());
+    for (unsigned int k = 0; k < segment.size(); ++k)
+    {
+        bonds[k] = {segment.getPointIdx(k), segment.begin() + k};
+    }
+    std::sort(bonds.begin(), bonds.end());
+}
+
+} // namespace
+
+CompressedNeighborList::CompressedNeighborList(const NeighborList& nlist, float r_max)
+    : m_num_query_points(nlist.getNumQueryPoints()), m_num_points(nlist.getNumPoints()),
+      m_num_bonds(nlist.getNumBonds()), m_r_max(r_max), m_scale(r_max / QUANTIZATION_LEVELS)
+{
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("CompressedNeighborList requires r_max to be positive.");
+    }
+    nlist.updateSegmentCounts();
+    const float* weights = nlist.getWeights().get();
+    const vec3<float>* vectors = nlist.getVectors().get();
+
+    // The weights are only stored if any of them differs from 1.
+    const bool unit_weights = std::all_of(weights, weights + m_num_bonds, [](float w) { return w == 1; });
+    const bool out_of_range = std::any_of(vectors, vectors + m_num_bonds, [r_max](const vec3<float>& v) {
+        return std::abs(v.x) > r_max || std::abs(v.y) > r_max || std::abs(v.z) > r_max;
+    });
+    if (out_of_range)
+    {
+        throw std::invalid_argument(
+            "CompressedNeighborList requires all bond vector components to be at most r_max in magnitude.");
+    }
+
+    // The point indices of each query point are encoded independently, so
+    // the size of each segment is computed first to place them.
+    m_bond_offsets.prepare(m_num_query_points + 1);
+    m_index_offsets.prepare(m_num_query_points + 1);
+    std::copy(nlist.getOffsets().get(), nlist.getOffsets().get() + m_num_query_points + 1, m_bond_offsets.get());
+    size_t* index_offsets = m_index_offsets.get();
+    util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        std::vector<std::pair<unsigned int, unsigned int>> bonds;
+        for (size_t i = begin; i < end; ++i)
+        {
+            sortedSegment(nlist.getSegment(i), bonds);
+            size_t size = 0;
+            unsigned int previous = 0;
+            for (const auto& bond : bonds)
+            {
+                size += encodedSize(bond.first - previous);
+                previous = bond.first;
+            }
+            index_offsets[i + 1] = size;
+        }
+    });
+    std::partial_sum(index_offsets, index_offsets + m_num_query_points + 1, index_offsets);
+
+    m_point_indices.prepare(index_offsets[m_num_query_points]);
+    m_vectors.prepare(size_t(3) * m_num_bonds);
+    if (!unit_weights)
+    {
+        m_weights.prepare(m_num_bonds);
+    }
+    uint8_t* point_indices = m_point_indices.get();
+    int16_t* quantized = m_vectors.get();
+    util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        std::vector<std::pair<unsigned int, unsigned int>> bonds;
+        for (size_t i = begin; i < end; ++i)
+        {
+            sortedSegment(nlist.getSegment(i), bonds);
+            size_t byte = index_offsets[i];
+            unsigned int previous = 0;
+            unsigned int bond = m_bond_offsets.get()[i];
+            for (const auto& original : bonds)
+            {
+                encodeDelta(original.first - previous, point_indices, byte);
+                previous = original.first;
+                const vec3<float>& v = vectors[original.second];
+                quantized[3 * bond] = static_cast<int16_t>(std::lround(v.x / m_scale));
+                quantized[3 * bond + 1] = static_cast<int16_t>(std::lround(v.y / m_scale));
+                quantized[3 * bond + 2] = static_cast<int16_t>(std::lround(v.z / m_scale));
+                if (!unit_weights)
+                {
+                    m_weights.get()[bond] = weights[original.second];
+                }
+                ++bond;
+            }
+        }
+    });
+}
+
+size_t CompressedNeighborList::getNumBytes() const
+{
+    return sizeof(unsigned int) * m_bond_offsets.size() + sizeof(size_t) * m_index_offsets.size()
+        + m_point_indices.size() + sizeof(int16_t) * m_vectors.size() + sizeof(float) * m_weights.size();
+}
+
+NeighborList* CompressedNeighborList::toNeighborList() const
+{
+    auto* nlist = new NeighborList();
+    nlist->setNumBonds(m_num_bonds, m_num_query_points, m_num_points);
+    const unsigned int* bond_offsets = m_bond_offsets.get();
+    util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            unsigned int bond = bond_offsets[i];
+            forEachBond(i, [&](const NeighborBond& nb) { nlist->setNeighborEntry(bond++, nb); });
+        }
+    });
+    return nlist;
+}
+
+void CompressedNeighborList::validate(unsigned int num_query_points, unsigned int num_points) const
+{
+    if (num_query_points != m_num_query_points || num_points != m_num_points)
+    {
+        throw std::runtime_error("CompressedNeighborList found inconsistent array sizes.");
+    }
+}
+
+}; }; // end namespace freud::locality
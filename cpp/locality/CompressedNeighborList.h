@@ -0,0 +1,188 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef COMPRESSED_NEIGHBOR_LIST_H
+#define COMPRESSED_NEIGHBOR_LIST_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ManagedArray.h"
+#include "NeighborBond.h"
+#include "NeighborList.h"
+#include "NeighborPerPointIterator.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file CompressedNeighborList.h
+    \brief Stores neighbor lists with quantized vectors and delta-encoded indices.
+*/
+
+namespace freud { namespace locality {
+
+//! Compact read-only representation of a NeighborList.
+/*! For very large neighbor lists, traversing the bonds is limited by memory
+ *  bandwidth rather than by the computation done on each bond. This class
+ *  stores the bonds of a NeighborList in about a quarter of the memory:
+ *
+ *  - The bonds of each query point are sorted by point index, and each point
+ *    index is stored as the difference to the previous one in a variable
+ *    length encoding of 7 bits per byte, so most bonds use a single byte.
+ *  - Each component of a bond vector is stored as a 16-bit fixed-point
+ *    number scaled by r_max, so the vectors are exact to r_max / 32767.
+ *  - Distances are computed from the decoded vectors, and weights are only
+ *    stored if they are not all 1.
+ *
+ *  The bonds are decoded while they are traversed (see forEachBond and
+ *  CompressedNeighborListPerPointIterator), so the decompressed list is never
+ *  stored.
+ */
+class CompressedNeighborList
+{
+public:
+    //! Compress a NeighborList.
+    /*! \param nlist NeighborList to compress.
+     *  \param r_max Bound of the components of all bond vectors, which sets
+     *         the resolution of the quantized vectors.
+     */
+    CompressedNeighborList(const NeighborList& nlist, float r_max);
+
+    //! Return the number of bonds.
+    unsigned int getNumBonds() const
+    {
+        return m_num_bonds;
+    }
+
+    //! Return the number of query points.
+    unsigned int getNumQueryPoints() const
+    {
+        return m_num_query_points;
+    }
+
+    //! Return the number of points.
+    unsigned int getNumPoints() const
+    {
+        return m_num_points;
+    }
+
+    //! Return the bound of the bond vector components.
+    float getRMax() const
+    {
+        return m_r_max;
+    }
+
+    //! Return the number of bytes used to store the bonds.
+    size_t getNumBytes() const;
+
+    //! Decompress the bonds into a NeighborList.
+    /*! The caller is responsible for deleting the returned NeighborList. */
+    NeighborList* toNeighborList() const;
+
+    //! Throw a runtime_error if num_points and num_query_points do not match the stored values.
+    void validate(unsigned int num_query_points, unsigned int num_points) const;
+
+    //! Decode the bonds of query point i, passing each to f in order of point index.
+    template<typename Func> void forEachBond(unsigned int i, const Func& f) const
+    {
+        const uint8_t* indices = m_point_indices.get();
+        const int16_t* vectors = m_vectors.get();
+        const float* weights = m_weights.size() == 0 ? nullptr : m_weights.get();
+        const unsigned int bond_end = m_bond_offsets.get()[i + 1];
+        size_t byte = m_index_offsets.get()[i];
+        unsigned int point_idx = 0;
+        for (unsigned int bond = m_bond_offsets.get()[i]; bond < bond_end; ++bond)
+        {
+            point_idx += decodeDelta(indices, byte);
+            const vec3<float> r_ij(float(vectors[3 * bond]) * m_scale, float(vectors[3 * bond + 1]) * m_scale,
+                                   float(vectors[3 * bond + 2]) * m_scale);
+            f(NeighborBond(i, point_idx, std::sqrt(dot(r_ij, r_ij)),
+                           weights == nullptr ? float(1) : weights[bond], r_ij));
+        }
+    }
+
+private:
+    //! Decode the index difference starting at the given byte, advancing byte past it.
+    static unsigned int decodeDelta(const uint8_t* indices, size_t& byte)
+    {
+        unsigned int delta = 0;
+        unsigned int shift = 0;
+        uint8_t value;
+        do
+        {
+            value = indices[byte++];
+            delta |= static_cast<unsigned int>(value & 0x7F) << shift;
+            shift += 7;
+        } while ((value & 0x80) != 0);
+        return delta;
+    }
+
+    //! Largest magnitude of the quantized vector components.
+    static constexpr float QUANTIZATION_LEVELS = 32767;
+
+    unsigned int m_num_query_points; //!< Number of query points.
+    unsigned int m_num_points;       //!< Number of points.
+    unsigned int m_num_bonds;        //!< Number of bonds.
+    float m_r_max;                   //!< Bound of the bond vector components.
+    float m_scale;                   //!< Length of one quantization step.
+
+    util::ManagedArray<unsigned int> m_bond_offsets; //!< CSR bond offsets of each query point.
+    util::ManagedArray<size_t> m_index_offsets;      //!< Offsets of the point indices of each query point.
+    util::ManagedArray<uint8_t> m_point_indices;     //!< Encoded point index differences.
+    util::ManagedArray<int16_t> m_vectors;           //!< Quantized bond vectors.
+    util::ManagedArray<float> m_weights;             //!< Bond weights, empty if all weights are 1.
+};
+
+//! Per-point iterator decoding the bonds of a CompressedNeighborList.
+/*! The bonds of a query point are decoded when the iterator is reset to it,
+ *  into a buffer that is reused for all query points the iterator visits.
+ */
+class CompressedNeighborListPerPointIterator : public NeighborPerPointIterator
+{
+public:
+    CompressedNeighborListPerPointIterator(const CompressedNeighborList* nlist, unsigned int point_index)
+        : NeighborPerPointIterator(point_index), m_nlist(nlist)
+    {
+        reset(point_index);
+    }
+
+    ~CompressedNeighborListPerPointIterator() override = default;
+
+    //! Reset the iterator to the bonds of another query point.
+    void reset(unsigned int point_index)
+    {
+        m_query_point_idx = point_index;
+        m_bonds.clear();
+        if (point_index < m_nlist->getNumQueryPoints())
+        {
+            m_nlist->forEachBond(point_index, [this](const NeighborBond& nb) { m_bonds.push_back(nb); });
+        }
+        m_current_index = 0;
+        m_finished = m_bonds.empty();
+    }
+
+    NeighborBond next() override
+    {
+        if (m_current_index == m_bonds.size())
+        {
+            m_finished = true;
+            return ITERATOR_TERMINATOR;
+        }
+        return m_bonds[m_current_index++];
+    }
+
+    bool end() const override
+    {
+        return m_finished;
+    }
+
+private:
+    const CompressedNeighborList* m_nlist; //!< The list being iterated over.
+    std::vector<NeighborBond> m_bonds;     //!< The decoded bonds of the current query point.
+    size_t m_current_index {0};            //!< The index of the next bond in m_bonds.
+    bool m_finished {false};               //!< Flag to indicate that the iterator has been exhausted.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // COMPRESSED_NEIGHBOR_LIST_H
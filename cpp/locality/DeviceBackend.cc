@@ -0,0 +1,73 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include "DeviceBackend.h"
+
+#ifdef FREUD_ENABLE_GPU
+#include "LinkCell.h"
+#include "NeighborComputeFunctional.h"
+#include "ThreadStorage.h"
+#endif
+
+/*! \file DeviceBackend.cc
+    \brief Interface of the optional device backend of bond histogram computes.
+*/
+
+namespace freud { namespace locality {
+
+#ifdef FREUD_ENABLE_GPU
+
+namespace {
+
+//! Device backend that runs the cell list binning on the host.
+class StubDeviceBackend : public DeviceBackend
+{
+public:
+    std::string getName() const override
+    {
+        return "stub";
+    }
+
+    void binBondDistances(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                          const vec3<float>* query_points, unsigned int n_query_points,
+                          const QueryArgs& qargs, const util::Axis& axis,
+                          unsigned int* bin_counts) const override
+    {
+        const LinkCell cell_list(box, points, n_points, qargs.r_max);
+        util::ThreadStorage<unsigned int> local_counts(axis.size());
+        loopOverNeighborChunks(&cell_list, query_points, n_query_points, qargs, nullptr, [&]() {
+            return [&axis, &counts = local_counts.local()](const NeighborBond& neighbor_bond) {
+                const size_t bin = axis.bin(neighbor_bond.getDistance());
+                if (bin < counts.size())
+                {
+                    ++counts[bin];
+                }
+            };
+        });
+        util::ManagedArray<unsigned int> counts(axis.size());
+        local_counts.reduceInto(counts);
+        for (size_t bin = 0; bin < counts.size(); ++bin)
+        {
+            bin_counts[bin] += counts[bin];
+        }
+    }
+};
+
+} // end anonymous namespace
+
+const DeviceBackend* getDeviceBackend()
+{
+    static const StubDeviceBackend backend;
+    return &backend;
+}
+
+#else
+
+const DeviceBackend* getDeviceBackend()
+{
+    return nullptr;
+}
+
+#endif
+
+}; }; // end namespace freud::locality
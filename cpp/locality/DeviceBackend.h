@@ -0,0 +1,62 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DEVICE_BACKEND_H
+#define DEVICE_BACKEND_H
+
+#include <string>
+
+#include "Box.h"
+#include "Histogram.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file DeviceBackend.h
+    \brief Interface of the optional device backend of bond histogram computes.
+*/
+
+namespace freud { namespace locality {
+
+//! Interface of a device backend that bins the bonds of ball queries.
+/*! A device backend builds a cell list of the points in device memory, finds
+ *  the bonds of a ball query with it and bins them straight into a histogram
+ *  in device memory. Only the reduced bin counts are copied back to the host,
+ *  so the bonds are never stored.
+ *
+ *  freud is built with a backend only if the CMake option FREUD_ENABLE_GPU is
+ *  set. The backend built with that option is a stub that runs the same
+ *  cell list binning on the host, so that computes can dispatch to the
+ *  interface before device kernels implement it.
+ */
+class DeviceBackend
+{
+public:
+    //! Destructor
+    virtual ~DeviceBackend() = default;
+
+    //! Get the name of the backend.
+    virtual std::string getName() const = 0;
+
+    //! Add the bond distances of a ball query to bin counts.
+    /*! \param box The simulation box.
+     *  \param points The points.
+     *  \param n_points The number of points.
+     *  \param query_points The query points.
+     *  \param n_query_points The number of query points.
+     *  \param qargs The arguments of the ball query.
+     *  \param axis The axis binning the bond distances.
+     *  \param bin_counts Host array of axis.size() bin counts to add the counts to.
+     */
+    virtual void binBondDistances(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                                  const vec3<float>* query_points, unsigned int n_query_points,
+                                  const QueryArgs& qargs, const util::Axis& axis,
+                                  unsigned int* bin_counts) const
+        = 0;
+};
+
+//! Get the device backend, or NULL if freud was built without one.
+const DeviceBackend* getDeviceBackend();
+
+}; }; // end namespace freud::locality
+
+#endif // DEVICE_BACKEND_H
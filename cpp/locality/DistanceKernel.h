@@ -0,0 +1,153 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DISTANCE_KERNEL_H
+#define DISTANCE_KERNEL_H
+
+#include "Box.h"
+#include "CPUDispatch.h"
+#include "VectorMath.h"
+
+/*! \file DistanceKernel.h
+    \brief Batched distance evaluation for the inner loops of ball queries.
+*/
+
+namespace freud { namespace locality {
+
+//! Maximum number of candidate points evaluated by one call to computeBallBatch.
+constexpr unsigned int BALL_BATCH_SIZE = 32;
+
+//! Minimum image convention for difference vectors in a periodic box.
+/*! This is a branch-free equivalent of box::Box::wrap for vectors whose
+ *  fractional coordinates are small (as is the case for vectors between a
+ *  query point and candidate neighbors), written so that loops over
+ *  structure-of-arrays data can be vectorized by the compiler.
+ */
+class MinimumImage
+{
+public:
+    //! Constructor
+    explicit MinimumImage(const box::Box& box)
+        : m_L(box.getL()), m_Linv(box.getLinv()), m_xy(box.getTiltFactorXY()), m_xz(box.getTiltFactorXZ()),
+          m_yz(box.getTiltFactorYZ()),
+          m_periodic(box.getPeriodic().x ? 1.0F : 0.0F, box.getPeriodic().y ? 1.0F : 0.0F,
+                     (box.getPeriodic().z && !box.is2D()) ? 1.0F : 0.0F)
+    {}
+
+    //! Replace the vector (x, y, z) with its minimum image
+    inline void apply(float& x, float& y, float& z) const
+    {
+        // Fractional coordinates of the vector relative to the box origin.
+        const float fz = z * m_Linv.z;
+        const float fy = (y - m_yz * z) * m_Linv.y;
+        const float fx = (x - (m_xz - m_yz * m_xy) * z - m_xy * y) * m_Linv.x;
+
+        const float nx = roundHalfUp(m_periodic.x * fx);
+        const float ny = roundHalfUp(m_periodic.y * fy);
+        const float nz = roundHalfUp(m_periodic.z * fz);
+
+        x -= nx * m_L.x + ny * m_xy * m_L.y + nz * m_xz * m_L.z;
+        y -= ny * m_L.y + nz * m_yz * m_L.z;
+        z -= nz * m_L.z;
+    }
+
+private:
+    //! Compute floor(f + 0.5) using only conversions that vectorize on all targets.
+    static inline float roundHalfUp(float f)
+    {
+        const float shifted = f + 0.5F;
+        const auto truncated = static_cast<float>(static_cast<int>(shifted));
+        return truncated - ((shifted < truncated) ? 1.0F : 0.0F);
+    }
+
+    vec3<float> m_L;        //!< Box lengths.
+    vec3<float> m_Linv;     //!< Inverse box lengths (zero in z for 2D boxes).
+    float m_xy;             //!< Tilt factor xy.
+    float m_xz;             //!< Tilt factor xz.
+    float m_yz;             //!< Tilt factor yz.
+    vec3<float> m_periodic; //!< One for periodic dimensions, zero otherwise.
+};
+
+//! Candidate neighbors of one query point that passed a ball query cut.
+struct BallBatch
+{
+    unsigned int size {0};                  //!< Number of candidates that passed the cut.
+    unsigned int pos {0};                   //!< Next candidate to be consumed.
+    unsigned int index[BALL_BATCH_SIZE];    //!< Index of each candidate within its block.
+    float r_sq[BALL_BATCH_SIZE];            //!< Squared distance of each candidate.
+    vec3<float> r_ij[BALL_BATCH_SIZE];      //!< Vector from the query point to each candidate.
+
+    //! Whether all candidates have been consumed
+    bool empty() const
+    {
+        return pos >= size;
+    }
+};
+
+//! Evaluate the distances from a query point to a block of points at once.
+/*! The positions are given as structure-of-arrays. The distances of all n
+ *  points are computed in straight-line loops that the compiler vectorizes,
+ *  and only the points with r_min_sq <= r^2 < r_max_sq are kept in the
+ *  batch, in their original order. The loops are dispatched to the
+ *  instruction set of the CPU (see util::dispatch).
+ *
+ *  \param x The x coordinates of the block.
+ *  \param y The y coordinates of the block.
+ *  \param z The z coordinates of the block.
+ *  \param n The number of points in the block, at most BALL_BATCH_SIZE.
+ *  \param query_point The query point.
+ *  \param r_min_sq The squared minimum distance.
+ *  \param r_max_sq The squared maximum distance.
+ *  \param minimum_image If not null, vectors are wrapped to their minimum image.
+ *  \param batch The batch to fill.
+ *  \returns The number of points that passed the cut.
+ */
+inline unsigned int computeBallBatch(const float* x, const float* y, const float* z, unsigned int n,
+                                     const vec3<float>& query_point, float r_min_sq, float r_max_sq,
+                                     const MinimumImage* minimum_image, BallBatch& batch)
+{
+    // The distances are compiled for each instruction set, since they are the
+    // innermost loop of every ball query.
+    return util::dispatch([&]() FREUD_KERNEL {
+        float dx[BALL_BATCH_SIZE];
+        float dy[BALL_BATCH_SIZE];
+        float dz[BALL_BATCH_SIZE];
+        float r_sq[BALL_BATCH_SIZE];
+
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            dx[k] = x[k] - query_point.x;
+            dy[k] = y[k] - query_point.y;
+            dz[k] = z[k] - query_point.z;
+        }
+        if (minimum_image != nullptr)
+        {
+            for (unsigned int k = 0; k < n; ++k)
+            {
+                minimum_image->apply(dx[k], dy[k], dz[k]);
+            }
+        }
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            r_sq[k] = dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k];
+        }
+
+        // Compact without branches: every point is written to the next free
+        // slot, which is only claimed if the point passed the cut.
+        unsigned int passed = 0;
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            batch.index[passed] = k;
+            batch.r_sq[passed] = r_sq[k];
+            batch.r_ij[passed] = vec3<float>(dx[k], dy[k], dz[k]);
+            passed += static_cast<unsigned int>(r_sq[k] < r_max_sq && r_sq[k] >= r_min_sq);
+        }
+        batch.size = passed;
+        batch.pos = 0;
+        return passed;
+    });
+}
+
+}; }; // end namespace freud::locality
+
+#endif // DISTANCE_KERNEL_H
@@ -0,0 +1,178 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "DomainDecomposition.h"
+#include "RadixSort.h"
+#include "utils.h"
+
+/*! \file DomainDecomposition.cc
+    \brief Splits a periodic box into a grid of domains with ghost layers.
+*/
+
+namespace freud { namespace locality {
+
+DomainDecomposition::DomainDecomposition(const vec3<unsigned int>& num_domains, float ghost_width)
+    : m_num_domains(num_domains), m_ghost_width(ghost_width)
+{
+    if (num_domains.x == 0 || num_domains.y == 0 || num_domains.z == 0)
+    {
+        throw std::invalid_argument("DomainDecomposition requires at least one domain along each axis.");
+    }
+    if (ghost_width < 0)
+    {
+        throw std::invalid_argument("DomainDecomposition requires a non-negative ghost width.");
+    }
+}
+
+void DomainDecomposition::validateBox(const box::Box& box) const
+{
+    if (box.is2D() && m_num_domains.z != 1)
+    {
+        throw std::invalid_argument("DomainDecomposition requires one domain along z in 2D boxes.");
+    }
+
+    // The ghosts of a domain are only searched among the points of its
+    // adjacent domains, so no ghost layer may reach beyond them.
+    const vec3<float> plane_distance = box.getNearestPlaneDistance();
+    const std::array<float, 3> widths {plane_distance.x / static_cast<float>(m_num_domains.x),
+                                       plane_distance.y / static_cast<float>(m_num_domains.y),
+                                       plane_distance.z / static_cast<float>(m_num_domains.z)};
+    const std::array<unsigned int, 3> counts {m_num_domains.x, m_num_domains.y, m_num_domains.z};
+    for (unsigned int d = 0; d < (box.is2D() ? 2 : 3); ++d)
+    {
+        if (counts[d] > 1 && m_ghost_width > widths[d])
+        {
+            throw std::invalid_argument(
+                "DomainDecomposition requires the ghost width to be at most the width of the domains.");
+        }
+    }
+}
+
+template<typename Func>
+void DomainDecomposition::forEachDomain(const vec3<float>& point, bool owner, const Func& f) const
+{
+    const vec3<float> fraction = m_box.makeFractional(point);
+    const std::array<float, 3> fractions {fraction.x, fraction.y, m_box.is2D() ? float(0.0) : fraction.z};
+    const std::array<unsigned int, 3> counts {m_num_domains.x, m_num_domains.y, m_num_domains.z};
+    const std::array<float, 3> ghost_fractions {m_ghost_fraction.x, m_ghost_fraction.y, m_ghost_fraction.z};
+
+    // The domain coordinates of the point, and the offsets of the domains
+    // whose ghost layers contain it along each axis.
+    std::array<unsigned int, 3> coords {};
+    std::array<std::array<int, 3>, 3> offsets {};
+    std::array<unsigned int, 3> num_offsets {};
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        const float scaled = (fractions[d] - std::floor(fractions[d])) * static_cast<float>(counts[d]);
+        coords[d] = std::min(static_cast<unsigned int>(scaled), counts[d] - 1);
+        const float position = scaled - static_cast<float>(coords[d]);
+        offsets[d][num_offsets[d]++] = 0;
+        if (owner || counts[d] == 1)
+        {
+            continue;
+        }
+        if (position < ghost_fractions[d])
+        {
+            offsets[d][num_offsets[d]++] = -1;
+        }
+        // With two domains along an axis both neighbors are the same domain.
+        if (position > 1 - ghost_fractions[d] && (counts[d] > 2 || num_offsets[d] == 1))
+        {
+            offsets[d][num_offsets[d]++] = 1;
+        }
+    }
+
+    for (unsigned int i = 0; i < num_offsets[0]; ++i)
+    {
+        for (unsigned int j = 0; j < num_offsets[1]; ++j)
+        {
+            for (unsigned int k = 0; k < num_offsets[2]; ++k)
+            {
+                const bool own_domain = offsets[0][i] == 0 && offsets[1][j] == 0 && offsets[2][k] == 0;
+                if (own_domain != owner)
+                {
+                    continue;
+                }
+                const auto wrap = [&](unsigned int d, int offset) {
+                    return static_cast<unsigned int>(
+                        (static_cast<int>(coords[d] + counts[d]) + offset) % static_cast<int>(counts[d]));
+                };
+                f((wrap(2, offsets[2][k]) * counts[1] + wrap(1, offsets[1][j])) * counts[0]
+                  + wrap(0, offsets[0][i]));
+            }
+        }
+    }
+}
+
+void DomainDecomposition::compute(const NeighborQuery* neighbor_query)
+{
+    const box::Box& box = neighbor_query->getBox();
+    validateBox(box);
+    m_box = box;
+    const vec3<float> plane_distance = box.getNearestPlaneDistance();
+    m_ghost_fraction = vec3<float>(m_ghost_width * static_cast<float>(m_num_domains.x) / plane_distance.x,
+                                   m_ghost_width * static_cast<float>(m_num_domains.y) / plane_distance.y,
+                                   box.is2D() ? float(0.0)
+                                              : m_ghost_width * static_cast<float>(m_num_domains.z)
+                                           / plane_distance.z);
+
+    const vec3<float>* points = neighbor_query->getPoints();
+    const unsigned int n_points = neighbor_query->getNPoints();
+    m_point_domains.prepare(n_points);
+    unsigned int* point_domains = m_point_domains.get();
+
+    // Find the owner and count the ghosts of each point, then list the
+    // ghosts of the points in order at the offsets given by the counts.
+    std::vector<size_t> ghost_offsets(static_cast<size_t>(n_points) + 1, 0);
+    util::forLoopWrapper(
+        0, n_points,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                forEachDomain(points[i], true, [&](unsigned int domain) { point_domains[i] = domain; });
+                forEachDomain(points[i], false, [&](unsigned int) { ++ghost_offsets[i + 1]; });
+            }
+        },
+        util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+    std::partial_sum(ghost_offsets.begin(), ghost_offsets.end(), ghost_offsets.begin());
+
+    const size_t num_ghosts = ghost_offsets.back();
+    std::vector<unsigned int> ghost_domains(num_ghosts);
+    std::vector<unsigned int> ghost_indices(num_ghosts);
+    util::forLoopWrapper(
+        0, n_points,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                size_t ghost = ghost_offsets[i];
+                forEachDomain(points[i], false, [&](unsigned int domain) {
+                    ghost_domains[ghost] = domain;
+                    ghost_indices[ghost++] = static_cast<unsigned int>(i);
+                });
+            }
+        },
+        util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+
+    // Group the ghosts by domain, keeping the points of each domain in order.
+    util::radixSortByKey(ghost_domains, ghost_indices);
+    m_ghost_indices.prepare(num_ghosts);
+    m_ghost_domains.prepare(num_ghosts);
+    std::copy(ghost_indices.begin(), ghost_indices.end(), m_ghost_indices.get());
+    std::copy(ghost_domains.begin(), ghost_domains.end(), m_ghost_domains.get());
+    m_ghost_counts.prepare(getNumDomains());
+    unsigned int* ghost_counts = m_ghost_counts.get();
+    std::fill(ghost_counts, ghost_counts + getNumDomains(), 0);
+    for (const unsigned int domain : ghost_domains)
+    {
+        ++ghost_counts[domain];
+    }
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,117 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DOMAIN_DECOMPOSITION_H
+#define DOMAIN_DECOMPOSITION_H
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file DomainDecomposition.h
+    \brief Splits a periodic box into a grid of domains with ghost layers.
+*/
+
+namespace freud { namespace locality {
+
+//! Assignment of points to a grid of domains of a periodic box, and of ghost points to their neighbors.
+/*! The box is split into num_domains.x * num_domains.y * num_domains.z
+ *  domains of equal size along its box vectors (num_domains.z must be 1 in
+ *  2D). Each point is owned by the domain containing it. A point is also a
+ *  ghost of every other domain whose extent along each box vector lies within
+ *  ghost_width of the point, so a domain with its ghosts holds every point
+ *  within ghost_width of the points it owns. Like PeriodicBuffer, the ghost
+ *  layers are slabs along the box vectors, so they may hold some points that
+ *  are farther than ghost_width away.
+ *
+ *  This lets processes that each hold a part of a system compute quantities
+ *  of the whole system: each process queries the points it owns against its
+ *  points and ghosts in the full periodic box, and the partial results are
+ *  summed across processes (see BondHistogramCompute::setDomainTotals). The
+ *  ghosts are listed grouped by domain, so they can be sent to the processes
+ *  holding each domain with a single all-to-all exchange.
+ *
+ *  The domains are indexed as (z * num_domains.y + y) * num_domains.x + x.
+ */
+class DomainDecomposition
+{
+public:
+    //! Constructor
+    /*! \param num_domains The number of domains along each box vector.
+     *  \param ghost_width The width of the ghost layer of each domain.
+     */
+    DomainDecomposition(const vec3<unsigned int>& num_domains, float ghost_width);
+
+    //! Assign the points of a NeighborQuery to domains and find the ghosts of each domain.
+    void compute(const NeighborQuery* neighbor_query);
+
+    //! Get the simulation box of the last computation.
+    const box::Box& getBox() const
+    {
+        return m_box;
+    }
+
+    //! Get the number of domains along each box vector.
+    vec3<unsigned int> getNumDomainsPerAxis() const
+    {
+        return m_num_domains;
+    }
+
+    //! Get the total number of domains.
+    unsigned int getNumDomains() const
+    {
+        return m_num_domains.x * m_num_domains.y * m_num_domains.z;
+    }
+
+    //! Get the width of the ghost layers.
+    float getGhostWidth() const
+    {
+        return m_ghost_width;
+    }
+
+    //! Get the domain that owns each point.
+    const util::ManagedArray<unsigned int>& getPointDomains() const
+    {
+        return m_point_domains;
+    }
+
+    //! Get the indices of the ghost points, grouped by the domain they are ghosts of.
+    const util::ManagedArray<unsigned int>& getGhostIndices() const
+    {
+        return m_ghost_indices;
+    }
+
+    //! Get the domain each ghost point belongs to.
+    const util::ManagedArray<unsigned int>& getGhostDomains() const
+    {
+        return m_ghost_domains;
+    }
+
+    //! Get the number of ghost points of each domain.
+    const util::ManagedArray<unsigned int>& getGhostCounts() const
+    {
+        return m_ghost_counts;
+    }
+
+private:
+    //! Throw if the domains of the box are narrower than the ghost layer.
+    void validateBox(const box::Box& box) const;
+
+    //! Call f(domain) for the domain owning a point (if owner) or for each domain the point is a ghost of.
+    template<typename Func> void forEachDomain(const vec3<float>& point, bool owner, const Func& f) const;
+
+    vec3<unsigned int> m_num_domains; //!< Number of domains along each box vector.
+    float m_ghost_width;              //!< Width of the ghost layers.
+    box::Box m_box;                   //!< Simulation box of the last computation.
+    vec3<float> m_ghost_fraction;     //!< Width of the ghost layers in units of the domain widths.
+
+    util::ManagedArray<unsigned int> m_point_domains; //!< Domain owning each point.
+    util::ManagedArray<unsigned int> m_ghost_indices; //!< Indices of the ghost points, grouped by domain.
+    util::ManagedArray<unsigned int> m_ghost_domains; //!< Domain of each ghost point.
+    util::ManagedArray<unsigned int> m_ghost_counts;  //!< Number of ghost points of each domain.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // DOMAIN_DECOMPOSITION_H
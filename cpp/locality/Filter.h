@@ -6,10 +6,81 @@
 
 #include "NeighborList.h"
 #include "NeighborQuery.h"
+#include "utils.h"
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <numeric>
+#include <vector>
 
 namespace freud { namespace locality {
 
+//! Lazily sorted view of the bonds of one query point, ordered by distance.
+/*! The filters visit the bonds of a query point starting from the closest one
+ *  and usually stop after a few of them, so the local bond indices are sorted
+ *  in growing batches with std::partial_sort instead of all at once. Ties in
+ *  distance are broken by point index and weight, as in compareNeighborDistance.
+ *
+ *  The order is written to caller-provided storage of segment.size()
+ *  elements. Entries before the current one are never moved again, so the
+ *  filters reuse them to record the local indices of the selected bonds.
+ */
+class DistanceSortedSegment
+{
+public:
+    DistanceSortedSegment(const NeighborListSegment& segment, unsigned int* order)
+        : m_segment(segment), m_order(order)
+    {
+        std::iota(m_order, m_order + m_segment.size(), 0);
+    }
+
+    //! The number of bonds of the query point.
+    unsigned int size() const
+    {
+        return m_segment.size();
+    }
+
+    //! Get the local index of the k-th closest bond, sorting more bonds if needed.
+    unsigned int operator[](unsigned int k)
+    {
+        if (k >= m_num_sorted)
+        {
+            sortFirst(k + 1);
+        }
+        return m_order[k];
+    }
+
+private:
+    //! Number of bonds sorted by the first batch.
+    static constexpr unsigned int INITIAL_NUM_SORTED = 16;
+
+    //! Extend the sorted prefix to at least num bonds, at least doubling it.
+    void sortFirst(unsigned int num)
+    {
+        const unsigned int num_sorted
+            = std::min(m_segment.size(), std::max({num, 2 * m_num_sorted, INITIAL_NUM_SORTED}));
+        // The unsorted bonds are all at least as far as the sorted ones, so
+        // the prefix is extended by sorting the closest of the remaining bonds.
+        std::partial_sort(m_order + m_num_sorted, m_order + num_sorted, m_order + m_segment.size(),
+                          [this](unsigned int left, unsigned int right) {
+                              if (m_segment.getDistance(left) != m_segment.getDistance(right))
+                              {
+                                  return m_segment.getDistance(left) < m_segment.getDistance(right);
+                              }
+                              if (m_segment.getPointIdx(left) != m_segment.getPointIdx(right))
+                              {
+                                  return m_segment.getPointIdx(left) < m_segment.getPointIdx(right);
+                              }
+                              return m_segment.getWeight(left) < m_segment.getWeight(right);
+                          });
+        m_num_sorted = num_sorted;
+    }
+
+    NeighborListSegment m_segment; //!< The bonds of the query point.
+    unsigned int* m_order;         //!< Local bond indices, sorted by distance up to m_num_sorted.
+    unsigned int m_num_sorted {0}; //!< Length of the sorted prefix of m_order.
+};
+
 /* Base class for all Neigborlist filtering methods in freud.
  *
  * A neighborlist filter is a class which is given a neighborlist and its goal
@@ -92,6 +163,44 @@ protected:
             std::cout << "WARNING: " << error_str.str() << std::endl;
         }
     }
+
+    /*! Fill the filtered neighborlist with the bonds selected from each segment of the unfiltered one
+     *
+     * The number of selected bonds of each query point is known before any
+     * bond is written, so each query point writes its bonds directly at its
+     * offset in the filtered neighborlist. The bonds stay sorted by query
+     * point index and, within each query point, are kept in the order in
+     * which they were selected.
+     *
+     * \param selected   Per-bond array of the unfiltered neighborlist. The first
+     *                   counts[i] entries of the segment of query point i hold
+     *                   the local indices of its selected bonds.
+     * \param counts     Number of selected bonds of each query point.
+     * \param make_bond  Callable returning the filtered NeighborBond for a
+     *                   segment and a local bond index.
+     * */
+    template<typename MakeBond>
+    void setFilteredBonds(const std::vector<unsigned int>& selected, const std::vector<unsigned int>& counts,
+                          const MakeBond& make_bond)
+    {
+        std::vector<unsigned int> offsets(counts.size() + 1, 0);
+        std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+        m_filtered_nlist = std::make_shared<NeighborList>();
+        m_filtered_nlist->setNumBonds(offsets.back(), m_unfiltered_nlist->getNumQueryPoints(),
+                                      m_unfiltered_nlist->getNumPoints());
+        util::forLoopWrapper(0, counts.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const NeighborListSegment segment = m_unfiltered_nlist->getSegment(i);
+                for (unsigned int n = 0; n < counts[i]; ++n)
+                {
+                    m_filtered_nlist->setNeighborEntry(offsets[i] + n,
+                                                       make_bond(segment, selected[segment.begin() + n]));
+                }
+            }
+        });
+    }
 };
 
 }; }; // namespace freud::locality
@@ -5,72 +5,132 @@
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
 #include "utils.h"
-#include <tbb/enumerable_thread_specific.h>
+#include <array>
+#include <cmath>
 #include <vector>
 
 namespace freud { namespace locality {
 
+namespace {
+
+//! Relative tolerance of the bound used to skip octants that cannot block a neighbor.
+/*! The bound is exact in real arithmetic, so the tolerance only has to cover
+ *  the rounding of the blocking test itself.
+ */
+constexpr float BLOCKING_BOUND_TOLERANCE = 1e-3;
+
+//! A closer potential neighbor which may block farther ones.
+struct Blocker
+{
+    vec3<float> vector;  //!< Wrapped vector from the potential neighbor to the query point.
+    float square_norm;   //!< Squared norm of the vector.
+    float distance;      //!< Bond distance of the potential neighbor.
+};
+
+//! Get the octant of a vector, with bit a set if component a is negative.
+unsigned int getOctant(const vec3<float>& v)
+{
+    return (v.x < 0 ? 1 : 0) | (v.y < 0 ? 2 : 0) | (v.z < 0 ? 4 : 0);
+}
+
+//! Get the maximum dot product of a vector with the unit vectors of an octant.
+/*! The maximum is the norm of the components of v pointing into the octant,
+ *  or zero if there are none.
+ */
+float getOctantBound(const vec3<float>& v, unsigned int octant)
+{
+    const float x = std::max((octant & 1) ? -v.x : v.x, 0.0F);
+    const float y = std::max((octant & 2) ? -v.y : v.y, 0.0F);
+    const float z = std::max((octant & 4) ? -v.z : v.z, 0.0F);
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+} // namespace
+
 void FilterRAD::compute(const NeighborQuery* nq, const vec3<float>* query_points,
                         unsigned int num_query_points, const NeighborList* nlist, const QueryArgs& qargs)
 {
     // make the unfiltered neighborlist from the arguments
     m_unfiltered_nlist = std::make_shared<NeighborList>(
         std::move(makeDefaultNlist(nq, nlist, query_points, num_query_points, qargs)));
+    m_unfiltered_nlist->updateSegmentCounts();
+    const unsigned int num_unfiltered_query_points = m_unfiltered_nlist->getNumQueryPoints();
 
-    // work with nlist sorted by distance
-    NeighborList sorted_nlist(*m_unfiltered_nlist);
-    sorted_nlist.sort(true);
+    // the bonds of each query point are sorted by distance in place, and the
+    // local indices of the neighbors that are not blocked are written over
+    // the already visited entries, so the first counts[i] entries of the
+    // segment of query point i are its selected bonds
+    std::vector<unsigned int> sorted_bonds(m_unfiltered_nlist->getNumBonds());
+    std::vector<unsigned int> counts(num_unfiltered_query_points, 0);
 
     // hold index of query point for a thread if its RAD shell isn't filled
-    std::vector<unsigned int> unfilled_qps(sorted_nlist.getNumQueryPoints(),
+    std::vector<unsigned int> unfilled_qps(num_unfiltered_query_points,
                                            std::numeric_limits<unsigned int>::max());
 
     const auto& points = nq->getPoints();
     const auto& box = nq->getBox();
-    const auto& sorted_neighbors = sorted_nlist.getNeighbors();
-    const auto& sorted_dist = sorted_nlist.getDistances();
-    const auto& sorted_weights = sorted_nlist.getWeights();
-    const auto& sorted_counts = sorted_nlist.getCounts();
-
-    using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
-    BondVector filtered_bonds;
 
     // parallelize over query_point_index
-    util::forLoopWrapper(0, sorted_nlist.getNumQueryPoints(), [&](size_t begin, size_t end) {
-        // grab thread-local vector
-        BondVector::reference local_bonds(filtered_bonds.local());
+    util::forLoopWrapper(0, num_unfiltered_query_points, [&](size_t begin, size_t end) {
+        // closer potential neighbors of the current query point, binned by the
+        // octant of their vectors, and the smallest product of the norm and
+        // the distance in each octant
+        std::array<std::vector<Blocker>, 8> blockers;
+        std::array<float, 8> min_blocker_scales {};
+
         for (auto i = begin; i < end; i++)
         {
-            const auto num_unfiltered_neighbors = sorted_counts(i);
-            const auto first_idx = sorted_nlist.find_first_index(i);
+            const NeighborListSegment segment = m_unfiltered_nlist->getSegment(i);
+            DistanceSortedSegment sorted(segment, sorted_bonds.data() + segment.begin());
+            const auto num_unfiltered_neighbors = sorted.size();
+            unsigned int num_neighbors = 0;
             bool good_neighbor = true;
+            for (auto& octant_blockers : blockers)
+            {
+                octant_blockers.clear();
+            }
 
             // loop over each potential neighbor particle j
             for (unsigned int j = 0; j < num_unfiltered_neighbors; j++)
             {
-                const auto first_neighbor_idx = sorted_neighbors(first_idx + j, 1);
-                const auto v1 = box.wrap(query_points[i] - points[first_neighbor_idx]);
+                const auto k_j = sorted[j];
+                const auto v1 = box.wrap(query_points[i] - points[segment.getPointIdx(k_j)]);
+                const auto v1_square_norm = dot(v1, v1);
+                const auto distance = segment.getDistance(k_j);
                 good_neighbor = true;
 
-                // loop over particles which may be blocking the neighbor j
-                for (unsigned int k = 0; k < j; k++)
+                // A closer particle k blocks j if
+                // |v2|^2 d_j d_k < (v1 . v2) |v1|^2. Since v1 . v2 is at most
+                // |v2| times the bound of v1 on the octant of v2, no particle
+                // of an octant can block j if that bound times |v1|^2 is
+                // smaller than |v2| d_k d_j for all of them.
+                for (unsigned int octant = 0; octant < 8 && good_neighbor; ++octant)
                 {
-                    const auto second_neighbor_idx = sorted_neighbors(first_idx + k, 1);
-                    const auto v2 = box.wrap(query_points[i] - points[second_neighbor_idx]);
+                    if (blockers[octant].empty()
+                        || getOctantBound(v1, octant) * v1_square_norm * (1 + BLOCKING_BOUND_TOLERANCE)
+                            < min_blocker_scales[octant] * distance)
+                    {
+                        continue;
+                    }
 
-                    // check if k blocks j
-                    if ((dot(v2, v2) * sorted_dist(first_idx + j) * sorted_dist(first_idx + k))
-                        < (dot(v1, v2) * dot(v1, v1)))
+                    // loop over particles which may be blocking the neighbor j
+                    for (const auto& blocker : blockers[octant])
                     {
-                        good_neighbor = false;
-                        break;
+                        // check if k blocks j
+                        if ((blocker.square_norm * distance * blocker.distance)
+                            < (dot(v1, blocker.vector) * v1_square_norm))
+                        {
+                            good_neighbor = false;
+                            break;
+                        }
                     }
                 }
 
                 // if no k blocks j, add a bond from i to j
                 if (good_neighbor)
                 {
-                    local_bonds.emplace_back(i, first_neighbor_idx, sorted_dist(first_idx + j), 1, v1);
+                    sorted_bonds[segment.begin() + num_neighbors] = k_j;
+                    ++num_neighbors;
                 }
                 else if (m_terminate_after_blocked)
                 {
@@ -78,7 +138,17 @@ void FilterRAD::compute(const NeighborQuery* nq, const vec3<float>* query_points
                     // stop looking for more neighbors
                     break;
                 }
+
+                // j may block the farther potential neighbors
+                const unsigned int octant = getOctant(v1);
+                const float scale = std::sqrt(v1_square_norm) * distance;
+                if (blockers[octant].empty() || scale < min_blocker_scales[octant])
+                {
+                    min_blocker_scales[octant] = scale;
+                }
+                blockers[octant].push_back({v1, v1_square_norm, distance});
             }
+            counts[i] = num_neighbors;
 
             // if we have searched over all potential neighbors j and still have
             // not found one that is blocked, the neighbor shell may be incomplete.
@@ -97,14 +167,12 @@ void FilterRAD::compute(const NeighborQuery* nq, const vec3<float>* query_points
     // print warning/exception about query point indices with unfilled neighbor shells
     Filter::warnAboutUnfilledNeighborShells(unfilled_qps);
 
-    // combine thread-local arrays
-    tbb::flattened2d<BondVector> flat_filtered_bonds = tbb::flatten2d(filtered_bonds);
-    std::vector<NeighborBond> rad_bonds(flat_filtered_bonds.begin(), flat_filtered_bonds.end());
-
-    // sort final bonds array by distance
-    tbb::parallel_sort(rad_bonds.begin(), rad_bonds.end(), compareNeighborDistance);
-
-    m_filtered_nlist = std::make_shared<NeighborList>(rad_bonds);
+    // write the selected bonds, which are sorted by distance for each query point
+    setFilteredBonds(sorted_bonds, counts, [&](const NeighborListSegment& segment, unsigned int k) {
+        const auto point_idx = segment.getPointIdx(k);
+        const auto v = box.wrap(query_points[segment.getQueryPointIdx()] - points[point_idx]);
+        return NeighborBond(segment.getQueryPointIdx(), point_idx, segment.getDistance(k), 1, v);
+    });
 };
 
 }; }; // namespace freud::locality
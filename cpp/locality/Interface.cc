@@ -0,0 +1,194 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AABBQuery.h"
+#include "Interface.h"
+#include "NeighborComputeFunctional.h"
+#include "utils.h"
+
+/*! \file Interface.cc
+    \brief Finds the points at the interface between two sets of points.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+
+//! A set of indices that threads can insert into concurrently.
+class ConcurrentBitmap
+{
+public:
+    //! Constructor
+    /*! \param size One more than the largest index of the set.
+     */
+    explicit ConcurrentBitmap(unsigned int size)
+        : m_num_words((static_cast<size_t>(size) + WORD_BITS - 1) / WORD_BITS),
+          m_words(new std::atomic<uint64_t>[m_num_words]())
+    {}
+
+    //! Insert an index into the set.
+    void insert(unsigned int i)
+    {
+        std::atomic<uint64_t>& word = m_words[i / WORD_BITS];
+        const uint64_t bit = uint64_t(1) << (i % WORD_BITS);
+        // Most indices of the bonds of a region are already in the set, and
+        // reading the word does not take ownership of its cache line.
+        if ((word.load(std::memory_order_relaxed) & bit) == 0)
+        {
+            word.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+
+    //! Write the indices of the set in increasing order.
+    void getIndices(util::ManagedArray<unsigned int>& indices) const
+    {
+        size_t count = 0;
+        for (size_t w = 0; w < m_num_words; ++w)
+        {
+            count += std::bitset<WORD_BITS>(m_words[w].load(std::memory_order_relaxed)).count();
+        }
+        indices.prepare(count);
+        size_t k = 0;
+        for (size_t w = 0; w < m_num_words; ++w)
+        {
+            const uint64_t word = m_words[w].load(std::memory_order_relaxed);
+            for (unsigned int b = 0; word != 0 && b < WORD_BITS; ++b)
+            {
+                if (((word >> b) & 1) != 0)
+                {
+                    indices[k++] = static_cast<unsigned int>(w * WORD_BITS + b);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr unsigned int WORD_BITS = 64; //!< Number of indices of each word.
+
+    size_t m_num_words;                               //!< Number of words of the bitmap.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_words; //!< Bit i % 64 of word i / 64 marks index i.
+};
+
+//! Mark the points and query points of the bonds of a ball query.
+/*! The query points first look for a single neighbor. Only the neighbors of
+ *  the query points that found one can be at the interface, so only those
+ *  query points look for all of their neighbors.
+ */
+void markBallBonds(const NeighborQuery& nq, const vec3<float>* query_points, unsigned int n_query_points,
+                   const QueryArgs& qargs, ConcurrentBitmap& points, ConcurrentBitmap& marked_query_points)
+{
+    std::shared_ptr<NeighborQueryIterator> iter = nq.query(query_points, n_query_points, qargs);
+    forLoopOverQuery(
+        *iter, n_query_points,
+        [&](size_t begin, size_t end) {
+            std::shared_ptr<NeighborQueryPerPointIterator> it;
+            for (size_t k = begin; k != end; ++k)
+            {
+                const unsigned int i = iter->getQueryPointIdx(k);
+                iter->query(i, it);
+                it->next();
+                if (!it->end())
+                {
+                    marked_query_points.insert(i);
+                }
+            }
+        },
+        util::LoopSchedule(), true);
+
+    util::ManagedArray<unsigned int> interface_query_points;
+    marked_query_points.getIndices(interface_query_points);
+    util::forLoopWrapper(0, interface_query_points.size(), [&](size_t begin, size_t end) {
+        std::shared_ptr<NeighborQueryPerPointIterator> it;
+        for (size_t k = begin; k != end; ++k)
+        {
+            iter->query(interface_query_points[k], it);
+            for (NeighborBond nb = it->next(); !it->end(); nb = it->next())
+            {
+                points.insert(nb.getPointIdx());
+            }
+        }
+    });
+}
+
+}; // end anonymous namespace
+
+void Interface::compute(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                        const NeighborList* nlist, QueryArgs qargs)
+{
+    const unsigned int n_points = nq->getNPoints();
+    ConcurrentBitmap points(n_points);
+    ConcurrentBitmap marked_query_points(n_query_points);
+
+    if (nlist != nullptr)
+    {
+        nlist->validate(n_query_points, n_points);
+        const unsigned int* neighbors = nlist->getNeighbors().get();
+        util::forLoopWrapper(
+            0, nlist->getNumBonds(),
+            [&](size_t begin, size_t end) {
+                for (size_t bond = begin; bond < end; ++bond)
+                {
+                    marked_query_points.insert(neighbors[2 * bond]);
+                    points.insert(neighbors[2 * bond + 1]);
+                }
+            },
+            util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+    }
+    else
+    {
+        std::shared_ptr<NeighborQueryIterator> iter = nq->query(query_points, n_query_points, qargs);
+        const QueryArgs& validated_qargs = iter->getQueryArgs();
+        if (validated_qargs.mode == QueryType::ball && !validated_qargs.half_list)
+        {
+            // Ball queries find the same pairs from either set, so the
+            // queries run from the smaller set. The query points are wrapped
+            // into the box to build a tree of them.
+            if (n_points < n_query_points)
+            {
+                const box::Box& box = nq->getBox();
+                std::vector<vec3<float>> wrapped_query_points(n_query_points);
+                box.wrap(query_points, n_query_points, wrapped_query_points.data());
+                const AABBQuery query_point_tree(box, wrapped_query_points.data(), n_query_points);
+                markBallBonds(query_point_tree, nq->getPoints(), n_points, validated_qargs,
+                              marked_query_points, points);
+            }
+            else
+            {
+                markBallBonds(*nq, query_points, n_query_points, validated_qargs, points,
+                              marked_query_points);
+            }
+        }
+        else
+        {
+            // Neighbors found by number or half of the pairs are not
+            // symmetric, so every bond of every query point is visited.
+            forLoopOverQuery(
+                *iter, n_query_points,
+                [&](size_t begin, size_t end) {
+                    std::shared_ptr<NeighborQueryPerPointIterator> it;
+                    for (size_t k = begin; k != end; ++k)
+                    {
+                        const unsigned int i = iter->getQueryPointIdx(k);
+                        iter->query(i, it);
+                        for (NeighborBond nb = it->next(); !it->end(); nb = it->next())
+                        {
+                            marked_query_points.insert(i);
+                            points.insert(nb.getPointIdx());
+                        }
+                    }
+                },
+                util::LoopSchedule(), true);
+        }
+    }
+
+    points.getIndices(m_point_ids);
+    marked_query_points.getIndices(m_query_point_ids);
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,60 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef INTERFACE_H
+#define INTERFACE_H
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file Interface.h
+    \brief Finds the points at the interface between two sets of points.
+*/
+
+namespace freud { namespace locality {
+
+//! Finds the points and query points at the interface between two sets of points.
+/*! A point and a query point are at the interface if they are bonded. The
+ *  bonds are only used to mark the bonded points in bitmaps, so no neighbor
+ *  list is built. Ball queries find the same pairs in both directions, so
+ *  they are run from the smaller set: every point of the smaller set stops
+ *  at its first neighbor, and only the points of the smaller set at the
+ *  interface look for all of their neighbors.
+ */
+class Interface
+{
+public:
+    //! Constructor
+    Interface() = default;
+
+    //! Find the points and query points with at least one bond.
+    /*! \param nq The NeighborQuery of the points.
+     *  \param query_points The query points.
+     *  \param n_query_points The number of query points.
+     *  \param nlist The bonds to use, or NULL to find them with qargs.
+     *  \param qargs The query arguments used to find the bonds.
+     */
+    void compute(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                 const NeighborList* nlist, QueryArgs qargs);
+
+    //! Get the sorted indices of the points at the interface.
+    const util::ManagedArray<unsigned int>& getPointIds() const
+    {
+        return m_point_ids;
+    }
+
+    //! Get the sorted indices of the query points at the interface.
+    const util::ManagedArray<unsigned int>& getQueryPointIds() const
+    {
+        return m_query_point_ids;
+    }
+
+private:
+    util::ManagedArray<unsigned int> m_point_ids;       //!< Points at the interface
+    util::ManagedArray<unsigned int> m_query_point_ids; //!< Query points at the interface
+};
+
+}; }; // end namespace freud::locality
+
+#endif // INTERFACE_H
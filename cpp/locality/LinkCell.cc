@@ -3,9 +3,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "LinkCell.h"
+#include "utils.h"
 
 /*! \file LinkCell.cc
     \brief Build a cell list from a set of points.
@@ -13,35 +18,22 @@
 
 namespace freud { namespace locality {
 
-/********************
- * IteratorLinkCell *
- ********************/
-void IteratorLinkCell::copy(const IteratorLinkCell& rhs)
-{
-    m_cell_list = rhs.m_cell_list;
-    m_Np = rhs.m_Np;
-    m_Nc = rhs.m_Nc;
-    m_cur_idx = rhs.m_cur_idx;
-    m_cell = rhs.m_cell;
-}
+namespace {
 
-bool IteratorLinkCell::atEnd() const
+//! Interleave the bits of three 10-bit subcell coordinates.
+uint32_t mortonCode(unsigned int x, unsigned int y, unsigned int z)
 {
-    return (m_cur_idx == LINK_CELL_TERMINATOR);
+    const auto spread = [](uint32_t v) {
+        v = (v | (v << 16)) & 0x030000FF;
+        v = (v | (v << 8)) & 0x0300F00F;
+        v = (v | (v << 4)) & 0x030C30C3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1) | (spread(z) << 2);
 }
 
-unsigned int IteratorLinkCell::next()
-{
-    m_cur_idx = m_cell_list[m_cur_idx];
-    return m_cur_idx;
-}
-
-unsigned int IteratorLinkCell::begin()
-{
-    m_cur_idx = m_Np + m_cell;
-    m_cur_idx = m_cell_list[m_cur_idx];
-    return m_cur_idx;
-}
+} // namespace
 
 /*********************
  * IteratorCellShell *
@@ -227,7 +219,30 @@ LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int
         m_cell_width = std::cbrtf(box.getVolume() / static_cast<float>(desired_num_cells));
     }
 
-    m_celldim = computeDimensions(box, m_cell_width);
+    setupCells(box);
+    computeCellList(points, n_points);
+    computeCellStencil();
+}
+
+void LinkCell::updatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+{
+    validatePoints(box, points, n_points);
+    const bool same_box = (box == m_box);
+    if (!same_box)
+    {
+        setupCells(box);
+    }
+    setPoints(box, points, n_points);
+    if (!same_box)
+    {
+        computeCellStencil();
+    }
+    computeCellList(points, n_points);
+}
+
+void LinkCell::setupCells(const box::Box& box)
+{
+    vec3<unsigned int> celldim = computeDimensions(box, m_cell_width);
 
     // Check if box is too small!
     vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
@@ -239,16 +254,16 @@ LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int
     // Only 1 cell deep in 2D
     if (box.is2D())
     {
-        m_celldim.z = 1;
+        celldim.z = 1;
     }
 
-    m_size = m_celldim.x * m_celldim.y * m_celldim.z;
-    if (m_size < 1)
+    const unsigned int size = celldim.x * celldim.y * celldim.z;
+    if (size < 1)
     {
         throw std::runtime_error("At least one cell must be present.");
     }
-
-    computeCellList(points, n_points);
+    m_celldim = celldim;
+    m_size = size;
 }
 
 unsigned int LinkCell::getCellIndex(const vec3<int> cellCoord) const
@@ -308,43 +323,260 @@ vec3<unsigned int> LinkCell::computeDimensions(const box::Box& box, float cell_w
 void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
 {
     // determine the number of cells and allocate memory
-    unsigned int Nc = getNumCells();
-    m_cell_list.prepare(n_points + Nc);
+    const unsigned int Nc = getNumCells();
+    // Release the spatial order, which shares the data of m_cell_points, so
+    // that the cell list is rebuilt in the memory of the previous one.
+    m_spatial_order = util::ManagedArray<unsigned int>();
+    m_cell_offsets.prepare(Nc + 1);
+    m_cell_points.prepare(n_points);
+    m_cell_positions.prepare({3, n_points});
     m_n_points = n_points;
 
-    // initialize memory
-    for (unsigned int cell = 0; cell < Nc; cell++)
-    {
-        m_cell_list[n_points + cell] = LINK_CELL_TERMINATOR;
-    }
+    // This is a parallel counting sort. The points are split into one
+    // contiguous chunk per thread and each chunk counts its points per cell.
+    // Within a cell, the points of earlier chunks are placed first, so every
+    // cell ends up sorted by point index without any atomics or sorting
+    // (dense cells are then reordered by sortDenseCells).
+    const size_t num_chunks = std::max<size_t>(
+        std::min<size_t>(n_points, std::max(parallel::maxConcurrency(), 1)), 1);
+    const size_t chunk_size = (n_points + num_chunks - 1) / num_chunks;
+    std::vector<unsigned int>& point_cells = m_point_cells;
+    std::vector<unsigned int>& chunk_cursors = m_chunk_cursors;
+    point_cells.resize(n_points);
+    chunk_cursors.assign(num_chunks * Nc, 0);
+    util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk)
+        {
+            unsigned int* counts = chunk_cursors.data() + chunk * Nc;
+            const size_t chunk_end = std::min<size_t>((chunk + 1) * chunk_size, n_points);
+            for (size_t i = chunk * chunk_size; i < chunk_end; ++i)
+            {
+                point_cells[i] = getCell(points[i]);
+                ++counts[point_cells[i]];
+            }
+        }
+    });
 
-    // Generate the cell list.
-    for (unsigned int i = n_points - 1; i != static_cast<unsigned int>(-1); --i)
+    // Convert the counts to the offset of each cell and of each chunk within it.
+    unsigned int* cell_offsets = m_cell_offsets.get();
+    util::forLoopWrapper(0, Nc, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            unsigned int count = 0;
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+            {
+                count += chunk_cursors[chunk * Nc + cell];
+            }
+            cell_offsets[cell + 1] = count;
+        }
+    });
+    cell_offsets[0] = 0;
+    for (unsigned int cell = 0; cell < Nc; ++cell)
     {
-        unsigned int cell = getCell(points[i]);
-        m_cell_list[i] = m_cell_list[n_points + cell];
-        m_cell_list[n_points + cell] = i;
+        cell_offsets[cell + 1] += cell_offsets[cell];
     }
+    util::forLoopWrapper(0, Nc, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            unsigned int offset = cell_offsets[cell];
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+            {
+                const unsigned int count = chunk_cursors[chunk * Nc + cell];
+                chunk_cursors[chunk * Nc + cell] = offset;
+                offset += count;
+            }
+        }
+    });
+
+    // Scatter the points into their cells.
+    unsigned int* cell_points = m_cell_points.get();
+    util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk)
+        {
+            unsigned int* cursors = chunk_cursors.data() + chunk * Nc;
+            const size_t chunk_end = std::min<size_t>((chunk + 1) * chunk_size, n_points);
+            for (size_t i = chunk * chunk_size; i < chunk_end; ++i)
+            {
+                cell_points[cursors[point_cells[i]]++] = i;
+            }
+        }
+    });
+
+    sortDenseCells(points);
+
+    // Gather the coordinates in the same order, one array per dimension.
+    float* cell_x = m_cell_positions.get();
+    float* cell_y = cell_x + n_points;
+    float* cell_z = cell_y + n_points;
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            const vec3<float>& point = points[cell_points[k]];
+            cell_x[k] = point.x;
+            cell_y[k] = point.y;
+            cell_z[k] = point.z;
+        }
+    });
+    computeBlockBounds();
+    // The cell order is a spatially coherent order of the points.
+    m_spatial_order = m_cell_points;
+}
+
+void LinkCell::sortDenseCells(const vec3<float>* points)
+{
+    const unsigned int* cell_offsets = m_cell_offsets.get();
+    unsigned int* cell_points = m_cell_points.get();
+    const vec3<float> celldim(static_cast<float>(m_celldim.x), static_cast<float>(m_celldim.y),
+                              static_cast<float>(m_celldim.z));
+    const float dimensions = m_box.is2D() ? 2 : 3;
+
+    util::forLoopWrapper(0, getNumCells(), [&](size_t begin, size_t end) {
+        std::vector<std::pair<uint32_t, unsigned int>> keys;
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            const unsigned int count = cell_offsets[cell + 1] - cell_offsets[cell];
+            if (count <= BALL_BATCH_SIZE)
+            {
+                continue;
+            }
+
+            // Subcells of about BALL_BATCH_SIZE points, visited in Morton
+            // order so that consecutive blocks of points are compact.
+            const auto subdivisions = static_cast<unsigned int>(std::min(
+                std::ceil(std::pow(static_cast<float>(count) / BALL_BATCH_SIZE, 1 / dimensions)),
+                static_cast<float>(LINK_CELL_MAX_SUBDIVISIONS)));
+            const auto subcell = [subdivisions](float alpha, float dim) {
+                const float fraction = alpha * dim - std::floor(alpha * dim);
+                return std::min(static_cast<unsigned int>(fraction * static_cast<float>(subdivisions)),
+                                subdivisions - 1);
+            };
+            keys.resize(count);
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                const unsigned int i = cell_points[cell_offsets[cell] + k];
+                const vec3<float> alpha = m_box.makeFractional(points[i]);
+                keys[k] = {mortonCode(subcell(alpha.x, celldim.x), subcell(alpha.y, celldim.y),
+                                      m_box.is2D() ? 0 : subcell(alpha.z, celldim.z)),
+                           i};
+            }
+            std::sort(keys.begin(), keys.end());
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                cell_points[cell_offsets[cell] + k] = keys[k].second;
+            }
+        }
+    });
+}
+
+void LinkCell::computeBlockBounds()
+{
+    // The bounds are only used to skip blocks whose minimum image distance
+    // along each axis exceeds the ball, which bounds the distance of all
+    // points of the block only in orthorhombic boxes.
+    if (m_box.getTiltFactorXY() != 0 || m_box.getTiltFactorXZ() != 0 || m_box.getTiltFactorYZ() != 0)
+    {
+        m_cell_block_offsets.clear();
+        m_block_bounds.clear();
+        return;
+    }
+
+    const unsigned int Nc = getNumCells();
+    const unsigned int* cell_offsets = m_cell_offsets.get();
+    m_cell_block_offsets.resize(Nc + 1);
+    m_cell_block_offsets[0] = 0;
+    for (unsigned int cell = 0; cell < Nc; ++cell)
+    {
+        const unsigned int count = cell_offsets[cell + 1] - cell_offsets[cell];
+        m_cell_block_offsets[cell + 1]
+            = m_cell_block_offsets[cell] + (count + BALL_BATCH_SIZE - 1) / BALL_BATCH_SIZE;
+    }
+    m_block_bounds.resize(LINK_CELL_BLOCK_BOUNDS_SIZE * size_t(m_cell_block_offsets[Nc]));
+
+    // The half extents are padded to absorb the rounding of the minimum
+    // image vectors, so that blocks are never skipped wrongly.
+    const vec3<float> L = m_box.getL();
+    const float padding = LINK_CELL_BOUNDS_PADDING * std::max({L.x, L.y, L.z});
+    const float* cell_coordinates[3] = {m_cell_positions.get(), m_cell_positions.get() + m_n_points,
+                                        m_cell_positions.get() + 2 * size_t(m_n_points)};
+    util::forLoopWrapper(0, Nc, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            float* bounds
+                = m_block_bounds.data() + LINK_CELL_BLOCK_BOUNDS_SIZE * size_t(m_cell_block_offsets[cell]);
+            for (unsigned int first = cell_offsets[cell]; first < cell_offsets[cell + 1];
+                 first += BALL_BATCH_SIZE, bounds += LINK_CELL_BLOCK_BOUNDS_SIZE)
+            {
+                const unsigned int last = std::min(first + BALL_BATCH_SIZE, cell_offsets[cell + 1]);
+                for (unsigned int dim = 0; dim < 3; ++dim)
+                {
+                    const auto range = std::minmax_element(cell_coordinates[dim] + first,
+                                                           cell_coordinates[dim] + last);
+                    const float center = (*range.first + *range.second) / 2;
+                    bounds[dim] = center;
+                    bounds[3 + dim]
+                        = std::max(*range.second - center, center - *range.first) + padding;
+                }
+            }
+        }
+    });
 }
 
 vec3<unsigned int> LinkCell::indexToCoord(unsigned int x) const
 {
-    std::vector<size_t> coord
-        = util::ManagedArray<unsigned int>::getMultiIndex({m_celldim.x, m_celldim.y, m_celldim.z}, x);
-    // For backwards compatibility with the Index1D layout, the indices and
-    // the dimensions are passed in reverse to the indexer. Changing this would
-    // also require updating the logic in IteratorCellShell.
-    return vec3<unsigned int>(coord[2], coord[1], coord[0]);
+    // For backwards compatibility with the Index1D layout, x varies fastest.
+    // Changing this would also require updating the logic in IteratorCellShell.
+    return vec3<unsigned int>(x % m_celldim.x, (x / m_celldim.x) % m_celldim.y,
+                              x / (m_celldim.x * m_celldim.y));
 }
 
 unsigned int LinkCell::coordToIndex(unsigned int x, unsigned int y, unsigned int z) const
 {
-    // For backwards compatibility with the Index1D layout, the indices and
-    // the dimensions are passed in reverse to the indexer. Changing this would
-    // also require updating the logic in IteratorCellShell.
-    return util::ManagedArray<unsigned int>::getIndex(
-        {m_celldim.z, m_celldim.y, m_celldim.x},
-        {static_cast<unsigned int>(z), static_cast<unsigned int>(y), static_cast<unsigned int>(x)});
+    // For backwards compatibility with the Index1D layout, x varies fastest.
+    // Changing this would also require updating the logic in IteratorCellShell.
+    return (z * m_celldim.y + y) * m_celldim.x + x;
+}
+
+float LinkCell::estimateDensity(const vec3<float>& point) const
+{
+    if (m_size == 0)
+    {
+        return NeighborQuery::estimateDensity(point);
+    }
+
+    // Single cells hold too few points in dilute regions to estimate the
+    // density, so the points of all cells in the stencil are counted.
+    const vec3<unsigned int> cell(getCellCoord(point));
+    const vec3<int> query_cell(cell.x, cell.y, cell.z);
+    const unsigned int* offsets = m_cell_offsets.get();
+    unsigned int num_points = 0;
+    for (const vec3<int>& offset : m_cell_stencil)
+    {
+        const unsigned int neighbor_cell = getCellIndex(query_cell + offset);
+        num_points += offsets[neighbor_cell + 1] - offsets[neighbor_cell];
+    }
+    return static_cast<float>(num_points) * static_cast<float>(m_size)
+        / (static_cast<float>(m_cell_stencil.size()) * m_box.getVolume());
+}
+
+float LinkCell::estimateQueryCost(const vec3<float>& query_point, const QueryArgs& args) const
+{
+    if (args.mode != QueryType::nearest || m_size == 0)
+    {
+        return NeighborQuery::estimateQueryCost(query_point, args);
+    }
+
+    // The search ends after the first shell of cells farther than the
+    // distance r_k within which num_neighbors points are expected.
+    const float density = estimateDensity(query_point);
+    const float num_neighbors = static_cast<float>(args.num_neighbors);
+    const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
+    const float r_k = density > 0 ? std::pow(num_neighbors / (density * ballVolume(1)), 1 / dimensions)
+                                  : std::numeric_limits<float>::infinity();
+    const float shell_width = float(2.0) * std::floor(std::min(r_k / m_cell_width, float(m_size))) + 3;
+    const float num_cells = std::min(std::pow(shell_width, dimensions), static_cast<float>(m_size));
+    const float num_points = std::min(density * num_cells * std::pow(m_cell_width, dimensions),
+                                      static_cast<float>(m_n_points));
+    return QUERY_FIXED_COST + num_neighbors + num_points * num_cells / 2;
 }
 
 vec3<unsigned int> LinkCell::getCellCoord(const vec3<float>& p) const
@@ -360,114 +592,44 @@ vec3<unsigned int> LinkCell::getCellCoord(const vec3<float>& p) const
     return c;
 }
 
-const std::vector<unsigned int>& LinkCell::getCellNeighbors(unsigned int cell) const
+void LinkCell::computeCellStencil()
 {
-    // check if the list of neighbors has been already computed
-    // return the list if it has
-    // otherwise, compute it and return
-    CellNeighbors::const_accessor a;
-    if (m_cell_neighbors.find(a, cell))
-    {
-        return a->second;
+    // The neighbor cells of a cell are the 27 (9 in 2D) cells adjacent to
+    // it, except that offsets wrapping onto the same cell in small cell lists
+    // are only included once. The stencil is the same for every cell.
+    m_cell_stencil.clear();
+    const int dz = m_box.is2D() ? 0 : 1;
+    for (int k = -dz; k <= dz; ++k)
+    {
+        for (int j = -1; j <= 1; ++j)
+        {
+            for (int i = -1; i <= 1; ++i)
+            {
+                const vec3<int> offset(i, j, k);
+                if (isUniqueCellOffset(offset))
+                {
+                    m_cell_stencil.push_back(offset);
+                }
+            }
+        }
     }
-    return computeCellNeighbors(cell);
 }
 
-const std::vector<unsigned int>& LinkCell::computeCellNeighbors(unsigned int cur_cell) const
+std::vector<unsigned int> LinkCell::getCellNeighbors(unsigned int cell) const
 {
-    std::vector<unsigned int> neighbor_cells;
-    vec3<unsigned int> l_idx = indexToCoord(cur_cell);
-    const int i = static_cast<int>(l_idx.x);
-    const int j = static_cast<int>(l_idx.y);
-    const int k = static_cast<int>(l_idx.z);
-
-    // loop over the neighbor cells
-    int starti;
-    int startj;
-    int startk;
-    int endi;
-    int endj;
-    int endk;
-    if (m_celldim.x < 3)
-    {
-        starti = i;
-    }
-    else
-    {
-        starti = i - 1;
-    }
-    if (m_celldim.y < 3)
-    {
-        startj = j;
-    }
-    else
-    {
-        startj = j - 1;
-    }
-    if (m_celldim.z < 3)
-    {
-        startk = k;
-    }
-    else
-    {
-        startk = k - 1;
-    }
+    const vec3<unsigned int> l_idx = indexToCoord(cell);
+    const vec3<int> cell_coord(l_idx.x, l_idx.y, l_idx.z);
 
-    if (m_celldim.x < 2)
-    {
-        endi = i;
-    }
-    else
-    {
-        endi = i + 1;
-    }
-    if (m_celldim.y < 2)
-    {
-        endj = j;
-    }
-    else
-    {
-        endj = j + 1;
-    }
-    if (m_celldim.z < 2)
-    {
-        endk = k;
-    }
-    else
-    {
-        endk = k + 1;
-    }
-    if (m_box.is2D())
-    {
-        startk = endk = k;
-    }
-
-    for (int neighk = startk; neighk <= endk; neighk++)
+    std::vector<unsigned int> neighbor_cells;
+    neighbor_cells.reserve(m_cell_stencil.size());
+    for (const vec3<int>& offset : m_cell_stencil)
     {
-        for (int neighj = startj; neighj <= endj; neighj++)
-        {
-            for (int neighi = starti; neighi <= endi; neighi++)
-            {
-                // wrap back into the box
-                unsigned int wrapi = (m_celldim.x + neighi) % m_celldim.x;
-                unsigned int wrapj = (m_celldim.y + neighj) % m_celldim.y;
-                unsigned int wrapk = (m_celldim.z + neighk) % m_celldim.z;
-
-                unsigned int neigh_cell = coordToIndex(wrapi, wrapj, wrapk);
-                // add to the list
-                neighbor_cells.push_back(neigh_cell);
-            }
-        }
+        neighbor_cells.push_back(getCellIndex(cell_coord + offset));
     }
 
     // sort the list
     std::sort(neighbor_cells.begin(), neighbor_cells.end());
-
-    // add the vector of neighbor cells to the hash table
-    CellNeighbors::accessor a;
-    m_cell_neighbors.insert(a, cur_cell);
-    a->second = neighbor_cells;
-    return a->second;
+    return neighbor_cells;
 }
 
 std::shared_ptr<NeighborQueryPerPointIterator>
@@ -476,8 +638,10 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
     this->validateQueryArgs(args);
     if (args.mode == QueryType::ball)
     {
-        return std::make_shared<LinkCellQueryBallIterator>(this, query_point, query_point_idx, args.r_max,
-                                                           args.r_min, args.exclude_ii);
+        auto iter = std::make_shared<LinkCellQueryBallIterator>(this, query_point, query_point_idx,
+                                                                args.r_max, args.r_min, args.exclude_ii);
+        iter->setHalfList(args.half_list);
+        return iter;
     }
     if (args.mode == QueryType::nearest)
     {
@@ -492,32 +656,41 @@ NeighborBond LinkCellQueryBallIterator::next()
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
 
-    vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
-
     // Loop over cell list neighbor shells relative to this point's cell.
     while (true)
     {
-        // Iterate over the particles in that cell. Using a local counter
-        // variable is safe, because the IteratorLinkCell object is keeping
-        // track between calls to next.
-        for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
+        // Return the points of the current block that are within the ball.
+        while (!m_batch.empty())
         {
-            // Skip ii matches immediately if requested.
-            if (m_exclude_ii && m_query_point_idx == j)
+            const unsigned int k = m_batch.pos++;
+            const unsigned int j = m_batch_points[m_batch.index[k]];
+
+            // Skip ii matches and mirrored bonds if requested.
+            if (isExcluded(j))
             {
                 continue;
             }
+            return NeighborBond(m_query_point_idx, j, std::sqrt(m_batch.r_sq[k]), 1, m_batch.r_ij[k]);
+        }
 
-            const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-            const float r_sq(dot(r_ij, r_ij));
-
-            if (r_sq < r_max_sq && r_sq >= r_min_sq)
+        // Compute the distances to the next block of particles in the cell.
+        // The IteratorLinkCell object keeps track of the block between calls
+        // to next.
+        if (m_cell_iter.remaining() > 0)
+        {
+            const unsigned int n = std::min(m_cell_iter.remaining(), BALL_BATCH_SIZE);
+            if (LinkCell::isBlockOutsideBall(m_cell_iter.nextBlockBounds(), m_query_point, r_max_sq,
+                                             m_minimum_image))
             {
-                return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq), 1, r_ij);
+                m_cell_iter.skip(n);
+                continue;
             }
+            m_batch_points = m_cell_iter.nextPoints();
+            computeBallBatch(m_cell_iter.nextCoordinates(0), m_cell_iter.nextCoordinates(1),
+                             m_cell_iter.nextCoordinates(2), n, m_query_point, r_min_sq, r_max_sq,
+                             &m_minimum_image, m_batch);
+            m_cell_iter.skip(n);
+            continue;
         }
 
         bool out_of_range = false;
@@ -537,17 +710,11 @@ NeighborBond LinkCellQueryBallIterator::next()
                 break;
             }
 
-            const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-            // Insertion to an unordered set returns a pair, the second
-            // element indicates insertion success or failure (if it
-            // already exists)
-            if (m_searched_cells.insert(neighbor_cell_index).second)
+            // Offsets that wrap onto a cell reached by another offset are
+            // skipped so that each cell is only searched once.
+            if (m_linkcell->isUniqueCellOffset(*m_neigh_cell_iter))
             {
-                // This cell has not been searched yet, so we will iterate
-                // over its contents. Otherwise, we loop back, increment
-                // the cell shell iterator, and try the next one.
-                m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
+                m_cell_iter = m_linkcell->itercell(m_linkcell->getCellIndex(m_query_cell + (*m_neigh_cell_iter)));
                 break;
             }
         }
@@ -575,37 +742,34 @@ NeighborBond LinkCellQueryIterator::next()
     unsigned int max_range
         = static_cast<unsigned int>(std::ceil(min_plane_distance / (2 * m_linkcell->getCellWidth()))) + 1;
 
-    vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
-
     // Loop over cell list neighbor shells relative to this point's cell.
     if (m_current_neighbors.empty())
     {
         // Expand search cell radius until termination conditions are met.
         while (m_neigh_cell_iter != IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
         {
-            // Iterate over the particles in that cell. Using a local counter
-            // variable is safe, because the IteratorLinkCell object is keeping
-            // track between calls to next. However, we have to add an extra
-            // check outside to proof ourselves against returning after
-            // previous calls to next that have not yet reset the iterator.
-            if (!m_cell_iter.atEnd())
+            // Iterate over the particles in that cell in blocks. The
+            // IteratorLinkCell object keeps track of the particles already
+            // searched, so a cell is never searched twice across calls to
+            // next.
+            while (m_cell_iter.remaining() > 0)
             {
-                for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
+                const unsigned int n = std::min(m_cell_iter.remaining(), BALL_BATCH_SIZE);
+                const unsigned int* cell_points = m_cell_iter.nextPoints();
+                computeBallBatch(m_cell_iter.nextCoordinates(0), m_cell_iter.nextCoordinates(1),
+                                 m_cell_iter.nextCoordinates(2), n, m_query_point, r_min_sq, r_max_sq,
+                                 &m_minimum_image, m_batch);
+                m_cell_iter.skip(n);
+                for (unsigned int k = 0; k < m_batch.size; ++k)
                 {
-                    // Skip ii matches immediately if requested.
+                    const unsigned int j = cell_points[m_batch.index[k]];
+                    // Skip ii matches if requested.
                     if (m_exclude_ii && m_query_point_idx == j)
                     {
                         continue;
                     }
-                    const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-                    const float r_sq(dot(r_ij, r_ij));
-                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                    {
-                        m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(r_sq), 1, r_ij);
-                    }
+                    m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(m_batch.r_sq[k]), 1,
+                                                     m_batch.r_ij[k]);
                 }
             }
 
@@ -618,18 +782,12 @@ NeighborBond LinkCellQueryIterator::next()
                     break;
                 }
 
-                const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                    vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-                // Insertion to an unordered set returns a pair, the second
-                // element indicates insertion success or failure (if it
-                // already exists)
-                if (m_searched_cells.insert(neighbor_cell_index).second)
+                // Offsets that wrap onto a cell reached by another offset
+                // are skipped so that each cell is only searched once.
+                if (m_linkcell->isUniqueCellOffset(*m_neigh_cell_iter))
                 {
-                    // This cell has not been searched yet, so we will
-                    // iterate over its contents. Otherwise, we loop back,
-                    // increment the cell shell iterator, and try the next
-                    // one.
-                    m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
+                    m_cell_iter
+                        = m_linkcell->itercell(m_linkcell->getCellIndex(m_query_cell + (*m_neigh_cell_iter)));
                     break;
                 }
             }
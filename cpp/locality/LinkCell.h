@@ -4,12 +4,13 @@
 #ifndef LINKCELL_H
 #define LINKCELL_H
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
-#include <tbb/concurrent_hash_map.h>
-#include <unordered_set>
 #include <vector>
 
 #include "Box.h"
+#include "DistanceKernel.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
 
@@ -24,17 +25,28 @@ namespace freud { namespace locality {
 */
 const unsigned int LINK_CELL_TERMINATOR = 0xffffffff;
 
-//! Iterates over particles in a link cell list generated by LinkCell
-/*! The link-cell structure is not trivial to iterate over. This helper class
- *  makes that easier both in C++ and provides a Python compatible interface
- *  for direct usage there. An IteratorLinkCell is given the bare essentials
- *  it needs to iterate over a given cell, the cell list, the number of
- *  particles, number of cells and the cell to iterate over. Call next() to
- *  get the index of the next particle in the cell, atEnd() will return true
- *  if you are at the end. In C++, next() will crash the code if you attempt
- *  to iterate past the end (no bounds checking for performance). When called
- *  from Python, a different version of next() is used that will throw
- *  StopIteration at the end.
+//! Number of floats storing the bounds of a block of particles in a cell (center and half extents).
+constexpr unsigned int LINK_CELL_BLOCK_BOUNDS_SIZE = 6;
+
+//! Largest number of subcells along each dimension of a dense cell.
+constexpr unsigned int LINK_CELL_MAX_SUBDIVISIONS = 1024;
+
+//! Padding of the block bounds relative to the largest box length.
+constexpr float LINK_CELL_BOUNDS_PADDING = 1e-5;
+
+//! Iterates over particles in a cell of the cell list generated by LinkCell
+/*! The particles of each cell are stored contiguously in LinkCell (see
+ *  LinkCell for their order within the cell). An IteratorLinkCell is given
+ *  the bare essentials it needs
+ *  to iterate over a given cell: the particle indices and positions sorted by
+ *  cell, and the range of those arrays that belongs to the cell. Call next()
+ *  to get the index of the next particle in the cell, atEnd() will return
+ *  true if you are at the end. After next() returns a particle,
+ *  getPosition() returns its position without an indirect lookup into the
+ *  original points. In C++, next() returns LINK_CELL_TERMINATOR once the end
+ *  of the cell is reached. The positions are stored as structure-of-arrays,
+ *  and the entries not yet returned can also be processed as a block with
+ *  remaining(), nextPoints(), nextCoordinates() and skip().
  *
  *  A loop over all of the particles in a cell can be accomplished with the
  *   following code in C++.
@@ -54,32 +66,94 @@ class IteratorLinkCell
 public:
     IteratorLinkCell() = default;
 
-    IteratorLinkCell(const util::ManagedArray<unsigned int>& cell_list, unsigned int Np, unsigned int Nc,
-                     unsigned int cell)
-        : m_cell_list(cell_list), m_Np(Np), m_Nc(Nc)
-    {
-        m_cell = cell;
-        m_cur_idx = m_Np + cell;
-    }
+    IteratorLinkCell(const unsigned int* cell_points, const float* cell_x, const float* cell_y,
+                     const float* cell_z, unsigned int begin, unsigned int end,
+                     const float* block_bounds = nullptr)
+        : m_cell_points(cell_points), m_cell_x(cell_x), m_cell_y(cell_y), m_cell_z(cell_z),
+          m_block_bounds(block_bounds), m_begin(begin), m_end(end), m_next(begin), m_cur_idx(0)
+    {}
 
     //! Copy the position of rhs into this object
-    void copy(const IteratorLinkCell& rhs);
+    void copy(const IteratorLinkCell& rhs)
+    {
+        *this = rhs;
+    }
 
     //! Test if the iteration over the cell is complete
-    bool atEnd() const;
+    bool atEnd() const
+    {
+        return (m_cur_idx == LINK_CELL_TERMINATOR);
+    }
 
     //! Get the next particle index in the list
-    unsigned int next();
+    unsigned int next()
+    {
+        m_cur_idx = (m_next < m_end) ? m_cell_points[m_next++] : LINK_CELL_TERMINATOR;
+        return m_cur_idx;
+    }
 
     //! Get the first particle index in the list
-    unsigned int begin();
+    unsigned int begin()
+    {
+        m_next = m_begin;
+        return next();
+    }
+
+    //! Get the position of the particle last returned by next
+    vec3<float> getPosition() const
+    {
+        return vec3<float>(m_cell_x[m_next - 1], m_cell_y[m_next - 1], m_cell_z[m_next - 1]);
+    }
+
+    //! Get the number of particles not yet returned by next
+    unsigned int remaining() const
+    {
+        return m_end - m_next;
+    }
+
+    //! Get the indices of the particles not yet returned by next
+    const unsigned int* nextPoints() const
+    {
+        return m_cell_points + m_next;
+    }
+
+    //! Get one coordinate (0, 1 or 2 for x, y or z) of the particles not yet returned by next
+    const float* nextCoordinates(unsigned int dim) const
+    {
+        const float* coordinates = (dim == 0) ? m_cell_x : ((dim == 1) ? m_cell_y : m_cell_z);
+        return coordinates + m_next;
+    }
+
+    //! Skip the next n particles, which must not exceed remaining()
+    void skip(unsigned int n)
+    {
+        m_next += n;
+    }
+
+    //! Get the bounds of the block of particles starting at the next particle
+    /*! The particles of a cell are split into blocks of BALL_BATCH_SIZE
+     *  starting at the first particle of the cell, so this is only valid
+     *  when the particles have been consumed in such blocks. The bounds are
+     *  the center and the half extents of the block, or nullptr if the cell
+     *  list does not store bounds.
+     */
+    const float* nextBlockBounds() const
+    {
+        return (m_block_bounds == nullptr)
+            ? nullptr
+            : m_block_bounds + LINK_CELL_BLOCK_BOUNDS_SIZE * ((m_next - m_begin) / BALL_BATCH_SIZE);
+    }
 
 private:
-    util::ManagedArray<unsigned int> m_cell_list;  //!< The cell list
-    unsigned int m_Np {0};                         //!< Number of particles in the cell list
-    unsigned int m_Nc {0};                         //!< Number of cells in the cell list
+    const unsigned int* m_cell_points {nullptr};   //!< Particle indices sorted by cell
+    const float* m_cell_x {nullptr};               //!< Particle x coordinates sorted by cell
+    const float* m_cell_y {nullptr};               //!< Particle y coordinates sorted by cell
+    const float* m_cell_z {nullptr};               //!< Particle z coordinates sorted by cell
+    const float* m_block_bounds {nullptr};         //!< Bounds of the blocks of the cell
+    unsigned int m_begin {0};                      //!< First entry of the cell
+    unsigned int m_end {0};                        //!< One past the last entry of the cell
+    unsigned int m_next {0};                       //!< Next entry to return
     unsigned int m_cur_idx {LINK_CELL_TERMINATOR}; //!< Current index
-    unsigned int m_cell {0};                       //!< Cell being considered
 };
 
 //! Iterates over sets of shells in a cell list
@@ -165,8 +239,26 @@ private:
  *  an arbitrary point.
 
  *  <b>Data structures:</b><br>
- *  The internal data structure used in LinkCell is a linked list of particle
- *  indices. See IteratorLinkCell for information on how to iterate through these.
+ *  LinkCell stores the particle indices sorted by cell id, along with the
+ *  offset of each cell into that array (a counting sort), so the particles
+ *  of each cell are contiguous in memory. The positions are stored in the
+ *  same order so that neighbor searches stream through contiguous memory.
+ *  Both are built in parallel. See IteratorLinkCell for information on how
+ *  to iterate through these. The offsets of the neighbor cells, which are
+ *  the same for every cell, are precomputed when the cell list is built.
+
+ *  <b>Inhomogeneous systems:</b><br>
+ *  A single cell width cannot suit both the dense and the dilute regions of
+ *  e.g. a liquid-vapor interface, so the cells adapt to their occupancy.
+ *  The points of a cell are sorted by particle index if the cell holds at
+ *  most BALL_BATCH_SIZE points. The points of denser cells are ordered
+ *  along a grid of subcells whose resolution is chosen for each cell so
+ *  that subcells hold about BALL_BATCH_SIZE points. In orthorhombic boxes,
+ *  the bounding box of each block of BALL_BATCH_SIZE consecutive points of
+ *  a cell is stored, and ball queries skip the blocks whose bounding box
+ *  lies outside the ball. The cost of a ball query in a dense cell is then
+ *  proportional to the number of points near the query point rather than
+ *  to the number of points in the neighboring cells.
 
  *  <b>2D:</b><br>
  *  LinkCell properly handles 2D boxes. When a 2D box is handed to LinkCell,
@@ -184,6 +276,12 @@ public:
     //! Constructor
     LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0);
 
+    //! Replace the box and points, reusing the cell list (see NeighborQuery::updatePoints).
+    /*! The cell width is kept. If the box is unchanged, so are the cells, and
+     *  the points are binned into the memory of the previous cell list.
+     */
+    void updatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points) override;
+
     //! Compute LinkCell dimensions
     static vec3<unsigned int> computeDimensions(const box::Box& box, float cell_width);
 
@@ -221,11 +319,61 @@ public:
     //! Iterate over particles in a cell
     IteratorLinkCell itercell(unsigned int cell) const
     {
-        return IteratorLinkCell(m_cell_list, m_n_points, getNumCells(), cell);
+        const unsigned int* offsets = m_cell_offsets.get();
+        const float* cell_positions = m_cell_positions.get();
+        const float* block_bounds = m_block_bounds.empty()
+            ? nullptr
+            : m_block_bounds.data() + LINK_CELL_BLOCK_BOUNDS_SIZE * size_t(m_cell_block_offsets[cell]);
+        return IteratorLinkCell(m_cell_points.get(), cell_positions, cell_positions + m_n_points,
+                                cell_positions + 2 * static_cast<size_t>(m_n_points), offsets[cell],
+                                offsets[cell + 1], block_bounds);
     }
 
-    //! Get a list of neighbors to a cell
-    const std::vector<unsigned int>& getCellNeighbors(unsigned int cell) const;
+    //! Test whether all points of a block lie outside a ball (see IteratorLinkCell::nextBlockBounds)
+    /*! \param bounds The bounds of the block, or nullptr if they are not stored.
+     *  \param query_point The center of the ball.
+     *  \param r_max_sq The squared radius of the ball.
+     *  \param minimum_image Minimum image convention of the box.
+     */
+    static bool isBlockOutsideBall(const float* bounds, const vec3<float>& query_point, float r_max_sq,
+                                   const MinimumImage& minimum_image)
+    {
+        if (bounds == nullptr)
+        {
+            return false;
+        }
+        float x = bounds[0] - query_point.x;
+        float y = bounds[1] - query_point.y;
+        float z = bounds[2] - query_point.z;
+        minimum_image.apply(x, y, z);
+        const float gap_x = std::max(std::abs(x) - bounds[3], 0.0F);
+        const float gap_y = std::max(std::abs(y) - bounds[4], 0.0F);
+        const float gap_z = std::max(std::abs(z) - bounds[5], 0.0F);
+        return gap_x * gap_x + gap_y * gap_y + gap_z * gap_z >= r_max_sq;
+    }
+
+    //! Get the offsets of the neighbor cells of each cell, including the cell itself
+    const std::vector<vec3<int>>& getCellStencil() const
+    {
+        return m_cell_stencil;
+    }
+
+    //! Get a sorted list of neighbors to a cell
+    std::vector<unsigned int> getCellNeighbors(unsigned int cell) const;
+
+    //! Test whether a cell offset is the unique representative of the cells it wraps onto
+    /*! When the cell list has fewer than 2 * range + 1 cells along some
+     *  dimension, distinct offsets of a cell shell wrap onto the same cell.
+     *  Exactly one offset of each such set lies in (-n / 2, n / 2] along
+     *  every dimension with n cells, and it is the one with the smallest
+     *  shell range, so searching only those offsets visits each cell once.
+     */
+    bool isUniqueCellOffset(const vec3<int>& offset) const
+    {
+        const vec3<int> dim(m_celldim.x, m_celldim.y, m_celldim.z);
+        return (2 * offset.x > -dim.x) && (2 * offset.x <= dim.x) && (2 * offset.y > -dim.y)
+            && (2 * offset.y <= dim.y) && (2 * offset.z > -dim.z) && (2 * offset.z <= dim.z);
+    }
 
     //! Compute the cell list
     void computeCellList(const vec3<float>* points, unsigned int n_points);
@@ -238,17 +386,106 @@ public:
     std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
+    //! Estimate the number density of the points around a position from the occupancy of the nearby cells.
+    float estimateDensity(const vec3<float>& point) const override;
+
+    //! Estimate the relative cost of a query around a point (see NeighborQuery::estimateQueryCost).
+    /*! A nearest neighbor query searches shells of cells until it holds
+     *  num_neighbors points closer than the next shell, sorting the points
+     *  found after each cell, so its cost grows with both the number of
+     *  cells searched and the number of points in them.
+     */
+    float estimateQueryCost(const vec3<float>& query_point, const QueryArgs& args) const override;
+
+    //! Apply a function to all neighbors of a query point within a ball.
+    /*! This finds the same bonds in the same order as a ball query through
+     *  querySingle, but passes them directly to cf instead of creating an
+     *  iterator, so it performs no allocations. The query arguments must
+     *  already have been validated.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param r_max The maximum distance of neighbors.
+     *  \param r_min The minimum distance of neighbors.
+     *  \param exclude_ii Whether to exclude bonds between points with the same index.
+     *  \param half_list Whether to only find bonds to points with a larger index.
+     *  \param cf An object with operator(const NeighborBond&).
+     */
+    template<typename ComputeBondType>
+    void forEachBallNeighbor(const vec3<float>& query_point, unsigned int query_point_idx, float r_max,
+                             float r_min, bool exclude_ii, bool half_list, const ComputeBondType& cf) const
+    {
+        const float r_max_sq = r_max * r_max;
+        const float r_min_sq = r_min * r_min;
+        const MinimumImage minimum_image(m_box);
+        const vec3<unsigned int> cell(getCellCoord(query_point));
+        const vec3<int> query_cell(cell.x, cell.y, cell.z);
+
+        // See LinkCellQueryBallIterator for the choice of search width.
+        const int extra_search_width = (r_max == m_cell_width) ? 0 : 1;
+
+        BallBatch batch;
+        for (IteratorCellShell shell(0, m_box.is2D());
+             static_cast<float>(shell.getRange() - extra_search_width) * m_cell_width <= r_max
+             || shell.getRange() == 0;
+             ++shell)
+        {
+            if (!isUniqueCellOffset(*shell))
+            {
+                continue;
+            }
+            IteratorLinkCell cell_iter = itercell(getCellIndex(query_cell + (*shell)));
+            while (cell_iter.remaining() > 0)
+            {
+                const unsigned int n = std::min(cell_iter.remaining(), BALL_BATCH_SIZE);
+                if (isBlockOutsideBall(cell_iter.nextBlockBounds(), query_point, r_max_sq, minimum_image))
+                {
+                    cell_iter.skip(n);
+                    continue;
+                }
+                const unsigned int* cell_points = cell_iter.nextPoints();
+                computeBallBatch(cell_iter.nextCoordinates(0), cell_iter.nextCoordinates(1),
+                                 cell_iter.nextCoordinates(2), n, query_point, r_min_sq, r_max_sq,
+                                 &minimum_image, batch);
+                cell_iter.skip(n);
+                for (unsigned int k = 0; k < batch.size; ++k)
+                {
+                    const unsigned int j = cell_points[batch.index[k]];
+                    if ((exclude_ii && query_point_idx == j) || (half_list && j <= query_point_idx))
+                    {
+                        continue;
+                    }
+                    cf(NeighborBond(query_point_idx, j, std::sqrt(batch.r_sq[k]), 1, batch.r_ij[k]));
+                }
+            }
+        }
+    }
+
 private:
-    //! Helper function to compute cell neighbors
-    const std::vector<unsigned int>& computeCellNeighbors(unsigned int cell) const;
+    //! Compute the cell dimensions for a box, throwing if the cell width is too large for it
+    void setupCells(const box::Box& box);
+
+    //! Helper function to compute the offsets of neighbor cells
+    void computeCellStencil();
+
+    //! Order the points of the dense cells along their subcells
+    void sortDenseCells(const vec3<float>* points);
+
+    //! Compute the bounds of the blocks of points of each cell
+    void computeBlockBounds();
 
     float m_cell_width {0};                 //!< Minimum necessary cell width cutoff
     vec3<unsigned int> m_celldim {0, 0, 0}; //!< Cell dimensions
     unsigned int m_size {0};                //!< The size of cell list.
 
-    util::ManagedArray<unsigned int> m_cell_list; //!< The cell list last computed
-    using CellNeighbors = tbb::concurrent_hash_map<unsigned int, std::vector<unsigned int>>;
-    mutable CellNeighbors m_cell_neighbors; //!< Hash map of cell neighbors for each cell
+    util::ManagedArray<unsigned int> m_cell_offsets; //!< Offset of each cell into m_cell_points
+    util::ManagedArray<unsigned int> m_cell_points;  //!< Particle indices sorted by cell
+    util::ManagedArray<float> m_cell_positions;      //!< Particle coordinates sorted by cell, shape (3, N)
+    std::vector<vec3<int>> m_cell_stencil;           //!< Offsets of the neighbor cells of any cell
+    std::vector<unsigned int> m_point_cells;         //!< Cell of each point, reused between builds
+    std::vector<unsigned int> m_chunk_cursors;       //!< Per-chunk cell counts, reused between builds
+    std::vector<unsigned int> m_cell_block_offsets;  //!< Index of the first block of each cell
+    std::vector<float> m_block_bounds;               //!< Center and half extents of each block, if stored
 };
 
 //! Parent class of LinkCell iterators that knows how to traverse general cell-linked list structures.
@@ -264,19 +501,42 @@ public:
         : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
                                         exclude_ii),
           m_linkcell(neighbor_query), m_neigh_cell_iter(0, neighbor_query->getBox().is2D()),
-          m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point)))
-    {}
+          m_minimum_image(neighbor_query->getBox())
+    {
+        startSearch();
+    }
 
     //! Empty Destructor
     ~LinkCellIterator() override = default;
 
+    //! Reset the iterator to find the neighbors of another query point.
+    void reset(const vec3<float>& query_point, unsigned int query_point_idx) override
+    {
+        NeighborQueryPerPointIterator::reset(query_point, query_point_idx);
+        startSearch();
+    }
+
 protected:
+    //! Start the search at the cell containing the query point.
+    void startSearch()
+    {
+        const vec3<unsigned int> query_cell(m_linkcell->getCellCoord(m_query_point));
+        m_query_cell = vec3<int>(query_cell.x, query_cell.y, query_cell.z);
+        m_neigh_cell_iter = IteratorCellShell(0, m_neighbor_query->getBox().is2D());
+        m_cell_iter = m_linkcell->itercell(m_linkcell->coordToIndex(query_cell.x, query_cell.y, query_cell.z));
+        m_batch.size = 0;
+        m_batch.pos = 0;
+    }
+
     const LinkCell* m_linkcell; //!< Link to the LinkCell object
     IteratorCellShell
         m_neigh_cell_iter;        //!< The shell iterator indicating how far out we're currently searching.
     IteratorLinkCell m_cell_iter; //!< The cell iterator indicating which cell we're currently searching.
-    std::unordered_set<unsigned int>
-        m_searched_cells; //!< Set of cells that have already been searched by the cell shell iterator.
+    vec3<int> m_query_cell;       //!< The cell coordinates of the query point.
+
+    MinimumImage m_minimum_image;                 //!< Minimum image convention of the box.
+    BallBatch m_batch;                            //!< The points of the current block within the ball.
+    const unsigned int* m_batch_points {nullptr}; //!< Indices of the points of the current block.
 };
 
 //! Iterator that gets specified numbers of nearest neighbors from LinkCell tree structures.
@@ -294,6 +554,14 @@ public:
     //! Empty Destructor
     ~LinkCellQueryIterator() override = default;
 
+    //! Reset the iterator to find the neighbors of another query point.
+    void reset(const vec3<float>& query_point, unsigned int query_point_idx) override
+    {
+        LinkCellIterator::reset(query_point, query_point_idx);
+        m_count = 0;
+        m_current_neighbors.clear();
+    }
+
     //! Get the next element.
     NeighborBond next() override;
 
@@ -156,6 +156,12 @@ public:
         return distance;
     }
 
+    //! Return the bond in the opposite direction, from the point to the query point.
+    NeighborBond mirror() const
+    {
+        return {point_idx, query_point_idx, distance, weight, -vector};
+    }
+
 private:
     unsigned int query_point_idx {0}; //! The query point index.
     unsigned int point_idx {0};       //! The reference point index.
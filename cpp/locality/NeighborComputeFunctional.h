@@ -4,12 +4,17 @@
 #ifndef NEIGHBOR_COMPUTE_FUNCTIONAL_H
 #define NEIGHBOR_COMPUTE_FUNCTIONAL_H
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "AABBQuery.h"
+#include "CompressedNeighborList.h"
+#include "LinkCell.h"
 #include "NeighborList.h"
 #include "NeighborPerPointIterator.h"
 #include "NeighborQuery.h"
+#include "RawPoints.h"
 #include "utils.h"
 
 /*! \file NeighborComputeFunctional.h
@@ -30,58 +35,127 @@ NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist
 //! Implementation of per-point finding logic for NeighborList objects.
 /*! This class provides a concrete implementation of the per-point neighbor
  *  finding interface specified by the NeighborPerPointIterator. In particular,
- *  it includes the logic for finding neighbors within a NeighborList by using
- *  the find_first_index method to initialize a start index and looping over all
- *  neighbors in the NeighborList.
+ *  it walks the NeighborListSegment of the query point, which is located with
+ *  a single lookup into the CSR offsets of the NeighborList.
  */
 class NeighborListPerPointIterator : public NeighborPerPointIterator
 {
 public:
     NeighborListPerPointIterator(const NeighborList* nlist, size_t point_index)
-        : NeighborPerPointIterator(point_index), m_nlist(nlist)
-    {
-        m_current_index = m_nlist->find_first_index(point_index);
-        m_finished = m_current_index == m_nlist->getNumBonds();
-        if (!m_finished)
-        {
-            m_returned_point_index = m_nlist->getNeighbors()(m_current_index, 0);
-        }
-    }
+        : NeighborPerPointIterator(point_index), m_nlist(nlist), m_segment(getSegment(nlist, point_index)),
+          m_current_index(0), m_finished(m_segment.empty())
+    {}
 
     ~NeighborListPerPointIterator() override = default;
 
+    //! Reset the iterator to the bonds of another query point.
+    void reset(size_t point_index)
+    {
+        m_query_point_idx = point_index;
+        m_segment = getSegment(m_nlist, point_index);
+        m_current_index = 0;
+        m_finished = m_segment.empty();
+    }
+
     NeighborBond next() override
     {
-        if (m_current_index == m_nlist->getNumBonds())
+        if (m_current_index == m_segment.size())
         {
             m_finished = true;
             return ITERATOR_TERMINATOR;
         }
 
-        NeighborBond nb = NeighborBond(
-            m_nlist->getNeighbors()(m_current_index, 0), m_nlist->getNeighbors()(m_current_index, 1),
-            m_nlist->getDistances()[m_current_index], m_nlist->getWeights()[m_current_index],
-            m_nlist->getVectors()[m_current_index]);
+        NeighborBond nb = m_segment.getBond(m_current_index);
         ++m_current_index;
-        m_returned_point_index = nb.getQueryPointIdx();
         return nb;
     }
 
     bool end() const override
     {
-        return (m_returned_point_index != m_query_point_idx) || m_finished;
+        return m_finished;
     }
 
 private:
-    const NeighborList* m_nlist; //! The NeighborList being iterated over.
-    size_t m_current_index;      //! The row of m_nlist where the iterator is currently located.
-    size_t m_returned_point_index {
-        0xffffffff}; //! The index of the last returned point (i.e. the value of
-                     //! m_nlist.getNeighbors()(m_current_index, 0)). Initialized to an arbitrary sentinel in
-                     //! case the user ever tries to access this for an iterator built from an empty nlist.
-    bool m_finished; //! Flag to indicate that the iterator has been exhausted.
+    //! Get the segment of a point, returning an empty segment for points the list does not contain.
+    static NeighborListSegment getSegment(const NeighborList* nlist, size_t point_index)
+    {
+        nlist->updateSegmentCounts();
+        if (point_index >= nlist->getNumQueryPoints())
+        {
+            return {nullptr, nullptr, nullptr, nullptr, static_cast<unsigned int>(point_index), 0, 0};
+        }
+        return nlist->getSegment(point_index);
+    }
+
+    const NeighborList* m_nlist;   //! The NeighborList being iterated over.
+    NeighborListSegment m_segment; //! The bonds of the query point being iterated over.
+    unsigned int m_current_index;  //! The index into m_segment where the iterator is currently located.
+    bool m_finished;               //! Flag to indicate that the iterator has been exhausted.
 };
 
+//! Point a NeighborListPerPointIterator at the bonds of a query point.
+/*! The iterator is created on first use and reset afterwards, so loops over
+ *  query points allocate one iterator per chunk rather than one per point.
+ */
+inline void resetNeighborListIterator(const NeighborList* nlist, size_t point_index,
+                                      std::shared_ptr<NeighborListPerPointIterator>& niter)
+{
+    if (niter)
+    {
+        niter->reset(point_index);
+    }
+    else
+    {
+        niter = std::make_shared<NeighborListPerPointIterator>(nlist, point_index);
+    }
+}
+
+constexpr size_t QUERY_RANGES_PER_THREAD(16); //!< Ranges of query points per thread in forLoopOverQuery.
+
+//! Loop over the steps of a query in parallel ranges of similar estimated cost.
+/*! The steps are split into ranges with
+ *  NeighborQueryIterator::getBalancedRanges, which are then distributed to
+ *  the threads, so a loop over an inhomogeneous system does not wait for the
+ *  few threads that were given the dense regions. The grain size of the
+ *  schedule bounds the number of ranges, and its affinity partitioner maps
+ *  ranges to threads.
+ *
+ *  \param iter The query whose steps are looped over.
+ *  \param n_query_points Number of query_points.
+ *  \param body An object with operator(size_t begin, size_t end) over steps.
+ *  \param schedule How to split the query points into chunks.
+ *  \param parallel If true, run body in parallel.
+ */
+template<typename Body>
+void forLoopOverQuery(const NeighborQueryIterator& iter, unsigned int n_query_points, const Body& body,
+                      const util::LoopSchedule& schedule, bool parallel)
+{
+    if (!parallel)
+    {
+        body(0, n_query_points);
+        return;
+    }
+    if (parallel::getDeterministicReductions())
+    {
+        // The balanced ranges depend on the number of threads, so the query
+        // points are split into the fixed chunks of deterministic loops.
+        util::forLoopWrapper(0, n_query_points, body);
+        return;
+    }
+    const size_t num_ranges
+        = std::min<size_t>(n_query_points / std::max<size_t>(schedule.grain_size, 1),
+                           QUERY_RANGES_PER_THREAD * std::max(parallel::maxConcurrency(), 1));
+    if (num_ranges <= 1)
+    {
+        body(0, n_query_points);
+        return;
+    }
+    const std::vector<size_t> bounds = iter.getBalancedRanges(num_ranges);
+    util::forLoopWrapper(
+        0, num_ranges, [&](size_t begin, size_t end) { body(bounds[begin], bounds[end]); },
+        util::LoopSchedule {1, schedule.affinity});
+}
+
 //! Wrapper iterating looping over NeighborQuery or NeighborList.
 /*! This function dynamically determines whether or not the provided
  *  NeighborList is valid. If it is, it applies the provide compute function to
@@ -109,42 +183,392 @@ private:
 template<typename ComputePairType>
 void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
                                unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
-                               const ComputePairType& cf, bool parallel = true)
+                               const ComputePairType& cf, bool parallel = true,
+                               const util::LoopSchedule& schedule = util::LoopSchedule())
 {
     // check if nlist exists
     if (nlist != nullptr)
     {
+        // Build the segment offsets before any per-point iterators read them.
+        nlist->updateSegmentCounts();
         util::forLoopWrapper(
             0, n_query_points,
             [&](size_t begin, size_t end) {
+                std::shared_ptr<NeighborListPerPointIterator> niter;
+                std::shared_ptr<NeighborPerPointIterator> ppiter;
                 for (size_t i = begin; i != end; ++i)
                 {
-                    std::shared_ptr<NeighborListPerPointIterator> niter
-                        = std::make_shared<NeighborListPerPointIterator>(nlist, i);
-                    cf(i, niter);
+                    resetNeighborListIterator(nlist, i, niter);
+                    if (!ppiter)
+                    {
+                        ppiter = niter;
+                    }
+                    cf(i, ppiter);
                 }
             },
-            parallel);
+            schedule, parallel);
     }
     else
     {
         std::shared_ptr<NeighborQueryIterator> iter
             = neighbor_query->query(query_points, n_query_points, qargs);
 
-        // iterate over the query object in parallel
+        // iterate over the query object in parallel, in its preferred order,
+        // reusing one per-point iterator for all query points of a chunk
+        forLoopOverQuery(
+            *iter, n_query_points,
+            [&](size_t begin, size_t end) {
+                std::shared_ptr<NeighborQueryPerPointIterator> it;
+                std::shared_ptr<NeighborPerPointIterator> ppiter;
+                for (size_t k = begin; k != end; ++k)
+                {
+                    const unsigned int i = iter->getQueryPointIdx(k);
+                    iter->query(i, it);
+                    if (!ppiter)
+                    {
+                        ppiter = it;
+                    }
+                    cf(i, ppiter);
+                }
+            },
+            schedule, parallel);
+    }
+}
+
+//! Wrap a compute function so that it is also applied to the mirror of each bond.
+/*! Half neighbor lists (see QueryArgs::half_list) contain each pair of
+ *  points once. Computes whose contribution of a bond only depends on the
+ *  bond can use this wrapper to account for both directions of each pair.
+ *  The mirrored bonds of a query point are found while looping over other
+ *  query points, so the compute function must accumulate into thread-local
+ *  storage rather than into per-point outputs.
+ *
+ *  \param cf An object with operator(NeighborBond) as input.
+ *  \param mirror If false, the bonds are passed to cf unchanged.
+ */
+template<typename ComputePairType> auto mirrorBonds(ComputePairType cf, bool mirror)
+{
+    return [cf, mirror](const NeighborBond& nb) {
+        cf(nb);
+        if (mirror)
+        {
+            cf(nb.mirror());
+        }
+    };
+}
+
+//! Wrapper looping over the decoded bonds of each query point of a CompressedNeighborList.
+/*! This function behaves like loopOverNeighborsIterator, except that the
+ *  per-point iterators decode the compressed bonds of each query point as
+ *  they are visited, so the decompressed list is never stored. The bonds of a
+ *  query point are visited in order of point index.
+ *
+ *  \param nlist Compressed neighbor list to loop over.
+ *  \param n_query_points Number of query_points.
+ *  \param cf An object with operator(size_t, std::shared_ptr<NeighborPerPointIterator>) as input.
+ *  \param parallel If true, loop over the query points in parallel.
+ *  \param schedule How to split the query points into chunks.
+ */
+template<typename ComputePairType>
+void loopOverNeighborsIterator(const CompressedNeighborList* nlist, unsigned int n_query_points,
+                               const ComputePairType& cf, bool parallel = true,
+                               const util::LoopSchedule& schedule = util::LoopSchedule())
+{
+    util::forLoopWrapper(
+        0, n_query_points,
+        [&](size_t begin, size_t end) {
+            std::shared_ptr<CompressedNeighborListPerPointIterator> niter;
+            std::shared_ptr<NeighborPerPointIterator> ppiter;
+            for (size_t i = begin; i != end; ++i)
+            {
+                if (niter)
+                {
+                    niter->reset(i);
+                }
+                else
+                {
+                    niter = std::make_shared<CompressedNeighborListPerPointIterator>(nlist, i);
+                    ppiter = niter;
+                }
+                cf(i, ppiter);
+            }
+        },
+        schedule, parallel);
+}
+
+//! Visits the bonds of single query points of a query.
+/*! Ball queries of LinkCell and AABBQuery objects (including the AABBQuery
+ *  that a RawPoints object builds) traverse the data structure directly
+ *  through forEachBallNeighbor. All other queries use per-point iterators.
+ */
+class QueryPointNeighbors
+{
+public:
+    QueryPointNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                        NeighborQueryIterator& iter)
+        : m_iter(iter), m_args(iter.getQueryArgs()), m_query_points(query_points)
+    {
+        if (m_args.mode == QueryType::ball)
+        {
+            m_linkcell = dynamic_cast<const LinkCell*>(neighbor_query);
+            m_aabb_query = dynamic_cast<const AABBQuery*>(neighbor_query);
+            if (const auto* raw_points = dynamic_cast<const RawPoints*>(neighbor_query))
+            {
+                m_aabb_query = raw_points->getAABBQuery();
+            }
+        }
+    }
+
+    //! Apply a compute function to the bonds of query point i.
+    /*! \param i Index of the query point.
+     *  \param it Per-point iterator reused between calls on the same thread.
+     *  \param cf An object with operator(NeighborBond) as input.
+     */
+    template<typename ComputePairType>
+    void operator()(unsigned int i, std::shared_ptr<NeighborQueryPerPointIterator>& it,
+                    const ComputePairType& cf) const
+    {
+        if (m_linkcell != nullptr)
+        {
+            m_linkcell->forEachBallNeighbor(m_query_points[i], i, m_args.r_max, m_args.r_min,
+                                            m_args.exclude_ii, m_args.half_list, cf);
+        }
+        else if (m_aabb_query != nullptr)
+        {
+            m_aabb_query->forEachBallNeighbor(m_query_points[i], i, m_args.r_max, m_args.r_min,
+                                              m_args.exclude_ii, m_args.half_list, cf);
+        }
+        else
+        {
+            m_iter.query(i, it);
+            NeighborBond nb = it->next();
+            while (!it->end())
+            {
+                cf(nb);
+                nb = it->next();
+            }
+        }
+    }
+
+private:
+    NeighborQueryIterator& m_iter;
+    const QueryArgs& m_args;
+    const vec3<float>* m_query_points;
+    const LinkCell* m_linkcell {nullptr};
+    const AABBQuery* m_aabb_query {nullptr};
+};
+
+//! Apply a compute function to all bonds found by querying a NeighborQuery.
+/*! Ball queries of LinkCell and AABBQuery objects (including the AABBQuery
+ *  that a RawPoints object builds) traverse the data structure directly
+ *  through forEachBallNeighbor, so no per-point iterators are allocated and
+ *  no bonds are stored. All other queries fall back to per-point iterators.
+ *
+ *  The query points are visited in the preferred order of the NeighborQuery,
+ *  and all bonds of a query point are passed to the compute function
+ *  consecutively by a single thread.
+ *
+ *  The compute function applied to the bonds of each chunk of query points
+ *  is obtained by calling make_cf once at the start of the chunk, on the
+ *  thread that processes it.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param make_cf A function returning an object with operator(NeighborBond) as input.
+ *  \param parallel If true, process the chunks in parallel.
+ *  \param schedule How to split the query points into chunks.
+ */
+template<typename MakeComputePairType>
+void loopOverNeighborQueryChunks(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                 unsigned int n_query_points, QueryArgs qargs,
+                                 const MakeComputePairType& make_cf, bool parallel = true,
+                                 const util::LoopSchedule& schedule = util::LoopSchedule())
+{
+    std::shared_ptr<NeighborQueryIterator> iter = neighbor_query->query(query_points, n_query_points, qargs);
+    const QueryPointNeighbors neighbors(neighbor_query, query_points, *iter);
+
+    // iterate over the query object in parallel, in its preferred order
+    forLoopOverQuery(
+        *iter, n_query_points,
+        [&](size_t begin, size_t end) {
+            const auto& cf = make_cf();
+            std::shared_ptr<NeighborQueryPerPointIterator> it;
+            for (size_t k = begin; k != end; ++k)
+            {
+                neighbors(iter->getQueryPointIdx(k), it, cf);
+            }
+        },
+        schedule, parallel);
+}
+
+//! Apply a compute function to all bonds found by querying a NeighborQuery.
+/*! This is loopOverNeighborQueryChunks with the same compute function for
+ *  every chunk.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param cf An object with operator(NeighborBond) as input.
+ */
+template<typename ComputePairType>
+void loopOverNeighborQuery(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                           unsigned int n_query_points, QueryArgs qargs, const ComputePairType& cf,
+                           bool parallel = true, const util::LoopSchedule& schedule = util::LoopSchedule())
+{
+    loopOverNeighborQueryChunks(
+        neighbor_query, query_points, n_query_points, qargs,
+        [&cf]() -> const ComputePairType& { return cf; }, parallel, schedule);
+}
+
+//! Wrapper looping over NeighborQuery or NeighborList with a compute function per chunk of work.
+/*! This function behaves like loopOverNeighbors, except that make_cf is
+ *  called at the start of every chunk of bonds or query points, on the thread
+ *  that processes the chunk, and the compute function it returns is applied
+ *  to the bonds of that chunk. This allows compute functions to look up
+ *  thread-local storage once per chunk rather than once per bond.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ * given qargs.
+ *  \param make_cf A function returning an object with operator(NeighborBond) as input.
+ *  \param parallel If true, process the chunks in parallel.
+ *  \param schedule How to split the bonds or query points into chunks. An
+ *         affinity partitioner kept across frames lets the same threads
+ *         visit the same query points in each frame.
+ */
+template<typename MakeComputePairType>
+void loopOverNeighborChunks(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                            unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                            const MakeComputePairType& make_cf, bool parallel = true,
+                            const util::LoopSchedule& schedule = util::LoopSchedule())
+{
+    // check if nlist exists
+    if (nlist != nullptr)
+    {
+        const unsigned int* neighbors = nlist->getNeighbors().get();
+        const float* distances = nlist->getDistances().get();
+        const float* weights = nlist->getWeights().get();
+        const vec3<float>* vectors = nlist->getVectors().get();
         util::forLoopWrapper(
-            0, n_query_points,
+            0, nlist->getNumBonds(),
             [&](size_t begin, size_t end) {
-                for (size_t i = begin; i != end; ++i)
+                const auto& cf = make_cf();
+                for (size_t bond = begin; bond != end; ++bond)
+                {
+                    const NeighborBond nb(neighbors[2 * bond], neighbors[2 * bond + 1], distances[bond],
+                                          weights[bond], vectors[bond]);
+                    cf(nb);
+                }
+            },
+            schedule, parallel);
+    }
+    else
+    {
+        loopOverNeighborQueryChunks(neighbor_query, query_points, n_query_points, qargs, make_cf, parallel,
+                                    schedule);
+    }
+}
+
+//! Wrapper looping over the bonds of a subset of the query points with a compute function per chunk of work.
+/*! This function behaves like loopOverNeighborChunks, except that only the
+ *  bonds of the query points in sample are visited. The query points keep
+ *  their indices, so the bonds report the original query point indices and
+ *  exclude_ii still excludes each query point from its own neighbors. With a
+ *  neighbor list, only the segments of the sampled query points are read.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param sample Indices of the query points to visit.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ * given qargs.
+ *  \param make_cf A function returning an object with operator(NeighborBond) as input.
+ *  \param parallel If true, process the chunks in parallel.
+ */
+template<typename MakeComputePairType>
+void loopOverSampledNeighborChunks(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                   unsigned int n_query_points, const std::vector<unsigned int>& sample,
+                                   QueryArgs qargs, const NeighborList* nlist,
+                                   const MakeComputePairType& make_cf, bool parallel = true)
+{
+    if (nlist != nullptr)
+    {
+        const unsigned int* neighbors = nlist->getNeighbors().get();
+        const float* distances = nlist->getDistances().get();
+        const float* weights = nlist->getWeights().get();
+        const vec3<float>* vectors = nlist->getVectors().get();
+        const unsigned int* segments = nlist->getSegments().get();
+        const unsigned int* counts = nlist->getCounts().get();
+        util::forLoopWrapper(
+            0, sample.size(),
+            [&](size_t begin, size_t end) {
+                const auto& cf = make_cf();
+                for (size_t k = begin; k != end; ++k)
+                {
+                    const unsigned int i = sample[k];
+                    for (size_t bond = segments[i]; bond != size_t(segments[i]) + counts[i]; ++bond)
+                    {
+                        const NeighborBond nb(neighbors[2 * bond], neighbors[2 * bond + 1], distances[bond],
+                                              weights[bond], vectors[bond]);
+                        cf(nb);
+                    }
+                }
+            },
+            parallel);
+    }
+    else
+    {
+        std::shared_ptr<NeighborQueryIterator> iter
+            = neighbor_query->query(query_points, n_query_points, qargs);
+        const QueryPointNeighbors neighbors(neighbor_query, query_points, *iter);
+        util::forLoopWrapper(
+            0, sample.size(),
+            [&](size_t begin, size_t end) {
+                const auto& cf = make_cf();
+                std::shared_ptr<NeighborQueryPerPointIterator> it;
+                for (size_t k = begin; k != end; ++k)
                 {
-                    std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
-                    cf(i, it);
+                    neighbors(sample[k], it, cf);
                 }
             },
             parallel);
     }
 }
 
+//! Wrapper looping over the bonds of a CompressedNeighborList with a compute function per chunk of work.
+/*! This function behaves like loopOverNeighborChunks, except that the
+ *  bonds are decoded while they are visited. The bonds of each query point
+ *  are passed to the compute function of a chunk consecutively, in order of
+ *  point index.
+ *
+ *  \param nlist Compressed neighbor list to loop over.
+ *  \param make_cf A function returning an object with operator(NeighborBond) as input.
+ *  \param parallel If true, process the chunks in parallel.
+ *  \param schedule How to split the query points into chunks.
+ */
+template<typename MakeComputePairType>
+void loopOverNeighborChunks(const CompressedNeighborList* nlist, const MakeComputePairType& make_cf,
+                            bool parallel = true, const util::LoopSchedule& schedule = util::LoopSchedule())
+{
+    util::forLoopWrapper(
+        0, nlist->getNumQueryPoints(),
+        [&](size_t begin, size_t end) {
+            const auto& cf = make_cf();
+            for (size_t i = begin; i != end; ++i)
+            {
+                nlist->forEachBond(i, cf);
+            }
+        },
+        schedule, parallel);
+}
+
 //! Wrapper iterating looping over NeighborQuery or NeighborList.
 /*! This function dynamically determines whether or not the provided
  *  NeighborList is valid. If it is, it applies the provide compute function to
@@ -169,46 +593,57 @@ void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<f
 template<typename ComputePairType>
 void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
                        unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
-                       const ComputePairType& cf, bool parallel = true)
+                       const ComputePairType& cf, bool parallel = true,
+                       const util::LoopSchedule& schedule = util::LoopSchedule())
+{
+    loopOverNeighborChunks(
+        neighbor_query, query_points, n_query_points, qargs, nlist,
+        [&cf]() -> const ComputePairType& { return cf; }, parallel, schedule);
+}
+
+//! Wrapper looping over the bonds of each query point of a NeighborQuery or NeighborList.
+/*! This function behaves like loopOverNeighbors, except that all bonds of a
+ *  given query point are passed to the compute function consecutively by a
+ *  single thread, also when a NeighborList is provided. This allows the
+ *  compute function to accumulate into per-query-point storage without
+ *  synchronization, and without the per-point iterators required by
+ *  loopOverNeighborsIterator.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ * given qargs.
+ *  \param cf An object with operator(NeighborBond) as input.
+ */
+template<typename ComputePairType>
+void loopOverNeighborsByQueryPoint(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                   unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                                   const ComputePairType& cf, bool parallel = true,
+                                   const util::LoopSchedule& schedule = util::LoopSchedule())
 {
-    // check if nlist exists
     if (nlist != nullptr)
     {
+        nlist->updateSegmentCounts();
+        const unsigned int n_nlist_query_points = nlist->getNumQueryPoints();
         util::forLoopWrapper(
-            0, nlist->getNumBonds(),
+            0, std::min(n_query_points, n_nlist_query_points),
             [&](size_t begin, size_t end) {
-                for (size_t bond = begin; bond != end; ++bond)
-                {
-                    const NeighborBond nb(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
-                                          nlist->getDistances()[bond], nlist->getWeights()[bond],
-                                          nlist->getVectors()[bond]);
-                    cf(nb);
-                }
-            },
-            parallel);
-    }
-    else
-    {
-        std::shared_ptr<NeighborQueryIterator> iter
-            = neighbor_query->query(query_points, n_query_points, qargs);
-
-        // iterate over the query object in parallel
-        util::forLoopWrapper(
-            0, n_query_points,
-            [&iter, &cf](size_t begin, size_t end) {
-                NeighborBond nb;
                 for (size_t i = begin; i != end; ++i)
                 {
-                    std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
-                    nb = it->next();
-                    while (!it->end())
+                    const NeighborListSegment segment = nlist->getSegment(i);
+                    for (unsigned int k = 0; k < segment.size(); ++k)
                     {
-                        cf(nb);
-                        nb = it->next();
+                        cf(segment.getBond(k));
                     }
                 }
             },
-            parallel);
+            schedule, parallel);
+    }
+    else
+    {
+        loopOverNeighborQuery(neighbor_query, query_points, n_query_points, qargs, cf, parallel, schedule);
     }
 }
 
@@ -231,19 +666,27 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
  * input. It should implement iteration logic over the iterator.
  */
 template<typename ComputePairType>
-void loopOverNeighborListIterator(const NeighborList* nlist, const ComputePairType& cf, bool parallel = true)
+void loopOverNeighborListIterator(const NeighborList* nlist, const ComputePairType& cf, bool parallel = true,
+                                  const util::LoopSchedule& schedule = util::LoopSchedule())
 {
+    // Build the segment offsets before any per-point iterators read them.
+    nlist->updateSegmentCounts();
     util::forLoopWrapper(
         0, nlist->getNumQueryPoints(),
         [&](size_t begin, size_t end) {
+            std::shared_ptr<NeighborListPerPointIterator> niter;
+            std::shared_ptr<NeighborPerPointIterator> ppiter;
             for (size_t i = begin; i != end; ++i)
             {
-                std::shared_ptr<NeighborListPerPointIterator> niter
-                    = std::make_shared<NeighborListPerPointIterator>(nlist, i);
-                cf(i, niter);
+                resetNeighborListIterator(nlist, i, niter);
+                if (!ppiter)
+                {
+                    ppiter = niter;
+                }
+                cf(i, ppiter);
             }
         },
-        parallel);
+        schedule, parallel);
 }
 }; }; // end namespace freud::locality
 
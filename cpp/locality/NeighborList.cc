@@ -2,12 +2,15 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
-#include <tbb/parallel_sort.h>
 
 #include "ManagedArray.h"
 #include "NeighborList.h"
+#include "RadixSort.h"
 
 namespace freud { namespace locality {
 
@@ -56,6 +59,47 @@ NeighborList::NeighborList(unsigned int num_bonds, const unsigned int* query_poi
     }
 }
 
+NeighborList::NeighborList(unsigned int num_bonds, const unsigned int* neighbors,
+                           unsigned int num_query_points, unsigned int num_points, const vec3<float>* vectors,
+                           const float* weights, const std::shared_ptr<void>& owner)
+    : m_num_query_points(num_query_points), m_num_points(num_points),
+      // Borrowed arrays are never written to, modified bonds are stored in new arrays.
+      m_neighbors(util::ManagedArray<unsigned int>::wrap(const_cast<unsigned int*>(neighbors),
+                                                         {num_bonds, 2}, owner)),
+      m_distances(0),
+      m_vectors(util::ManagedArray<vec3<float>>::wrap(const_cast<vec3<float>*>(vectors), {num_bonds}, owner)),
+      m_distances_updated(false), m_segments_counts_updated(false)
+{
+    unsigned int last_index(0);
+    for (unsigned int i = 0; i < num_bonds; i++)
+    {
+        const unsigned int index = neighbors[2 * i];
+        if (index < last_index)
+        {
+            throw std::invalid_argument("NeighborList query_point_index must be sorted.");
+        }
+        if (index >= m_num_query_points)
+        {
+            throw std::invalid_argument(
+                "NeighborList query_point_index values must be less than num_query_points.");
+        }
+        if (neighbors[2 * i + 1] >= m_num_points)
+        {
+            throw std::invalid_argument("NeighborList point_index values must be less than num_points.");
+        }
+        last_index = index;
+    }
+
+    if (weights != nullptr)
+    {
+        m_weights = util::ManagedArray<float>::wrap(const_cast<float*>(weights), {num_bonds}, owner);
+    }
+    else
+    {
+        m_weights_updated = false;
+    }
+}
+
 NeighborList::NeighborList(const vec3<float>* points, const vec3<float>* query_points, const box::Box& box,
                            const bool exclude_ii, const unsigned int num_points,
                            const unsigned int num_query_points)
@@ -169,39 +213,336 @@ void NeighborList::setNumBonds(unsigned int num_bonds, unsigned int num_query_po
     m_segments_counts_updated = false;
 }
 
+void NeighborList::setStoredColumns(unsigned int columns, const box::Box& box, const vec3<float>* points,
+                                    unsigned int num_points, const vec3<float>* query_points,
+                                    unsigned int num_query_points)
+{
+    m_distances_updated = (columns & DISTANCES_COLUMN) != 0;
+    m_vectors_updated = (columns & VECTORS_COLUMN) != 0;
+    m_weights_updated = (columns & WEIGHTS_COLUMN) != 0;
+    if (!m_distances_updated)
+    {
+        m_distances = util::ManagedArray<float>(0);
+    }
+    if (!m_vectors_updated)
+    {
+        m_vectors = util::ManagedArray<vec3<float>>(0);
+    }
+    if (!m_weights_updated)
+    {
+        m_weights = util::ManagedArray<float>(0);
+    }
+
+    m_box = box;
+    if ((columns & (DISTANCES_COLUMN | VECTORS_COLUMN)) == (DISTANCES_COLUMN | VECTORS_COLUMN))
+    {
+        // The positions are only needed to compute vectors or distances.
+        m_points = util::ManagedArray<vec3<float>>(0);
+        m_query_points = util::ManagedArray<vec3<float>>(0);
+        return;
+    }
+    m_points.prepare(num_points);
+    std::copy(points, points + num_points, m_points.get());
+    if (query_points == points && num_query_points == num_points)
+    {
+        m_query_points = m_points;
+    }
+    else
+    {
+        m_query_points.prepare(num_query_points);
+        std::copy(query_points, query_points + num_query_points, m_query_points.get());
+    }
+}
+
+void NeighborList::updateDistances() const
+{
+    if (!m_distances_updated)
+    {
+        const unsigned int num_bonds(getNumBonds());
+        m_distances.prepare(num_bonds);
+        float* distances = m_distances.get();
+        if (m_vectors_updated)
+        {
+            const vec3<float>* vectors = m_vectors.get();
+            util::forLoopWrapper(
+                0, num_bonds,
+                [&](size_t begin, size_t end) {
+                    for (size_t bond = begin; bond < end; ++bond)
+                    {
+                        distances[bond] = std::sqrt(dot(vectors[bond], vectors[bond]));
+                    }
+                },
+                util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+        }
+        else
+        {
+            const unsigned int* neighbors = m_neighbors.get();
+            const vec3<float>* points = m_points.get();
+            const vec3<float>* query_points = m_query_points.get();
+            util::forLoopWrapper(
+                0, num_bonds,
+                [&](size_t begin, size_t end) {
+                    for (size_t bond = begin; bond < end; ++bond)
+                    {
+                        const vec3<float> r_ij = m_box.wrap(points[neighbors[2 * bond + 1]]
+                                                            - query_points[neighbors[2 * bond]]);
+                        distances[bond] = std::sqrt(dot(r_ij, r_ij));
+                    }
+                },
+                util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+        }
+        m_distances_updated = true;
+    }
+}
+
+void NeighborList::updateVectors() const
+{
+    if (!m_vectors_updated)
+    {
+        const unsigned int num_bonds(getNumBonds());
+        m_vectors.prepare(num_bonds);
+        vec3<float>* vectors = m_vectors.get();
+        const unsigned int* neighbors = m_neighbors.get();
+        const vec3<float>* points = m_points.get();
+        const vec3<float>* query_points = m_query_points.get();
+        util::forLoopWrapper(
+            0, num_bonds,
+            [&](size_t begin, size_t end) {
+                for (size_t bond = begin; bond < end; ++bond)
+                {
+                    vectors[bond]
+                        = m_box.wrap(points[neighbors[2 * bond + 1]] - query_points[neighbors[2 * bond]]);
+                }
+            },
+            util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+        m_vectors_updated = true;
+    }
+}
+
+void NeighborList::updateWeights() const
+{
+    if (!m_weights_updated)
+    {
+        m_weights.prepare(getNumBonds());
+        std::fill(m_weights.get(), m_weights.get() + getNumBonds(), 1.0F);
+        m_weights_updated = true;
+    }
+}
+
 void NeighborList::updateSegmentCounts() const
 {
+    updateVectors();
+    updateDistances();
+    updateWeights();
     if (!m_segments_counts_updated)
     {
+        const unsigned int num_bonds(getNumBonds());
         m_counts.prepare(m_num_query_points);
         m_segments.prepare(m_num_query_points);
-        const unsigned int INDEX_TERMINATOR(0xffffffff);
-        unsigned int last_index(INDEX_TERMINATOR);
-        unsigned int counter(0);
-        for (unsigned int i = 0; i < getNumBonds(); i++)
+        m_offsets.prepare(m_num_query_points + 1);
+
+        const unsigned int* neighbors = m_neighbors.get();
+        unsigned int* offsets = m_offsets.get();
+
+        // Bonds are sorted by query point index, so the offset of query point
+        // i is the first bond whose query point index is >= i. Each bond that
+        // starts a new query point writes the offsets of all query points
+        // between the previous bond's query point and its own, so every
+        // offset is written exactly once and the loop parallelizes over bonds.
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                const unsigned int index(neighbors[2 * bond]);
+                const unsigned int first_index(bond == 0 ? 0 : neighbors[2 * (bond - 1)] + 1);
+                for (unsigned int i = first_index; i <= index; ++i)
+                {
+                    offsets[i] = bond;
+                }
+            }
+        });
+        const unsigned int last_index(num_bonds == 0 ? 0 : neighbors[2 * (num_bonds - 1)] + 1);
+        for (unsigned int i = last_index; i <= m_num_query_points; ++i)
+        {
+            offsets[i] = num_bonds;
+        }
+
+        util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_segments[i] = offsets[i];
+                m_counts[i] = offsets[i + 1] - offsets[i];
+            }
+        });
+        m_segments_counts_updated = true;
+    }
+}
+
+namespace {
+
+//! Number of bonds in each chunk of the parallel compaction in NeighborList::filterBonds.
+constexpr size_t FILTER_CHUNK_SIZE = 65536;
+
+} // namespace
+
+/*! This is a parallel stream compaction. The bonds are split into chunks,
+ *  the surviving bonds of each chunk are counted, and an exclusive scan of
+ *  the counts gives the offset of each chunk in the filtered list.
+ *
+ *  If no other array (such as a NumPy array in Python) references the
+ *  columns, the bonds are compacted in place: each chunk first moves its
+ *  surviving bonds to its start in parallel, and the chunks are then moved
+ *  to their offsets in order. Otherwise, the surviving bonds are scattered
+ *  into new arrays in parallel, so that the referenced data is unchanged.
+ *
+ *  keep is called exactly once per bond when compacting in place, and twice
+ *  otherwise. It may read the columns of the bond it is called for.
+ *
+ *  \param keep An object with operator(size_t bond) returning whether to keep the bond.
+ */
+template<typename Predicate> unsigned int NeighborList::filterBonds(const Predicate& keep)
+{
+    const size_t old_size(getNumBonds());
+    const size_t num_chunks = (old_size + FILTER_CHUNK_SIZE - 1) / FILTER_CHUNK_SIZE;
+    std::vector<size_t> chunk_offsets(num_chunks + 1, 0);
+    const auto chunk_begin = [](size_t chunk) { return chunk * FILTER_CHUNK_SIZE; };
+    const auto chunk_end = [old_size](size_t chunk) {
+        return std::min((chunk + 1) * FILTER_CHUNK_SIZE, old_size);
+    };
+    const auto scan_offsets = [&]() {
+        for (size_t chunk = 0; chunk < num_chunks; ++chunk)
         {
-            const unsigned int index(m_neighbors(i, 0));
-            if (index != last_index)
+            chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+        }
+        return chunk_offsets[num_chunks];
+    };
+
+    const bool in_place = m_neighbors.isUnique() && (!m_distances_updated || m_distances.isUnique())
+        && (!m_weights_updated || m_weights.isUnique()) && (!m_vectors_updated || m_vectors.isUnique());
+
+    size_t new_size;
+    if (in_place)
+    {
+        unsigned int* neighbors = m_neighbors.get();
+        float* distances = m_distances_updated ? m_distances.get() : nullptr;
+        float* weights = m_weights_updated ? m_weights.get() : nullptr;
+        vec3<float>* vectors = m_vectors_updated ? m_vectors.get() : nullptr;
+        const auto move_bonds = [&](size_t from, size_t to, size_t count) {
+            std::memmove(neighbors + 2 * to, neighbors + 2 * from, 2 * count * sizeof(unsigned int));
+            if (distances != nullptr)
+            {
+                std::memmove(distances + to, distances + from, count * sizeof(float));
+            }
+            if (weights != nullptr)
+            {
+                std::memmove(weights + to, weights + from, count * sizeof(float));
+            }
+            if (vectors != nullptr)
+            {
+                std::memmove(static_cast<void*>(vectors + to), vectors + from, count * sizeof(vec3<float>));
+            }
+        };
+
+        // Bonds only move towards the start of their chunk, past bonds that
+        // have already been tested, so chunks are compacted independently.
+        util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk)
             {
-                m_segments[index] = i;
-                if (index > 0)
+                size_t num_good = chunk_begin(chunk);
+                for (size_t bond = chunk_begin(chunk); bond < chunk_end(chunk); ++bond)
                 {
-                    if (last_index != INDEX_TERMINATOR)
+                    if (keep(bond))
                     {
-                        m_counts[last_index] = counter;
+                        if (num_good != bond)
+                        {
+                            move_bonds(bond, num_good, 1);
+                        }
+                        ++num_good;
                     }
-                    counter = 0;
                 }
+                chunk_offsets[chunk + 1] = num_good - chunk_begin(chunk);
             }
-            last_index = index;
-            counter++;
+        });
+        new_size = scan_offsets();
+
+        // A chunk may move onto the start of the next one, so the chunks are
+        // moved in order.
+        for (size_t chunk = 1; chunk < num_chunks; ++chunk)
+        {
+            move_bonds(chunk_begin(chunk), chunk_offsets[chunk],
+                       chunk_offsets[chunk + 1] - chunk_offsets[chunk]);
         }
-        if (last_index != INDEX_TERMINATOR)
+        m_neighbors.truncate({new_size, 2});
+        if (distances != nullptr)
         {
-            m_counts[last_index] = counter;
+            m_distances.truncate({new_size});
+        }
+        if (weights != nullptr)
+        {
+            m_weights.truncate({new_size});
+        }
+        if (vectors != nullptr)
+        {
+            m_vectors.truncate({new_size});
         }
-        m_segments_counts_updated = true;
     }
+    else
+    {
+        util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk)
+            {
+                size_t num_good = 0;
+                for (size_t bond = chunk_begin(chunk); bond < chunk_end(chunk); ++bond)
+                {
+                    num_good += keep(bond) ? 1 : 0;
+                }
+                chunk_offsets[chunk + 1] = num_good;
+            }
+        });
+        new_size = scan_offsets();
+
+        // Arrays to hold filtered data. Columns that are not stored stay
+        // empty.
+        auto new_neighbors = util::ManagedArray<unsigned int>({new_size, 2});
+        auto new_distances = util::ManagedArray<float>(m_distances_updated ? new_size : 0);
+        auto new_weights = util::ManagedArray<float>(m_weights_updated ? new_size : 0);
+        auto new_vectors = util::ManagedArray<vec3<float>>(m_vectors_updated ? new_size : 0);
+
+        util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk)
+            {
+                size_t num_good = chunk_offsets[chunk];
+                for (size_t bond = chunk_begin(chunk); bond < chunk_end(chunk); ++bond)
+                {
+                    if (!keep(bond))
+                    {
+                        continue;
+                    }
+                    new_neighbors.get()[2 * num_good] = m_neighbors.get()[2 * bond];
+                    new_neighbors.get()[2 * num_good + 1] = m_neighbors.get()[2 * bond + 1];
+                    if (m_distances_updated)
+                    {
+                        new_distances.get()[num_good] = m_distances.get()[bond];
+                    }
+                    if (m_weights_updated)
+                    {
+                        new_weights.get()[num_good] = m_weights.get()[bond];
+                    }
+                    if (m_vectors_updated)
+                    {
+                        new_vectors.get()[num_good] = m_vectors.get()[bond];
+                    }
+                    ++num_good;
+                }
+            }
+        });
+
+        m_neighbors = new_neighbors;
+        m_distances = new_distances;
+        m_weights = new_weights;
+        m_vectors = new_vectors;
+    }
+    m_segments_counts_updated = false;
+    return static_cast<unsigned int>(old_size - new_size);
 }
 
 // We are currently assuming that the input iterator has the correct length;
@@ -211,41 +552,7 @@ void NeighborList::updateSegmentCounts() const
 // accept an "end" parameter as well.
 template<typename Iterator> unsigned int NeighborList::filter(Iterator begin)
 {
-    const unsigned int old_size(getNumBonds());
-    const auto end = begin + old_size;
-
-    // new_size is the number of good (unfiltered-out) elements
-    const unsigned int new_size(std::count(begin, end, true));
-
-    // Arrays to hold filtered data - we use new arrays instead of writing over
-    // existing data to avoid requiring a second pass in resize().
-    auto new_neighbors = util::ManagedArray<unsigned int>({new_size, 2});
-    auto new_distances = util::ManagedArray<float>(new_size);
-    auto new_weights = util::ManagedArray<float>(new_size);
-    auto new_vectors = util::ManagedArray<vec3<float>>(new_size);
-
-    auto current_element = begin;
-    unsigned int num_good(0);
-    for (unsigned int i(0); i < old_size; ++i)
-    {
-        if (*current_element)
-        {
-            new_neighbors(num_good, 0) = m_neighbors(i, 0);
-            new_neighbors(num_good, 1) = m_neighbors(i, 1);
-            new_distances[num_good] = m_distances[i];
-            new_weights[num_good] = m_weights[i];
-            new_vectors[num_good] = m_vectors[i];
-            ++num_good;
-        }
-        ++current_element;
-    }
-
-    m_neighbors = new_neighbors;
-    m_distances = new_distances;
-    m_weights = new_weights;
-    m_vectors = new_vectors;
-    m_segments_counts_updated = false;
-    return old_size - new_size;
+    return filterBonds([begin](size_t bond) { return static_cast<bool>(*(begin + bond)); });
 }
 
 // Explicit template instantiation required for usage in dynamically linked
@@ -270,16 +577,51 @@ unsigned int NeighborList::filter_r(float r_max, float r_min)
         throw std::invalid_argument("NeighborList.filter_r requires that r_max must be greater than r_min.");
     }
 
-    std::vector<bool> dist_filter(getNumBonds());
-    for (unsigned int i(0); i < getNumBonds(); ++i)
+    // The distances are tested while the bonds are compacted, without a mask.
+    updateDistances();
+    const float* distances = m_distances.get();
+    return filterBonds([distances, r_min, r_max](size_t bond) {
+        return distances[bond] >= r_min && distances[bond] < r_max;
+    });
+}
+
+NeighborList* NeighborList::filteredCopy_r(float r_max, float r_min) const
+{
+    // The new list shares the arrays of this one, so filtering it copies the
+    // bonds it keeps into new arrays instead of compacting them in place.
+    updateDistances();
+    auto* nl = new NeighborList();
+    nl->m_num_query_points = m_num_query_points;
+    nl->m_num_points = m_num_points;
+    nl->m_neighbors = m_neighbors;
+    nl->m_distances = m_distances;
+    nl->m_weights = m_weights;
+    nl->m_vectors = m_vectors;
+    nl->m_box = m_box;
+    nl->m_points = m_points;
+    nl->m_query_points = m_query_points;
+    nl->m_distances_updated = m_distances_updated;
+    nl->m_vectors_updated = m_vectors_updated;
+    nl->m_weights_updated = m_weights_updated;
+    try
+    {
+        nl->filter_r(r_max, r_min);
+    }
+    catch (...)
     {
-        dist_filter[i] = (m_distances[i] >= r_min && m_distances[i] < r_max);
+        delete nl;
+        throw;
     }
-    return filter(dist_filter.cbegin());
+    return nl;
 }
 
 unsigned int NeighborList::find_first_index(unsigned int i) const
 {
+    // Use the cached CSR offsets when they are available.
+    if (m_segments_counts_updated && i <= m_num_query_points)
+    {
+        return m_offsets.get()[i];
+    }
     if (getNumBonds() != 0)
     {
         return bisection_search(i, 0, getNumBonds()) + (i > m_neighbors(0, 0) ? 1 : 0);
@@ -290,9 +632,9 @@ unsigned int NeighborList::find_first_index(unsigned int i) const
 void NeighborList::resize(unsigned int num_bonds)
 {
     auto new_neighbors = util::ManagedArray<unsigned int>({num_bonds, 2});
-    auto new_distances = util::ManagedArray<float>(num_bonds);
-    auto new_weights = util::ManagedArray<float>(num_bonds);
-    auto new_vectors = util::ManagedArray<vec3<float>>(num_bonds);
+    auto new_distances = util::ManagedArray<float>(m_distances_updated ? num_bonds : 0);
+    auto new_weights = util::ManagedArray<float>(m_weights_updated ? num_bonds : 0);
+    auto new_vectors = util::ManagedArray<vec3<float>>(m_vectors_updated ? num_bonds : 0);
 
     // On shrinking resizes, keep existing data.
     if (num_bonds <= getNumBonds())
@@ -301,9 +643,18 @@ void NeighborList::resize(unsigned int num_bonds)
         {
             new_neighbors(i, 0) = m_neighbors(i, 0);
             new_neighbors(i, 1) = m_neighbors(i, 1);
-            new_distances[i] = m_distances[i];
-            new_weights[i] = m_weights[i];
-            new_vectors[i] = m_vectors[i];
+            if (m_distances_updated)
+            {
+                new_distances[i] = m_distances[i];
+            }
+            if (m_weights_updated)
+            {
+                new_weights[i] = m_weights[i];
+            }
+            if (m_vectors_updated)
+            {
+                new_vectors[i] = m_vectors[i];
+            }
         }
     }
 
@@ -316,11 +667,19 @@ void NeighborList::resize(unsigned int num_bonds)
 
 void NeighborList::copy(const NeighborList& other)
 {
-    setNumBonds(other.getNumBonds(), other.getNumQueryPoints(), other.getNumPoints());
+    m_num_query_points = other.m_num_query_points;
+    m_num_points = other.m_num_points;
     m_neighbors = other.m_neighbors.copy();
     m_distances = other.m_distances.copy();
     m_weights = other.m_weights.copy();
     m_vectors = other.m_vectors.copy();
+    // The positions are never modified, so they are shared with the other list.
+    m_box = other.m_box;
+    m_points = other.m_points;
+    m_query_points = other.m_query_points;
+    m_distances_updated = other.m_distances_updated;
+    m_vectors_updated = other.m_vectors_updated;
+    m_weights_updated = other.m_weights_updated;
     m_segments_counts_updated = false;
 }
 
@@ -336,49 +695,144 @@ void NeighborList::validate(unsigned int num_query_points, unsigned int num_poin
     }
 }
 
+/*! The bonds are sorted by radix sorts of their integer keys, which give
+ *  the permutation of the bonds that is then applied to each stored column.
+ *  Bonds with equal keys keep their relative order.
+ */
 void NeighborList::sort(bool by_distance = false)
 {
-    // create a vector of NeighborBonds from the Neighborlist entries
-    auto bond_vector = std::move(toBondVector());
-    auto num_bonds = bond_vector.size();
-
-    // do parallel sort with tbb
+    const size_t num_bonds = getNumBonds();
+    const unsigned int* neighbors = m_neighbors.get();
+    std::vector<unsigned int> order(num_bonds);
+    std::vector<uint64_t> keys(num_bonds);
     if (by_distance)
     {
-        tbb::parallel_sort(bond_vector.begin(), bond_vector.end(), compareNeighborDistance);
+        // Sorting by point index first breaks ties in distance by point index.
+        updateDistances();
+        std::vector<uint32_t> point_keys(num_bonds);
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                order[bond] = static_cast<unsigned int>(bond);
+                point_keys[bond] = neighbors[2 * bond + 1];
+            }
+        });
+        util::radixSortByKey(point_keys, order);
+        const float* distances = m_distances.get();
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k)
+            {
+                keys[k] = (uint64_t(neighbors[2 * order[k]]) << 32)
+                    | util::orderedFloatBits(distances[order[k]]);
+            }
+        });
     }
     else
     {
-        tbb::parallel_sort(bond_vector.begin(), bond_vector.end(), compareNeighborBond);
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                order[bond] = static_cast<unsigned int>(bond);
+                keys[bond] = (uint64_t(neighbors[2 * bond]) << 32) | neighbors[2 * bond + 1];
+            }
+        });
+    }
+    util::radixSortByKey(keys, order);
+
+    // Bonds with equal keys are ordered by the remaining fields of the
+    // comparator. These runs are rare and short, e.g. repeated pairs.
+    const auto compare = by_distance ? compareNeighborDistance : compareNeighborBond;
+    const auto bond_at = [this](unsigned int bond) {
+        return NeighborBond(m_neighbors.get()[2 * bond], m_neighbors.get()[2 * bond + 1],
+                            m_distances.get()[bond], m_weights_updated ? m_weights.get()[bond] : float(1),
+                            vec3<float>());
+    };
+    for (size_t run_begin = 0, run_end = 1; run_begin < num_bonds; run_begin = run_end++)
+    {
+        while (run_end < num_bonds && keys[run_end] == keys[run_begin])
+        {
+            ++run_end;
+        }
+        if (run_end - run_begin > 1)
+        {
+            updateDistances();
+            std::sort(order.begin() + run_begin, order.begin() + run_end,
+                      [&](unsigned int left, unsigned int right) {
+                          return compare(bond_at(left), bond_at(right));
+                      });
+        }
     }
+    gatherBonds(order);
+}
 
-    // put the results back into this neighborlist
+void NeighborList::addMirroredBonds()
+{
+    if (m_num_query_points != m_num_points)
+    {
+        throw std::invalid_argument(
+            "NeighborList can only mirror the bonds between a set of points and itself.");
+    }
+    const size_t num_bonds = getNumBonds();
+    const unsigned int* neighbors = m_neighbors.get();
+    std::vector<unsigned int> order(2 * num_bonds);
+    std::vector<uint64_t> keys(2 * num_bonds);
     util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-        for (auto bond = begin; bond < end; ++bond)
+        for (size_t bond = begin; bond < end; ++bond)
         {
-            auto nb = bond_vector[bond];
-            m_neighbors(bond, 0) = nb.getQueryPointIdx();
-            m_neighbors(bond, 1) = nb.getPointIdx();
-            m_distances(bond) = nb.getDistance();
-            m_vectors(bond) = nb.getVector();
-            m_weights(bond) = nb.getWeight();
+            const uint64_t i = neighbors[2 * bond];
+            const uint64_t j = neighbors[2 * bond + 1];
+            order[bond] = static_cast<unsigned int>(bond);
+            keys[bond] = (i << 32) | j;
+            order[num_bonds + bond] = static_cast<unsigned int>(num_bonds + bond);
+            keys[num_bonds + bond] = (j << 32) | i;
         }
     });
+    util::radixSortByKey(keys, order);
+    gatherBonds(order);
 }
 
-std::vector<NeighborBond> NeighborList::toBondVector() const
+/*! Entries of order past the number of bonds refer to the mirror of bond
+ *  order[k] - getNumBonds(), as used by addMirroredBonds. Only the stored
+ *  columns are gathered, since the others are computed from the bonds.
+ */
+void NeighborList::gatherBonds(const std::vector<unsigned int>& order)
 {
-    auto num_bonds = m_distances.size();
-    std::vector<NeighborBond> bond_vector(num_bonds);
-    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-        for (auto bond_idx = begin; bond_idx < end; ++bond_idx)
+    const size_t num_bonds = getNumBonds();
+    const size_t new_num_bonds = order.size();
+    auto new_neighbors = util::ManagedArray<unsigned int>({new_num_bonds, 2});
+    auto new_distances = util::ManagedArray<float>(m_distances_updated ? new_num_bonds : 0);
+    auto new_weights = util::ManagedArray<float>(m_weights_updated ? new_num_bonds : 0);
+    auto new_vectors = util::ManagedArray<vec3<float>>(m_vectors_updated ? new_num_bonds : 0);
+
+    const unsigned int* neighbors = m_neighbors.get();
+    unsigned int* gathered_neighbors = new_neighbors.get();
+    util::forLoopWrapper(0, new_num_bonds, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
         {
-            NeighborBond nb(m_neighbors(bond_idx, 0), m_neighbors(bond_idx, 1), m_distances(bond_idx),
-                            m_weights(bond_idx), m_vectors(bond_idx));
-            bond_vector[bond_idx] = nb;
+            const bool mirrored = order[k] >= num_bonds;
+            const size_t bond = mirrored ? order[k] - num_bonds : order[k];
+            gathered_neighbors[2 * k] = neighbors[2 * bond + (mirrored ? 1 : 0)];
+            gathered_neighbors[2 * k + 1] = neighbors[2 * bond + (mirrored ? 0 : 1)];
+            if (m_distances_updated)
+            {
+                new_distances.get()[k] = m_distances.get()[bond];
+            }
+            if (m_weights_updated)
+            {
+                new_weights.get()[k] = m_weights.get()[bond];
+            }
+            if (m_vectors_updated)
+            {
+                new_vectors.get()[k] = mirrored ? -m_vectors.get()[bond] : m_vectors.get()[bond];
+            }
         }
     });
-    return bond_vector;
+
+    m_neighbors = new_neighbors;
+    m_distances = new_distances;
+    m_weights = new_weights;
+    m_vectors = new_vectors;
+    m_segments_counts_updated = false;
 }
 
 unsigned int NeighborList::bisection_search(unsigned int val, unsigned int left, unsigned int right) const
@@ -4,6 +4,7 @@
 #ifndef NEIGHBOR_LIST_H
 #define NEIGHBOR_LIST_H
 
+#include <memory>
 #include <vector>
 
 #include "Box.h"
@@ -23,7 +24,131 @@ namespace freud { namespace locality {
 
     Query point and point indices are stored in a 2D array m_neighbors of shape
     (n_bonds, 2). The distances and weights arrays are flat per-bond arrays.
+    Since bonds are sorted by query point index, the list is also described by
+    a compressed sparse row (CSR) array of per-query-point bond offsets, which
+    is built lazily and exposed through NeighborListSegment views.
+
+    <b>Stored columns:</b>
+
+    Only the indices are always stored. Lists built by neighbor queries can
+    leave out the vectors, distances and weights (see NeighborListColumns),
+    which are then computed from copies of the points, query points and box
+    the first time they are accessed. Workloads that only need the topology of
+    the bonds thus store 8 bytes per bond rather than 28.
+
+    <b>Borrowed arrays:</b>
+
+    A NeighborList can also be constructed as a view of bond arrays owned by
+    the caller, such as lists built by a simulation engine, in which case the
+    neighbors, vectors and weights are not copied. The distances are then
+    computed from the vectors the first time they are accessed. Borrowed
+    arrays are never written to: operations that modify the bonds, like
+    sorting or filtering, write to new arrays owned by the NeighborList.
  */
+class NeighborList;
+
+//! Flags selecting the per-bond columns that a NeighborList stores when it is built.
+/*! Columns that are not stored are computed when they are first accessed.
+ */
+enum NeighborListColumns : unsigned int
+{
+    NO_COLUMNS = 0,
+    VECTORS_COLUMN = 1 << 0,
+    DISTANCES_COLUMN = 1 << 1,
+    WEIGHTS_COLUMN = 1 << 2,
+    ALL_COLUMNS = VECTORS_COLUMN | DISTANCES_COLUMN | WEIGHTS_COLUMN
+};
+
+//! Read-only view of the contiguous range of bonds belonging to one query point.
+/*! A NeighborListSegment is obtained from NeighborList::getSegment and holds
+ *  raw pointers into the columns of the parent NeighborList, so accessing a
+ *  bond costs a single offset computation with no bounds checking. Bonds can
+ *  be addressed either by their local index k in [0, size()) or by their
+ *  global bond index in [begin(), end()).
+ *
+ *  \note Behavior is undefined if a segment is accessed after the parent
+ *  NeighborList is modified or destroyed.
+ */
+class NeighborListSegment
+{
+public:
+    NeighborListSegment(const unsigned int* neighbors, const float* distances, const float* weights,
+                        const vec3<float>* vectors, unsigned int query_point_idx, unsigned int begin,
+                        unsigned int end)
+        : m_neighbors(neighbors), m_distances(distances), m_weights(weights), m_vectors(vectors),
+          m_query_point_idx(query_point_idx), m_begin(begin), m_end(end)
+    {}
+
+    //! The query point index shared by all bonds in this segment.
+    unsigned int getQueryPointIdx() const
+    {
+        return m_query_point_idx;
+    }
+
+    //! The global index of the first bond in this segment.
+    unsigned int begin() const
+    {
+        return m_begin;
+    }
+
+    //! The global index one past the last bond in this segment.
+    unsigned int end() const
+    {
+        return m_end;
+    }
+
+    //! The number of bonds in this segment.
+    unsigned int size() const
+    {
+        return m_end - m_begin;
+    }
+
+    //! Whether this segment contains no bonds.
+    bool empty() const
+    {
+        return m_end == m_begin;
+    }
+
+    //! Point index of the k-th bond in this segment.
+    unsigned int getPointIdx(unsigned int k) const
+    {
+        return m_neighbors[2 * (m_begin + k) + 1];
+    }
+
+    //! Distance of the k-th bond in this segment.
+    float getDistance(unsigned int k) const
+    {
+        return m_distances[m_begin + k];
+    }
+
+    //! Weight of the k-th bond in this segment.
+    float getWeight(unsigned int k) const
+    {
+        return m_weights[m_begin + k];
+    }
+
+    //! Vector of the k-th bond in this segment.
+    const vec3<float>& getVector(unsigned int k) const
+    {
+        return m_vectors[m_begin + k];
+    }
+
+    //! Construct a NeighborBond for the k-th bond in this segment.
+    NeighborBond getBond(unsigned int k) const
+    {
+        return {m_query_point_idx, getPointIdx(k), getDistance(k), getWeight(k), getVector(k)};
+    }
+
+private:
+    const unsigned int* m_neighbors; //!< Interleaved (query point, point) index pairs.
+    const float* m_distances;        //!< Per-bond distances.
+    const float* m_weights;          //!< Per-bond weights.
+    const vec3<float>* m_vectors;    //!< Per-bond vectors.
+    unsigned int m_query_point_idx;  //!< Query point index of this segment.
+    unsigned int m_begin;            //!< First bond index of this segment.
+    unsigned int m_end;              //!< One past the last bond index of this segment.
+};
+
 class NeighborList
 {
 public:
@@ -37,6 +162,18 @@ public:
     NeighborList(unsigned int num_bonds, const unsigned int* query_point_index, unsigned int num_query_points,
                  const unsigned int* point_index, unsigned int num_points, const vec3<float>* vectors,
                  const float* weights);
+    //! Construct a view of bond arrays owned by the caller, without copying them
+    /*! \param num_bonds Number of bonds.
+     *  \param neighbors Array of shape (num_bonds, 2) of query point and point indices.
+     *  \param num_query_points Number of query points.
+     *  \param num_points Number of points.
+     *  \param vectors Array of bond vectors.
+     *  \param weights Array of bond weights, or NULL to use a weight of 1 for every bond.
+     *  \param owner Object keeping the arrays alive, see util::makeExternalOwner.
+     */
+    NeighborList(unsigned int num_bonds, const unsigned int* neighbors, unsigned int num_query_points,
+                 unsigned int num_points, const vec3<float>* vectors, const float* weights,
+                 const std::shared_ptr<void>& owner);
     //! Make a neighborlist where all points, excluding ii, are pairs
     NeighborList(const vec3<float>* points, const vec3<float>* query_points, const box::Box& box,
                  const bool exclude_ii, const unsigned int num_points, const unsigned int num_query_points);
@@ -53,7 +190,26 @@ public:
 
     //! Set the number of bonds, query points, and points for this NeighborList object
     void setNumBonds(unsigned int num_bonds, unsigned int num_query_points, unsigned int num_points);
-    //! Update the arrays of neighbor counts and segments
+    //! Select the columns to store, computing the others from the given positions when accessed
+    /*! This function should be called before setNumBonds, so that the
+     *  columns that are not stored are never allocated. The positions are
+     *  copied, so they need not outlive the NeighborList.
+     *
+     *  \param columns Bitwise or of the NeighborListColumns to store.
+     *  \param box Box of the positions.
+     *  \param points Points of the bonds.
+     *  \param num_points Number of points.
+     *  \param query_points Query points of the bonds.
+     *  \param num_query_points Number of query points.
+     */
+    void setStoredColumns(unsigned int columns, const box::Box& box, const vec3<float>* points,
+                          unsigned int num_points, const vec3<float>* query_points,
+                          unsigned int num_query_points);
+    //! Update the arrays of neighbor counts, segments, and CSR offsets
+    /*! This function is not thread-safe when the cached arrays are out of
+     *  date, so computes that access segments from inside parallel loops
+     *  should call it once beforehand.
+     */
     void updateSegmentCounts() const;
 
     //! Access the neighbors array for reading
@@ -63,20 +219,26 @@ public:
     }
 
     //! Access the distances array for reading
+    /*! Like updateSegmentCounts, this function and the other column accessors
+     *  are not thread-safe when the column has not been computed yet.
+     */
     const util::ManagedArray<float>& getDistances() const
     {
+        updateDistances();
         return m_distances;
     }
 
     //! Access the weights array for reading
     const util::ManagedArray<float>& getWeights() const
     {
+        updateWeights();
         return m_weights;
     }
 
     //! Access the vectors array for reading
     const util::ManagedArray<vec3<float>>& getVectors() const
     {
+        updateVectors();
         return m_vectors;
     }
 
@@ -93,25 +255,66 @@ public:
         return m_segments;
     }
 
+    //! Access the CSR offsets array (of length num_query_points + 1) for reading
+    const util::ManagedArray<unsigned int>& getOffsets() const
+    {
+        updateSegmentCounts();
+        return m_offsets;
+    }
+
+    //! Get a view of the bonds of query point i.
+    /*! The segment offsets must be up to date, see updateSegmentCounts, which
+     *  also computes the columns that are not stored.
+     */
+    NeighborListSegment getSegment(unsigned int i) const
+    {
+        const unsigned int* offsets = m_offsets.get();
+        return NeighborListSegment(m_neighbors.get(), m_distances.get(), m_weights.get(), m_vectors.get(), i,
+                                   offsets[i], offsets[i + 1]);
+    }
+
     /**
      * Set the values for the neighbor index to be that of the given neighborbond
      */
     void setNeighborEntry(size_t neighbor_index, const NeighborBond& nb)
     {
-        m_neighbors(neighbor_index, 0) = nb.getQueryPointIdx();
-        m_neighbors(neighbor_index, 1) = nb.getPointIdx();
-        m_vectors[neighbor_index] = nb.getVector();
-        m_distances[neighbor_index] = nb.getDistance();
-        m_weights[neighbor_index] = nb.getWeight();
+        setNeighborPair(neighbor_index, nb.getQueryPointIdx(), nb.getPointIdx());
+        if (m_distances_updated)
+        {
+            m_distances.get()[neighbor_index] = nb.getDistance();
+        }
+        if (m_vectors_updated)
+        {
+            m_vectors.get()[neighbor_index] = nb.getVector();
+        }
+        if (m_weights_updated)
+        {
+            m_weights.get()[neighbor_index] = nb.getWeight();
+        }
+    }
+
+    //! Set the indices of a bond, leaving the other columns unchanged
+    void setNeighborPair(size_t neighbor_index, unsigned int query_point_idx, unsigned int point_idx)
+    {
+        // The bounds-checked write validates neighbor_index for the other
+        // columns, which are written directly to avoid building index vectors.
+        m_neighbors[2 * neighbor_index + 1] = point_idx;
+        m_neighbors.get()[2 * neighbor_index] = query_point_idx;
     }
 
     //! Remove bonds in this object based on an array of boolean values. The
     //  array must be at least as long as the number of neighbor bonds.
     //  Returns the number of bonds removed.
     template<typename Iterator> unsigned int filter(Iterator begin);
+    //! Remove the bonds for which keep(bond_index) is false. Returns the
+    //  number of bonds removed (see the definition for details).
+    template<typename Predicate> unsigned int filterBonds(const Predicate& keep);
     //! Remove bonds in this object based on minimum and maximum distance
     //  constraints. Returns the number of bonds removed.
     unsigned int filter_r(float r_max, float r_min = 0);
+    //! Return a new NeighborList of the bonds with distances in [r_min,
+    //  r_max), leaving this object unchanged. The caller owns the new list.
+    NeighborList* filteredCopy_r(float r_max, float r_min = 0) const;
 
     //! Return the first bond index corresponding to point i
     unsigned int find_first_index(unsigned int i) const;
@@ -124,15 +327,29 @@ public:
     //! Throw a runtime_error if num_points and num_query_points do not match
     //  the stored value
     void validate(unsigned int num_query_points, unsigned int num_points) const;
-    // sort the neighborlist
+    //! Sort the bonds by query point index, then point index or distance
     void sort(bool by_distance);
+    //! Add the mirror (j, i) of each bond (i, j) and sort the bonds
+    /*! This turns a half neighbor list (see QueryArgs::half_list) of a set
+     *  of points with itself into the full neighbor list.
+     */
+    void addMirroredBonds();
 
 private:
     //! Helper method for bisection search of the neighbor list, used in find_first_index
     unsigned int bisection_search(unsigned int val, unsigned int left, unsigned int right) const;
 
-    //! Helper method to get an equivalent list of NeighborBonds from the nlist
-    std::vector<NeighborBond> toBondVector() const;
+    //! Replace the bonds with the bonds at the indices in order
+    void gatherBonds(const std::vector<unsigned int>& order);
+
+    //! Compute the distances if they are not stored
+    void updateDistances() const;
+
+    //! Compute the vectors from the positions if they are not stored
+    void updateVectors() const;
+
+    //! Set all weights to 1 if they are not stored
+    void updateWeights() const;
 
     //! Number of query points
     unsigned int m_num_query_points;
@@ -141,18 +358,33 @@ private:
     //! Neighbor list indices array
     util::ManagedArray<unsigned int> m_neighbors;
     //! Neighbor list per-bond distance array
-    util::ManagedArray<float> m_distances;
+    mutable util::ManagedArray<float> m_distances;
     //! Neighbor list per-bond weight array
-    util::ManagedArray<float> m_weights;
+    mutable util::ManagedArray<float> m_weights;
     //!< Directed vectors per-bond array
-    util::ManagedArray<vec3<float>> m_vectors;
+    mutable util::ManagedArray<vec3<float>> m_vectors;
+
+    //! Box used to compute the columns that are not stored
+    box::Box m_box;
+    //! Points used to compute the columns that are not stored
+    util::ManagedArray<vec3<float>> m_points;
+    //! Query points used to compute the columns that are not stored
+    util::ManagedArray<vec3<float>> m_query_points;
 
+    //! Track whether the distances are up to date
+    mutable bool m_distances_updated {true};
+    //! Track whether the vectors are up to date
+    mutable bool m_vectors_updated {true};
+    //! Track whether the weights are up to date
+    mutable bool m_weights_updated {true};
     //! Track whether segments and counts are up to date
     mutable bool m_segments_counts_updated;
     //! Neighbor counts for each query point
     mutable util::ManagedArray<unsigned int> m_counts;
     //! Neighbor segments for each query point
     mutable util::ManagedArray<unsigned int> m_segments;
+    //! CSR bond offsets for each query point, plus a trailing total bond count
+    mutable util::ManagedArray<unsigned int> m_offsets;
 };
 
 bool compareNeighborBond(const NeighborBond& left, const NeighborBond& right);
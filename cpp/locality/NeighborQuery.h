@@ -4,16 +4,19 @@
 #ifndef NEIGHBOR_QUERY_H
 #define NEIGHBOR_QUERY_H
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
-#include <tbb/enumerable_thread_specific.h>
-#include <tbb/parallel_sort.h>
 #include <utility>
+#include <vector>
 
 #include "Box.h"
 #include "NeighborBond.h"
 #include "NeighborList.h"
 #include "NeighborPerPointIterator.h"
+#include "Profiler.h"
 #include "utils.h"
 
 /*! \file NeighborQuery.h
@@ -38,6 +41,10 @@ constexpr float DEFAULT_R_MIN(0);                         //!< Default minimum q
 constexpr float DEFAULT_R_GUESS(-1.0);                    //!< Default guess query distance.
 constexpr float DEFAULT_SCALE(-1.0);      //!< Default scaling parameter for AABB nearest neighbor queries.
 constexpr bool DEFAULT_EXCLUDE_II(false); //!< Default for whether or not to include self-neighbors.
+constexpr bool DEFAULT_HALF_LIST(false);  //!< Default for whether to find each pair of points once.
+constexpr size_t TOLIST_CHUNKS_PER_THREAD(16); //!< Chunks of query points per thread in toNeighborList.
+constexpr float QUERY_FIXED_COST(12); //!< Cost of a query besides its bonds, relative to the cost of a bond.
+constexpr unsigned int MEMORY_ESTIMATE_SAMPLES(1024); //!< Query points sampled to estimate a number of bonds.
 constexpr auto ITERATOR_TERMINATOR
     = NeighborBond(-1, -1, 0, 0, vec3<float>()); //!< The object returned when iteration is complete.
 
@@ -60,6 +67,8 @@ struct QueryArgs
     float scale {DEFAULT_SCALE};          //! The scale factor to use when performing repeated ball queries
                                           //! to find a specified number of nearest neighbors.
     bool exclude_ii {DEFAULT_EXCLUDE_II}; //! If true, exclude self-neighbors.
+    bool half_list {DEFAULT_HALF_LIST};   //! If true, only find bonds (i, j) with i < j. This requires
+                                          //! the query points to be the points of the NeighborQuery.
 };
 
 // Forward declare the iterators
@@ -83,28 +92,29 @@ public:
     NeighborQuery(box::Box box, const vec3<float>* points, unsigned int n_points)
         : m_box(std::move(box)), m_points(points), m_n_points(n_points)
     {
-        // Reject systems with 0 particles
-        if (m_n_points == 0)
-        {
-            throw std::invalid_argument("Cannot create a NeighborQuery with 0 particles.");
-        }
-
-        // For 2D systems, check if any z-coordinates are outside some tolerance of z=0
-        if (m_box.is2D())
-        {
-            for (unsigned int i(0); i < n_points; i++)
-            {
-                if (std::abs(m_points[i].z) > 1e-6)
-                {
-                    throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
-                }
-            }
-        }
+        validatePoints(m_box, m_points, m_n_points);
     }
 
     //! Empty Destructor
     virtual ~NeighborQuery() = default;
 
+    //! Replace the box and points, reusing the storage of the object.
+    /*! This is equivalent to constructing a new object from the box and
+     *  points, but subclasses reuse the memory of their search structures
+     *  and update them incrementally where possible. As for the constructor,
+     *  the points are not copied and must outlive this object. Iterators
+     *  created by earlier queries must not be used after the update.
+     *
+     *  \param box The new simulation box.
+     *  \param points The new point coordinates.
+     *  \param n_points The number of points.
+     */
+    virtual void updatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+    {
+        validatePoints(box, points, n_points);
+        setPoints(box, points, n_points);
+    }
+
     //! Perform a query based on a set of query parameters.
     /*! Given a QueryArgs object and a set of points to perform a query
      *  with, this function creates an iterator object that loops over all \c
@@ -162,6 +172,30 @@ public:
         return m_n_points;
     }
 
+    //! Return whether the given points are the reference points.
+    /*! Arrays other than the reference points themselves, such as a copy
+     *  made by the caller, are compared by value.
+     *
+     *  \param points The points to compare.
+     *  \param n_points The number of points to compare.
+     */
+    bool hasPoints(const vec3<float>* points, unsigned int n_points) const
+    {
+        return n_points == m_n_points
+            && (points == m_points || std::equal(points, points + n_points, m_points));
+    }
+
+    //! Get a spatially coherent ordering of the points
+    /*! Backends that sort their points spatially (e.g. by cell or by tree
+     *  leaf) store that permutation here, so that loops over the points can
+     *  visit nearby points consecutively. The array is empty if the backend
+     *  does not provide an ordering.
+     */
+    const util::ManagedArray<unsigned int>& getSpatialOrder() const
+    {
+        return m_spatial_order;
+    }
+
     //! Get a point's coordinates using index operator notation
     /*! \param index The point index to return.
      */
@@ -174,7 +208,75 @@ public:
         return m_points[index];
     }
 
+    //! Estimate the number density of the points around a position.
+    /*! The estimate is only used to balance the work of parallel queries, so
+     *  it should be cheap rather than accurate. The default assumes that the
+     *  points are uniformly distributed in the box, and backends override it
+     *  with the occupancy of their data structure around the given position.
+     *  In 2D this is a density per unit area.
+     */
+    virtual float estimateDensity(const vec3<float>& /*point*/) const
+    {
+        return static_cast<float>(m_n_points) / m_box.getVolume();
+    }
+
+    //! Estimate the relative cost of a query around a point.
+    /*! The cost is measured in bonds: a ball query costs QUERY_FIXED_COST
+     *  plus the number of points expected within r_max at the local density.
+     *  How many points a nearest neighbor search examines depends more on the
+     *  data structure than on the density, so by default nearest neighbor
+     *  queries cost QUERY_FIXED_COST plus num_neighbors everywhere.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param args Validated query arguments.
+     */
+    virtual float estimateQueryCost(const vec3<float>& query_point, const QueryArgs& args) const
+    {
+        if (args.mode == QueryType::nearest)
+        {
+            return QUERY_FIXED_COST + static_cast<float>(args.num_neighbors);
+        }
+        return QUERY_FIXED_COST + estimateDensity(query_point) * ballVolume(args.r_max);
+    }
+
 protected:
+    //! Get the volume of a ball of radius r, or its area in 2D boxes.
+    float ballVolume(float r) const
+    {
+        return m_box.is2D() ? static_cast<float>(M_PI) * r * r
+                            : static_cast<float>(4.0 * M_PI / 3.0) * r * r * r;
+    }
+
+    //! Throw if the points cannot be used to construct a NeighborQuery in the box.
+    static void validatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+    {
+        // Reject systems with 0 particles
+        if (n_points == 0)
+        {
+            throw std::invalid_argument("Cannot create a NeighborQuery with 0 particles.");
+        }
+
+        // For 2D systems, check if any z-coordinates are outside some tolerance of z=0
+        if (box.is2D())
+        {
+            for (unsigned int i(0); i < n_points; i++)
+            {
+                if (std::abs(points[i].z) > 1e-6)
+                {
+                    throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
+                }
+            }
+        }
+    }
+
+    //! Replace the box and points without validating them (see validatePoints).
+    void setPoints(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+    {
+        m_box = box;
+        m_points = points;
+        m_n_points = n_points;
+    }
+
     //! Validate the combination of specified arguments.
     /*! Before checking if the combination of parameters currently set is
      *  valid, this function first attempts to infer a mode if one is not set in
@@ -215,6 +317,16 @@ protected:
         {
             throw std::runtime_error("Unknown mode");
         }
+        if (args.half_list)
+        {
+            // Nearest neighbor relations are not symmetric, so only ball
+            // queries can skip the mirror of each bond.
+            if (args.mode != QueryType::ball)
+            {
+                throw std::runtime_error("Half neighbor lists can only be found by ball queries.");
+            }
+            args.exclude_ii = true;
+        }
     }
 
     //! Try to determine the query mode if one is not specified.
@@ -239,9 +351,10 @@ protected:
         }
     }
 
-    const box::Box m_box;        //!< Simulation box where the particles belong.
-    const vec3<float>* m_points; //!< Point coordinates.
-    unsigned int m_n_points;     //!< Number of points.
+    box::Box m_box;                                   //!< Simulation box where the particles belong.
+    const vec3<float>* m_points;                      //!< Point coordinates.
+    unsigned int m_n_points;                          //!< Number of points.
+    util::ManagedArray<unsigned int> m_spatial_order; //!< Spatially coherent order of the points, if any.
 };
 
 //! Implementation of per-point finding logic for NeighborQuery objects.
@@ -279,6 +392,22 @@ public:
     //! Empty Destructor
     ~NeighborQueryPerPointIterator() override = default;
 
+    //! Reset the iterator to find the neighbors of another query point.
+    /*! This allows one iterator to be reused for many query points with the
+     *  same query arguments, so that loops over query points allocate an
+     *  iterator once rather than once per point. Subclasses with additional
+     *  per-point state must extend this function to reset that state.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     */
+    virtual void reset(const vec3<float>& query_point, unsigned int query_point_idx)
+    {
+        m_query_point = query_point;
+        m_query_point_idx = query_point_idx;
+        m_finished = false;
+    }
+
     //! Indicate when done.
     bool end() const override
     {
@@ -288,13 +417,26 @@ public:
     //! Get the next element.
     NeighborBond next() override = 0;
 
+    //! Only find the bonds to points with a larger index than the query point.
+    void setHalfList(bool half_list)
+    {
+        m_half_list = half_list;
+    }
+
 protected:
+    //! Return whether the bond to point j must be skipped by the query.
+    bool isExcluded(unsigned int j) const
+    {
+        return (m_exclude_ii && m_query_point_idx == j) || (m_half_list && j <= m_query_point_idx);
+    }
+
     const NeighborQuery* m_neighbor_query;       //!< Link to the NeighborQuery object.
-    const vec3<float> m_query_point = {0, 0, 0}; //!< Coordinates of the query point.
+    vec3<float> m_query_point = {0, 0, 0};       //!< Coordinates of the query point.
     bool m_finished; //!< Flag to indicate that iteration is complete (must be set by next() on termination).
     float m_r_max;   //!< Cutoff distance for neighbors.
     float m_r_min;   //!< Minimum distance for neighbors.
-    bool m_exclude_ii; //!< Flag to indicate whether or not to include self bonds.
+    bool m_exclude_ii;        //!< Flag to indicate whether or not to include self bonds.
+    bool m_half_list {false}; //!< Flag to indicate whether to skip bonds to points j <= i.
 };
 
 //! The iterator class for neighbor queries on NeighborQuery objects.
@@ -318,6 +460,19 @@ public:
         : m_neighbor_query(neighbor_query), m_query_points(query_points),
           m_num_query_points(num_query_points), m_qargs(qargs), m_finished(false), m_cur_p(0)
     {
+        if (qargs.half_list && !neighbor_query->hasPoints(query_points, num_query_points))
+        {
+            throw std::invalid_argument("Half neighbor lists require the query points to be the points.");
+        }
+        // Parallel loops visit the query points in the spatial order of the
+        // NeighborQuery when the query points are its own points, so that
+        // consecutive queries touch the same parts of the data structure.
+        const util::ManagedArray<unsigned int>& spatial_order = neighbor_query->getSpatialOrder();
+        if (query_points == neighbor_query->getPoints() && num_query_points == neighbor_query->getNPoints()
+            && spatial_order.size() == num_query_points)
+        {
+            m_query_order = spatial_order.get();
+        }
         m_iter = this->query(m_cur_p);
     }
 
@@ -336,6 +491,90 @@ public:
         return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
     }
 
+    //! Point a per-point iterator at a specific query point by index.
+    /*! If it is empty, a new iterator is created. Otherwise it must have been
+     *  created by this object, and it is reset to query point i without
+     *  allocating, so loops over many query points can reuse one iterator.
+     */
+    void query(unsigned int i, std::shared_ptr<NeighborQueryPerPointIterator>& it)
+    {
+        if (it)
+        {
+            it->reset(m_query_points[i], i);
+        }
+        else
+        {
+            it = this->query(i);
+        }
+    }
+
+    //! Get the validated query arguments.
+    const QueryArgs& getQueryArgs() const
+    {
+        return m_qargs;
+    }
+
+    //! Get the index of the k-th query point in the preferred order for parallel loops.
+    /*! Loops over all query points whose results do not depend on the order
+     *  in which points are processed should process query point
+     *  getQueryPointIdx(k) at step k.
+     */
+    unsigned int getQueryPointIdx(size_t k) const
+    {
+        return m_query_order == nullptr ? k : m_query_order[k];
+    }
+
+    //! Split the steps of a parallel loop over the query points into ranges of similar cost.
+    /*! The steps are the indices k of getQueryPointIdx. The cost of each
+     *  query is estimated with NeighborQuery::estimateQueryCost, so in
+     *  inhomogeneous systems the ranges through dense regions hold fewer
+     *  query points than those through sparse regions, and no thread is left
+     *  with a tail of expensive queries after the others finish. If only one
+     *  thread is available, the steps are split evenly without estimating
+     *  their cost.
+     *
+     *  \param num_ranges The number of ranges.
+     *  
+eturns The num_ranges + 1 boundaries of the ranges, range r holding
+     *           the steps from element r up to element r + 1.
+     */
+    std::vector<size_t> getBalancedRanges(size_t num_ranges) const
+    {
+        std::vector<size_t> bounds(num_ranges + 1, m_num_query_points);
+        for (size_t r = 0; r < num_ranges; ++r)
+        {
+            bounds[r] = r * m_num_query_points / num_ranges;
+        }
+        if (num_ranges <= 1 || parallel::maxConcurrency() <= 1)
+        {
+            return bounds;
+        }
+
+        std::vector<double> cumulative_cost(m_num_query_points);
+        util::forLoopWrapper(
+            0, m_num_query_points,
+            [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k)
+                {
+                    cumulative_cost[k] = m_neighbor_query->estimateQueryCost(
+                        m_query_points[getQueryPointIdx(k)], m_qargs);
+                }
+            },
+            util::LoopSchedule {util::CHEAP_LOOP_GRAIN_SIZE});
+        std::partial_sum(cumulative_cost.begin(), cumulative_cost.end(), cumulative_cost.begin());
+
+        // Each range ends at the first step whose cumulative cost passes
+        // its share of the total.
+        const double total_cost = cumulative_cost.back();
+        for (size_t r = 1; r < num_ranges; ++r)
+        {
+            const double target = total_cost * static_cast<double>(r) / static_cast<double>(num_ranges);
+            bounds[r] = std::upper_bound(cumulative_cost.begin(), cumulative_cost.end(), target)
+                - cumulative_cost.begin();
+        }
+        return bounds;
+    }
+
     //! Get the next element.
     NeighborBond next()
     {
@@ -360,75 +599,386 @@ public:
             {
                 break;
             }
-            m_iter = this->query(m_cur_p);
+            this->query(m_cur_p, m_iter);
         }
         m_finished = true;
         return ITERATOR_TERMINATOR;
     }
 
+    //! Estimate the peak memory of toNeighborList in bytes.
+    /*! The number of bonds is estimated with NeighborQuery::estimateQueryCost
+     *  from a sample of the query points.
+     *
+     *  \param columns Bitwise or of the NeighborListColumns to store.
+     */
+    size_t estimateNeighborListMemory(unsigned int columns = ALL_COLUMNS) const
+    {
+        if (m_num_query_points == 0)
+        {
+            return 0;
+        }
+        const unsigned int stride = std::max(m_num_query_points / MEMORY_ESTIMATE_SAMPLES, 1U);
+        double sampled_bonds = 0;
+        unsigned int num_samples = 0;
+        for (unsigned int i = 0; i < m_num_query_points; i += stride, ++num_samples)
+        {
+            sampled_bonds += std::max(
+                m_neighbor_query->estimateQueryCost(m_query_points[i], m_qargs) - QUERY_FIXED_COST, float(0));
+        }
+        const auto num_bonds = static_cast<size_t>(sampled_bonds * m_num_query_points / num_samples);
+
+        // The bonds are gathered per chunk of query points, then copied into
+        // the columns of the list.
+        size_t bond_memory = 2 * sizeof(unsigned int);
+        bond_memory += (columns & VECTORS_COLUMN) != 0 ? sizeof(vec3<float>) : 0;
+        bond_memory += (columns & DISTANCES_COLUMN) != 0 ? sizeof(float) : 0;
+        bond_memory += (columns & WEIGHTS_COLUMN) != 0 ? sizeof(float) : 0;
+        bond_memory += columns != NO_COLUMNS ? sizeof(NeighborBond) : sizeof(unsigned int);
+        size_t memory = num_bonds * bond_memory + (m_num_query_points + 1) * sizeof(size_t);
+        if (columns != ALL_COLUMNS)
+        {
+            // The positions are copied to compute the other columns.
+            memory += (static_cast<size_t>(m_num_query_points) + m_neighbor_query->getNPoints())
+                * sizeof(vec3<float>);
+        }
+        return memory;
+    }
+
     //! Generate a NeighborList from query.
     /*! This function exploits parallelism by finding the neighbors for
-     *  each query point in parallel and adding them to a list, which is
-     *  then sorted in parallel as well before being added to the
-     *  NeighborList object. Right now this won't be backwards compatible
+     *  each query point in parallel and adding them to per-chunk lists,
+     *  which are then copied in order into the NeighborList object. Right
+     *  now this won't be backwards compatible
      *  because the kn query is not symmetric, so even if we reverse the
      *  output order here the actual neighbors found will be different.
      *
+     *  Columns that are not selected are not stored, and are computed from
+     *  the positions if they are accessed later. If no columns are selected,
+     *  only the point index of each bond is kept between the query and the
+     *  copy into the NeighborList. If the selected columns would exceed the
+     *  memory budget (see parallel::setMemoryBudget), none are stored,
+     *  unless a ball query may find bonds to several periodic images of a
+     *  point, whose vectors cannot be recomputed from the positions.
+     *
      *  This function returns a pointer, not a shared pointer, so the
      *  caller is responsible for deleting it. The reason for this is that
      *  the primary use-case is to have this object be managed by instances
      *  of the Cython NeighborList class.
+     *
+     *  \param sort_by_distance Whether to sort the bonds of each query point by distance.
+     *  \param columns Bitwise or of the NeighborListColumns to store.
      */
-    NeighborList* toNeighborList(bool sort_by_distance = false)
+    NeighborList* toNeighborList(bool sort_by_distance = false, unsigned int columns = ALL_COLUMNS)
     {
-        using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
-        BondVector bonds;
-        util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
-            BondVector::reference local_bonds(bonds.local());
-            NeighborBond nb;
-            for (size_t i = begin; i < end; ++i)
+        return toNeighborList(sort_by_distance, columns, [](const NeighborBond&) { return true; });
+    }
+
+    //! Obtain a NeighborList of the bonds for which keep(bond) is true.
+    /*! The predicate is tested while the bonds are gathered by the query, so
+     *  filtering the bonds this way never stores the rejected ones, unlike
+     *  calling NeighborList::filter on the full list.
+     *
+     *  \param sort_by_distance Whether to sort the bonds of each query point by distance.
+     *  \param columns Bitwise or of the NeighborListColumns to store.
+     *  \param keep An object with operator(const NeighborBond&) returning whether to keep the bond.
+     */
+    template<typename Predicate>
+    NeighborList* toNeighborList(bool sort_by_distance, unsigned int columns, const Predicate& keep)
+    {
+        FREUD_PROFILE_SCOPE("NeighborQuery::toNeighborList");
+        if (columns != NO_COLUMNS && parallel::getMemoryBudget() != 0 && hasMinimumImageBonds()
+            && !parallel::fitsMemoryBudget(estimateNeighborListMemory(columns)))
+        {
+            columns = NO_COLUMNS;
+        }
+
+        // Bonds are gathered into chunks of query points of similar cost,
+        // visited in the preferred query order. Each per-point iterator only
+        // produces bonds for its own query point, so sorting the bonds of
+        // each point and placing them at the offset of their query point
+        // produces a globally sorted list without a global sort.
+        const size_t num_chunks = std::min<size_t>(
+            m_num_query_points,
+            TOLIST_CHUNKS_PER_THREAD * std::max(parallel::maxConcurrency(), 1));
+        const std::vector<size_t> chunk_bounds = getBalancedRanges(num_chunks);
+        const auto compare = sort_by_distance ? compareNeighborDistance : compareNeighborBond;
+        const bool store_bonds = columns != NO_COLUMNS;
+
+        std::vector<std::vector<NeighborBond>> chunk_bonds(store_bonds ? num_chunks : 0);
+        std::vector<std::vector<unsigned int>> chunk_point_indices(store_bonds ? 0 : num_chunks);
+        std::vector<size_t> point_offsets(m_num_query_points + 1, 0);
+        {
+            FREUD_PROFILE_SCOPE("NeighborQuery::toNeighborList::query");
+            util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+                NeighborBond nb;
+                std::shared_ptr<NeighborQueryPerPointIterator> it;
+                std::vector<NeighborBond> point_bonds;
+                for (size_t chunk = begin; chunk < end; ++chunk)
+                {
+                    std::vector<NeighborBond>& local_bonds = store_bonds ? chunk_bonds[chunk] : point_bonds;
+                    for (size_t k = chunk_bounds[chunk]; k < chunk_bounds[chunk + 1]; ++k)
+                    {
+                        const unsigned int i = getQueryPointIdx(k);
+                        if (!store_bonds)
+                        {
+                            point_bonds.clear();
+                        }
+                        const size_t point_begin = local_bonds.size();
+                        this->query(i, it);
+                        while (!it->end())
+                        {
+                            nb = it->next();
+                            // If we're excluding ii bonds, we have to check before adding.
+                            if (nb != ITERATOR_TERMINATOR && keep(nb))
+                            {
+                                local_bonds.emplace_back(nb.getQueryPointIdx(), nb.getPointIdx(),
+                                                         nb.getWeight(), nb.getVector());
+                            }
+                        }
+                        std::sort(local_bonds.begin() + point_begin, local_bonds.end(), compare);
+                        point_offsets[i + 1] = local_bonds.size() - point_begin;
+                        if (!store_bonds)
+                        {
+                            for (const auto& bond : point_bonds)
+                            {
+                                chunk_point_indices[chunk].push_back(bond.getPointIdx());
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        // Compute the offset of each query point in the final list.
+        for (size_t i = 0; i < m_num_query_points; ++i)
+        {
+            point_offsets[i + 1] += point_offsets[i];
+        }
+        const unsigned int num_bonds = point_offsets[m_num_query_points];
+
+        auto* nl = new NeighborList();
+        if (columns != ALL_COLUMNS)
+        {
+            nl->setStoredColumns(columns, m_neighbor_query->getBox(), m_neighbor_query->getPoints(),
+                                 m_neighbor_query->getNPoints(), m_query_points, m_num_query_points);
+        }
+        nl->setNumBonds(num_bonds, m_num_query_points, m_neighbor_query->getNPoints());
+
+        FREUD_PROFILE_SCOPE("NeighborQuery::toNeighborList::copy");
+        FREUD_PROFILE_COUNT("NeighborQuery::toNeighborList::bonds", num_bonds);
+        util::forLoopWrapper(0, num_chunks, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk)
             {
-                std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(i);
-                while (!it->end())
+                size_t local_bond = 0;
+                for (size_t k = chunk_bounds[chunk]; k < chunk_bounds[chunk + 1]; ++k)
                 {
-                    nb = it->next();
-                    // If we're excluding ii bonds, we have to check before adding.
-                    if (nb != ITERATOR_TERMINATOR)
+                    const unsigned int i = getQueryPointIdx(k);
+                    for (size_t bond = point_offsets[i]; bond < point_offsets[i + 1]; ++bond)
                     {
-                        local_bonds.emplace_back(nb.getQueryPointIdx(), nb.getPointIdx(), nb.getWeight(),
-                                                 nb.getVector());
+                        if (store_bonds)
+                        {
+                            nl->setNeighborEntry(bond, chunk_bonds[chunk][local_bond++]);
+                        }
+                        else
+                        {
+                            nl->setNeighborPair(bond, i, chunk_point_indices[chunk][local_bond++]);
+                        }
                     }
                 }
+                // Release each chunk as soon as it has been copied.
+                if (store_bonds)
+                {
+                    std::vector<NeighborBond>().swap(chunk_bonds[chunk]);
+                }
+                else
+                {
+                    std::vector<unsigned int>().swap(chunk_point_indices[chunk]);
+                }
             }
         });
 
-        tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
-        std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
-        if (sort_by_distance)
+        return nl;
+    }
+
+    //! Copy the bonds of the next query points into arrays of at most max_bonds bonds.
+    /*! Chunks let callers stream the bonds of queries too large to store in
+     *  a NeighborList. Concatenating the chunks gives the bonds in the order
+     *  of toNeighborList: the query points are visited in index order, and
+     *  the bonds of each query point are sorted by point index. The query
+     *  points are queried in parallel batches sized to fill about one chunk,
+     *  and the bonds that do not fit in a chunk are kept for the next one,
+     *  so about two chunks of bonds are stored at a time.
+     *
+     *  \param max_bonds The maximum number of bonds to copy.
+     *  \param query_point_indices Output array of max_bonds query point indices.
+     *  \param point_indices Output array of max_bonds point indices.
+     *  \param distances Output array of max_bonds distances.
+     *  \returns The number of bonds copied, which is 0 once all bonds have been copied.
+     */
+    unsigned int nextChunk(unsigned int max_bonds, unsigned int* query_point_indices,
+                           unsigned int* point_indices, float* distances)
+    {
+        if (max_bonds == 0)
         {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborDistance);
+            throw std::invalid_argument("NeighborQuery chunks must hold at least one bond.");
         }
-        else
+        while (m_chunk_bonds.size() - m_chunk_pos < max_bonds && m_chunk_next_point < m_num_query_points)
         {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
+            queryChunkBatch(max_bonds - (m_chunk_bonds.size() - m_chunk_pos));
         }
 
-        unsigned int num_bonds = linear_bonds.size();
+        const auto num_bonds
+            = static_cast<unsigned int>(std::min<size_t>(max_bonds, m_chunk_bonds.size() - m_chunk_pos));
+        for (unsigned int bond = 0; bond < num_bonds; ++bond)
+        {
+            const NeighborBond& nb = m_chunk_bonds[m_chunk_pos + bond];
+            query_point_indices[bond] = nb.getQueryPointIdx();
+            point_indices[bond] = nb.getPointIdx();
+            distances[bond] = nb.getDistance();
+        }
+        m_chunk_pos += num_bonds;
+        return num_bonds;
+    }
 
-        auto* nl = new NeighborList();
-        nl->setNumBonds(num_bonds, m_num_query_points, m_neighbor_query->getNPoints());
+    //! Obtain one NeighborList per cutoff distance from a single query.
+    /*! Pipelines that run several computes on the same points with different
+     *  cutoffs (e.g. an RDF, Steinhardt order parameters and clusters) can
+     *  traverse the neighbor finding structure once at the largest cutoff
+     *  instead of once per compute. The list for each cutoff r_max holds the
+     *  bonds of this query with distances less than r_max, in the order of
+     *  toNeighborList. Bonds beyond the largest cutoff are discarded during
+     *  the query, and the list for the largest cutoff is filtered into the
+     *  other lists.
+     *
+     *  The caller is responsible for deleting the returned NeighborLists.
+     *
+     *  \param r_maxs The cutoff distance of each NeighborList.
+     *  \param sort_by_distance Whether to sort the bonds of each query point by distance.
+     *  \param columns Bitwise or of the NeighborListColumns to store.
+     */
+    std::vector<NeighborList*> toNeighborLists(const std::vector<float>& r_maxs,
+                                               bool sort_by_distance = false,
+                                               unsigned int columns = ALL_COLUMNS)
+    {
+        if (r_maxs.empty())
+        {
+            throw std::invalid_argument("NeighborQuery requires at least one cutoff distance.");
+        }
+        if (*std::min_element(r_maxs.begin(), r_maxs.end()) <= 0)
+        {
+            throw std::invalid_argument("NeighborQuery requires all cutoff distances to be positive.");
+        }
+        const auto largest = std::max_element(r_maxs.begin(), r_maxs.end());
+        const float r_max = *largest;
+
+        std::vector<NeighborList*> nlists(r_maxs.size(), nullptr);
+        try
+        {
+            const auto keep = [r_max](const NeighborBond& nb) { return nb.getDistance() < r_max; };
+            nlists[largest - r_maxs.begin()] = toNeighborList(sort_by_distance, columns, keep);
+            const NeighborList* all = nlists[largest - r_maxs.begin()];
+            for (size_t i = 0; i < r_maxs.size(); ++i)
+            {
+                if (nlists[i] == nullptr)
+                {
+                    nlists[i] = all->filteredCopy_r(r_maxs[i]);
+                }
+            }
+        }
+        catch (...)
+        {
+            for (auto* nlist : nlists)
+            {
+                delete nlist;
+            }
+            throw;
+        }
+        return nlists;
+    }
 
-        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-            for (size_t bond = begin; bond < end; ++bond)
+protected:
+    //! Check whether every bond of the query is to the nearest periodic image of its point.
+    bool hasMinimumImageBonds() const
+    {
+        if (m_qargs.mode != QueryType::ball)
+        {
+            return true;
+        }
+        const box::Box& box = m_neighbor_query->getBox();
+        const vec3<float> plane_distance = box.getNearestPlaneDistance();
+        float min_plane_distance = std::min(plane_distance.x, plane_distance.y);
+        if (!box.is2D())
+        {
+            min_plane_distance = std::min(min_plane_distance, plane_distance.z);
+        }
+        return m_qargs.r_max < min_plane_distance / 2;
+    }
+
+    //! Query the next batch of query points of nextChunk, appending their bonds to the pending bonds.
+    /*! \param target_bonds The number of bonds the batch should find.
+     */
+    void queryChunkBatch(size_t target_bonds)
+    {
+        m_chunk_bonds.erase(m_chunk_bonds.begin(), m_chunk_bonds.begin() + m_chunk_pos);
+        m_chunk_pos = 0;
+
+        // The batch size is predicted from the bonds per query point found
+        // so far, or from the estimated cost of the first query.
+        const unsigned int first_point = m_chunk_next_point;
+        const double bonds_per_point = first_point != 0
+            ? static_cast<double>(m_chunk_num_found) / first_point
+            : m_neighbor_query->estimateQueryCost(m_query_points[0], m_qargs) - QUERY_FIXED_COST;
+        const size_t num_points = std::min<size_t>(
+            m_num_query_points - first_point,
+            std::max(1.0, std::ceil(static_cast<double>(target_bonds) / std::max(bonds_per_point, 1.0))));
+        const size_t num_ranges = std::min<size_t>(
+            num_points, TOLIST_CHUNKS_PER_THREAD * std::max(parallel::maxConcurrency(), 1));
+
+        // Each range of query points is queried into its own buffer, which
+        // is kept between batches to reuse its memory.
+        m_chunk_range_bonds.resize(std::max(m_chunk_range_bonds.size(), num_ranges));
+        util::forLoopWrapper(0, num_ranges, [&](size_t begin, size_t end) {
+            NeighborBond nb;
+            std::shared_ptr<NeighborQueryPerPointIterator> it;
+            for (size_t range = begin; range < end; ++range)
             {
-                nl->setNeighborEntry(bond, linear_bonds[bond]);
+                std::vector<NeighborBond>& range_bonds = m_chunk_range_bonds[range];
+                range_bonds.clear();
+                const size_t range_end = first_point + (range + 1) * num_points / num_ranges;
+                for (size_t i = first_point + range * num_points / num_ranges; i < range_end; ++i)
+                {
+                    const size_t point_begin = range_bonds.size();
+                    this->query(i, it);
+                    while (!it->end())
+                    {
+                        nb = it->next();
+                        if (nb != ITERATOR_TERMINATOR)
+                        {
+                            range_bonds.push_back(nb);
+                        }
+                    }
+                    std::sort(range_bonds.begin() + point_begin, range_bonds.end(), compareNeighborBond);
+                }
             }
         });
 
-        return nl;
+        std::vector<size_t> range_offsets(num_ranges + 1, m_chunk_bonds.size());
+        for (size_t range = 0; range < num_ranges; ++range)
+        {
+            range_offsets[range + 1] = range_offsets[range] + m_chunk_range_bonds[range].size();
+        }
+        m_chunk_bonds.resize(range_offsets[num_ranges]);
+        util::forLoopWrapper(0, num_ranges, [&](size_t begin, size_t end) {
+            for (size_t range = begin; range < end; ++range)
+            {
+                std::copy(m_chunk_range_bonds[range].begin(), m_chunk_range_bonds[range].end(),
+                          m_chunk_bonds.begin() + range_offsets[range]);
+            }
+        });
+        m_chunk_num_found += range_offsets[num_ranges] - range_offsets[0];
+        m_chunk_next_point += static_cast<unsigned int>(num_points);
     }
 
-protected:
     const NeighborQuery* m_neighbor_query;                 //!< Link to the NeighborQuery object.
     const vec3<float>* m_query_points;                     //!< Coordinates of the query points.
     unsigned int m_num_query_points;                       //!< The number of query points.
@@ -437,6 +987,13 @@ protected:
 
     bool m_finished; //!< Flag to indicate that iteration is complete (must be set by next on termination).
     unsigned int m_cur_p; //!< The current particle under consideration.
+    const unsigned int* m_query_order {nullptr}; //!< Preferred order of the query points, if any.
+
+    std::vector<NeighborBond> m_chunk_bonds;                    //!< Bonds found but not yet copied.
+    size_t m_chunk_pos {0};                                     //!< Index of the first pending bond.
+    unsigned int m_chunk_next_point {0};                        //!< Next query point to query.
+    size_t m_chunk_num_found {0};                               //!< Number of bonds found so far.
+    std::vector<std::vector<NeighborBond>> m_chunk_range_bonds; //!< Bonds of each range of a batch.
 };
 
 }; }; // end namespace freud::locality
@@ -1,9 +1,13 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <stdexcept>
 
 #include "PeriodicBuffer.h"
+#include "utils.h"
 
 /*! \file PeriodicBuffer.cc
     \brief Replicates points across periodic boundaries.
@@ -11,6 +15,16 @@
 
 namespace freud { namespace locality {
 
+namespace {
+
+//! Widening of the range of candidate images along each axis, in fractional units of the box.
+/*! The range is computed analytically, so the widening only has to cover the
+ *  rounding of the exact check of each image.
+ */
+constexpr float IMAGE_RANGE_TOLERANCE = 1e-3;
+
+} // namespace
+
 void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
                              const bool use_images, const bool include_input_points)
 {
@@ -55,17 +69,41 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
         images.z = 0;
     }
 
-    m_buffer_points.clear();
-    m_buffer_ids.clear();
+    const unsigned int num_points = neighbor_query->getNPoints();
+    const vec3<float> buffer_lengths(m_buffer_box.getL());
 
-    // for each point
-    for (unsigned int point_id = 0; point_id < neighbor_query->getNPoints(); point_id++)
-    {
-        for (int i = use_images ? 0 : -images.x; i <= images.x; i++)
+    // Call a function on each candidate image of a point that belongs to the
+    // buffer, in the order of the image indices.
+    const auto for_each_image = [&](unsigned int point_id, const auto& function) {
+        const vec3<float> point = (*neighbor_query)[point_id];
+        vec3<int> first_image = use_images ? vec3<int>(0, 0, 0) : -images;
+        vec3<int> last_image = images;
+        if (!use_images)
         {
-            for (int j = use_images ? 0 : -images.y; j <= images.y; j++)
+            // The boxes have the same tilt factors, so along each axis the
+            // fractional coordinate of an image in the buffer box only
+            // depends on the image index along that axis. Images outside of
+            // the slightly widened range along any axis cannot pass the exact
+            // check below and are never generated.
+            const vec3<float> frac = m_box.makeFractional(point);
+            const auto prune = [](float f, float length, float buffer_length, int& first, int& last) {
+                const float half_width = float(0.5) * buffer_length / length + IMAGE_RANGE_TOLERANCE;
+                first = std::max(first, static_cast<int>(std::ceil(float(0.5) - f - half_width)));
+                last = std::min(last, static_cast<int>(std::floor(float(0.5) - f + half_width)));
+            };
+            prune(frac.x, L.x, buffer_lengths.x, first_image.x, last_image.x);
+            prune(frac.y, L.y, buffer_lengths.y, first_image.y, last_image.y);
+            if (!is2D)
             {
-                for (int k = use_images ? 0 : -images.z; k <= images.z; k++)
+                prune(frac.z, L.z, buffer_lengths.z, first_image.z, last_image.z);
+            }
+        }
+
+        for (int i = first_image.x; i <= last_image.x; i++)
+        {
+            for (int j = first_image.y; j <= last_image.y; j++)
+            {
+                for (int k = first_image.z; k <= last_image.z; k++)
                 {
                     // Skip the origin image
                     if (!include_input_points && i == 0 && j == 0 && k == 0)
@@ -75,7 +113,7 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
 
                     // Compute the new position for the buffer point,
                     // shifted by images.
-                    vec3<float> point_image = (*neighbor_query)[point_id];
+                    vec3<float> point_image = point;
                     point_image += float(i) * m_box.getLatticeVector(0);
                     point_image += float(j) * m_box.getLatticeVector(1);
                     if (!is2D)
@@ -91,8 +129,7 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
                         // have the correct number of points instead of
                         // relying on the floating point precision of the
                         // fractional check below.
-                        m_buffer_points.push_back(m_buffer_box.wrap(point_image));
-                        m_buffer_ids.push_back(point_id);
+                        function(m_buffer_box.wrap(point_image));
                     }
                     else
                     {
@@ -104,14 +141,53 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
                         if (0 <= buff_frac.x && buff_frac.x < 1 && 0 <= buff_frac.y && buff_frac.y < 1
                             && (is2D || (0 <= buff_frac.z && buff_frac.z < 1)))
                         {
-                            m_buffer_points.push_back(point_image);
-                            m_buffer_ids.push_back(point_id);
+                            function(point_image);
                         }
                     }
                 }
             }
         }
+    };
+
+    // Count the buffer points of each point. Every image is kept when a
+    // number of images is given, so only the skin distance needs a pass.
+    std::vector<size_t> offsets(num_points + 1, 0);
+    if (use_images)
+    {
+        const size_t num_images = static_cast<size_t>(images.x + 1) * (images.y + 1) * (images.z + 1)
+            - (include_input_points ? 0 : 1);
+        for (unsigned int point_id = 0; point_id < num_points; point_id++)
+        {
+            offsets[point_id + 1] = num_images;
+        }
     }
+    else
+    {
+        util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+            for (size_t point_id = begin; point_id < end; ++point_id)
+            {
+                size_t count = 0;
+                for_each_image(point_id, [&](const vec3<float>& /*point_image*/) { ++count; });
+                offsets[point_id + 1] = count;
+            }
+        });
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Write the buffer points of each point at its offset.
+    m_buffer_points.resize(offsets[num_points]);
+    m_buffer_ids.resize(offsets[num_points]);
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t point_id = begin; point_id < end; ++point_id)
+        {
+            size_t buffer_id = offsets[point_id];
+            for_each_image(point_id, [&](const vec3<float>& point_image) {
+                m_buffer_points[buffer_id] = point_image;
+                m_buffer_ids[buffer_id] = point_id;
+                ++buffer_id;
+            });
+        }
+    });
 }
 
 }; }; // end namespace freud::locality
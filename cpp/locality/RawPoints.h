@@ -36,6 +36,17 @@ public:
 
     ~RawPoints() override = default;
 
+    //! Replace the box and points, updating the underlying AABBQuery if it has been created.
+    void updatePoints(const box::Box& box, const vec3<float>* points, unsigned int n_points) override
+    {
+        validatePoints(box, points, n_points);
+        setPoints(box, points, n_points);
+        if (aq)
+        {
+            aq->updatePoints(box, points, n_points);
+        }
+    }
+
     //! Perform a query based on a set of query parameters.
     /*! Shadow parent function to ensure that the underlying AABBQuery is
      * only constructed when this object is actually queried. Note that unlike
@@ -70,6 +81,12 @@ public:
         return aq->querySingle(query_point, query_point_idx, qargs);
     }
 
+    //! Get the AABBQuery that performs queries, or nullptr if this object has not been queried yet.
+    const AABBQuery* getAABBQuery() const
+    {
+        return aq.get();
+    }
+
 private:
     mutable std::unique_ptr<AABBQuery> aq; //!< The AABBQuery object that will be used to perform queries.
 };
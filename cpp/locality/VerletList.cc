@@ -0,0 +1,105 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+
+#include "VerletList.h"
+#include "utils.h"
+
+/*! \file VerletList.cc
+    \brief Reuses a neighbor list built with a skin distance across frames.
+*/
+
+namespace freud { namespace locality {
+
+VerletList::VerletList(float r_max, float skin, bool exclude_ii)
+    : m_r_max(r_max), m_skin(skin), m_exclude_ii(exclude_ii),
+      m_candidate_nlist(std::make_shared<NeighborList>()), m_nlist(std::make_shared<NeighborList>())
+{
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("VerletList requires r_max to be positive.");
+    }
+    if (skin < 0)
+    {
+        throw std::invalid_argument("VerletList requires skin to be non-negative.");
+    }
+}
+
+void VerletList::reset()
+{
+    m_reference_points.clear();
+    m_candidate_nlist = std::make_shared<NeighborList>();
+    m_nlist = std::make_shared<NeighborList>();
+    m_rebuilt = false;
+}
+
+bool VerletList::needsRebuild(const box::Box& box, const vec3<float>* points, unsigned int n_points) const
+{
+    if (m_reference_points.size() != n_points || m_reference_box != box)
+    {
+        return true;
+    }
+
+    // Find the largest displacement of any point since the last build.
+    const float max_displacement_sq = (m_skin / float(2.0)) * (m_skin / float(2.0));
+    tbb::enumerable_thread_specific<bool> moved_too_far(false);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        bool& local_moved = moved_too_far.local();
+        for (size_t i = begin; i < end && !local_moved; ++i)
+        {
+            const vec3<float> delta = box.wrap(points[i] - m_reference_points[i]);
+            local_moved = dot(delta, delta) > max_displacement_sq;
+        }
+    });
+    for (const auto& local_moved : moved_too_far)
+    {
+        if (local_moved)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VerletList::compute(const NeighborQuery* nq)
+{
+    const box::Box& box = nq->getBox();
+    const vec3<float>* points = nq->getPoints();
+    const unsigned int n_points = nq->getNPoints();
+
+    m_rebuilt = needsRebuild(box, points, n_points);
+    if (m_rebuilt)
+    {
+        QueryArgs qargs;
+        qargs.mode = QueryType::ball;
+        qargs.r_max = m_r_max + m_skin;
+        qargs.exclude_ii = m_exclude_ii;
+        m_candidate_nlist = std::shared_ptr<NeighborList>(nq->query(points, n_points, qargs)->toNeighborList());
+        m_reference_points.assign(points, points + n_points);
+        m_reference_box = box;
+        ++m_num_rebuilds;
+    }
+    else
+    {
+        // Refresh the cached bonds from the current positions. The bond
+        // topology is unchanged, so the segment offsets remain valid.
+        const unsigned int* neighbors = m_candidate_nlist->getNeighbors().get();
+        const float* weights = m_candidate_nlist->getWeights().get();
+        util::forLoopWrapper(0, m_candidate_nlist->getNumBonds(), [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                const unsigned int i = neighbors[2 * bond];
+                const unsigned int j = neighbors[2 * bond + 1];
+                const vec3<float> r_ij = box.wrap(points[j] - points[i]);
+                m_candidate_nlist->setNeighborEntry(bond, NeighborBond(i, j, weights[bond], r_ij));
+            }
+        });
+    }
+
+    m_nlist = std::make_shared<NeighborList>(*m_candidate_nlist);
+    m_nlist->filter_r(m_r_max);
+}
+
+}; }; // end namespace freud::locality
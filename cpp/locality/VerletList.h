@@ -0,0 +1,107 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef VERLET_LIST_H
+#define VERLET_LIST_H
+
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file VerletList.h
+    \brief Reuses a neighbor list built with a skin distance across frames.
+*/
+
+namespace freud { namespace locality {
+
+//! Neighbor list that is reused across frames until points move too far.
+/*! A VerletList performs a ball query with a cutoff of r_max + skin and caches
+ *  the resulting candidate bonds along with the positions the query was built
+ *  from. On subsequent calls to compute, the candidate list is only rebuilt
+ *  when any point has moved more than skin / 2 from its reference position (or
+ *  when the box or number of points changes). Otherwise, the vectors and
+ *  distances of the cached candidate bonds are recomputed from the current
+ *  positions and filtered down to r_max. This is exact: no pair can move from
+ *  beyond r_max + skin to within r_max without one of its points moving more
+ *  than skin / 2.
+ *
+ *  The query is always a self-query of the points of the NeighborQuery.
+ */
+class VerletList
+{
+public:
+    //! Constructor
+    /*! \param r_max The neighbor cutoff distance.
+     *  \param skin The extra distance added to r_max when building the candidate list.
+     *  \param exclude_ii Whether or not to exclude self-neighbors.
+     */
+    VerletList(float r_max, float skin, bool exclude_ii);
+
+    //! Compute the neighbor list for the points of a NeighborQuery, reusing cached bonds when possible.
+    void compute(const NeighborQuery* nq);
+
+    //! Discard the cached candidate list so that the next compute rebuilds it.
+    void reset();
+
+    //! Get the neighbor list within r_max from the last call to compute.
+    std::shared_ptr<NeighborList> getNeighborList() const
+    {
+        return m_nlist;
+    }
+
+    //! Get the cached candidate neighbor list within r_max + skin.
+    std::shared_ptr<NeighborList> getCandidateNeighborList() const
+    {
+        return m_candidate_nlist;
+    }
+
+    //! Whether the last call to compute rebuilt the candidate list.
+    bool getRebuilt() const
+    {
+        return m_rebuilt;
+    }
+
+    //! The number of times the candidate list has been built.
+    unsigned int getNumRebuilds() const
+    {
+        return m_num_rebuilds;
+    }
+
+    float getRMax() const
+    {
+        return m_r_max;
+    }
+
+    float getSkin() const
+    {
+        return m_skin;
+    }
+
+    bool getExcludeII() const
+    {
+        return m_exclude_ii;
+    }
+
+private:
+    //! Check whether the candidate list must be rebuilt for the given points.
+    bool needsRebuild(const box::Box& box, const vec3<float>* points, unsigned int n_points) const;
+
+    float m_r_max;              //!< Neighbor cutoff distance.
+    float m_skin;               //!< Extra cutoff distance of the candidate list.
+    bool m_exclude_ii;          //!< Whether or not to exclude self-neighbors.
+    bool m_rebuilt {false};     //!< Whether the last compute rebuilt the candidate list.
+    unsigned int m_num_rebuilds {0}; //!< Number of candidate list builds.
+
+    box::Box m_reference_box;                    //!< Box the candidate list was built in.
+    std::vector<vec3<float>> m_reference_points; //!< Positions the candidate list was built from.
+    std::shared_ptr<NeighborList> m_candidate_nlist; //!< Cached bonds within r_max + skin.
+    std::shared_ptr<NeighborList> m_nlist;           //!< Bonds within r_max.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // VERLET_LIST_H
@@ -4,10 +4,13 @@
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <utility>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
 #include <vector>
 
 #include "NeighborBond.h"
+#include "Profiler.h"
 #include "Voronoi.h"
 
 /*! \file Voronoi.cc
@@ -19,10 +22,15 @@ namespace freud { namespace locality {
 // Voronoi calculations should be kept in double precision.
 void Voronoi::compute(const freud::locality::NeighborQuery* nq)
 {
+    FREUD_PROFILE_SCOPE("Voronoi::compute");
     m_box = nq->getBox();
     const auto n_points = nq->getNPoints();
 
-    m_polytopes.resize(n_points);
+    m_polytopes.clear();
+    if (m_compute_polytopes)
+    {
+        m_polytopes.resize(n_points);
+    }
     m_volumes.prepare(n_points);
 
     const vec3<float> v1 = m_box.getLatticeVector(0);
@@ -49,153 +57,194 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
         container.put(query_point_id, query_point.x, query_point.y, query_point.z);
     }
 
-    voro::voronoicell_neighbor cell;
-    voro::c_loop_all_periodic voronoi_loop(container);
-    std::vector<double> face_areas;
-    std::vector<int> face_vertices;
-    std::vector<int> neighbors;
-    std::vector<double> normals;
-    std::vector<double> vertices;
-    std::vector<NeighborBond> bonds;
-
-    if (voronoi_loop.start())
-    {
-        do
+    // The container creates periodic images of its blocks lazily while
+    // computing cells. Creating all of them up front makes the container
+    // read-only during the computation, so its blocks can be split between
+    // threads. Each thread uses its own voro_compute, which holds the search
+    // state that container_periodic::compute_cell would otherwise share.
+    container.create_all_images();
+    const int num_blocks_x = container.nx;
+    const int num_blocks_y = container.ny;
+    const int num_blocks_z = container.nz;
+
+    using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
+    BondVector thread_bonds;
+
+    const size_t num_blocks = static_cast<size_t>(num_blocks_x) * num_blocks_y * num_blocks_z;
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        BondVector::reference local_bonds(thread_bonds.local());
+        voro::voro_compute<voro::container_periodic> cell_compute(
+            container, 2 * container.nx + 1, 2 * container.ey + 1, 2 * container.ez + 1);
+        voro::voronoicell_neighbor cell;
+        std::vector<double> face_areas;
+        std::vector<int> face_vertices;
+        std::vector<int> neighbors;
+        std::vector<double> normals;
+        std::vector<double> vertices;
+
+        for (size_t block = begin; block < end; ++block)
         {
-            container.compute_cell(cell, voronoi_loop);
-
-            // Get id and position of current particle
-            const int query_point_id(voronoi_loop.pid());
-            vec3<double> query_point(voronoi_loop.x(), voronoi_loop.y(), voronoi_loop.z());
-
-            // Get Voronoi cell properties
-            cell.face_areas(face_areas);
-            cell.face_vertices(face_vertices);
-            cell.neighbors(neighbors);
-            cell.normals(normals);
-            cell.vertices(query_point.x, query_point.y, query_point.z, vertices);
-
-            // Compute polytope vertices in relative coordinates
-            std::vector<vec3<double>> relative_vertices;
-            auto vertex_iterator = vertices.begin();
-            while (vertex_iterator != vertices.end())
+            // Blocks of the primary domain, in the same order as c_loop_all_periodic.
+            const int block_i = static_cast<int>(block % num_blocks_x);
+            const int block_j = container.ey + static_cast<int>((block / num_blocks_x) % num_blocks_y);
+            const int block_k = container.ez + static_cast<int>(block / (num_blocks_x * num_blocks_y));
+            const int ijk = block_i + container.nx * (block_j + container.oy * block_k);
+
+            for (int q = 0; q < container.co[ijk]; ++q)
             {
-                double vert_x = *vertex_iterator;
-                vertex_iterator++;
-                double vert_y = *vertex_iterator;
-                vertex_iterator++;
-                double vert_z = *vertex_iterator;
-                vertex_iterator++;
-
-                // In 2D systems, only use vertices from the upper plane
-                // to prevent double-counting, and set z=0 manually
-                if (m_box.is2D())
+                if (!cell_compute.compute_cell(cell, ijk, q, block_i, block_j, block_k))
+                {
+                    continue;
+                }
+
+                // Get id and position of current particle
+                const int query_point_id(container.id[ijk][q]);
+                vec3<double> query_point(container.p[ijk][3 * q], container.p[ijk][3 * q + 1],
+                                         container.p[ijk][3 * q + 2]);
+
+                // Get Voronoi cell properties
+                cell.face_areas(face_areas);
+                cell.face_vertices(face_vertices);
+                cell.neighbors(neighbors);
+                cell.normals(normals);
+                cell.vertices(query_point.x, query_point.y, query_point.z, vertices);
+
+                if (m_compute_polytopes)
                 {
-                    if (vert_z < 0)
+                    // Compute polytope vertices in relative coordinates
+                    std::vector<vec3<double>> relative_vertices;
+                    auto vertex_iterator = vertices.begin();
+                    while (vertex_iterator != vertices.end())
                     {
-                        continue;
+                        double vert_x = *vertex_iterator;
+                        vertex_iterator++;
+                        double vert_y = *vertex_iterator;
+                        vertex_iterator++;
+                        double vert_z = *vertex_iterator;
+                        vertex_iterator++;
+
+                        // In 2D systems, only use vertices from the upper plane
+                        // to prevent double-counting, and set z=0 manually
+                        if (m_box.is2D())
+                        {
+                            if (vert_z < 0)
+                            {
+                                continue;
+                            }
+                            vert_z = 0;
+                        }
+                        vec3<double> delta = vec3<double>(vert_x, vert_y, vert_z) - query_point;
+                        relative_vertices.push_back(delta);
                     }
-                    vert_z = 0;
+
+                    // Sort relative vertices by their angle in 2D systems
+                    if (m_box.is2D())
+                    {
+                        std::sort(relative_vertices.begin(), relative_vertices.end(),
+                                  [](const vec3<double>& a, const vec3<double>& b) {
+                                      return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+                                  });
+                    }
+
+                    // Save polytope vertices in system coordinates
+                    const vec3<double>& query_point_system_coords((*nq)[query_point_id]);
+
+                    std::vector<vec3<double>> system_vertices;
+                    system_vertices.reserve(relative_vertices.size());
+                    std::transform(relative_vertices.begin(), relative_vertices.end(),
+                                   std::back_inserter(system_vertices), [&](const auto& relative_vertex) {
+                                       return relative_vertex + query_point_system_coords;
+                                   });
+                    m_polytopes[query_point_id] = std::move(system_vertices);
                 }
-                vec3<double> delta = vec3<double>(vert_x, vert_y, vert_z) - query_point;
-                relative_vertices.push_back(delta);
-            }
 
-            // Sort relative vertices by their angle in 2D systems
-            if (m_box.is2D())
-            {
-                std::sort(relative_vertices.begin(), relative_vertices.end(),
-                          [](const vec3<double>& a, const vec3<double>& b) {
-                              return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
-                          });
-            }
+                // Save cell volume
+                m_volumes[query_point_id] = cell.volume();
 
-            // Save polytope vertices in system coordinates
-            const vec3<double>& query_point_system_coords((*nq)[query_point_id]);
-
-            std::vector<vec3<double>> system_vertices;
-            system_vertices.reserve(relative_vertices.size());
-            std::transform(
-                relative_vertices.begin(), relative_vertices.end(), std::back_inserter(system_vertices),
-                [&](const auto& relative_vertex) { return relative_vertex + query_point_system_coords; });
-            m_polytopes[query_point_id] = system_vertices;
-
-            // Save cell volume
-            m_volumes[query_point_id] = cell.volume();
-
-            // Compute cell neighbors
-            size_t neighbor_counter(0);
-            size_t face_vertices_index(0);
-            for (auto neighbor_iterator = neighbors.begin(); neighbor_iterator != neighbors.end();
-                 ++neighbor_iterator, ++neighbor_counter,
-                      face_vertices_index += face_vertices[face_vertices_index] + 1)
-            {
-                // Get the normal to the current face
-                const vec3<double> normal(normals[3 * neighbor_counter], normals[3 * neighbor_counter + 1],
-                                          normals[3 * neighbor_counter + 2]);
-
-                // Ignore bonds in 2D systems that point up or down. This check
-                // should only be dealing with bonds whose normal vectors' z
-                // components are -1, 0, or +1 (within some tolerance). This
-                // also skips bonds where the normal vector is exactly zero.
-                // A normal vector of exactly zero seems to appear for certain
-                // particles in 2D systems where the neighbors are very close.
-                // It seems like an issue of numerical imprecision but could be
-                // some other pathological case.
-                if (m_box.is2D() && std::abs(normal.z) > 0.5
-                    || (normal.x == 0 && normal.y == 0 && normal.z == 0))
+                // Compute cell neighbors
+                size_t neighbor_counter(0);
+                size_t face_vertices_index(0);
+                for (auto neighbor_iterator = neighbors.begin(); neighbor_iterator != neighbors.end();
+                     ++neighbor_iterator, ++neighbor_counter,
+                          face_vertices_index += face_vertices[face_vertices_index] + 1)
                 {
-                    continue;
-                }
+                    // Get the normal to the current face
+                    const vec3<double> normal(normals[3 * neighbor_counter],
+                                              normals[3 * neighbor_counter + 1],
+                                              normals[3 * neighbor_counter + 2]);
+
+                    // Ignore bonds in 2D systems that point up or down. This check
+                    // should only be dealing with bonds whose normal vectors' z
+                    // components are -1, 0, or +1 (within some tolerance). This
+                    // also skips bonds where the normal vector is exactly zero.
+                    // A normal vector of exactly zero seems to appear for certain
+                    // particles in 2D systems where the neighbors are very close.
+                    // It seems like an issue of numerical imprecision but could be
+                    // some other pathological case.
+                    if (m_box.is2D() && std::abs(normal.z) > 0.5
+                        || (normal.x == 0 && normal.y == 0 && normal.z == 0))
+                    {
+                        continue;
+                    }
 
-                // Fetch neighbor information
-                const int point_id = *neighbor_iterator;
-                const float weight(face_areas[neighbor_counter]);
-
-                // Find a vertex on the current face: this leverages the
-                // structure of face_vertices, which has a count of the
-                // number of vertices for a face followed by the
-                // corresponding vertex ids for that face. We use this
-                // structure later when incrementing face_vertices_index.
-                // face_vertices_index always points to the "vertex
-                // counter" element of face_vertices for the current face.
-
-                // Get the id of the vertex on this face that is most parallel to the normal
-                const auto normal_length = std::sqrt(dot(normal, normal));
-                auto cosine_vertex_to_normal = [&](const auto& vertex_id_on_face) {
+                    // Fetch neighbor information
+                    const int point_id = *neighbor_iterator;
+                    const float weight(face_areas[neighbor_counter]);
+
+                    // Find a vertex on the current face: this leverages the
+                    // structure of face_vertices, which has a count of the
+                    // number of vertices for a face followed by the
+                    // corresponding vertex ids for that face. We use this
+                    // structure later when incrementing face_vertices_index.
+                    // face_vertices_index always points to the "vertex
+                    // counter" element of face_vertices for the current face.
+
+                    // Get the id of the vertex on this face that is most parallel to the normal
+                    const auto normal_length = std::sqrt(dot(normal, normal));
+                    auto cosine_vertex_to_normal = [&](const auto& vertex_id_on_face) {
+                        const vec3<double> rv(vertices[3 * vertex_id_on_face],
+                                              vertices[3 * vertex_id_on_face + 1],
+                                              vertices[3 * vertex_id_on_face + 2]);
+                        const vec3<double> riv(rv - query_point);
+                        return dot(riv, normal) / std::sqrt(dot(riv, riv)) / normal_length;
+                    };
+
+                    const int vertex_id_on_face = *std::max_element(
+                        &(face_vertices[face_vertices_index + 1]),
+                        &(face_vertices[face_vertices_index + face_vertices[face_vertices_index]]),
+                        [&](const auto& a, const auto& b) {
+                            return cosine_vertex_to_normal(a) < cosine_vertex_to_normal(b);
+                        });
+
+                    // Project the vertex vector onto the face normal to get a
+                    // vector from query_point to the face, then double it to
+                    // get the vector to the neighbor particle.
                     const vec3<double> rv(vertices[3 * vertex_id_on_face],
                                           vertices[3 * vertex_id_on_face + 1],
                                           vertices[3 * vertex_id_on_face + 2]);
                     const vec3<double> riv(rv - query_point);
-                    return dot(riv, normal) / std::sqrt(dot(riv, riv)) / normal_length;
-                };
-
-                const int vertex_id_on_face = *std::max_element(
-                    &(face_vertices[face_vertices_index + 1]),
-                    &(face_vertices[face_vertices_index + face_vertices[face_vertices_index]]),
-                    [&](const auto& a, const auto& b) {
-                        return cosine_vertex_to_normal(a) < cosine_vertex_to_normal(b);
-                    });
-
-                // Project the vertex vector onto the face normal to get a
-                // vector from query_point to the face, then double it to
-                // get the vector to the neighbor particle.
-                const vec3<double> rv(vertices[3 * vertex_id_on_face], vertices[3 * vertex_id_on_face + 1],
-                                      vertices[3 * vertex_id_on_face + 2]);
-                const vec3<double> riv(rv - query_point);
-                const vec3<float> vector(2.0 * dot(riv, normal) * normal);
-
-                bonds.emplace_back(query_point_id, point_id, weight, vector);
+                    const vec3<float> vector(2.0 * dot(riv, normal) * normal);
+
+                    local_bonds.emplace_back(query_point_id, point_id, weight, vector);
+                }
             }
+        }
+    });
 
-        } while (voronoi_loop.inc());
-    }
+    // The cells are computed by the time this timer starts, so the remaining
+    // time of the compute is spent building the neighbor list.
+    FREUD_PROFILE_SCOPE("Voronoi::compute::neighbor_list");
+    tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(thread_bonds);
+    std::vector<NeighborBond> bonds(flat_bonds.begin(), flat_bonds.end());
 
-    tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
-        return n1.less_id_ref_weight(n2);
+    parallel::execute([&]() {
+        tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
+            return n1.less_id_ref_weight(n2);
+        });
     });
 
     unsigned int num_bonds = bonds.size();
+    FREUD_PROFILE_COUNT("Voronoi::compute::bonds", num_bonds);
 
     m_neighbor_list->resize(num_bonds);
     m_neighbor_list->setNumBonds(num_bonds, n_points, n_points);
@@ -16,8 +16,14 @@ namespace freud { namespace locality {
 class Voronoi
 {
 public:
-    // default constructor
-    Voronoi() : m_neighbor_list(std::make_shared<NeighborList>()) {}
+    //! Constructor
+    /*! \param compute_polytopes Whether to store the vertices of each cell.
+     *         Without them, only the volumes and the weighted neighbor list
+     *         are computed, which saves the time and memory of the polytopes.
+     */
+    explicit Voronoi(bool compute_polytopes = true)
+        : m_neighbor_list(std::make_shared<NeighborList>()), m_compute_polytopes(compute_polytopes)
+    {}
 
     void compute(const freud::locality::NeighborQuery* nq);
 
@@ -41,11 +47,18 @@ public:
         return m_box;
     }
 
+    //! Return whether the vertices of each cell are stored.
+    bool getComputePolytopes() const
+    {
+        return m_compute_polytopes;
+    }
+
 private:
     box::Box m_box;
     std::shared_ptr<NeighborList> m_neighbor_list;      //!< Stored neighbor list
     std::vector<std::vector<vec3<double>>> m_polytopes; //!< Voronoi polytopes
     util::ManagedArray<double> m_volumes;               //!< Voronoi cell volumes
+    bool m_compute_polytopes;                           //!< Whether to store the polytopes
 };
 }; }; // end namespace freud::locality
 
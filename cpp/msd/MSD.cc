@@ -0,0 +1,133 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "Eigen/unsupported/Eigen/FFT"
+
+#include "MSD.h"
+#include "utils.h"
+
+/*! \file MSD.cc
+    \brief Computes the mean squared displacement of particles over a trajectory.
+*/
+
+namespace freud { namespace msd {
+
+namespace {
+
+//! Get the smallest size of at least n whose only prime factors are 2, 3 and 5.
+/*! FFTs of sizes with large prime factors are much slower, and any size of
+ *  at least 2 N - 1 is valid for the autocorrelation of N frames.
+ */
+size_t getFFTSize(size_t n)
+{
+    for (size_t size = n;; ++size)
+    {
+        size_t remainder = size;
+        for (const size_t factor : {2, 3, 5})
+        {
+            while (remainder % factor == 0)
+            {
+                remainder /= factor;
+            }
+        }
+        if (remainder == 1)
+        {
+            return size;
+        }
+    }
+}
+
+} // namespace
+
+void MSD::compute(const vec3<float>* positions, unsigned int num_frames, unsigned int num_particles)
+{
+    m_particle_msd.prepare({num_frames, num_particles});
+    if (num_frames == 0)
+    {
+        return;
+    }
+
+    util::forLoopWrapper(0, num_particles, [&](size_t begin, size_t end) {
+        if (m_window)
+        {
+            computeWindow(positions, num_frames, num_particles, begin, end);
+            return;
+        }
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (size_t t = 0; t < num_frames; ++t)
+            {
+                const vec3<double> delta = vec3<double>(positions[t * num_particles + i])
+                    - vec3<double>(positions[i]);
+                m_particle_msd[t * num_particles + i] = dot(delta, delta);
+            }
+        }
+    });
+}
+
+void MSD::computeWindow(const vec3<float>* positions, unsigned int num_frames, unsigned int num_particles,
+                        size_t begin, size_t end)
+{
+    // Padding the positions with zeros to at least 2 N - 1 frames makes the
+    // circular autocorrelation computed with FFTs equal to the linear one.
+    // Padding to 2 N frames also avoids FFTs of size 1, which are not supported.
+    const size_t fft_size = getFFTSize(2 * static_cast<size_t>(num_frames));
+    Eigen::FFT<double> fft;
+    std::vector<double> signal_x(fft_size, 0);
+    std::vector<double> signal_y(fft_size, 0);
+    std::vector<double> signal_z(fft_size, 0);
+    std::vector<std::complex<double>> spectrum;
+    std::vector<std::complex<double>> power(fft_size);
+    std::vector<double> autocorrelation;
+    std::vector<double> square_norms(num_frames);
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        for (size_t t = 0; t < num_frames; ++t)
+        {
+            const vec3<float>& position = positions[t * num_particles + i];
+            signal_x[t] = position.x;
+            signal_y[t] = position.y;
+            signal_z[t] = position.z;
+            square_norms[t]
+                = signal_x[t] * signal_x[t] + signal_y[t] * signal_y[t] + signal_z[t] * signal_z[t];
+        }
+
+        // The autocorrelation of the positions is the inverse transform of
+        // the sum of the power spectra of the three components.
+        std::fill(power.begin(), power.end(), 0.0);
+        for (const auto* signal : {&signal_x, &signal_y, &signal_z})
+        {
+            fft.fwd(spectrum, *signal);
+            for (size_t f = 0; f < fft_size; ++f)
+            {
+                power[f] += std::norm(spectrum[f]);
+            }
+        }
+        fft.inv(autocorrelation, power);
+
+        // The sum of r^2(k + m) + r^2(k) over all windows of lag m is updated
+        // from the sum for lag m - 1 by removing the frames m - 1 and N - m.
+        double square_norm_sum = 0;
+        for (size_t t = 0; t < num_frames; ++t)
+        {
+            square_norm_sum += square_norms[t];
+        }
+        square_norm_sum *= 2;
+        for (size_t m = 0; m < num_frames; ++m)
+        {
+            if (m > 0)
+            {
+                square_norm_sum -= square_norms[m - 1] + square_norms[num_frames - m];
+            }
+            const auto num_windows = static_cast<double>(num_frames - m);
+            m_particle_msd[m * num_particles + i] = (square_norm_sum - 2 * autocorrelation[m]) / num_windows;
+        }
+    }
+}
+
+}; }; // end namespace freud::msd
@@ -0,0 +1,68 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MSD_H
+#define MSD_H
+
+#include "ManagedArray.h"
+#include "VectorMath.h"
+
+/*! \file MSD.h
+    \brief Computes the mean squared displacement of particles over a trajectory.
+*/
+
+namespace freud { namespace msd {
+
+//! Computes the mean squared displacement of each particle over a trajectory.
+/*! In window mode, the MSD of lag m is averaged over all windows of m frames
+ *  of the trajectory,
+ *  \f$ MSD_i(m) = \frac{1}{N - m} \sum_{k=0}^{N-m-1} (r_i(k+m) - r_i(k))^2 \f$.
+ *  It is computed as \f$ S_1(m) - 2 S_2(m) \f$, where \f$ S_1 \f$ follows from
+ *  a running sum of the squared positions and \f$ S_2 \f$ is the
+ *  autocorrelation of the positions, which is computed with zero-padded FFTs
+ *  (Calandrini et al. 2011). In direct mode, the MSD of frame t is the
+ *  squared displacement from the first frame, \f$ (r_i(t) - r_i(0))^2 \f$.
+ *
+ *  The particles are independent, so the calculation is parallelized over
+ *  particles.
+ */
+class MSD
+{
+public:
+    //! Constructor
+    /*! \param window Whether to average over all windows (window mode) rather
+     *         than compute displacements from the first frame (direct mode).
+     */
+    explicit MSD(bool window = true) : m_window(window) {}
+
+    //! Compute the MSD of each particle.
+    /*! \param positions Unwrapped positions, of shape (num_frames, num_particles).
+     *  \param num_frames Number of frames of the trajectory.
+     *  \param num_particles Number of particles in each frame.
+     */
+    void compute(const vec3<float>* positions, unsigned int num_frames, unsigned int num_particles);
+
+    //! Return whether the MSD is averaged over all windows.
+    bool isWindow() const
+    {
+        return m_window;
+    }
+
+    //! Get a reference to the MSD of each particle, of shape (num_frames, num_particles).
+    const util::ManagedArray<double>& getParticleMSD() const
+    {
+        return m_particle_msd;
+    }
+
+private:
+    //! Compute the MSD of particles [begin, end) in window mode.
+    void computeWindow(const vec3<float>* positions, unsigned int num_frames, unsigned int num_particles,
+                       size_t begin, size_t end);
+
+    bool m_window;                             //!< Whether to average over all windows.
+    util::ManagedArray<double> m_particle_msd; //!< MSD of each particle in each frame.
+};
+
+}; }; // end namespace freud::msd
+
+#endif // MSD_H
@@ -0,0 +1,81 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "StreamingMSD.h"
+
+/*! \file StreamingMSD.cc
+    \brief Accumulates the mean squared displacement of a trajectory frame by frame.
+*/
+
+namespace freud { namespace msd {
+
+StreamingMSD::StreamingMSD(unsigned int points_per_level, unsigned int level_factor)
+    : m_correlator(points_per_level, level_factor), m_reduce(true)
+{}
+
+void StreamingMSD::reset()
+{
+    m_correlator.reset();
+    m_reduce = true;
+}
+
+void StreamingMSD::update(const vec3<float>* positions, unsigned int num_particles)
+{
+    if (getNumFrames() != 0 && num_particles != m_correlator.getFrameSize())
+    {
+        throw std::invalid_argument("StreamingMSD requires the same number of particles in every frame.");
+    }
+    const auto squared_displacement = [num_particles](const vec3<float>* frame, const vec3<float>* origin) {
+        double sum = 0;
+        for (size_t i = 0; i < num_particles; ++i)
+        {
+            const vec3<float> delta = frame[i] - origin[i];
+            sum += dot(delta, delta);
+        }
+        return sum / static_cast<double>(num_particles);
+    };
+    m_correlator.update(positions, num_particles, squared_displacement);
+    m_reduce = true;
+}
+
+void StreamingMSD::updateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first, uint64_t last,
+                                    uint64_t stride)
+{
+    std::vector<vec3<float>> unwrapped;
+    trajectory.forEachFrame(first, last, stride, [&](const util::GSDFrame& frame) {
+        unwrapped.resize(frame.getNumParticles());
+        frame.box.unwrap(frame.positions.data(), frame.images.data(), frame.getNumParticles(),
+                         unwrapped.data());
+        update(unwrapped.data(), frame.getNumParticles());
+    });
+}
+
+void StreamingMSD::reduce()
+{
+    if (!m_reduce)
+    {
+        return;
+    }
+    m_reduce = false;
+
+    std::vector<unsigned int> lags;
+    std::vector<double> msd;
+    std::vector<unsigned int> counts;
+    m_correlator.reduce(lags, msd, counts);
+
+    m_lags.prepare(lags.size());
+    m_msd.prepare(msd.size());
+    m_counts.prepare(counts.size());
+    std::copy(lags.begin(), lags.end(), m_lags.get());
+    std::copy(counts.begin(), counts.end(), m_counts.get());
+    for (size_t i = 0; i < msd.size(); ++i)
+    {
+        m_msd[i] = static_cast<float>(msd[i]);
+    }
+}
+
+}; }; // end namespace freud::msd
@@ -0,0 +1,103 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef STREAMING_MSD_H
+#define STREAMING_MSD_H
+
+#include "GSDTrajectory.h"
+#include "ManagedArray.h"
+#include "MultipleTauCorrelator.h"
+#include "VectorMath.h"
+
+/*! \file StreamingMSD.h
+    \brief Accumulates the mean squared displacement of a trajectory frame by frame.
+*/
+
+namespace freud { namespace msd {
+
+//! Accumulates the windowed mean squared displacement with a multiple-tau correlator.
+/*! Frames are added one at a time, so trajectories that do not fit in memory
+ *  can be analyzed. The positions of each frame are stored in a
+ *  util::MultipleTauCorrelator, which accumulates the squared displacements
+ *  at logarithmically spaced lags. The displacements are computed exactly
+ *  from the stored positions, but at long lags fewer time origins are
+ *  averaged over. For lags below points_per_level the result is identical to
+ *  the window mode of MSD.
+ */
+class StreamingMSD
+{
+public:
+    //! Constructor
+    /*! \param points_per_level Number of frames held in each level.
+     *  \param level_factor Ratio of the frame spacings of consecutive levels.
+     */
+    explicit StreamingMSD(unsigned int points_per_level = 16, unsigned int level_factor = 2);
+
+    //! Reset the accumulated displacements and stored frames.
+    void reset();
+
+    //! Add the next frame of the trajectory.
+    /*! \param positions Unwrapped positions of the particles in this frame.
+     *  \param num_particles Number of particles, which must not change between frames.
+     */
+    void update(const vec3<float>* positions, unsigned int num_particles);
+
+    //! Add the frames first, first + stride, ... before last of a GSD trajectory.
+    /*! The positions are unwrapped with the particle images stored in the
+     *  file, and each frame is read while the previous one is added.
+     */
+    void updateTrajectory(const util::GSDTrajectory& trajectory, uint64_t first, uint64_t last,
+                          uint64_t stride);
+
+    unsigned int getPointsPerLevel() const
+    {
+        return m_correlator.getPointsPerLevel();
+    }
+
+    unsigned int getLevelFactor() const
+    {
+        return m_correlator.getLevelFactor();
+    }
+
+    //! Get the number of frames added since the last reset.
+    unsigned int getNumFrames() const
+    {
+        return m_correlator.getNumFrames();
+    }
+
+    //! Get the lags (in frames) at which the MSD has been accumulated.
+    const util::ManagedArray<unsigned int>& getLags()
+    {
+        reduce();
+        return m_lags;
+    }
+
+    //! Get the MSD averaged over all particles for each lag.
+    const util::ManagedArray<float>& getMSD()
+    {
+        reduce();
+        return m_msd;
+    }
+
+    //! Get the number of pairs of frames averaged over for each lag.
+    const util::ManagedArray<unsigned int>& getCounts()
+    {
+        reduce();
+        return m_counts;
+    }
+
+private:
+    //! Collect the accumulated lags into m_lags, m_msd and m_counts.
+    void reduce();
+
+    util::MultipleTauCorrelator<vec3<float>> m_correlator; //!< Correlator holding the stored positions.
+    bool m_reduce;                                         //!< Whether the results must be collected again.
+
+    util::ManagedArray<unsigned int> m_lags;   //!< Lags with accumulated pairs.
+    util::ManagedArray<float> m_msd;           //!< MSD of each lag.
+    util::ManagedArray<unsigned int> m_counts; //!< Number of pairs of each lag.
+};
+
+}; }; // end namespace freud::msd
+
+#endif // STREAMING_MSD_H
@@ -1,12 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
-#include <functional>
-#include <numeric>
+#include <vector>
 
 #include "ContinuousCoordination.h"
-#include "NeighborComputeFunctional.h"
+#include "utils.h"
 
 /*! \file ContinuousCoordination.cc
     \brief Routines for computing local density around a point.
@@ -14,6 +14,62 @@
 
 namespace freud { namespace order {
 
+namespace {
+
+//! Largest power evaluated by repeated multiplication rather than std::pow.
+constexpr unsigned int MAX_MULTIPLIED_POWER = 16;
+
+//! Raises positive values to a fixed power.
+/*! Integer and half-integer powers, which are the usual choices for the
+ *  coordination numbers, are evaluated by repeated squaring of the value or
+ *  of its square root, which is much cheaper than std::pow.
+ */
+class Power
+{
+public:
+    explicit Power(float power) : m_power(power)
+    {
+        const float twice_power = 2.0F * power;
+        m_multiplied = twice_power == std::round(twice_power)
+            && std::abs(twice_power) <= static_cast<float>(2 * MAX_MULTIPLIED_POWER);
+        if (m_multiplied)
+        {
+            const auto twice_exponent = static_cast<int>(std::abs(twice_power));
+            m_half = twice_exponent % 2 != 0;
+            m_exponent = m_half ? twice_exponent : twice_exponent / 2;
+            m_inverse = power < 0;
+        }
+    }
+
+    float operator()(float value) const
+    {
+        if (!m_multiplied)
+        {
+            return std::pow(value, m_power);
+        }
+        float base = m_half ? std::sqrt(value) : value;
+        float result = 1.0F;
+        for (unsigned int exponent = m_exponent; exponent != 0; exponent >>= 1U)
+        {
+            if ((exponent & 1U) != 0)
+            {
+                result *= base;
+            }
+            base *= base;
+        }
+        return m_inverse ? 1.0F / result : result;
+    }
+
+private:
+    float m_power;               //!< The power.
+    bool m_multiplied;           //!< Whether the power is evaluated by multiplication.
+    bool m_half {false};         //!< Whether the power is a half-integer.
+    bool m_inverse {false};      //!< Whether the power is negative.
+    unsigned int m_exponent {0}; //!< Number of factors of the value (or of its square root).
+};
+
+} // namespace
+
 ContinuousCoordination::ContinuousCoordination(std::vector<float> powers, bool compute_log, bool compute_exp)
     : m_powers(std::move(powers)), m_compute_exp(compute_exp), m_compute_log(compute_log)
 {}
@@ -24,51 +80,69 @@ void ContinuousCoordination::compute(const freud::locality::Voronoi* voronoi)
     size_t num_points = nlist->getNumQueryPoints();
     m_coordination.prepare({num_points, getNumberOfCoordinations()});
     const auto& volumes = voronoi->getVolumes();
+    // Getting the counts also brings the segments of the neighbor list up to date.
     const auto& num_neighbors = nlist->getCounts();
-    // This is necessary as the current Windows runners on GitHub actions have a
-    // compiler that doesn't support *this capture in lambdas. Thus, we need a
-    // reference to powers directly.
-    const auto& powers = getPowers();
+    const size_t num_powers = m_powers.size();
+    std::vector<Power> volume_powers;
+    std::vector<Power> count_powers;
+    for (const float power : m_powers)
+    {
+        volume_powers.emplace_back(power);
+        count_powers.emplace_back(2.0F - power);
+    }
     // 2 for triangles 3 for pyramids
     const float volume_prefactor = voronoi->getBox().is2D() ? 2.0 : 3.0;
-    freud::locality::loopOverNeighborListIterator(
-        nlist.get(),
-        [&](size_t particle_index, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
+
+    // All coordination numbers of a point are accumulated in a single pass
+    // over its bonds, without storing the volumes of the bonds.
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        std::vector<float> power_sums(num_powers);
+        for (size_t particle_index = begin; particle_index < end; ++particle_index)
+        {
+            const locality::NeighborListSegment segment(nlist->getSegment(particle_index));
             // 1/2 comes from the distance vector since we want to measure from the pyramid
             // base to the center.
             const float prefactor
                 = 1.0F / (volume_prefactor * 2.0F * static_cast<float>(volumes[particle_index]));
-            std::vector<float> i_volumes;
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            const float num_neighbors_i {static_cast<float>(num_neighbors[particle_index])};
+            const float exp_offset = 1.0F / num_neighbors_i;
+
+            std::fill(power_sums.begin(), power_sums.end(), 0.0F);
+            float log_sum {0};
+            float exp_sum {0};
+            for (unsigned int n = 0; n < segment.size(); ++n)
             {
-                i_volumes.emplace_back(prefactor * nb.getWeight() * nb.getDistance());
+                const float volume = prefactor * segment.getWeight(n) * segment.getDistance(n);
+                for (size_t k {0}; k < num_powers; ++k)
+                {
+                    power_sums[k] += volume_powers[k](volume);
+                }
+                if (m_compute_log)
+                {
+                    log_sum += std::log(volume);
+                }
+                if (m_compute_exp)
+                {
+                    exp_sum += std::exp(volume - exp_offset);
+                }
             }
+
             size_t coordination_number {0};
-            float num_neighbors_i {static_cast<float>(num_neighbors[particle_index])};
-            for (size_t k {0}; k < powers.size(); ++k)
+            for (size_t k {0}; k < num_powers; ++k)
             {
-                float coordination = std::transform_reduce(
-                    i_volumes.begin(), i_volumes.end(), 0.0F, std::plus<>(),
-                    [&powers, k](const auto& volume) { return std::pow(volume, powers[k]); });
                 m_coordination(particle_index, coordination_number++)
-                    = std::pow(num_neighbors_i, 2.0F - powers[k]) / coordination;
+                    = count_powers[k](num_neighbors_i) / power_sums[k];
             }
             if (m_compute_log)
             {
-                float coordination
-                    = std::transform_reduce(i_volumes.begin(), i_volumes.end(), 0.0F, std::plus<>(), logf);
-                m_coordination(particle_index, coordination_number++)
-                    = -coordination / std::log(num_neighbors_i);
+                m_coordination(particle_index, coordination_number++) = -log_sum / std::log(num_neighbors_i);
             }
             if (m_compute_exp)
             {
-                m_coordination(particle_index, coordination_number) = std::transform_reduce(
-                    i_volumes.begin(), i_volumes.end(), 0.0F, std::plus<>(),
-                    [num_neighbors_i](const auto& volume) {
-                        return std::exp(volume - (1.0F / static_cast<float>(num_neighbors_i)));
-                    });
+                m_coordination(particle_index, coordination_number) = exp_sum;
             }
-        });
+        }
+    });
 }
 
 unsigned int ContinuousCoordination::getNumberOfCoordinations() const
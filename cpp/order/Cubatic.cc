@@ -1,9 +1,10 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
-#include <cstring>
+#include <algorithm>
 #include <functional>
 #include <stdexcept>
+#include <vector>
 
 #include "Cubatic.h"
 #include "utils.h"
@@ -14,35 +15,49 @@
 
 namespace freud { namespace order {
 
+namespace {
+
+//! Number of particles summed together by each task of calculateGlobalTensor.
+constexpr size_t CUBATIC_BLOCK_SIZE = 1024;
+
+//! Offset of the components with nx x indices, which are ordered by decreasing nx and then ny.
+constexpr std::array<unsigned int, 5> COMPONENT_OFFSETS = {10, 6, 3, 1, 0};
+
+//! Number of index permutations represented by each unique component, 4! / (nx! ny! nz!).
+constexpr std::array<float, tensor4::num_components> COMPONENT_MULTIPLICITIES
+    = {1, 4, 4, 6, 12, 6, 4, 12, 12, 4, 1, 4, 6, 4, 1};
+
+} // namespace
+
+unsigned int tensor4::componentIndex(unsigned int nx, unsigned int ny)
+{
+    return COMPONENT_OFFSETS[nx] + (4 - nx - ny);
+}
+
 tensor4::tensor4(const vec3<float>& vector)
 {
-    unsigned int cnt = 0;
-    std::array<float, 3> v = {vector.x, vector.y, vector.z};
-    for (float vi : v)
+    // Powers 0 through 4 of each coordinate.
+    std::array<float, 5> px {1, 0, 0, 0, 0};
+    std::array<float, 5> py {1, 0, 0, 0, 0};
+    std::array<float, 5> pz {1, 0, 0, 0, 0};
+    for (unsigned int n = 1; n < 5; ++n)
+    {
+        px[n] = px[n - 1] * vector.x;
+        py[n] = py[n - 1] * vector.y;
+        pz[n] = pz[n - 1] * vector.z;
+    }
+    for (unsigned int nx = 0; nx <= 4; ++nx)
     {
-        for (float vj : v)
+        for (unsigned int ny = 0; ny <= 4 - nx; ++ny)
         {
-            for (float vk : v)
-            {
-                for (float vl : v)
-                {
-                    data[cnt] = vi * vj * vk * vl;
-                    cnt++;
-                }
-            }
+            data[componentIndex(nx, ny)] = px[nx] * py[ny] * pz[4 - nx - ny];
         }
     }
 }
 
-//! Writeable index into array.
-float& tensor4::operator[](unsigned int index)
+tensor4& tensor4::operator+=(const tensor4& b)
 {
-    return data[index];
-}
-
-tensor4 tensor4::operator+=(const tensor4& b)
-{
-    for (unsigned int i = 0; i < 81; i++)
+    for (unsigned int i = 0; i < num_components; i++)
     {
         data[i] += b.data[i];
     }
@@ -52,7 +67,7 @@ tensor4 tensor4::operator+=(const tensor4& b)
 tensor4 tensor4::operator-(const tensor4& b) const
 {
     tensor4 c;
-    for (unsigned int i = 0; i < 81; i++)
+    for (unsigned int i = 0; i < num_components; i++)
     {
         c.data[i] = data[i] - b.data[i];
     }
@@ -62,20 +77,37 @@ tensor4 tensor4::operator-(const tensor4& b) const
 tensor4 tensor4::operator*(const float& b) const
 {
     tensor4 c;
-    for (unsigned int i = 0; i < 81; i++)
+    for (unsigned int i = 0; i < num_components; i++)
     {
         c.data[i] = data[i] * b;
     }
     return c;
 }
 
-void tensor4::copyToManagedArray(util::ManagedArray<float>& ma)
+void tensor4::copyToManagedArray(util::ManagedArray<float>& ma) const
 {
-    std::copy(data.begin(), data.end(), ma.get());
+    unsigned int cnt = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                for (unsigned int l = 0; l < 3; ++l)
+                {
+                    const unsigned int nx = (i == 0) + (j == 0) + (k == 0) + (l == 0);
+                    const unsigned int ny = (i == 1) + (j == 1) + (k == 1) + (l == 1);
+                    ma[cnt] = data[componentIndex(nx, ny)];
+                    ++cnt;
+                }
+            }
+        }
+    }
 }
 
 //! Complete tensor contraction.
-/*! This function is simply a sum-product over two tensors. For reference, see eq. 4.
+/*! This function is simply a sum-product over two tensors, with each unique
+ *  component weighted by its multiplicity. For reference, see eq. 4.
  *
  *  \param a The first tensor.
  *  \param b The second tensor.
@@ -83,9 +115,9 @@ void tensor4::copyToManagedArray(util::ManagedArray<float>& ma)
 float dot(const tensor4& a, const tensor4& b)
 {
     float c = 0;
-    for (unsigned int i = 0; i < 81; i++)
+    for (unsigned int i = 0; i < tensor4::num_components; i++)
     {
-        c += a.data[i] * b.data[i];
+        c += COMPONENT_MULTIPLICITIES[i] * a.data[i] * b.data[i];
     }
     return c;
 }
@@ -98,32 +130,26 @@ float dot(const tensor4& a, const tensor4& b)
  */
 tensor4 genR4Tensor()
 {
-    // Construct the identity matrix to build the delta functions.
-    util::ManagedArray<float> identity({3, 3});
-    identity(0, 0) = 1;
-    identity(1, 1) = 1;
-    identity(2, 2) = 1;
-
-    unsigned int cnt = 0;
     tensor4 r4 = tensor4();
-    for (unsigned int i = 0; i < 3; ++i)
+    for (unsigned int nx = 0; nx <= 4; ++nx)
     {
-        for (unsigned int j = 0; j < 3; ++j)
+        for (unsigned int ny = 0; ny <= 4 - nx; ++ny)
         {
-            for (unsigned int k = 0; k < 3; ++k)
+            // Evaluate the ijkl, ikjl and iljk delta products for the sorted
+            // indices of this component.
+            std::array<unsigned int, 4> index {};
+            for (unsigned int n = 0; n < 4; ++n)
             {
-                for (unsigned int l = 0; l < 3; ++l)
-                {
-                    // ijkl term
-                    r4[cnt] += identity(i, j) * identity(k, l);
-                    // ikjl term
-                    r4[cnt] += identity(i, k) * identity(j, l);
-                    // iljk term
-                    r4[cnt] += identity(i, l) * identity(j, k);
-                    r4[cnt] *= 2.0 / 5.0;
-                    ++cnt;
-                }
+                index[n] = static_cast<unsigned int>(n >= nx) + static_cast<unsigned int>(n >= nx + ny);
             }
+            const unsigned int i = index[0];
+            const unsigned int j = index[1];
+            const unsigned int k = index[2];
+            const unsigned int l = index[3];
+            const auto deltas = static_cast<float>(static_cast<unsigned int>(i == j && k == l)
+                                                   + static_cast<unsigned int>(i == k && j == l)
+                                                   + static_cast<unsigned int>(i == l && j == k));
+            r4.data[tensor4::componentIndex(nx, ny)] = deltas * float(2.0 / 5.0);
         }
     }
     return r4;
@@ -168,8 +194,17 @@ tensor4 Cubatic::calcCubaticTensor(quat<float>& orientation)
 
 float Cubatic::calcCubaticOrderParameter(const tensor4& cubatic_tensor, const tensor4& global_tensor)
 {
-    tensor4 diff = global_tensor - cubatic_tensor;
-    return float(1.0) - dot(diff, diff) / dot(cubatic_tensor, cubatic_tensor);
+    // Both contractions are accumulated in a single pass without a temporary
+    // difference tensor.
+    float diff_norm = 0;
+    float cubatic_norm = 0;
+    for (unsigned int i = 0; i < tensor4::num_components; i++)
+    {
+        const float diff = global_tensor.data[i] - cubatic_tensor.data[i];
+        diff_norm += COMPONENT_MULTIPLICITIES[i] * diff * diff;
+        cubatic_norm += COMPONENT_MULTIPLICITIES[i] * cubatic_tensor.data[i] * cubatic_tensor.data[i];
+    }
+    return float(1.0) - diff_norm / cubatic_norm;
 }
 
 template<typename T> quat<float> Cubatic::calcRandomQuaternion(T& dist, float angle_multiplier) const
@@ -184,56 +219,37 @@ template<typename T> quat<float> Cubatic::calcRandomQuaternion(T& dist, float an
     return quat<float>::fromAxisAngle(axis, angle);
 }
 
-util::ManagedArray<tensor4> Cubatic::calculatePerParticleTensor(const quat<float>* orientations) const
+tensor4 Cubatic::calculateGlobalTensor(const quat<float>* orientations) const
 {
-    util::ManagedArray<tensor4> particle_tensor(m_n);
-
-    // calculate per-particle tensor
-    util::forLoopWrapper(0, m_n, [&](size_t begin, size_t end) {
-        for (size_t i = begin; i < end; ++i)
+    // Each block of particles is summed into its own tensor in parallel, and
+    // the block sums are added in order so that the result does not depend
+    // on the number of threads.
+    const size_t num_blocks = (m_n + CUBATIC_BLOCK_SIZE - 1) / CUBATIC_BLOCK_SIZE;
+    std::vector<tensor4> block_tensors(num_blocks);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
         {
-            tensor4 l_mbar = tensor4();
-            for (const auto& m_system_vector : m_system_vectors)
+            const size_t block_end = std::min((block + 1) * CUBATIC_BLOCK_SIZE, static_cast<size_t>(m_n));
+            for (size_t i = block * CUBATIC_BLOCK_SIZE; i < block_end; ++i)
             {
                 // Calculate the homogeneous tensor H for each vector then add
-                // to the per-particle value.
-                vec3<float> v_r = rotate(orientations[i], m_system_vector);
-                tensor4 r4_tensor(v_r);
-                l_mbar += r4_tensor;
+                // to the sum.
+                for (const auto& m_system_vector : m_system_vectors)
+                {
+                    block_tensors[block] += tensor4(rotate(orientations[i], m_system_vector));
+                }
             }
-
-            // Apply the prefactor from the sum in equation 27 before assigning.
-            particle_tensor[i] = l_mbar * 2.0;
         }
     });
-    return particle_tensor;
-}
 
-tensor4 Cubatic::calculateGlobalTensor(quat<float>* orientations) const
-{
     tensor4 global_tensor = tensor4();
-    util::ManagedArray<tensor4> particle_tensor = calculatePerParticleTensor(orientations);
-
-    // now calculate the global tensor
-    float n_inv = float(1.0) / static_cast<float>(m_n);
+    for (const tensor4& block_tensor : block_tensors)
+    {
+        global_tensor += block_tensor;
+    }
 
-    util::forLoopWrapper(0, 81, [&](size_t begin, size_t end) {
-        for (size_t i = begin; i < end; i++)
-        {
-            float tensor_value = 0;
-            for (unsigned int j = 0; j < m_n; j++)
-            {
-                tensor_value += particle_tensor[j][i];
-            }
-            // Note that in the third equation in eq. 27, the prefactor of the
-            // sum is 2/N, but the factor of 2 is already accounted for in the
-            // calculation of per particle calculation in
-            // calculatePerParticleTensor, so here we just need to apply the 1/N
-            // scaling.
-            global_tensor[i] = tensor_value * n_inv;
-        }
-    });
-    return global_tensor - m_gen_r4_tensor;
+    // The prefactor of the sum in the third equation in eq. 27 is 2/N.
+    return global_tensor * (float(2.0) / static_cast<float>(m_n)) - m_gen_r4_tensor;
 }
 
 void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
@@ -254,21 +270,18 @@ void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
     util::ManagedArray<float> p_cubatic_order_parameter(m_n_replicates);
     util::ManagedArray<quat<float>> p_cubatic_orientation(m_n_replicates);
 
+    // Each replicate is an independent task with its own random number
+    // stream, so the replicates do not depend on how they are split between
+    // threads and a replicate gives the same result for any number of
+    // replicates.
     util::forLoopWrapper(0, m_n_replicates, [&](size_t begin, size_t end) {
-        // create thread-specific rng
-        const auto thread_start = static_cast<unsigned int>(begin);
-
-        std::vector<unsigned int> seed_seq(3);
-        seed_seq[0] = m_seed;
-        seed_seq[1] = thread_start;
-        seed_seq[2] = 0xffaabb;
-        std::seed_seq seed(seed_seq.begin(), seed_seq.end());
-        std::mt19937 rng(seed);
-        std::uniform_real_distribution<float> base_dist(0, 1);
-        auto dist = [&]() { return base_dist(rng); };
-
         for (size_t i = begin; i < end; i++)
         {
+            std::seed_seq seed({m_seed, static_cast<unsigned int>(i), 0xffaabbU});
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> base_dist(0, 1);
+            auto dist = [&]() { return base_dist(rng); };
+
             // need to generate random orientation
             quat<float> cubatic_orientation = calcRandomQuaternion(dist);
             quat<float> new_orientation = cubatic_orientation;
@@ -21,19 +21,30 @@ namespace freud { namespace order {
  *  tensor4 class encapsulates some of the basic features required to enable
  *  these calculations, in particular the construction of the tensor from a
  *  vector and some arithmetic operations that help simplify the code.
+ *
+ *  All tensors in these calculations are fully symmetric, so only the 15
+ *  unique components (one per multiset of indices, i.e. per number of x, y
+ *  and z indices) are stored instead of all 81. Contractions weight each
+ *  unique component by the number of index permutations it stands for.
  */
 struct tensor4
 {
+    //! Number of unique components of a fully symmetric 4th order tensor in 3D.
+    static constexpr unsigned int num_components = 15;
+
     tensor4() = default;
     explicit tensor4(const vec3<float>& vector);
-    tensor4 operator+=(const tensor4& b);
+    tensor4& operator+=(const tensor4& b);
     tensor4 operator-(const tensor4& b) const;
     tensor4 operator*(const float& b) const;
-    float& operator[](unsigned int index);
 
-    void copyToManagedArray(util::ManagedArray<float>& ma);
+    //! Get the index of the unique component with nx x indices and ny y indices.
+    static unsigned int componentIndex(unsigned int nx, unsigned int ny);
+
+    //! Expand the unique components into a 3x3x3x3 array.
+    void copyToManagedArray(util::ManagedArray<float>& ma) const;
 
-    std::array<float, 81> data {0};
+    std::array<float, num_components> data {0};
 };
 
 //! Compute the cubatic order parameter for a set of points
@@ -144,19 +155,12 @@ private:
      */
     static float calcCubaticOrderParameter(const tensor4& cubatic_tensor, const tensor4& global_tensor);
 
-    //! Calculate the per-particle tensor.
-    /*! Implements the first line of eq. 27, the calculation of M.
-     *
-     *  \param orientations The per-particle orientations.
-     *
-     *  \return The per-particle cubatic tensors value M^{ijkl}.
-     */
-    util::ManagedArray<tensor4> calculatePerParticleTensor(const quat<float>* orientations) const;
-
     //! Calculate the global tensor for the system.
-    /*! Implements the third line of eq. 27, the calculation of \bar{M}.
+    /*! Implements the first and third lines of eq. 27, the calculation of
+     *  \bar{M} from the per-particle tensors M^{ijkl}, which are summed
+     *  without being stored.
      */
-    tensor4 calculateGlobalTensor(quat<float>* orientations) const;
+    tensor4 calculateGlobalTensor(const quat<float>* orientations) const;
 
     //! Calculate a random quaternion.
     /*! To calculate a random quaternion in a way that obeys the right
@@ -1,10 +1,41 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
+#include <complex>
+
 #include "HexaticTranslational.h"
 
 namespace freud { namespace order {
 
+namespace {
+
+//! Raise a unit complex number to an integer power by binary exponentiation.
+/*! The products are written out rather than using std::complex so that no
+    NaN and infinity checks are made.
+*/
+inline std::complex<float> integerPower(float re, float im, unsigned int k)
+{
+    float result_re(1);
+    float result_im(0);
+    while (k != 0)
+    {
+        if ((k & 1U) != 0)
+        {
+            const float next_re = result_re * re - result_im * im;
+            result_im = result_re * im + result_im * re;
+            result_re = next_re;
+        }
+        const float next_re = re * re - im * im;
+        im = float(2.0) * re * im;
+        re = next_re;
+        k >>= 1U;
+    }
+    return {result_re, result_im};
+}
+
+} // namespace
+
 //! Compute the order parameter
 template<typename T>
 template<typename Func>
@@ -53,8 +84,15 @@ void Hexatic::compute(const freud::locality::NeighborList* nlist,
 {
     computeGeneral(
         [this](const vec3<float>& delta) {
-            const float theta_ij = std::atan2(delta.y, delta.x);
-            return std::exp(std::complex<float>(0, static_cast<float>(m_k) * theta_ij));
+            // exp(i k theta) is the k-th power of the unit bond vector (dx + i dy) / r,
+            // which avoids evaluating atan2 and exp for every bond.
+            const float r_sq = delta.x * delta.x + delta.y * delta.y;
+            if (r_sq == float(0.0))
+            {
+                return std::complex<float>(1, 0);
+            }
+            const float inv_r = float(1.0) / std::sqrt(r_sq);
+            return integerPower(delta.x * inv_r, delta.y * inv_r, m_k);
         },
         nlist, points, qargs, false);
 }
@@ -1,8 +1,10 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <stdexcept>
 
+#include "NeighborComputeFunctional.h"
 #include "Nematic.h"
 #include "diagonalize.h"
 
@@ -12,6 +14,43 @@
 
 namespace freud { namespace order {
 
+namespace {
+
+//! Accumulate the tensor 3/2 u u^T - 1/2 I of a particle orientation into a sum.
+/*! The tensor of the particle is also written to tensor when it is not null.
+ */
+inline void addParticleTensor(vec3<float> u, std::array<double, 9>& sum, float* tensor)
+{
+    // get the orientation of the particle and normalize it
+    u = u / std::sqrt(dot(u, u));
+    const float Q_ab[9] = {1.5f * u.x * u.x - 0.5f, 1.5f * u.x * u.y,        1.5f * u.x * u.z,
+                           1.5f * u.y * u.x,        1.5f * u.y * u.y - 0.5f, 1.5f * u.y * u.z,
+                           1.5f * u.z * u.x,        1.5f * u.z * u.y,        1.5f * u.z * u.z - 0.5f};
+    for (unsigned int k = 0; k < 9; ++k)
+    {
+        sum[k] += Q_ab[k];
+    }
+    if (tensor != nullptr)
+    {
+        std::copy(Q_ab, Q_ab + 9, tensor);
+    }
+}
+
+//! Get the order parameter and director of a mean nematic tensor.
+/*! The order parameter is the largest eigenvalue and the director is the
+    corresponding eigenvector.
+*/
+inline float diagonalizeTensor(const std::array<float, 9>& tensor, vec3<float>& director)
+{
+    std::array<float, 3> eval {};
+    std::array<float, 9> evec {};
+    freud::util::diagonalize33SymmetricMatrix(tensor, eval, evec);
+    director = vec3<float>(evec[6], evec[7], evec[8]);
+    return eval[2];
+}
+
+} // namespace
+
 float Nematic::getNematicOrderParameter() const
 {
     return m_nematic_order_parameter;
@@ -32,46 +71,44 @@ unsigned int Nematic::getNumParticles() const
     return m_n;
 }
 
+const util::ManagedArray<float>& Nematic::getParticleOrder() const
+{
+    return m_particle_order;
+}
+
+const util::ManagedArray<float>& Nematic::getFrameOrder() const
+{
+    return m_frame_order;
+}
+
+const util::ManagedArray<float>& Nematic::getFrameDirectors() const
+{
+    return m_frame_directors;
+}
+
 vec3<float> Nematic::getNematicDirector() const
 {
     return m_nematic_director;
 }
 
-void Nematic::compute(vec3<float>* orientations, unsigned int n)
+std::array<float, 9> Nematic::computeParticleTensors(const vec3<float>* orientations, unsigned int n)
 {
     m_n = n;
     m_particle_tensor.prepare({m_n, 3, 3});
     m_nematic_tensor_local.reset();
 
-    // calculate per-particle tensor
+    // calculate per-particle tensor, summing each chunk before adding it to
+    // the thread-local nematic tensor.
     util::forLoopWrapper(0, n, [&](size_t begin, size_t end) {
+        std::array<double, 9> sum {};
         for (size_t i = begin; i < end; ++i)
         {
-            // get the orientation of the particle and normalize it
-            auto u_i = orientations[i];
-            u_i = u_i / std::sqrt(dot(u_i, u_i));
-
-            util::ManagedArray<float> Q_ab({3, 3});
-
-            Q_ab(0, 0) = 1.5f * u_i.x * u_i.x - 0.5f;
-            Q_ab(0, 1) = 1.5f * u_i.x * u_i.y;
-            Q_ab(0, 2) = 1.5f * u_i.x * u_i.z;
-            Q_ab(1, 0) = 1.5f * u_i.y * u_i.x;
-            Q_ab(1, 1) = 1.5f * u_i.y * u_i.y - 0.5f;
-            Q_ab(1, 2) = 1.5f * u_i.y * u_i.z;
-            Q_ab(2, 0) = 1.5f * u_i.z * u_i.x;
-            Q_ab(2, 1) = 1.5f * u_i.z * u_i.y;
-            Q_ab(2, 2) = 1.5f * u_i.z * u_i.z - 0.5f;
-
-            // Set the values. The nematic tensor is reduced later.
-            for (unsigned int j = 0; j < 3; j++)
-            {
-                for (unsigned int k = 0; k < 3; k++)
-                {
-                    m_particle_tensor(i, j, k) += Q_ab(j, k);
-                    m_nematic_tensor_local.local()(j, k) += Q_ab(j, k);
-                }
-            }
+            addParticleTensor(orientations[i], sum, m_particle_tensor.get() + 9 * i);
+        }
+        util::ManagedArray<float>& local_tensor = m_nematic_tensor_local.local();
+        for (unsigned int k = 0; k < 9; ++k)
+        {
+            local_tensor[k] += static_cast<float>(sum[k]);
         }
     });
 
@@ -80,18 +117,98 @@ void Nematic::compute(vec3<float>* orientations, unsigned int n)
     m_nematic_tensor_local.reduceInto(m_nematic_tensor);
 
     // Normalize by the number of particles
+    std::array<float, 9> tensor {};
     for (unsigned int i = 0; i < m_nematic_tensor.size(); ++i)
     {
         m_nematic_tensor[i] /= static_cast<float>(m_n);
+        tensor[i] = m_nematic_tensor[i];
     }
+    return tensor;
+}
 
-    // the order parameter is the eigenvector belonging to the largest eigenvalue
-    util::ManagedArray<float> eval = util::ManagedArray<float>(3);
-    util::ManagedArray<float> evec = util::ManagedArray<float>({3, 3});
+void Nematic::compute(const vec3<float>* orientations, unsigned int n)
+{
+    const std::array<float, 9> tensor = computeParticleTensors(orientations, n);
+    m_nematic_order_parameter = diagonalizeTensor(tensor, m_nematic_director);
+
+    m_frame_order.prepare(1);
+    m_frame_directors.prepare({1, 3});
+    m_frame_order[0] = m_nematic_order_parameter;
+    m_frame_directors(0, 0) = m_nematic_director.x;
+    m_frame_directors(0, 1) = m_nematic_director.y;
+    m_frame_directors(0, 2) = m_nematic_director.z;
+}
 
-    freud::util::diagonalize33SymmetricMatrix(m_nematic_tensor, eval, evec);
-    m_nematic_director = vec3<float>(evec(2, 0), evec(2, 1), evec(2, 2));
-    m_nematic_order_parameter = eval[2];
+void Nematic::computeFrames(const vec3<float>* orientations, unsigned int n_frames, unsigned int n)
+{
+    if (n_frames == 0)
+    {
+        throw std::invalid_argument("Nematic requires at least one frame.");
+    }
+    compute(orientations + static_cast<size_t>(n_frames - 1) * n, n);
+
+    // Frames are independent, so they are computed in parallel and only the
+    // mean tensor of each frame is formed.
+    m_frame_order.prepare(n_frames);
+    m_frame_directors.prepare({n_frames, 3});
+    util::forLoopWrapper(0, n_frames, [&](size_t begin, size_t end) {
+        for (size_t frame = begin; frame < end; ++frame)
+        {
+            const vec3<float>* frame_orientations = orientations + frame * n;
+            std::array<double, 9> sum {};
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                addParticleTensor(frame_orientations[i], sum, nullptr);
+            }
+            std::array<float, 9> tensor {};
+            for (unsigned int k = 0; k < 9; ++k)
+            {
+                tensor[k] = static_cast<float>(sum[k] / static_cast<double>(n));
+            }
+            vec3<float> director;
+            m_frame_order[frame] = diagonalizeTensor(tensor, director);
+            float* frame_director = m_frame_directors.get() + 3 * frame;
+            frame_director[0] = director.x;
+            frame_director[1] = director.y;
+            frame_director[2] = director.z;
+        }
+    });
+}
+
+void Nematic::computeLocal(const freud::locality::NeighborList* nlist,
+                           const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
+{
+    if (points->getNPoints() != m_n)
+    {
+        throw std::invalid_argument("Nematic requires one point for each orientation to compute the local "
+                                    "order parameter.");
+    }
+    m_particle_order.prepare(m_n);
+
+    freud::locality::loopOverNeighborsIterator(
+        points, points->getPoints(), m_n, qargs, nlist,
+        [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
+            std::array<float, 9> tensor {};
+            const float* particle_tensor = m_particle_tensor.get() + 9 * i;
+            std::copy(particle_tensor, particle_tensor + 9, tensor.begin());
+            unsigned int count(1);
+
+            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            {
+                const float* neighbor_tensor = m_particle_tensor.get() + 9 * nb.getPointIdx();
+                for (unsigned int k = 0; k < 9; ++k)
+                {
+                    tensor[k] += neighbor_tensor[k];
+                }
+                ++count;
+            }
+            for (unsigned int k = 0; k < 9; ++k)
+            {
+                tensor[k] /= static_cast<float>(count);
+            }
+            vec3<float> director;
+            m_particle_order[i] = diagonalizeTensor(tensor, director);
+        });
 }
 
 }; }; // end namespace freud::order
@@ -4,10 +4,13 @@
 #ifndef NEMATIC_H
 #define NEMATIC_H
 
+#include <array>
 #include <memory>
 
 #include "Box.h"
 #include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
 #include "ThreadStorage.h"
 #include "VectorMath.h"
 
@@ -29,13 +32,34 @@ public:
     virtual ~Nematic() = default;
 
     //! Compute the nematic order parameter
-    void compute(vec3<float>* orientations, unsigned int n);
+    void compute(const vec3<float>* orientations, unsigned int n);
+
+    //! Compute the nematic order parameter of several frames with the same number of particles
+    /*! The orientations are stored frame by frame. The order parameter and
+        director of every frame are stored, and all other results describe
+        the last frame.
+    */
+    void computeFrames(const vec3<float>* orientations, unsigned int n_frames, unsigned int n);
+
+    //! Compute the local nematic order parameter of each particle of the last compute
+    /*! The tensor of each particle is averaged with the tensors of its
+        neighbors, and the local order parameter is the largest eigenvalue
+        of the average.
+    */
+    void computeLocal(const freud::locality::NeighborList* nlist,
+                      const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs);
 
     //! Get the value of the last computed nematic order parameter
     float getNematicOrderParameter() const;
 
     const util::ManagedArray<float>& getParticleTensor() const;
 
+    const util::ManagedArray<float>& getParticleOrder() const;
+
+    const util::ManagedArray<float>& getFrameOrder() const;
+
+    const util::ManagedArray<float>& getFrameDirectors() const;
+
     const util::ManagedArray<float>& getNematicTensor() const;
 
     unsigned int getNumParticles() const;
@@ -43,6 +67,9 @@ public:
     vec3<float> getNematicDirector() const;
 
 private:
+    //! Fill the per-particle tensors and return their mean.
+    std::array<float, 9> computeParticleTensors(const vec3<float>* orientations, unsigned int n);
+
     unsigned int m_n {0};                //!< Last number of points computed
     float m_nematic_order_parameter {0}; //!< Current value of the order parameter
     vec3<float> m_nematic_director;      //!< The director (eigenvector corresponding to the OP)
@@ -50,6 +77,9 @@ private:
     util::ManagedArray<float> m_nematic_tensor {{3, 3}};        //!< The computed nematic tensor.
     util::ThreadStorage<float> m_nematic_tensor_local {{3, 3}}; //!< Thread-specific nematic tensor.
     util::ManagedArray<float> m_particle_tensor; //!< The per-particle tensor that is summed up to Q.
+    util::ManagedArray<float> m_particle_order;  //!< The local order parameter of each particle.
+    util::ManagedArray<float> m_frame_order;     //!< The order parameter of each frame.
+    util::ManagedArray<float> m_frame_directors; //!< The director of each frame.
 };
 
 }; }; // end namespace freud::order
@@ -4,7 +4,9 @@
 #include "RotationalAutocorrelation.h"
 
 #include "utils.h"
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 /*! \file RotationalAutocorrelation.cc
     \brief Implements the RotationalAutocorrelation class.
@@ -12,92 +14,114 @@
 
 namespace freud { namespace order {
 
-// This function wraps exponentiation for complex numbers to avoid
-// the case where pow((0,0), 0) returns (nan, nan). Additionally, it
-// serves as a micro-optimization since std::pow can be slow. We can take the
-// exponent to be an unsigned int since all the sums in the hyperspherical
-// harmonic below guarantee this.
-inline std::complex<float> cpow(std::complex<float> base, unsigned int p)
+namespace {
+
+//! Compute the powers 0 to l of xi*, zeta, zeta* and -xi.
+/*! The powers are computed once per orientation by repeated multiplication
+ *  and shared by all terms of all harmonics. The powers of zero are 1 for
+ *  an exponent of 0, which avoids std::pow((0, 0), 0) returning (nan, nan).
+ */
+template<typename T>
+void computePowers(const std::complex<T> xi, const std::complex<T> zeta, unsigned int l,
+                   std::complex<T>* powers)
 {
-    if (p == 0)
-    {
-        return {1, 0};
-    }
-    std::complex<float> val(base);
-    for (unsigned int i = 1; i < p; i++)
+    const std::array<std::complex<T>, 4> bases = {std::conj(xi), zeta, std::conj(zeta), -xi};
+    for (unsigned int p = 0; p < bases.size(); p++)
     {
-        val *= base;
+        std::complex<T>* base_powers = powers + p * (l + 1);
+        base_powers[0] = 1;
+        for (unsigned int n = 1; n <= l; n++)
+        {
+            base_powers[n] = base_powers[n - 1] * bases[p];
+        }
     }
-    return val;
 }
 
-inline std::complex<float> RotationalAutocorrelation::hypersphere_harmonic(const std::complex<float> xi,
-                                                                           std::complex<float> zeta,
-                                                                           const unsigned int m1,
-                                                                           const unsigned int m2)
-{
-    const std::complex<float> xi_conj = std::conj(xi);
-    const std::complex<float> zeta_conj = std::conj(zeta);
+} // namespace
 
-    // Doing a summation over non-negative exponents, which requires the additional inner conditional.
-    std::complex<float> sum_tracker(0, 0);
-    for (unsigned int k = (m1 + m2 < m_l ? 0 : m1 + m2 - m_l); k <= std::min(m1, m2); k++)
+RotationalAutocorrelation::RotationalAutocorrelation(unsigned int l) : m_l(l)
+{
+    // The factorials are stored as doubles since they overflow an unsigned
+    // int for l > 12, and their products already do for l >= 10.
+    std::vector<double> factorials(m_l + 1);
+    factorials[0] = 1;
+    for (unsigned int i = 1; i <= m_l; i++)
     {
-        float fact_product = static_cast<float>(m_factorials[k])
-            * static_cast<float>(m_factorials[m_l + k - m1 - m2]) * static_cast<float>(m_factorials[m1 - k])
-            * static_cast<float>(m_factorials[m2 - k]);
-        sum_tracker += cpow(xi_conj, k) * cpow(zeta, m2 - k) * cpow(zeta_conj, m1 - k)
-            * cpow(-xi, m_l + k - m1 - m2) / fact_product;
+        factorials[i] = i * factorials[i - 1];
     }
-    return sum_tracker;
-}
 
-void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, const quat<float>* orientations,
-                                        unsigned int N)
-{
-    m_RA_array.prepare(N);
+    // The hyperspherical harmonics for the unit quaternion are evaluated in
+    // double precision. Only the harmonics with m1 + m2 = l are nonzero there,
+    // so the autocorrelation only needs the terms of those harmonics.
+    const unsigned int num_powers = m_l + 1;
+    std::vector<std::complex<double>> unit_powers(4 * num_powers);
+    computePowers(std::complex<double>(0, 0), std::complex<double>(0, 1), m_l, unit_powers.data());
 
-    // Precompute the hyperspherical harmonics for the unit quaternion. The
-    // default quaternion constructor gives a unit quaternion. We will assume
-    // the same iteration order here as in the loop below to save ourselves
-    // from having to use a more expensive process (i.e. a map).
-    std::complex<float> xi = std::complex<float>(0, 0);
-    std::complex<float> zeta = std::complex<float>(0, 1);
-    std::vector<std::complex<float>> unit_harmonics;
-    std::vector<std::vector<float>> prefactors(m_l + 1, std::vector<float>(m_l + 1, float(0)));
+    unsigned int index = 0;
     for (unsigned int a = 0; a <= m_l; a++)
     {
         for (unsigned int b = 0; b <= m_l; b++)
         {
-            unit_harmonics.push_back(std::conj(hypersphere_harmonic(xi, zeta, a, b)));
-            prefactors[a][b] = static_cast<float>(m_factorials[a] * m_factorials[m_l - a] * m_factorials[b]
-                                                  * m_factorials[m_l - b])
-                / (static_cast<float>(m_l + 1));
+            const unsigned int k_min = (a + b < m_l ? 0 : a + b - m_l);
+            const unsigned int k_max = std::min(a, b);
+            std::complex<double> unit_harmonic(0, 0);
+            for (unsigned int k = k_min; k <= k_max; k++)
+            {
+                unit_harmonic += unit_powers[k] * unit_powers[num_powers + b - k]
+                    * unit_powers[2 * num_powers + a - k] * unit_powers[3 * num_powers + m_l + k - a - b]
+                    / (factorials[k] * factorials[m_l + k - a - b] * factorials[a - k] * factorials[b - k]);
+            }
+            const double prefactor = factorials[a] * factorials[m_l - a] * factorials[b] * factorials[m_l - b]
+                / static_cast<double>(m_l + 1);
+
+            for (unsigned int k = k_min; k <= k_max; k++)
+            {
+                const double term_factor = 1
+                    / (factorials[k] * factorials[m_l + k - a - b] * factorials[a - k] * factorials[b - k]);
+                const std::array<unsigned int, 4> powers
+                    = {k, num_powers + b - k, 2 * num_powers + a - k, 3 * num_powers + m_l + k - a - b};
+                m_expansion_terms.push_back(
+                    {static_cast<float>(std::sqrt(prefactor) * term_factor), index, powers});
+                if (unit_harmonic != 0.0)
+                {
+                    const std::complex<double> coefficient
+                        = prefactor * std::conj(unit_harmonic) * term_factor;
+                    m_autocorrelation_terms.push_back({std::complex<float>(coefficient), 0, powers});
+                }
+            }
+            index += 1;
         }
     }
+}
+
+inline void RotationalAutocorrelation::addHarmonicTerms(const std::vector<HarmonicTerm>& terms,
+                                                        const quat<float>& q, std::complex<float>* powers,
+                                                        std::complex<float>* values) const
+{
+    computePowers(std::complex<float>(q.v.x, q.v.y), std::complex<float>(q.v.z, q.s), m_l, powers);
+    for (const HarmonicTerm& term : terms)
+    {
+        values[term.index] += term.coefficient * powers[term.powers[0]] * powers[term.powers[1]]
+            * powers[term.powers[2]] * powers[term.powers[3]];
+    }
+}
+
+void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, const quat<float>* orientations,
+                                        unsigned int N)
+{
+    m_RA_array.prepare(N);
 
     // Parallel loop is over orientations (technically (ref_or, or) pairs).
     util::forLoopWrapper(0, N, [&](size_t begin, size_t end) {
+        std::vector<std::complex<float>> powers(4 * (m_l + 1));
         for (size_t i = begin; i < end; ++i)
         {
-            // Transform the orientation quaternions into Xi/Zeta coordinates;
-            quat<float> qq_1 = conj(ref_orientations[i]) * orientations[i];
-            std::complex<float> xi = std::complex<float>(qq_1.v.x, qq_1.v.y);
-            std::complex<float> zeta = std::complex<float>(qq_1.v.z, qq_1.s);
-
-            // Loop through the valid quantum numbers.
+            // The autocorrelation is the weighted inner product of the
+            // harmonics of the relative orientation with those of the unit
+            // quaternion, whose weights are folded into the terms.
+            const quat<float> qq_1 = conj(ref_orientations[i]) * orientations[i];
             m_RA_array[i] = std::complex<float>(0, 0);
-            unsigned int uh_index = 0;
-            for (unsigned int a = 0; a <= m_l; a++)
-            {
-                for (unsigned int b = 0; b <= m_l; b++)
-                {
-                    std::complex<float> combined_value
-                        = unit_harmonics[uh_index] * hypersphere_harmonic(xi, zeta, a, b);
-                    m_RA_array[i] += prefactors[a][b] * combined_value;
-                    uh_index += 1;
-                }
-            }
+            addHarmonicTerms(m_autocorrelation_terms, qq_1, powers.data(), &m_RA_array[i]);
         }
     });
 
@@ -109,4 +133,91 @@ void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, con
     m_Ft = RA_sum / static_cast<float>(N);
 };
 
+void RotationalAutocorrelation::computeHarmonicExpansions(const quat<float>* orientations, unsigned int N,
+                                                          std::complex<float>* expansions) const
+{
+    // The hyperspherical harmonics of l form a unitary representation of the
+    // rotations, so the autocorrelation of (q_1, q_2) evaluated by compute
+    // also equals sum_ab p_ab conj(U_ab(q_1)) U_ab(q_2), where p_ab are the
+    // prefactors. Each expansion holds sqrt(p_ab) U_ab.
+    const size_t num_harmonics = static_cast<size_t>(m_l + 1) * (m_l + 1);
+    util::forLoopWrapper(0, N, [&](size_t begin, size_t end) {
+        std::vector<std::complex<float>> powers(4 * (m_l + 1));
+        for (size_t i = begin; i < end; ++i)
+        {
+            std::complex<float>* expansion = expansions + i * num_harmonics;
+            std::fill(expansion, expansion + num_harmonics, std::complex<float>(0, 0));
+            addHarmonicTerms(m_expansion_terms, orientations[i], powers.data(), expansion);
+        }
+    });
+}
+
+StreamingRotationalAutocorrelation::StreamingRotationalAutocorrelation(unsigned int l,
+                                                                       unsigned int points_per_level,
+                                                                       unsigned int level_factor)
+    : m_autocorrelation(l), m_correlator(points_per_level, level_factor)
+{}
+
+void StreamingRotationalAutocorrelation::reset()
+{
+    m_correlator.reset();
+    m_num_orientations = 0;
+    m_reduce = true;
+}
+
+void StreamingRotationalAutocorrelation::update(const quat<float>* orientations, unsigned int N)
+{
+    if (getNumFrames() == 0)
+    {
+        m_num_orientations = N;
+    }
+    else if (N != m_num_orientations)
+    {
+        throw std::invalid_argument(
+            "StreamingRotationalAutocorrelation requires the same number of orientations in every frame.");
+    }
+
+    const size_t num_harmonics = static_cast<size_t>(getL() + 1) * (getL() + 1);
+    m_expansions.resize(N * num_harmonics);
+    m_autocorrelation.computeHarmonicExpansions(orientations, N, m_expansions.data());
+
+    // The autocorrelation of a pair of frames is the mean over orientations
+    // of the real parts of the inner products of their expansions.
+    const auto autocorrelation = [N, num_harmonics](const std::complex<float>* frame,
+                                                    const std::complex<float>* origin) {
+        double sum = 0;
+        for (size_t i = 0; i < N * num_harmonics; ++i)
+        {
+            sum += origin[i].real() * frame[i].real() + origin[i].imag() * frame[i].imag();
+        }
+        return sum / static_cast<double>(N);
+    };
+    m_correlator.update(m_expansions.data(), m_expansions.size(), autocorrelation);
+    m_reduce = true;
+}
+
+void StreamingRotationalAutocorrelation::reduce()
+{
+    if (!m_reduce)
+    {
+        return;
+    }
+    m_reduce = false;
+
+    std::vector<unsigned int> lags;
+    std::vector<double> autocorrelation;
+    std::vector<unsigned int> counts;
+    m_correlator.reduce(lags, autocorrelation, counts);
+
+    m_lags.prepare(lags.size());
+    m_Ft.prepare(autocorrelation.size());
+    m_counts.prepare(counts.size());
+    std::copy(lags.begin(), lags.end(), m_lags.get());
+    std::copy(counts.begin(), counts.end(), m_counts.get());
+    for (size_t i = 0; i < autocorrelation.size(); ++i)
+    {
+        m_Ft[i] = static_cast<float>(autocorrelation[i]);
+    }
+}
+
 }; }; // end namespace freud::order
@@ -4,9 +4,12 @@
 #ifndef ROTATIONAL_AUTOCORRELATION_H
 #define ROTATIONAL_AUTOCORRELATION_H
 
+#include <array>
 #include <complex>
+#include <vector>
 
 #include "ManagedArray.h"
+#include "MultipleTauCorrelator.h"
 #include "VectorMath.h"
 
 /*! \file RotationalAutocorrelation.h
@@ -50,17 +53,7 @@ public:
     //! Constructor
     /*! \param l The order of the spherical harmonic.
      */
-    explicit RotationalAutocorrelation(unsigned int l) : m_l(l)
-    {
-        // For efficiency, we precompute all required factorials for use during
-        // the per-particle computation.
-        m_factorials.prepare(m_l + 1);
-        m_factorials[0] = 1;
-        for (unsigned int i = 1; i <= m_l; i++)
-        {
-            m_factorials[i] = i * m_factorials[i - 1];
-        }
-    }
+    explicit RotationalAutocorrelation(unsigned int l);
 
     //! Destructor
     ~RotationalAutocorrelation() = default;
@@ -98,30 +91,139 @@ public:
      */
     void compute(const quat<float>* ref_orientations, const quat<float>* orientations, unsigned int N);
 
-private:
-    //! Compute a hyperspherical harmonic.
-    /*! \param xi The first complex number coordinate.
-     *  \param zeta The second complex number coordinate.
-     *  \param l The azimuthal quantum number.
-     *  \param m1 The first magnetic quantum number.
-     *  \param m2 The second magnetic quantum number.
-     *  \return The value of the hyperspherical harmonic (l, m1, m2) at (xi, zeta).
+    //! Compute the weighted hyperspherical harmonic expansions of a set of orientations.
+    /*! \param orientations Quaternions to expand.
+     *  \param N The number of orientations.
+     *  \param expansions Output array of (l + 1)^2 values per orientation.
      *
-     *  The hyperspherical harmonic function is a generalization of spherical
+     *  The autocorrelation of a pair of orientations is the real part of the
+     *  inner product of their expansions, so the expansions of each frame of
+     *  a trajectory only need to be computed once to correlate the frame
+     *  with any number of other frames.
+     */
+    void computeHarmonicExpansions(const quat<float>* orientations, unsigned int N,
+                                   std::complex<float>* expansions) const;
+
+private:
+    //! A term c xi*^k zeta^(m2 - k) zeta*^(m1 - k) (-xi)^(l + k - m1 - m2) of a hyperspherical harmonic.
+    /*! The hyperspherical harmonic function is a generalization of spherical
      *  harmonics from the 2-sphere to the 3-sphere. For details, see Harmonic
      *  functions and matrix elements for hyperspherical quantum field models
-     *  (https://doi.org/10.1063/1.526210). The function needs to be a class
-     *  method to access the cached factorial values for the class's value of
-     *  m_l.
+     *  (https://doi.org/10.1063/1.526210). The harmonic (l, m1, m2) is a sum
+     *  of these terms over k, and the coefficients include the factorials of
+     *  the terms as well as any weights the harmonic is multiplied by.
+     */
+    struct HarmonicTerm
+    {
+        std::complex<float> coefficient;    //!< Coefficient c of the product of powers.
+        unsigned int index;                 //!< Index of the value the term is added to.
+        std::array<unsigned int, 4> powers; //!< Indices of the powers of xi*, zeta, zeta* and -xi.
+    };
+
+    //! Add weighted hyperspherical harmonics of an orientation to an array of values.
+    /*! \param terms Terms of the weighted harmonics.
+     *  \param q The orientation to evaluate the harmonics at.
+     *  \param powers Scratch array of 4 (l + 1) powers.
+     *  \param values Array the terms are added to.
      */
-    std::complex<float> hypersphere_harmonic(const std::complex<float> xi, std::complex<float> zeta,
-                                             const unsigned int m1, const unsigned int m2);
+    void addHarmonicTerms(const std::vector<HarmonicTerm>& terms, const quat<float>& q,
+                          std::complex<float>* powers, std::complex<float>* values) const;
 
     unsigned int m_l; //!< Order of the hyperspherical harmonic.
     float m_Ft {0};   //!< Real value of calculated RA function.
 
     util::ManagedArray<std::complex<float>> m_RA_array; //!< Array of RA values per particle
-    util::ManagedArray<unsigned int> m_factorials;      //!< Array of cached factorials
+    std::vector<HarmonicTerm> m_autocorrelation_terms;  //!< Terms of the autocorrelation with the identity
+    std::vector<HarmonicTerm> m_expansion_terms;        //!< Terms of the weighted harmonic expansions
+};
+
+//! Accumulates the rotational autocorrelation of a trajectory frame by frame.
+/*! The hyperspherical harmonic expansions of the orientations of each frame
+ *  are computed once and stored in a util::MultipleTauCorrelator, which
+ *  correlates them with the stored expansions of earlier frames to
+ *  accumulate the autocorrelation at logarithmically spaced lags. Each pair
+ *  of frames then costs one inner product of (l + 1)^2 values per
+ *  orientation, rather than a full evaluation of the hyperspherical
+ *  harmonics of the relative orientations. For lags below points_per_level
+ *  the autocorrelation is averaged over all time origins, and at longer lags
+ *  only fewer time origins are averaged over.
+ */
+class StreamingRotationalAutocorrelation
+{
+public:
+    //! Constructor
+    /*! \param l The order of the spherical harmonic.
+     *  \param points_per_level Number of frames held in each level.
+     *  \param level_factor Ratio of the frame spacings of consecutive levels.
+     */
+    explicit StreamingRotationalAutocorrelation(unsigned int l, unsigned int points_per_level = 16,
+                                                unsigned int level_factor = 2);
+
+    //! Reset the accumulated autocorrelations and stored frames.
+    void reset();
+
+    //! Add the next frame of the trajectory.
+    /*! \param orientations Quaternions in this frame.
+     *  \param N The number of orientations, which must not change between frames.
+     */
+    void update(const quat<float>* orientations, unsigned int N);
+
+    //! Get the quantum number l used in calculations.
+    unsigned int getL() const
+    {
+        return m_autocorrelation.getL();
+    }
+
+    unsigned int getPointsPerLevel() const
+    {
+        return m_correlator.getPointsPerLevel();
+    }
+
+    unsigned int getLevelFactor() const
+    {
+        return m_correlator.getLevelFactor();
+    }
+
+    //! Get the number of frames added since the last reset.
+    unsigned int getNumFrames() const
+    {
+        return m_correlator.getNumFrames();
+    }
+
+    //! Get the lags (in frames) at which the autocorrelation has been accumulated.
+    const util::ManagedArray<unsigned int>& getLags()
+    {
+        reduce();
+        return m_lags;
+    }
+
+    //! Get the autocorrelation of the system for each lag.
+    const util::ManagedArray<float>& getRotationalAutocorrelation()
+    {
+        reduce();
+        return m_Ft;
+    }
+
+    //! Get the number of pairs of frames averaged over for each lag.
+    const util::ManagedArray<unsigned int>& getCounts()
+    {
+        reduce();
+        return m_counts;
+    }
+
+private:
+    //! Collect the accumulated lags into m_lags, m_Ft and m_counts.
+    void reduce();
+
+    RotationalAutocorrelation m_autocorrelation;                   //!< Computes the harmonic expansions.
+    util::MultipleTauCorrelator<std::complex<float>> m_correlator; //!< Correlator holding the expansions.
+    std::vector<std::complex<float>> m_expansions;                 //!< Expansions of the newest frame.
+    unsigned int m_num_orientations {0};                           //!< Number of orientations per frame.
+    bool m_reduce {true};                                          //!< Whether to collect the results again.
+
+    util::ManagedArray<unsigned int> m_lags;   //!< Lags with accumulated pairs.
+    util::ManagedArray<float> m_Ft;            //!< Autocorrelation of each lag.
+    util::ManagedArray<unsigned int> m_counts; //!< Number of pairs of each lag.
 };
 
 }; }; // end namespace freud::order
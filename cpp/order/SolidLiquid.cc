@@ -25,80 +25,153 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
     // This function requires a NeighborList object, so we always make one and store it locally.
     m_nlist = locality::makeDefaultNlist(points, nlist, points->getPoints(), points->getNPoints(), qargs);
 
+    // A half neighbor list is mirrored into the full list that Steinhardt
+    // needs, and ql_ij is only computed once for each pair of points.
+    const bool mirrored = qargs.half_list && nlist == nullptr;
+    if (mirrored)
+    {
+        m_nlist.addMirroredBonds();
+    }
+
     const unsigned int num_query_points(m_nlist.getNumQueryPoints());
 
     // Compute Steinhardt using neighbor list (also gets ql for normalization)
     m_steinhardt.compute(&m_nlist, points, qargs);
-    // SolidLiquid only has one l value so we index the 2D array from Steinhardt.
-    const auto& qlm = m_steinhardt.getQlm()[0];
-    const auto& ql = m_steinhardt.getQl();
+    // SolidLiquid only has one l value, so each row of the packed array
+    // from Steinhardt holds the m_num_ms values of qlm of one particle.
+    const std::complex<float>* qlm = m_steinhardt.getQlm().get();
+    const float* ql = m_steinhardt.getQl().get();
 
     // Compute (normalized) dot products for each bond in the neighbor list
     const auto normalizationfactor = float(4.0 * M_PI / m_num_ms);
-    const unsigned int num_bonds(m_nlist.getNumBonds());
-    m_ql_ij.prepare(num_bonds);
+    m_ql_ij.prepare(m_nlist.getNumBonds());
 
+    m_nlist.updateSegmentCounts();
     util::forLoopWrapper(
         0, num_query_points,
         [&](size_t begin, size_t end) {
             for (unsigned int i = begin; i != end; ++i)
             {
-                unsigned int bond(m_nlist.find_first_index(i));
-                for (; bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+                const locality::NeighborListSegment segment(m_nlist.getSegment(i));
+                const std::complex<float>* qlm_i = qlm + static_cast<size_t>(i) * m_num_ms;
+                // Optionally normalize dot products by points' ql values,
+                // accounting for the normalization of ql values
+                const float normalization_i = m_normalize_q ? normalizationfactor / ql[i] : float(1);
+                for (unsigned int n = 0; n < segment.size(); ++n)
                 {
-                    const unsigned int j(m_nlist.getNeighbors()(bond, 1));
+                    const unsigned int j(segment.getPointIdx(n));
+                    if (mirrored && j < i)
+                    {
+                        continue;
+                    }
+                    const std::complex<float>* qlm_j = qlm + static_cast<size_t>(j) * m_num_ms;
 
-                    // Accumulate the dot product over m of qlmi and qlmj vectors
-                    std::complex<float> bond_ql_ij = 0;
+                    // Accumulate the real part of the dot product over m of
+                    // qlmi and qlmj vectors
+                    float bond_ql_ij = 0;
                     for (unsigned int k = 0; k < m_num_ms; k++)
                     {
-                        bond_ql_ij += qlm(i, k) * std::conj(qlm(j, k));
+                        bond_ql_ij += qlm_i[k].real() * qlm_j[k].real() + qlm_i[k].imag() * qlm_j[k].imag();
                     }
-
-                    // Optionally normalize dot products by points' ql values,
-                    // accounting for the normalization of ql values
                     if (m_normalize_q)
                     {
-                        bond_ql_ij *= normalizationfactor / (ql[i] * ql[j]);
+                        bond_ql_ij *= normalization_i / ql[j];
                     }
-                    m_ql_ij[bond] = bond_ql_ij.real();
+                    m_ql_ij[segment.begin() + n] = bond_ql_ij;
                 }
             }
         },
         true);
 
-    // Filter neighbors to contain only solid-like bonds
-    std::vector<bool> solid_filter(num_bonds);
-    for (unsigned int bond(0); bond < num_bonds; bond++)
+    // The dot products are symmetric, so the skipped bonds (i, j) with j < i
+    // take the value of their mirror (j, i) in the sorted segment of j.
+    if (mirrored)
     {
-        solid_filter[bond] = (m_ql_ij[bond] > m_q_threshold);
+        util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+            for (unsigned int i = begin; i != end; ++i)
+            {
+                const locality::NeighborListSegment segment(m_nlist.getSegment(i));
+                for (unsigned int n = 0; n < segment.size() && segment.getPointIdx(n) < i; ++n)
+                {
+                    const locality::NeighborListSegment segment_j(m_nlist.getSegment(segment.getPointIdx(n)));
+                    unsigned int lower = 0;
+                    unsigned int upper = segment_j.size();
+                    while (lower < upper)
+                    {
+                        const unsigned int middle = (lower + upper) / 2;
+                        if (segment_j.getPointIdx(middle) < i)
+                        {
+                            lower = middle + 1;
+                        }
+                        else
+                        {
+                            upper = middle;
+                        }
+                    }
+                    m_ql_ij[segment.begin() + n] = m_ql_ij[segment_j.begin() + lower];
+                }
+            }
+        });
     }
-    freud::locality::NeighborList solid_nlist(m_nlist);
-    solid_nlist.filter(solid_filter.cbegin());
 
-    // Save the neighbor counts of solid-like bonds for each query point
-    m_number_of_connections.prepare(num_query_points);
-    for (unsigned int i(0); i < num_query_points; i++)
+    computeClusters(points);
+}
+
+void SolidLiquid::threshold(const freud::locality::NeighborQuery* points, float q_threshold,
+                            unsigned int solid_threshold)
+{
+    if (q_threshold < 0.0)
     {
-        m_number_of_connections[i] = solid_nlist.getCounts()[i];
+        throw std::invalid_argument(
+            "SolidLiquid requires that the dot product cutoff q_threshold must be non-negative.");
     }
+    if (points->getNPoints() != m_nlist.getNumPoints())
+    {
+        throw std::invalid_argument(
+            "SolidLiquid::threshold requires the points used in the last call to compute.");
+    }
+    m_q_threshold = q_threshold;
+    m_solid_threshold = solid_threshold;
+    computeClusters(points);
+}
+
+void SolidLiquid::computeClusters(const freud::locality::NeighborQuery* points)
+{
+    const unsigned int num_query_points(m_nlist.getNumQueryPoints());
+    const unsigned int num_bonds(m_nlist.getNumBonds());
 
-    // Filter nlist to only bonds between solid-like particles
+    // Count the solid-like bonds (bonds with ql_ij above q_threshold) of
+    // each query point
+    m_number_of_connections.prepare(num_query_points);
+    util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        for (unsigned int i = begin; i != end; ++i)
+        {
+            const locality::NeighborListSegment segment(m_nlist.getSegment(i));
+            unsigned int num_solid_bonds = 0;
+            for (unsigned int n = 0; n < segment.size(); ++n)
+            {
+                num_solid_bonds += static_cast<unsigned int>(m_ql_ij[segment.begin() + n] > m_q_threshold);
+            }
+            m_number_of_connections[i] = num_solid_bonds;
+        }
+    });
+
+    // Filter nlist to only solid-like bonds between solid-like particles
     // (particles with more than solid_threshold solid-like bonds)
-    const unsigned int num_solid_bonds(solid_nlist.getNumBonds());
-    std::vector<bool> neighbor_count_filter(num_solid_bonds);
-    for (unsigned int bond(0); bond < num_solid_bonds; bond++)
+    const unsigned int* neighbors = m_nlist.getNeighbors().get();
+    std::vector<bool> solid_filter(num_bonds);
+    for (unsigned int bond(0); bond < num_bonds; bond++)
     {
-        const unsigned int i(solid_nlist.getNeighbors()(bond, 0));
-        const unsigned int j(solid_nlist.getNeighbors()(bond, 1));
-        neighbor_count_filter[bond] = (m_number_of_connections[i] >= m_solid_threshold
-                                       && m_number_of_connections[j] >= m_solid_threshold);
+        const unsigned int i(neighbors[2 * bond]);
+        const unsigned int j(neighbors[2 * bond + 1]);
+        solid_filter[bond] = (m_ql_ij[bond] > m_q_threshold && m_number_of_connections[i] >= m_solid_threshold
+                              && m_number_of_connections[j] >= m_solid_threshold);
     }
-    freud::locality::NeighborList solid_neighbor_nlist(solid_nlist);
-    solid_neighbor_nlist.filter(neighbor_count_filter.cbegin());
+    freud::locality::NeighborList solid_neighbor_nlist(m_nlist);
+    solid_neighbor_nlist.filter(solid_filter.cbegin());
 
     // Find clusters of solid-like particles
-    m_cluster.compute(points, &solid_neighbor_nlist, qargs);
+    m_cluster.compute(points, &solid_neighbor_nlist, freud::locality::QueryArgs());
 }
 
 }; }; // end namespace freud::order
@@ -88,6 +88,16 @@ public:
     void compute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                  freud::locality::QueryArgs qargs);
 
+    //! Reclassify solid-like bonds and particles with new thresholds
+    /*! The neighbor list, qlm and ql_ij of the last call to compute are
+     *  reused, so only the thresholding and clustering are repeated.
+     *  \param points The points used in the last call to compute.
+     *  \param q_threshold The new dot product cutoff.
+     *  \param solid_threshold The new solid-like num connections cutoff.
+     */
+    void threshold(const freud::locality::NeighborQuery* points, float q_threshold,
+                   unsigned int solid_threshold);
+
     //! Returns largest cluster size.
     unsigned int getLargestClusterSize() const
     {
@@ -132,7 +142,7 @@ public:
     //! Get the last calculated qlm for each particle
     const util::ManagedArray<std::complex<float>>& getQlm() const
     {
-        return m_steinhardt.getQlm()[0];
+        return m_steinhardt.getQlm();
     }
 
     //! Return the ql_ij values.
@@ -142,6 +152,9 @@ public:
     }
 
 private:
+    //! Classify solid-like bonds and particles from m_ql_ij and cluster them.
+    void computeClusters(const freud::locality::NeighborQuery* points);
+
     unsigned int m_l;               //!< Value of l for the spherical harmonic.
     unsigned int m_num_ms;          //!< The number of magnetic quantum numbers (2*m_l+1).
     float m_q_threshold;            //!< Dot product cutoff
@@ -0,0 +1,191 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SPHERICAL_HARMONICS_H
+#define SPHERICAL_HARMONICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "CPUDispatch.h"
+
+/*! \file SphericalHarmonics.h
+    \brief Evaluates sums of spherical harmonics over bond vectors by recurrence.
+*/
+
+namespace freud { namespace order {
+
+//! Maximum number of bond vectors evaluated by one call to SphericalHarmonics::addBatch.
+constexpr unsigned int YLM_BATCH_SIZE = 32;
+
+//! Weighted sums of spherical harmonics over batches of unit vectors.
+/*! The spherical harmonics (including the Condon-Shortley phase) of a unit
+ *  vector u are evaluated from its Cartesian components as
+ *  \f$ Y_{lm}(u) = \bar{P}_{lm}(u_z) (u_x + i u_y)^m \f$ for \f$ m \geq 0 \f$,
+ *  where \f$ \bar{P}_{lm} \f$ is the normalized associated Legendre function
+ *  divided by \f$ \sin^m\theta \f$. It is computed with the standard
+ *  three-term recurrence in l, so no trigonometric or inverse trigonometric
+ *  functions are needed. All l up to the maximum l are generated in a
+ *  single sweep over m, and the loops over the vectors of a batch are
+ *  vectorized by the compiler for the instruction set of the CPU (see
+ *  util::dispatch).
+ *
+ *  Sums are stored packed by l and m >= 0 (see packedIndex). The sums for
+ *  negative m follow from \f$ Y_{l,-m} = (-1)^m Y_{lm}^* \f$ because the
+ *  weights are real.
+ */
+class SphericalHarmonics
+{
+public:
+    //! Constructor
+    /*! \param ls The values of l for which sums are accumulated.
+     */
+    explicit SphericalHarmonics(const std::vector<unsigned int>& ls)
+        : m_max_l(ls.empty() ? 0 : *std::max_element(ls.begin(), ls.end())), m_accumulate(m_max_l + 1, 0),
+          m_diagonal(m_max_l + 1), m_a(numPacked()), m_b(numPacked())
+    {
+        for (const auto l : ls)
+        {
+            m_accumulate[l] = 1;
+        }
+        double diagonal = std::sqrt(1.0 / (4.0 * M_PI));
+        for (unsigned int m = 0; m <= m_max_l; ++m)
+        {
+            if (m > 0)
+            {
+                diagonal *= -std::sqrt((2.0 * m + 1.0) / (2.0 * m));
+            }
+            m_diagonal[m] = static_cast<float>(diagonal);
+        }
+        for (unsigned int m = 0; m <= m_max_l; ++m)
+        {
+            for (unsigned int l = m + 1; l <= m_max_l; ++l)
+            {
+                const auto l_sq = static_cast<double>(l * l);
+                const auto m_sq = static_cast<double>(m * m);
+                const auto l_minus_one_sq = static_cast<double>((l - 1) * (l - 1));
+                m_a[packedIndex(l, m)] = static_cast<float>(std::sqrt((4.0 * l_sq - 1.0) / (l_sq - m_sq)));
+                m_b[packedIndex(l, m)]
+                    = static_cast<float>(std::sqrt((l_minus_one_sq - m_sq) / (4.0 * l_minus_one_sq - 1.0)));
+            }
+        }
+    }
+
+    //! Get the maximum l.
+    unsigned int getMaxL() const
+    {
+        return m_max_l;
+    }
+
+    //! Number of packed (l, m) pairs with 0 <= m <= l <= max_l.
+    size_t numPacked() const
+    {
+        return static_cast<size_t>(m_max_l + 1) * (m_max_l + 2) / 2;
+    }
+
+    //! Index of the packed sum of Y_lm for 0 <= m <= l.
+    static size_t packedIndex(unsigned int l, unsigned int m)
+    {
+        return static_cast<size_t>(l) * (l + 1) / 2 + m;
+    }
+
+    //! Add the weighted sums of Y_lm over a batch of unit vectors.
+    /*! \param x The x components of the unit vectors.
+     *  \param y The y components of the unit vectors.
+     *  \param z The z components of the unit vectors.
+     *  \param weight The weight of each vector.
+     *  \param n The number of vectors, at most YLM_BATCH_SIZE.
+     *  \param sums The packed sums to add to, of size numPacked(). Only the
+     *         sums of the values of l given to the constructor are updated.
+     */
+    void addBatch(const float* x, const float* y, const float* z, const float* weight, unsigned int n,
+                  std::complex<float>* sums) const
+    {
+        util::dispatch([&]() FREUD_KERNEL {
+            // The weighted powers (u_x + i u_y)^m, and the current and two
+            // previous terms of the recurrence in l for the current m.
+            float power_re[YLM_BATCH_SIZE];
+            float power_im[YLM_BATCH_SIZE];
+            float p_minus_two[YLM_BATCH_SIZE];
+            float p_minus_one[YLM_BATCH_SIZE];
+            float p[YLM_BATCH_SIZE];
+
+            for (unsigned int k = 0; k < n; ++k)
+            {
+                power_re[k] = weight[k];
+                power_im[k] = 0;
+            }
+            for (unsigned int m = 0; m <= m_max_l; ++m)
+            {
+                if (m > 0)
+                {
+                    for (unsigned int k = 0; k < n; ++k)
+                    {
+                        const float re = power_re[k] * x[k] - power_im[k] * y[k];
+                        power_im[k] = power_re[k] * y[k] + power_im[k] * x[k];
+                        power_re[k] = re;
+                    }
+                }
+                for (unsigned int k = 0; k < n; ++k)
+                {
+                    p_minus_one[k] = m_diagonal[m];
+                }
+                accumulate(m, m, p_minus_one, power_re, power_im, n, sums);
+                if (m == m_max_l)
+                {
+                    break;
+                }
+
+                const float a_first = m_a[packedIndex(m + 1, m)];
+                for (unsigned int k = 0; k < n; ++k)
+                {
+                    p[k] = a_first * z[k] * p_minus_one[k];
+                }
+                accumulate(m + 1, m, p, power_re, power_im, n, sums);
+                for (unsigned int l = m + 2; l <= m_max_l; ++l)
+                {
+                    const float a = m_a[packedIndex(l, m)];
+                    const float b = m_b[packedIndex(l, m)];
+                    for (unsigned int k = 0; k < n; ++k)
+                    {
+                        p_minus_two[k] = p_minus_one[k];
+                        p_minus_one[k] = p[k];
+                        p[k] = a * (z[k] * p_minus_one[k] - b * p_minus_two[k]);
+                    }
+                    accumulate(l, m, p, power_re, power_im, n, sums);
+                }
+            }
+        });
+    }
+
+private:
+    //! Add the sum of p * power over a batch to the packed sum of (l, m), if l is accumulated.
+    void accumulate(unsigned int l, unsigned int m, const float* p, const float* power_re,
+                    const float* power_im, unsigned int n, std::complex<float>* sums) const
+    {
+        if (m_accumulate[l] == 0)
+        {
+            return;
+        }
+        float sum_re = 0;
+        float sum_im = 0;
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            sum_re += p[k] * power_re[k];
+            sum_im += p[k] * power_im[k];
+        }
+        sums[packedIndex(l, m)] += std::complex<float>(sum_re, sum_im);
+    }
+
+    unsigned int m_max_l;           //!< Maximum l.
+    std::vector<char> m_accumulate; //!< Whether sums are accumulated for each l.
+    std::vector<float> m_diagonal;  //!< Pbar_mm for each m.
+    std::vector<float> m_a;         //!< Recurrence coefficient of the previous term, packed by (l, m).
+    std::vector<float> m_b;         //!< Recurrence coefficient of the term before that, packed by (l, m).
+};
+
+}; }; // end namespace freud::order
+
+#endif // SPHERICAL_HARMONICS_H
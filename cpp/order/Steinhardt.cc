@@ -2,8 +2,13 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include "Steinhardt.h"
+#include "CPUDispatch.h"
 #include "NeighborComputeFunctional.h"
+#include "Profiler.h"
+#include "SphericalHarmonics.h"
 #include "utils.h"
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 /*! \file Steinhardt.cc
@@ -12,28 +17,6 @@
 
 namespace freud { namespace order {
 
-// Calculating Ylm using fsph module
-void Steinhardt::computeYlm(fsph::PointSPHEvaluator<float>& sph_eval, const float theta, const float phi,
-                            YlmsType& Ylms) const
-{
-    sph_eval.compute(theta, phi);
-
-    for (size_t i = 0; i < m_ls.size(); ++i)
-    {
-        auto& Ylm = Ylms[i];
-        const auto l = m_ls[i];
-        size_t m_index(0);
-
-        const auto end_iter(sph_eval.begin_l(l + 1, 0, true));
-        for (auto iter(sph_eval.begin_l(l, 0, true)); iter != end_iter; ++iter, ++m_index)
-        {
-            // Manually add the Condon-Shortley phase, (-1)^m, to positive odd m
-            const float phase = (m_index <= l && m_index % 2 == 1) ? -1 : 1;
-            Ylm[m_index] = phase * (*iter);
-        }
-    }
-}
-
 void Steinhardt::reallocateArrays(unsigned int Np)
 {
     m_Np = Np;
@@ -50,37 +33,41 @@ void Steinhardt::reallocateArrays(unsigned int Np)
         m_wli.prepare({Np, num_ls});
     }
 
-    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    m_qlmi.prepare({Np, m_total_ms});
+    m_qlm.prepare(m_total_ms);
+    if (m_average)
     {
-        const auto num_ms = m_num_ms[l_index];
-        m_qlmi[l_index].prepare({Np, num_ms});
-        m_qlm[l_index].prepare(num_ms);
-        if (m_average)
-        {
-            m_qlmiAve[l_index].prepare({Np, num_ms});
-        }
+        m_qlmiAve.prepare({Np, m_total_ms});
     }
 }
 
 void Steinhardt::compute(const freud::locality::NeighborList* nlist,
                          const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
+    FREUD_PROFILE_SCOPE("Steinhardt::compute");
+
     // Allocate and zero out arrays as necessary.
     reallocateArrays(points->getNPoints());
 
+    // Averaging walks the neighbors of each point twice, so the neighbors
+    // are found once and kept in a neighbor list for both passes.
+    std::unique_ptr<freud::locality::NeighborList> query_nlist;
+    if (m_average && nlist == nullptr)
+    {
+        query_nlist.reset(points->query(points->getPoints(), points->getNPoints(), qargs)->toNeighborList());
+        nlist = query_nlist.get();
+    }
+
     // Computes the base qlmi required for each specialized order parameter
     baseCompute(nlist, points, qargs);
 
     if (m_average)
     {
-        computeAve(nlist, points, qargs);
+        computeAve(*nlist);
     }
 
     // Reduce qlm
-    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-    {
-        m_qlm_local[l_index].reduceInto(m_qlm[l_index]);
-    }
+    m_qlm_local.reduceInto(m_qlm);
 
     if (m_wl)
     {
@@ -99,6 +86,7 @@ void Steinhardt::compute(const freud::locality::NeighborList* nlist,
 void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
                              const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
+    FREUD_PROFILE_SCOPE("Steinhardt::compute::qlm");
     std::vector<float> normalizationfactor(m_ls.size());
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
@@ -106,163 +94,168 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
     }
     // For consistency, this reset is done here regardless of whether the array
     // is populated in baseCompute or computeAve.
-    for (auto& qlm_local : m_qlm_local)
-    {
-        qlm_local.reset();
-    }
+    m_qlm_local.reset();
+
+    const SphericalHarmonics spherical_harmonics(m_ls);
+    util::ThreadStorage<std::complex<float>> local_ylm_sums(spherical_harmonics.numPacked());
 
     freud::locality::loopOverNeighborsIterator(
         points, points->getPoints(), m_Np, qargs, nlist,
         [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
             float total_weight(0);
             const vec3<float> ref((*points)[i]);
-            // Construct PointSPHEvaluator outside loop since the construction is costly.
-            auto max_l = *std::max_element(m_ls.begin(), m_ls.end());
-            fsph::PointSPHEvaluator<float> sph_eval(max_l);
 
-            // Alocate and instantiate this array before looping over particles to prevent N instantiations
-            // and N * m_l.size() allocations.
-            YlmsType Ylms(m_ls.size());
-            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-            {
-                Ylms[l_index].resize(m_num_ms[l_index]);
-            }
+            // Bonds are buffered as unit vectors and their spherical
+            // harmonics are summed a batch at a time.
+            auto& ylm_sums = local_ylm_sums.local();
+            ylm_sums.reset();
+            float x[YLM_BATCH_SIZE];
+            float y[YLM_BATCH_SIZE];
+            float z[YLM_BATCH_SIZE];
+            float weights[YLM_BATCH_SIZE];
+            unsigned int batch_size(0);
 
             for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
             {
                 const vec3<float> delta = points->getBox().wrap((*points)[nb.getPointIdx()] - ref);
                 const float weight(m_weighted ? nb.getWeight() : float(1.0));
+                const float distance = std::sqrt(dot(delta, delta));
 
-                // phi is usually in range 0..2Pi, but
-                // it only appears in Ylm as exp(im\phi),
-                // so range -Pi..Pi will give same results.
-                const float phi = std::atan2(delta.y, delta.x); // -Pi..Pi
-
-                // This value must be clamped in cases where the particles are
-                // aligned along z, otherwise due to floating point error we
-                // could get delta.z/nb.distance = -1-eps, which is outside the
-                // valid range of std::acos.
-                float theta = std::acos(util::clamp(delta.z / nb.getDistance(), -1, 1)); // 0..Pi
-
-                // If the points are directly on top of each other,
-                // theta should be zero instead of nan.
-                if (nb.getDistance() == float(0))
+                // If the points are directly on top of each other, the bond
+                // is taken to point along z (theta = 0).
+                if (distance == float(0))
                 {
-                    theta = 0;
+                    x[batch_size] = 0;
+                    y[batch_size] = 0;
+                    z[batch_size] = 1;
                 }
-
-                computeYlm(sph_eval, theta, phi, Ylms); // Fill up Ylm
-
-                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+                else
                 {
-                    auto& qlmi = m_qlmi[l_index];
-                    const auto& Ylm = Ylms[l_index];
-                    // Get the initial index and iterate using ++ for faster iteration
-                    // Profiling showed using operator() to slow the code significantly.
-                    const size_t index = qlmi.getIndex({i, 0});
-                    for (size_t k = 0; k < m_num_ms[l_index]; ++k)
-                    {
-                        qlmi[index + k] += weight * Ylm[k];
-                    }
+                    x[batch_size] = delta.x / distance;
+                    y[batch_size] = delta.y / distance;
+                    z[batch_size] = delta.z / distance;
+                }
+                weights[batch_size] = weight;
+                if (++batch_size == YLM_BATCH_SIZE)
+                {
+                    spherical_harmonics.addBatch(x, y, z, weights, batch_size, ylm_sums.get());
+                    batch_size = 0;
                 }
                 // Accumulate weight for normalization
                 total_weight += weight;
             } // End loop going over neighbor bonds
+            spherical_harmonics.addBatch(x, y, z, weights, batch_size, ylm_sums.get());
+
+            // Unpack the sums into qlmi, ordered as m = 0, 1, ..., l, -1, ..., -l for each l.
+            std::complex<float>* const qlmi = m_qlmi.get() + i * m_total_ms;
+            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+            {
+                const auto l = m_ls[l_index];
+                std::complex<float>* const qlmi_l = qlmi + m_ms_offsets[l_index];
+                for (unsigned int m = 0; m <= l; ++m)
+                {
+                    const std::complex<float> ylm_sum = ylm_sums[SphericalHarmonics::packedIndex(l, m)];
+                    qlmi_l[m] += ylm_sum;
+                    if (m > 0)
+                    {
+                        const float phase = (m % 2 == 1) ? -1 : 1;
+                        qlmi_l[l + m] += phase * std::conj(ylm_sum);
+                    }
+                }
+            }
 
             // Normalize!
             const size_t qli_i_start = m_qli.getIndex({i, 0});
+            auto& qlm_local = m_qlm_local.local();
             for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
             {
-                // get l specific vectors/arrays
-                auto& qlmi = m_qlmi[l_index];
-                auto& qlm_local = m_qlm_local[l_index];
-                const size_t first_qlmi_index = qlmi.getIndex({i, 0});
+                const size_t offset = m_ms_offsets[l_index];
                 const size_t qli_index = qli_i_start + l_index;
 
-                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                for (size_t k = offset; k < offset + m_num_ms[l_index]; ++k)
                 {
-                    // Cache the index for efficiency.
-                    const size_t qlmi_index = first_qlmi_index + k;
-
-                    qlmi[qlmi_index] /= total_weight;
+                    qlmi[k] /= total_weight;
                     // Add the norm, which is the (complex) squared magnitude
-                    m_qli[qli_index] += norm(qlmi[qlmi_index]);
+                    m_qli[qli_index] += norm(qlmi[k]);
                     // This array gets populated by computeAve in the averaging case.
                     if (!m_average)
                     {
-                        qlm_local.local()[k] += qlmi[qlmi_index] / float(m_Np);
+                        qlm_local[k] += qlmi[k] / float(m_Np);
                     }
                 }
                 m_qli[qli_index] *= normalizationfactor[l_index];
                 m_qli[qli_index] = std::sqrt(m_qli[qli_index]);
             }
-        });
+        },
+        true, util::LoopSchedule {1, &m_affinity});
 }
 
-void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
-                            const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
+void Steinhardt::computeAve(const freud::locality::NeighborList& nlist)
 {
-    std::shared_ptr<locality::NeighborQueryIterator> iter;
-    if (nlist == nullptr)
-    {
-        iter = points->query(points->getPoints(), points->getNPoints(), qargs);
-    }
-
+    FREUD_PROFILE_SCOPE("Steinhardt::compute::average");
     std::vector<float> normalizationfactor(m_ls.size());
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
         normalizationfactor[l_index] = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
     }
 
-    freud::locality::loopOverNeighborsIterator(
-        points, points->getPoints(), m_Np, qargs, nlist,
-        [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
-            unsigned int neighborcount(1);
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+    // Points past the query points of the list have no neighbors.
+    const unsigned int num_query_points = std::min(m_Np, nlist.getNumQueryPoints());
+    const unsigned int* const offsets = nlist.getOffsets().get();
+    const unsigned int* const neighbors = nlist.getNeighbors().get();
+    // The rows of qlmi are summed as interleaved real and imaginary parts.
+    const size_t row_size = 2 * static_cast<size_t>(m_total_ms);
+    const auto* const qlmi_rows = reinterpret_cast<const float*>(m_qlmi.get());
+    auto* const qlmiAve_rows = reinterpret_cast<float*>(m_qlmiAve.get());
+
+    util::forLoopWrapper(
+        0, m_Np,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
             {
-                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+                // Adding all the qlm of the neighbors, for all l at once.
+                unsigned int neighborcount(1);
+                if (i < num_query_points)
                 {
-                    auto& qlmiAve = m_qlmiAve[l_index];
-                    auto& qlmi = m_qlmi[l_index];
-                    const auto ave_index = qlmiAve.getIndex({i, 0});
-                    const auto nb_index = qlmi.getIndex({nb.getPointIdx(), 0});
-                    for (size_t k = 0; k < m_num_ms[l_index]; ++k)
-                    {
-                        // Adding all the qlm of the neighbors. We use the
-                        // vector function signature for indexing into the
-                        // arrays for speed.
-                        qlmiAve[ave_index + k] += qlmi[nb_index + k];
-                    }
+                    float* const qlmiAve_row = qlmiAve_rows + i * row_size;
+                    util::dispatch([&]() FREUD_KERNEL {
+                        for (unsigned int bond = offsets[i]; bond < offsets[i + 1]; ++bond)
+                        {
+                            const float* const qlmj_row = qlmi_rows + neighbors[2 * bond + 1] * row_size;
+                            for (size_t k = 0; k < row_size; ++k)
+                            {
+                                qlmiAve_row[k] += qlmj_row[k];
+                            }
+                        }
+                    });
+                    neighborcount += offsets[i + 1] - offsets[i];
                 }
-                neighborcount++;
-            } // End loop over particle's bonds
-
-            // Normalize!
 
-            const size_t qliAve_i_start = m_qliAve.getIndex({i, 0});
-            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-            {
-                auto& qlmiAve = m_qlmiAve[l_index];
-                auto& qlmi = m_qlmi[l_index];
-                auto& qlm_local = m_qlm_local[l_index];
-                const size_t first_qlmi_index = qlmiAve.getIndex({i, 0});
-                const size_t qliAve_index = qliAve_i_start + l_index;
-
-                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                // Normalize!
+                std::complex<float>* const qlmiAve = m_qlmiAve.get() + i * m_total_ms;
+                const std::complex<float>* const qlmi = m_qlmi.get() + i * m_total_ms;
+                const size_t qliAve_i_start = m_qliAve.getIndex({i, 0});
+                auto& qlm_local = m_qlm_local.local();
+                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
                 {
-                    // Cache the index for efficiency.
-                    const size_t qlmi_index = first_qlmi_index + k;
-                    // Add the qlm of the particle i itself
-                    qlmiAve[qlmi_index] += qlmi[qlmi_index];
-                    qlmiAve[qlmi_index] /= static_cast<float>(neighborcount);
-                    qlm_local.local()[k] += qlmiAve[qlmi_index] / float(m_Np);
-                    // Add the norm, which is the complex squared magnitude
-                    m_qliAve[qliAve_index] += norm(qlmiAve[qlmi_index]);
+                    const size_t offset = m_ms_offsets[l_index];
+                    const size_t qliAve_index = qliAve_i_start + l_index;
+
+                    for (size_t k = offset; k < offset + m_num_ms[l_index]; ++k)
+                    {
+                        // Add the qlm of the particle i itself
+                        qlmiAve[k] += qlmi[k];
+                        qlmiAve[k] /= static_cast<float>(neighborcount);
+                        qlm_local[k] += qlmiAve[k] / float(m_Np);
+                        // Add the norm, which is the complex squared magnitude
+                        m_qliAve[qliAve_index] += norm(qlmiAve[k]);
+                    }
+                    m_qliAve[qliAve_index] *= normalizationfactor[l_index];
+                    m_qliAve[qliAve_index] = std::sqrt(m_qliAve[qliAve_index]);
                 }
-                m_qliAve[qliAve_index] *= normalizationfactor[l_index];
-                m_qliAve[qliAve_index] = std::sqrt(m_qliAve[qliAve_index]);
             }
-        });
+        },
+        util::LoopSchedule {1, &m_affinity});
 }
 
 std::vector<float> Steinhardt::normalizeSystem()
@@ -270,7 +263,7 @@ std::vector<float> Steinhardt::normalizeSystem()
     std::vector<float> system_norms(m_ls.size());
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
-        auto& qlm = m_qlm[l_index];
+        const std::complex<float>* const qlm = m_qlm.get() + m_ms_offsets[l_index];
         auto l = m_ls[l_index];
         float calc_norm(0);
         const auto normalizationfactor = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
@@ -283,8 +276,7 @@ std::vector<float> Steinhardt::normalizeSystem()
 
         if (m_wl)
         {
-            const auto wigner3j_values = getWigner3j(l);
-            float wl_system_norm = reduceWigner3j(qlm.get(), l, wigner3j_values);
+            float wl_system_norm = reduceWigner3j(qlm, getWigner3jTerms(l));
 
             // The normalization factor of wl is calculated using qli, which is
             // equivalent to calculate the normalization factor from qlmi
@@ -304,33 +296,41 @@ std::vector<float> Steinhardt::normalizeSystem()
 }
 
 void Steinhardt::aggregatewl(util::ManagedArray<float>& target,
-                             const std::vector<util::ManagedArray<std::complex<float>>>& source,
+                             const util::ManagedArray<std::complex<float>>& source,
                              const util::ManagedArray<float>& normalization_source) const
 {
-    util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
-        for (size_t i = begin; i < end; ++i)
-        {
-            const auto target_particle_index = target.getIndex({i, 0});
-            const auto norm_particle_index = normalization_source.getIndex({i, 0});
-            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-            {
-                const auto l = m_ls[l_index];
-                const auto& source_l = source[l_index];
-
-                const auto normalizationfactor = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
-                const auto wigner3j_values = getWigner3j(l);
+    FREUD_PROFILE_SCOPE("Steinhardt::compute::wl");
+    // Look up the terms of every l once, so that the loop over particles
+    // only streams through the packed qlm array.
+    const size_t num_ls = m_ls.size();
+    std::vector<const std::vector<Wigner3jTerm>*> terms(num_ls);
+    std::vector<float> normalizationfactor(num_ls);
+    for (size_t l_index = 0; l_index < num_ls; ++l_index)
+    {
+        terms[l_index] = &getWigner3jTerms(m_ls[l_index]);
+        normalizationfactor[l_index] = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
+    }
 
-                target[target_particle_index + l_index]
-                    = reduceWigner3j(&(source_l({i, 0})), l, wigner3j_values);
-                if (m_wl_normalize)
+    util::forLoopWrapper(
+        0, m_Np,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const std::complex<float>* const source_i = source.get() + i * m_total_ms;
+                for (size_t l_index = 0; l_index < num_ls; ++l_index)
                 {
-                    const float normalization = std::sqrt(normalizationfactor)
-                        / normalization_source[norm_particle_index + l_index];
-                    target[target_particle_index + l_index] *= normalization * normalization * normalization;
+                    const size_t index = i * num_ls + l_index;
+                    target[index] = reduceWigner3j(source_i + m_ms_offsets[l_index], *terms[l_index]);
+                    if (m_wl_normalize)
+                    {
+                        const float normalization
+                            = std::sqrt(normalizationfactor[l_index]) / normalization_source[index];
+                        target[index] *= normalization * normalization * normalization;
+                    }
                 }
             }
-        }
-    });
+        },
+        util::LoopSchedule {1, &m_affinity});
 }
 
 }; }; // end namespace freud::order
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <complex>
+#include <tbb/partitioner.h>
 
 #include "Box.h"
 #include "ManagedArray.h"
@@ -14,7 +15,6 @@
 #include "ThreadStorage.h"
 #include "VectorMath.h"
 #include "Wigner3j.h"
-#include "fsph/src/spherical_harmonics.hpp"
 
 /*! \file Steinhardt.h
     \brief Computes variants of Steinhardt order parameters.
@@ -22,8 +22,6 @@
 
 namespace freud { namespace order {
 
-using YlmsType = std::vector<std::vector<std::complex<float>>>;
-
 //! Compute the Steinhardt local rotationally invariant ql or wl order parameter for a set of points
 /*!
  * Implements the rotationally invariant ql or wl order parameter described
@@ -65,14 +63,17 @@ public:
      */
     explicit Steinhardt(const std::vector<unsigned int>& ls, bool average = false, bool wl = false,
                         bool weighted = false, bool wl_normalize = false)
-        : m_ls(ls), m_num_ms(m_ls.size()), m_average(average), m_wl(wl), m_weighted(weighted),
-          m_wl_normalize(wl_normalize), m_qlm_local(m_ls.size()), m_qlmi(ls.size()), m_qlm(ls.size()),
-          m_qlmiAve(ls.size()), m_qlmAve(ls.size())
+        : m_ls(ls), m_num_ms(m_ls.size()), m_ms_offsets(m_ls.size()), m_average(average), m_wl(wl),
+          m_weighted(weighted), m_wl_normalize(wl_normalize)
 
     {
         std::transform(m_ls.cbegin(), m_ls.cend(), m_num_ms.begin(), [](const auto& l) { return 2 * l + 1; });
-        std::transform(m_ls.cbegin(), m_ls.cend(), m_qlm_local.begin(),
-                       [](const auto& l) { return util::ThreadStorage<std::complex<float>>(2 * l + 1); });
+        for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+        {
+            m_ms_offsets[l_index] = m_total_ms;
+            m_total_ms += m_num_ms[l_index];
+        }
+        m_qlm_local.resize(m_total_ms);
     }
 
     //! Steinhardt Class Constructor
@@ -114,7 +115,10 @@ public:
     }
 
     //! Get the last calculated qlm for each particle and l
-    const std::vector<util::ManagedArray<std::complex<float>>>& getQlm() const
+    /*! The array has shape (N, sum(2l+1)). The qlm of each l are stored
+     *  contiguously in the order of getL(), starting at getMsOffsets().
+     */
+    const util::ManagedArray<std::complex<float>>& getQlm() const
     {
         return m_qlmi;
     }
@@ -158,14 +162,13 @@ public:
         return m_ls;
     }
 
-private:
-    //! \internal
-    //! Spherical harmonics calculation for Ylm filling a
-    //  std::vector<std::vector<std::complex<float> > > with values for m = 0, 1, ..., l, -1, ..., -l
-    //  for all l in m_ls
-    void computeYlm(fsph::PointSPHEvaluator<float>& sph_eval, const float theta, const float phi,
-                    YlmsType& Ylms) const;
+    //! Get the offset of the first m of each l in the packed qlm arrays
+    std::vector<size_t> getMsOffsets() const
+    {
+        return m_ms_offsets;
+    }
 
+private:
     template<typename T> std::shared_ptr<T> makeArray(size_t size);
 
     //! Reallocates only the necessary arrays when the number of particles changes
@@ -177,8 +180,11 @@ private:
                      freud::locality::QueryArgs qargs);
 
     //! Calculates the neighbor average ql order parameter
-    void computeAve(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
-                    freud::locality::QueryArgs qargs);
+    /*! The qlm of each point and its neighbors are summed as a sparse
+     *  matrix-vector product of the CSR adjacency of the neighbor list with
+     *  the rows of qlmi.
+     */
+    void computeAve(const freud::locality::NeighborList& nlist);
 
     //! Compute the system-wide order by averaging over particles, then
     //  reducing over the m values to produce a single scalar.
@@ -186,14 +192,15 @@ private:
 
     //! Sum over Wigner 3j coefficients to compute third-order invariants
     //  wl from second-order invariants ql
-    void aggregatewl(util::ManagedArray<float>& target,
-                     const std::vector<util::ManagedArray<std::complex<float>>>& source,
+    void aggregatewl(util::ManagedArray<float>& target, const util::ManagedArray<std::complex<float>>& source,
                      const util::ManagedArray<float>& normalization_source) const;
 
     // Member variables used for compute
     unsigned int m_Np {0};              //!< Last number of points computed
     std::vector<unsigned int> m_ls;     //!< Spherical harmonic l values.
     std::vector<unsigned int> m_num_ms; //!< The number of magnetic quantum numbers for each l (2*l+1).
+    std::vector<size_t> m_ms_offsets;   //!< Offset of the first m of each l in the packed qlm arrays.
+    size_t m_total_ms {0};              //!< Total number of magnetic quantum numbers over all l.
 
     // Flags
     bool m_average;      //!< Whether to take a second shell average (default false)
@@ -201,19 +208,20 @@ private:
     bool m_weighted;     //!< Whether to use neighbor weights in computing qlmi (default false)
     bool m_wl_normalize; //!< Whether to normalize the third-order invariant wl (default false)
 
-    std::vector<util::ManagedArray<std::complex<float>>> m_qlmi; //!< qlm for each particle i
-    std::vector<util::ManagedArray<std::complex<float>>> m_qlm;  //!< Normalized qlm(Ave) for the whole system
-    std::vector<util::ThreadStorage<std::complex<float>>>
-        m_qlm_local;                    //!< Thread-specific m_qlm(Ave) for each l
+    // The qlm arrays are packed over l, with the ms of each l starting at m_ms_offsets.
+    util::ManagedArray<std::complex<float>> m_qlmi;       //!< qlm for each particle i
+    util::ManagedArray<std::complex<float>> m_qlm;        //!< Normalized qlm(Ave) for the whole system
+    util::ThreadStorage<std::complex<float>> m_qlm_local; //!< Thread-specific m_qlm(Ave)
+    util::ManagedArray<std::complex<float>> m_qlmiAve;    //!< qlm averaged over the 2nd neighbor shell
+
     util::ManagedArray<float> m_qli;    //!< ql locally invariant order parameter for each particle i
     util::ManagedArray<float> m_qliAve; //!< Averaged ql with 2nd neighbor shell for each particle i
-    std::vector<util::ManagedArray<std::complex<float>>>
-        m_qlmiAve; //!< Averaged qlm with 2nd neighbor shell for each particle i
-    std::vector<util::ManagedArray<std::complex<float>>>
-        m_qlmAve;                  //!< Normalized qlmiAve for the whole system
-    std::vector<float> m_norm {0}; //!< System normalized order parameter
+    std::vector<float> m_norm {0};      //!< System normalized order parameter
     util::ManagedArray<float>
         m_wli; //!< wl order parameter for each particle i, also used for wl averaged data
+
+    //! Mapping of particles to threads, replayed by the loops over particles of every compute.
+    mutable tbb::affinity_partitioner m_affinity;
 };
 
 }; };  // end namespace freud::order
@@ -8,58 +8,43 @@
 #include <vector>
 
 /*! \file Wigner3j.h
- *  \brief Stores and reduces over Wigner 3j coefficients for l from 0 to 20
+ *  \brief Generates and reduces over Wigner 3j coefficients for l from 0 to 20
  */
 
 namespace freud { namespace order {
 
+//! Maximum l for which Wigner 3j coefficients are available.
+constexpr unsigned int WIGNER3J_MAX_L = 20;
+
 //! Compute array index for m values, indexed like:
 //  [0, 1, ..., l, -1, -2, ..., -l]
 int lmIndex(int l, int m);
 
+//! A term of the sum over m1 + m2 + m3 = 0 of a third-order invariant.
+/*! Only the terms with m1 <= m2 <= m3 are stored. The coefficient is the
+ *  Wigner 3j symbol (l l l; m1 m2 m3) multiplied by the number of distinct
+ *  permutations of (m1, m2, m3), which all contribute equally to the sum
+ *  for even l. For odd l the invariant vanishes and there are no terms.
+ */
+struct Wigner3jTerm
+{
+    unsigned int m1_index; //!< Index of m1 in the ordering [0, 1, ..., l, -1, ..., -l].
+    unsigned int m2_index; //!< Index of m2 in the ordering [0, 1, ..., l, -1, ..., -l].
+    unsigned int m3_index; //!< Index of m3 in the ordering [0, 1, ..., l, -1, ..., -l].
+    float coefficient;     //!< Wigner 3j symbol times the number of permutations.
+};
+
+//! Get the nonzero terms of the third-order invariant for l.
+/*! The terms of all l up to WIGNER3J_MAX_L are generated once, on first use,
+ *  from the Racah formula, and stored contiguously for each l.
+ */
+const std::vector<Wigner3jTerm>& getWigner3jTerms(unsigned int l);
+
 //! Reduce an array using Wigner 3j coefficients to construct a
 //  third-order rotational invariant quantity.
 //  source array must be indexed by m, like [0, 1, ..., l, -1, -2, ..., -l].
-float reduceWigner3j(const std::complex<float>* source, unsigned int l_, const std::vector<double>& wigner3j);
-
-std::vector<double> getWigner3j(unsigned int l);
-// All Wigner 3j coefficients created using sympy
-/*
-
-from sympy.physics.wigner import wigner_3j
-import numpy as np
-import json
-
-wigner = {}
-for l in range(21):
-    wigner[l] = []
-    for m1 in range(-l, l+1):
-        for m2 in range(max(-l-m1, -l), min(l-m1, l)+1):
-            m3 = -m1-m2
-            wigner[l].append(float(wigner_3j(l, l, l, m1, m2, m3)))
-
-with open('wigner3j.json', 'w') as jsonfile:
-    json.dump(wigner, jsonfile, sort_keys=True, indent=4)
-
-WIGNER_COEFF = """
-    case {l}:
-    {{
-        return {{
-{values}
-        }};
-    }}"""
-
-def format_values(values, per_line=4, spaces=12):
-    lines = []
-    for line in range(int(np.ceil(len(values)/per_line))):
-        lines.append(', '.join(
-            map(str, values[line*per_line:min(len(values), (line+1)*per_line)])))
-    return ' '*spaces + (',\n' + ' '*spaces).join(lines)
-
-for l in sorted(wigner.keys()):
-    print(WIGNER_COEFF.format(l=l, values=format_values(wigner[l])))
+float reduceWigner3j(const std::complex<float>* source, const std::vector<Wigner3jTerm>& terms);
 
-*/
+}; }; // end namespace freud::order
 
-}; };  // end namespace freud::order
 #endif // WIGNER3J_H
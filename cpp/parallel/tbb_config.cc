@@ -3,7 +3,19 @@
 
 #include "tbb_config.h"
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
+#include <tbb/task_scheduler_observer.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 /*! \file tbb_config.cc
     \brief Helper functions to configure tbb
@@ -32,4 +44,307 @@ void setNumThreads(unsigned int N)
         = std::make_unique<tbb::global_control>(tbb::global_control::parameter::max_allowed_parallelism, N);
 }
 
+namespace {
+
+#ifdef __linux__
+//! Parse a sysfs CPU list such as "0-3,8-11" into CPU ids.
+std::vector<int> parseCpuList(const std::string& cpu_list)
+{
+    std::vector<int> cpus;
+    std::stringstream ranges(cpu_list);
+    std::string range;
+    while (std::getline(ranges, range, ','))
+    {
+        if (range.empty() || range == "\n")
+        {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+//! Order the CPUs this process may run on so that consecutive CPUs alternate between NUMA nodes.
+/*! Pinning the n-th thread to the n-th CPU then spreads any number of threads
+    evenly across the nodes, so that memory first touched by the threads is
+    spread across the nodes as well. If the NUMA topology cannot be read, the
+    CPUs are ordered by id.
+*/
+std::vector<int> interleavedCpus(const cpu_set_t& allowed)
+{
+    std::vector<std::vector<int>> node_cpus;
+    for (unsigned int node = 0;; ++node)
+    {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string cpu_list;
+        if (!file || !std::getline(file, cpu_list))
+        {
+            break;
+        }
+        std::vector<int> cpus;
+        for (const int cpu : parseCpuList(cpu_list))
+        {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty())
+        {
+            node_cpus.push_back(cpus);
+        }
+    }
+    if (node_cpus.empty())
+    {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        node_cpus.push_back(cpus);
+    }
+
+    std::vector<int> cpus;
+    for (size_t i = 0;; ++i)
+    {
+        const size_t num_cpus = cpus.size();
+        for (const auto& node : node_cpus)
+        {
+            if (i < node.size())
+            {
+                cpus.push_back(node[i]);
+            }
+        }
+        if (cpus.size() == num_cpus)
+        {
+            return cpus;
+        }
+    }
+}
+#endif
+
+//! Observer pinning each thread that enters the TBB scheduler to its own CPU.
+/*! Threads are assigned CPUs in the order of interleavedCpus as they first
+    enter the scheduler. When pinning is disabled, threads entering the
+    scheduler get back the affinity mask the process started with.
+*/
+class ThreadPinningObserver : public tbb::task_scheduler_observer
+{
+public:
+    ThreadPinningObserver()
+    {
+#ifdef __linux__
+        CPU_ZERO(&m_process_mask);
+        sched_getaffinity(0, sizeof(cpu_set_t), &m_process_mask);
+        m_cpus = interleavedCpus(m_process_mask);
+#endif
+        observe(true);
+    }
+
+    ~ThreadPinningObserver() override
+    {
+        observe(false);
+    }
+
+    ThreadPinningObserver(const ThreadPinningObserver&) = delete;
+    ThreadPinningObserver& operator=(const ThreadPinningObserver&) = delete;
+
+    void setPinning(bool pin)
+    {
+        m_pin = pin;
+    }
+
+    bool getPinning() const
+    {
+        return m_pin;
+    }
+
+    void on_scheduler_entry(bool /*is_worker*/) override
+    {
+#ifdef __linux__
+        if (!m_pin)
+        {
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_process_mask);
+            return;
+        }
+        if (m_cpus.empty())
+        {
+            return;
+        }
+        thread_local int slot = -1;
+        if (slot < 0)
+        {
+            slot = m_next_slot.fetch_add(1);
+        }
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(m_cpus[static_cast<size_t>(slot) % m_cpus.size()], &mask);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mask);
+#endif
+    }
+
+private:
+    std::atomic<bool> m_pin {false};  //!< Whether threads entering the scheduler are pinned.
+    std::atomic<int> m_next_slot {0}; //!< Index of the CPU assigned to the next new thread.
+#ifdef __linux__
+    cpu_set_t m_process_mask {};      //!< CPUs the process was allowed to run on.
+    std::vector<int> m_cpus;          //!< Allowed CPUs, interleaved between NUMA nodes.
+#endif
+};
+
+std::unique_ptr<ThreadPinningObserver> thread_pinning_observer;
+
+} // namespace
+
+/*! \param pin Whether to pin threads.
+
+    Each thread is pinned to a single CPU when it next enters the TBB
+   scheduler, so data a thread first touches stays in the memory of its NUMA
+   node. Consecutive threads are assigned CPUs of alternating NUMA nodes. Pinning
+   is only supported on Linux and is ignored elsewhere.
+
+    \note setThreadPinning should only be called from the main thread.
+*/
+void setThreadPinning(bool pin)
+{
+    if (!thread_pinning_observer)
+    {
+        if (!pin)
+        {
+            return;
+        }
+        thread_pinning_observer = std::make_unique<ThreadPinningObserver>();
+    }
+    thread_pinning_observer->setPinning(pin);
+}
+
+bool getThreadPinning()
+{
+    return thread_pinning_observer && thread_pinning_observer->getPinning();
+}
+
+namespace {
+
+//! Whether parallel loops are split into deterministic chunks.
+std::atomic<bool> deterministic_reductions {false};
+
+//! Chunk of a deterministic loop run by each thread, or -1.
+thread_local int current_chunk = -1;
+
+} // namespace
+
+/*! \param deterministic Whether reductions should not depend on the number of threads.
+
+    Parallel loops are then split into a fixed set of chunks, and nested
+   parallel loops run serially within the chunk of their thread. Thread local
+   storage holds one copy per chunk, so reductions use up to
+   DETERMINISTIC_NUM_CHUNKS copies regardless of the number of threads.
+
+    \note setDeterministicReductions should only be called from the main thread.
+*/
+void setDeterministicReductions(bool deterministic)
+{
+    deterministic_reductions = deterministic;
+}
+
+bool getDeterministicReductions()
+{
+    return deterministic_reductions.load(std::memory_order_relaxed);
+}
+
+namespace {
+
+//! Memory that a single compute may use, in bytes, or 0 for no budget.
+std::atomic<size_t> memory_budget {0};
+
+} // namespace
+
+/*! \param bytes Memory budget in bytes, or 0 for no budget.
+
+    Computes with a lower memory mode switch to it when their estimated peak
+    memory exceeds the budget, and computes that replicate buffers per thread
+    use fewer threads. The budget is not a hard limit: computes whose lowest
+    memory mode exceeds it still run.
+*/
+void setMemoryBudget(size_t bytes)
+{
+    memory_budget = bytes;
+}
+
+size_t getMemoryBudget()
+{
+    return memory_budget.load(std::memory_order_relaxed);
+}
+
+bool fitsMemoryBudget(size_t bytes)
+{
+    const size_t budget = getMemoryBudget();
+    return budget == 0 || bytes <= budget;
+}
+
+unsigned int getBudgetedNumThreads(size_t shared_bytes, size_t thread_bytes)
+{
+    const auto max_threads = static_cast<unsigned int>(std::max(maxConcurrency(), 1));
+    const size_t budget = getMemoryBudget();
+    if (budget == 0 || thread_bytes == 0)
+    {
+        return max_threads;
+    }
+    if (shared_bytes + thread_bytes >= budget)
+    {
+        return 1;
+    }
+    return static_cast<unsigned int>(
+        std::min<size_t>(max_threads, (budget - shared_bytes) / thread_bytes));
+}
+
+DeterministicChunk::DeterministicChunk(int chunk) : m_previous(current_chunk)
+{
+    current_chunk = chunk;
+}
+
+DeterministicChunk::~DeterministicChunk()
+{
+    current_chunk = m_previous;
+}
+
+int DeterministicChunk::current()
+{
+    return current_chunk;
+}
+
+namespace {
+
+//! Innermost execution context of each thread.
+thread_local ExecutionContext* current_context = nullptr;
+
+} // namespace
+
+ExecutionContext::ExecutionContext(unsigned int num_threads)
+    : m_num_threads(num_threads),
+      m_arena(num_threads == 0 ? tbb::task_arena::automatic : static_cast<int>(num_threads)),
+      m_previous(current_context)
+{
+    current_context = this;
+}
+
+ExecutionContext::~ExecutionContext()
+{
+    current_context = m_previous;
+}
+
+ExecutionContext* ExecutionContext::current()
+{
+    return current_context;
+}
+
 }; }; // end namespace freud::parallel
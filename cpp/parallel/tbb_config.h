@@ -6,6 +6,8 @@
 
 #define TBB_PREVIEW_GLOBAL_CONTROL 1
 #include <tbb/global_control.h>
+#include <cstddef>
+#include <tbb/task_arena.h>
 
 /*! \file tbb_config.h
     \brief Helper functions to configure tbb
@@ -16,6 +18,165 @@ namespace freud { namespace parallel {
 //! Set the number of TBB threads
 void setNumThreads(unsigned int N);
 
+//! Set whether TBB threads are pinned to CPUs spread evenly across NUMA nodes
+void setThreadPinning(bool pin);
+
+//! Get whether TBB threads are pinned to CPUs
+bool getThreadPinning();
+
+//! Set whether parallel reductions give results independent of the number of threads
+void setDeterministicReductions(bool deterministic);
+
+//! Get whether parallel reductions give results independent of the number of threads
+bool getDeterministicReductions();
+
+//! Set the memory that a single compute may use, in bytes, or 0 for no budget.
+void setMemoryBudget(size_t bytes);
+
+//! Get the memory that a single compute may use, in bytes, or 0 if there is no budget.
+size_t getMemoryBudget();
+
+//! Get whether a computation using the given number of bytes fits in the memory budget.
+bool fitsMemoryBudget(size_t bytes);
+
+//! Get the number of threads whose thread local copies fit in the memory budget.
+/*! Computes that replicate buffers per thread run their parallel loops with
+    this many threads (see executeWithNumThreads), so that their peak memory
+    stays within the budget where possible.
+
+    \param shared_bytes Memory used regardless of the number of threads.
+    \param thread_bytes Memory of the thread local copies of each thread.
+    
+eturns The largest number of threads, between 1 and maxConcurrency(),
+             for which shared_bytes + num_threads * thread_bytes fits in the budget.
+*/
+unsigned int getBudgetedNumThreads(size_t shared_bytes, size_t thread_bytes);
+
+//! Maximum number of chunks that parallel loops are split into when reductions are deterministic.
+constexpr size_t DETERMINISTIC_NUM_CHUNKS = 64;
+
+//! Scoped marker of the chunk of a deterministic parallel loop run by the current thread.
+/*! When reductions are deterministic, util::forLoopWrapper splits loops
+    into at most DETERMINISTIC_NUM_CHUNKS chunks whose bounds only depend on
+    the length of the loop, and runs each chunk within a DeterministicChunk.
+    Thread local storage (util::ThreadStorage and the thread local copies of
+    util::Histogram) then accumulates into one copy per chunk rather than one
+    per thread, and the copies are combined in a fixed order, so sums of
+    floating point numbers do not depend on the number of threads or on how
+    TBB scheduled the chunks.
+*/
+class DeterministicChunk
+{
+public:
+    //! Constructor
+    /*! \param chunk Index of the chunk run by the current thread.
+     */
+    explicit DeterministicChunk(int chunk);
+
+    //! Destructor, restoring the previous chunk of the thread.
+    ~DeterministicChunk();
+
+    DeterministicChunk(const DeterministicChunk&) = delete;
+    DeterministicChunk& operator=(const DeterministicChunk&) = delete;
+
+    //! Get the chunk run by the current thread, or -1 outside of deterministic loops.
+    static int current();
+
+private:
+    int m_previous; //!< Chunk of the thread when this marker was created.
+};
+
+//! Scoped limit on the number of threads used by computations started on the current thread.
+/*! While an ExecutionContext exists, the parallel loops that freud starts on
+    the thread that created it run in a task arena of its own with the given
+    number of threads. Computations started from different threads (e.g. the
+    workers of a Python thread pool) can thus each be given a budget of cores,
+    rather than all sharing the global pool of threads set by setNumThreads.
+
+    Contexts nest, and destroying a context restores the previous context of
+    its thread, so contexts must be destroyed on the thread that created them
+    in the reverse order of their creation. The number of threads of a context
+    is still capped by setNumThreads.
+*/
+class ExecutionContext
+{
+public:
+    //! Constructor
+    /*! \param num_threads Number of threads of the context, or 0 to use all threads available.
+     */
+    explicit ExecutionContext(unsigned int num_threads);
+
+    //! Destructor, restoring the previous context of the thread.
+    ~ExecutionContext();
+
+    ExecutionContext(const ExecutionContext&) = delete;
+    ExecutionContext& operator=(const ExecutionContext&) = delete;
+
+    //! Get the number of threads of the context.
+    unsigned int getNumThreads() const
+    {
+        return m_num_threads;
+    }
+
+    //! Get the innermost context of the current thread, or NULL if there is none.
+    static ExecutionContext* current();
+
+    //! Get the task arena of the context.
+    tbb::task_arena& getArena()
+    {
+        return m_arena;
+    }
+
+private:
+    unsigned int m_num_threads;    //!< Number of threads of the context.
+    tbb::task_arena m_arena;       //!< Arena the computations of the context run in.
+    ExecutionContext* m_previous; //!< Context of the thread when this context was created.
+};
+
+//! Run a function in the execution context of the current thread.
+/*! Parallel algorithms started by the function run in the task arena of the
+    current context of the thread, or in the arena the thread is already in if
+    it has no context (e.g. within a TBB worker thread). All top-level parallel
+    algorithms of freud must be started through this function, which
+    util::forLoopWrapper does.
+
+    \param f Function to run.
+*/
+template<typename Func> void execute(const Func& f)
+{
+    ExecutionContext* context = ExecutionContext::current();
+    if (context == nullptr)
+    {
+        f();
+    }
+    else
+    {
+        context->getArena().execute(f);
+    }
+}
+
+//! Get the maximum number of threads a parallel algorithm started on this thread may use.
+inline int maxConcurrency()
+{
+    ExecutionContext* context = ExecutionContext::current();
+    return context == nullptr ? tbb::this_task_arena::max_concurrency() : context->getArena().max_concurrency();
+}
+
+//! Run a function whose parallel loops use at most the given number of threads.
+/*! \param num_threads Maximum number of threads.
+    \param f Function to run.
+*/
+template<typename Func> void executeWithNumThreads(unsigned int num_threads, const Func& f)
+{
+    if (num_threads >= static_cast<unsigned int>(maxConcurrency()))
+    {
+        f();
+        return;
+    }
+    ExecutionContext context(num_threads);
+    f();
+}
+
 }; }; // end namespace freud::parallel
 
 #endif // TBB_CONFIG_H
@@ -39,6 +39,14 @@ public:
         return reduceAndReturn(m_pcf_array);
     }
 
+    //! Get the standard error of the PCF estimated from the batches of sampled query points.
+    /*! The errors are zero if the query points were not sampled.
+     */
+    const util::ManagedArray<float>& getPCFStandardError()
+    {
+        return reduceAndReturn(m_pcf_error_array);
+    }
+
 protected:
     //! Reduce the thread local histogram into the total pair correlation function.
     /*! The pair correlation function is computed by reducing the bin counts in
@@ -64,6 +72,7 @@ protected:
     template<typename JacobFactor> void reduce(JacobFactor jf)
     {
         m_pcf_array.prepare(m_histogram.shape());
+        m_pcf_error_array.prepare(m_histogram.shape());
         m_histogram.prepare(m_histogram.shape());
 
         float inv_num_dens = m_box.getVolume() / static_cast<float>(m_n_query_points);
@@ -74,9 +83,15 @@ protected:
         m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jf](size_t i) {
             m_pcf_array[i] = static_cast<float>(m_histogram[i]) * prefactor * jf(i);
         });
+        const auto bin_count_errors = getBinCountStandardErrors();
+        for (size_t i = 0; i < bin_count_errors.size(); ++i)
+        {
+            m_pcf_error_array[i] = bin_count_errors[i] * prefactor * jf(i);
+        }
     }
 
-    util::ManagedArray<float> m_pcf_array; //!< Array of computed pair correlation function.
+    util::ManagedArray<float> m_pcf_array;       //!< Array of computed pair correlation function.
+    util::ManagedArray<float> m_pcf_error_array; //!< Standard error of the pair correlation function.
 };
 
 }; }; // end namespace freud::pmft
@@ -12,6 +12,26 @@
 
 namespace freud { namespace pmft {
 
+namespace {
+
+//! Bin the bond length and the angles between the bond and the orientations of its points.
+inline void binBond(util::Histogram<unsigned int>& histogram, const locality::NeighborBond& neighbor_bond,
+                    const float* orientations, const float* query_orientations)
+{
+    const vec3<float>& delta(neighbor_bond.getVector());
+    // calculate angles
+    const float d_theta1 = std::atan2(delta.y, delta.x);
+    const float d_theta2 = std::atan2(-delta.y, -delta.x);
+    // make sure that t1, t2 are bounded between 0 and 2PI
+    const float t1
+        = util::modulusPositive(orientations[neighbor_bond.getPointIdx()] - d_theta1, constants::TWO_PI);
+    const float t2 = util::modulusPositive(query_orientations[neighbor_bond.getQueryPointIdx()] - d_theta2,
+                                           constants::TWO_PI);
+    histogram(neighbor_bond.getDistance(), t1, t2);
+}
+
+} // namespace
+
 PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2) : PMFT()
 {
     if (n_r < 1)
@@ -80,20 +100,39 @@ void PMFTR12::accumulate(const locality::NeighborQuery* neighbor_query, const fl
                          freud::locality::QueryArgs qargs)
 {
     neighbor_query->getBox().enforce2D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          const vec3<float>& delta(neighbor_bond.getVector());
-                          // calculate angles
-                          const float d_theta1 = std::atan2(delta.y, delta.x);
-                          const float d_theta2 = std::atan2(-delta.y, -delta.x);
-                          // make sure that t1, t2 are bounded between 0 and 2PI
-                          const float t1 = util::modulusPositive(
-                              orientations[neighbor_bond.getPointIdx()] - d_theta1, constants::TWO_PI);
-                          const float t2 = util::modulusPositive(
-                              query_orientations[neighbor_bond.getQueryPointIdx()] - d_theta2,
-                              constants::TWO_PI);
-                          m_local_histograms(neighbor_bond.getDistance(), t1, t2);
-                      });
+    qargs = mirrorableQueryArgs(neighbor_query, query_points, n_query_points, qargs,
+                                orientations == query_orientations);
+    accumulateHistogram(neighbor_query, query_points, n_query_points, nlist, qargs,
+                        [&](BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+                            binBond(histogram, neighbor_bond, orientations, query_orientations);
+                        });
+}
+
+void PMFTR12::accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                               const std::vector<const float*>& orientations,
+                               const std::vector<const vec3<float>*>& query_points,
+                               const std::vector<const float*>& query_orientations,
+                               const std::vector<unsigned int>& n_query_points,
+                               freud::locality::QueryArgs qargs)
+{
+    if (orientations.size() != neighbor_queries.size()
+        || query_orientations.size() != neighbor_queries.size())
+    {
+        throw std::invalid_argument("PMFTR12 requires orientations for every frame.");
+    }
+    for (const auto* neighbor_query : neighbor_queries)
+    {
+        neighbor_query->getBox().enforce2D();
+    }
+    if (orientations != query_orientations)
+    {
+        qargs.half_list = false;
+    }
+    accumulateHistogramFrames(
+        neighbor_queries, query_points, n_query_points, qargs,
+        [&](size_t frame, BondHistogram& histogram, const freud::locality::NeighborBond& neighbor_bond) {
+            binBond(histogram, neighbor_bond, orientations[frame], query_orientations[frame]);
+        });
 }
 
 }; }; // end namespace freud::pmft
@@ -11,6 +11,46 @@
 
 namespace freud { namespace pmft {
 
+namespace {
+
+//! Bin bond vectors rotated into the frame of their query points.
+/*! One instance is made per chunk of bonds. The bonds of a query point are
+ *  consecutive, so its rotation matrix is computed once for all of them.
+ */
+class BondBinner
+{
+public:
+    BondBinner(util::Histogram<unsigned int>& histogram, const util::RegularBins<2>& bins,
+               const float* query_orientations)
+        : m_histogram(histogram), m_bins(bins), m_query_orientations(query_orientations)
+    {}
+
+    void operator()(const locality::NeighborBond& neighbor_bond) const
+    {
+        const unsigned int query_point_idx = neighbor_bond.getQueryPointIdx();
+        if (query_point_idx != m_query_point_idx)
+        {
+            m_rotation = rotmat2<float>::fromAngle(-m_query_orientations[query_point_idx]);
+            m_query_point_idx = query_point_idx;
+        }
+
+        // rotate interparticle vector
+        const vec3<float>& delta(neighbor_bond.getVector());
+        const vec2<float> rotVec = m_rotation * vec2<float>(delta.x, delta.y);
+
+        m_histogram.increment(m_bins.bin({rotVec.x, rotVec.y}));
+    }
+
+private:
+    util::Histogram<unsigned int>& m_histogram;
+    const util::RegularBins<2>& m_bins;
+    const float* m_query_orientations;
+    mutable unsigned int m_query_point_idx {0xffffffff}; //!< Query point of the cached rotation.
+    mutable rotmat2<float> m_rotation;                    //!< Rotation into the frame of the query point.
+};
+
+} // namespace
+
 PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y) : PMFT()
 {
     if (n_x < 1)
@@ -60,18 +100,45 @@ void PMFTXY::accumulate(const locality::NeighborQuery* neighbor_query, const flo
                         const locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
 {
     neighbor_query->getBox().enforce2D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          const vec3<float>& delta(neighbor_bond.getVector());
-
-                          // rotate interparticle vector
-                          const vec2<float> myVec(delta.x, delta.y);
-                          const rotmat2<float> myMat(rotmat2<float>::fromAngle(
-                              -query_orientations[neighbor_bond.getQueryPointIdx()]));
-                          const vec2<float> rotVec = myMat * myVec;
-
-                          m_local_histograms(rotVec.x, rotVec.y);
-                      });
+    const util::RegularBins<2> bins(m_histogram.getAxes());
+    accumulateHistogramChunks(neighbor_query, query_points, n_query_points, nlist, qargs,
+                              [&](BondHistogram& histogram) {
+                                  return BondBinner(histogram, bins, query_orientations);
+                              });
+}
+
+void PMFTXY::accumulateSampled(const locality::NeighborQuery* neighbor_query, const float* query_orientations,
+                               const vec3<float>* query_points, unsigned int n_query_points,
+                               const locality::NeighborList* nlist, freud::locality::QueryArgs qargs,
+                               const locality::QuerySampling& sampling)
+{
+    neighbor_query->getBox().enforce2D();
+    const util::RegularBins<2> bins(m_histogram.getAxes());
+    accumulateSampledHistogramChunks(neighbor_query, query_points, n_query_points, nlist, qargs, sampling,
+                                     [&](unsigned int /*batch*/, BondHistogram& histogram) {
+                                         return BondBinner(histogram, bins, query_orientations);
+                                     });
+}
+
+void PMFTXY::accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                              const std::vector<const float*>& query_orientations,
+                              const std::vector<const vec3<float>*>& query_points,
+                              const std::vector<unsigned int>& n_query_points,
+                              freud::locality::QueryArgs qargs)
+{
+    if (query_orientations.size() != neighbor_queries.size())
+    {
+        throw std::invalid_argument("PMFTXY requires query orientations for every frame.");
+    }
+    for (const auto* neighbor_query : neighbor_queries)
+    {
+        neighbor_query->getBox().enforce2D();
+    }
+    const util::RegularBins<2> bins(m_histogram.getAxes());
+    accumulateHistogramFramesChunks(neighbor_queries, query_points, n_query_points, qargs,
+                                    [&](size_t frame, BondHistogram& histogram) {
+                                        return BondBinner(histogram, bins, query_orientations[frame]);
+                                    });
 }
 
 }; }; // end namespace freud::pmft
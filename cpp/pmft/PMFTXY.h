@@ -25,6 +25,23 @@ public:
                     const vec3<float>* query_points, unsigned int n_query_points,
                     const locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    /*! Compute the PCF from a random sample of the query points, normalized
+     *  by the number of sampled query points. The standard error of each bin
+     *  is estimated from the batches of sampled query points.
+     */
+    void accumulateSampled(const locality::NeighborQuery* neighbor_query, const float* query_orientations,
+                           const vec3<float>* query_points, unsigned int n_query_points,
+                           const locality::NeighborList* nlist, freud::locality::QueryArgs qargs,
+                           const locality::QuerySampling& sampling);
+
+    /*! Compute the PCF for several frames, as if accumulate were called for
+     *  each frame. The frames are processed concurrently.
+     */
+    void accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                          const std::vector<const float*>& query_orientations,
+                          const std::vector<const vec3<float>*>& query_points,
+                          const std::vector<unsigned int>& n_query_points, freud::locality::QueryArgs qargs);
+
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
@@ -12,6 +12,52 @@
 
 namespace freud { namespace pmft {
 
+namespace {
+
+//! Bin bond vectors rotated into the frame of their query points and the angles of the bonds to their points.
+/*! One instance is made per chunk of bonds. The bonds of a query point are
+ *  consecutive, so its rotation matrix is computed once for all of them.
+ */
+class BondBinner
+{
+public:
+    BondBinner(util::Histogram<unsigned int>& histogram, const util::RegularBins<3>& bins,
+               const float* orientations, const float* query_orientations)
+        : m_histogram(histogram), m_bins(bins), m_orientations(orientations),
+          m_query_orientations(query_orientations)
+    {}
+
+    void operator()(const locality::NeighborBond& neighbor_bond) const
+    {
+        const unsigned int query_point_idx = neighbor_bond.getQueryPointIdx();
+        if (query_point_idx != m_query_point_idx)
+        {
+            m_rotation = rotmat2<float>::fromAngle(-m_query_orientations[query_point_idx]);
+            m_query_point_idx = query_point_idx;
+        }
+
+        // rotate interparticle vector
+        const vec3<float>& delta(neighbor_bond.getVector());
+        const vec2<float> rotVec = m_rotation * vec2<float>(delta.x, delta.y);
+        // calculate angle
+        const float d_theta = std::atan2(-delta.y, -delta.x);
+        // make sure that t is bounded between 0 and 2PI
+        const float t = util::modulusPositive(m_orientations[neighbor_bond.getPointIdx()] - d_theta,
+                                              constants::TWO_PI);
+        m_histogram.increment(m_bins.bin({rotVec.x, rotVec.y, t}));
+    }
+
+private:
+    util::Histogram<unsigned int>& m_histogram;
+    const util::RegularBins<3>& m_bins;
+    const float* m_orientations;
+    const float* m_query_orientations;
+    mutable unsigned int m_query_point_idx {0xffffffff}; //!< Query point of the cached rotation.
+    mutable rotmat2<float> m_rotation;                    //!< Rotation into the frame of the query point.
+};
+
+} // namespace
+
 PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, unsigned int n_t) : PMFT()
 {
     if (n_x < 1)
@@ -53,7 +99,10 @@ PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, u
                                   std::make_shared<util::RegularAxis>(n_y, -y_max, y_max),
                                   std::make_shared<util::RegularAxis>(n_t, 0, constants::TWO_PI)};
     m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+
+    // Bonds typically populate only a small fraction of the bins of a 3D
+    // histogram, so the thread local copies only allocate the pages they use.
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, true);
 }
 
 void PMFTXYT::reduce()
@@ -68,21 +117,39 @@ void PMFTXYT::accumulate(const locality::NeighborQuery* neighbor_query, const fl
                          freud::locality::QueryArgs qargs)
 {
     neighbor_query->getBox().enforce2D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          const vec3<float>& delta(neighbor_bond.getVector());
-
-                          // rotate interparticle vector
-                          const vec2<float> myVec(delta.x, delta.y);
-                          const rotmat2<float> myMat(rotmat2<float>::fromAngle(
-                              -query_orientations[neighbor_bond.getQueryPointIdx()]));
-                          const vec2<float> rotVec = myMat * myVec;
-                          // calculate angle
-                          const float d_theta = std::atan2(-delta.y, -delta.x);
-                          // make sure that t is bounded between 0 and 2PI
-                          const float t = util::modulusPositive(
-                              orientations[neighbor_bond.getPointIdx()] - d_theta, constants::TWO_PI);
-                          m_local_histograms(rotVec.x, rotVec.y, t);
-                      });
+    const util::RegularBins<3> bins(m_histogram.getAxes());
+    qargs = mirrorableQueryArgs(neighbor_query, query_points, n_query_points, qargs,
+                                orientations == query_orientations);
+    accumulateHistogramChunks(neighbor_query, query_points, n_query_points, nlist, qargs,
+                              [&](BondHistogram& histogram) {
+                                  return BondBinner(histogram, bins, orientations, query_orientations);
+                              });
+}
+
+void PMFTXYT::accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                               const std::vector<const float*>& orientations,
+                               const std::vector<const vec3<float>*>& query_points,
+                               const std::vector<const float*>& query_orientations,
+                               const std::vector<unsigned int>& n_query_points,
+                               freud::locality::QueryArgs qargs)
+{
+    if (orientations.size() != neighbor_queries.size()
+        || query_orientations.size() != neighbor_queries.size())
+    {
+        throw std::invalid_argument("PMFTXYT requires orientations for every frame.");
+    }
+    for (const auto* neighbor_query : neighbor_queries)
+    {
+        neighbor_query->getBox().enforce2D();
+    }
+    if (orientations != query_orientations)
+    {
+        qargs.half_list = false;
+    }
+    const util::RegularBins<3> bins(m_histogram.getAxes());
+    accumulateHistogramFramesChunks(
+        neighbor_queries, query_points, n_query_points, qargs, [&](size_t frame, BondHistogram& histogram) {
+            return BondBinner(histogram, bins, orientations[frame], query_orientations[frame]);
+        });
 }
 }; }; // end namespace freud::pmft
@@ -26,6 +26,15 @@ public:
                     unsigned int n_query_points, const locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    /*! Compute the PCF for several frames, as if accumulate were called for
+        each frame. The frames are processed concurrently.
+    */
+    void accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                          const std::vector<const float*>& orientations,
+                          const std::vector<const vec3<float>*>& query_points,
+                          const std::vector<const float*>& query_orientations,
+                          const std::vector<unsigned int>& n_query_points, freud::locality::QueryArgs qargs);
+
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
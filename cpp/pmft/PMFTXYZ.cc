@@ -1,8 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
-#include "PMFTXYZ.h"
+#include <array>
+#include <cmath>
 #include <stdexcept>
+#include <vector>
+
+#include "PMFTXYZ.h"
 
 /*! \file PMFTXYZ.cc
     \brief Routines for computing 3D potential of mean force in XYZ coordinates
@@ -10,6 +14,138 @@
 
 namespace freud { namespace pmft {
 
+namespace {
+
+//! Bin bond vectors rotated into the frame of their query points, once per equivalent orientation.
+/*! One instance is made per chunk of bonds. The bonds of a query point are
+ *  consecutive, so the products of its inverse rotation with each equivalent
+ *  orientation are computed once for all of them. The matrices are stored by
+ *  element, so rotating and binning a bond for all equivalent orientations
+ *  are loops over contiguous arrays that the compiler can vectorize.
+ */
+class BondBinner
+{
+public:
+    BondBinner(util::Histogram<unsigned int>& histogram, const util::RegularBins<3>& bins,
+               const quat<float>* query_orientations, const std::vector<rotmat3<float>>& equiv_rotations)
+        : m_histogram(histogram), m_bins(bins), m_query_orientations(query_orientations),
+          m_equiv_rotations(equiv_rotations), m_matrices(9 * equiv_rotations.size()),
+          m_x(equiv_rotations.size()), m_y(equiv_rotations.size()), m_z(equiv_rotations.size()),
+          m_value_bins(equiv_rotations.size())
+    {}
+
+    void operator()(const locality::NeighborBond& neighbor_bond) const
+    {
+        const size_t num_equiv_orientations = m_equiv_rotations.size();
+        const unsigned int query_point_idx = neighbor_bond.getQueryPointIdx();
+        if (query_point_idx != m_query_point_idx)
+        {
+            const rotmat3<float> query_rotation(conj(m_query_orientations[query_point_idx]));
+            for (size_t k = 0; k < num_equiv_orientations; ++k)
+            {
+                const rotmat3<float> r = m_equiv_rotations[k] * query_rotation;
+                const std::array<float, 9> elements {r.row0.x, r.row0.y, r.row0.z, r.row1.x, r.row1.y,
+                                                     r.row1.z, r.row2.x, r.row2.y, r.row2.z};
+                for (size_t e = 0; e < 9; ++e)
+                {
+                    m_matrices[e * num_equiv_orientations + k] = elements[e];
+                }
+            }
+            m_query_point_idx = query_point_idx;
+        }
+
+        const vec3<float>& delta(neighbor_bond.getVector());
+        const float* m = m_matrices.data();
+        const size_t n = num_equiv_orientations;
+        for (size_t k = 0; k < n; ++k)
+        {
+            m_x[k] = m[k] * delta.x + m[n + k] * delta.y + m[2 * n + k] * delta.z;
+            m_y[k] = m[3 * n + k] * delta.x + m[4 * n + k] * delta.y + m[5 * n + k] * delta.z;
+            m_z[k] = m[6 * n + k] * delta.x + m[7 * n + k] * delta.y + m[8 * n + k] * delta.z;
+        }
+        m_bins.bin({m_x.data(), m_y.data(), m_z.data()}, n, m_value_bins.data());
+        for (size_t k = 0; k < n; ++k)
+        {
+            m_histogram.increment(m_value_bins[k]);
+        }
+    }
+
+private:
+    util::Histogram<unsigned int>& m_histogram;
+    const util::RegularBins<3>& m_bins;
+    const quat<float>* m_query_orientations;
+    const std::vector<rotmat3<float>>& m_equiv_rotations;
+    mutable unsigned int m_query_point_idx {0xffffffff}; //!< Query point of the cached matrices.
+    mutable std::vector<float> m_matrices;               //!< Rotation matrices of the query point by element.
+    mutable std::vector<float> m_x;                      //!< Rotated x coordinates of the bond.
+    mutable std::vector<float> m_y;                      //!< Rotated y coordinates of the bond.
+    mutable std::vector<float> m_z;                      //!< Rotated z coordinates of the bond.
+    mutable std::vector<size_t> m_value_bins;            //!< Bins of the rotated bond.
+};
+
+//! Convert the equivalent orientations to rotation matrices.
+std::vector<rotmat3<float>> makeEquivRotations(const quat<float>* equiv_orientations,
+                                               unsigned int num_equiv_orientations)
+{
+    std::vector<rotmat3<float>> equiv_rotations;
+    equiv_rotations.reserve(num_equiv_orientations);
+    for (unsigned int k = 0; k < num_equiv_orientations; ++k)
+    {
+        equiv_rotations.emplace_back(equiv_orientations[k]);
+    }
+    return equiv_rotations;
+}
+
+//! Find the bin permutations of the equivalent orientations.
+/*! \returns The permutations, or an empty vector if any equivalent orientation
+ *  does not permute the bins of the axes.
+ */
+template<typename BinSymmetry>
+std::vector<BinSymmetry> findBinSymmetries(const quat<float>* equiv_orientations,
+                                           unsigned int num_equiv_orientations, const util::Axes& axes)
+{
+    // Quaternions given in single precision do not produce exact matrix elements.
+    constexpr float tolerance = 1e-5;
+    std::vector<BinSymmetry> symmetries;
+    for (unsigned int k = 0; k < num_equiv_orientations; ++k)
+    {
+        const rotmat3<float> r(equiv_orientations[k]);
+        const std::array<vec3<float>, 3> rows {r.row0, r.row1, r.row2};
+        BinSymmetry symmetry {};
+        std::array<bool, 3> used {false, false, false};
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            const std::array<float, 3> row {rows[i].x, rows[i].y, rows[i].z};
+            unsigned int num_unit = 0;
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                if (std::abs(std::abs(row[j]) - float(1.0)) < tolerance)
+                {
+                    symmetry.source_axis[i] = j;
+                    symmetry.flip[i] = row[j] < 0;
+                    ++num_unit;
+                }
+                else if (std::abs(row[j]) >= tolerance)
+                {
+                    return {};
+                }
+            }
+            const unsigned int j = symmetry.source_axis[i];
+            // The axes are symmetric about zero, so only their sizes and extents must match.
+            if (num_unit != 1 || used[j] || axes[i]->size() != axes[j]->size()
+                || axes[i]->getMax() != axes[j]->getMax())
+            {
+                return {};
+            }
+            used[j] = true;
+        }
+        symmetries.push_back(symmetry);
+    }
+    return symmetries;
+}
+
+} // namespace
+
 PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsigned int n_y, unsigned int n_z,
                  const vec3<float>& shiftvec)
     : PMFT(), m_shiftvec(shiftvec), m_num_equiv_orientations(0xffffffff)
@@ -69,7 +205,11 @@ PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsign
                                   std::make_shared<util::RegularAxis>(n_y, -y_max, y_max),
                                   std::make_shared<util::RegularAxis>(n_z, -z_max, z_max)};
     m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+
+    // Bonds typically populate only a small fraction of the bins of a 3D
+    // histogram, so the thread local copies only allocate the pages they use.
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, true);
+    m_local_unsymmetrized_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, true);
 }
 
 // Almost identical to the parent method, except that the normalization factor
@@ -84,8 +224,35 @@ void PMFTXYZ::reduce()
         = (float) 1.0 / ((float) m_frame_counter * (float) m_n_points * (float) m_num_equiv_orientations);
     float prefactor = inv_num_dens * norm_factor;
 
+    // Bonds binned once are added to the bin of every equivalent orientation
+    // by gathering the counts of the bins that each permutation maps onto a bin.
+    util::ManagedArray<unsigned int> unsymmetrized_counts;
+    if (!m_bin_symmetries.empty())
+    {
+        unsymmetrized_counts.prepare(m_histogram.shape());
+        m_local_unsymmetrized_histograms.reduceInto(unsymmetrized_counts);
+    }
+    const std::vector<size_t> sizes = m_histogram.getAxisSizes();
+
     float jacobian_factor = (float) 1.0 / m_jacobian;
-    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jacobian_factor](size_t i) {
+    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+        if (!m_bin_symmetries.empty())
+        {
+            const std::array<size_t, 3> bin {i / (sizes[1] * sizes[2]), (i / sizes[2]) % sizes[1],
+                                             i % sizes[2]};
+            for (const auto& symmetry : m_bin_symmetries)
+            {
+                std::array<size_t, 3> source_bin {};
+                for (unsigned int ax = 0; ax < 3; ++ax)
+                {
+                    source_bin[symmetry.source_axis[ax]]
+                        = symmetry.flip[ax] ? sizes[ax] - 1 - bin[ax] : bin[ax];
+                }
+                m_histogram[i]
+                    += unsymmetrized_counts[(source_bin[0] * sizes[1] + source_bin[1]) * sizes[2]
+                                            + source_bin[2]];
+            }
+        }
         m_pcf_array[i] = static_cast<float>(m_histogram[i]) * prefactor * jacobian_factor;
     });
 }
@@ -94,12 +261,131 @@ void PMFTXYZ::reset()
 {
     BondHistogramCompute::reset();
     m_num_equiv_orientations = 0xffffffff;
+    m_bin_symmetries.clear();
+    m_local_unsymmetrized_histograms.reset();
+}
+
+size_t PMFTXYZ::estimateMemory() const
+{
+    const size_t shared_memory = getSharedMemory();
+    const size_t thread_memory = getThreadMemory();
+    return shared_memory + parallel::getBudgetedNumThreads(shared_memory, thread_memory) * thread_memory;
+}
+
+size_t PMFTXYZ::getSharedMemory() const
+{
+    // The bin counts, the PCF, the running totals of the symmetrized and
+    // unsymmetrized copies and the unsymmetrized counts gathered on reduction.
+    return m_histogram.getBinCounts().size() * (4 * sizeof(unsigned int) + sizeof(float));
+}
+
+size_t PMFTXYZ::getThreadMemory() const
+{
+    return m_histogram.getBinCounts().size() * sizeof(unsigned int);
+}
+
+template<typename Func> void PMFTXYZ::accumulateWithinBudget(const Func& accumulate_func)
+{
+    const unsigned int num_threads = parallel::getBudgetedNumThreads(getSharedMemory(), getThreadMemory());
+    parallel::executeWithNumThreads(num_threads, accumulate_func);
+    if (num_threads < static_cast<unsigned int>(parallel::maxConcurrency()))
+    {
+        // Merging the copies releases their pages, so the threads of later
+        // calls do not add copies beyond the budget.
+        reduce();
+    }
 }
 
 void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, const quat<float>* query_orientations,
                          const vec3<float>* query_points, unsigned int n_query_points,
                          const quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
                          const locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    checkNumEquivOrientations(num_equiv_orientations);
+    neighbor_query->getBox().enforce3D();
+    const util::RegularBins<3> bins(m_histogram.getAxes());
+    if (useBinSymmetries(equiv_orientations, num_equiv_orientations))
+    {
+        const std::vector<rotmat3<float>> identity(1);
+        accumulateWithinBudget([&]() {
+            accumulateHistogramChunks(
+                neighbor_query, query_points, n_query_points, nlist, qargs,
+                [&](BondHistogram& histogram) {
+                    return BondBinner(histogram, bins, query_orientations, identity);
+                },
+                &m_local_unsymmetrized_histograms);
+        });
+        return;
+    }
+    const std::vector<rotmat3<float>> equiv_rotations
+        = makeEquivRotations(equiv_orientations, num_equiv_orientations);
+    accumulateWithinBudget([&]() {
+        accumulateHistogramChunks(neighbor_query, query_points, n_query_points, nlist, qargs,
+                                  [&](BondHistogram& histogram) {
+                                      return BondBinner(histogram, bins, query_orientations,
+                                                        equiv_rotations);
+                                  });
+    });
+}
+
+void PMFTXYZ::accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                               const std::vector<const quat<float>*>& query_orientations,
+                               const std::vector<const vec3<float>*>& query_points,
+                               const std::vector<unsigned int>& n_query_points,
+                               const quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
+                               freud::locality::QueryArgs qargs)
+{
+    if (query_orientations.size() != neighbor_queries.size())
+    {
+        throw std::invalid_argument("PMFTXYZ requires query orientations for every frame.");
+    }
+    checkNumEquivOrientations(num_equiv_orientations);
+    for (const auto* neighbor_query : neighbor_queries)
+    {
+        neighbor_query->getBox().enforce3D();
+    }
+    const util::RegularBins<3> bins(m_histogram.getAxes());
+    if (useBinSymmetries(equiv_orientations, num_equiv_orientations))
+    {
+        const std::vector<rotmat3<float>> identity(1);
+        accumulateWithinBudget([&]() {
+            accumulateHistogramFramesChunks(
+                neighbor_queries, query_points, n_query_points, qargs,
+                [&](size_t frame, BondHistogram& histogram) {
+                    return BondBinner(histogram, bins, query_orientations[frame], identity);
+                },
+                &m_local_unsymmetrized_histograms);
+        });
+        return;
+    }
+    const std::vector<rotmat3<float>> equiv_rotations
+        = makeEquivRotations(equiv_orientations, num_equiv_orientations);
+    accumulateWithinBudget([&]() {
+        accumulateHistogramFramesChunks(neighbor_queries, query_points, n_query_points, qargs,
+                                        [&](size_t frame, BondHistogram& histogram) {
+                                            return BondBinner(histogram, bins, query_orientations[frame],
+                                                              equiv_rotations);
+                                        });
+    });
+}
+
+bool PMFTXYZ::useBinSymmetries(const quat<float>* equiv_orientations, unsigned int num_equiv_orientations)
+{
+    const std::vector<BinSymmetry> symmetries
+        = findBinSymmetries<BinSymmetry>(equiv_orientations, num_equiv_orientations, m_histogram.getAxes());
+    if (symmetries.empty())
+    {
+        return false;
+    }
+    if (m_bin_symmetries.empty())
+    {
+        m_bin_symmetries = symmetries;
+        return true;
+    }
+    return m_bin_symmetries == symmetries;
+}
+
+void PMFTXYZ::checkNumEquivOrientations(unsigned int num_equiv_orientations)
 {
     // Set the number of equivalent orientations the first time we compute
     // (after a reset), then error on subsequent calls if it changes.
@@ -112,26 +398,6 @@ void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, const qu
         throw std::runtime_error(
             "The number of equivalent orientations must be constant while accumulating data into PMFTXYZ.");
     }
-    neighbor_query->getBox().enforce3D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          // create the reference point quaternion
-                          const quat<float> query_orientation(
-                              query_orientations[neighbor_bond.getQueryPointIdx()]);
-                          // make sure that the particles are wrapped into the box
-                          const vec3<float>& delta(neighbor_bond.getVector());
-
-                          for (unsigned int k = 0; k < num_equiv_orientations; k++)
-                          {
-                              // create point vector
-                              vec3<float> v(delta);
-                              // rotate the vector
-                              v = rotate(conj(query_orientation), v);
-                              v = rotate(equiv_orientations[k], v);
-
-                              m_local_histograms(v.x, v.y, v.z);
-                          }
-                      });
 }
 
 }; }; // end namespace freud::pmft
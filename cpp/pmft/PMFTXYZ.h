@@ -4,6 +4,9 @@
 #ifndef PMFTXYZ_H
 #define PMFTXYZ_H
 
+#include <array>
+#include <vector>
+
 #include "PMFT.h"
 
 /*! \file PMFTXYZ.h
@@ -27,20 +30,79 @@ public:
                     const quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
                     const locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    /*! Compute the PCF for several frames, as if accumulate were called for
+        each frame. The frames are processed concurrently.
+    */
+    void accumulateFrames(const std::vector<const locality::NeighborQuery*>& neighbor_queries,
+                          const std::vector<const quat<float>*>& query_orientations,
+                          const std::vector<const vec3<float>*>& query_points,
+                          const std::vector<unsigned int>& n_query_points,
+                          const quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
+                          freud::locality::QueryArgs qargs);
+
     //! Reset the PMFT
     /*! Override the parent method to also reset the number of equivalent orientations.
      */
     void reset() override;
 
+    //! Estimate the peak memory of accumulate in bytes.
+    /*! Each thread accumulates into its own paged copy of the histogram,
+     *  which holds every bin in the worst case. If the copies would not fit
+     *  in the memory budget (see parallel::setMemoryBudget), accumulate uses
+     *  fewer threads and merges the copies after each call.
+     */
+    size_t estimateMemory() const;
+
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     void reduce() override;
 
+    //! Get the memory of the histograms that does not depend on the number of threads.
+    size_t getSharedMemory() const;
+
+    //! Get the memory of the copy of the histogram of each thread in the worst case.
+    size_t getThreadMemory() const;
+
+    //! Run an accumulation with as many threads as fit in the memory budget.
+    template<typename Func> void accumulateWithinBudget(const Func& accumulate_func);
+
+    //! Check that the number of equivalent orientations is the same as in previous calls since the last
+    //! reset.
+    void checkNumEquivOrientations(unsigned int num_equiv_orientations);
+
+    //! A permutation of the bins induced by an equivalent orientation.
+    /*! An equivalent orientation whose rotation matrix permutes and negates
+        the coordinate axes maps every bin onto exactly one other bin. Axis i
+        of the rotated vector is taken from axis source_axis[i] of the vector,
+        negated if flip[i] is set.
+    */
+    struct BinSymmetry
+    {
+        std::array<unsigned int, 3> source_axis; //!< Axis each rotated coordinate is taken from.
+        std::array<bool, 3> flip;                //!< Whether each rotated coordinate is negated.
+
+        bool operator==(const BinSymmetry& other) const
+        {
+            return source_axis == other.source_axis && flip == other.flip;
+        }
+    };
+
+    //! Check whether bonds can be binned once and symmetrized over the equivalent orientations on reduction.
+    /*! This is the case if all equivalent orientations permute the bins and
+        match those of previous calls since the last reset that were
+        symmetrized in the same way.
+    */
+    bool useBinSymmetries(const quat<float>* equiv_orientations, unsigned int num_equiv_orientations);
+
     float m_jacobian;
     vec3<float> m_shiftvec;                //!< vector that points from [0,0,0] to the origin of the pmft
     unsigned int m_num_equiv_orientations; //!< The number of equivalent orientations used in the current
                                            //!< calls to compute.
+    std::vector<BinSymmetry> m_bin_symmetries; //!< Bin permutations applied to the unsymmetrized counts.
+    BondHistogram::ThreadLocalHistogram
+        m_local_unsymmetrized_histograms; //!< Thread local counts of bonds binned once, before
+                                          //!< symmetrization over the equivalent orientations.
 };
 
 }; }; // end namespace freud::pmft
@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "CPUDispatch.h"
+
+/*! \file CPUDispatch.cc
+    \brief Runtime selection of the instruction set used by vectorized kernels.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+
+//! Detect the most capable instruction set supported by the CPU and operating system.
+/*! __builtin_cpu_supports also checks that the operating system saves the
+ *  AVX and AVX-512 registers on context switches.
+ */
+InstructionSet detectInstructionSet()
+{
+#if FREUD_DISPATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+        && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw"))
+    {
+        return InstructionSet::avx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return InstructionSet::avx2;
+    }
+#endif
+    return InstructionSet::baseline;
+}
+
+//! Get the instruction set to start with, lowered by FREUD_INSTRUCTION_SET if set.
+InstructionSet initialInstructionSet()
+{
+    const InstructionSet supported = getSupportedInstructionSet();
+    const char* requested = std::getenv("FREUD_INSTRUCTION_SET");
+    if (requested == nullptr)
+    {
+        return supported;
+    }
+    try
+    {
+        const InstructionSet instruction_set = getInstructionSetFromName(requested);
+        return instruction_set < supported ? instruction_set : supported;
+    }
+    catch (const std::invalid_argument&)
+    {
+        // An unknown name is ignored rather than failing on import.
+        return supported;
+    }
+}
+
+std::atomic<int>& activeInstructionSet()
+{
+    static std::atomic<int> active(static_cast<int>(initialInstructionSet()));
+    return active;
+}
+
+}; // end anonymous namespace
+
+InstructionSet getSupportedInstructionSet()
+{
+    static const InstructionSet supported = detectInstructionSet();
+    return supported;
+}
+
+InstructionSet getInstructionSet()
+{
+    return static_cast<InstructionSet>(activeInstructionSet().load(std::memory_order_relaxed));
+}
+
+void setInstructionSet(InstructionSet instruction_set)
+{
+    if (instruction_set > getSupportedInstructionSet())
+    {
+        throw std::invalid_argument("The instruction set " + getInstructionSetName(instruction_set)
+                                    + " is not supported by this CPU or build of freud.");
+    }
+    activeInstructionSet().store(static_cast<int>(instruction_set), std::memory_order_relaxed);
+}
+
+std::string getInstructionSetName(InstructionSet instruction_set)
+{
+    switch (instruction_set)
+    {
+    case InstructionSet::avx2:
+        return "avx2";
+    case InstructionSet::avx512:
+        return "avx512";
+    default:
+        return "baseline";
+    }
+}
+
+InstructionSet getInstructionSetFromName(const std::string& name)
+{
+    for (const auto instruction_set :
+         {InstructionSet::baseline, InstructionSet::avx2, InstructionSet::avx512})
+    {
+        if (name == getInstructionSetName(instruction_set))
+        {
+            return instruction_set;
+        }
+    }
+    throw std::invalid_argument("Unknown instruction set " + name
+                                + "; expected one of baseline, avx2 or avx512.");
+}
+
+}; }; // end namespace freud::util
@@ -0,0 +1,124 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <string>
+
+/*! \file CPUDispatch.h
+    \brief Runtime selection of the instruction set used by vectorized kernels.
+
+    Wheels are compiled for the baseline instruction set of their platform,
+    so loops that the compiler vectorizes only use e.g. SSE2 on x86-64. A
+    kernel passed to util::dispatch is compiled once for each supported
+    instruction set, and the variant matching the CPU (detected with CPUID
+    when freud is first used) is run:
+
+    \code
+    util::dispatch([&]() FREUD_KERNEL {
+        for (unsigned int k = 0; k < n; ++k)
+        {
+            out[k] = a[k] * b[k];
+        }
+    });
+    \endcode
+
+    The kernel must be a lambda marked FREUD_KERNEL so that it is inlined
+    into, and compiled with the target attributes of, each variant. Inline
+    functions called by the kernel are compiled for each variant too.
+    Dispatching is disabled (and only the baseline variant is compiled) on
+    compilers without target attributes, on other architectures, and when
+    FREUD_DISABLE_DISPATCH is defined.
+
+    Multiplications and additions are not contracted into FMA instructions
+    (which AVX-512 implies) because freud is compiled with
+    -ffp-contract=off, so every variant rounds exactly like the baseline:
+    results do not depend on the CPU they were computed on.
+*/
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(FREUD_DISABLE_DISPATCH)
+#define FREUD_DISPATCH_X86 1
+#define FREUD_TARGET_AVX2 __attribute__((target("avx2")))
+#define FREUD_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512vl,avx512bw,avx2")))
+#else
+#define FREUD_DISPATCH_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FREUD_KERNEL __attribute__((always_inline))
+#else
+#define FREUD_KERNEL
+#endif
+
+namespace freud { namespace util {
+
+//! Instruction sets that kernels are compiled for, in increasing order of capability.
+enum class InstructionSet
+{
+    baseline = 0, //!< The instruction set freud was compiled for.
+    avx2 = 1,     //!< AVX2.
+    avx512 = 2    //!< AVX-512 F, DQ, VL and BW.
+};
+
+//! Get the most capable instruction set supported by the CPU and operating system.
+InstructionSet getSupportedInstructionSet();
+
+//! Get the instruction set used by dispatched kernels.
+/*! This is the supported instruction set, unless it was lowered by the
+ *  FREUD_INSTRUCTION_SET environment variable (read when freud is first
+ *  used) or by setInstructionSet.
+ */
+InstructionSet getInstructionSet();
+
+//! Set the instruction set used by dispatched kernels.
+/*! \param instruction_set The instruction set, which must be supported.
+ */
+void setInstructionSet(InstructionSet instruction_set);
+
+//! Get the name of an instruction set ("baseline", "avx2" or "avx512").
+std::string getInstructionSetName(InstructionSet instruction_set);
+
+//! Get the instruction set with the given name, throwing if there is none.
+InstructionSet getInstructionSetFromName(const std::string& name);
+
+namespace detail {
+
+#if FREUD_DISPATCH_X86
+template<typename Kernel> FREUD_TARGET_AVX2 auto runAVX2(const Kernel& kernel)
+{
+    return kernel();
+}
+
+template<typename Kernel> FREUD_TARGET_AVX512 auto runAVX512(const Kernel& kernel)
+{
+    return kernel();
+}
+#endif
+
+}; // end namespace detail
+
+//! Run a kernel compiled for the active instruction set.
+/*! \param kernel A lambda marked FREUD_KERNEL with no arguments.
+ *  \returns The value returned by the kernel.
+ */
+template<typename Kernel> inline auto dispatch(const Kernel& kernel)
+{
+#if FREUD_DISPATCH_X86
+    switch (getInstructionSet())
+    {
+    case InstructionSet::avx512:
+        return detail::runAVX512(kernel);
+    case InstructionSet::avx2:
+        return detail::runAVX2(kernel);
+    default:
+        break;
+    }
+#endif
+    return kernel();
+}
+
+}; }; // end namespace freud::util
+
+#endif // CPU_DISPATCH_H
@@ -0,0 +1,80 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "Eigen/unsupported/Eigen/FFT"
+
+#include "ManagedArray.h"
+#include "utils.h"
+
+namespace freud { namespace util {
+
+//! Compute the discrete Fourier transform of a 3D grid in place.
+/*! The transform is computed as one pass of 1D FFTs along each dimension,
+ *  parallelized over the lines of the grid. Dimensions of size 1 are skipped,
+ *  so 2D grids may be stored with a single layer in the last dimension.
+ *
+ *  The forward transform uses the phase exp(-2 pi i m n / M). The inverse
+ *  transform uses exp(2 pi i m n / M) and is divided by the number of grid
+ *  points, so that it exactly undoes the forward transform.
+ *
+ *  \param grid The grid to transform, with shape {M_x, M_y, M_z}.
+ *  \param inverse Whether to compute the inverse transform.
+ */
+template<typename Real> void fft3D(ManagedArray<std::complex<Real>>& grid, bool inverse = false)
+{
+    const auto shape = grid.shape();
+    if (shape.size() != 3)
+    {
+        throw std::invalid_argument("fft3D requires a grid with three dimensions.");
+    }
+
+    size_t stride = grid.size();
+    for (const auto line_size : shape)
+    {
+        // Lines along this dimension are line_size elements apart by stride,
+        // and the line starts are laid out as blocks of stride consecutive
+        // elements, line_size * stride apart.
+        stride /= line_size;
+        if (line_size == 1)
+        {
+            continue;
+        }
+        const size_t num_lines = grid.size() / line_size;
+        forLoopWrapper(0, num_lines, [&](size_t begin, size_t end) {
+            Eigen::FFT<Real> fft;
+            std::vector<std::complex<Real>> line(line_size);
+            std::vector<std::complex<Real>> transformed_line(line_size);
+            for (size_t line_index = begin; line_index < end; ++line_index)
+            {
+                const size_t start = (line_index / stride) * stride * line_size + line_index % stride;
+                for (size_t n = 0; n < line_size; ++n)
+                {
+                    line[n] = grid[start + n * stride];
+                }
+                if (inverse)
+                {
+                    fft.inv(transformed_line, line);
+                }
+                else
+                {
+                    fft.fwd(transformed_line, line);
+                }
+                for (size_t n = 0; n < line_size; ++n)
+                {
+                    grid[start + n * stride] = transformed_line[n];
+                }
+            }
+        });
+    }
+}
+
+}; }; // end namespace freud::util
+
+#endif // FFT_H
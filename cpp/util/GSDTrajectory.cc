@@ -0,0 +1,380 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "GSDTrajectory.h"
+
+/*! \file GSDTrajectory.cc
+    \brief Streams the frames of HOOMD-blue GSD trajectories.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+
+//! Identifier at the start of every GSD file.
+constexpr uint64_t GSD_MAGIC_ID = 0x65DF65DF65DF65DF;
+
+//! Length of the names of the namelist entries of GSD 1.x files.
+constexpr size_t GSD_V1_NAME_SIZE = 64;
+
+//! Element type ids of GSD chunks.
+enum GSDType : uint8_t
+{
+    GSD_TYPE_UINT8 = 1,
+    GSD_TYPE_UINT16,
+    GSD_TYPE_UINT32,
+    GSD_TYPE_UINT64,
+    GSD_TYPE_INT8,
+    GSD_TYPE_INT16,
+    GSD_TYPE_INT32,
+    GSD_TYPE_INT64,
+    GSD_TYPE_FLOAT,
+    GSD_TYPE_DOUBLE,
+};
+
+//! File header, as laid out at the start of the file.
+struct GSDHeader
+{
+    uint64_t magic;
+    uint64_t index_location;
+    uint64_t index_allocated_entries;
+    uint64_t namelist_location;
+    uint64_t namelist_allocated_entries;
+    uint32_t schema_version;
+    uint32_t gsd_version;
+    char application[64];
+    char schema[64];
+    char reserved[80];
+};
+static_assert(sizeof(GSDHeader) == 256, "GSD headers are 256 bytes.");
+
+//! Index entry locating one chunk, as laid out in the file.
+struct GSDIndexEntry
+{
+    int64_t frame;
+    uint64_t N;
+    int64_t location;
+    uint32_t M;
+    uint16_t id;
+    uint8_t type;
+    uint8_t flags;
+};
+static_assert(sizeof(GSDIndexEntry) == 32, "GSD index entries are 32 bytes.");
+
+//! Names of the chunks that are read.
+const std::array<std::string, 4> CHUNK_NAMES {"configuration/box", "configuration/dimensions",
+                                              "particles/position", "particles/image"};
+
+//! Return the size in bytes of an element of the given type.
+size_t typeSize(uint8_t type)
+{
+    switch (type)
+    {
+    case GSD_TYPE_UINT8:
+    case GSD_TYPE_INT8:
+        return 1;
+    case GSD_TYPE_UINT16:
+    case GSD_TYPE_INT16:
+        return 2;
+    case GSD_TYPE_UINT32:
+    case GSD_TYPE_INT32:
+    case GSD_TYPE_FLOAT:
+        return 4;
+    case GSD_TYPE_UINT64:
+    case GSD_TYPE_INT64:
+    case GSD_TYPE_DOUBLE:
+        return 8;
+    default:
+        throw std::runtime_error("GSDTrajectory found a chunk of unknown type.");
+    }
+}
+
+//! Convert count elements of the given type to T.
+template<typename T> void convertElements(const char* data, uint8_t type, size_t count, T* result)
+{
+    const auto convert = [&](auto element) {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(&element, data + i * sizeof(element), sizeof(element));
+            result[i] = static_cast<T>(element);
+        }
+    };
+    switch (type)
+    {
+    case GSD_TYPE_UINT8:
+        convert(uint8_t());
+        break;
+    case GSD_TYPE_UINT16:
+        convert(uint16_t());
+        break;
+    case GSD_TYPE_UINT32:
+        convert(uint32_t());
+        break;
+    case GSD_TYPE_UINT64:
+        convert(uint64_t());
+        break;
+    case GSD_TYPE_INT8:
+        convert(int8_t());
+        break;
+    case GSD_TYPE_INT16:
+        convert(int16_t());
+        break;
+    case GSD_TYPE_INT32:
+        convert(int32_t());
+        break;
+    case GSD_TYPE_INT64:
+        convert(int64_t());
+        break;
+    case GSD_TYPE_FLOAT:
+        convert(float());
+        break;
+    case GSD_TYPE_DOUBLE:
+        convert(double());
+        break;
+    default:
+        throw std::runtime_error("GSDTrajectory found a chunk of unknown type.");
+    }
+}
+
+} // namespace
+
+GSDTrajectory::GSDTrajectory(const std::string& filename) : m_filename(filename)
+{
+#ifndef _WIN32
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw std::runtime_error("GSDTrajectory could not open " + filename + ".");
+    }
+    struct stat file_stat
+    {};
+    if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+    {
+        m_file_size = static_cast<uint64_t>(file_stat.st_size);
+        void* map = ::mmap(nullptr, m_file_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            m_map = static_cast<const char*>(map);
+        }
+    }
+    ::close(fd);
+#endif
+    if (m_map == nullptr)
+    {
+        m_file.open(filename, std::ios::binary);
+        if (!m_file)
+        {
+            throw std::runtime_error("GSDTrajectory could not open " + filename + ".");
+        }
+        m_file.seekg(0, std::ios::end);
+        m_file_size = static_cast<uint64_t>(m_file.tellg());
+    }
+
+    try
+    {
+        GSDHeader header {};
+        readBytes(0, sizeof(header), &header);
+        if (header.magic != GSD_MAGIC_ID)
+        {
+            throw std::runtime_error(filename + " is not a GSD file.");
+        }
+        const uint32_t major_version = header.gsd_version >> 16;
+        if (major_version < 1 || major_version > 2)
+        {
+            throw std::runtime_error("GSDTrajectory cannot read version " + std::to_string(major_version)
+                                     + " GSD files.");
+        }
+
+        // GSD 1.x files store names in fixed size entries, and GSD 2.x files
+        // store null terminated names in a buffer of the allocated size.
+        const uint64_t namelist_size = major_version == 1
+            ? header.namelist_allocated_entries * GSD_V1_NAME_SIZE
+            : header.namelist_allocated_entries;
+        std::vector<char> namelist(namelist_size + 1, 0);
+        readBytes(header.namelist_location, namelist_size, namelist.data());
+        std::unordered_map<uint16_t, std::string> names_by_id;
+        uint16_t id = 0;
+        for (size_t offset = 0; offset < namelist_size && namelist[offset] != 0; ++id)
+        {
+            names_by_id[id] = std::string(namelist.data() + offset);
+            offset = major_version == 1 ? offset + GSD_V1_NAME_SIZE : offset + names_by_id[id].size() + 1;
+        }
+
+        std::vector<GSDIndexEntry> index(header.index_allocated_entries);
+        readBytes(header.index_location, index.size() * sizeof(GSDIndexEntry), index.data());
+        for (const auto& name : CHUNK_NAMES)
+        {
+            m_chunks[name];
+        }
+        for (const auto& entry : index)
+        {
+            // Unused entries at the end of the index have no location.
+            if (entry.location == 0)
+            {
+                break;
+            }
+            m_num_frames = std::max(m_num_frames, static_cast<uint64_t>(entry.frame) + 1);
+            const auto name = names_by_id.find(entry.id);
+            if (name == names_by_id.end() || m_chunks.count(name->second) == 0)
+            {
+                continue;
+            }
+            auto& chunks = m_chunks[name->second];
+            if (chunks.size() <= static_cast<uint64_t>(entry.frame))
+            {
+                chunks.resize(entry.frame + 1);
+            }
+            const size_t size = entry.N * entry.M * typeSize(entry.type);
+            if (static_cast<uint64_t>(entry.location) + size > m_file_size)
+            {
+                throw std::runtime_error(filename + " is truncated.");
+            }
+            chunks[entry.frame] = {static_cast<uint64_t>(entry.location), entry.N, entry.M, entry.type};
+        }
+    }
+    catch (...)
+    {
+#ifndef _WIN32
+        if (m_map != nullptr)
+        {
+            ::munmap(const_cast<char*>(m_map), m_file_size);
+        }
+#endif
+        throw;
+    }
+}
+
+GSDTrajectory::~GSDTrajectory()
+{
+#ifndef _WIN32
+    if (m_map != nullptr)
+    {
+        ::munmap(const_cast<char*>(m_map), m_file_size);
+    }
+#endif
+}
+
+void GSDTrajectory::validateRange(uint64_t first, uint64_t last, uint64_t stride) const
+{
+    if (stride == 0)
+    {
+        throw std::invalid_argument("GSDTrajectory requires a positive stride.");
+    }
+    if (first > last || last > m_num_frames)
+    {
+        throw std::invalid_argument("GSDTrajectory frame range is out of bounds.");
+    }
+}
+
+void GSDTrajectory::readBytes(uint64_t offset, uint64_t size, void* dest) const
+{
+    if (offset + size > m_file_size)
+    {
+        throw std::runtime_error(m_filename + " is truncated.");
+    }
+    if (m_map != nullptr)
+    {
+        std::memcpy(dest, m_map + offset, size);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_file_mutex);
+    m_file.seekg(static_cast<std::streamoff>(offset));
+    m_file.read(static_cast<char*>(dest), static_cast<std::streamsize>(size));
+    if (!m_file)
+    {
+        throw std::runtime_error("GSDTrajectory could not read " + m_filename + ".");
+    }
+}
+
+const GSDTrajectory::Chunk* GSDTrajectory::findChunk(uint64_t frame, const std::string& name) const
+{
+    const auto& chunks = m_chunks.at(name);
+    if (frame < chunks.size() && chunks[frame].location != 0)
+    {
+        return &chunks[frame];
+    }
+    if (!chunks.empty() && chunks[0].location != 0)
+    {
+        return &chunks[0];
+    }
+    return nullptr;
+}
+
+template<typename T>
+void GSDTrajectory::readChunk(const Chunk& chunk, uint32_t columns, std::vector<T>& result) const
+{
+    if (chunk.M != columns)
+    {
+        throw std::runtime_error("GSDTrajectory found a chunk with an unexpected number of columns.");
+    }
+    const size_t count = chunk.N * chunk.M;
+    result.resize(count);
+    const size_t size = count * typeSize(chunk.type);
+    if (m_map != nullptr)
+    {
+        convertElements(m_map + chunk.location, chunk.type, count, result.data());
+        return;
+    }
+    std::vector<char> buffer(size);
+    readBytes(chunk.location, size, buffer.data());
+    convertElements(buffer.data(), chunk.type, count, result.data());
+}
+
+void GSDTrajectory::readFrame(uint64_t frame, GSDFrame& result) const
+{
+    if (frame >= m_num_frames)
+    {
+        throw std::invalid_argument("GSDTrajectory frame index is out of bounds.");
+    }
+    result.index = frame;
+
+    // HOOMD-blue's defaults apply to chunks missing from frame 0.
+    std::vector<float> box {1, 1, 1, 0, 0, 0};
+    std::vector<uint8_t> dimensions {3};
+    if (const Chunk* chunk = findChunk(frame, "configuration/box"))
+    {
+        readChunk(*chunk, 1, box);
+        if (box.size() != 6)
+        {
+            throw std::runtime_error("GSDTrajectory requires configuration/box to have 6 elements.");
+        }
+    }
+    if (const Chunk* chunk = findChunk(frame, "configuration/dimensions"))
+    {
+        readChunk(*chunk, 1, dimensions);
+    }
+    result.box = box::Box(box[0], box[1], box[2], box[3], box[4], box[5], dimensions.at(0) == 2);
+
+    const Chunk* position_chunk = findChunk(frame, "particles/position");
+    if (position_chunk == nullptr)
+    {
+        result.positions.clear();
+        result.images.clear();
+        return;
+    }
+    std::vector<float> values;
+    readChunk(*position_chunk, 3, values);
+    result.positions.resize(position_chunk->N);
+    std::memcpy(static_cast<void*>(result.positions.data()), values.data(), values.size() * sizeof(float));
+
+    result.images.assign(position_chunk->N, vec3<int>(0, 0, 0));
+    const Chunk* image_chunk = findChunk(frame, "particles/image");
+    if (image_chunk != nullptr && image_chunk->N == position_chunk->N)
+    {
+        std::vector<int> images;
+        readChunk(*image_chunk, 3, images);
+        std::memcpy(static_cast<void*>(result.images.data()), images.data(), images.size() * sizeof(int));
+    }
+}
+
+}; }; // end namespace freud::util
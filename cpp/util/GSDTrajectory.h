@@ -0,0 +1,162 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef GSD_TRAJECTORY_H
+#define GSD_TRAJECTORY_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Box.h"
+#include "VectorMath.h"
+
+/*! \file GSDTrajectory.h
+    \brief Streams the frames of HOOMD-blue GSD trajectories.
+*/
+
+namespace freud { namespace util {
+
+//! The data of one frame of a GSD trajectory.
+struct GSDFrame
+{
+    box::Box box;                       //!< Simulation box of the frame.
+    std::vector<vec3<float>> positions; //!< Positions of the particles.
+    std::vector<vec3<int>> images;      //!< Images of the particles, zero if not stored.
+    uint64_t index {0};                 //!< Index of the frame in the trajectory.
+
+    //! Get the number of particles.
+    unsigned int getNumParticles() const
+    {
+        return static_cast<unsigned int>(positions.size());
+    }
+};
+
+//! Reader of the frames of a GSD file written with the HOOMD schema.
+/*! Only the chunks needed by freud are read: configuration/box,
+ *  configuration/dimensions, particles/position and particles/image. As in
+ *  HOOMD-blue, chunks missing from a frame take their value from frame 0.
+ *
+ *  On POSIX systems the file is memory mapped, so the chunks of a frame are
+ *  copied straight from the page cache without system calls. forEachFrame
+ *  reads frame t+1 on a background thread while frame t is processed, so
+ *  the I/O of a trajectory overlaps with the computation.
+ *
+ *  The reader is read-only and its functions may be called concurrently.
+ */
+class GSDTrajectory
+{
+public:
+    //! Open a GSD file.
+    explicit GSDTrajectory(const std::string& filename);
+
+    ~GSDTrajectory();
+
+    GSDTrajectory(const GSDTrajectory&) = delete;
+    GSDTrajectory& operator=(const GSDTrajectory&) = delete;
+
+    //! Get the name of the file.
+    const std::string& getFilename() const
+    {
+        return m_filename;
+    }
+
+    //! Get the number of frames in the file.
+    uint64_t getNumFrames() const
+    {
+        return m_num_frames;
+    }
+
+    //! Read a frame into a GSDFrame, reusing its buffers.
+    void readFrame(uint64_t frame, GSDFrame& result) const;
+
+    //! Call f with each of the frames first, first + stride, ... before last.
+    /*! The next frame is read on a background thread while f processes the
+     *  current one. The GSDFrame passed to f is only valid during the call.
+     *
+     *  \param first Index of the first frame.
+     *  \param last Index past the last frame.
+     *  \param stride Number of frames between consecutive frames passed to f.
+     *  \param f An object with operator(const GSDFrame&).
+     */
+    template<typename Func> void forEachFrame(uint64_t first, uint64_t last, uint64_t stride, Func f) const
+    {
+        validateRange(first, last, stride);
+        if (first >= last)
+        {
+            return;
+        }
+        std::array<GSDFrame, 2> buffers;
+        readFrame(first, buffers[0]);
+        unsigned int current = 0;
+        for (uint64_t frame = first; frame < last; frame += stride)
+        {
+            std::future<void> prefetch;
+            if (last - frame > stride)
+            {
+                GSDFrame& next = buffers[1 - current];
+                prefetch = std::async(std::launch::async,
+                                      [this, frame, stride, &next]() { readFrame(frame + stride, next); });
+            }
+            try
+            {
+                f(static_cast<const GSDFrame&>(buffers[current]));
+            }
+            catch (...)
+            {
+                if (prefetch.valid())
+                {
+                    prefetch.wait();
+                }
+                throw;
+            }
+            if (prefetch.valid())
+            {
+                prefetch.get();
+            }
+            current = 1 - current;
+        }
+    }
+
+private:
+    //! Location of a chunk in the file.
+    struct Chunk
+    {
+        uint64_t location {0}; //!< Byte offset of the data.
+        uint64_t N {0};        //!< Number of rows.
+        uint32_t M {0};        //!< Number of columns.
+        uint8_t type {0};      //!< GSD type id of the elements.
+    };
+
+    //! Throw if the frame range is invalid.
+    void validateRange(uint64_t first, uint64_t last, uint64_t stride) const;
+
+    //! Copy bytes of the file into dest.
+    void readBytes(uint64_t offset, uint64_t size, void* dest) const;
+
+    //! Find the chunk with the given name in a frame, falling back to frame 0.
+    const Chunk* findChunk(uint64_t frame, const std::string& name) const;
+
+    //! Read a chunk converting its elements to T, checking its number of columns.
+    template<typename T> void readChunk(const Chunk& chunk, uint32_t columns, std::vector<T>& result) const;
+
+    std::string m_filename;    //!< Name of the file.
+    uint64_t m_file_size {0};  //!< Size of the file in bytes.
+    uint64_t m_num_frames {0}; //!< Number of frames in the file.
+
+    //! Chunks of each frame by name, for the names freud reads.
+    std::unordered_map<std::string, std::vector<Chunk>> m_chunks;
+
+    const char* m_map {nullptr};     //!< Memory mapped contents of the file, if mapped.
+    mutable std::ifstream m_file;    //!< Stream used to read the file if it is not mapped.
+    mutable std::mutex m_file_mutex; //!< Serializes reads from m_file.
+};
+
+}; }; // end namespace freud::util
+
+#endif // GSD_TRAJECTORY_H
@@ -4,17 +4,26 @@
 #ifndef HISTOGRAM_H
 #define HISTOGRAM_H
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
 #include <sstream>
+#include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <utility>
 
 #include "ManagedArray.h"
+#include "Profiler.h"
 #include "utils.h"
 
 namespace freud { namespace util {
@@ -170,13 +179,279 @@ public:
         return bin;
     }
 
+    //! Return the inverse of the bin width.
+    float getInverseBinWidth() const
+    {
+        return m_inverse_bin_width;
+    }
+
 protected:
     float m_bin_width;         //!< Bin width
     float m_inverse_bin_width; //!< Inverse of bin width
 };
 
+//! An axis with arbitrary increasing bin edges.
+/*! Instead of searching the bin edges, the range of the axis is divided into
+ * uniform lookup cells narrower than the narrowest bin, and each cell stores
+ * the lowest bin a value in it can fall into. Finding a bin then costs one
+ * scaling like RegularAxis::bin, a table lookup and usually one comparison
+ * with the next bin edge.
+ *
+ * The cells may instead be uniform in the bit pattern of the values, which
+ * for positive values increases monotonically and approximately like their
+ * logarithm, so logarithmically spaced edges also need few cells per bin.
+ */
+class VariableAxis : public Axis
+{
+public:
+    //! Constructor
+    /*! \param bin_edges The nbins + 1 strictly increasing bin edges.
+     *  \param logarithmic_cells Whether the lookup cells are uniform in the
+     *         bit pattern of the values, which requires positive edges.
+     */
+    explicit VariableAxis(const std::vector<float>& bin_edges, bool logarithmic_cells = false)
+        : Axis(bin_edges.empty() ? 0 : bin_edges.size() - 1, bin_edges.empty() ? 0 : bin_edges.front(),
+               bin_edges.empty() ? 0 : bin_edges.back()),
+          m_logarithmic_cells(logarithmic_cells)
+    {
+        if (bin_edges.size() < 2)
+        {
+            throw std::invalid_argument("VariableAxis requires at least two bin edges.");
+        }
+        if (logarithmic_cells && !(bin_edges.front() > 0))
+        {
+            throw std::invalid_argument("VariableAxis with logarithmic cells requires positive bin edges.");
+        }
+        for (size_t i = 0; i < m_nbins; ++i)
+        {
+            if (!(bin_edges[i] < bin_edges[i + 1]))
+            {
+                throw std::invalid_argument("VariableAxis requires strictly increasing bin edges.");
+            }
+        }
+        m_bin_edges = bin_edges;
+        buildLookupTable();
+    }
+
+    ~VariableAxis() override = default;
+
+    //! Find the bin of a value along this axis.
+    /*! \param value The value to bin
+     *
+     * 
+eturn The index of the bin the value falls into.
+     */
+    size_t bin(const float& value) const override
+    {
+        if (!(value >= m_min) || value >= m_max)
+        {
+            return OVERFLOW_BIN;
+        }
+        // The cell gives a lower bound. Cells narrower than the bins hold at
+        // most one edge, so one branchless comparison usually finds the bin,
+        // and the loop (which stops at the last bin since value < m_max) only
+        // runs for cells holding several edges.
+        size_t bin = m_cell_bins[cell(value)];
+        bin += static_cast<size_t>(value >= m_bin_edges[bin + 1]);
+        while (value >= m_bin_edges[bin + 1])
+        {
+            ++bin;
+        }
+        return bin;
+    }
+
+protected:
+    //! Maximum number of lookup cells per bin, which bounds the size of the table for very uneven bins.
+    static constexpr size_t MAX_CELLS_PER_BIN = 8;
+
+    //! Map a value in [m_min, m_max) onto the monotonically increasing key the cells are uniform in.
+    float cellKey(float value) const
+    {
+        if (m_logarithmic_cells)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return static_cast<float>(bits);
+        }
+        return value;
+    }
+
+    //! Find the lookup cell of a value in [m_min, m_max).
+    /*! Every step is monotonic in the value, so a value is never in a lower
+     * cell than a smaller value.
+     */
+    size_t cell(float value) const
+    {
+        const float scaled = (cellKey(value) - m_min_key) * m_inverse_cell_width;
+        return static_cast<size_t>(std::min(std::max(float(0), scaled), m_last_cell));
+    }
+
+    //! Build the lowest possible bin of each lookup cell.
+    void buildLookupTable()
+    {
+        m_min_key = cellKey(m_min);
+        const float key_range = cellKey(m_max) - m_min_key;
+        float min_key_width = key_range;
+        for (size_t i = 0; i < m_nbins; ++i)
+        {
+            min_key_width = std::min(min_key_width, cellKey(m_bin_edges[i + 1]) - cellKey(m_bin_edges[i]));
+        }
+        const auto num_cells = static_cast<size_t>(std::min(
+            std::ceil(static_cast<double>(key_range) / std::max(min_key_width, float(1e-30))),
+            static_cast<double>(MAX_CELLS_PER_BIN * m_nbins)));
+        m_inverse_cell_width = static_cast<float>(static_cast<double>(num_cells) / key_range);
+        m_last_cell = static_cast<float>(num_cells - 1);
+
+        // A value in cell c is larger than every edge in a lower cell, so it
+        // is at least in the bin starting at the last of those edges.
+        m_cell_bins.resize(num_cells);
+        size_t edge = 1;
+        for (size_t c = 0; c < num_cells; ++c)
+        {
+            while (edge < m_nbins && cell(m_bin_edges[edge]) < c)
+            {
+                ++edge;
+            }
+            m_cell_bins[c] = static_cast<unsigned int>(edge - 1);
+        }
+    }
+
+    bool m_logarithmic_cells;              //!< Whether the cells are uniform in the bits of the values.
+    float m_min_key {0};                   //!< Key of the lowest value.
+    float m_inverse_cell_width {0};        //!< Inverse of the width of the cells in keys.
+    float m_last_cell {0};                 //!< Index of the last cell.
+    std::vector<unsigned int> m_cell_bins; //!< Lowest bin of the values in each cell.
+};
+
+//! A logarithmically spaced axis.
+/*! The bin edges are min * (max / min)^(i / nbins), and the bins are found
+ * with lookup cells uniform in the bit pattern of the values, so no logarithm
+ * is evaluated while binning.
+ */
+class LogAxis : public VariableAxis
+{
+public:
+    LogAxis(size_t nbins, float min, float max) : VariableAxis(logBinEdges(nbins, min, max), true) {}
+
+    ~LogAxis() override = default;
+
+private:
+    //! Compute the logarithmically spaced bin edges, validating the arguments.
+    static std::vector<float> logBinEdges(size_t nbins, float min, float max)
+    {
+        if (nbins == 0)
+        {
+            throw std::invalid_argument("LogAxis requires a nonzero number of bins.");
+        }
+        if (!(min > 0) || !(max > min))
+        {
+            throw std::invalid_argument("LogAxis requires 0 < min < max.");
+        }
+        std::vector<float> bin_edges(nbins + 1);
+        const double log_ratio = std::log(static_cast<double>(max) / static_cast<double>(min));
+        for (size_t i = 0; i <= nbins; ++i)
+        {
+            bin_edges[i] = static_cast<float>(
+                static_cast<double>(min) * std::exp(log_ratio * static_cast<double>(i) / nbins));
+        }
+        bin_edges.front() = min;
+        bin_edges.back() = max;
+        return bin_edges;
+    }
+};
+
 using Axes = std::vector<std::shared_ptr<Axis>>;
 
+//! Fused bin lookup for D regular axes.
+/*! Histogram::bin dispatches to each axis through a virtual call and returns
+ * early on overflow. When all axes are known to be RegularAxis instances,
+ * the linear bin of a set of values can instead be computed with a fixed
+ * number of arithmetic operations and no branches, which allows the compiler
+ * to vectorize the lookup across many values. The bins found are identical to
+ * those of Histogram::bin.
+ */
+template<size_t D> class RegularBins
+{
+public:
+    //! Constructor
+    /*! \param axes The axes of the histogram, all of which must be RegularAxis instances.
+     */
+    explicit RegularBins(const Axes& axes)
+    {
+        if (axes.size() != D)
+        {
+            std::ostringstream msg;
+            msg << "RegularBins requires " << D << " axes, but " << axes.size() << " were provided.";
+            throw std::invalid_argument(msg.str());
+        }
+        size_t stride = 1;
+        for (size_t ax_idx = D; ax_idx-- > 0;)
+        {
+            const auto* axis = dynamic_cast<const RegularAxis*>(axes[ax_idx].get());
+            if (axis == nullptr)
+            {
+                throw std::invalid_argument("RegularBins requires all axes to be regular.");
+            }
+            m_min[ax_idx] = axis->getMin();
+            m_max[ax_idx] = axis->getMax();
+            m_inverse_bin_width[ax_idx] = axis->getInverseBinWidth();
+            m_last_bin[ax_idx] = static_cast<float>(axis->size() - 1);
+            m_stride[ax_idx] = static_cast<unsigned int>(stride);
+            stride *= axis->size();
+        }
+    }
+
+    //! Find the linear bin of one value per axis.
+    size_t bin(const std::array<float, D>& values) const
+    {
+        bool in_range = true;
+        unsigned int value_bin = 0;
+        for (size_t ax_idx = 0; ax_idx < D; ++ax_idx)
+        {
+            value_bin += axisBin(ax_idx, values[ax_idx], in_range) * m_stride[ax_idx];
+        }
+        return in_range ? value_bin : Axis::OVERFLOW_BIN;
+    }
+
+    //! Find the linear bins of n values per axis.
+    /*! \param values D arrays holding the n values along each axis.
+     *  \param n The number of values per axis.
+     *  \param bins Output array of n linear bins.
+     */
+    void bin(const std::array<const float*, D>& values, size_t n, size_t* bins) const
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            bool in_range = true;
+            unsigned int value_bin = 0;
+            for (size_t ax_idx = 0; ax_idx < D; ++ax_idx)
+            {
+                value_bin += axisBin(ax_idx, values[ax_idx][i], in_range) * m_stride[ax_idx];
+            }
+            bins[i] = in_range ? value_bin : Axis::OVERFLOW_BIN;
+        }
+    }
+
+private:
+    //! Find the bin of a value along one axis, clearing in_range if it lies outside the axis.
+    /*! The scaled value is clamped before truncation, which both avoids
+     * converting out of range floats to integers and maps values rounding up
+     * to the number of bins onto the last bin, as RegularAxis::bin does.
+     */
+    unsigned int axisBin(size_t ax_idx, float value, bool& in_range) const
+    {
+        in_range = in_range && (value >= m_min[ax_idx]) && (value < m_max[ax_idx]);
+        const float scaled = (value - m_min[ax_idx]) * m_inverse_bin_width[ax_idx];
+        return static_cast<unsigned int>(std::min(std::max(float(0), scaled), m_last_bin[ax_idx]));
+    }
+
+    std::array<float, D> m_min {};               //!< Lowest value of each axis.
+    std::array<float, D> m_max {};               //!< Highest value of each axis.
+    std::array<float, D> m_inverse_bin_width {}; //!< Inverse bin width of each axis.
+    std::array<float, D> m_last_bin {};          //!< Index of the last bin of each axis.
+    std::array<unsigned int, D> m_stride {};     //!< Row-major stride of each axis.
+};
+
 //! An n-dimensional histogram class.
 /*! The Histogram is designed to simplify the most common use of histograms in
  * C++ code, which is looping over a series of values and then binning them. To
@@ -186,6 +461,12 @@ using Axes = std::vector<std::shared_ptr<Axis>>;
  * can also directly request to know what bin a value would occupy if they wish
  * to operate on the histogram directly. The underlying data is handled using a
  * ManagedArray, allowing dispatch of the multi-dimensional indexing.
+ *
+ * A histogram may instead be constructed as paged, in which case the bins are
+ * stored in pages of PAGE_SIZE bins that are only allocated when a bin in
+ * them is first incremented. Paged histograms are meant to be used as sparse
+ * thread-local copies (see ThreadLocalHistogram), and their counts can only
+ * be read by reducing them.
  */
 template<typename T> class Histogram
 {
@@ -200,16 +481,44 @@ public:
      * local copies all share the same axes (because the axes are stored as
      * arrays of shared_ptrs in the Histogram class). This should cause no
      * problems, but can be refactored if needed.
+     *
+     * If paged is true, the thread local copies are paged histograms, so the
+     * memory used by each thread scales with the number of pages of bins it
+     * touches rather than the total number of bins. This is useful for large
+     * multidimensional histograms in which most bins are never populated.
+     *
+     * The thread local copies may be constructed from a histogram with a
+     * different bin type and reduced into it, so that values accumulated over
+     * many frames can be summed in a wider type (e.g. double) than the one
+     * the results are stored in (e.g. float).
+     *
+     * Reductions are incremental: the copies accessed since the last
+     * reduction are merged into a running total and cleared, so polling the
+     * result during a long accumulation only reads the copies of the threads
+     * that contributed since the previous poll.
+     *
+     * When reductions are deterministic (see parallel::DeterministicChunk),
+     * histograms of floating point bins are accumulated per chunk of the
+     * parallel loops rather than per thread, and the chunks are merged in a
+     * fixed order. Integer counts are exact and always stay thread local.
      */
     class ThreadLocalHistogram
     {
     public:
         ThreadLocalHistogram() = default;
 
-        explicit ThreadLocalHistogram(const Histogram& histogram)
-            : m_local_histograms([histogram]() { return Histogram(histogram.m_axes); })
+        template<typename U>
+        explicit ThreadLocalHistogram(const Histogram<U>& histogram, bool paged = false)
+            : m_local_histograms([axes = histogram.getAxes(), paged]() { return Histogram(axes, paged); }),
+              m_paged(paged), m_axes(histogram.getAxes()),
+              m_chunk_histograms(std::is_integral_v<T> ? 0 : parallel::DETERMINISTIC_NUM_CHUNKS)
         {}
 
+        ThreadLocalHistogram(const ThreadLocalHistogram&) = delete;
+        ThreadLocalHistogram& operator=(const ThreadLocalHistogram&) = delete;
+        ThreadLocalHistogram(ThreadLocalHistogram&&) = default;
+        ThreadLocalHistogram& operator=(ThreadLocalHistogram&&) = default;
+
         using const_iterator = typename tbb::enumerable_thread_specific<Histogram<T>>::const_iterator;
         using iterator = typename tbb::enumerable_thread_specific<Histogram>::iterator;
         using reference = typename tbb::enumerable_thread_specific<Histogram>::reference;
@@ -234,61 +543,183 @@ public:
             return m_local_histograms.end();
         }
 
+        //! Get the histogram of this thread (or chunk), which is merged by the next reduction.
         reference local()
         {
-            return m_local_histograms.local();
+            const int chunk = parallel::DeterministicChunk::current();
+            if (chunk >= 0 && !m_chunk_histograms.empty())
+            {
+                // Only the task running a chunk accesses its histogram.
+                auto& chunk_hist = m_chunk_histograms[chunk];
+                if (!chunk_hist)
+                {
+                    chunk_hist = std::make_unique<Histogram>(m_axes, m_paged);
+                }
+                chunk_hist->m_unreduced = true;
+                return *chunk_hist;
+            }
+            reference hist = m_local_histograms.local();
+            hist.m_unreduced = true;
+            return hist;
         }
 
+        //! Reset the thread local histograms.
+        /*! The thread local copies are released and recreated empty the
+         *  next time each thread accesses its local histogram, so threads
+         *  that do not take part in the next computation are not reduced.
+         */
         void reset()
         {
-            for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
+            m_local_histograms.clear();
+            for (auto& chunk_hist : m_chunk_histograms)
             {
-                hist->reset();
+                chunk_hist.reset();
             }
+            std::vector<T>().swap(m_reduced);
         }
 
         //! Dispatch to thread local histogram.
         template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
         {
-            m_local_histograms.local()(values...);
+            local()(values...);
         }
 
         //! Dispatch to thread local histogram.
         void increment(size_t value_bin, T weight = 1)
         {
-            m_local_histograms.local().increment(value_bin, weight);
+            local().increment(value_bin, weight);
         }
 
         // Reduce over histograms into the result array.
-        void reduceInto(ManagedArray<T>& result)
+        /*! The thread local histograms accessed since the last reduction are
+         *  added to the running total and cleared, then the total is written
+         *  to the result. The total is kept in T and converted to the type of
+         *  the result array once.
+         */
+        template<typename U> void reduceInto(ManagedArray<U>& result)
         {
-            result.reset();
-            util::forLoopWrapper(0, result.size(), [&](size_t begin, size_t end) {
+            const size_t size = result.size();
+            if (m_reduced.size() != size)
+            {
+                m_reduced.assign(size, T(0));
+            }
+
+            std::vector<Histogram*> unreduced;
+            for (auto& hist : m_local_histograms)
+            {
+                if (hist.m_unreduced)
+                {
+                    unreduced.push_back(&hist);
+                }
+            }
+            const size_t num_thread_histograms = unreduced.size();
+            for (auto& chunk_hist : m_chunk_histograms)
+            {
+                if (chunk_hist && chunk_hist->m_unreduced)
+                {
+                    unreduced.push_back(chunk_hist.get());
+                }
+            }
+            if (m_paged)
+            {
+                // Pages are merged in the order of the histograms.
+                mergePages(unreduced);
+            }
+            else
+            {
+                std::vector<const T*> local_bin_counts;
+                local_bin_counts.reserve(unreduced.size());
+                for (const Histogram* hist : unreduced)
+                {
+                    local_bin_counts.push_back(hist->m_bin_counts.get());
+                }
+                const auto chunk_bin_counts_begin = local_bin_counts.begin() + num_thread_histograms;
+                const std::vector<const T*> chunk_bin_counts(chunk_bin_counts_begin, local_bin_counts.end());
+                local_bin_counts.erase(chunk_bin_counts_begin, local_bin_counts.end());
+                util::reduceArrays(m_reduced.data(), size, local_bin_counts);
+                util::reduceArraysPairwise(m_reduced.data(), size, chunk_bin_counts);
+            }
+            util::forLoopWrapper(0, unreduced.size(), [&](size_t begin, size_t end) {
                 for (size_t i = begin; i < end; ++i)
                 {
-                    for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
+                    unreduced[i]->reset();
+                    unreduced[i]->m_unreduced = false;
+                }
+            });
+
+            U* const result_data = result.get();
+            util::forLoopWrapper(0, size, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    result_data[i] = static_cast<U>(m_reduced[i]);
+                }
+            });
+        }
+
+    protected:
+        //! Add paged histograms to the running total one page at a time.
+        /*! Pages that were never allocated by a thread are skipped.
+         */
+        void mergePages(const std::vector<Histogram*>& unreduced)
+        {
+            const size_t size = m_reduced.size();
+            const size_t num_pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+            util::forLoopWrapper(0, num_pages, [&](size_t begin, size_t end) {
+                for (size_t page = begin; page < end; ++page)
+                {
+                    const size_t page_begin = page * PAGE_SIZE;
+                    const size_t page_end = std::min(page_begin + PAGE_SIZE, size);
+                    for (const Histogram* hist : unreduced)
                     {
-                        result[i] += hist->m_bin_counts[i];
+                        const std::vector<T>& local_page = hist->m_pages[page];
+                        if (local_page.empty())
+                        {
+                            continue;
+                        }
+                        for (size_t i = page_begin; i < page_end; ++i)
+                        {
+                            m_reduced[i] += local_page[i - page_begin];
+                        }
                     }
                 }
             });
         }
 
-    protected:
         tbb::enumerable_thread_specific<Histogram<T>>
-            m_local_histograms; //!< The thread-local copies of m_histogram.
+            m_local_histograms;                    //!< The thread-local copies of m_histogram.
+        bool m_paged {false};                      //!< Whether the thread-local copies are paged.
+        std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes of the copies.
+        std::vector<std::unique_ptr<Histogram>>
+            m_chunk_histograms;   //!< Copies of the chunks of deterministic loops, created on first use.
+        std::vector<T> m_reduced; //!< Sum of the thread-local copies merged so far.
     };
 
+    //! Number of bins in each page of a paged histogram.
+    static constexpr size_t PAGE_SIZE = 1024;
+
     //! Default constructor
     Histogram() = default;
 
     //! Constructor
-    explicit Histogram(std::vector<std::shared_ptr<Axis>> axes) : m_axes(std::move(axes))
+    /*! \param axes The axes of the histogram.
+     *  \param paged Whether to store the bins in pages allocated on first use.
+     */
+    explicit Histogram(std::vector<std::shared_ptr<Axis>> axes, bool paged = false)
+        : m_axes(std::move(axes)), m_paged(paged)
     {
         std::vector<size_t> sizes(m_axes.size());
         std::transform(m_axes.begin(), m_axes.end(), sizes.begin(),
                        [](const auto& ax) { return ax->size(); });
-        m_bin_counts = ManagedArray<T>(sizes);
+        if (m_paged)
+        {
+            const size_t num_bins
+                = std::accumulate(sizes.begin(), sizes.end(), size_t(1), std::multiplies<size_t>());
+            m_pages.resize((num_bins + PAGE_SIZE - 1) / PAGE_SIZE);
+        }
+        else
+        {
+            m_bin_counts = ManagedArray<T>(sizes);
+        }
     }
 
     //! Simple convenience for 1D arrays that calls through to the shape based `prepare` function.
@@ -313,14 +744,20 @@ public:
     ~Histogram() = default;
 
     //! Bin value and update the histogram count.
+    /*! The values are gathered on the stack, so binning a value performs no
+     *  heap allocations.
+     */
     template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
     {
-        std::pair<std::vector<float>, Weight<T>> value_vector = getValueVector(values...);
-        size_t value_bin = bin(value_vector.first);
+        std::array<float, sizeof...(FloatsOrWeight)> value_array {};
+        size_t num_values = 0;
+        Weight<T> weight;
+        (storeValue(values, value_array.data(), num_values, weight), ...);
+        size_t value_bin = bin(value_array.data(), num_values);
         // Check for sentinel to avoid overflow.
         if (value_bin != Axis::OVERFLOW_BIN)
         {
-            m_bin_counts[value_bin] += value_vector.second.value;
+            binCount(value_bin) += weight.value;
         }
     }
 
@@ -330,7 +767,7 @@ public:
         // Check for sentinel to avoid overflow.
         if (value_bin != Axis::OVERFLOW_BIN)
         {
-            m_bin_counts[value_bin] += weight;
+            binCount(value_bin) += weight;
         }
     }
 
@@ -339,17 +776,28 @@ public:
      *  are then combined into a single linear index using the underlying
      *  ManagedArray.
      */
-    size_t bin(std::vector<float> values) const
+    size_t bin(const std::vector<float>& values) const
     {
-        if (values.size() != m_axes.size())
+        return bin(values.data(), values.size());
+    }
+
+    //! Find the bin of the values in an array.
+    /*! The bins along each axis are combined into the row-major linear index
+     *  of the underlying ManagedArray as they are computed.
+     *
+     *  \param values The values to bin, one per axis.
+     *  \param num_values The number of values.
+     */
+    size_t bin(const float* values, size_t num_values) const
+    {
+        if (num_values != m_axes.size())
         {
             std::ostringstream msg;
-            msg << "This Histogram is " << m_axes.size() << "-dimensional, but " << values.size()
+            msg << "This Histogram is " << m_axes.size() << "-dimensional, but " << num_values
                 << " values were provided in bin" << std::endl;
             throw std::invalid_argument(msg.str());
         }
-        // First bin the values along each axis.
-        std::vector<size_t> ax_bins;
+        size_t value_bin = 0;
         for (unsigned int ax_idx = 0; ax_idx < m_axes.size(); ++ax_idx)
         {
             size_t bin_i = m_axes[ax_idx]->bin(values[ax_idx]);
@@ -358,10 +806,9 @@ public:
             {
                 return Axis::OVERFLOW_BIN;
             }
-            ax_bins.push_back(bin_i);
+            value_bin = value_bin * m_axes[ax_idx]->size() + bin_i;
         }
-
-        return m_bin_counts.getIndex(ax_bins);
+        return value_bin;
     }
 
     //! Return the axes.
@@ -386,6 +833,10 @@ public:
     void reset()
     {
         m_bin_counts.reset();
+        for (auto& page : m_pages)
+        {
+            std::vector<T>().swap(page);
+        }
     }
 
     //! Return the edges of bins.
@@ -441,12 +892,15 @@ public:
      * ThreadLocalHistograms requires additional post-processing, such as some
      * sort of normalization per bin.
      *
-     * \param local_histograms The set of local histograms to reduce into this one.
+     * \param local_histograms The set of local histograms to reduce into this
+     *        one, which may accumulate in a different bin type.
      * \param cf The function to apply to each bin, must have signature (size_t i) {...}
      */
-    template<typename ComputeFunction>
-    void reduceOverThreadsPerBin(ThreadLocalHistogram& local_histograms, const ComputeFunction& cf)
+    template<typename LocalHistograms, typename ComputeFunction>
+    void reduceOverThreadsPerBin(LocalHistograms& local_histograms, const ComputeFunction& cf)
     {
+        FREUD_PROFILE_SCOPE("Histogram::reduceOverThreadsPerBin");
+        FREUD_PROFILE_COUNT("Histogram::reduceOverThreadsPerBin::bins", m_bin_counts.size());
         local_histograms.reduceInto(m_bin_counts);
         util::forLoopWrapper(0, m_bin_counts.size(), [&](size_t begin, size_t end) {
             for (size_t i = begin; i < end; ++i)
@@ -465,7 +919,7 @@ public:
      *
      * \param local_histograms The set of local histograms to reduce into this one.
      */
-    void reduceOverThreads(ThreadLocalHistogram& local_histograms)
+    template<typename LocalHistograms> void reduceOverThreads(LocalHistograms& local_histograms)
     {
         // Simply call the per-bin function with a nullary function.
         reduceOverThreadsPerBin(local_histograms, [](size_t i) {});
@@ -491,43 +945,35 @@ public:
 protected:
     std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes.
     ManagedArray<T> m_bin_counts;              //!< Counts for each bin
+    bool m_paged {false};                      //!< Whether the counts are stored in m_pages.
+    std::vector<std::vector<T>> m_pages;       //!< Pages of counts, empty until first used.
+    bool m_unreduced {false};                  //!< Whether a thread-local copy has counts not yet reduced.
 
-    //! The base case for type float when constructing a vector of values provided to operator().
-    /*! This function and the accompanying recursive function below employ
-     * variadic templating to accept an arbitrary set of float values and
-     * construct a vector out of them.
-     */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value) const
-    {
-        return {{value}, Weight<T>()};
-    }
-
-    //! The base case for type Weight when constructing a vector of values provided to operator().
-    /*! This function and the accompanying recursive function below employ
-     * variadic templating to accept an arbitrary set of float values and
-     * construct a vector out of them.
-     */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight) const
+    //! Get a writeable reference to the count of a linear bin, allocating its page if needed.
+    T& binCount(size_t value_bin)
     {
-        return {{}, weight};
+        if (!m_paged)
+        {
+            return m_bin_counts[value_bin];
+        }
+        std::vector<T>& page = m_pages[value_bin / PAGE_SIZE];
+        if (page.empty())
+        {
+            page.resize(PAGE_SIZE, T(0));
+        }
+        return page[value_bin % PAGE_SIZE];
     }
 
-    //! The recursive case for constructing a vector of values (see base-case function docs).
-    template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value, FloatsOrWeight... values) const
+    //! Store a float value provided to operator().
+    static void storeValue(float value, float* values, size_t& num_values, Weight<T>& /*weight*/)
     {
-        std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
-        tmp.first.insert(tmp.first.begin(), value);
-        return tmp;
+        values[num_values++] = value;
     }
 
-    //! The recursive case for constructing a vector of values (see base-case function docs).
-    template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight, FloatsOrWeight... values) const
+    //! Store a Weight provided to operator().
+    static void storeValue(Weight<T> value, float* /*values*/, size_t& /*num_values*/, Weight<T>& weight)
     {
-        std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
-        tmp.second = weight;
-        return tmp;
+        weight = value;
     }
 };
 
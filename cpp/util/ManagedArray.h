@@ -4,13 +4,21 @@
 #ifndef MANAGED_ARRAY_H
 #define MANAGED_ARRAY_H
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <vector>
 
+#include "MemoryPool.h"
+#include "tbb_config.h"
+
 /*! \file ManagedArray.h
     \brief Defines the standard array class to be used throughout freud.
 */
@@ -26,16 +34,24 @@ namespace freud { namespace util {
  *  of freud. The array shape is stored and used to support multidimensional
  *  indexing.
  *
- *  To support resizing, a ManagedArray instances stores its data as a pointer
- *  to a pointer, and its shape as a pointer. As a result, copy-assignment or
- *  initialization will result in a new ManagedArray pointing to the same data,
- *  and any such array can resize or reallocate this data. The pointer to
- *  pointer infrastructure ensures that such changes properly propagate to all
- *  ManagedArrays referencing a given memory space. In addition, this
- *  infrastructure allows the creation of a completely new ManagedArray with a
- *  new set of pointers that also manages the same data, allowing it to keep
- *  the original array alive if the original ManagedArray instances become
- *  decoupled from it.
+ *  A ManagedArray shares ownership of its data through a shared pointer. As a
+ *  result, copy-assignment or initialization will result in a new
+ *  ManagedArray pointing to the same data, which keeps the data alive if the
+ *  original ManagedArray reallocates or is destroyed. This allows the Python
+ *  API to hold the results of a compute while the compute prepares new
+ *  arrays for its next call.
+ *
+ *  The data is allocated from the MemoryPool, and returned to it once the
+ *  last ManagedArray referencing it is destroyed or reallocated. Computes that
+ *  prepare arrays of the same sizes on every call therefore reuse the buffers
+ *  of previous calls rather than allocating new memory.
+ *
+ *  Alternatively, a ManagedArray can wrap memory owned by the caller (see
+ *  wrap), in which case the data is kept alive by an owner object instead.
+ *  Preparing such an array always allocates new memory from the pool, so
+ *  computes never write into memory they do not own. Callers that want the
+ *  results of a compute written into their own memory instead provide an
+ *  output buffer with setOutput, which prepare uses in place of new memory.
  *
  *  Performance notes:
  *      1. The variadic indexers may be a bottleneck if used in
@@ -89,17 +105,26 @@ public:
      */
     void prepare(const std::vector<size_t>& new_shape, bool force = false)
     {
-        // If we resized, or if there are outstanding references, we create a new array. No matter what,
-        // reset.
-        if (force || (m_data.use_count() > 1) || (new_shape != shape()))
+        const size_t new_size
+            = std::accumulate(new_shape.cbegin(), new_shape.cend(), size_t(1), std::multiplies<>());
+        // Write into the output buffer of the caller if it fits. Otherwise, if we resized, or if there are
+        // outstanding references, we create a new array. No matter what, reset.
+        if (m_output.data && (new_size == m_output.size))
         {
-            m_shape = std::make_shared<std::vector<size_t>>(new_shape);
+            m_shape = new_shape;
+            m_size = new_size;
+            m_data = m_output.data;
+            m_borrowed = true;
+        }
+        else if (force || m_borrowed || (m_data.use_count() > 1) || (new_shape != m_shape))
+        {
+            m_shape = new_shape;
+            m_borrowed = false;
+            m_size = new_size;
 
-            m_size = std::make_shared<size_t>(1);
-            for (unsigned int i = m_shape->size() - 1; i != static_cast<unsigned int>(-1); --i)
-            {
-                (*m_size) *= (*m_shape)[i];
-            }
+            // Release the current data first, so that the pool can hand the
+            // same buffer back if no other array references it.
+            m_data.reset();
 
             // We make use of C-style arrays here rather than any alternative
             // because we need the underlying data representation to be
@@ -107,29 +132,137 @@ public:
             // with a different data structure like std::vector, but it would
             // require writing additional gymnastics to ensure proper reference
             // management and should be carefully considered before any rewrite.
-            m_data = std::shared_ptr<std::shared_ptr<T>>(new std::shared_ptr<T>(
-                new T[size()], std::default_delete<T[]>())); // NOLINT(modernize-avoid-c-arrays)
+            const size_t bytes = sizeof(T) * m_size;
+            T* data = static_cast<T*>(MemoryPool::get().allocate(bytes));
+            if constexpr (!std::is_trivially_default_constructible_v<T>)
+            {
+                std::uninitialized_default_construct_n(data, m_size);
+            }
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "ManagedArray elements are released without calling destructors.");
+            m_data = std::shared_ptr<T>(data, [bytes](T* ptr) { MemoryPool::get().deallocate(ptr, bytes); });
         }
         reset();
     }
 
+    //! Wrap memory owned by the caller without copying it.
+    /*! The returned array and all ManagedArrays copied from it share
+     *  ownership of the owner object, which must keep the data alive until it
+     *  is destroyed. The data must not be resized or freed by its owner in the
+     *  meantime.
+     *
+     *  \param data Pointer to the data to wrap.
+     *  \param shape Shape of the data.
+     *  \param owner Object keeping the data alive, see makeExternalOwner.
+     */
+    static ManagedArray wrap(T* data, const std::vector<size_t>& shape, const std::shared_ptr<void>& owner)
+    {
+        ManagedArray array(std::vector<size_t> {0});
+        array.m_shape = shape;
+        array.m_size = std::accumulate(shape.cbegin(), shape.cend(), size_t(1), std::multiplies<>());
+        array.m_data = std::shared_ptr<T>(owner, data);
+        array.m_borrowed = true;
+        return array;
+    }
+
+    //! Use memory owned by the caller as the data of subsequent preparations.
+    /*! Every later call to prepare with a shape of size elements resets and
+     *  uses this buffer instead of allocating new memory, so that the results
+     *  of a compute are written straight into the memory of the caller. Other
+     *  shapes are allocated as usual. The buffer is not shared with copies of
+     *  this array and is used until clearOutput is called.
+     *
+     *  \param data Pointer to the buffer.
+     *  \param size Number of elements of the buffer.
+     *  \param owner Object keeping the buffer alive, see makeExternalOwner.
+     */
+    void setOutput(T* data, size_t size, const std::shared_ptr<void>& owner)
+    {
+        m_output.data = std::shared_ptr<T>(owner, data);
+        m_output.size = size;
+    }
+
+    //! Stop using the buffer of setOutput for subsequent preparations.
+    /*! The array keeps referencing the buffer until it is prepared again.
+     */
+    void clearOutput()
+    {
+        m_output = OutputBuffer();
+    }
+
+    //! Whether this array wraps memory owned by the caller.
+    bool isBorrowed() const
+    {
+        return m_borrowed;
+    }
+
+    //! Whether this array owns its data and no other ManagedArray references it.
+    /*! Only such arrays may be modified in place without changing data that
+     *  other arrays, like the NumPy arrays of the Python API, point to.
+     */
+    bool isUnique() const
+    {
+        return !m_borrowed && (m_data.use_count() == 1);
+    }
+
+    //! Reduce the shape of the array, keeping its data.
+    /*! The array keeps the first elements of its data, and its memory is
+     *  neither reallocated nor cleared. The memory of the removed elements
+     *  is only released with the rest of the data.
+     *
+     *  \param new_shape Shape of the array, with at most as many elements as the current shape.
+     */
+    void truncate(const std::vector<size_t>& new_shape)
+    {
+        const size_t new_size
+            = std::accumulate(new_shape.cbegin(), new_shape.cend(), size_t(1), std::multiplies<>());
+        if (new_size > m_size)
+        {
+            throw std::invalid_argument("ManagedArray::truncate cannot increase the size of an array.");
+        }
+        m_shape = new_shape;
+        m_size = new_size;
+    }
+
     //! Reset the contents of array to be 0.
+    /*! Large arrays are zeroed in parallel in blocks of huge pages. A freshly
+     *  allocated page is placed in the memory of the NUMA node of the thread
+     *  that first touches it, so this spreads the array across the nodes that
+     *  the threads of the subsequent computation run on, rather than placing
+     *  all of it on the node of the calling thread.
+     */
     void reset()
     {
-        if (size() != 0)
+        const size_t bytes = sizeof(T) * size();
+        if (bytes < PARALLEL_RESET_BYTES)
         {
-            memset((void*) get(), 0, sizeof(T) * size());
+            if (bytes != 0)
+            {
+                memset((void*) get(), 0, bytes);
+            }
+            return;
         }
+        char* data = reinterpret_cast<char*>(get());
+        const size_t num_blocks = (bytes + MemoryPool::HUGE_PAGE_SIZE - 1) / MemoryPool::HUGE_PAGE_SIZE;
+        parallel::execute([&]() {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, num_blocks),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    const size_t begin = r.begin() * MemoryPool::HUGE_PAGE_SIZE;
+                    const size_t end = std::min(r.end() * MemoryPool::HUGE_PAGE_SIZE, bytes);
+                    memset(data + begin, 0, end - begin);
+                },
+                tbb::static_partitioner());
+        });
     }
 
-    //! Return a constant pointer to the underlying data (requires two levels of indirection).
+    //! Return a constant pointer to the underlying data.
     const T* get() const
     {
-        std::shared_ptr<T>* tmp = m_data.get();
-        return (*tmp).get();
+        return m_data.get();
     }
 
-    //! Return the underlying pointer (requires two levels of indirection).
+    //! Return the underlying pointer.
     /*! This function should only be used by client code when a raw pointer is
      * absolutely required. It is primarily part of the public API for the
      * purpose of freud's Python API, which requires a non-const pointer to the
@@ -141,8 +274,7 @@ public:
      */
     T* get()
     {
-        std::shared_ptr<T>* tmp = m_data.get();
-        return (*tmp).get();
+        return m_data.get();
     }
 
     //! Writeable index into array.
@@ -172,13 +304,13 @@ public:
     //! Get the size of the current array.
     size_t size() const
     {
-        return *m_size;
+        return m_size;
     }
 
     //! Get the shape of the current array.
     std::vector<size_t> shape() const
     {
-        return *m_shape;
+        return m_shape;
     }
 
     //*************************************************************************
@@ -236,7 +368,7 @@ public:
         for (unsigned int i = indices.size() - 1; i != static_cast<unsigned int>(-1); --i)
         {
             idx += indices[i] * cur_prod;
-            cur_prod *= (*m_shape)[i];
+            cur_prod *= m_shape[i];
         }
         return (*this)[idx];
     }
@@ -252,7 +384,7 @@ public:
         for (unsigned int i = indices.size() - 1; i != static_cast<unsigned int>(-1); --i)
         {
             idx += indices[i] * cur_prod;
-            cur_prod *= (*m_shape)[i];
+            cur_prod *= m_shape[i];
         }
         return (*this)[idx];
     }
@@ -311,23 +443,23 @@ public:
      */
     inline size_t getIndex(const std::vector<size_t>& indices) const
     {
-        if (indices.size() != m_shape->size())
+        if (indices.size() != m_shape.size())
         {
             throw std::invalid_argument("Incorrect number of indices for this array.");
         }
 
         for (unsigned int i = 0; i < indices.size(); ++i)
         {
-            if (indices[i] > (*m_shape)[i])
+            if (indices[i] > m_shape[i])
             {
                 std::ostringstream msg;
                 msg << "Attempted to access index " << indices[i] << " in dimension " << i
-                    << ", which has size " << (*m_shape)[i] << std::endl;
+                    << ", which has size " << m_shape[i] << std::endl;
                 throw std::invalid_argument(msg.str());
             }
         }
 
-        return getIndex(*m_shape, indices);
+        return getIndex(m_shape, indices);
     }
 
     //! Return a copy of this array.
@@ -369,11 +501,49 @@ private:
         return tmp;
     }
 
-    std::shared_ptr<std::shared_ptr<T>> m_data;   //!< Pointer to array.
-    std::shared_ptr<std::vector<size_t>> m_shape; //!< Shape of array.
-    std::shared_ptr<size_t> m_size;               //!< Size of array.
+    //! Size in bytes above which arrays are zeroed in parallel.
+    static constexpr size_t PARALLEL_RESET_BYTES = 4 * MemoryPool::HUGE_PAGE_SIZE;
+
+    //! Output buffer of the caller, which copies of an array do not inherit.
+    struct OutputBuffer
+    {
+        OutputBuffer() = default;
+        OutputBuffer(const OutputBuffer& /*other*/) {}
+        OutputBuffer& operator=(const OutputBuffer& /*other*/)
+        {
+            return *this;
+        }
+        OutputBuffer& operator=(OutputBuffer&& other) noexcept
+        {
+            data = std::move(other.data);
+            size = other.size;
+            return *this;
+        }
+
+        std::shared_ptr<T> data; //!< Pointer to the buffer.
+        size_t size {0};         //!< Number of elements of the buffer.
+    };
+
+    std::shared_ptr<T> m_data;   //!< Pointer to array.
+    std::vector<size_t> m_shape; //!< Shape of array.
+    size_t m_size {0};           //!< Size of array.
+    bool m_borrowed {false};     //!< Whether the data is owned by the caller.
+    OutputBuffer m_output;       //!< Buffer that prepare writes into, see setOutput.
 };
 
+//! Make an owner object for ManagedArray::wrap.
+/*! The owner calls release(handle) once no ManagedArray references the
+ *  wrapped data anymore. This allows callers that cannot construct shared
+ *  pointers, such as the Python API, to release their reference to the data.
+ *
+ *  \param release Function releasing the data.
+ *  \param handle Argument passed to release.
+ */
+inline std::shared_ptr<void> makeExternalOwner(void (*release)(void*), void* handle)
+{
+    return std::shared_ptr<void>(handle, release);
+}
+
 }; }; // end namespace freud::util
 
 #endif
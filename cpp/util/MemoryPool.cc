@@ -0,0 +1,133 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "MemoryPool.h"
+
+/*! \file MemoryPool.cc
+    \brief Pool of reusable buffers backing ManagedArray.
+*/
+
+namespace freud { namespace util {
+
+MemoryPool& MemoryPool::get()
+{
+    // The pool is never destroyed, because arrays held by Python may be
+    // released after static destructors have run at interpreter exit.
+    static auto* pool = new MemoryPool();
+    return *pool;
+}
+
+void* MemoryPool::allocate(size_t bytes)
+{
+    const size_t size_class = sizeClass(bytes);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto free_list = m_free_lists.find(size_class);
+        if (free_list != m_free_lists.end() && !free_list->second.empty())
+        {
+            void* ptr = free_list->second.back();
+            free_list->second.pop_back();
+            m_cached_bytes -= size_class;
+            return ptr;
+        }
+    }
+    return allocateSystem(size_class);
+}
+
+void MemoryPool::deallocate(void* ptr, size_t bytes)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    const size_t size_class = sizeClass(bytes);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cached_bytes + size_class <= m_capacity)
+        {
+            m_free_lists[size_class].push_back(ptr);
+            m_cached_bytes += size_class;
+            return;
+        }
+    }
+    deallocateSystem(ptr, size_class);
+}
+
+void MemoryPool::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    trim(capacity);
+}
+
+size_t MemoryPool::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+size_t MemoryPool::getCachedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cached_bytes;
+}
+
+void MemoryPool::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    trim(0);
+}
+
+size_t MemoryPool::sizeClass(size_t bytes)
+{
+    if (bytes >= HUGE_PAGE_SIZE)
+    {
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+    size_t size_class = ALIGNMENT;
+    while (size_class < bytes)
+    {
+        size_class *= 2;
+    }
+    return size_class;
+}
+
+void* MemoryPool::allocateSystem(size_t size_class)
+{
+    if (size_class < HUGE_PAGE_SIZE)
+    {
+        return ::operator new(size_class, std::align_val_t(ALIGNMENT));
+    }
+    void* ptr = ::operator new(size_class, std::align_val_t(HUGE_PAGE_SIZE));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // This is only advice, so failure (e.g. if transparent huge pages are disabled) is harmless.
+    madvise(ptr, size_class, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void MemoryPool::deallocateSystem(void* ptr, size_t size_class)
+{
+    ::operator delete(ptr, std::align_val_t(size_class < HUGE_PAGE_SIZE ? ALIGNMENT : HUGE_PAGE_SIZE));
+}
+
+void MemoryPool::trim(size_t capacity)
+{
+    for (auto free_list = m_free_lists.rbegin(); free_list != m_free_lists.rend(); ++free_list)
+    {
+        std::vector<void*>& buffers = free_list->second;
+        while (m_cached_bytes > capacity && !buffers.empty())
+        {
+            deallocateSystem(buffers.back(), free_list->first);
+            buffers.pop_back();
+            m_cached_bytes -= free_list->first;
+        }
+    }
+}
+
+}; }; // end namespace freud::util
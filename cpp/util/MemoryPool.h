@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/*! \file MemoryPool.h
+    \brief Pool of reusable buffers backing ManagedArray.
+*/
+
+namespace freud { namespace util {
+
+//! Cache of freed buffers, sorted into size classes for reuse.
+/*! Computes typically prepare output arrays of the same sizes on every call,
+ *  so the buffer released by one call can serve the next one. Released buffers
+ *  are kept on a free list per size class until the total size of the cached
+ *  buffers exceeds the capacity of the pool, in which case they are returned
+ *  to the system. Reusing a buffer also avoids the page faults of touching
+ *  freshly mapped memory.
+ *
+ *  Requested sizes are rounded up to a power of two, and buffers of at least
+ *  HUGE_PAGE_SIZE bytes to a multiple of HUGE_PAGE_SIZE. A buffer may thus be
+ *  almost twice as large as requested. Such large buffers
+ *  are aligned to huge pages, and on Linux the kernel is advised to back them
+ *  with transparent huge pages.
+ *
+ *  All functions are thread safe, since buffers may be released on any thread
+ *  (e.g. when Python garbage collects a NumPy array viewing one).
+ */
+class MemoryPool
+{
+public:
+    //! Alignment of all buffers, which is sufficient for SIMD loads.
+    static constexpr size_t ALIGNMENT = 64;
+
+    //! Size above which buffers are aligned to and rounded to huge pages.
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    //! Default capacity of the pool in bytes.
+    static constexpr size_t DEFAULT_CAPACITY = size_t(256) << 20;
+
+    //! Get the pool shared by all ManagedArrays.
+    static MemoryPool& get();
+
+    //! Get a buffer of at least the given number of bytes.
+    /*! The contents of the buffer are undefined.
+     */
+    void* allocate(size_t bytes);
+
+    //! Return a buffer obtained from allocate with the same number of bytes.
+    void deallocate(void* ptr, size_t bytes);
+
+    //! Set the total number of bytes of cached buffers, releasing cached buffers beyond it.
+    void setCapacity(size_t capacity);
+
+    //! Get the total number of bytes of cached buffers allowed.
+    size_t getCapacity() const;
+
+    //! Get the total number of bytes of cached buffers.
+    size_t getCachedBytes() const;
+
+    //! Return all cached buffers to the system.
+    void release();
+
+private:
+    //! Constructor, private so that the pool is only accessed through get().
+    MemoryPool() = default;
+
+    //! Get the size class of a request of the given number of bytes.
+    static size_t sizeClass(size_t bytes);
+
+    //! Allocate a new buffer of a size class from the system.
+    static void* allocateSystem(size_t size_class);
+
+    //! Return a buffer of a size class to the system.
+    static void deallocateSystem(void* ptr, size_t size_class);
+
+    //! Release cached buffers, starting from the largest, until at most capacity bytes are cached.
+    /*! The mutex must be held by the caller.
+     */
+    void trim(size_t capacity);
+
+    mutable std::mutex m_mutex;                           //!< Guards the free lists.
+    std::map<size_t, std::vector<void*>> m_free_lists;    //!< Cached buffers of each size class.
+    size_t m_cached_bytes {0};                            //!< Total size of the cached buffers.
+    size_t m_capacity {DEFAULT_CAPACITY};                 //!< Maximum total size of the cached buffers.
+};
+
+}; }; // end namespace freud::util
+
+#endif // MEMORY_POOL_H
@@ -0,0 +1,235 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MULTIPLE_TAU_CORRELATOR_H
+#define MULTIPLE_TAU_CORRELATOR_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "utils.h"
+
+/*! \file MultipleTauCorrelator.h
+    \brief Accumulates time correlations of a trajectory at logarithmically spaced lags.
+*/
+
+namespace freud { namespace util {
+
+//! Accumulates a time correlation of a trajectory with a multiple-tau correlator.
+/*! Frames of frame_size elements of type T are added one at a time. The
+ *  correlator keeps a hierarchy of levels of points_per_level frames each.
+ *  Level 0 holds the most recent frames, and every level_factor-th frame of a
+ *  level is also added to the next level, so level l holds frames
+ *  level_factor^l apart. The correlation between each new frame of a level
+ *  and the frames held in it is accumulated for the lags j level_factor^l
+ *  that are not already covered by the lower levels (Ramirez et al. 2010).
+ *  This gives logarithmically spaced lags up to the length of the trajectory
+ *  with memory proportional to the number of levels.
+ *
+ *  The correlations are computed exactly from the stored frames by a
+ *  callable correlate(frame, origin) returning a double, but at level l only
+ *  time origins that are multiples of level_factor^l are averaged over. The
+ *  lags of a level are correlated in parallel, so the callable must be safe
+ *  to call concurrently. A correlator of num_values values per lag (e.g. one
+ *  per wave vector bin) instead takes a callable correlate(frame, origin,
+ *  values) adding the correlations to the num_values doubles at values.
+ */
+template<typename T> class MultipleTauCorrelator
+{
+public:
+    //! Constructor
+    /*! \param points_per_level Number of frames held in each level.
+     *  \param level_factor Ratio of the frame spacings of consecutive levels.
+     *  \param num_values Number of correlation values accumulated for each lag.
+     */
+    MultipleTauCorrelator(unsigned int points_per_level, unsigned int level_factor,
+                          unsigned int num_values = 1)
+        : m_points_per_level(points_per_level), m_level_factor(level_factor), m_num_values(num_values)
+    {
+        if (level_factor < 2)
+        {
+            throw std::invalid_argument(
+                "The multiple-tau correlator requires level_factor to be at least 2.");
+        }
+        if (points_per_level <= level_factor)
+        {
+            throw std::invalid_argument(
+                "The multiple-tau correlator requires points_per_level to be greater than level_factor.");
+        }
+    }
+
+    //! Reset the accumulated correlations and stored frames.
+    void reset()
+    {
+        m_frame_size = 0;
+        m_frames.clear();
+        m_level_frames.clear();
+        m_sums.clear();
+        m_pair_counts.clear();
+    }
+
+    unsigned int getPointsPerLevel() const
+    {
+        return m_points_per_level;
+    }
+
+    unsigned int getLevelFactor() const
+    {
+        return m_level_factor;
+    }
+
+    //! Get the number of correlation values accumulated for each lag.
+    unsigned int getNumValues() const
+    {
+        return m_num_values;
+    }
+
+    //! Get the number of frames added since the last reset.
+    unsigned int getNumFrames() const
+    {
+        return m_level_frames.empty() ? 0 : m_level_frames[0];
+    }
+
+    //! Get the number of elements of each frame, which is set by the first frame.
+    size_t getFrameSize() const
+    {
+        return m_frame_size;
+    }
+
+    //! Add the next frame of the trajectory.
+    /*! \param frame Elements of this frame.
+     *  \param frame_size Number of elements, which must not change between frames.
+     *  \param correlate Callable returning the correlation of a frame with an earlier origin frame.
+     */
+    template<typename Correlate> void update(const T* frame, size_t frame_size, const Correlate& correlate)
+    {
+        updateValues(frame, frame_size, [&correlate](const T* new_frame, const T* origin, double* values) {
+            *values += correlate(new_frame, origin);
+        });
+    }
+
+    //! Add the next frame of the trajectory, accumulating num_values correlations per lag.
+    /*! \param frame Elements of this frame.
+     *  \param frame_size Number of elements, which must not change between frames.
+     *  \param correlate Callable adding the correlations of a frame with an earlier origin frame to an
+     *         array of num_values doubles.
+     */
+    template<typename Correlate>
+    void updateValues(const T* frame, size_t frame_size, const Correlate& correlate)
+    {
+        if (getNumFrames() == 0)
+        {
+            m_frame_size = frame_size;
+        }
+        else if (frame_size != m_frame_size)
+        {
+            throw std::invalid_argument("The multiple-tau correlator requires frames of the same size.");
+        }
+        addFrame(0, frame, correlate);
+    }
+
+    //! Collect the mean correlation and number of pairs of each lag with accumulated pairs.
+    /*! \param lags Output lags, in frames, in increasing order.
+     *  \param means Output correlations averaged over the pairs of each lag, num_values per lag.
+     *  \param counts Output number of pairs of frames of each lag.
+     */
+    void reduce(std::vector<unsigned int>& lags, std::vector<double>& means,
+                std::vector<unsigned int>& counts) const
+    {
+        lags.clear();
+        means.clear();
+        counts.clear();
+        const unsigned int num_points = m_points_per_level;
+        unsigned int spacing = 1;
+        for (unsigned int level = 0; level < m_frames.size(); ++level)
+        {
+            for (unsigned int j = getMinLagIndex(level); j < num_points; ++j)
+            {
+                const unsigned int pair_count = m_pair_counts[level * num_points + j];
+                if (pair_count > 0)
+                {
+                    lags.push_back(j * spacing);
+                    const size_t first_value = (static_cast<size_t>(level) * num_points + j) * m_num_values;
+                    for (size_t v = first_value; v < first_value + m_num_values; ++v)
+                    {
+                        means.push_back(m_sums[v] / pair_count);
+                    }
+                    counts.push_back(pair_count);
+                }
+            }
+            spacing *= m_level_factor;
+        }
+    }
+
+private:
+    //! Get the first lag index correlated in a level.
+    /*! Above level 0, the shortest lags are covered by the level below at a
+     *  finer spacing.
+     */
+    unsigned int getMinLagIndex(unsigned int level) const
+    {
+        return (level == 0) ? 0 : (m_points_per_level - 1) / m_level_factor + 1;
+    }
+
+    //! Add a frame to a level, creating the level if needed.
+    template<typename Correlate> void addFrame(unsigned int level, const T* frame, const Correlate& correlate)
+    {
+        const unsigned int num_points = m_points_per_level;
+        const size_t frame_size = m_frame_size;
+        if (level == m_frames.size())
+        {
+            m_frames.emplace_back(num_points * frame_size);
+            m_level_frames.push_back(0);
+            m_sums.resize(m_sums.size() + static_cast<size_t>(num_points) * m_num_values, 0);
+            m_pair_counts.resize(m_pair_counts.size() + num_points, 0);
+        }
+        const unsigned int k = m_level_frames[level];
+
+        // Store the new frame first so that lag 0 correlates it with itself.
+        T* frames = m_frames[level].data();
+        std::copy(frame, frame + frame_size, frames + (k % num_points) * frame_size);
+        const T* new_frame = frames + (k % num_points) * frame_size;
+
+        const unsigned int j_min = getMinLagIndex(level);
+        const unsigned int j_max = std::min(k, num_points - 1);
+        if (frame_size != 0 && j_min <= j_max)
+        {
+            forLoopWrapper(j_min, j_max + 1, [&](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j)
+                {
+                    const T* origin = frames + ((k + num_points - j) % num_points) * frame_size;
+                    correlate(new_frame, origin,
+                              m_sums.data() + (static_cast<size_t>(level) * num_points + j) * m_num_values);
+                    ++m_pair_counts[level * num_points + j];
+                }
+            });
+        }
+        ++m_level_frames[level];
+
+        // Every level_factor-th frame is also added to the next level.
+        if (k > 0 && k % m_level_factor == 0)
+        {
+            if (level + 1 == m_frames.size())
+            {
+                // The next level starts from the first frame of this level,
+                // which is still held since level_factor < points_per_level.
+                addFrame(level + 1, m_frames[level].data(), correlate);
+            }
+            addFrame(level + 1, m_frames[level].data() + (k % num_points) * frame_size, correlate);
+        }
+    }
+
+    unsigned int m_points_per_level;          //!< Number of frames held in each level.
+    unsigned int m_level_factor;              //!< Ratio of the frame spacings of consecutive levels.
+    unsigned int m_num_values;                //!< Number of correlation values of each lag.
+    size_t m_frame_size {0};                  //!< Number of elements of each frame.
+    std::vector<std::vector<T>> m_frames;     //!< Circular buffers of the frames held in each level.
+    std::vector<unsigned int> m_level_frames; //!< Number of frames added to each level.
+    std::vector<double> m_sums;               //!< Sums of the correlations of each level and lag index.
+    std::vector<unsigned int> m_pair_counts;  //!< Number of pairs of each level and lag index.
+};
+
+}; }; // end namespace freud::util
+
+#endif // MULTIPLE_TAU_CORRELATOR_H
@@ -0,0 +1,57 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <atomic>
+
+#include "Profiler.h"
+
+/*! \file Profiler.cc
+    \brief Scoped timers and counters recording where computes spend their time.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+//! Number of unmatched calls to enableProfiling.
+std::atomic<int> profiling_scopes {0};
+
+//! Timers and counters of the current thread.
+thread_local Profile thread_profile;
+} // namespace
+
+void enableProfiling()
+{
+    profiling_scopes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void disableProfiling()
+{
+    profiling_scopes.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool isProfiling()
+{
+    return profiling_scopes.load(std::memory_order_relaxed) > 0;
+}
+
+const Profile& getProfile()
+{
+    return thread_profile;
+}
+
+void addProfileCount(const char* name, long long value)
+{
+    if (isProfiling())
+    {
+        thread_profile.counters[name] += value;
+    }
+}
+
+void ScopedTimer::record(double seconds) const
+{
+    ProfileTimer& timer = thread_profile.timers[m_name];
+    timer.seconds += seconds;
+    ++timer.calls;
+}
+
+}; }; // end namespace freud::util
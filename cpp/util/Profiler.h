@@ -0,0 +1,112 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <map>
+#include <string>
+
+/*! \file Profiler.h
+    \brief Scoped timers and counters recording where computes spend their time.
+*/
+
+namespace freud { namespace util {
+
+//! Total time spent in a section of code and the number of times it was entered.
+struct ProfileTimer
+{
+    double seconds {0};           //!< Total time spent in the section.
+    unsigned long long calls {0}; //!< Number of times the section was entered.
+};
+
+//! Timers and counters recorded on a thread, by name.
+struct Profile
+{
+    std::map<std::string, ProfileTimer> timers; //!< Timers of the sections of code entered.
+    std::map<std::string, long long> counters;  //!< Counters of the amounts of work done.
+};
+
+//! Start recording timers and counters on all threads.
+/*! Recording stays enabled until every call to enableProfiling is matched by
+    a call to disableProfiling, so that profiling can be enabled by several
+    independent scopes at once.
+*/
+void enableProfiling();
+
+//! Stop recording timers and counters, undoing one call to enableProfiling.
+void disableProfiling();
+
+//! Whether timers and counters are being recorded.
+bool isProfiling();
+
+//! Get the timers and counters recorded on the current thread.
+/*! Timers and counters are accumulated over the lifetime of the thread, so
+    the work done by a computation is the difference between the profiles
+    before and after it.
+*/
+const Profile& getProfile();
+
+//! Add a value to a counter of the current thread, if profiling is enabled.
+void addProfileCount(const char* name, long long value);
+
+//! Timer adding the time spent in its scope to a timer of the current thread.
+/*! Timers are only recorded on the thread that creates them, so they should
+    enclose whole parallel loops rather than be created inside them. Nested
+    timers are recorded independently, so the time of an enclosing section
+    includes the time of the sections it contains.
+*/
+class ScopedTimer
+{
+public:
+    //! Start the timer if profiling is enabled.
+    /*! \param name Name of the timer, which must outlive the scope.
+     */
+    explicit ScopedTimer(const char* name) : m_name(isProfiling() ? name : nullptr)
+    {
+        if (m_name != nullptr)
+        {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    //! Stop the timer and record the time spent in the scope.
+    ~ScopedTimer()
+    {
+        if (m_name != nullptr)
+        {
+            record(std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count());
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    //! Add the time spent in the scope to the timer of the current thread.
+    void record(double seconds) const;
+
+    const char* m_name;                               //!< Name of the timer, or NULL if not recording.
+    std::chrono::steady_clock::time_point m_start {}; //!< Time at which the scope was entered.
+};
+
+}; }; // end namespace freud::util
+
+// The instrumentation of computes is compiled only if FREUD_PROFILING is
+// defined, so that builds without it do not even check whether profiling is
+// enabled.
+#ifdef FREUD_PROFILING
+#define FREUD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FREUD_PROFILE_CONCAT(a, b) FREUD_PROFILE_CONCAT_IMPL(a, b)
+//! Time the rest of the enclosing scope.
+#define FREUD_PROFILE_SCOPE(name) \
+    const ::freud::util::ScopedTimer FREUD_PROFILE_CONCAT(freud_profile_timer_, __LINE__)(name)
+//! Add a value to a counter.
+#define FREUD_PROFILE_COUNT(name, value) ::freud::util::addProfileCount(name, static_cast<long long>(value))
+#else
+#define FREUD_PROFILE_SCOPE(name) static_cast<void>(0)
+#define FREUD_PROFILE_COUNT(name, value) static_cast<void>(0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,145 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "tbb_config.h"
+#include "utils.h"
+
+/*! \file RadixSort.h
+    \brief Parallel least significant digit radix sort of unsigned integer keys.
+*/
+
+namespace freud { namespace util {
+
+namespace detail {
+
+//! Number of bits sorted by each pass of radixSortByKey.
+constexpr unsigned int RADIX_BITS = 8;
+
+//! Number of buckets of each pass of radixSortByKey.
+constexpr size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+
+//! Smallest number of keys per block of a pass of radixSortByKey.
+constexpr size_t RADIX_MIN_BLOCK_SIZE = 16384;
+
+//! Number of blocks per thread in each pass of radixSortByKey.
+constexpr size_t RADIX_BLOCKS_PER_THREAD = 4;
+
+} // namespace detail
+
+//! Map a float to an unsigned integer with the same ordering.
+/*! The sign bit of non-negative floats is set, and all bits of negative
+ *  floats are flipped, so the unsigned integers compare as the floats do
+ *  (with -0 ordered before +0).
+ */
+inline uint32_t orderedFloatBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000U) != 0 ? ~bits : (bits | 0x80000000U);
+}
+
+//! Stably sort unsigned integer keys, applying the same permutation to values.
+/*! This is a least significant digit radix sort with 8-bit digits. Each pass
+ *  counts the digits of blocks of keys in parallel, scans the counts into
+ *  the offset of each block in each bucket, and scatters the blocks in
+ *  parallel. Passes over digits that are equal for all keys are skipped, so
+ *  keys whose range is much smaller than the key type (e.g. particle indices)
+ *  take fewer passes, and keys that are already sorted are not moved.
+ *
+ *  Sorting with a secondary key first and then with a primary key sorts by
+ *  both, since each sort is stable.
+ *
+ *  \param keys The keys to sort.
+ *  \param values Values permuted with the keys, usually the indices of the
+ *         sorted elements. Must have the same size as keys.
+ */
+template<typename Key, typename Value> void radixSortByKey(std::vector<Key>& keys, std::vector<Value>& values)
+{
+    static_assert(std::is_unsigned<Key>::value, "radixSortByKey sorts unsigned integer keys.");
+    const size_t num_keys = keys.size();
+    if (std::is_sorted(keys.begin(), keys.end()))
+    {
+        return;
+    }
+
+    const size_t num_blocks = std::max<size_t>(
+        1,
+        std::min<size_t>(num_keys / detail::RADIX_MIN_BLOCK_SIZE,
+                         detail::RADIX_BLOCKS_PER_THREAD * std::max(parallel::maxConcurrency(), 1)));
+    const size_t block_size = (num_keys + num_blocks - 1) / num_blocks;
+    std::vector<std::array<size_t, detail::RADIX_BUCKETS>> offsets(num_blocks);
+    std::vector<Key> sorted_keys(num_keys);
+    std::vector<Value> sorted_values(num_keys);
+
+    for (unsigned int shift = 0; shift < 8 * sizeof(Key); shift += detail::RADIX_BITS)
+    {
+        const auto digit = [shift](Key key) {
+            return static_cast<size_t>((key >> shift) & (detail::RADIX_BUCKETS - 1));
+        };
+
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                auto& counts = offsets[block];
+                counts.fill(0);
+                const size_t block_end = std::min((block + 1) * block_size, num_keys);
+                for (size_t i = block * block_size; i < block_end; ++i)
+                {
+                    ++counts[digit(keys[i])];
+                }
+            }
+        });
+
+        // Each bucket holds the keys of all blocks in order, so the offset of
+        // a block in a bucket follows the keys of that bucket in the previous
+        // blocks.
+        size_t total = 0;
+        bool constant_digit = false;
+        for (size_t bucket = 0; bucket < detail::RADIX_BUCKETS; ++bucket)
+        {
+            size_t bucket_count = 0;
+            for (auto& counts : offsets)
+            {
+                const size_t count = counts[bucket];
+                counts[bucket] = total + bucket_count;
+                bucket_count += count;
+            }
+            constant_digit = constant_digit || bucket_count == num_keys;
+            total += bucket_count;
+        }
+        if (constant_digit)
+        {
+            continue;
+        }
+
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                auto& cursors = offsets[block];
+                const size_t block_end = std::min((block + 1) * block_size, num_keys);
+                for (size_t i = block * block_size; i < block_end; ++i)
+                {
+                    const size_t destination = cursors[digit(keys[i])]++;
+                    sorted_keys[destination] = keys[i];
+                    sorted_values[destination] = values[i];
+                }
+            }
+        });
+        keys.swap(sorted_keys);
+        values.swap(sorted_values);
+    }
+}
+
+}; }; // end namespace freud::util
+
+#endif // RADIX_SORT_H
@@ -6,20 +6,29 @@
 
 #include "ManagedArray.h"
 #include "utils.h"
+#include <memory>
 #include <tbb/enumerable_thread_specific.h>
+#include <type_traits>
 #include <vector>
 
 namespace freud { namespace util {
 
 //! Wrapper class for enumerable_thread_specific<T*>
 /*! It is expected that default value for T is 0.
+ *
+ *  When reductions are deterministic (see parallel::DeterministicChunk),
+ *  floating point arrays are accumulated per chunk of the parallel loops
+ *  rather than per thread, and reduceInto combines the chunks pairwise in
+ *  a fixed order. Integer sums are exact, so integer arrays always stay
+ *  thread local.
  */
 template<typename T> class ThreadStorage
 {
 public:
     //! Default constructor
     ThreadStorage()
-        : arrays(tbb::enumerable_thread_specific<ManagedArray<T>>([]() { return ManagedArray<T>(); }))
+        : arrays(tbb::enumerable_thread_specific<ManagedArray<T>>([]() { return ManagedArray<T>(); })),
+          chunk_arrays(parallel::DETERMINISTIC_NUM_CHUNKS)
     {}
 
     //! Constructor with specific size for thread local arrays
@@ -32,12 +41,18 @@ public:
      */
     explicit ThreadStorage(const std::vector<size_t>& shape)
         : arrays(
-              tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); }))
+            tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); })),
+          chunk_arrays(parallel::DETERMINISTIC_NUM_CHUNKS), shape(shape)
     {}
 
     //! Destructor
     ~ThreadStorage() = default;
 
+    ThreadStorage(const ThreadStorage&) = delete;
+    ThreadStorage& operator=(const ThreadStorage&) = delete;
+    ThreadStorage(ThreadStorage&&) = default;
+    ThreadStorage& operator=(ThreadStorage&&) = default;
+
     //! Update size of the thread local arrays
     /*! \param size New size of the thread local arrays
      */
@@ -53,15 +68,20 @@ public:
     {
         arrays
             = tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); });
+        releaseChunkArrays();
+        this->shape = shape;
     }
 
     //! Reset the contents of thread local arrays to be 0
+    /*! The thread local arrays are released rather than zeroed, and are
+     *  recreated (as zeros) the next time a thread accesses its local array,
+     *  so threads that do not take part in the next computation are not
+     *  included in the reduction.
+     */
     void reset()
     {
-        for (auto array = arrays.begin(); array != arrays.end(); ++array)
-        {
-            array->reset();
-        }
+        arrays.clear();
+        releaseChunkArrays();
     }
 
     using const_iterator = typename tbb::enumerable_thread_specific<ManagedArray<T>>::const_iterator;
@@ -88,14 +108,37 @@ public:
         return arrays.end();
     }
 
+    //! Get the array of the current thread, or of the current chunk if reductions are deterministic.
     reference local()
     {
+        if constexpr (!std::is_integral_v<T>)
+        {
+            const int chunk = parallel::DeterministicChunk::current();
+            if (chunk >= 0)
+            {
+                // Only the task running a chunk accesses its array.
+                auto& chunk_array = chunk_arrays[chunk];
+                if (!chunk_array)
+                {
+                    chunk_array = std::make_unique<ManagedArray<T>>(shape);
+                }
+                return *chunk_array;
+            }
+        }
         return arrays.local();
     }
 
     void reduceInto(ManagedArray<T>& result)
     {
-        if (arrays.size() == 0)
+        std::vector<const T*> local_chunk_arrays;
+        for (const auto& chunk_array : chunk_arrays)
+        {
+            if (chunk_array)
+            {
+                local_chunk_arrays.push_back(chunk_array->get());
+            }
+        }
+        if (arrays.size() == 0 && local_chunk_arrays.empty())
         {
             // If no local arrays have been created, then no data can be reduced
             // and an error will occur if we attempt to iterate over arrays.
@@ -105,20 +148,31 @@ public:
         else
         {
             // Reduce over arrays into the result array.
-            util::forLoopWrapper(0, result.size(), [&](size_t begin, size_t end) {
-                for (size_t i = begin; i < end; ++i)
-                {
-                    for (auto arr = arrays.begin(); arr != arrays.end(); ++arr)
-                    {
-                        result[i] += (*arr)[i];
-                    }
-                }
-            });
+            std::vector<const T*> local_arrays;
+            local_arrays.reserve(arrays.size());
+            for (const auto& arr : arrays)
+            {
+                local_arrays.push_back(arr.get());
+            }
+            util::reduceArrays(result.get(), result.size(), local_arrays);
+            util::reduceArraysPairwise(result.get(), result.size(), local_chunk_arrays);
         }
     }
 
 private:
+    //! Release the arrays of the chunks of deterministic loops.
+    void releaseChunkArrays()
+    {
+        for (auto& chunk_array : chunk_arrays)
+        {
+            chunk_array.reset();
+        }
+    }
+
     tbb::enumerable_thread_specific<ManagedArray<T>> arrays; //!< thread local arrays
+    std::vector<std::unique_ptr<ManagedArray<T>>>
+        chunk_arrays;               //!< arrays of the chunks of deterministic loops, created on first use
+    std::vector<size_t> shape {0}; //!< shape of the local arrays
 };
 
 }; }; // end namespace freud::util
@@ -1,6 +1,8 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+
 #include "diagonalize.h"
 
 namespace freud { namespace util {
@@ -8,7 +10,19 @@ namespace freud { namespace util {
 void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::ManagedArray<float>& eigen_vals,
                                   util::ManagedArray<float>& eigen_vecs)
 {
-    const Eigen::Matrix3f m = Eigen::Map<const Eigen::Matrix3f>(mat.get());
+    std::array<float, 9> mat_array {};
+    std::copy(mat.get(), mat.get() + 9, mat_array.begin());
+    std::array<float, 3> eigen_vals_array {};
+    std::array<float, 9> eigen_vecs_array {};
+    diagonalize33SymmetricMatrix(mat_array, eigen_vals_array, eigen_vecs_array);
+    std::copy(eigen_vals_array.begin(), eigen_vals_array.end(), eigen_vals.get());
+    std::copy(eigen_vecs_array.begin(), eigen_vecs_array.end(), eigen_vecs.get());
+}
+
+void diagonalize33SymmetricMatrix(const std::array<float, 9>& mat, std::array<float, 3>& eigen_vals,
+                                  std::array<float, 9>& eigen_vecs)
+{
+    const Eigen::Matrix3f m = Eigen::Map<const Eigen::Matrix3f>(mat.data());
 
     Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> es;
     es.compute(m);
@@ -17,7 +31,7 @@ void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::Ma
     {
         // numerical issue, return identity matrix
         Eigen::Matrix3f id = Eigen::Matrix3f::Identity();
-        Eigen::Map<Eigen::Matrix3f>(eigen_vecs.get(), 3, 3) = id;
+        Eigen::Map<Eigen::Matrix3f>(eigen_vecs.data(), 3, 3) = id;
         // set eigenvalues to zero so it's easily detectable
         eigen_vals[0] = eigen_vals[1] = eigen_vals[2] = 0.0;
     }
@@ -30,8 +44,8 @@ void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::Ma
         // outputmatrix eigen_vecs.
         // See here for information:
         // https://eigen.tuxfamily.org/dox/group__TopicStorageOrders.html
-        Eigen::Map<Eigen::Matrix3f>(eigen_vecs.get(), 3, 3) = es.eigenvectors();
-        Eigen::Map<Eigen::Vector3f>(eigen_vals.get(), 3) = es.eigenvalues();
+        Eigen::Map<Eigen::Matrix3f>(eigen_vecs.data(), 3, 3) = es.eigenvectors();
+        Eigen::Map<Eigen::Vector3f>(eigen_vals.data(), 3) = es.eigenvalues();
     }
 }
 
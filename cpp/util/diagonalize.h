@@ -4,6 +4,8 @@
 #ifndef DIAGONALIZE_H
 #define DIAGONALIZE_H
 
+#include <array>
+
 #include "Eigen/Eigen/Dense"
 #include "ManagedArray.h"
 
@@ -26,5 +28,13 @@ namespace freud { namespace util {
 void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::ManagedArray<float>& eigen_vals,
                                   util::ManagedArray<float>& eigen_vecs);
 
+//! Compute eigenvalues and eigenvectors of a self-adjoint 3x3 matrix without heap allocations.
+/*! This overload is identical to the one above, but the matrices are stored
+ *  in row-major std::arrays, which is cheaper for small temporary matrices
+ *  computed in inner loops.
+ */
+void diagonalize33SymmetricMatrix(const std::array<float, 9>& mat, std::array<float, 3>& eigen_vals,
+                                  std::array<float, 9>& eigen_vecs);
+
 }; }; // namespace freud::util
 #endif
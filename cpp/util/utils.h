@@ -9,6 +9,11 @@
 #include <tbb/blocked_range.h>
 #include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <type_traits>
+#include <vector>
+
+#include "tbb_config.h"
 
 namespace freud { namespace util {
 
@@ -43,19 +48,93 @@ template<typename Scalar> inline Scalar sinc(Scalar x)
     return std::sin(x) / x;
 }
 
+//! Scheduling of the iterations of a loop run by forLoopWrapper.
+/*! By default the range is split by TBB's auto_partitioner down to single
+ *  iterations. A larger grain size bounds the number of tasks for loops with
+ *  very cheap bodies. An affinity_partitioner records which thread ran each
+ *  subrange, and replays that mapping when it is passed to a later loop over
+ *  the same range, so each thread finds the data it touched in the previous
+ *  loop (e.g. the particles of the previous frame) still in its cache. The
+ *  partitioner must outlive the loops it is passed to, and is typically a
+ *  member of the compute object running them.
+ */
+struct LoopSchedule
+{
+    size_t grain_size {1};                          //!< Minimum number of iterations of a task.
+    tbb::affinity_partitioner* affinity {nullptr}; //!< Partitioner replaying earlier loops, if not NULL.
+};
+
+//! Number of iterations of a task for loops whose bodies take only a few nanoseconds.
+constexpr size_t CHEAP_LOOP_GRAIN_SIZE = 1024;
+
+namespace detail {
+
+//! Run a loop in the chunks used when reductions are deterministic.
+/*! The range is split into at most parallel::DETERMINISTIC_NUM_CHUNKS
+ *  chunks whose bounds only depend on its length, and each chunk is run
+ *  within a parallel::DeterministicChunk. Loops nested in a chunk run
+ *  serially in that chunk, so the chunk of every thread local access is
+ *  fixed.
+ *
+ *  \param begin Beginning index.
+ *  \param end Ending index.
+ *  \param body An object with operator(size_t begin, size_t end).
+ */
+template<typename Body> inline void forLoopDeterministic(size_t begin, size_t end, const Body& body)
+{
+    const size_t n = end - begin;
+    const size_t num_chunks = std::min(n, parallel::DETERMINISTIC_NUM_CHUNKS);
+    if (parallel::DeterministicChunk::current() >= 0 || num_chunks <= 1)
+    {
+        const parallel::DeterministicChunk chunk(std::max(parallel::DeterministicChunk::current(), 0));
+        body(begin, end);
+        return;
+    }
+    parallel::execute([&]() {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, num_chunks, 1),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+                {
+                    const parallel::DeterministicChunk scope(static_cast<int>(chunk));
+                    body(begin + chunk * n / num_chunks, begin + (chunk + 1) * n / num_chunks);
+                }
+            },
+            tbb::simple_partitioner());
+    });
+}
+
+}; // end namespace detail
+
 //! Wrapper for for-loop to allow the execution in parallel or not.
 /*! \param begin Beginning index.
  *  \param end Ending index.
  *  \param body An object with operator(size_t begin, size_t end).
+ *  \param schedule How to split the range into tasks.
  *  \param parallel If true, run body in parallel.
  */
 template<typename Body>
-inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool parallel = true)
+inline void forLoopWrapper(size_t begin, size_t end, const Body& body, const LoopSchedule& schedule,
+                           bool parallel = true)
 {
-    if (parallel)
+    if (parallel && parallel::getDeterministicReductions())
+    {
+        detail::forLoopDeterministic(begin, end, body);
+    }
+    else if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
-                          [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        parallel::execute([&]() {
+            const tbb::blocked_range<size_t> range(begin, end, std::max<size_t>(schedule.grain_size, 1));
+            const auto range_body = [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); };
+            if (schedule.affinity != nullptr)
+            {
+                tbb::parallel_for(range, range_body, *schedule.affinity);
+            }
+            else
+            {
+                tbb::parallel_for(range, range_body);
+            }
+        });
     }
     else
     {
@@ -63,24 +142,56 @@ inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool para
     }
 }
 
+//! Wrapper for for-loop to allow the execution in parallel or not.
+/*! \param begin Beginning index.
+ *  \param end Ending index.
+ *  \param body An object with operator(size_t begin, size_t end).
+ *  \param parallel If true, run body in parallel.
+ */
+template<typename Body>
+inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool parallel = true)
+{
+    forLoopWrapper(begin, end, body, LoopSchedule(), parallel);
+}
+
 //! Wrapper for 2D nested for loops to allow the execution in parallel or not.
 /*! \param begin_row Beginning index of outer loop.
  *  \param end_row Ending index of outer loop.
  *  \param begin_col Beginning index of inner loop.
  *  \param end_col Ending index of inner loop.
  *  \param body An object with operator(size_t begin_row, size_t end_row, size_t begin_col, size_t end_col).
+ *  \param schedule How to split the range into tasks. The grain size applies to both dimensions.
  *  \param parallel If true, run body in parallel.
  */
 template<typename Body>
 inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col, size_t end_col,
-                             const Body& body, bool parallel = true)
+                             const Body& body, const LoopSchedule& schedule, bool parallel = true)
 {
-    if (parallel)
+    if (parallel && parallel::getDeterministicReductions())
+    {
+        // Only the rows are split into chunks.
+        detail::forLoopDeterministic(begin_row, end_row, [&](size_t row_begin, size_t row_end) {
+            body(row_begin, row_end, begin_col, end_col);
+        });
+    }
+    else if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
-                          [&body](const tbb::blocked_range2d<size_t>& r) {
-                              body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-                          });
+        parallel::execute([&]() {
+            const size_t grain_size = std::max<size_t>(schedule.grain_size, 1);
+            const tbb::blocked_range2d<size_t> range(begin_row, end_row, grain_size, begin_col, end_col,
+                                                     grain_size);
+            const auto range_body = [&body](const tbb::blocked_range2d<size_t>& r) {
+                body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+            };
+            if (schedule.affinity != nullptr)
+            {
+                tbb::parallel_for(range, range_body, *schedule.affinity);
+            }
+            else
+            {
+                tbb::parallel_for(range, range_body);
+            }
+        });
     }
     else
     {
@@ -88,6 +199,126 @@ inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col,
     }
 }
 
+//! Wrapper for 2D nested for loops to allow the execution in parallel or not.
+/*! \param begin_row Beginning index of outer loop.
+ *  \param end_row Ending index of outer loop.
+ *  \param begin_col Beginning index of inner loop.
+ *  \param end_col Ending index of inner loop.
+ *  \param body An object with operator(size_t begin_row, size_t end_row, size_t begin_col, size_t end_col).
+ *  \param parallel If true, run body in parallel.
+ */
+template<typename Body>
+inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col, size_t end_col,
+                             const Body& body, bool parallel = true)
+{
+    forLoopWrapper2D(begin_row, end_row, begin_col, end_col, body, LoopSchedule(), parallel);
+}
+
+//! Number of elements reduced together by each task of reduceArrays.
+constexpr size_t REDUCTION_BLOCK_SIZE = 4096;
+
+//! Add a set of arrays element-wise into a result array.
+/*! The elements are split into contiguous blocks that are reduced in
+ *  parallel. Each task adds its block of every array into the result in
+ *  turn, so each input is read sequentially and the block of the result
+ *  stays in cache while all arrays are added to it.
+ *
+ *  If the arrays are of a different type than the result, the sum of the
+ *  arrays is computed in their type and converted when it is added to the
+ *  result, so a wider accumulator type is not rounded once per array.
+ *
+ *  \param result The array to add into.
+ *  \param size The number of elements of each array.
+ *  \param arrays The arrays to add.
+ */
+template<typename T, typename U>
+inline void reduceArrays(T* result, size_t size, const std::vector<const U*>& arrays)
+{
+    const size_t num_blocks = (size + REDUCTION_BLOCK_SIZE - 1) / REDUCTION_BLOCK_SIZE;
+    forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        const size_t block_begin = begin * REDUCTION_BLOCK_SIZE;
+        const size_t block_end = std::min(end * REDUCTION_BLOCK_SIZE, size);
+        if constexpr (std::is_same_v<T, U>)
+        {
+            for (const U* array : arrays)
+            {
+                for (size_t i = block_begin; i < block_end; ++i)
+                {
+                    result[i] += array[i];
+                }
+            }
+        }
+        else
+        {
+            std::vector<U> block_sum(block_end - block_begin, U(0));
+            for (const U* array : arrays)
+            {
+                for (size_t i = block_begin; i < block_end; ++i)
+                {
+                    block_sum[i - block_begin] += array[i];
+                }
+            }
+            for (size_t i = block_begin; i < block_end; ++i)
+            {
+                result[i] += static_cast<T>(block_sum[i - block_begin]);
+            }
+        }
+    });
+}
+
+//! Number of elements reduced together by each task of reduceArraysPairwise.
+constexpr size_t PAIRWISE_REDUCTION_BLOCK_SIZE = 256;
+
+//! Add a set of arrays element-wise into a result array in a fixed pairwise order.
+/*! Each element is summed over the arrays as a balanced binary tree, in
+ *  which neighboring arrays are added first. The order of the additions
+ *  only depends on the number of arrays, so the result is reproducible, and
+ *  the rounding error grows with the logarithm of the number of arrays.
+ *
+ *  \param result The array to add into.
+ *  \param size The number of elements of each array.
+ *  \param arrays The arrays to add, in the order they are combined.
+ */
+template<typename T>
+inline void reduceArraysPairwise(T* result, size_t size, const std::vector<const T*>& arrays)
+{
+    const size_t num_arrays = arrays.size();
+    if (num_arrays == 0)
+    {
+        return;
+    }
+    const size_t num_blocks = (size + PAIRWISE_REDUCTION_BLOCK_SIZE - 1) / PAIRWISE_REDUCTION_BLOCK_SIZE;
+    forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        std::vector<T> partial_sums(num_arrays * PAIRWISE_REDUCTION_BLOCK_SIZE);
+        for (size_t block = begin; block < end; ++block)
+        {
+            const size_t block_begin = block * PAIRWISE_REDUCTION_BLOCK_SIZE;
+            const size_t block_size = std::min(PAIRWISE_REDUCTION_BLOCK_SIZE, size - block_begin);
+            for (size_t a = 0; a < num_arrays; ++a)
+            {
+                std::copy(arrays[a] + block_begin, arrays[a] + block_begin + block_size,
+                          partial_sums.begin() + a * PAIRWISE_REDUCTION_BLOCK_SIZE);
+            }
+            for (size_t stride = 1; stride < num_arrays; stride *= 2)
+            {
+                for (size_t a = 0; a + stride < num_arrays; a += 2 * stride)
+                {
+                    T* const lhs = partial_sums.data() + a * PAIRWISE_REDUCTION_BLOCK_SIZE;
+                    const T* const rhs = partial_sums.data() + (a + stride) * PAIRWISE_REDUCTION_BLOCK_SIZE;
+                    for (size_t i = 0; i < block_size; ++i)
+                    {
+                        lhs[i] += rhs[i];
+                    }
+                }
+            }
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                result[block_begin + i] += partial_sums[i];
+            }
+        }
+    });
+}
+
 }; }; // namespace freud::util
 
 #endif
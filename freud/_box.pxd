@@ -7,7 +7,7 @@ from freud.util cimport vec3
 
 ctypedef unsigned int uint
 
-cdef extern from "Box.h" namespace "freud::box":
+cdef extern from "Box.h" namespace "freud::box" nogil:
     cdef cppclass Box:
         Box()
         Box(float, bool)
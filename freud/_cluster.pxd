@@ -8,7 +8,7 @@ cimport freud.util
 from freud.util cimport uint, vec3
 
 
-cdef extern from "Cluster.h" namespace "freud::cluster":
+cdef extern from "Cluster.h" namespace "freud::cluster" nogil:
     cdef cppclass Cluster:
         Cluster() except +
         void compute(const freud._locality.NeighborQuery*,
@@ -19,7 +19,25 @@ cdef extern from "Cluster.h" namespace "freud::cluster":
         const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
         const vector[vector[uint]] getClusterKeys() const
 
-cdef extern from "ClusterProperties.h" namespace "freud::cluster":
+cdef extern from "ClusterTracker.h" namespace "freud::cluster" nogil:
+    cdef cppclass ClusterTracker:
+        ClusterTracker() except +
+        void reset()
+        void compute(const freud._locality.NeighborQuery*,
+                     const freud._locality.NeighborList*,
+                     freud._locality.QueryArgs) except +
+        unsigned int getNumFrames() const
+        unsigned int getNumClusters() const
+        unsigned int getMaxClusterId() const
+        const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
+        const vector[uint] &getClusterSizes() const
+        const freud.util.ManagedArray[unsigned int] &getMerges() const
+        const freud.util.ManagedArray[unsigned int] &getSplits() const
+        unsigned int getNumAddedBonds() const
+        unsigned int getNumRemovedBonds() const
+        unsigned int getNumRelabeledPoints() const
+
+cdef extern from "ClusterProperties.h" namespace "freud::cluster" nogil:
     cdef cppclass ClusterProperties:
         ClusterProperties()
         void compute(const freud._locality.NeighborQuery*,
@@ -28,5 +46,7 @@ cdef extern from "ClusterProperties.h" namespace "freud::cluster":
         const freud.util.ManagedArray[vec3[float]] &getClusterCentersOfMass() const
         const freud.util.ManagedArray[float] &getClusterMomentsOfInertia() const
         const freud.util.ManagedArray[float] &getClusterGyrations() const
+        const freud.util.ManagedArray[float] &getClusterRadiiOfGyration() \
+            const
         const freud.util.ManagedArray[unsigned int] &getClusterSizes() const
         const freud.util.ManagedArray[float] &getClusterMasses() const
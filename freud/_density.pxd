@@ -1,6 +1,9 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
+from libcpp.vector cimport vector
+
 cimport freud._box
 cimport freud._locality
 cimport freud.util
@@ -9,29 +12,42 @@ from freud.util cimport vec3
 
 ctypedef unsigned int uint
 
-cdef extern from "CorrelationFunction.h" namespace "freud::density":
+cdef extern from "CorrelationFunction.h" namespace "freud::density" nogil:
     cdef cppclass CorrelationFunction[T](BondHistogramCompute):
-        CorrelationFunction(float, float) except +
+        CorrelationFunction(unsigned int, float, vec3[unsigned int]) except +
         void accumulate(const freud._locality.NeighborQuery*, const T*,
                         const vec3[float]*,
                         const T*,
                         unsigned int, const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateSampled(const freud._locality.NeighborQuery*, const T*,
+                               const vec3[float]*,
+                               const T*,
+                               unsigned int,
+                               const freud._locality.NeighborList*,
+                               freud._locality.QueryArgs,
+                               const freud._locality.QuerySampling&) except +
         const freud.util.ManagedArray[T] &getCorrelation()
+        const freud.util.ManagedArray[float] &getCorrelationStandardError()
+        const vec3[unsigned int]& getMesh() const
 
-cdef extern from "GaussianDensity.h" namespace "freud::density":
+cdef extern from "GaussianDensity.h" namespace "freud::density" nogil:
     cdef cppclass GaussianDensity:
-        GaussianDensity(vec3[unsigned int], float, float) except +
+        GaussianDensity(vec3[unsigned int], float, float, bool) except +
         const freud._box.Box & getBox() const
         void reset()
         void compute(const freud._locality.NeighborQuery*,
-                     const float*) except +
+                     const float*, unsigned int) except +
         const freud.util.ManagedArray[float] &getDensity() const
+        unsigned int getNumChannels() const
         vec3[unsigned int] getWidth() const
         float getSigma() const
         float getRMax() const
+        bool getUseFFT() const
+        size_t estimateMemory(const freud._box.Box &, unsigned int,
+                              unsigned int) const
 
-cdef extern from "LocalDensity.h" namespace "freud::density":
+cdef extern from "LocalDensity.h" namespace "freud::density" nogil:
     cdef cppclass LocalDensity:
         LocalDensity(float, float) except +
         const freud._box.Box & getBox() const
@@ -45,24 +61,72 @@ cdef extern from "LocalDensity.h" namespace "freud::density":
         float getRMax() const
         float getDiameter() const
 
-cdef extern from "RDF.h" namespace "freud::density":
+cdef extern from "RDF.h" namespace "freud::density" nogil:
     cdef cppclass RDF(BondHistogramCompute):
 
         ctypedef enum NormalizationMode "NormalizationMode":
             exact "freud::density::RDF::NormalizationMode::exact"
             finite_size "freud::density::RDF::NormalizationMode::finite_size"
 
-        RDF(float, float, float, NormalizationMode) except +
+        RDF(float, float, float, NormalizationMode, bool) except +
+        bool getLogBins() const
+        const freud._box.Box & getBox() const
+        void accumulate(const freud._locality.NeighborQuery*,
+                        const vec3[float]*,
+                        unsigned int,
+                        const freud._locality.NeighborList*,
+                        freud._locality.QueryArgs) except +
+        void accumulateSampled(const freud._locality.NeighborQuery*,
+                               const vec3[float]*,
+                               unsigned int,
+                               const freud._locality.NeighborList*,
+                               freud._locality.QueryArgs,
+                               const freud._locality.QuerySampling&) except +
+        void accumulate(const freud._locality.NeighborQuery*,
+                        unsigned int,
+                        const freud._locality.CompressedNeighborList*) except +
+        void accumulateFrames(
+            const vector[const freud._locality.NeighborQuery*]&,
+            const vector[const vec3[float]*]&,
+            const vector[unsigned int]&,
+            freud._locality.QueryArgs) except +
+        void accumulateTrajectory(
+            const freud._locality.GSDTrajectory&,
+            unsigned long long, unsigned long long, unsigned long long,
+            freud._locality.QueryArgs) except +
+        const freud.util.ManagedArray[float] &getRDF()
+        const freud.util.ManagedArray[float] &getRDFStandardError()
+        const freud.util.ManagedArray[float] &getNr()
+
+cdef extern from "PartialRDF.h" namespace "freud::density" nogil:
+    cdef cppclass PartialRDF(BondHistogramCompute):
+        PartialRDF(unsigned int, unsigned int, float, float) except +
         const freud._box.Box & getBox() const
         void accumulate(const freud._locality.NeighborQuery*,
+                        const unsigned int*,
                         const vec3[float]*,
+                        const unsigned int*,
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        unsigned int getNumTypes() const
         const freud.util.ManagedArray[float] &getRDF()
         const freud.util.ManagedArray[float] &getNr()
 
-cdef extern from "SphereVoxelization.h" namespace "freud::density":
+cdef extern from "VanHove.h" namespace "freud::density" nogil:
+    cdef cppclass VanHove(BondHistogramCompute):
+        VanHove(const vector[unsigned int]&, unsigned int, float,
+                float) except +
+        const freud._box.Box & getBox() const
+        void accumulate(const freud._box.Box&, const vec3[float]*,
+                        unsigned int, unsigned int) except +
+        const vector[unsigned int]& getLags() const
+        const vector[unsigned int]& getNumOrigins() const
+        const freud.util.ManagedArray[float] &getDistinct()
+        const freud.util.ManagedArray[float] &getSelf()
+        const freud.util.ManagedArray[unsigned int] &getSelfBinCounts()
+
+cdef extern from "SphereVoxelization.h" namespace "freud::density" nogil:
     cdef cppclass SphereVoxelization:
         SphereVoxelization(vec3[unsigned int], float) except +
         const freud._box.Box & getBox() const
@@ -2,32 +2,88 @@
 # This file is from the freud project, released under the BSD 3-Clause License.
 
 from libcpp cimport bool
+from libcpp.complex cimport complex
 from libcpp.vector cimport vector
 
+cimport freud._box
 cimport freud._locality
 cimport freud.util
-from freud.util cimport vec3
+from freud.util cimport quat, vec3
 
+ctypedef float complex fcomplex
 
-cdef extern from "StaticStructureFactor.h" namespace "freud::diffraction":
+cdef extern from "StaticStructureFactor.h" namespace "freud::diffraction" nogil:
     cdef cppclass StaticStructureFactor:
         const freud.util.ManagedArray[float] &getStructureFactor()
         const vector[float] getBinEdges() const
         const vector[float] getBinCenters() const
         float getMinValidK() const
+        void accumulateTrajectory(const freud._locality.GSDTrajectory&,
+                                  unsigned long long, unsigned long long,
+                                  unsigned long long) except +
 
-cdef extern from "StaticStructureFactorDebye.h" namespace "freud::diffraction":
+cdef extern from "StaticStructureFactorDebye.h" namespace "freud::diffraction" nogil:
     cdef cppclass StaticStructureFactorDebye(StaticStructureFactor):
-        StaticStructureFactorDebye(unsigned int, float, float) except +
+        StaticStructureFactorDebye(unsigned int, float, float, float) except +
         void accumulate(const freud._locality.NeighborQuery*,
                         const vec3[float]*, unsigned int, unsigned int) except +
         void reset()
+        float getDistanceBinWidth() const
+        size_t estimateMemory(const freud._box.Box &) const
 
-cdef extern from "StaticStructureFactorDirect.h" namespace "freud::diffraction":
+cdef extern from "StaticStructureFactorDirect.h" namespace "freud::diffraction" nogil:
     cdef cppclass StaticStructureFactorDirect(StaticStructureFactor):
-        StaticStructureFactorDirect(unsigned int, float, float, unsigned int) except +
+        StaticStructureFactorDirect(unsigned int, float, float, unsigned int,
+                                    unsigned int) except +
         void accumulate(const freud._locality.NeighborQuery*,
                         const vec3[float]*, unsigned int, unsigned int) except +
+        void accumulateFrames(const vector[const freud._locality.NeighborQuery*]&,
+                              const vector[const vec3[float]*]&, unsigned int,
+                              unsigned int) except +
+        void computeAmplitudes(const freud._locality.NeighborQuery*,
+                               const vec3[float]*, unsigned int,
+                               unsigned int) except +
+        void accumulateAmplitudes(const fcomplex*, const fcomplex*)
+        const freud.util.ManagedArray[fcomplex] &getPointAmplitudes() const
+        const freud.util.ManagedArray[fcomplex] &getQueryPointAmplitudes() const
         void reset()
         unsigned int getNumSampledKPoints() const
+        unsigned int getGridSize() const
         vector[vec3[float]] getKPoints() const
+
+cdef extern from "IntermediateScatteringFunction.h" namespace "freud::diffraction" nogil:
+    cdef cppclass IntermediateScatteringFunction:
+        IntermediateScatteringFunction(unsigned int, float, float, unsigned int,
+                                       unsigned int, unsigned int, unsigned int,
+                                       bool) except +
+        void reset()
+        void update(const freud._box.Box&, const vec3[float]*,
+                    unsigned int) except +
+        void updateTrajectory(const freud._locality.GSDTrajectory&,
+                              unsigned long long, unsigned long long,
+                              unsigned long long) except +
+        unsigned int getPointsPerLevel() const
+        unsigned int getLevelFactor() const
+        bool getSelfPart() const
+        unsigned int getNumFrames() const
+        const vector[float] getBinEdges() const
+        const vector[float] getBinCenters() const
+        vector[vec3[float]] getKPoints() const
+        const freud.util.ManagedArray[unsigned int] &getLags() except +
+        const freud.util.ManagedArray[float] &getISF() except +
+        const freud.util.ManagedArray[float] &getSelfISF() except +
+        const freud.util.ManagedArray[unsigned int] &getCounts() except +
+
+cdef extern from "DiffractionPattern.h" namespace "freud::diffraction" nogil:
+    cdef cppclass DiffractionPattern:
+        DiffractionPattern(unsigned int, unsigned int) except +
+        void reset()
+        void accumulate(const freud._box.Box&, const vec3[float]*,
+                        unsigned int, const quat[float]*, unsigned int,
+                        float, float) except +
+        unsigned int getGridSize() const
+        unsigned int getOutputSize() const
+        unsigned int getNPoints() const
+        unsigned int getFrameCounter() const
+        const freud.util.ManagedArray[double] &getDiffraction()
+        const freud.util.ManagedArray[double] &getRadialAverage()
@@ -13,7 +13,7 @@ from freud._locality cimport BondHistogramCompute
 from freud.util cimport quat, vec3
 
 
-cdef extern from "BondOrder.h" namespace "freud::environment":
+cdef extern from "BondOrder.h" namespace "freud::environment" nogil:
     ctypedef enum BondOrderMode:
         bod
         lbod
@@ -30,10 +30,17 @@ cdef extern from "BondOrder.h" namespace "freud::environment":
             unsigned int,
             const freud._locality.NeighborList*,
             freud._locality.QueryArgs) except +
+        void accumulateFrames(
+            const vector[const freud._locality.NeighborQuery*]&,
+            const vector[const quat[float]*]&,
+            const vector[const vec3[float]*]&,
+            const vector[const quat[float]*]&,
+            const vector[unsigned int]&,
+            freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getBondOrder()
         BondOrderMode getMode() const
 
-cdef extern from "LocalDescriptors.h" namespace "freud::environment":
+cdef extern from "LocalDescriptors.h" namespace "freud::environment" nogil:
     ctypedef enum LocalDescriptorOrientation:
         LocalNeighborhood
         Global
@@ -57,7 +64,7 @@ cdef extern from "LocalDescriptors.h" namespace "freud::environment":
         LocalDescriptorOrientation getMode() const
         bool getNegativeM() const
 
-cdef extern from "MatchEnv.h" namespace "freud::environment":
+cdef extern from "MatchEnv.h" namespace "freud::environment" nogil:
     map[unsigned int, unsigned int] minimizeRMSD(
         const freud._box.Box &, const vec3[float]*, vec3[float]*, unsigned int,
         float &, bool) except +
@@ -82,7 +89,16 @@ cdef extern from "MatchEnv.h" namespace "freud::environment":
                      unsigned int,
                      float,
                      bool) except +
+        void computeMotifs(const freud._locality.NeighborQuery*,
+                           const freud._locality.NeighborList*,
+                           freud._locality.QueryArgs,
+                           const vec3[float]*,
+                           const unsigned int*,
+                           unsigned int,
+                           float,
+                           bool) except +
         const freud.util.ManagedArray[bool] &getMatches()
+        const freud.util.ManagedArray[unsigned int] &getMotifIndices()
 
     cdef cppclass EnvironmentRMSDMinimizer(MatchEnv):
         EnvironmentRMSDMinimizer() except +
@@ -92,6 +108,7 @@ cdef extern from "MatchEnv.h" namespace "freud::environment":
             freud._locality.QueryArgs,
             const vec3[float]*,
             unsigned int,
+            bool,
             bool) except +
         const freud.util.ManagedArray[float] &getRMSDs()
 
@@ -108,7 +125,7 @@ cdef extern from "MatchEnv.h" namespace "freud::environment":
         const freud.util.ManagedArray[unsigned int] &getClusters()
         vector[vector[vec3[float]]] &getClusterEnvironments()
 
-cdef extern from "AngularSeparation.h" namespace "freud::environment":
+cdef extern from "AngularSeparation.h" namespace "freud::environment" nogil:
     cdef cppclass AngularSeparationGlobal:
         AngularSeparationGlobal()
         void compute(quat[float]*,
@@ -132,9 +149,10 @@ cdef extern from "AngularSeparation.h" namespace "freud::environment":
         const freud.util.ManagedArray[float] &getAngles() const
         freud._locality.NeighborList * getNList()
 
-cdef extern from "LocalBondProjection.h" namespace "freud::environment":
+cdef extern from "LocalBondProjection.h" namespace "freud::environment" nogil:
     cdef cppclass LocalBondProjection:
-        LocalBondProjection()
+        LocalBondProjection(bool)
+        bool getComputeProjections() const
         void compute(const freud._locality.NeighborQuery*, quat[float]*,
                      vec3[float]*, unsigned int, vec3[float]*, unsigned int,
                      quat[float]*, unsigned int, const
@@ -1,9 +1,11 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libc.stdint cimport uint64_t
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr
 from libcpp.pair cimport pair
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 
 cimport freud._box
@@ -11,7 +13,7 @@ cimport freud.util
 from freud.util cimport vec3
 
 
-cdef extern from "NeighborBond.h" namespace "freud::locality":
+cdef extern from "NeighborBond.h" namespace "freud::locality" nogil:
     cdef cppclass NeighborBond:
         unsigned int getQueryPointIdx() const
         unsigned int getPointIdx() const
@@ -22,7 +24,7 @@ cdef extern from "NeighborBond.h" namespace "freud::locality":
         bool operator!=(const NeighborBond &) const
         bool operator<(const NeighborBond &) const
 
-cdef extern from "NeighborQuery.h" namespace "freud::locality":
+cdef extern from "NeighborQuery.h" namespace "freud::locality" nogil:
 
     ctypedef enum QueryType "freud::locality::QueryType":
         none "freud::locality::QueryType::none"
@@ -37,6 +39,7 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         float r_guess
         float scale
         bool exclude_ii
+        bool half_list
 
     cdef cppclass NeighborQuery:
         NeighborQuery() except +
@@ -45,6 +48,9 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
                       unsigned int) except +
         shared_ptr[NeighborQueryIterator] query(
             const vec3[float]*, unsigned int, QueryArgs) except +
+        void updatePoints(const freud._box.Box &,
+                          const vec3[float]*,
+                          unsigned int) except +
         const freud._box.Box & getBox() const
         const vec3[float]* getPoints const
         const unsigned int getNPoints const
@@ -58,9 +64,13 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         NeighborQueryIterator(NeighborQuery*, vec3[float]*, unsigned int)
         bool end()
         NeighborBond next()
-        NeighborList *toNeighborList(bool)
+        NeighborList *toNeighborList(bool, unsigned int)
+        vector[NeighborList*] toNeighborLists(
+            const vector[float] &, bool, unsigned int) except +
+        unsigned int nextChunk(unsigned int, unsigned int*, unsigned int*,
+                               float*) except +
 
-cdef extern from "RawPoints.h" namespace "freud::locality":
+cdef extern from "RawPoints.h" namespace "freud::locality" nogil:
 
     cdef cppclass RawPoints(NeighborQuery):
         RawPoints() except +
@@ -68,13 +78,23 @@ cdef extern from "RawPoints.h" namespace "freud::locality":
                   const vec3[float]*,
                   unsigned int) except +
 
-cdef extern from "NeighborList.h" namespace "freud::locality":
+cdef extern from "NeighborList.h" namespace "freud::locality" nogil:
+    cdef enum NeighborListColumns:
+        NO_COLUMNS
+        VECTORS_COLUMN
+        DISTANCES_COLUMN
+        WEIGHTS_COLUMN
+        ALL_COLUMNS
+
     cdef cppclass NeighborList:
         NeighborList()
         NeighborList(unsigned int)
         NeighborList(unsigned int, const unsigned int*, unsigned int,
                      const unsigned int*, unsigned int, const vec3[float]*,
                      const float*) except +
+        NeighborList(unsigned int, const unsigned int*, unsigned int,
+                     unsigned int, const vec3[float]*, const float*,
+                     const shared_ptr[void]&) except +
         NeighborList(const vec3[float]*, const vec3[float]*,
                      const freud._box.Box&, const bool, const unsigned int,
                      const unsigned int)
@@ -100,7 +120,30 @@ cdef extern from "NeighborList.h" namespace "freud::locality":
         void validate(unsigned int, unsigned int) except +
         void sort(bool)
 
-cdef extern from "LinkCell.h" namespace "freud::locality":
+cdef extern from "CompressedNeighborList.h" namespace "freud::locality" nogil:
+    cdef cppclass CompressedNeighborList:
+        CompressedNeighborList(const NeighborList &, float) except +
+        unsigned int getNumBonds() const
+        unsigned int getNumQueryPoints() const
+        unsigned int getNumPoints() const
+        float getRMax() const
+        size_t getNumBytes() const
+        NeighborList * toNeighborList() const
+
+cdef extern from "GSDTrajectory.h" namespace "freud::util" nogil:
+    cdef cppclass GSDFrame:
+        GSDFrame()
+        freud._box.Box box
+        vector[vec3[float]] positions
+        unsigned int getNumParticles() const
+
+    cdef cppclass GSDTrajectory:
+        GSDTrajectory(const string &) except +
+        const string & getFilename() const
+        uint64_t getNumFrames() const
+        void readFrame(uint64_t, GSDFrame &) except +
+
+cdef extern from "LinkCell.h" namespace "freud::locality" nogil:
     cdef cppclass LinkCell(NeighborQuery):
         LinkCell() except +
         LinkCell(const freud._box.Box &,
@@ -109,14 +152,23 @@ cdef extern from "LinkCell.h" namespace "freud::locality":
                  float) except +
         float getCellWidth() const
 
-cdef extern from "AABBQuery.h" namespace "freud::locality":
+cdef extern from "AABBQuery.h" namespace "freud::locality" nogil:
     cdef cppclass AABBQuery(NeighborQuery):
         AABBQuery() except +
         AABBQuery(const freud._box.Box,
                   const vec3[float]*,
                   unsigned int) except +
+        void queryNearest(const vec3[float]*, unsigned int, QueryArgs,
+                          freud.util.ManagedArray[unsigned int] &,
+                          freud.util.ManagedArray[float] &) except +
+
+cdef extern from "BondHistogramCompute.h" namespace "freud::locality" nogil:
+    cdef cppclass QuerySampling:
+        float fraction
+        bool stratified
+        unsigned int seed
+        unsigned int num_batches
 
-cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
     cdef cppclass BondHistogramCompute:
         BondHistogramCompute()
 
@@ -127,8 +179,25 @@ cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
         vector[vector[float]] getBinCenters() const
         vector[pair[float, float]] getBounds() const
         vector[size_t] getAxisSizes() const
+        unsigned int getNPoints() const
+        unsigned int getNQueryPoints() const
+        void setDomainTotals(const unsigned int*, unsigned int, unsigned int)
+        unsigned int getNumBatches() const
+
+cdef extern from "DomainDecomposition.h" namespace "freud::locality" nogil:
+    cdef cppclass DomainDecomposition:
+        DomainDecomposition(const vec3[unsigned int] &, float) except +
+        void compute(const NeighborQuery*) except +
+        const freud._box.Box & getBox() const
+        vec3[unsigned int] getNumDomainsPerAxis() const
+        unsigned int getNumDomains() const
+        float getGhostWidth() const
+        const freud.util.ManagedArray[unsigned int] &getPointDomains() const
+        const freud.util.ManagedArray[unsigned int] &getGhostIndices() const
+        const freud.util.ManagedArray[unsigned int] &getGhostDomains() const
+        const freud.util.ManagedArray[unsigned int] &getGhostCounts() const
 
-cdef extern from "PeriodicBuffer.h" namespace "freud::locality":
+cdef extern from "PeriodicBuffer.h" namespace "freud::locality" nogil:
     cdef cppclass PeriodicBuffer:
         PeriodicBuffer()
         const freud._box.Box & getBox() const
@@ -141,15 +210,28 @@ cdef extern from "PeriodicBuffer.h" namespace "freud::locality":
         vector[vec3[float]] getBufferPoints() const
         vector[uint] getBufferIds() const
 
-cdef extern from "Voronoi.h" namespace "freud::locality":
+cdef extern from "VerletList.h" namespace "freud::locality" nogil:
+    cdef cppclass VerletList:
+        VerletList(float, float, bool) except +
+        void compute(const NeighborQuery*) except +
+        void reset()
+        shared_ptr[NeighborList] getNeighborList() const
+        bool getRebuilt() const
+        unsigned int getNumRebuilds() const
+        float getRMax() const
+        float getSkin() const
+        bool getExcludeII() const
+
+cdef extern from "Voronoi.h" namespace "freud::locality" nogil:
     cdef cppclass Voronoi:
-        Voronoi()
-        void compute(const NeighborQuery*) nogil except +
+        Voronoi(bool)
+        void compute(const NeighborQuery*) except +
+        bool getComputePolytopes() const
         vector[vector[vec3[double]]] getPolytopes() const
         const freud.util.ManagedArray[double] &getVolumes() const
         shared_ptr[NeighborList] getNeighborList() const
 
-cdef extern from "Filter.h" namespace "freud::locality":
+cdef extern from "Filter.h" namespace "freud::locality" nogil:
     cdef cppclass Filter:
         Filter()
         void compute(const NeighborQuery *,
@@ -160,10 +242,18 @@ cdef extern from "Filter.h" namespace "freud::locality":
         shared_ptr[NeighborList] getFilteredNlist() const
         shared_ptr[NeighborList] getUnfilteredNlist() const
 
-cdef extern from "FilterSANN.h" namespace "freud::locality":
+cdef extern from "FilterSANN.h" namespace "freud::locality" nogil:
     cdef cppclass FilterSANN(Filter):
         FilterSANN(bool)
 
-cdef extern from "FilterRAD.h" namespace "freud::locality":
+cdef extern from "FilterRAD.h" namespace "freud::locality" nogil:
     cdef cppclass FilterRAD(Filter):
         FilterRAD(bool, bool)
+
+cdef extern from "Interface.h" namespace "freud::locality" nogil:
+    cdef cppclass Interface:
+        Interface()
+        void compute(const NeighborQuery*, const vec3[float]*, unsigned int,
+                     const NeighborList*, QueryArgs) except +
+        const freud.util.ManagedArray[unsigned int] &getPointIds() const
+        const freud.util.ManagedArray[unsigned int] &getQueryPointIds() const
@@ -0,0 +1,32 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from libcpp cimport bool
+
+cimport freud._locality
+cimport freud.util
+from freud.util cimport vec3
+
+
+cdef extern from "MSD.h" namespace "freud::msd" nogil:
+    cdef cppclass MSD:
+        MSD(bool)
+        void compute(const vec3[float]*, unsigned int,
+                     unsigned int) except +
+        bool isWindow() const
+        const freud.util.ManagedArray[double] &getParticleMSD() const
+
+cdef extern from "StreamingMSD.h" namespace "freud::msd" nogil:
+    cdef cppclass StreamingMSD:
+        StreamingMSD(unsigned int, unsigned int) except +
+        void reset()
+        void update(const vec3[float]*, unsigned int) except +
+        void updateTrajectory(const freud._locality.GSDTrajectory&,
+                              unsigned long long, unsigned long long,
+                              unsigned long long) except +
+        unsigned int getPointsPerLevel() const
+        unsigned int getLevelFactor() const
+        unsigned int getNumFrames() const
+        const freud.util.ManagedArray[unsigned int] &getLags()
+        const freud.util.ManagedArray[float] &getMSD()
+        const freud.util.ManagedArray[unsigned int] &getCounts()
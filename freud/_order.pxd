@@ -12,7 +12,7 @@ from freud.util cimport quat, vec3
 
 ctypedef float complex fcomplex
 
-cdef extern from "Cubatic.h" namespace "freud::order":
+cdef extern from "Cubatic.h" namespace "freud::order" nogil:
     cdef cppclass Cubatic:
         Cubatic(float,
                 float,
@@ -35,20 +35,29 @@ cdef extern from "Cubatic.h" namespace "freud::order":
         unsigned int getSeed() const
 
 
-cdef extern from "Nematic.h" namespace "freud::order":
+cdef extern from "Nematic.h" namespace "freud::order" nogil:
     cdef cppclass Nematic:
         Nematic()
         void reset()
         void compute(vec3[float]*,
                      unsigned int) except +
+        void computeFrames(vec3[float]*,
+                           unsigned int,
+                           unsigned int) except +
+        void computeLocal(const freud._locality.NeighborList*,
+                          const freud._locality.NeighborQuery*,
+                          freud._locality.QueryArgs) except +
         unsigned int getNumParticles() const
         float getNematicOrderParameter() const
         const freud.util.ManagedArray[float] &getParticleTensor() const
+        const freud.util.ManagedArray[float] &getParticleOrder() const
+        const freud.util.ManagedArray[float] &getFrameOrder() const
+        const freud.util.ManagedArray[float] &getFrameDirectors() const
         const freud.util.ManagedArray[float] &getNematicTensor() const
         vec3[float] getNematicDirector() const
 
 
-cdef extern from "HexaticTranslational.h" namespace "freud::order":
+cdef extern from "HexaticTranslational.h" namespace "freud::order" nogil:
     cdef cppclass Hexatic:
         Hexatic(unsigned int, bool)
         void compute(const freud._locality.NeighborList*,
@@ -59,7 +68,7 @@ cdef extern from "HexaticTranslational.h" namespace "freud::order":
         bool isWeighted() const
 
 
-cdef extern from "Steinhardt.h" namespace "freud::order":
+cdef extern from "Steinhardt.h" namespace "freud::order" nogil:
     cdef cppclass Steinhardt:
         Steinhardt(vector[unsigned int], bool, bool, bool, bool) except +
         unsigned int getNP() const
@@ -67,7 +76,7 @@ cdef extern from "Steinhardt.h" namespace "freud::order":
                      const freud._locality.NeighborQuery*,
                      freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getQl() const
-        const vector[freud.util.ManagedArray[fcomplex]] &getQlm() const
+        const freud.util.ManagedArray[fcomplex] &getQlm() const
         const freud.util.ManagedArray[float] &getParticleOrder() const
         vector[float] getOrder() const
         bool isAverage() const
@@ -75,9 +84,10 @@ cdef extern from "Steinhardt.h" namespace "freud::order":
         bool isWeighted() const
         bool isWlNormalized() const
         vector[unsigned int] getL() const
+        vector[size_t] getMsOffsets() const
 
 
-cdef extern from "SolidLiquid.h" namespace "freud::order":
+cdef extern from "SolidLiquid.h" namespace "freud::order" nogil:
     cdef cppclass SolidLiquid:
         SolidLiquid(unsigned int, float, unsigned int, bool) except +
         unsigned int getL() const
@@ -86,7 +96,9 @@ cdef extern from "SolidLiquid.h" namespace "freud::order":
         bool getNormalizeQ() const
         void compute(const freud._locality.NeighborList*,
                      const freud._locality.NeighborQuery*,
-                     freud._locality.QueryArgs) nogil except +
+                     freud._locality.QueryArgs) except +
+        void threshold(const freud._locality.NeighborQuery*, float,
+                       unsigned int) except +
         unsigned int getLargestClusterSize() const
         vector[unsigned int] getClusterSizes() const
         const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
@@ -98,7 +110,7 @@ cdef extern from "SolidLiquid.h" namespace "freud::order":
         const freud.util.ManagedArray[float] &getQlij() const
 
 
-cdef extern from "RotationalAutocorrelation.h" namespace "freud::order":
+cdef extern from "RotationalAutocorrelation.h" namespace "freud::order" nogil:
     cdef cppclass RotationalAutocorrelation:
         RotationalAutocorrelation()
         RotationalAutocorrelation(unsigned int)
@@ -107,8 +119,21 @@ cdef extern from "RotationalAutocorrelation.h" namespace "freud::order":
         float getRotationalAutocorrelation() const
         void compute(quat[float]*, quat[float]*, unsigned int) except +
 
+    cdef cppclass StreamingRotationalAutocorrelation:
+        StreamingRotationalAutocorrelation(unsigned int, unsigned int,
+                                           unsigned int) except +
+        void reset()
+        void update(const quat[float]*, unsigned int) except +
+        unsigned int getL() const
+        unsigned int getPointsPerLevel() const
+        unsigned int getLevelFactor() const
+        unsigned int getNumFrames() const
+        const freud.util.ManagedArray[unsigned int] &getLags()
+        const freud.util.ManagedArray[float] &getRotationalAutocorrelation()
+        const freud.util.ManagedArray[unsigned int] &getCounts()
+
 
-cdef extern from "ContinuousCoordination.h" namespace "freud::order":
+cdef extern from "ContinuousCoordination.h" namespace "freud::order" nogil:
     cdef cppclass ContinuousCoordination:
         ContinuousCoordination(const vector[float], bool, bool) except +
         void compute(const freud._locality.Voronoi*) except +
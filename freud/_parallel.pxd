@@ -1,5 +1,44 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
+from libcpp.map cimport map
+from libcpp.string cimport string
+
 cdef extern from "tbb_config.h" namespace "freud::parallel":
     void setNumThreads(unsigned int)
+    void setThreadPinning(bool)
+    bool getThreadPinning()
+    void setDeterministicReductions(bool)
+    bool getDeterministicReductions()
+    void setMemoryBudget(size_t)
+    size_t getMemoryBudget()
+
+    cdef cppclass ExecutionContext:
+        ExecutionContext(unsigned int)
+        unsigned int getNumThreads() const
+
+cdef extern from "Profiler.h" namespace "freud::util":
+    cdef struct ProfileTimer:
+        double seconds
+        unsigned long long calls
+
+    cdef cppclass Profile:
+        map[string, ProfileTimer] timers
+        map[string, long long] counters
+
+    void enableProfiling()
+    void disableProfiling()
+    const Profile& getProfile()
+
+cdef extern from "CPUDispatch.h" namespace "freud::util":
+    ctypedef enum InstructionSet "freud::util::InstructionSet":
+        baseline "freud::util::InstructionSet::baseline"
+        avx2 "freud::util::InstructionSet::avx2"
+        avx512 "freud::util::InstructionSet::avx512"
+
+    InstructionSet getSupportedInstructionSet()
+    InstructionSet getInstructionSet()
+    void setInstructionSet(InstructionSet) except +
+    string getInstructionSetName(InstructionSet)
+    InstructionSet getInstructionSetFromName(const string &) except +
@@ -1,18 +1,21 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp.vector cimport vector
+
 cimport freud._locality
 cimport freud.util
 from freud._locality cimport BondHistogramCompute
 from freud.util cimport quat, vec3
 
 
-cdef extern from "PMFT.h" namespace "freud::pmft":
+cdef extern from "PMFT.h" namespace "freud::pmft" nogil:
     cdef cppclass PMFT(BondHistogramCompute):
         PMFT() except +
         const freud.util.ManagedArray[float] &getPCF()
+        const freud.util.ManagedArray[float] &getPCFStandardError()
 
-cdef extern from "PMFTR12.h" namespace "freud::pmft":
+cdef extern from "PMFTR12.h" namespace "freud::pmft" nogil:
     cdef cppclass PMFTR12(PMFT):
         PMFTR12(float, unsigned int, unsigned int, unsigned int) except +
 
@@ -23,8 +26,15 @@ cdef extern from "PMFTR12.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(
+            const vector[const freud._locality.NeighborQuery*]&,
+            const vector[const float*]&,
+            const vector[const vec3[float]*]&,
+            const vector[const float*]&,
+            const vector[unsigned int]&,
+            freud._locality.QueryArgs) except +
 
-cdef extern from "PMFTXYT.h" namespace "freud::pmft":
+cdef extern from "PMFTXYT.h" namespace "freud::pmft" nogil:
     cdef cppclass PMFTXYT(PMFT):
         PMFTXYT(float, float,
                 unsigned int, unsigned int, unsigned int) except +
@@ -36,8 +46,15 @@ cdef extern from "PMFTXYT.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(
+            const vector[const freud._locality.NeighborQuery*]&,
+            const vector[const float*]&,
+            const vector[const vec3[float]*]&,
+            const vector[const float*]&,
+            const vector[unsigned int]&,
+            freud._locality.QueryArgs) except +
 
-cdef extern from "PMFTXY.h" namespace "freud::pmft":
+cdef extern from "PMFTXY.h" namespace "freud::pmft" nogil:
     cdef cppclass PMFTXY(PMFT):
         PMFTXY(float, float, unsigned int, unsigned int) except +
 
@@ -47,11 +64,25 @@ cdef extern from "PMFTXY.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateSampled(const freud._locality.NeighborQuery*,
+                               const float*,
+                               const vec3[float]*,
+                               unsigned int,
+                               const freud._locality.NeighborList*,
+                               freud._locality.QueryArgs,
+                               const freud._locality.QuerySampling&) except +
+        void accumulateFrames(
+            const vector[const freud._locality.NeighborQuery*]&,
+            const vector[const float*]&,
+            const vector[const vec3[float]*]&,
+            const vector[unsigned int]&,
+            freud._locality.QueryArgs) except +
 
-cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
+cdef extern from "PMFTXYZ.h" namespace "freud::pmft" nogil:
     cdef cppclass PMFTXYZ(PMFT):
         PMFTXYZ(float, float, float, unsigned int, unsigned int,
                 unsigned int, vec3[float]) except +
+        size_t estimateMemory() const
 
         void accumulate(const freud._locality.NeighborQuery*,
                         const quat[float]*,
@@ -61,3 +92,11 @@ cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(
+            const vector[const freud._locality.NeighborQuery*]&,
+            const vector[const quat[float]*]&,
+            const vector[const vec3[float]*]&,
+            const vector[unsigned int]&,
+            const quat[float]*,
+            unsigned int,
+            freud._locality.QueryArgs) except +
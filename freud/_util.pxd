@@ -3,10 +3,11 @@
 
 cimport numpy
 from libcpp cimport bool
+from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
 
 
-cdef extern from "VectorMath.h":
+cdef extern from "VectorMath.h" nogil:
     cdef cppclass vec3[Real]:
         vec3(Real, Real, Real)
         vec3()
@@ -27,6 +28,18 @@ cdef extern from "ManagedArray.h" namespace "freud::util":
         T *get()
         size_t size() const
         vector[size_t] shape() const
+        void setOutput(T*, size_t, const shared_ptr[void]&)
+        void clearOutput()
+
+    shared_ptr[void] makeExternalOwner(void (*)(void*), void*) except +
+
+cdef extern from "MemoryPool.h" namespace "freud::util":
+    cdef cppclass MemoryPool:
+        @staticmethod
+        MemoryPool& get()
+        void setCapacity(size_t)
+        size_t getCapacity() const
+        void release()
 
 
 cdef extern from "numpy/arrayobject.h":
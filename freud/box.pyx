@@ -211,9 +211,10 @@ cdef class Box:
         cdef unsigned int Np = l_points.shape[0]
         cdef float[:, ::1] l_out = out
 
-        self.thisptr.makeAbsolute(
-            <vec3[float]*> &l_points[0, 0], Np,
-            <vec3[float]*> &l_out[0, 0])
+        with nogil:
+            self.thisptr.makeAbsolute(
+                <vec3[float]*> &l_points[0, 0], Np,
+                <vec3[float]*> &l_out[0, 0])
 
         return np.squeeze(out) if flatten else out
 
@@ -244,9 +245,10 @@ cdef class Box:
         cdef unsigned int Np = l_points.shape[0]
         cdef float[:, ::1] l_out = out
 
-        self.thisptr.makeFractional(
-            <vec3[float]*> &l_points[0, 0], Np,
-            <vec3[float]*> &l_out[0, 0])
+        with nogil:
+            self.thisptr.makeFractional(
+                <vec3[float]*> &l_points[0, 0], Np,
+                <vec3[float]*> &l_out[0, 0])
 
         return np.squeeze(out) if flatten else out
 
@@ -270,8 +272,9 @@ cdef class Box:
         cdef const float[:, ::1] l_points = vecs
         cdef const int[:, ::1] l_result = images
         cdef unsigned int Np = l_points.shape[0]
-        self.thisptr.getImages(<vec3[float]*> &l_points[0, 0], Np,
-                               <vec3[int]*> &l_result[0, 0])
+        with nogil:
+            self.thisptr.getImages(<vec3[float]*> &l_points[0, 0], Np,
+                                   <vec3[int]*> &l_result[0, 0])
 
         return np.squeeze(images) if flatten else images
 
@@ -338,8 +341,9 @@ cdef class Box:
         cdef unsigned int Np = l_points.shape[0]
         cdef float[:, ::1] l_out = out
 
-        self.thisptr.wrap(<vec3[float]*> &l_points[0, 0],
-                          Np, <vec3[float]*> &l_out[0, 0])
+        with nogil:
+            self.thisptr.wrap(<vec3[float]*> &l_points[0, 0],
+                              Np, <vec3[float]*> &l_out[0, 0])
 
         return np.squeeze(out) if flatten else out
 
@@ -381,9 +385,10 @@ cdef class Box:
         cdef unsigned int Np = l_points.shape[0]
         cdef float[:, ::1] l_out = out
 
-        self.thisptr.unwrap(<vec3[float]*> &l_points[0, 0],
-                            <vec3[int]*> &l_imgs[0, 0], Np,
-                            <vec3[float]*> &l_out[0, 0])
+        with nogil:
+            self.thisptr.unwrap(<vec3[float]*> &l_points[0, 0],
+                                <vec3[int]*> &l_imgs[0, 0], Np,
+                                <vec3[float]*> &l_out[0, 0])
 
         return np.squeeze(out) if flatten else out
 
@@ -426,8 +431,10 @@ cdef class Box:
             l_masses_ptr = &l_masses[0]
 
         cdef size_t Np = l_points.shape[0]
-        cdef vec3[float] result = self.thisptr.centerOfMass(
-            <vec3[float]*> &l_points[0, 0], Np, l_masses_ptr)
+        cdef vec3[float] result
+        with nogil:
+            result = self.thisptr.centerOfMass(
+                <vec3[float]*> &l_points[0, 0], Np, l_masses_ptr)
         return np.asarray([result.x, result.y, result.z])
 
     def center(self, vecs, masses=None):
@@ -468,7 +475,8 @@ cdef class Box:
             l_masses_ptr = &l_masses[0]
 
         cdef size_t Np = l_points.shape[0]
-        self.thisptr.center(<vec3[float]*> &l_points[0, 0], Np, l_masses_ptr)
+        with nogil:
+            self.thisptr.center(<vec3[float]*> &l_points[0, 0], Np, l_masses_ptr)
         return vecs
 
     def compute_distances(self, query_points, points):
@@ -501,10 +509,11 @@ cdef class Box:
             float[::1] distances = np.empty(
                 n_query_points, dtype=np.float32)
 
-        self.thisptr.computeDistances(
-            <vec3[float]*> &l_query_points[0, 0], n_query_points,
-            <vec3[float]*> &l_points[0, 0], n_points,
-            <float *> &distances[0])
+        with nogil:
+            self.thisptr.computeDistances(
+                <vec3[float]*> &l_query_points[0, 0], n_query_points,
+                <vec3[float]*> &l_points[0, 0], n_points,
+                <float *> &distances[0])
         return np.asarray(distances)
 
     def compute_all_distances(self, query_points, points):
@@ -536,10 +545,11 @@ cdef class Box:
             float[:, ::1] distances = np.empty(
                 [n_query_points, n_points], dtype=np.float32)
 
-        self.thisptr.computeAllDistances(
-            <vec3[float]*> &l_query_points[0, 0], n_query_points,
-            <vec3[float]*> &l_points[0, 0], n_points,
-            <float *> &distances[0, 0])
+        with nogil:
+            self.thisptr.computeAllDistances(
+                <vec3[float]*> &l_query_points[0, 0], n_query_points,
+                <vec3[float]*> &l_points[0, 0], n_points,
+                <float *> &distances[0, 0])
 
         return np.asarray(distances)
 
@@ -586,9 +596,10 @@ cdef class Box:
             np.ones(n_points), dtype=bool)
         cdef cpp_bool[::1] l_contains_mask = contains_mask
 
-        self.thisptr.contains(
-            <vec3[float]*> &l_points[0, 0], n_points,
-            <cpp_bool*> &l_contains_mask[0])
+        with nogil:
+            self.thisptr.contains(
+                <vec3[float]*> &l_points[0, 0], n_points,
+                <cpp_bool*> &l_contains_mask[0])
 
         return np.array(l_contains_mask).astype(bool)
 
@@ -94,11 +94,12 @@ cdef class Cluster(_PairCompute):
                 keys, shape=(num_query_points, ), dtype=np.uint32)
             l_keys_ptr = &l_keys[0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            nlist.get_ptr(),
-            dereference(qargs.thisptr),
-            l_keys_ptr)
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                nlist.get_ptr(),
+                dereference(qargs.thisptr),
+                l_keys_ptr)
         return self
 
     @_Compute._computed_property
@@ -151,6 +152,172 @@ cdef class Cluster(_PairCompute):
             return None
 
 
+cdef class ClusterTracker(_PairCompute):
+    r"""Tracks clusters across the frames of a trajectory with stable ids.
+
+    Each call to :meth:`compute` finds the clusters of the next frame like
+    :class:`freud.cluster.Cluster`, but only the clusters touched by a bond
+    that was added or removed since the previous frame are relabeled.
+    Clusters that only gained bonds are merged along the added bonds, and
+    clusters that lost a bond are split into the connected components of
+    their remaining bonds, while all other clusters keep their points and
+    ids without being visited.
+
+    The new clusters inherit the ids of the previous frame by greedily
+    matching the pairs of previous and new clusters sharing the most points,
+    so a cluster keeps its id while it grows, shrinks or absorbs smaller
+    clusters. A cluster matched with no previous id gets a new id and is
+    recorded in :attr:`splits`, and a previous id matched with no cluster is
+    recorded in :attr:`merges`. The clusters of the first frame are numbered
+    from largest to smallest like those of :class:`freud.cluster.Cluster`.
+
+    Cluster ids are not contiguous: they are less than
+    :attr:`max_cluster_id` and are not reused until :meth:`reset` is called.
+    The number of points must not change between frames.
+
+    Example::
+
+        >>> import freud
+        >>> import numpy as np
+        >>> box = freud.box.Box.cube(10)
+        >>> rng = np.random.default_rng(0)
+        >>> points = box.wrap(box.make_absolute(rng.random((100, 3))))
+        >>> tracker = freud.cluster.ClusterTracker()
+        >>> for frame in range(5):
+        ...     points = box.wrap(points + rng.normal(scale=0.05, size=points.shape))
+        ...     _ = tracker.compute((box, points), neighbors={"r_max": 1.0})
+        >>> tracker.num_frames
+        5
+    """
+
+    cdef freud._cluster.ClusterTracker * thisptr
+
+    def __cinit__(self):
+        self.thisptr = new freud._cluster.ClusterTracker()
+
+    def __init__(self):
+        pass
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, neighbors=None, reset=False):
+        r"""Compute the clusters of the next frame and match them with those
+        of the previous frame.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether to forget the previous frames and number the clusters
+                of this frame afresh (Default value = False).
+        """
+        if reset:
+            self._reset()
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, neighbors=neighbors)
+
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                nlist.get_ptr(),
+                dereference(qargs.thisptr))
+        return self
+
+    def _reset(self):
+        self.thisptr.reset()
+
+    def reset(self):
+        r"""Forget the previous frames, so the clusters of the next frame are
+        numbered afresh."""
+        self._reset()
+        self._called_compute = False
+
+    @_Compute._computed_property
+    def num_frames(self):
+        """int: The number of frames computed since the last reset."""
+        return self.thisptr.getNumFrames()
+
+    @_Compute._computed_property
+    def num_clusters(self):
+        """int: The number of clusters in the last frame."""
+        return self.thisptr.getNumClusters()
+
+    @_Compute._computed_property
+    def max_cluster_id(self):
+        """int: One more than the largest cluster id given out since the last
+        reset."""
+        return self.thisptr.getMaxClusterId()
+
+    @_Compute._computed_property
+    def cluster_idx(self):
+        """(:math:`N_{points}`) :class:`numpy.ndarray`: The stable cluster id
+        of each point."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterIdx(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def cluster_sizes(self):
+        """(:attr:`max_cluster_id`) :class:`numpy.ndarray`: The number of
+        points with each cluster id, which is 0 for ids no longer in use."""
+        return np.asarray(self.thisptr.getClusterSizes(), dtype=np.uint32)
+
+    @_Compute._computed_property
+    def merges(self):
+        """(:math:`N_{merges}`, 2) :class:`numpy.ndarray`: The ids of the
+        clusters of the previous frame that disappeared in the last frame,
+        each with the id of the cluster holding most of its points."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getMerges(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def splits(self):
+        """(:math:`N_{splits}`, 2) :class:`numpy.ndarray`: The ids of the
+        clusters that appeared in the last frame, each with the id of the
+        cluster of the previous frame it shares the most points with."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSplits(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def num_added_bonds(self):
+        """int: The number of bonds of the last frame that were not bonds of
+        the previous frame."""
+        return self.thisptr.getNumAddedBonds()
+
+    @_Compute._computed_property
+    def num_removed_bonds(self):
+        """int: The number of bonds of the previous frame that are not bonds
+        of the last frame."""
+        return self.thisptr.getNumRemovedBonds()
+
+    @_Compute._computed_property
+    def num_relabeled_points(self):
+        """int: The number of points in the clusters touched by the bonds
+        that changed in the last frame."""
+        return self.thisptr.getNumRelabeledPoints()
+
+    def __repr__(self):
+        return "freud.cluster.{cls}()".format(cls=type(self).__name__)
+
+
 cdef class ClusterProperties(_Compute):
     r"""Routines for computing properties of point clusters.
 
@@ -222,9 +389,10 @@ cdef class ClusterProperties(_Compute):
             l_masses = freud.util._convert_array(masses, shape=(len(masses), ))
             l_masses_ptr = &l_masses[0]
 
-        self.thisptr.compute(nq.get_ptr(),
-                             <unsigned int*> &l_cluster_idx[0],
-                             l_masses_ptr)
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(),
+                                 <unsigned int*> &l_cluster_idx[0],
+                                 l_masses_ptr)
         return self
 
     @_Compute._computed_property
@@ -331,8 +499,9 @@ cdef class ClusterProperties(_Compute):
         the center of mass.
 
         """
-        return np.sqrt(np.trace(self.inertia_tensors, axis1=-2, axis2=-1)
-                       /(2*self.cluster_masses))
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterRadiiOfGyration(),
+            freud.util.arr_type_t.FLOAT)
 
     def __repr__(self):
         return "freud.cluster.{cls}()".format(cls=type(self).__name__)
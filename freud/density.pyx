@@ -14,8 +14,9 @@ import numpy as np
 import freud.locality
 
 from cython.operator cimport dereference
+from libcpp.vector cimport vector
 
-from freud.locality cimport _PairCompute, _SpatialHistogram1D
+from freud.locality cimport _PairCompute, _SpatialHistogram, _SpatialHistogram1D
 from freud.util cimport _Compute, vec3
 
 from collections.abc import Sequence
@@ -55,18 +56,46 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
         :code:`None`, we omit accumulating the self-correlation value in the
         first bin.
 
+    .. note::
+        **Mesh:** For dense systems the correlation function can instead be
+        computed on a grid of :code:`mesh` cells spanning the box. The values
+        are summed into the cells and correlated with FFTs, so all pairs of
+        points within :code:`r_max` contribute and distances are resolved to
+        the size of a cell. This requires a box that is periodic in all
+        dimensions, and :code:`neighbors` may not be a
+        :class:`freud.locality.NeighborList`.
+
     Args:
         bins (unsigned int):
             The number of bins in the correlation function.
         r_max (float):
             Maximum pointwise distance to include in the calculation.
+        mesh (int or Sequence[int], optional):
+            The number of grid cells in each dimension (identical in all
+            dimensions if a single integer value is provided) used to
+            correlate the values with FFTs, or :code:`None` to correlate
+            pairs of points (Default value = :code:`None`).
     """  # noqa E501
     cdef freud._density.CorrelationFunction[np.complex128_t] * thisptr
     cdef is_complex
 
-    def __cinit__(self, unsigned int bins, float r_max):
+    def __cinit__(self, unsigned int bins, float r_max, mesh=None):
+        cdef vec3[uint] mesh_vector
+        if mesh is None:
+            mesh_vector = vec3[uint](0, 0, 0)
+        elif isinstance(mesh, int):
+            mesh_vector = vec3[uint](mesh, mesh, mesh)
+        elif isinstance(mesh, Sequence) and len(mesh) == 2:
+            mesh_vector = vec3[uint](mesh[0], mesh[1], 1)
+        elif isinstance(mesh, Sequence) and len(mesh) == 3:
+            mesh_vector = vec3[uint](mesh[0], mesh[1], mesh[2])
+        else:
+            raise ValueError("The mesh must be either a number of cells or a "
+                             "sequence indicating the cells in each spatial "
+                             "dimension (length 2 in 2D, length 3 in 3D).")
         self.thisptr = self.histptr = new \
-            freud._density.CorrelationFunction[np.complex128_t](bins, r_max)
+            freud._density.CorrelationFunction[np.complex128_t](
+                bins, r_max, mesh_vector)
         self.r_max = r_max
         self.is_complex = False
 
@@ -74,7 +103,8 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
         del self.thisptr
 
     def compute(self, system, values, query_points=None,
-                query_values=None, neighbors=None, reset=True):
+                query_values=None, neighbors=None, reset=True,
+                sampling=None):
         r"""Calculates the correlation function and adds to the current
         histogram.
 
@@ -103,6 +133,13 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            sampling (dict, optional):
+                Arguments for accumulating only a random fraction of the
+                query points, with the keys ``fraction``, ``stratified``,
+                ``seed`` and ``num_batches`` as described in
+                :meth:`freud.density.RDF.compute`, or :code:`None` to
+                accumulate all query points. Sampling cannot be combined with
+                a mesh (Default value: None).
         """  # noqa E501
         if reset:
             self.is_complex = False
@@ -114,9 +151,11 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
+            freud.locality._QuerySampling l_sampling
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_values)
 
         # Save if any inputs have been complex so far.
         self.is_complex = self.is_complex or np.any(np.iscomplex(values)) or \
@@ -134,13 +173,26 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
         cdef np.complex128_t[::1] l_values = values
         cdef np.complex128_t[::1] l_query_values = query_values
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <np.complex128_t*> &l_values[0],
-            <vec3[float]*> &l_query_points[0, 0],
-            <np.complex128_t*> &l_query_values[0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        if sampling is not None:
+            l_sampling = freud.locality._QuerySampling(**sampling)
+            with nogil:
+                self.thisptr.accumulateSampled(
+                    nq.get_ptr(),
+                    <np.complex128_t*> &l_values[0],
+                    <vec3[float]*> &l_query_points[0, 0],
+                    <np.complex128_t*> &l_query_values[0],
+                    num_query_points, nlist.get_ptr(),
+                    dereference(qargs.thisptr), l_sampling.sampling)
+            return self
+
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <np.complex128_t*> &l_values[0],
+                <vec3[float]*> &l_query_points[0, 0],
+                <np.complex128_t*> &l_query_values[0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -152,9 +204,32 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             freud.util.arr_type_t.COMPLEX_DOUBLE)
         return output if self.is_complex else np.real(output)
 
+    @_Compute._computed_property
+    def correlation_standard_error(self):
+        """(:math:`N_{bins}`) :class:`numpy.ndarray`: Standard error of the
+        correlation function estimated from the batches of sampled query
+        points, or :code:`None` if the query points were not sampled."""
+        if self.histptr.getNumBatches() == 0:
+            return None
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getCorrelationStandardError(),
+            freud.util.arr_type_t.FLOAT)
+
+    @property
+    def mesh(self):
+        """tuple[int]: The number of grid cells in each dimension, or
+        :code:`None` if pairs of points are correlated."""
+        cdef vec3[uint] mesh = self.thisptr.getMesh()
+        if mesh.x == 0:
+            return None
+        return (mesh.x, mesh.y, mesh.z)
+
     def __repr__(self):
-        return ("freud.density.{cls}(bins={bins}, r_max={r_max})").format(
-            cls=type(self).__name__, bins=self.nbins, r_max=self.r_max)
+        mesh = "" if self.mesh is None else ", mesh={}".format(self.mesh)
+        return ("freud.density.{cls}(bins={bins}, "
+                "r_max={r_max}{mesh})").format(
+            cls=type(self).__name__, bins=self.nbins, r_max=self.r_max,
+            mesh=mesh)
 
     def plot(self, ax=None):
         """Plot complex correlation function.
@@ -203,6 +278,11 @@ cdef class GaussianDensity(_Compute):
     dimensions of the grid are set in the constructor, and can either be set
     equally for all dimensions or for each dimension independently.
 
+    Several values per point (e.g. type indicators and charges) can be
+    smeared at once by passing a two-dimensional array of values, which gives
+    one density grid per column. The Gaussian weight of each grid cell is
+    computed once for all of the columns.
+
     Args:
         width (int or Sequence[int]):
             The number of bins to make the grid in each dimension (identical
@@ -211,10 +291,15 @@ cdef class GaussianDensity(_Compute):
             Distance over which to blur.
         sigma (float):
             Sigma parameter for Gaussian.
+        use_fft (bool, optional):
+            Whether to convolve the values with the Gaussian using FFTs, which
+            requires an orthorhombic box that is periodic in all dimensions.
+            The Gaussian is then not truncated at :code:`r_max`
+            (Default value = :code:`False`).
     """  # noqa: E501
     cdef freud._density.GaussianDensity * thisptr
 
-    def __cinit__(self, width, r_max, sigma):
+    def __cinit__(self, width, r_max, sigma, use_fft=False):
         cdef vec3[uint] width_vector
         if isinstance(width, int):
             width_vector = vec3[uint](width, width, width)
@@ -228,7 +313,7 @@ cdef class GaussianDensity(_Compute):
                              "dimension (length 2 in 2D, length 3 in 3D).")
 
         self.thisptr = new freud._density.GaussianDensity(
-            width_vector, r_max, sigma)
+            width_vector, r_max, sigma, use_fft)
 
     def __dealloc__(self):
         del self.thisptr
@@ -245,36 +330,79 @@ cdef class GaussianDensity(_Compute):
             system:
                 Any object that is a valid argument to
                 :class:`freud.locality.NeighborQuery.from_system`.
-            values ((:math:`N_{points}`) :class:`numpy.ndarray`):
+            values ((:math:`N_{points}`) or (:math:`N_{points}`, :math:`N_{channels}`) :class:`numpy.ndarray`):
                 Values associated with the system points used to calculate the
-                convolution. Calculates Gaussian blur (equivalent to providing
-                a value of 1 for every point) if :code:`None`. (Default value
-                = :code:`None`).
-        """
+                convolution. Each column of a two-dimensional array is smeared
+                into its own channel of the density. Calculates Gaussian blur
+                (equivalent to providing a value of 1 for every point) if
+                :code:`None`. (Default value = :code:`None`).
+        """  # noqa: E501
         cdef freud.locality.NeighborQuery nq = \
             freud.locality.NeighborQuery.from_system(system)
 
         cdef float* l_values_ptr = NULL
-        cdef float[::1] l_values
+        cdef float[:, ::1] l_values
+        cdef unsigned int num_channels = 0
         if values is not None:
-            l_values = freud.util._convert_array(
-                values, shape=(nq.points.shape[0], ))
-            l_values_ptr = &l_values[0]
-
-        self.thisptr.compute(nq.get_ptr(),
-                             l_values_ptr)
+            values = np.asarray(values)
+            if values.ndim == 2:
+                num_channels = values.shape[1]
+                if num_channels == 0:
+                    raise ValueError("The values must have at least one column.")
+                l_values = freud.util._convert_array(
+                    values, shape=(nq.points.shape[0], num_channels))
+            else:
+                l_values = freud.util._convert_array(
+                    values, shape=(nq.points.shape[0], )).reshape(-1, 1)
+            if nq.points.shape[0] > 0:
+                l_values_ptr = &l_values[0, 0]
+
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(),
+                                 l_values_ptr, num_channels)
         return self
 
+    def estimate_memory(self, system, values=None):
+        r"""Estimate the peak memory of :meth:`compute`.
+
+        If FFT convolution would exceed the budget set by
+        :func:`freud.parallel.set_memory_budget`, :meth:`compute` deposits the
+        Gaussians directly instead and the estimate is that of the direct
+        deposition.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            values (:class:`numpy.ndarray`, optional):
+                The values that would be passed to :meth:`compute`.
+                (Default value = :code:`None`).
+
+        Returns:
+            int: The estimated memory in bytes.
+        """
+        cdef freud.locality.NeighborQuery nq = \
+            freud.locality.NeighborQuery.from_system(system)
+        cdef unsigned int num_channels = 0
+        if values is not None and np.ndim(values) == 2:
+            num_channels = np.shape(values)[1]
+        return self.thisptr.estimateMemory(
+            nq.get_ptr().getBox(), nq.points.shape[0],
+            num_channels)
+
     @_Compute._computed_property
     def density(self):
-        """(:math:`w_x`, :math:`w_y`, :math:`w_z`) :class:`numpy.ndarray`: The
-        grid with the Gaussian density contributions from each point."""
-        if self.box.is2D:
-            return np.squeeze(freud.util.make_managed_numpy_array(
-                &self.thisptr.getDensity(), freud.util.arr_type_t.FLOAT))
-        else:
-            return freud.util.make_managed_numpy_array(
-                &self.thisptr.getDensity(), freud.util.arr_type_t.FLOAT)
+        """(:math:`w_x`, :math:`w_y`, :math:`w_z`) or (:math:`N_{channels}`, :math:`w_x`, :math:`w_y`, :math:`w_z`) :class:`numpy.ndarray`:
+        The grid with the Gaussian density contributions from each point, with
+        a leading channel dimension if the values were two-dimensional. The
+        :math:`w_z` dimension is dropped for 2D boxes."""  # noqa: E501
+        density = freud.util.make_managed_numpy_array(
+            &self.thisptr.getDensity(), freud.util.arr_type_t.FLOAT)
+        if not self.box.is2D:
+            return density
+        if self.thisptr.getNumChannels() > 0:
+            return density[..., 0]
+        return np.squeeze(density)
 
     @property
     def r_max(self):
@@ -286,6 +414,11 @@ cdef class GaussianDensity(_Compute):
         """float: Sigma parameter for Gaussian."""
         return self.thisptr.getSigma()
 
+    @property
+    def use_fft(self):
+        """bool: Whether the density is computed by FFT convolution."""
+        return self.thisptr.getUseFFT()
+
     @property
     def width(self):
         """tuple[int]: The number of bins in the grid in each dimension
@@ -295,10 +428,12 @@ cdef class GaussianDensity(_Compute):
 
     def __repr__(self):
         return ("freud.density.{cls}({width}, "
-                "{r_max}, {sigma})").format(cls=type(self).__name__,
-                                            width=self.width,
-                                            r_max=self.r_max,
-                                            sigma=self.sigma)
+                "{r_max}, {sigma}, "
+                "use_fft={use_fft})").format(cls=type(self).__name__,
+                                             width=self.width,
+                                             r_max=self.r_max,
+                                             sigma=self.sigma,
+                                             use_fft=self.use_fft)
 
     def plot(self, ax=None):
         """Plot Gaussian Density.
@@ -377,7 +512,8 @@ cdef class SphereVoxelization(_Compute):
         """
         cdef freud.locality.NeighborQuery nq = \
             freud.locality.NeighborQuery.from_system(system)
-        self.thisptr.compute(nq.get_ptr())
+        with nogil:
+            self.thisptr.compute(nq.get_ptr())
         return self
 
     @_Compute._computed_property
@@ -525,11 +661,12 @@ cdef class LocalDensity(_PairCompute):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
         return self
 
     @property
@@ -612,15 +749,20 @@ cdef class RDF(_SpatialHistogram1D):
             :math:`\frac{N_{query\_points}}{N_{query\_ponts} - 1}` so the RDF
             values will tend to 1 at large :math:`r` for small systems (Default
             value = :code:`'exact'`).
+        log_bins (bool, optional):
+            Whether the bins are logarithmically spaced between ``r_min``,
+            which must then be positive, and ``r_max``. Distances are binned
+            about as fast as with linearly spaced bins (Default value =
+            :code:`False`).
     """
     cdef freud._density.RDF * thisptr
 
     def __cinit__(self, unsigned int bins, float r_max, float r_min=0,
-                  normalization_mode='exact'):
+                  normalization_mode='exact', log_bins=False):
         norm_mode = self._validate_normalization_mode(normalization_mode)
         if type(self) is RDF:
             self.thisptr = self.histptr = new freud._density.RDF(
-                bins, r_max, r_min, norm_mode)
+                bins, r_max, r_min, norm_mode, log_bins)
 
             # r_max is left as an attribute rather than a property for now
             # since that change needs to happen at the _SpatialHistogram level
@@ -641,9 +783,23 @@ cdef class RDF(_SpatialHistogram1D):
             raise ValueError(f"invalid input {mode} for normalization_mode")
 
     def compute(self, system, query_points=None, neighbors=None,
-                reset=True):
+                reset=True, sampling=None):
         r"""Calculates the RDF and adds to the current RDF histogram.
 
+        For a quick look at a large system, only a random fraction of the
+        query points can be accumulated by passing ``sampling``. The sampled
+        query points are dealt into batches whose RDFs are independent
+        estimates, and their spread gives :attr:`rdf_standard_error`. The
+        sampled query points keep their indices, so ``exclude_ii`` still
+        excludes the bonds of each point with itself.
+
+        Example of an RDF accumulated from a tenth of the points::
+
+            >>> box, points = freud.data.make_random_system(10, 1000)
+            >>> rdf = freud.density.RDF(bins=50, r_max=3)
+            >>> rdf.compute((box, points), sampling={"fraction": 0.1})
+            freud.density.RDF(...)
+
         Args:
             system:
                 Any object that is a valid argument to
@@ -652,16 +808,30 @@ cdef class RDF(_SpatialHistogram1D):
                 Query points used to calculate the RDF. Uses the system's
                 points if :code:`None` (Default value =
                 :code:`None`).
-            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
-                Either a :class:`NeighborList <freud.locality.NeighborList>` of
-                neighbor pairs to use in the calculation, or a dictionary of
-                `query arguments
+            neighbors (:class:`freud.locality.NeighborList`, :class:`freud.locality.CompressedNeighborList`, or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` or
+                :class:`CompressedNeighborList
+                <freud.locality.CompressedNeighborList>` of neighbor pairs to
+                use in the calculation, or a dictionary of `query arguments
                 <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
                 (Default value: None).
             reset (bool):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            sampling (dict, optional):
+                Arguments for accumulating only a random fraction of the
+                query points of this frame, or :code:`None` to accumulate all
+                query points (Default value: None). The keys are
+                ``fraction``, the fraction of the query points in
+                :math:`(0, 1]`; ``stratified``, whether one query point is
+                drawn from each run of consecutive indices rather than
+                uniformly (Default value: True); ``seed``, the seed of the
+                random number generator, combined with the number of frames
+                accumulated so far (Default value: 0); and ``num_batches``,
+                the number of batches for the standard error (Default value:
+                10). Frames accumulated with and without sampling, or with
+                different numbers of batches, cannot be combined.
         """  # noqa E501
         if reset:
             self._reset()
@@ -669,17 +839,189 @@ cdef class RDF(_SpatialHistogram1D):
         cdef:
             freud.locality.NeighborQuery nq
             freud.locality.NeighborList nlist
+            freud.locality.CompressedNeighborList cnlist
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
+            freud.locality._QuerySampling l_sampling
+        if isinstance(neighbors, freud.locality.CompressedNeighborList):
+            if sampling is not None:
+                raise ValueError("Query points cannot be sampled with a "
+                                 "CompressedNeighborList.")
+            cnlist = neighbors
+            nq = freud.locality.NeighborQuery.from_system(system)
+            num_query_points = len(nq.points) if query_points is None \
+                else len(query_points)
+            with nogil:
+                self.thisptr.accumulate(nq.get_ptr(), num_query_points,
+                                        cnlist.thisptr)
+            return self
+
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        if sampling is not None:
+            l_sampling = freud.locality._QuerySampling(**sampling)
+            with nogil:
+                self.thisptr.accumulateSampled(
+                    nq.get_ptr(),
+                    <vec3[float]*> &l_query_points[0, 0],
+                    num_query_points, nlist.get_ptr(),
+                    dereference(qargs.thisptr), l_sampling.sampling)
+            return self
+
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
+        return self
+
+    def compute_frames(self, systems, query_points=None, neighbors=None,
+                       reset=True):
+        r"""Calculates the RDF averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but the frames are computed concurrently, so the
+        neighbor finding data structure of one frame is built while the
+        bonds of other frames are binned.
+
+        Example for a trajectory of random systems::
+
+            >>> frames = [
+            ...     freud.data.make_random_system(10, 100, seed=i)
+            ...     for i in range(4)
+            ... ]
+            >>> rdf = freud.density.RDF(bins=50, r_max=3)
+            >>> rdf.compute_frames(frames)
+            freud.density.RDF(...)
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame. If a :class:`freud.locality.GSDTrajectory` is given
+                and ``query_points`` is :code:`None`, the frames are streamed
+                from the file in C++, reading each frame while the previous
+                one is computed.
+            query_points (iterable, optional):
+                Query points of each frame, each a
+                (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`. Uses
+                the points of each system if :code:`None` (Default value =
+                :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used for all frames (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """
+        if (isinstance(systems, freud.locality.GSDTrajectory)
+                and query_points is None):
+            return self._compute_trajectory(systems, neighbors, reset)
+
+        nqs, query_points_list, qargs = self._preprocess_frames(
+            systems, query_points, neighbors)
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality._QueryArgs l_qargs = qargs
+            const float[:, ::1] l_query_points
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            vector[unsigned int] num_query_points
+
+        for nq, l_query_points in zip(nqs, query_points_list):
+            nq_ptrs.push_back(nq.get_ptr())
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+            num_query_points.push_back(l_query_points.shape[0])
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.thisptr.accumulateFrames(
+                nq_ptrs, query_point_ptrs, num_query_points,
+                dereference(l_qargs.thisptr))
+        return self
+
+    def _compute_trajectory(self, freud.locality.GSDTrajectory trajectory,
+                            neighbors, reset):
+        if type(neighbors) is freud.locality.NeighborList:
+            raise ValueError(
+                "Neighbors must be given as a dictionary of query arguments "
+                "when computing several frames.")
+        _, qargs = self._resolve_neighbors(neighbors)
+        cdef freud.locality._QueryArgs l_qargs = qargs
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.thisptr.accumulateTrajectory(
+                dereference(trajectory.thisptr), trajectory.first,
+                trajectory.last, trajectory.stride,
+                dereference(l_qargs.thisptr))
+        return self
+
+    def reduce_domains(self, comm, num_points=None):
+        r"""Combine the RDFs accumulated from the domains of a system by
+        several processes.
+
+        Each process accumulates the bonds of the points it owns in a
+        :class:`freud.locality.DomainDecomposition`: the owned points are the
+        query points, and the owned and ghost points are the points of the
+        system, in the box of the whole system. When the points and query
+        points are the same, the owned points must come first in the points
+        and ``exclude_ii`` must be set so that the bonds of each point with
+        itself are excluded. Every process must accumulate the same frames.
+        This method sums the bin counts of all processes, after which every
+        process holds the RDF of the whole system.
+
+        Example with :mod:`mpi4py`, where ``comm`` is
+        :code:`mpi4py.MPI.COMM_WORLD`::
+
+            decomposition = freud.locality.DomainDecomposition(
+                domains=(2, 2, 1), ghost_width=r_max
+            ).compute((box, points))
+            owned, ghosts = decomposition.domain_indices(comm.rank)
+            local_points = points[np.concatenate((owned, ghosts))]
+            rdf = freud.density.RDF(bins=100, r_max=r_max)
+            rdf.compute(
+                (box, local_points),
+                query_points=points[owned],
+                neighbors={"r_max": r_max, "exclude_ii": True},
+            )
+            rdf.reduce_domains(comm)
+
+        Args:
+            comm:
+                Communicator of the processes, with an :code:`allreduce`
+                method that sums a value over all processes and returns the
+                sum on every process, like :code:`mpi4py.MPI.Comm.allreduce`.
+            num_points (int, optional):
+                The total number of points of the system. Uses the total
+                number of query points if :code:`None`, which is correct when
+                the points and query points are the same (Default value =
+                :code:`None`).
+        """
+        bin_counts = comm.allreduce(
+            np.asarray(self.bin_counts, dtype=np.uint64))
+        n_query_points = comm.allreduce(int(self.thisptr.getNQueryPoints()))
+        if num_points is None:
+            num_points = n_query_points
+        if np.any(bin_counts > np.iinfo(np.uint32).max):
+            raise ValueError("The summed bin counts exceed the range of the "
+                             "histogram.")
+        cdef unsigned int[::1] l_bin_counts = np.ascontiguousarray(
+            bin_counts, dtype=np.uint32)
+        cdef unsigned int l_num_points = num_points
+        cdef unsigned int l_n_query_points = n_query_points
+        self.thisptr.setDomainTotals(
+            &l_bin_counts[0], l_num_points, l_n_query_points)
         return self
 
     @_Compute._computed_property
@@ -690,6 +1032,17 @@ cdef class RDF(_SpatialHistogram1D):
             &self.thisptr.getRDF(),
             freud.util.arr_type_t.FLOAT)
 
+    @_Compute._computed_property
+    def rdf_standard_error(self):
+        """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Standard error of the
+        RDF estimated from the batches of sampled query points, or
+        :code:`None` if the query points were not sampled."""
+        if self.histptr.getNumBatches() == 0:
+            return None
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRDFStandardError(),
+            freud.util.arr_type_t.FLOAT)
+
     @_Compute._computed_property
     def n_r(self):
         """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Histogram of cumulative
@@ -703,10 +1056,12 @@ cdef class RDF(_SpatialHistogram1D):
 
     def __repr__(self):
         return ("freud.density.{cls}(bins={bins}, r_max={r_max}, "
-                "r_min={r_min})").format(cls=type(self).__name__,
-                                         bins=len(self.bin_centers),
-                                         r_max=self.bounds[1],
-                                         r_min=self.bounds[0])
+                "r_min={r_min}, log_bins={log_bins})").format(
+                    cls=type(self).__name__,
+                    bins=len(self.bin_centers),
+                    r_max=self.bounds[1],
+                    r_min=self.bounds[0],
+                    log_bins=self.thisptr.getLogBins())
 
     def plot(self, ax=None):
         """Plot radial distribution function.
@@ -732,3 +1087,371 @@ cdef class RDF(_SpatialHistogram1D):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class PartialRDF(_SpatialHistogram):
+    r"""Computes the partial RDFs :math:`g_{ab}(r)` of all pairs of types of
+    a mixture.
+
+    The bonds are binned by the type of their query point :math:`a`, the type
+    of their point :math:`b` and their length, so the partial RDFs of all
+    pairs of types are accumulated from a single neighbor search instead of
+    one :class:`~.RDF` computation per pair of types. Each partial RDF is
+    normalized like the ``exact`` mode of :class:`~.RDF` with the number of
+    query points :math:`N_a` of type :math:`a` and points :math:`N_b` of type
+    :math:`b`:
+
+    .. math::
+
+        g_{ab}(r) = \frac{V}{N_a N_b} \langle \delta(r) \rangle_{ab}
+
+    so :code:`rdf[a, b]` is equal to the :class:`~.RDF` computed with the
+    points of type :math:`b` and the query points of type :math:`a`.
+
+    .. note::
+        When the points and query points are the same, ``exclude_ii`` must be
+        set (which is the default when ``query_points`` is :code:`None`) so
+        that the bonds of each point with itself are excluded from
+        :math:`g_{aa}(r)`.
+
+    Args:
+        num_types (unsigned int):
+            The number of types. Types are integers from 0 to
+            ``num_types - 1``.
+        bins (unsigned int):
+            The number of bins in the RDFs.
+        r_max (float):
+            Maximum interparticle distance to include in the calculation.
+        r_min (float, optional):
+            Minimum interparticle distance to include in the calculation
+            (Default value = :code:`0`).
+    """
+    cdef freud._density.PartialRDF * thisptr
+
+    def __cinit__(self, unsigned int num_types, unsigned int bins,
+                  float r_max, float r_min=0):
+        if type(self) is PartialRDF:
+            self.thisptr = self.histptr = new freud._density.PartialRDF(
+                num_types, bins, r_max, r_min)
+            self.r_max = r_max
+
+    def __dealloc__(self):
+        if type(self) is PartialRDF:
+            del self.thisptr
+
+    def compute(self, system, types, query_points=None, query_types=None,
+                neighbors=None, reset=True):
+        r"""Calculates the partial RDFs and adds them to the current
+        histograms.
+
+        Example for a binary mixture::
+
+            >>> import numpy as np
+            >>> box, points = freud.data.make_random_system(10, 100, seed=0)
+            >>> types = np.arange(100) % 2
+            >>> prdf = freud.density.PartialRDF(num_types=2, bins=50, r_max=3)
+            >>> prdf.compute((box, points), types)
+            freud.density.PartialRDF(...)
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            types ((:math:`N_{points}`,) :class:`numpy.ndarray`):
+                The type of each point.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to calculate the RDFs. Uses the system's
+                points if :code:`None` (Default value = :code:`None`).
+            query_types ((:math:`N_{query\_points}`,) :class:`numpy.ndarray`, optional):
+                The type of each query point. Required if ``query_points`` are
+                given, and uses ``types`` otherwise (Default value =
+                :code:`None`).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>`
+                of neighbor pairs to use in the calculation, or a dictionary
+                of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        if (query_points is None) != (query_types is None):
+            raise ValueError(
+                "query_types must be provided if and only if query_points "
+                "are provided.")
+        if reset:
+            self._reset()
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        cdef const unsigned int[::1] l_types = freud.util._convert_array(
+            types, shape=(nq.points.shape[0], ), dtype=np.uint32)
+        cdef const unsigned int[::1] l_query_types = l_types
+        if query_types is not None:
+            l_query_types = freud.util._convert_array(
+                query_types, shape=(num_query_points, ), dtype=np.uint32)
+
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(), &l_types[0],
+                <vec3[float]*> &l_query_points[0, 0], &l_query_types[0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
+        return self
+
+    @property
+    def num_types(self):
+        """unsigned int: The number of types."""
+        return self.thisptr.getNumTypes()
+
+    @_Compute._computed_property
+    def rdf(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`)
+        :class:`numpy.ndarray`: The partial RDFs, indexed by the type of the
+        query points and the type of the points."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRDF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def n_r(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`)
+        :class:`numpy.ndarray`: Cumulative bin counts. :code:`n_r[a, b, i]`
+        is the average number of points of type :code:`b` within a ball of
+        radius :code:`bin_edges[i+1]` centered at a query point of type
+        :code:`a`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getNr(),
+            freud.util.arr_type_t.FLOAT)
+
+    @property
+    def bin_centers(self):
+        """:math:`(N_{bins}, )` :class:`numpy.ndarray`: The centers of each
+        bin of distances."""
+        vec = self.histptr.getBinCenters()
+        return np.array(vec[2], copy=True)
+
+    @property
+    def bin_edges(self):
+        """:math:`(N_{bins}+1, )` :class:`numpy.ndarray`: The edges of each
+        bin of distances."""
+        vec = self.histptr.getBinEdges()
+        return np.array(vec[2], copy=True)
+
+    @property
+    def bounds(self):
+        """tuple: A tuple indicating the lower and upper bounds of the
+        distances."""
+        vec = self.histptr.getBounds()
+        return vec[2]
+
+    @property
+    def nbins(self):
+        """int: The number of bins of distances."""
+        return self.histptr.getAxisSizes()[2]
+
+    def __repr__(self):
+        return ("freud.density.{cls}(num_types={num_types}, bins={bins}, "
+                "r_max={r_max}, r_min={r_min})").format(
+                    cls=type(self).__name__, num_types=self.num_types,
+                    bins=self.nbins, r_max=self.bounds[1],
+                    r_min=self.bounds[0])
+
+
+cdef class VanHove(_SpatialHistogram):
+    r"""Computes the self and distinct parts of the Van Hove correlation
+    function :math:`G(r, t)` of a trajectory.
+
+    For each lag :math:`t`, the distinct part is the density of particles
+    :math:`j` at a distance :math:`r` at time :math:`t_0 + t` from a
+    different particle :math:`i` at time :math:`t_0`, normalized like the
+    ``exact`` mode of :class:`~.RDF`:
+
+    .. math::
+
+        G_d(r, t) = \frac{V}{N^2} \left\langle \sum_{i} \sum_{j \neq i}
+        \delta(r - |\vec{r}_j(t_0 + t) - \vec{r}_i(t_0)|) \right\rangle
+
+    so :math:`G_d(r, 0)` is the RDF and :math:`G_d(r, t)` tends to 1 at large
+    :math:`r`. The self part is the probability density of the displacement
+    of a particle over a time :math:`t`:
+
+    .. math::
+
+        G_s(r, t) = \frac{1}{N} \left\langle \sum_{i}
+        \delta(r - |\vec{r}_i(t_0 + t) - \vec{r}_i(t_0)|) \right\rangle
+
+    Every frame is a time origin :math:`t_0` for each lag that fits in the
+    trajectory. One :class:`freud.locality.AABBQuery` is built from each
+    origin frame and queried with the frames of all lags at once, rather than
+    building a tree for every pair of frames as when computing :class:`~.RDF`
+    with ``query_points`` from another frame.
+
+    .. note::
+        The box and the number of particles must be constant over the
+        trajectory.
+
+    Args:
+        lags (:math:`(N_{lags}, )` :class:`numpy.ndarray`):
+            The lags, in frames, at which :math:`G(r, t)` is computed.
+        bins (unsigned int):
+            The number of bins of distances.
+        r_max (float):
+            Maximum distance to include in the calculation.
+        r_min (float, optional):
+            Minimum distance to include in the calculation (Default value =
+            :code:`0`).
+    """
+    cdef freud._density.VanHove * thisptr
+
+    def __cinit__(self, lags, unsigned int bins, float r_max, float r_min=0):
+        cdef vector[unsigned int] l_lags = freud.util._convert_array(
+            lags, shape=(None, ), dtype=np.uint32)
+        if type(self) is VanHove:
+            self.thisptr = self.histptr = new freud._density.VanHove(
+                l_lags, bins, r_max, r_min)
+            self.r_max = r_max
+
+    def __dealloc__(self):
+        if type(self) is VanHove:
+            del self.thisptr
+
+    def compute(self, system, images=None, reset=True):
+        r"""Calculates the Van Hove correlation function of a trajectory and
+        adds it to the current histograms.
+
+        Example::
+
+            >>> import numpy as np
+            >>> box = freud.box.Box.cube(10)
+            >>> rng = np.random.default_rng(0)
+            >>> steps = rng.normal(scale=0.1, size=(20, 100, 3))
+            >>> positions = box.make_absolute(rng.random((100, 3))) + np.cumsum(
+            ...     steps, axis=0
+            ... )
+            >>> vh = freud.density.VanHove(lags=[0, 1, 5], bins=50, r_max=3)
+            >>> vh.compute((box, positions))
+            freud.density.VanHove(...)
+
+        Args:
+            system (tuple):
+                A tuple of a :class:`freud.box.Box` and the
+                (:math:`N_{frames}`, :math:`N_{particles}`, 3) positions of
+                consecutive frames of the trajectory. The positions must be
+                unwrapped unless ``images`` are provided.
+            images ((:math:`N_{frames}`, :math:`N_{particles}`, 3) :class:`numpy.ndarray`, optional):
+                The particle images to unwrap the positions with. If
+                :code:`None`, the positions are assumed to be unwrapped
+                already (Default value = :code:`None`).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        if reset:
+            self._reset()
+
+        cdef:
+            freud.box.Box b
+            const float[:, :, ::1] l_positions
+            unsigned int num_frames
+            unsigned int num_particles
+
+        box, positions = system
+        b = freud.util._convert_box(box)
+        positions = freud.util._convert_array(
+            positions, shape=(None, None, 3))
+        if images is not None:
+            images = freud.util._convert_array(
+                images, shape=positions.shape, dtype=np.int32)
+            positions = np.stack(
+                [b.unwrap(frame.copy(), frame_images)
+                 for frame, frame_images in zip(positions, images)])
+        l_positions = positions
+        num_frames = l_positions.shape[0]
+        num_particles = l_positions.shape[1]
+        with nogil:
+            self.thisptr.accumulate(
+                dereference(b.thisptr), <vec3[float]*> &l_positions[0, 0, 0],
+                num_frames, num_particles)
+        return self
+
+    @property
+    def lags(self):
+        """:math:`(N_{lags}, )` :class:`numpy.ndarray`: The lags, in
+        frames."""
+        return np.array(self.thisptr.getLags(), dtype=np.uint32)
+
+    @_Compute._computed_property
+    def num_origins(self):
+        """:math:`(N_{lags}, )` :class:`numpy.ndarray`: The number of time
+        origins averaged over for each lag."""
+        return np.array(self.thisptr.getNumOrigins(), dtype=np.uint32)
+
+    @_Compute._computed_property
+    def distinct(self):
+        """(:math:`N_{lags}`, :math:`N_{bins}`) :class:`numpy.ndarray`: The
+        distinct part :math:`G_d(r, t)`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getDistinct(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def self_part(self):
+        """(:math:`N_{lags}`, :math:`N_{bins}`) :class:`numpy.ndarray`: The
+        self part :math:`G_s(r, t)`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSelf(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def self_bin_counts(self):
+        """(:math:`N_{lags}`, :math:`N_{bins}`) :class:`numpy.ndarray`: The
+        histogram of particle displacements. The distinct pairs are counted
+        in :attr:`bin_counts`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSelfBinCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @property
+    def bin_centers(self):
+        """:math:`(N_{bins}, )` :class:`numpy.ndarray`: The centers of each
+        bin of distances."""
+        vec = self.histptr.getBinCenters()
+        return np.array(vec[1], copy=True)
+
+    @property
+    def bin_edges(self):
+        """:math:`(N_{bins}+1, )` :class:`numpy.ndarray`: The edges of each
+        bin of distances."""
+        vec = self.histptr.getBinEdges()
+        return np.array(vec[1], copy=True)
+
+    @property
+    def bounds(self):
+        """tuple: A tuple indicating the lower and upper bounds of the
+        distances."""
+        vec = self.histptr.getBounds()
+        return vec[1]
+
+    @property
+    def nbins(self):
+        """int: The number of bins of distances."""
+        return self.histptr.getAxisSizes()[1]
+
+    def __repr__(self):
+        return ("freud.density.{cls}(lags={lags}, bins={bins}, "
+                "r_max={r_max}, r_min={r_min})").format(
+                    cls=type(self).__name__, lags=self.lags.tolist(),
+                    bins=self.nbins, r_max=self.bounds[1],
+                    r_min=self.bounds[0])
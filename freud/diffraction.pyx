@@ -12,22 +12,23 @@ diffraction pattern of particles in systems with long range order.
 finalized in a future release.
 """
 
+from cython.operator cimport dereference
 from libcpp cimport bool as cbool
 from libcpp.vector cimport vector
 
-from freud.util cimport _Compute, vec3
+from freud.util cimport _Compute, quat, vec3
 
 import logging
 
 import numpy as np
 import rowan
-import scipy.ndimage
 
 import freud.locality
 
 cimport numpy as np
 
 cimport freud._diffraction
+cimport freud.box
 cimport freud.locality
 cimport freud.util
 
@@ -118,6 +119,18 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
     .. note::
         This code assumes all particles have a form factor :math:`f` of 1.
 
+    For large systems, the cost of evaluating every term of the sum above for
+    every :math:`k` value can be avoided by providing a
+    ``distance_bin_width``. The pair distances are then binned into a histogram
+    and :math:`S(k)` is evaluated once per histogram bin, using the bin center
+    as the distance of all pairs in the bin. This reduces the cost from
+    :math:`O(N^2 N_k)` to :math:`O(N^2 + N_r N_k)`, where :math:`N_r` is the
+    number of distance bins. Since the derivatives of :math:`\text{sinc}` and
+    :math:`J_0` are bounded by 1, each term changes by at most
+    :math:`k \Delta r / 2` for a bin width :math:`\Delta r`, so the bin width
+    should be much smaller than :math:`1 / k_{max}`. Pairs of coincident points
+    are always counted exactly.
+
     Partial structure factors can be computed by providing a set of
     ``query_points`` and the total number of points in the system ``N_total`` to
     the :py:meth:`compute` method. The normalization criterion is based on the
@@ -140,15 +153,23 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
             are practical restrictions on the validity of the calculation in the
             long wavelength regime, see :py:attr:`min_valid_k` (Default value =
             0).
+        distance_bin_width (float, optional):
+            If provided, :math:`S(k)` is approximated from a histogram of pair
+            distances with bins of this width instead of being summed over all
+            pairs (Default value = :code:`None`).
     """
     cdef freud._diffraction.StaticStructureFactorDebye * thisptr
 
-    def __cinit__(self, unsigned int num_k_values, float k_max, float k_min=0):
+    def __cinit__(self, unsigned int num_k_values, float k_max, float k_min=0,
+                  distance_bin_width=None):
+        if distance_bin_width is None:
+            distance_bin_width = 0
+        elif distance_bin_width <= 0:
+            raise ValueError("distance_bin_width must be positive.")
         if type(self) is StaticStructureFactorDebye:
             self.thisptr = self.ssfptr = new \
-                freud._diffraction.StaticStructureFactorDebye(num_k_values,
-                                                              k_max,
-                                                              k_min)
+                freud._diffraction.StaticStructureFactorDebye(
+                    num_k_values, k_max, k_min, distance_bin_width)
 
     def __dealloc__(self):
         if type(self) is StaticStructureFactorDebye:
@@ -159,6 +180,32 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
         """int: The number of k values used."""
         return len(self.k_values)
 
+    @property
+    def distance_bin_width(self):
+        """float: The width of the pair distance histogram bins, or
+        :code:`None` if :math:`S(k)` is summed over all pairs."""
+        distance_bin_width = self.thisptr.getDistanceBinWidth()
+        return distance_bin_width if distance_bin_width > 0 else None
+
+    def estimate_memory(self, box):
+        r"""Estimate the peak memory of computing in a box.
+
+        The pair distances are never stored, so the estimate does not depend
+        on the number of points. It accounts for the thread local copies of
+        :math:`S(k)` within the budget set by
+        :func:`freud.parallel.set_memory_budget`.
+
+        Args:
+            box (:class:`freud.box.Box`):
+                Simulation box, or any object that is a valid argument to
+                :meth:`freud.box.Box.from_box`.
+
+        Returns:
+            int: The estimated memory in bytes.
+        """
+        cdef freud.box.Box b = freud.util._convert_box(box)
+        return self.thisptr.estimateMemory(dereference(b.thisptr))
+
     @property
     def k_values(self):
         """:class:`numpy.ndarray`: The :math:`k` values for the calculation."""
@@ -251,11 +298,13 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
 
         if N_total is None:
             N_total = num_query_points
+        cdef unsigned int l_N_total = N_total
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, N_total)
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, l_N_total)
         return self
 
     def _reset(self):
@@ -270,11 +319,13 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
 
     def __repr__(self):
         return ("freud.diffraction.{cls}(num_k_values={num_k_values}, "
-                "k_max={k_max}, k_min={k_min})").format(
+                "k_max={k_max}, k_min={k_min}, "
+                "distance_bin_width={distance_bin_width})").format(
                     cls=type(self).__name__,
                     num_k_values=self.num_k_values,
                     k_max=self.k_max,
-                    k_min=self.k_min)
+                    k_min=self.k_min,
+                    distance_bin_width=self.distance_bin_width)
 
     def plot(self, ax=None, **kwargs):
         r"""Plot static structure factor.
@@ -365,16 +416,35 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
             from the full grid with uniform radial density, resulting in a
             sample of ``num_sampled_k_points`` vectors on average (Default
             value = 0).
+        grid_size (unsigned int, optional):
+            If provided, the scattering amplitudes are computed with a
+            particle-mesh method instead of summing over every pair of
+            particle and :math:`\vec{k}` vector. The particles are assigned
+            to a periodic grid of ``grid_size`` points along each box vector
+            with a triangular-shaped cloud window, the grid is Fourier
+            transformed, and the window is divided out of the transform. The
+            cost is :math:`O(N + M^3 \log M)` for :math:`M` = ``grid_size``
+            rather than :math:`O(N N_k)` for :math:`N_k` sampled
+            :math:`\vec{k}` vectors. The grid must resolve ``k_max``, i.e.
+            ``grid_size`` must exceed :math:`k_{max} L / \pi` for every box
+            dimension :math:`L`; the result approaches the direct sum as
+            ``grid_size`` grows. If :code:`None`, the direct sum is used
+            (Default value = :code:`None`).
     """
 
     cdef freud._diffraction.StaticStructureFactorDirect * thisptr
 
     def __cinit__(self, unsigned int bins, float k_max, float k_min=0,
-                  unsigned int num_sampled_k_points=0):
+                  unsigned int num_sampled_k_points=0, grid_size=None):
+        cdef unsigned int l_grid_size = 0
+        if grid_size is not None:
+            if grid_size < 2:
+                raise ValueError("grid_size must be at least 2.")
+            l_grid_size = grid_size
         if type(self) is StaticStructureFactorDirect:
             self.thisptr = self.ssfptr = \
                 new freud._diffraction.StaticStructureFactorDirect(
-                    bins, k_max, k_min, num_sampled_k_points)
+                    bins, k_max, k_min, num_sampled_k_points, l_grid_size)
 
     def __dealloc__(self):
         if type(self) is StaticStructureFactorDirect:
@@ -402,7 +472,8 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
         bin_edges = self.bin_edges
         return (bin_edges[0], bin_edges[len(bin_edges)-1])
 
-    def compute(self, system, query_points=None, N_total=None, reset=True):
+    def compute(self, system, query_points=None, N_total=None, reset=True,
+                comm=None):
         r"""Computes static structure factor.
 
         Example for a single component system::
@@ -455,8 +526,20 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value = True).
+            comm (optional):
+                Communicator of several processes that each hold the points
+                of one domain of the system, e.g. with
+                :class:`freud.locality.DomainDecomposition` (no ghost points
+                are needed). The scattering amplitudes of the points of each
+                process are summed with :code:`comm.allreduce`, like
+                :code:`mpi4py.MPI.Comm.allreduce`, so every process obtains
+                the structure factor of the whole system. All processes must
+                pass the box of the whole system. If ``N_total`` is
+                :code:`None`, it is the total number of points of all
+                processes. If :code:`None`, the system is computed by this
+                process alone (Default value = :code:`None`).
         """  # noqa E501
-        if (query_points is None) != (N_total is None):
+        if (query_points is None) != (N_total is None) and comm is None:
             raise ValueError(
                 "If query_points are provided, N_total must also be provided "
                 "in order to correctly compute the normalization of the "
@@ -484,12 +567,160 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
             l_query_points_ptr = <vec3[float]*> &l_query_points[0, 0]
 
         if N_total is None:
-            N_total = num_points
+            N_total = num_points if comm is None else \
+                comm.allreduce(int(num_points))
+        cdef unsigned int l_N_total = N_total
+
+        if comm is None:
+            with nogil:
+                self.thisptr.accumulate(
+                    nq.get_ptr(),
+                    l_query_points_ptr, num_query_points, l_N_total
+                )
+            return self
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            l_query_points_ptr, num_query_points, N_total
-        )
+        cdef:
+            float complex[::1] l_F_k_points
+            float complex[::1] l_F_k_query_points
+            const float complex* l_F_k_points_ptr = NULL
+            const float complex* l_F_k_query_points_ptr = NULL
+
+        # The amplitudes of the processes are summed in double precision.
+        with nogil:
+            self.thisptr.computeAmplitudes(
+                nq.get_ptr(),
+                l_query_points_ptr, num_query_points, l_N_total
+            )
+        l_F_k_points = np.ascontiguousarray(comm.allreduce(
+            freud.util.make_managed_numpy_array(
+                &self.thisptr.getPointAmplitudes(),
+                freud.util.arr_type_t.COMPLEX_FLOAT).astype(np.complex128)
+        ), dtype=np.complex64)
+        if l_F_k_points.shape[0] > 0:
+            l_F_k_points_ptr = &l_F_k_points[0]
+        if query_points is not None:
+            l_F_k_query_points = np.ascontiguousarray(comm.allreduce(
+                freud.util.make_managed_numpy_array(
+                    &self.thisptr.getQueryPointAmplitudes(),
+                    freud.util.arr_type_t.COMPLEX_FLOAT).astype(np.complex128)
+            ), dtype=np.complex64)
+            if l_F_k_query_points.shape[0] > 0:
+                l_F_k_query_points_ptr = &l_F_k_query_points[0]
+        with nogil:
+            self.thisptr.accumulateAmplitudes(
+                l_F_k_points_ptr, l_F_k_query_points_ptr)
+        return self
+
+    def compute_frames(self, systems, query_points=None, N_total=None,
+                       reset=True):
+        r"""Computes the static structure factor averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but consecutive frames in the same box reuse the
+        sampled :math:`\vec{k}` vectors and are computed concurrently.
+
+        Example for a trajectory of random systems::
+
+            >>> box = freud.box.Box.cube(10)
+            >>> frames = [
+            ...     (box, freud.data.make_random_system(10, 100, seed=i)[1])
+            ...     for i in range(4)
+            ... ]
+            >>> sf = freud.diffraction.StaticStructureFactorDirect(
+            ...     bins=100, k_max=10, k_min=0
+            ... )
+            >>> sf.compute_frames(frames)
+            freud.diffraction.StaticStructureFactorDirect(...)
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame. If a :class:`freud.locality.GSDTrajectory` is given
+                and ``query_points`` is :code:`None`, the frames are streamed
+                from the file in C++, reading each frame while the previous
+                one is computed.
+            query_points (iterable, optional):
+                Query points of each frame used to calculate the partial
+                structure factor, each a (:math:`N_{query\_points}`, 3)
+                :class:`numpy.ndarray`. Every frame must have the same number
+                of query points. If :code:`None`, the full scattering is
+                computed. (Default value = :code:`None`).
+            N_total (int, optional):
+                Total number of points in each frame. This is required if
+                ``query_points`` are provided. (Default value = :code:`None`).
+            reset (bool, optional):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value = True).
+        """
+        if (query_points is None) != (N_total is None):
+            raise ValueError(
+                "If query_points are provided, N_total must also be provided "
+                "in order to correctly compute the normalization of the "
+                "partial structure factor."
+            )
+        cdef freud.locality.GSDTrajectory trajectory
+        if (isinstance(systems, freud.locality.GSDTrajectory)
+                and query_points is None):
+            trajectory = systems
+            if reset:
+                self._reset()
+            with nogil:
+                self.ssfptr.accumulateTrajectory(
+                    dereference(trajectory.thisptr), trajectory.first,
+                    trajectory.last, trajectory.stride)
+            return self
+
+        # Keep references to the NeighborQuery objects and query point arrays
+        # so that they outlive the C++ computation.
+        nqs = []
+        for system in systems:
+            temp_nq = freud.locality.NeighborQuery.from_system(system)
+            nqs.append(freud.locality.NeighborQuery.from_system(
+                (temp_nq.box, freud.util._convert_array(temp_nq.points))))
+        l_query_points_list = []
+        if query_points is not None:
+            l_query_points_list = [
+                freud.util._convert_array(qp) for qp in query_points]
+            if len(l_query_points_list) != len(nqs):
+                raise ValueError(
+                    "query_points must be provided for every frame.")
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            const float[:, ::1] l_query_points
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            unsigned int num_query_points = 0
+
+        for nq in nqs:
+            nq_ptrs.push_back(nq.get_ptr())
+        for i, l_query_points in enumerate(l_query_points_list):
+            if i == 0:
+                num_query_points = l_query_points.shape[0]
+            elif l_query_points.shape[0] != num_query_points:
+                raise ValueError(
+                    "Every frame must have the same number of query_points.")
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+
+        if N_total is None:
+            if len(nqs) == 0:
+                N_total = 0
+            else:
+                N_total = len(nqs[0].points)
+                if any(len(frame.points) != N_total for frame in nqs):
+                    raise ValueError(
+                        "Every frame must have the same number of points "
+                        "unless N_total is provided.")
+
+        cdef unsigned int l_N_total = N_total
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.thisptr.accumulateFrames(
+                nq_ptrs, query_point_ptrs, num_query_points, l_N_total)
         return self
 
     def _reset(self):
@@ -508,6 +739,13 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
         constructing :math:`k` space grid."""
         return self.thisptr.getNumSampledKPoints()
 
+    @property
+    def grid_size(self):
+        """int: The number of grid points along each box vector used by the
+        particle-mesh method, or :code:`None` if the direct sum is used."""
+        cdef unsigned int grid_size = self.thisptr.getGridSize()
+        return None if grid_size == 0 else grid_size
+
     @_Compute._computed_property
     def k_points(self):
         r""":class:`numpy.ndarray`: The :math:`\vec{k}` points used in the
@@ -518,12 +756,14 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
     def __repr__(self):
         return ("freud.diffraction.{cls}(bins={bins}, "
                 "k_max={k_max}, k_min={k_min}, "
-                "num_sampled_k_points={num_sampled_k_points})").format(
+                "num_sampled_k_points={num_sampled_k_points}, "
+                "grid_size={grid_size})").format(
                     cls=type(self).__name__,
                     bins=self.nbins,
                     k_max=self.k_max,
                     k_min=self.k_min,
-                    num_sampled_k_points=self.num_sampled_k_points)
+                    num_sampled_k_points=self.num_sampled_k_points,
+                    grid_size=self.grid_size)
 
     def plot(self, ax=None, **kwargs):
         r"""Plot static structure factor.
@@ -549,6 +789,258 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
                                     ax=ax)
 
 
+cdef class IntermediateScatteringFunction(_Compute):
+    r"""Accumulates the intermediate scattering function of a trajectory.
+
+    The collective intermediate scattering function
+
+    .. math::
+
+        F(k, t) = \left\langle \frac{1}{N} \sum_{i=0}^{N} \sum_{j=0}^{N}
+        e^{i\vec{k} \cdot (\vec{r}_i(t_0 + t) - \vec{r}_j(t_0))}
+        \right\rangle
+
+    is averaged over the :math:`\vec{k}` vectors of each bin of :math:`k`
+    and over the time origins :math:`t_0`, so that :math:`F(k, 0)` is the
+    static structure factor computed by
+    :class:`freud.diffraction.StaticStructureFactorDirect`. The
+    :math:`\vec{k}` vectors are sampled in the same way, for the box of the
+    first frame.
+
+    The scattering amplitudes of each frame are computed once (directly or
+    with the particle-mesh method of ``grid_size``) and stored in a
+    multiple-tau correlator :cite:`Ramirez2010`, like
+    :class:`freud.msd.StreamingMSD`, so the frames are provided one at a time
+    (or in chunks) and the lags are logarithmically spaced. Correlating two
+    frames costs :math:`O(N_k)` for :math:`N_k` sampled :math:`\vec{k}`
+    vectors rather than the :math:`O(N N_k)` of computing their amplitudes.
+
+    If ``self_part`` is True, the self part
+
+    .. math::
+
+        F_s(k, t) = \left\langle \frac{1}{N} \sum_{j=0}^{N}
+        e^{i\vec{k} \cdot (\vec{r}_j(t_0 + t) - \vec{r}_j(t_0))}
+        \right\rangle
+
+    is also accumulated at the same lags from the displacements of the
+    particles, which costs :math:`O(N N_k)` per pair of frames.
+
+    .. note::
+        The box and the number of particles must be constant over the
+        trajectory. The positions must be unwrapped if the self part is
+        computed. 2D boxes are not supported.
+
+    Args:
+        bins (unsigned int):
+            Number of bins in :math:`k` space.
+        k_max (float):
+            Maximum :math:`k` value to include in the calculation.
+        k_min (float, optional):
+            Minimum :math:`k` value included in the calculation (Default
+            value = 0).
+        num_sampled_k_points (unsigned int, optional):
+            The desired number of :math:`\vec{k}` vectors to sample, as in
+            :class:`freud.diffraction.StaticStructureFactorDirect`. If set to
+            0, all :math:`\vec{k}` vectors are used (Default value = 0).
+        grid_size (unsigned int, optional):
+            If provided, the scattering amplitudes are computed with the
+            particle-mesh method of
+            :class:`freud.diffraction.StaticStructureFactorDirect`. If
+            :code:`None`, the direct sum is used (Default value =
+            :code:`None`).
+        points_per_level (unsigned int, optional):
+            Number of frames held in each level of the correlator. (Default
+            value = 16).
+        level_factor (unsigned int, optional):
+            Ratio of the frame spacings of consecutive levels, which must be
+            at least 2 and less than :code:`points_per_level`. (Default value
+            = 2).
+        self_part (bool, optional):
+            Whether to also accumulate the self part :math:`F_s(k, t)`
+            (Default value = False).
+    """
+    cdef freud._diffraction.IntermediateScatteringFunction * thisptr
+
+    def __cinit__(self, unsigned int bins, float k_max, float k_min=0,
+                  unsigned int num_sampled_k_points=0, grid_size=None,
+                  unsigned int points_per_level=16,
+                  unsigned int level_factor=2, cbool self_part=False):
+        cdef unsigned int l_grid_size = 0
+        if grid_size is not None:
+            if grid_size < 2:
+                raise ValueError("grid_size must be at least 2.")
+            l_grid_size = grid_size
+        self.thisptr = new freud._diffraction.IntermediateScatteringFunction(
+            bins, k_max, k_min, num_sampled_k_points, l_grid_size,
+            points_per_level, level_factor, self_part)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, reset=True):
+        r"""Add frames of a trajectory to the intermediate scattering
+        function.
+
+        Example::
+
+            >>> import freud
+            >>> import numpy as np
+            >>> box = freud.box.Box.cube(10)
+            >>> isf = freud.diffraction.IntermediateScatteringFunction(
+            ...     bins=10, k_max=5, num_sampled_k_points=1000
+            ... )
+            >>> rng = np.random.default_rng(0)
+            >>> positions = box.make_absolute(rng.random((100, 3)))
+            >>> for frame in range(20):
+            ...     positions += rng.normal(scale=0.1, size=positions.shape)
+            ...     _ = isf.compute((box, positions), reset=False)
+            >>> isf.lags[:4]
+            array([0, 1, 2, 3], dtype=uint32)
+
+        Args:
+            system (tuple or :class:`freud.locality.GSDTrajectory`):
+                A tuple of a :class:`freud.box.Box` and the
+                (:math:`N_{particles}`, 3) positions of one frame or the
+                (:math:`N_{frames}`, :math:`N_{particles}`, 3) positions of
+                consecutive frames of the trajectory. If a
+                :class:`freud.locality.GSDTrajectory` is given, its frames
+                are streamed from the file in C++ and unwrapped with the
+                images stored in the file.
+            reset (bool):
+                Whether to erase the previously added frames before adding
+                these frames; if False, the frames continue the trajectory
+                (Default value: True).
+        """
+        cdef:
+            freud.box.Box b
+            const float[:, :, ::1] l_positions
+            unsigned int num_frames
+            unsigned int num_particles
+            unsigned int frame
+            freud.locality.GSDTrajectory trajectory
+
+        if reset:
+            self.thisptr.reset()
+
+        if isinstance(system, freud.locality.GSDTrajectory):
+            trajectory = system
+            with nogil:
+                self.thisptr.updateTrajectory(
+                    dereference(trajectory.thisptr), trajectory.first,
+                    trajectory.last, trajectory.stride)
+            return self
+
+        box, positions = system
+        b = freud.util._convert_box(box)
+        positions = np.asarray(positions)
+        if positions.ndim == 2:
+            positions = positions[np.newaxis]
+        l_positions = freud.util._convert_array(
+            positions, shape=(None, None, 3))
+        num_frames = l_positions.shape[0]
+        num_particles = l_positions.shape[1]
+        with nogil:
+            for frame in range(num_frames):
+                self.thisptr.update(
+                    dereference(b.thisptr),
+                    <vec3[float]*> &l_positions[frame, 0, 0], num_particles)
+        return self
+
+    @property
+    def nbins(self):
+        """float: Number of bins in the histogram."""
+        return len(self.bin_centers)
+
+    @property
+    def bin_edges(self):
+        """:class:`numpy.ndarray`: The edges of each bin of :math:`k`."""
+        return np.array(self.thisptr.getBinEdges(), copy=True)
+
+    @property
+    def bin_centers(self):
+        """:class:`numpy.ndarray`: The centers of each bin of :math:`k`."""
+        return np.array(self.thisptr.getBinCenters(), copy=True)
+
+    @property
+    def bounds(self):
+        """tuple: A tuple indicating upper and lower bounds of the
+        histogram."""
+        bin_edges = self.bin_edges
+        return (bin_edges[0], bin_edges[len(bin_edges)-1])
+
+    @property
+    def points_per_level(self):
+        """unsigned int: Number of frames held in each level."""
+        return self.thisptr.getPointsPerLevel()
+
+    @property
+    def level_factor(self):
+        """unsigned int: Ratio of the frame spacings of consecutive levels."""
+        return self.thisptr.getLevelFactor()
+
+    @property
+    def self_part(self):
+        """bool: Whether the self part is accumulated."""
+        return self.thisptr.getSelfPart()
+
+    @_Compute._computed_property
+    def num_frames(self):
+        """unsigned int: Number of frames added since the last reset."""
+        return self.thisptr.getNumFrames()
+
+    @_Compute._computed_property
+    def k_points(self):
+        r""":class:`numpy.ndarray`: The :math:`\vec{k}` points used in the
+        calculation."""
+        cdef vector[vec3[float]] k_points = self.thisptr.getKPoints()
+        return np.asarray([[k.x, k.y, k.z] for k in k_points])
+
+    @_Compute._computed_property
+    def lags(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The lags,
+        in frames, at which the intermediate scattering function is
+        accumulated."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getLags(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def F_kt(self):
+        """:math:`\\left(N_{lags}, N_{bins} \\right)` :class:`numpy.ndarray`:
+        The collective intermediate scattering function :math:`F(k, t)` at
+        each lag."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getISF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def F_s_kt(self):
+        """:math:`\\left(N_{lags}, N_{bins} \\right)` :class:`numpy.ndarray`:
+        The self part :math:`F_s(k, t)` at each lag, empty unless
+        ``self_part`` is True."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSelfISF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def counts(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The number
+        of pairs of frames averaged over at each lag."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    def __repr__(self):
+        return ("freud.diffraction.{cls}(bins={bins}, k_max={k_max}, "
+                "k_min={k_min}, points_per_level={p}, level_factor={m}, "
+                "self_part={self_part})").format(
+                    cls=type(self).__name__, bins=self.nbins,
+                    k_max=self.bounds[1], k_min=self.bounds[0],
+                    p=self.points_per_level, m=self.level_factor,
+                    self_part=self.self_part)
+
+
 cdef class DiffractionPattern(_Compute):
     r"""Computes a 2D diffraction pattern.
 
@@ -589,25 +1081,21 @@ cdef class DiffractionPattern(_Compute):
             Resolution of the output diffraction image, uses ``grid_size`` if
             not provided or ``None`` (Default value = :code:`None`).
     """
-    cdef int _grid_size
-    cdef int _output_size
-    cdef int _N_points
+    cdef freud._diffraction.DiffractionPattern * thisptr
     cdef double[:] _k_values_orig
     cdef double[:, :, :] _k_vectors_orig
     cdef double[:] _k_values
     cdef double[:, :, :] _k_vectors
-    cdef double[:, :] _diffraction
-    cdef unsigned int _frame_counter
     cdef double _box_matrix_scale_factor
     cdef double[:] _view_orientation
     cdef double _k_scale_factor
     cdef cbool _k_values_cached
     cdef cbool _k_vectors_cached
 
-    def __init__(self, grid_size=512, output_size=None):
-        self._grid_size = int(grid_size)
-        self._output_size = int(grid_size) if output_size is None \
-            else int(output_size)
+    def __cinit__(self, grid_size=512, output_size=None):
+        output_size = grid_size if output_size is None else output_size
+        self.thisptr = new freud._diffraction.DiffractionPattern(
+            int(grid_size), int(output_size))
 
         # Cache these because they are system-independent.
         self._k_values_orig = np.empty(self.output_size)
@@ -617,121 +1105,27 @@ cdef class DiffractionPattern(_Compute):
         # Store these computed arrays which are exposed as properties.
         self._k_values = np.empty_like(self._k_values_orig)
         self._k_vectors = np.empty_like(self._k_vectors_orig)
-        self._diffraction = np.zeros((self.output_size, self.output_size))
-        self._frame_counter = 0
-
-    def _calc_proj(self, view_orientation, box):
-        """Calculate the inverse shear matrix from finding the projected box
-        vectors whose area of parallogram is the largest.
-
-        Args:
-            view_orientation ((:math:`4`) :class:`numpy.ndarray`):
-                View orientation as a quaternion.
-            box (:class:`~.box.Box`):
-                Simulation box.
-
-        Returns:
-            (2, 2) :class:`numpy.ndarray`:
-                Inverse shear matrix.
-        """
-        # Rotate the box matrix by the view orientation.
-        box_matrix = rowan.rotate(view_orientation, box.to_matrix())
-
-        # Compute normals for each box face.
-        # The area of the face is the length of the vector.
-        box_face_normals = np.cross(
-            np.roll(box_matrix, 1, axis=-1),
-            np.roll(box_matrix, -1, axis=-1),
-            axis=0)
 
-        # Compute view axis projections.
-        projections = np.abs(box_face_normals.T @ np.array([0., 0., 1.]))
-
-        # Determine the largest projection area along the view axis and use
-        # that face for the projection into 2D.
-        best_projection_axis = np.argmax(projections)
-        secondary_axes = np.array([
-            best_projection_axis + 1, best_projection_axis + 2]) % 3
-
-        # Figure out appropriate shear matrix
-        shear = box_matrix[np.ix_([0, 1], secondary_axes)]
-
-        # Return the inverse shear matrix
-        inv_shear = np.linalg.inv(shear)
-        return inv_shear
-
-    def _transform(self, img, box, inv_shear, zoom):
-        """Zoom, shear, and scale diffraction intensities.
-
-        Args:
-            img ((``grid_size, grid_size``) :class:`numpy.ndarray`):
-                Array of diffraction intensities.
-            box (:class:`~.box.Box`):
-                Simulation box.
-            inv_shear ((2, 2) :class:`numpy.ndarray`):
-                Inverse shear matrix.
-            zoom (float):
-                Scaling factor for incident wavevectors.
-
-        Returns:
-            (``output_size, output_size``) :class:`numpy.ndarray`:
-                Transformed array of diffraction intensities.
-        """  # noqa: E501
+    def __dealloc__(self):
+        del self.thisptr
 
-        # The adjustments to roll and roll_shift ensure that the peak
-        # corresponding to k=0 is located at exactly
-        # (output_size//2, output_size//2), regardless of whether the grid_size
-        # and output_size are odd or even. This keeps the peak aligned at the
-        # center of a single pixel, which should always have the maximum value.
-
-        roll = img.shape[0] / 2
-        if img.shape[0] % 2 == 1:
-            roll -= 0.5
-
-        roll_shift = self.output_size / zoom / 2
-        if self.output_size % 2 == 1:
-            roll_shift -= 0.5 / zoom
-
-        box_matrix = box.to_matrix()
-        ss = np.max(box_matrix) * inv_shear
-
-        shift_matrix = np.array(
-            [[1, 0, -roll],
-             [0, 1, -roll],
-             [0, 0, 1]])
-
-        # Translation for [roll_shift, roll_shift]
-        # Then shift using ss
-        shear_matrix = np.array(
-            [[ss[1, 0], ss[0, 0], roll_shift],
-             [ss[1, 1], ss[0, 1], roll_shift],
-             [0, 0, 1]])
-
-        zoom_matrix = np.diag((zoom, zoom, 1))
-
-        # This matrix uses homogeneous coordinates. It is a 3x3 matrix that
-        # transforms 2D points and adds an offset.
-        inverse_transform = np.linalg.inv(
-            zoom_matrix @ shear_matrix @ shift_matrix)
-
-        img = scipy.ndimage.affine_transform(
-            input=img,
-            matrix=inverse_transform,
-            output_shape=(self.output_size, self.output_size),
-            order=1,
-            mode="constant")
-        return img
-
-    def compute(self, system, view_orientation=None, zoom=4, peak_width=1, reset=True):
+    def compute(self, system, view_orientation=None, zoom=4, peak_width=1,
+                reset=True):
         r"""Computes diffraction pattern.
 
+        Several view orientations may be given at once, for example to average
+        the diffraction pattern over orientations sampled on a sphere. Their
+        patterns are computed concurrently and averaged, as if :meth:`compute`
+        had been called for each of them with ``reset=False``.
+
         Args:
             system:
                 Any object that is a valid argument to
                 :class:`freud.locality.NeighborQuery.from_system`.
-            view_orientation ((:math:`4`) :class:`numpy.ndarray`, optional):
-                View orientation. Uses :math:`(1, 0, 0, 0)` if not provided
-                or :code:`None` (Default value = :code:`None`).
+            view_orientation ((:math:`4`) or (:math:`N_{views}`, :math:`4`) :class:`numpy.ndarray`, optional):
+                View orientation, or an array of view orientations whose
+                patterns are averaged. Uses :math:`(1, 0, 0, 0)` if not
+                provided or :code:`None` (Default value = :code:`None`).
             zoom (float, optional):
                 Scaling factor for incident wavevectors (Default value = 4).
             peak_width (float, optional):
@@ -741,10 +1135,9 @@ cdef class DiffractionPattern(_Compute):
                 Whether to erase the previously computed values before adding
                 the new computations; if False, will accumulate data (Default
                 value = True).
-        """
+        """  # noqa: E501
         if reset:
-            self._diffraction = np.zeros((self.output_size, self.output_size))
-            self._frame_counter = 0
+            self.thisptr.reset()
 
         system = freud.locality.NeighborQuery.from_system(system)
 
@@ -754,44 +1147,23 @@ cdef class DiffractionPattern(_Compute):
 
         if view_orientation is None:
             view_orientation = np.array([1., 0., 0., 0.])
-        view_orientation = freud.util._convert_array(
-            view_orientation, (4,), np.double)
-
-        # Compute the box projection matrix
-        inv_shear = self._calc_proj(view_orientation, system.box)
-
-        # Rotate points by the view quaternion and shear by the box projection
-        xy = rowan.rotate(view_orientation, system.points)[:, 0:2]
-        xy = xy @ inv_shear.T
-
-        # Map positions to [0, 1] and compute a histogram "image"
-        # Use grid_size+1 bin edges so that there are grid_size bins
-        xy += 0.5
-        xy %= 1
-        im, _, _ = np.histogram2d(
-            xy[:, 0], xy[:, 1], bins=np.linspace(0, 1, self.grid_size+1))
-
-        # Compute FFT and convolve with Gaussian
-        cdef double complex[:, :] diffraction_fft
-        diffraction_fft = np.fft.fft2(im)
-        diffraction_fft = scipy.ndimage.fourier_gaussian(
-            diffraction_fft, peak_width / zoom)
-        diffraction_fft = np.fft.fftshift(diffraction_fft)
-
-        # Compute the squared modulus of the FFT, which is S(k)
-        cdef double[:, :] diffraction_frame
-        diffraction_frame = np.real(
-            diffraction_fft * np.conjugate(diffraction_fft))
-
-        # Transform the image (scale, shear, zoom) and normalize S(k) by the
-        # number of points
-        self._N_points = len(system.points)
-        diffraction_frame = self._transform(
-            diffraction_frame, system.box, inv_shear, zoom) / self._N_points
-
-        # Add to the diffraction pattern and increment the frame counter
-        self._diffraction += np.asarray(diffraction_frame)
-        self._frame_counter += 1
+        view_orientations = freud.util._convert_array(
+            np.atleast_2d(view_orientation), (None, 4))
+
+        cdef:
+            freud.box.Box b = system.box
+            const float[:, ::1] l_points = system.points
+            const float[:, ::1] l_view_orientations = view_orientations
+            unsigned int n_points = l_points.shape[0]
+            unsigned int n_views = l_view_orientations.shape[0]
+            float l_zoom = zoom
+            float l_peak_width = peak_width
+
+        with nogil:
+            self.thisptr.accumulate(
+                dereference(b.thisptr), <vec3[float]*> &l_points[0, 0],
+                n_points, <quat[float]*> &l_view_orientations[0, 0], n_views,
+                l_zoom, l_peak_width)
 
         # Compute a cached array of k-vectors that can be rotated and scaled
         if not self._called_compute:
@@ -804,10 +1176,11 @@ cdef class DiffractionPattern(_Compute):
             self._k_vectors_orig = np.asarray(np.meshgrid(
                 self._k_values_orig, self._k_values_orig, [0])).T[0]
 
-        # Cache the view orientation and box matrix scale factor for
+        # Cache the last view orientation and box matrix scale factor for
         # lazy evaluation of k-values and k-vectors
         self._box_matrix_scale_factor = np.max(system.box.to_matrix())
-        self._view_orientation = view_orientation
+        self._view_orientation = np.asarray(
+            view_orientations[-1], dtype=np.float64)
         self._k_scale_factor = 2 * np.pi * self.output_size / \
             (self._box_matrix_scale_factor * zoom)
         self._k_values_cached = False
@@ -818,25 +1191,44 @@ cdef class DiffractionPattern(_Compute):
     @property
     def grid_size(self):
         """int: Resolution of the diffraction grid."""
-        return self._grid_size
+        return self.thisptr.getGridSize()
 
     @property
     def output_size(self):
         """int: Resolution of the output diffraction image."""
-        return self._output_size
+        return self.thisptr.getOutputSize()
 
     @_Compute._computed_property
     def diffraction(self):
         """
         (``output_size``, ``output_size``) :class:`numpy.ndarray`:
-            Diffraction pattern.
+            Diffraction pattern, averaged over the view orientations of all
+            computations since the last reset.
         """
-        return np.asarray(self._diffraction) / self._frame_counter
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getDiffraction(),
+            freud.util.arr_type_t.DOUBLE)
+
+    @_Compute._computed_property
+    def radial_average(self):
+        """(``output_size // 2 + 1``,) :class:`numpy.ndarray`: Average of
+        the diffraction pattern over rings of pixels around
+        :math:`\\vec{k} = 0`, at the magnitudes :attr:`radial_k_values`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRadialAverage(),
+            freud.util.arr_type_t.DOUBLE)
+
+    @_Compute._computed_property
+    def radial_k_values(self):
+        """(``output_size // 2 + 1``,) :class:`numpy.ndarray`: The
+        magnitudes of the k-vectors of the rings of :attr:`radial_average`."""
+        return np.arange(self.output_size // 2 + 1) * \
+            self._k_scale_factor / self.output_size
 
     @_Compute._computed_property
     def N_points(self):
         """int: Number of points used in the last computation."""
-        return self._N_points
+        return self.thisptr.getNPoints()
 
     @_Compute._computed_property
     def k_values(self):
@@ -11,7 +11,9 @@ characterize the particle environment.
 from freud.errors import NO_DEFAULT_QUERY_ARGS_MESSAGE
 
 from cython.operator cimport dereference
+from libcpp cimport bool as cbool
 from libcpp.map cimport map
+from libcpp.vector cimport vector
 
 from freud.locality cimport _PairCompute, _SpatialHistogram
 from freud.util cimport _Compute, quat, vec3
@@ -179,6 +181,7 @@ cdef class BondOrder(_SpatialHistogram):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_orientations)
         if orientations is None:
             orientations = np.array([[1, 0, 0, 0]] * nq.points.shape[0])
         if query_orientations is None:
@@ -192,13 +195,104 @@ cdef class BondOrder(_SpatialHistogram):
         cdef const float[:, ::1] l_orientations = orientations
         cdef const float[:, ::1] l_query_orientations = query_orientations
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <quat[float]*> &l_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0],
-            <quat[float]*> &l_query_orientations[0, 0],
-            num_query_points,
-            nlist.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <quat[float]*> &l_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0],
+                <quat[float]*> &l_query_orientations[0, 0],
+                num_query_points,
+                nlist.get_ptr(), dereference(qargs.thisptr))
+        return self
+
+    def compute_frames(self, systems, orientations=None, query_points=None,
+                       query_orientations=None, neighbors=None, reset=True):
+        r"""Calculates the bond order diagram averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but the frames are computed concurrently, so the
+        neighbor finding data structure of one frame is built while the
+        bonds of other frames are binned.
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame.
+            orientations (iterable, optional):
+                Orientations associated with the system points of each frame,
+                as accepted by :py:meth:`compute`. Uses identity quaternions
+                if :code:`None` (Default value = :code:`None`).
+            query_points (iterable, optional):
+                Query points of each frame. Uses the points of each system if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations (iterable, optional):
+                Query orientations of each frame, as accepted by
+                :py:meth:`compute`. Uses :code:`orientations` if :code:`None`
+                (Default value = :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used for all frames (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        nqs, query_points_list, qargs = self._preprocess_frames(
+            systems, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_orientations)
+        if orientations is None:
+            orientations = [
+                np.array([[1, 0, 0, 0]] * frame_nq.points.shape[0])
+                for frame_nq in nqs]
+        orientations = list(orientations)
+        if query_orientations is not None:
+            query_orientations = list(query_orientations)
+        if len(orientations) != len(nqs) or (
+                query_orientations is not None and
+                len(query_orientations) != len(nqs)):
+            raise ValueError("Orientations must be provided for every frame.")
+        orientations_list = [
+            freud.util._convert_array(o, shape=(frame_nq.points.shape[0], 4))
+            for frame_nq, o in zip(nqs, orientations)]
+        if query_orientations is None:
+            query_orientations = orientations_list
+        query_orientations_list = [
+            freud.util._convert_array(o, shape=(qp.shape[0], 4))
+            for qp, o in zip(query_points_list, query_orientations)]
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality._QueryArgs l_qargs = qargs
+            const float[:, ::1] l_query_points
+            const float[:, ::1] l_orientations
+            const float[:, ::1] l_query_orientations
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const quat[float]*] orientation_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            vector[const quat[float]*] query_orientation_ptrs
+            vector[unsigned int] num_query_points
+
+        for nq, l_orientations, l_query_points, l_query_orientations in zip(
+                nqs, orientations_list, query_points_list,
+                query_orientations_list):
+            nq_ptrs.push_back(nq.get_ptr())
+            orientation_ptrs.push_back(
+                <quat[float]*> &l_orientations[0, 0])
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+            query_orientation_ptrs.push_back(
+                <quat[float]*> &l_query_orientations[0, 0])
+            num_query_points.push_back(l_query_points.shape[0])
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.thisptr.accumulateFrames(
+                nq_ptrs, orientation_ptrs, query_point_ptrs,
+                query_orientation_ptrs, num_query_points,
+                dereference(l_qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -328,13 +422,15 @@ cdef class LocalDescriptors(_PairCompute):
 
             l_orientations = orientations
             l_orientations_ptr = <quat[float]*> &l_orientations[0, 0]
-
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0], num_query_points,
-            l_orientations_ptr,
-            nlist.get_ptr(), dereference(qargs.thisptr),
-            max_num_neighbors)
+        cdef unsigned int l_max_num_neighbors = max_num_neighbors
+
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                l_orientations_ptr,
+                nlist.get_ptr(), dereference(qargs.thisptr),
+                l_max_num_neighbors)
         return self
 
     @_Compute._computed_property
@@ -651,11 +747,14 @@ cdef class EnvironmentCluster(_MatchEnv):
         if env_neighbors is None:
             env_neighbors = cluster_neighbors
         env_nlist, env_qargs = self._resolve_neighbors(env_neighbors)
-
-        self.thisptr.compute(
-            nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
-            env_nlist.get_ptr(), dereference(env_qargs.thisptr), threshold,
-            registration)
+        cdef float l_threshold = threshold
+        cdef cbool l_registration = registration
+
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                env_nlist.get_ptr(), dereference(env_qargs.thisptr), l_threshold,
+                l_registration)
         return self
 
     @_Compute._computed_property
@@ -783,22 +882,110 @@ cdef class EnvironmentMotifMatch(_MatchEnv):
 
         cdef const float[:, ::1] l_motif = motif
         cdef unsigned int nRef = l_motif.shape[0]
+        cdef float l_threshold = threshold
+        cdef cbool l_registration = registration
+
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                <vec3[float]*>
+                <vec3[float]*> &l_motif[0, 0], nRef,
+                l_threshold, l_registration)
+        return self
+
+    def compute_motifs(self, system, motifs, threshold, env_neighbors=None,
+                       registration=False):
+        r"""Determine which of several motifs the local environment of each
+        particle matches.
 
-        self.thisptr.compute(
-            nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
-            <vec3[float]*>
-            <vec3[float]*> &l_motif[0, 0], nRef,
-            threshold, registration)
+        The environment of every particle is built once and compared with
+        the motifs in order, so a particle matching several motifs is
+        assigned the first of them. This is faster than calling
+        :meth:`compute` once per motif, e.g. to classify particles among
+        candidate crystal structures.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            motifs (sequence of (:math:`N_{vectors}`, 3) :class:`numpy.ndarray`):
+                The motifs against which we are matching, each given by its
+                vectors as in :meth:`compute`. Motifs may have different
+                numbers of vectors.
+            threshold (float):
+                Maximum magnitude of the vector difference between two vectors,
+                below which they are "matching", as in :meth:`compute`.
+            env_neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_.
+                Defines the environment of the query particles
+                (Default value: None).
+            registration (bool, optional):
+                If True, first use brute force registration to orient the
+                environment vectors with respect to each motif such that it
+                minimizes the RMSD between the two sets
+                (Default value = False).
+        """
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        motifs = [freud.util._convert_array(motif, shape=(None, 3))
+                  for motif in motifs]
+        if len(motifs) == 0:
+            raise ValueError("At least one motif must be provided.")
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, neighbors=env_neighbors)
+
+        if any((motif == 0).all(axis=1).any() for motif in motifs):
+            warnings.warn(
+                "Attempting to match a motif containing the zero "
+                "vector is likely to result in zero matches.",
+                RuntimeWarning
+            )
+
+        cdef const float[:, ::1] l_motifs = np.concatenate(motifs)
+        cdef const unsigned int[::1] l_motif_sizes = np.array(
+            [len(motif) for motif in motifs], dtype=np.uint32)
+        cdef unsigned int num_motifs = len(motifs)
+        cdef float l_threshold = threshold
+        cdef cbool l_registration = registration
+        cdef const vec3[float]* l_motifs_ptr = NULL
+        if l_motifs.shape[0] > 0:
+            l_motifs_ptr = <vec3[float]*> &l_motifs[0, 0]
+
+        with nogil:
+            self.thisptr.computeMotifs(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                l_motifs_ptr, &l_motif_sizes[0], num_motifs,
+                l_threshold, l_registration)
         return self
 
     @_Compute._computed_property
     def matches(self):
         """(:math:`N_{points}`) :class:`numpy.ndarray`: A boolean array indicating
-        whether each point matches the motif."""
+        whether each point matches the motif, or any of the motifs of
+        :meth:`compute_motifs`."""
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getMatches(),
             freud.util.arr_type_t.BOOL)
 
+    @_Compute._computed_property
+    def motif_indices(self):
+        """(:math:`N_{points}`) :class:`numpy.ndarray`: The index of the motif
+        matched by each point, or -1 for points that match no motif."""
+        motif_indices = freud.util.make_managed_numpy_array(
+            &self.thisptr.getMotifIndices(),
+            freud.util.arr_type_t.UNSIGNED_INT).astype(np.int64)
+        motif_indices[~self.matches] = -1
+        return motif_indices
+
 
 cdef class _EnvironmentRMSDMinimizer(_MatchEnv):
     r"""Find linear transformations that map the environments of points onto a
@@ -824,7 +1011,7 @@ cdef class _EnvironmentRMSDMinimizer(_MatchEnv):
         pass
 
     def compute(self, system, motif, neighbors=None,
-                registration=False):
+                registration=False, exact_assignment=False):
         r"""Rotate (if registration=True) and permute the environments of all
         particles to minimize their RMSD with respect to the motif provided by
         motif.
@@ -846,6 +1033,13 @@ cdef class _EnvironmentRMSDMinimizer(_MatchEnv):
                 of environment vectors with respect to the other set such that
                 it minimizes the RMSD between the two sets
                 (Default value = :code:`False`).
+            exact_assignment (bool, optional):
+                If True, pair the environment vectors with the motif vectors
+                by solving the assignment problem exactly with the Hungarian
+                algorithm, which always finds the minimal RMSD for a given
+                orientation. Otherwise, every vector is greedily paired with
+                its nearest unpaired motif vector, which is faster but may
+                overestimate the RMSD (Default value = :code:`False`).
         Returns:
             :math:`\left(N_{particles}\right)` :class:`numpy.ndarray`:
                 Vector of minimal RMSD values, one value per particle.
@@ -864,12 +1058,15 @@ cdef class _EnvironmentRMSDMinimizer(_MatchEnv):
         motif = freud.util._convert_array(motif, shape=(None, 3))
         cdef const float[:, ::1] l_motif = motif
         cdef unsigned int nRef = l_motif.shape[0]
+        cdef cbool l_registration = registration
+        cdef cbool l_exact_assignment = exact_assignment
 
-        self.thisptr.compute(
-            nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
-            <vec3[float]*>
-            <vec3[float]*> &l_motif[0, 0], nRef,
-            registration)
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                <vec3[float]*>
+                <vec3[float]*> &l_motif[0, 0], nRef,
+                l_registration, l_exact_assignment)
 
         return self
 
@@ -962,16 +1159,17 @@ cdef class AngularSeparationNeighbor(_PairCompute):
 
         cdef unsigned int n_equiv_orientations = l_equiv_orientations.shape[0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <quat[float]*> &l_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0],
-            <quat[float]*> &l_query_orientations[0, 0],
-            num_query_points,
-            <quat[float]*> &l_equiv_orientations[0, 0],
-            n_equiv_orientations,
-            nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <quat[float]*> &l_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0],
+                <quat[float]*> &l_query_orientations[0, 0],
+                num_query_points,
+                <quat[float]*> &l_equiv_orientations[0, 0],
+                n_equiv_orientations,
+                nlist.get_ptr(),
+                dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -1047,13 +1245,14 @@ cdef class AngularSeparationGlobal(_Compute):
         cdef unsigned int n_points = l_orientations.shape[0]
         cdef unsigned int n_equiv_orientations = l_equiv_orientations.shape[0]
 
-        self.thisptr.compute(
-            <quat[float]*> &l_global_orientations[0, 0],
-            n_global,
-            <quat[float]*> &l_orientations[0, 0],
-            n_points,
-            <quat[float]*> &l_equiv_orientations[0, 0],
-            n_equiv_orientations)
+        with nogil:
+            self.thisptr.compute(
+                <quat[float]*> &l_global_orientations[0, 0],
+                n_global,
+                <quat[float]*> &l_orientations[0, 0],
+                n_points,
+                <quat[float]*> &l_equiv_orientations[0, 0],
+                n_equiv_orientations)
         return self
 
     @_Compute._computed_property
@@ -1073,13 +1272,21 @@ cdef class LocalBondProjection(_PairCompute):
     r"""Calculates the maximal projection of nearest neighbor bonds for each
     particle onto some set of reference vectors, defined in the particles'
     local reference frame.
+
+    Args:
+        compute_projections (bool, optional):
+            Whether to store the unnormalized :attr:`projections` in addition
+            to the :attr:`normed_projections`. Setting this to :code:`False`
+            halves the memory used by the results of large systems.
+            (Default value = :code:`True`).
     """
     cdef freud._environment.LocalBondProjection * thisptr
 
-    def __cinit__(self):
-        self.thisptr = new freud._environment.LocalBondProjection()
+    def __cinit__(self, compute_projections=True):
+        self.thisptr = new freud._environment.LocalBondProjection(
+            compute_projections)
 
-    def __init__(self):
+    def __init__(self, compute_projections=True):
         pass
 
     def __dealloc__(self):
@@ -1150,13 +1357,14 @@ cdef class LocalBondProjection(_PairCompute):
         cdef unsigned int n_equiv = l_equiv_orientations.shape[0]
         cdef unsigned int n_proj = l_proj_vecs.shape[0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <quat[float]*> &l_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0], num_query_points,
-            <vec3[float]*> &l_proj_vecs[0, 0], n_proj,
-            <quat[float]*> &l_equiv_orientations[0, 0], n_equiv,
-            nlist.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <quat[float]*> &l_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                <vec3[float]*> &l_proj_vecs[0, 0], n_proj,
+                <quat[float]*> &l_equiv_orientations[0, 0], n_equiv,
+                nlist.get_ptr(), dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -1167,11 +1375,21 @@ cdef class LocalBondProjection(_PairCompute):
         nlist._compute = self
         return nlist
 
+    @property
+    def compute_projections(self):
+        """bool: Whether the unnormalized projections are stored."""
+        return self.thisptr.getComputeProjections()
+
     @_Compute._computed_property
     def projections(self):
         """:math:`\\left(N_{bonds}, N_{projection\\_vecs} \\right)` :class:`numpy.ndarray`:
         The projection of each bond between query particles and their neighbors
-        onto each of the projection vectors."""  # noqa: E501
+        onto each of the projection vectors. Only available when
+        :attr:`compute_projections` is :code:`True`."""  # noqa: E501
+        if not self.compute_projections:
+            raise AttributeError(
+                "Projections are only available with "
+                "compute_projections=True.")
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getProjections(),
             freud.util.arr_type_t.FLOAT)
@@ -1187,4 +1405,5 @@ cdef class LocalBondProjection(_PairCompute):
             freud.util.arr_type_t.FLOAT)
 
     def __repr__(self):
-        return ("freud.environment.{cls}()").format(cls=type(self).__name__)
+        return ("freud.environment.{cls}(compute_projections={cp})").format(
+            cls=type(self).__name__, cp=self.compute_projections)
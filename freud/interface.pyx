@@ -6,29 +6,44 @@ The :class:`freud.interface` module contains functions to measure the interface
 between sets of points.
 """
 
-import numpy as np
+from cython.operator cimport dereference
 
 from freud.locality cimport _PairCompute
-from freud.util cimport _Compute
+from freud.util cimport _Compute, vec3
+
+import numpy as np
 
 import freud.locality
 
 cimport numpy as np
 
+cimport freud._locality
 cimport freud.locality
+cimport freud.util
 
 # numpy must be initialized. When using numpy from C or Cython you must
 # _always_ do that, or you will have segfaults
 np.import_array()
 
 cdef class Interface(_PairCompute):
-    r"""Measures the interface between two sets of points."""
-    cdef const unsigned int[::1] _point_ids
-    cdef const unsigned int[::1] _query_point_ids
+    r"""Measures the interface between two sets of points.
+
+    A point and a query point are at the interface if they are neighbors. No
+    neighbor list is built when query arguments are given: the neighbors only
+    mark the points at the interface. Since a ball query finds the same pairs
+    from either set of points, it is run from the smaller set, and each of
+    its points stops at its first neighbor unless it is at the interface.
+    """
+    cdef freud._locality.Interface * thisptr
+
+    def __cinit__(self):
+        self.thisptr = new freud._locality.Interface()
+
+    def __dealloc__(self):
+        del self.thisptr
 
     def __init__(self):
-        self._point_ids = np.empty(0, dtype=np.uint32)
-        self._query_point_ids = np.empty(0, dtype=np.uint32)
+        pass
 
     def compute(self, system, query_points, neighbors=None):
         r"""Compute the particles at the interface between two sets of points.
@@ -54,33 +69,44 @@ cdef class Interface(_PairCompute):
             const float[:, ::1] l_query_points
             unsigned int num_query_points
 
-        nlist = freud.locality._make_default_nlist(
-            system, neighbors, query_points)
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        cdef const float* l_query_points_ptr = NULL
+        if num_query_points > 0:
+            l_query_points_ptr = &l_query_points[0, 0]
 
-        self._point_ids = np.unique(nlist.point_indices)
-        self._query_point_ids = np.unique(nlist.query_point_indices)
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), <vec3[float]*> l_query_points_ptr,
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
     def point_count(self):
         """int: Number of particles from :code:`points` on the interface."""
-        return len(self._point_ids)
+        return self.thisptr.getPointIds().size()
 
     @_Compute._computed_property
     def point_ids(self):
         """:class:`np.ndarray`: The particle IDs from :code:`points`."""
-        return np.asarray(self._point_ids)
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getPointIds(),
+            freud.util.arr_type_t.UNSIGNED_INT)
 
     @_Compute._computed_property
     def query_point_count(self):
         """int: Number of particles from :code:`query_points` on the
         interface."""
-        return len(self._query_point_ids)
+        return self.thisptr.getQueryPointIds().size()
 
     @_Compute._computed_property
     def query_point_ids(self):
         """:class:`np.ndarray`: The particle IDs from :code:`query_points`."""
-        return np.asarray(self._query_point_ids)
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getQueryPointIds(),
+            freud.util.arr_type_t.UNSIGNED_INT)
 
     def __repr__(self):
         return "freud.interface.{cls}()".format(cls=type(self).__name__)
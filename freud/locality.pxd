@@ -1,6 +1,8 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp.memory cimport shared_ptr
+
 cimport freud._locality
 cimport freud.box
 from freud.util cimport _Compute
@@ -35,16 +37,25 @@ cdef class NeighborQueryResult:
 cdef class NeighborQuery:
     cdef freud._locality.NeighborQuery * nqptr
     cdef const float[:, ::1] points
-    cdef freud._locality.NeighborQuery * get_ptr(self)
+    cdef freud._locality.NeighborQuery * get_ptr(self) nogil
 
 cdef class NeighborList:
     cdef freud._locality.NeighborList * thisptr
     cdef char _managed
     cdef freud.util._Compute _compute
 
-    cdef freud._locality.NeighborList * get_ptr(self)
+    cdef freud._locality.NeighborList * get_ptr(self) nogil
     cdef void copy_c(self, NeighborList other)
 
+cdef class CompressedNeighborList:
+    cdef freud._locality.CompressedNeighborList * thisptr
+
+cdef class GSDTrajectory:
+    cdef shared_ptr[freud._locality.GSDTrajectory] thisptr
+    cdef readonly unsigned long long first
+    cdef readonly unsigned long long last
+    cdef readonly unsigned long long stride
+
 cdef class LinkCell(NeighborQuery):
     cdef freud._locality.LinkCell * thisptr
 
@@ -57,6 +68,9 @@ cdef class _RawPoints(NeighborQuery):
 cdef class _QueryArgs:
     cdef freud._locality.QueryArgs * thisptr
 
+cdef class _QuerySampling:
+    cdef freud._locality.QuerySampling sampling
+
 cdef class _PairCompute(_Compute):
     pass
 
@@ -67,9 +81,15 @@ cdef class _SpatialHistogram(_PairCompute):
 cdef class _SpatialHistogram1D(_SpatialHistogram):
     pass
 
+cdef class DomainDecomposition(_Compute):
+    cdef freud._locality.DomainDecomposition * thisptr
+
 cdef class PeriodicBuffer(_Compute):
     cdef freud._locality.PeriodicBuffer * thisptr
 
+cdef class VerletList(_Compute):
+    cdef freud._locality.VerletList * thisptr
+
 cdef class Voronoi(_Compute):
     cdef freud._locality.Voronoi * thisptr
     cdef NeighborList _nlist
@@ -7,13 +7,15 @@ locate points based on their proximity to other points.
 """
 from freud.errors import NO_DEFAULT_QUERY_ARGS_MESSAGE
 
+from cpython cimport Py_DECREF, Py_INCREF
 from cython.operator cimport dereference
 from libcpp cimport bool as cbool
 from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
 
 from freud._locality cimport ITERATOR_TERMINATOR
-from freud.util cimport _Compute, vec3
+from freud._util cimport makeExternalOwner
+from freud.util cimport ManagedArray, _Compute, vec3
 
 import inspect
 
@@ -42,7 +44,7 @@ cdef class _QueryArgs:
 
     def __cinit__(self, mode=None, r_min=None, r_max=None, r_guess=None,
                   num_neighbors=None, exclude_ii=None,
-                  scale=None, **kwargs):
+                  scale=None, half_list=None, **kwargs):
         if type(self) is _QueryArgs:
             self.thisptr = new freud._locality.QueryArgs()
             self.mode = mode
@@ -58,6 +60,8 @@ cdef class _QueryArgs:
                 self.exclude_ii = exclude_ii
             if scale is not None:
                 self.scale = scale
+            if half_list is not None:
+                self.half_list = half_list
             if len(kwargs):
                 err_str = ", ".join(
                     "{} = {}".format(k, v) for k, v in kwargs.items())
@@ -154,6 +158,14 @@ cdef class _QueryArgs:
     def scale(self, value):
         self.thisptr.scale = value
 
+    @property
+    def half_list(self):
+        return self.thisptr.half_list
+
+    @half_list.setter
+    def half_list(self, value):
+        self.thisptr.half_list = value
+
     def __repr__(self):
         return ("freud.locality.{cls}(mode={mode}, r_max={r_max}, "
                 "num_neighbors={num_neighbors}, exclude_ii={exclude_ii}, "
@@ -168,6 +180,21 @@ cdef class _QueryArgs:
         return repr(self)
 
 
+cdef class _QuerySampling:
+    r"""Container for the arguments of a computation that samples a fraction
+    of the query points of each frame.
+
+    This class is used internally by the spatial histograms to pass the
+    sampling arguments of their compute methods to C++.
+    """
+
+    def __cinit__(self, fraction, stratified=True, seed=0, num_batches=10):
+        self.sampling.fraction = fraction
+        self.sampling.stratified = stratified
+        self.sampling.seed = seed
+        self.sampling.num_batches = num_batches
+
+
 cdef class NeighborQueryResult:
     r"""Class encapsulating the output of queries of NeighborQuery objects.
 
@@ -202,7 +229,63 @@ cdef class NeighborQueryResult:
                    npoint.getDistance())
             npoint = dereference(iterator).next()
 
-    def toNeighborList(self, sort_by_distance=False):
+    def chunks(self, chunk_size=65536):
+        """Iterate over the bonds of the query in chunks of arrays.
+
+        Unlike iterating over the result, which creates one tuple per bond,
+        or :meth:`~.toNeighborList`, which stores all bonds, the bonds are
+        found in parallel batches and yielded as arrays of at most
+        :code:`chunk_size` bonds, so custom analyses of very many bonds run
+        at the speed of NumPy in bounded memory. The chunks hold the bonds in
+        the order of :meth:`~.toNeighborList`.
+
+        Example::
+
+            for query_point_indices, point_indices, distances in nq.query(
+                points, dict(r_max=5)
+            ).chunks():
+                counts += np.bincount(query_point_indices, minlength=len(points))
+
+        Args:
+            chunk_size (int):
+                Maximum number of bonds of each chunk (Default value =
+                :code:`65536`).
+
+        Yields:
+            tuple[:class:`numpy.ndarray`]: The query point indices, point
+            indices and distances of the bonds of a chunk.
+        """
+        if chunk_size < 1:
+            raise ValueError("chunk_size must be positive.")
+        cdef const float[:, ::1] l_points = self.points
+        cdef shared_ptr[freud._locality.NeighborQueryIterator] iterator = \
+            self.nq.nqptr.query(
+                <vec3[float]*> &l_points[0, 0],
+                self.points.shape[0],
+                dereference(self.query_args.thisptr))
+
+        cdef unsigned int l_chunk_size = chunk_size
+        cdef unsigned int num_bonds
+        cdef unsigned int[::1] l_query_point_indices
+        cdef unsigned int[::1] l_point_indices
+        cdef float[::1] l_distances
+        while True:
+            query_point_indices = np.empty(chunk_size, dtype=np.uint32)
+            point_indices = np.empty(chunk_size, dtype=np.uint32)
+            distances = np.empty(chunk_size, dtype=np.float32)
+            l_query_point_indices = query_point_indices
+            l_point_indices = point_indices
+            l_distances = distances
+            with nogil:
+                num_bonds = dereference(iterator).nextChunk(
+                    l_chunk_size, &l_query_point_indices[0],
+                    &l_point_indices[0], &l_distances[0])
+            if num_bonds == 0:
+                return
+            yield (query_point_indices[:num_bonds], point_indices[:num_bonds],
+                   distances[:num_bonds])
+
+    def toNeighborList(self, sort_by_distance=False, columns=None):
         """Convert query result to a freud :class:`~NeighborList`.
 
         Args:
@@ -210,6 +293,14 @@ cdef class NeighborQueryResult:
                 If :code:`True`, sort neighboring bonds by distance.
                 If :code:`False`, sort neighboring bonds by point index
                 (Default value = :code:`False`).
+            columns (Iterable[str], optional):
+                The per-bond columns to store, among :code:`"vectors"`,
+                :code:`"distances"` and :code:`"weights"`. The indices are
+                always stored, and the other columns are computed from the
+                points and box when first accessed, so computations that
+                only use the bond topology can pass an empty sequence to
+                reduce the memory of the list. If :code:`None`, all columns
+                are stored (Default value = :code:`None`).
 
         Returns:
             :class:`~NeighborList`: A :class:`~NeighborList` containing all
@@ -222,8 +313,12 @@ cdef class NeighborQueryResult:
                 self.points.shape[0],
                 dereference(self.query_args.thisptr))
 
-        cdef freud._locality.NeighborList *cnlist = dereference(
-            iterator).toNeighborList(sort_by_distance)
+        cdef unsigned int l_columns = _neighbor_list_columns(columns)
+        cdef cbool l_sort_by_distance = sort_by_distance
+        cdef freud._locality.NeighborList *cnlist
+        with nogil:
+            cnlist = dereference(iterator).toNeighborList(
+                l_sort_by_distance, l_columns)
         cdef NeighborList nl = _nlist_from_cnlist(cnlist)
         # Explicitly manage a manually created nlist so that it will be
         # deleted when the Python object is.
@@ -231,6 +326,60 @@ cdef class NeighborQueryResult:
 
         return nl
 
+    def toNeighborLists(self, r_maxs, sort_by_distance=False, columns=None):
+        """Convert query result to one :class:`~NeighborList` per cutoff.
+
+        The neighbors are found once, and the list for each cutoff
+        distance :code:`r_max` holds the bonds of the query whose distances
+        are less than :code:`r_max`. This replaces separate queries for
+        computes using different cutoffs on the same points.
+
+        Example::
+
+            rdf_nlist, ql_nlist, cl_nlist = nq.query(
+                points, dict(r_max=5, exclude_ii=True)
+            ).toNeighborLists([5, 1.5, 1.2])
+            rdf.compute(nq, neighbors=rdf_nlist)
+            ql.compute(nq, neighbors=ql_nlist)
+            cl.compute(nq, neighbors=cl_nlist)
+
+        Args:
+            r_maxs (Iterable[float]):
+                Cutoff distance of each neighbor list.
+            sort_by_distance (bool):
+                If :code:`True`, sort neighboring bonds by distance.
+                If :code:`False`, sort neighboring bonds by point index
+                (Default value = :code:`False`).
+            columns (Iterable[str], optional):
+                The per-bond columns to store, as in
+                :meth:`~.toNeighborList` (Default value = :code:`None`).
+
+        Returns:
+            list[:class:`~NeighborList`]: The neighbor list of each cutoff.
+        """
+        cdef vector[float] l_r_maxs = r_maxs
+        cdef const float[:, ::1] l_points = self.points
+        cdef shared_ptr[freud._locality.NeighborQueryIterator] iterator = \
+            self.nq.nqptr.query(
+                <vec3[float]*> &l_points[0, 0],
+                self.points.shape[0],
+                dereference(self.query_args.thisptr))
+
+        cdef unsigned int l_columns = _neighbor_list_columns(columns)
+        cdef cbool l_sort_by_distance = sort_by_distance
+        cdef vector[freud._locality.NeighborList*] cnlists
+        with nogil:
+            cnlists = dereference(iterator).toNeighborLists(
+                l_r_maxs, l_sort_by_distance, l_columns)
+
+        cdef NeighborList nl
+        nlists = []
+        for i in range(cnlists.size()):
+            nl = _nlist_from_cnlist(cnlists[i])
+            nl._managed = True
+            nlists.append(nl)
+        return nlists
+
 
 cdef class NeighborQuery:
     r"""Class representing a set of points along with the ability to query for
@@ -389,6 +538,55 @@ cdef class NeighborQuery:
         """:class:`np.ndarray`: The array of points in this data structure."""
         return np.asarray(self.points)
 
+    def update_points(self, points, box=None):
+        r"""Replace the points, and optionally the box, of this object.
+
+        This is equivalent to constructing a new object of the same type from
+        the box and points, but the memory of the search structure is reused.
+        An :class:`~.AABBQuery` refits its existing tree to the new points if
+        their number is unchanged, and only partitions the points again once
+        they have moved far enough to slow down queries. A
+        :class:`~.LinkCell` keeps its cell width, and bins the points into its
+        existing cells if the box is unchanged. In loops over the frames of a
+        trajectory, updating one object is therefore much faster than
+        constructing a new one for each frame.
+
+        Results of earlier queries that have not been evaluated yet use the
+        updated points.
+
+        Example::
+
+            >>> box, points = freud.data.make_random_system(10, 100, seed=0)
+            >>> aq = freud.locality.AABBQuery(box, points)
+            >>> for seed in range(1, 4):
+            ...     _, points = freud.data.make_random_system(10, 100, seed=seed)
+            ...     nlist = aq.update_points(points).query(
+            ...         points, {'r_max': 2}).toNeighborList()
+
+        Args:
+            points ((:math:`N`, 3) :class:`numpy.ndarray`):
+                The new points.
+            box (:class:`freud.box.Box`, optional):
+                The new simulation box. If :code:`None`, the box is unchanged
+                (Default value = :code:`None`).
+
+        Returns:
+            :class:`~.NeighborQuery`: This object.
+        """
+        cdef freud.box.Box b = (
+            self.box if box is None else freud.util._convert_box(box))
+        points = freud.util._convert_array(points, shape=(None, 3)).copy()
+        cdef const float[:, ::1] l_points = points
+        cdef unsigned int num_points = l_points.shape[0]
+        if num_points == 0:
+            raise ValueError("Cannot create a NeighborQuery with 0 points.")
+        with nogil:
+            self.nqptr.updatePoints(
+                dereference(b.thisptr), <vec3[float]*> &l_points[0, 0],
+                num_points)
+        self.points = l_points
+        return self
+
     def query(self, query_points, query_args):
         r"""Query for nearest neighbors of the provided point.
 
@@ -410,7 +608,7 @@ cdef class NeighborQuery:
         cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
         return NeighborQueryResult.init(self, query_points, args)
 
-    cdef freud._locality.NeighborQuery * get_ptr(self):
+    cdef freud._locality.NeighborQuery * get_ptr(self) nogil:
         r"""Returns a pointer to the raw C++ object we are wrapping."""
         return self.nqptr
 
@@ -441,6 +639,45 @@ cdef class NeighborQuery:
             self, ax=ax, title=title, *args, **kwargs)
 
 
+def _neighbor_list_columns(columns):
+    r"""Convert the names of NeighborList columns to NeighborListColumns
+    flags."""
+    if columns is None:
+        return freud._locality.ALL_COLUMNS
+    flags = {
+        "vectors": freud._locality.VECTORS_COLUMN,
+        "distances": freud._locality.DISTANCES_COLUMN,
+        "weights": freud._locality.WEIGHTS_COLUMN,
+    }
+    result = freud._locality.NO_COLUMNS
+    for column in columns:
+        if column not in flags:
+            raise ValueError(
+                "Unknown NeighborList column {}, expected one of {}.".format(
+                    column, ", ".join(flags)))
+        result |= flags[column]
+    return result
+
+
+cdef void _release_arrays(void *arrays) noexcept with gil:
+    Py_DECREF(<object> arrays)
+
+
+def _interleave_indices(query_point_indices, point_indices):
+    r"""Return the :math:`\left(N_{bonds}, 2\right)` array of query point
+    and point indices, which is a view of the given arrays if they are already
+    the two columns of one C-contiguous array."""
+    itemsize = query_point_indices.itemsize
+    if (query_point_indices.strides == (2 * itemsize,)
+            and point_indices.strides == (2 * itemsize,)
+            and point_indices.ctypes.data
+            == query_point_indices.ctypes.data + itemsize):
+        return np.lib.stride_tricks.as_strided(
+            query_point_indices, shape=(len(query_point_indices), 2),
+            strides=(2 * itemsize, itemsize), writeable=False)
+    return np.column_stack((query_point_indices, point_indices))
+
+
 cdef class NeighborList:
     r"""Class representing bonds between two sets of points.
 
@@ -485,7 +722,7 @@ cdef class NeighborList:
 
     @classmethod
     def from_arrays(cls, num_query_points, num_points, query_point_indices,
-                    point_indices, vectors, weights=None):
+                    point_indices, vectors, weights=None, copy=True):
         r"""Create a NeighborList from a set of bond information arrays.
 
         Example::
@@ -523,7 +760,23 @@ cdef class NeighborList:
             weights (:math:`\left(N_{bonds} \right)` :class:`np.ndarray`, optional):
                 Array of per-bond weights (if :code:`None` is given, use a
                 value of 1 for each weight) (Default value = :code:`None`).
+            copy (bool):
+                If :code:`False`, the NeighborList is a view of the given
+                arrays rather than a copy of them, and keeps them alive for
+                its lifetime. The arrays must not be modified while the
+                NeighborList is in use. Vectors and weights are only copied if
+                they are not C-contiguous :code:`float32` arrays, and indices
+                only if they are not the two columns of one C-contiguous
+                :math:`\left(N_{bonds}, 2\right)` :code:`uint32` array (such
+                as the bond array of another NeighborList). Distances are
+                computed from the vectors when they are first accessed
+                (Default value = :code:`True`).
         """  # noqa 501
+        if not copy:
+            return cls._from_borrowed_arrays(
+                num_query_points, num_points, query_point_indices,
+                point_indices, vectors, weights)
+
         query_point_indices = freud.util._convert_array(
             query_point_indices, shape=(None,), dtype=np.uint32)
         point_indices = freud.util._convert_array(
@@ -555,6 +808,54 @@ cdef class NeighborList:
 
         return result
 
+    @classmethod
+    def _from_borrowed_arrays(cls, num_query_points, num_points,
+                              query_point_indices, point_indices, vectors,
+                              weights):
+        r"""Create a NeighborList that is a view of a set of bond information
+        arrays, see :meth:`from_arrays`."""
+        query_point_indices = freud.util._convert_array(
+            query_point_indices, shape=(None,), dtype=np.uint32,
+            requirements=())
+        point_indices = freud.util._convert_array(
+            point_indices, shape=query_point_indices.shape, dtype=np.uint32,
+            requirements=())
+        neighbors = _interleave_indices(query_point_indices, point_indices)
+
+        vectors = freud.util._convert_array(
+            vectors, shape=(len(query_point_indices), 3))
+        if weights is not None:
+            weights = freud.util._convert_array(
+                weights, shape=query_point_indices.shape)
+
+        cdef const unsigned int[:, ::1] l_neighbors = neighbors
+        cdef const float[:, ::1] l_vectors = vectors
+        cdef const float[::1] l_weights
+        cdef const float *l_weights_ptr = NULL
+        if weights is not None:
+            l_weights = weights
+            l_weights_ptr = &l_weights[0]
+        cdef unsigned int l_num_bonds = l_neighbors.shape[0]
+        cdef unsigned int l_num_query_points = num_query_points
+        cdef unsigned int l_num_points = num_points
+
+        # The C++ arrays hold a reference to the NumPy arrays, which is
+        # released once no array of the NeighborList or of its results
+        # references the data anymore.
+        arrays = (neighbors, vectors, weights)
+        Py_INCREF(arrays)
+        cdef shared_ptr[void] owner = makeExternalOwner(
+            _release_arrays, <void*> arrays)
+
+        cdef NeighborList result
+        result = cls()
+        result.thisptr = new freud._locality.NeighborList(
+            l_num_bonds, &l_neighbors[0, 0], l_num_query_points,
+            l_num_points, <vec3[float]*> &l_vectors[0, 0], l_weights_ptr,
+            owner)
+
+        return result
+
     @classmethod
     def all_pairs(cls, system, query_points=None, exclude_ii=True):
         R"""Create a NeighborList where all pairs of points are neighbors.
@@ -613,7 +914,7 @@ cdef class NeighborList:
         if self._managed:
             del self.thisptr
 
-    cdef freud._locality.NeighborList * get_ptr(self):
+    cdef freud._locality.NeighborList * get_ptr(self) nogil:
         r"""Returns a pointer to the raw C++ object we are wrapping."""
         return self.thisptr
 
@@ -746,9 +1047,16 @@ cdef class NeighborList:
             nlist.filter(types[nlist.query_point_indices] != types[nlist.point_indices])
         """  # noqa E501
         filt = np.ascontiguousarray(filt, dtype=bool)
+        if filt.ndim != 1 or len(filt) < self.num_bonds:
+            raise ValueError(
+                "The filter must be a 1D array with at least one value per bond."
+            )
+        if self.num_bonds == 0:
+            return self
         cdef np.ndarray[np.uint8_t, ndim=1, cast=True] filt_c = filt
         cdef const cbool * filt_ptr = <cbool*> &filt_c[0]
-        self.thisptr.filter(filt_ptr)
+        with nogil:
+            self.thisptr.filter(filt_ptr)
         return self
 
     def filter_r(self, float r_max, float r_min=0):
@@ -761,7 +1069,8 @@ cdef class NeighborList:
                 Minimum bond distance in the resulting neighbor list
                 (Default value = :code:`0`).
         """
-        self.thisptr.filter_r(r_max, r_min)
+        with nogil:
+            self.thisptr.filter_r(r_max, r_min)
         return self
 
     def sort(self, cbool by_distance=False):
@@ -775,10 +1084,188 @@ cdef class NeighborList:
                 ``query_point_index``, then ``point_index``, then ``distance``
                 (Default value = ``False``).
         """
-        self.thisptr.sort(by_distance)
+        with nogil:
+            self.thisptr.sort(by_distance)
         return self
 
 
+cdef class CompressedNeighborList:
+    r"""Compact read-only copy of a :class:`NeighborList`.
+
+    Very large neighbor lists are traversed at the speed of memory rather than
+    at the speed of the computation done on each bond. This class stores the
+    bonds of a :class:`NeighborList` in about a quarter of the memory, so that
+    computes accepting it (currently :class:`freud.density.RDF`) read less
+    data per bond:
+
+    - The point indices of each query point are sorted and stored as
+      differences to the previous index, using one byte for most bonds.
+    - The components of the bond vectors are stored as 16-bit fixed-point
+      numbers, with a resolution of :code:`r_max / 32767`.
+    - Distances are recomputed from the vectors while the bonds are
+      traversed, and weights are only stored if they are not all 1.
+
+    Example::
+
+        >>> box, points = freud.data.make_random_system(10, 1000, seed=0)
+        >>> aq = freud.locality.AABBQuery(box, points)
+        >>> nlist = aq.query(points, {'r_max': 3, 'exclude_ii': True}
+        ...                  ).toNeighborList()
+        >>> cnlist = freud.locality.CompressedNeighborList(nlist, r_max=3)
+        >>> rdf = freud.density.RDF(bins=50, r_max=3)
+        >>> rdf.compute((box, points), neighbors=cnlist)
+        freud.density.RDF(...)
+
+    Args:
+        nlist (:class:`NeighborList`):
+            Neighbor list to compress.
+        r_max (float):
+            Bound of the components of all bond vectors, usually the cutoff
+            of the query that found the bonds.
+    """
+
+    def __cinit__(self, NeighborList nlist, float r_max):
+        self.thisptr = new freud._locality.CompressedNeighborList(
+            dereference(nlist.get_ptr()), r_max)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def num_bonds(self):
+        """unsigned int: The number of bonds stored."""
+        return self.thisptr.getNumBonds()
+
+    @property
+    def num_query_points(self):
+        """unsigned int: The number of query points."""
+        return self.thisptr.getNumQueryPoints()
+
+    @property
+    def num_points(self):
+        """unsigned int: The number of points."""
+        return self.thisptr.getNumPoints()
+
+    @property
+    def r_max(self):
+        """float: The bound of the bond vector components."""
+        return self.thisptr.getRMax()
+
+    @property
+    def nbytes(self):
+        """int: The number of bytes used to store the bonds."""
+        return self.thisptr.getNumBytes()
+
+    def __len__(self):
+        return self.thisptr.getNumBonds()
+
+    def to_neighbor_list(self):
+        r"""Decompress the bonds into a :class:`NeighborList`.
+
+        The bonds of each query point are sorted by point index, and the
+        vectors and distances carry the quantization error.
+
+        Returns:
+            :class:`NeighborList`: The decompressed neighbor list.
+        """
+        cdef NeighborList result = NeighborList()
+        del result.thisptr
+        result.thisptr = self.thisptr.toNeighborList()
+        return result
+
+
+cdef class GSDTrajectory:
+    r"""Reader of the frames of a GSD trajectory written by HOOMD-blue.
+
+    The reader only loads the box and the particle positions and images of
+    each frame, and can be passed in place of a list of systems to the
+    multi-frame computes :meth:`freud.density.RDF.compute_frames`,
+    :meth:`freud.diffraction.StaticStructureFactorDirect.compute_frames` and
+    :meth:`freud.msd.StreamingMSD.compute`. These computes then stream the
+    frames from the file in C++: the file is memory mapped, and the next
+    frame is read on a background thread while the current frame is
+    computed, so trajectories larger than memory are analyzed without
+    holding more than two frames at a time.
+
+    Indexing the reader with an integer returns the frame as a
+    :code:`(box, points)` tuple, and slicing it returns a reader of the
+    selected frames. As in HOOMD-blue, data missing from a frame is taken
+    from frame 0.
+
+    Example::
+
+        >>> traj = freud.locality.GSDTrajectory('trajectory.gsd')  # doctest: +SKIP
+        >>> rdf = freud.density.RDF(bins=50, r_max=3)  # doctest: +SKIP
+        >>> rdf.compute_frames(traj[100::10])  # doctest: +SKIP
+
+    Args:
+        filename (str):
+            Name of the GSD file.
+    """
+
+    def __cinit__(self, filename=None):
+        if filename is None:
+            # Views of another reader are initialized by __getitem__.
+            return
+        self.thisptr.reset(new freud._locality.GSDTrajectory(
+            str(filename).encode()))
+        self.first = 0
+        self.last = self.thisptr.get().getNumFrames()
+        self.stride = 1
+
+    @property
+    def filename(self):
+        """str: The name of the GSD file."""
+        return self.thisptr.get().getFilename().decode()
+
+    def __len__(self):
+        if self.last <= self.first:
+            return 0
+        return (self.last - self.first + self.stride - 1) // self.stride
+
+    def __getitem__(self, index):
+        cdef GSDTrajectory view
+        if isinstance(index, slice):
+            start, stop, step = index.indices(len(self))
+            if step <= 0:
+                raise ValueError(
+                    "GSDTrajectory slices must have a positive step.")
+            view = GSDTrajectory()
+            view.thisptr = self.thisptr
+            view.first = self.first + start * self.stride
+            view.last = self.first + max(stop, start) * self.stride
+            view.stride = self.stride * step
+            return view
+        if index < 0:
+            index += len(self)
+        if index < 0 or index >= len(self):
+            raise IndexError("GSDTrajectory index out of range.")
+        return self._read(self.first + index * self.stride)
+
+    def __iter__(self):
+        for index in range(len(self)):
+            yield self._read(self.first + index * self.stride)
+
+    def _read(self, unsigned long long frame):
+        cdef freud._locality.GSDFrame c_frame
+        with nogil:
+            self.thisptr.get().readFrame(frame, c_frame)
+        cdef unsigned int num_particles = c_frame.getNumParticles()
+        points = np.empty((num_particles, 3), dtype=np.float32)
+        cdef float[:, ::1] l_points = points
+        cdef unsigned int i
+        for i in range(num_particles):
+            l_points[i, 0] = c_frame.positions[i].x
+            l_points[i, 1] = c_frame.positions[i].y
+            l_points[i, 2] = c_frame.positions[i].z
+        return freud.box.BoxFromCPP(c_frame.box), points
+
+    def __repr__(self):
+        return "freud.locality.{cls}({filename})[{first}:{last}:{stride}]".format(
+            cls=type(self).__name__, filename=repr(self.filename),
+            first=self.first, last=self.last, stride=self.stride)
+
+
 cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     """Create a Python NeighborList object that points to an existing C++
     NeighborList object.
@@ -836,7 +1323,7 @@ def _make_default_nq(neighbor_query):
     return nq
 
 
-def _make_default_nlist(system, neighbors, query_points=None):
+def _make_default_nlist(system, neighbors, query_points=None, columns=None):
     r"""Helper function to return a neighbor list object if is given, or to
     construct one using AABBQuery if it is not.
 
@@ -853,6 +1340,10 @@ def _make_default_nlist(system, neighbors, query_points=None):
             query_points is :code:`None` and :code:`True` otherwise.
         nlist (:class:`freud.locality.NeighborList`, optional):
             NeighborList to use to find bonds (Default value = :code:`None`).
+        columns (Iterable[str], optional):
+            Columns stored by a constructed neighbor list, see
+            :meth:`NeighborQueryResult.toNeighborList` (Default value =
+            :code:`None`).
 
     Returns:
         :class:`freud.locality.NeighborList`:
@@ -869,7 +1360,7 @@ def _make_default_nlist(system, neighbors, query_points=None):
         query_args.setdefault('exclude_ii', query_points is None)
         nq = _make_default_nq(system)
         qp = query_points if query_points is not None else nq.points
-        return nq.query(qp, query_args).toNeighborList()
+        return nq.query(qp, query_args).toNeighborList(columns=columns)
 
 
 cdef class _RawPoints(NeighborQuery):
@@ -925,6 +1416,49 @@ cdef class AABBQuery(NeighborQuery):
         if type(self) is AABBQuery:
             del self.thisptr
 
+    def query_nearest(self, query_points, query_args):
+        r"""Find the nearest neighbors of the provided points as dense arrays.
+
+        This is equivalent to a ``'nearest'`` mode :meth:`~.query`, but
+        skips the construction of bonds and returns the neighbors of each
+        query point in a row sorted by distance. If fewer than
+        ``num_neighbors`` neighbors are found for a query point, the
+        remaining entries of its row have an index equal to the number of
+        points and an infinite distance.
+
+        Args:
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`):
+                Points to query for.
+            query_args (dict):
+                Query arguments determining how to find neighbors. The mode
+                is always ``'nearest'``.
+
+        Returns:
+            tuple (:class:`numpy.ndarray`, :class:`numpy.ndarray`):
+                The (:math:`N_{query\_points}`, :math:`k`) point indices and
+                distances of the neighbors of each query point.
+        """
+        query_points = freud.util._convert_array(
+            np.atleast_2d(query_points), shape=(None, 3))
+        cdef const float[:, ::1] l_query_points = query_points
+        cdef unsigned int num_query_points = l_query_points.shape[0]
+
+        query_args = dict(query_args)
+        query_args['mode'] = 'nearest'
+        cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
+
+        cdef ManagedArray[unsigned int] point_indices
+        cdef ManagedArray[float] distances
+        with nogil:
+            self.thisptr.queryNearest(
+                <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                dereference(args.thisptr), point_indices, distances)
+
+        return (freud.util.make_managed_numpy_array(
+                    &point_indices, freud.util.arr_type_t.UNSIGNED_INT),
+                freud.util.make_managed_numpy_array(
+                    &distances, freud.util.arr_type_t.FLOAT))
+
 
 cdef class LinkCell(NeighborQuery):
     r"""Supports efficiently finding all points in a set within a certain
@@ -1031,11 +1565,36 @@ cdef class _PairCompute(_Compute):
                 nlist = NeighborList(_null=True)
             except NotImplementedError:
                 raise
+            if qargs.half_list and query_points is not None:
+                raise ValueError(
+                    "Half neighbor lists can only be found from the points "
+                    "themselves, so query_points cannot be provided.")
         else:
             raise ValueError('An invalid value was provided for neighbors, '
                              'which must be a dict or NeighborList object.')
         return nlist, qargs
 
+    def _check_half_list_query_data(self, _QueryArgs qargs, query_data):
+        """Raise if the bonds of a half neighbor list cannot be mirrored.
+
+        Each bond of a half neighbor list is also counted from its point, so
+        the query points must have the same per-point data (e.g. orientations
+        or values) as the points.
+
+        Args:
+            qargs (:class:`_QueryArgs`):
+                The resolved query arguments.
+            query_data:
+                The per-point data of the query points provided separately
+                from that of the points, or :code:`None` if it was not
+                provided.
+        """
+        if qargs.half_list and query_data is not None:
+            raise ValueError(
+                "Half neighbor lists require the query points to have the "
+                "same data as the points, so separate query data cannot be "
+                "provided.")
+
     @property
     def default_query_args(self):
         """No default query arguments."""
@@ -1058,6 +1617,50 @@ cdef class _SpatialHistogram(_PairCompute):
         :code:`{'mode': 'ball', 'r_max': self.r_max}`."""
         return dict(mode="ball", r_max=self.r_max)
 
+    def _preprocess_frames(self, systems, query_points=None, neighbors=None):
+        """Process the arguments of a multi-frame compute into freud's
+        internal types.
+
+        Each system is converted into a
+        :class:`freud.locality.NeighborQuery` with
+        :meth:`~.NeighborQuery.from_system`. Systems that are not already
+        :class:`~.NeighborQuery` objects are only turned into a spatial data
+        structure when they are first queried, so the C++ computation builds
+        the data structures of different frames concurrently.
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame.
+            query_points (iterable, optional):
+                Query points of each frame. Uses the points of each system if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of query arguments used for all frames (Default
+                value = :code:`None`).
+
+        Returns:
+            tuple: The list of :class:`~.NeighborQuery` objects, the list of
+            query point arrays and the query arguments.
+        """
+        if type(neighbors) is NeighborList:
+            raise ValueError(
+                "Neighbors must be given as a dictionary of query arguments "
+                "when computing several frames.")
+        _, qargs = self._resolve_neighbors(neighbors, query_points)
+        nqs = [NeighborQuery.from_system(system) for system in systems]
+        if query_points is None:
+            query_points_list = [nq.points for nq in nqs]
+        else:
+            query_points_list = [
+                freud.util._convert_array(qp, shape=(None, 3))
+                for qp in query_points]
+            if len(query_points_list) != len(nqs):
+                raise ValueError(
+                    "query_points must be provided for every frame.")
+        return nqs, query_points_list, qargs
+
     @_Compute._computed_property
     def box(self):
         """:class:`freud.box.Box`: The box object used in the last
@@ -1146,6 +1749,147 @@ cdef class _SpatialHistogram1D(_SpatialHistogram):
         return self.histptr.getAxisSizes()[0]
 
 
+cdef class DomainDecomposition(_Compute):
+    r"""Split a periodic box into a grid of domains with ghost layers.
+
+    The box is split into domains of equal size along its box vectors. Each
+    point is owned by the domain containing it, and is a ghost of every other
+    domain whose extent along each box vector lies within ``ghost_width`` of
+    the point. A domain together with its ghosts therefore holds every point
+    within ``ghost_width`` of the points it owns. Like
+    :class:`~.PeriodicBuffer`, the ghost layers are slabs along the box
+    vectors, so they may also hold some points farther away.
+
+    This allows quantities of systems too large for one node to be computed
+    by several processes, e.g. with MPI. Each process holds the points of one
+    domain and its ghosts. Bond histograms such as :class:`freud.density.RDF`
+    are computed with the owned points as query points and the owned and
+    ghost points as points in the full box, and combined with
+    :meth:`freud.density.RDF.reduce_domains`. Structure factors are computed
+    from the owned points only with the ``comm`` argument of
+    :meth:`freud.diffraction.StaticStructureFactorDirect.compute`. The ghost
+    width must be at least the ``r_max`` of the bond histogram.
+
+    The domains are indexed as :code:`(z * ny + y) * nx + x` for
+    :code:`domains = (nx, ny, nz)`. The ghosts are listed grouped by domain,
+    in the layout expected by an all-to-all exchange such as
+    :code:`MPI_Alltoallv`.
+
+    Args:
+        domains (list of 3 ints):
+            The number of domains along each box vector. Must be 1 along the
+            third box vector of 2D boxes.
+        ghost_width (float):
+            The width of the ghost layer of each domain, at most the width of
+            the domains along every box vector with more than one domain.
+    """
+
+    def __cinit__(self, domains, float ghost_width):
+        if len(domains) != 3:
+            raise ValueError("domains must have length 3.")
+        self.thisptr = new freud._locality.DomainDecomposition(
+            vec3[unsigned int](domains[0], domains[1], domains[2]),
+            ghost_width)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system):
+        r"""Assign the points of a system to domains and find the ghosts of
+        each domain.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+        """
+        cdef NeighborQuery nq = _make_default_nq(system)
+        with nogil:
+            self.thisptr.compute(nq.get_ptr())
+        return self
+
+    def domain_indices(self, unsigned int domain):
+        r"""Get the indices of the points held by a domain.
+
+        Args:
+            domain (int):
+                The index of the domain.
+
+        Returns:
+            tuple: The indices of the points owned by the domain and the
+            indices of its ghost points, each a :class:`numpy.ndarray`.
+        """
+        if domain >= self.num_domains:
+            raise ValueError("domain must be less than num_domains.")
+        owned = np.flatnonzero(self.point_domains == domain)
+        offsets = np.concatenate(([0], np.cumsum(self.ghost_counts)))
+        ghosts = self.ghost_indices[offsets[domain]:offsets[domain + 1]]
+        return owned, ghosts
+
+    @_Compute._computed_property
+    def box(self):
+        """:class:`freud.box.Box`: The box used in the last computation."""
+        return freud.box.BoxFromCPP(self.thisptr.getBox())
+
+    @property
+    def domains(self):
+        """tuple: The number of domains along each box vector."""
+        cdef vec3[unsigned int] domains = self.thisptr.getNumDomainsPerAxis()
+        return (domains.x, domains.y, domains.z)
+
+    @property
+    def num_domains(self):
+        """int: The total number of domains."""
+        return self.thisptr.getNumDomains()
+
+    @property
+    def ghost_width(self):
+        """float: The width of the ghost layers."""
+        return self.thisptr.getGhostWidth()
+
+    @_Compute._computed_property
+    def point_domains(self):
+        """:math:`\\left(N_{points}\\right)` :class:`numpy.ndarray`: The
+        domain owning each point."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getPointDomains(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def ghost_indices(self):
+        """:math:`\\left(N_{ghosts}\\right)` :class:`numpy.ndarray`: The
+        indices of the ghost points, grouped by the domain they are ghosts of
+        and in increasing order within each domain."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getGhostIndices(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def ghost_domains(self):
+        """:math:`\\left(N_{ghosts}\\right)` :class:`numpy.ndarray`: The
+        domain each ghost point in :attr:`ghost_indices` is a ghost of."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getGhostDomains(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def ghost_counts(self):
+        """:math:`\\left(N_{domains}\\right)` :class:`numpy.ndarray`: The
+        number of ghost points of each domain."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getGhostCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    def __repr__(self):
+        return ("freud.locality.{cls}(domains={domains}, "
+                "ghost_width={ghost_width})").format(
+                    cls=type(self).__name__, domains=list(self.domains),
+                    ghost_width=self.ghost_width)
+
+    def __str__(self):
+        return repr(self)
+
+
 cdef class PeriodicBuffer(_Compute):
     r"""Replicate periodic images of points inside a box."""
 
@@ -1187,8 +1931,12 @@ cdef class PeriodicBuffer(_Compute):
             buffer_vec = vec3[float](buffer[0], buffer[1], buffer[2])
         else:
             raise ValueError('buffer must be a scalar or have length 3.')
+        cdef cbool l_images = images
+        cdef cbool l_include_input_points = include_input_points
 
-        self.thisptr.compute(nq.get_ptr(), buffer_vec, images, include_input_points)
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(), buffer_vec, l_images,
+                                 l_include_input_points)
         return self
 
     @_Compute._computed_property
@@ -1218,6 +1966,103 @@ cdef class PeriodicBuffer(_Compute):
         return repr(self)
 
 
+cdef class VerletList(_Compute):
+    r"""Reuse a neighbor list across frames using a skin distance.
+
+    A Verlet list finds all neighbors within a distance of
+    :code:`r_max + skin` and caches those candidate bonds. On subsequent calls
+    to :meth:`compute`, the candidate bonds are only rebuilt if any point has
+    moved more than :code:`skin / 2` since the last build, or if the box or
+    the number of points has changed. Otherwise, the bond vectors and distances
+    are recomputed from the current positions and the result is filtered to
+    :code:`r_max`. The resulting neighbor list is identical to a ball query
+    with :code:`r_max`, up to the order of bonds within each query point.
+
+    This is useful when analyzing consecutive frames of a trajectory in which
+    points move only a small distance between frames.
+
+    Args:
+        r_max (float):
+            Maximum neighbor distance.
+        skin (float):
+            Extra distance added to :code:`r_max` when building the candidate
+            bonds. Larger values result in fewer rebuilds at the cost of more
+            candidate bonds.
+        exclude_ii (bool, optional):
+            Whether to exclude bonds between a point and itself
+            (Default value = :code:`True`).
+    """
+
+    def __cinit__(self, float r_max, float skin, cbool exclude_ii=True):
+        self.thisptr = new freud._locality.VerletList(r_max, skin, exclude_ii)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system):
+        r"""Compute the neighbor list, reusing cached bonds if possible.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`. The
+                neighbor query is used to rebuild the candidate bonds.
+        """
+        cdef NeighborQuery nq = NeighborQuery.from_system(system)
+        with nogil:
+            self.thisptr.compute(nq.get_ptr())
+        return self
+
+    def reset(self):
+        r"""Discard the cached bonds so that the next call to
+        :meth:`compute` rebuilds them."""
+        self.thisptr.reset()
+        return self
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`~.locality.NeighborList`: The neighbor list of bonds within
+        :code:`r_max`."""
+        nlist = _nlist_from_cnlist(self.thisptr.getNeighborList().get())
+        nlist._compute = self
+        return nlist
+
+    @_Compute._computed_property
+    def rebuilt(self):
+        """bool: Whether the last call to :meth:`compute` rebuilt the
+        candidate bonds."""
+        return self.thisptr.getRebuilt()
+
+    @property
+    def num_rebuilds(self):
+        """int: The number of times the candidate bonds have been built."""
+        return self.thisptr.getNumRebuilds()
+
+    @property
+    def r_max(self):
+        """float: Maximum neighbor distance."""
+        return self.thisptr.getRMax()
+
+    @property
+    def skin(self):
+        """float: Extra distance used when building the candidate bonds."""
+        return self.thisptr.getSkin()
+
+    @property
+    def exclude_ii(self):
+        """bool: Whether bonds between a point and itself are excluded."""
+        return self.thisptr.getExcludeII()
+
+    def __repr__(self):
+        return ("freud.locality.{cls}(r_max={r_max}, skin={skin}, "
+                "exclude_ii={exclude_ii})").format(
+                    cls=type(self).__name__, r_max=self.r_max,
+                    skin=self.skin, exclude_ii=self.exclude_ii)
+
+    def __str__(self):
+        return repr(self)
+
+
 cdef class Voronoi(_Compute):
     r"""Computes Voronoi diagrams using voro++.
 
@@ -1231,10 +2076,18 @@ cdef class Voronoi(_Compute):
 
     The voro++ library :cite:`Rycroft2009` is used for fast computations of the
     Voronoi diagram.
+
+    Args:
+        compute_polytopes (bool, optional):
+            Whether to store the vertices of each cell. When only the
+            volumes and the neighbor list are needed, for example to compute
+            :class:`freud.order.ContinuousCoordination`, setting this to
+            :code:`False` saves the time and memory used by the polytopes.
+            (Default value = :code:`True`).
     """
 
-    def __cinit__(self):
-        self.thisptr = new freud._locality.Voronoi()
+    def __cinit__(self, compute_polytopes=True):
+        self.thisptr = new freud._locality.Voronoi(compute_polytopes)
         self._nlist = NeighborList()
 
     def __dealloc__(self):
@@ -1249,14 +2102,24 @@ cdef class Voronoi(_Compute):
                 :class:`freud.locality.NeighborQuery.from_system`.
         """
         cdef NeighborQuery nq = NeighborQuery.from_system(system)
-        self.thisptr.compute(nq.get_ptr())
+        with nogil:
+            self.thisptr.compute(nq.get_ptr())
         self._box = nq.box
         return self
 
+    @property
+    def compute_polytopes(self):
+        """bool: Whether the vertices of each cell are stored."""
+        return self.thisptr.getComputePolytopes()
+
     @_Compute._computed_property
     def polytopes(self):
         """list[:class:`numpy.ndarray`]: A list of :class:`numpy.ndarray`
-        defining Voronoi polytope vertices for each cell."""
+        defining Voronoi polytope vertices for each cell. Only available when
+        :attr:`compute_polytopes` is :code:`True`."""
+        if not self.compute_polytopes:
+            raise AttributeError(
+                "Polytopes are only available with compute_polytopes=True.")
         polytopes = []
         cdef vector[vector[vec3[double]]] raw_polytopes = \
             self.thisptr.getPolytopes()
@@ -1308,8 +2171,8 @@ cdef class Voronoi(_Compute):
         return self._nlist
 
     def __repr__(self):
-        return "freud.locality.{cls}()".format(
-            cls=type(self).__name__)
+        return "freud.locality.{cls}(compute_polytopes={compute_polytopes})".format(
+            cls=type(self).__name__, compute_polytopes=self.compute_polytopes)
 
     def __str__(self):
         return repr(self)
@@ -1408,10 +2271,11 @@ cdef class Filter(_PairCompute):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
 
-        self._filterptr.compute(nq.get_ptr(),
-                                <vec3[float]*> &l_query_points[0, 0],
-                                num_query_points, nlist.get_ptr(),
-                                dereference(qargs.thisptr))
+        with nogil:
+            self._filterptr.compute(nq.get_ptr(),
+                                    <vec3[float]*> &l_query_points[0, 0],
+                                    num_query_points, nlist.get_ptr(),
+                                    dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -6,60 +6,20 @@ The :class:`freud.msd` module provides functions for computing the
 mean-squared-displacement (MSD) of particles in periodic systems.
 """
 
-from freud.util cimport _Compute
-import logging
+from cython.operator cimport dereference
+
+from freud.util cimport _Compute, vec3
 
 import numpy as np
 
-import freud.parallel
+import freud.locality
 
 cimport numpy as np
 
+cimport freud._msd
 cimport freud.box
-
-logger = logging.getLogger(__name__)
-
-# Use fastest available fft library
-try:
-    import pyfftw
-    logger.info("Using PyFFTW for FFTs")
-
-    pyfftw.config.NUM_THREADS = min(1, freud.parallel.get_num_threads())
-    logger.info("Setting number of threads to {}".format(
-        freud.parallel.get_num_threads()))
-
-    # Note that currently these functions are defined to match only the parts
-    # of the numpy/scipy API that are actually used below. There is no promise
-    # that other aspects of the API will be preserved.
-    def fft(x, n, axis):
-        a = pyfftw.empty_aligned(x.shape, 'complex64')
-        a[:] = x
-        fft_object = pyfftw.builders.fft(a, n=n, axis=axis)
-        return fft_object()
-
-    def ifft(x, axis):
-        a = pyfftw.empty_aligned(x.shape, 'complex64')
-        a[:] = x
-        fft_object = pyfftw.builders.ifft(a, axis=axis)
-        return fft_object()
-except ImportError:
-    try:
-        from scipy.fftpack import fft, ifft
-        logger.info("Using SciPy's fftpack for FFTs")
-    except ImportError:
-        from numpy.fft import fft, ifft
-        logger.info("Using NumPy for FFTs")
-
-
-def _autocorrelation(x):
-    r"""Compute the autocorrelation of a sequence"""
-    N = x.shape[0]
-    F = fft(x, n=2*N, axis=0)
-    PSD = F * F.conjugate()
-    res = ifft(PSD, axis=0)
-    res = (res[:N]).real
-    n = np.arange(1, N+1)[::-1]  # N to 1
-    return res/n[:, np.newaxis]
+cimport freud.locality
+cimport freud.util
 
 
 cdef class MSD(_Compute):
@@ -94,21 +54,11 @@ cdef class MSD(_Compute):
       <https://stackoverflow.com/questions/34222272/computing-mean-square-displacement-using-python-and-fft>`_.
 
       .. note::
-          The most intensive part of this calculation is computing an FFT. To
-          maximize performance, freud attempts to use the fastest FFT library
-          available. By default, the order of preference is `pyFFTW
-          <https://github.com/pyFFTW/pyFFTW>`_, SciPy, and then NumPy. If you
-          are experiencing significant slowdowns in calculating the MSD, you
-          may benefit from installing a faster FFT library, which freud will
-          automatically detect. The performance change will be especially
-          noticeable if the length of your trajectory is a number whose prime
-          factorization consists of extremely large prime factors. The
-          standard Cooley-Tukey FFT algorithm performs very poorly in this
-          case, so installing pyFFTW will significantly improve performance.
-
-          Note that while pyFFTW is released under the BSD 3-Clause license,
-          the FFTW library is available under either GPL or a commercial
-          license.
+          The FFTs are computed in C++ and parallelized over particles. The
+          positions are zero-padded to a length whose prime factors are all
+          2, 3 or 5, so the performance does not depend on the prime
+          factorization of the length of the trajectory. For trajectories
+          that do not fit in memory, use :class:`StreamingMSD`.
 
     * :code:`'direct'`:
       Under some circumstances, however, we may be more interested in
@@ -141,6 +91,7 @@ cdef class MSD(_Compute):
             Mode of calculation. Options are :code:`'window'` and
             :code:`'direct'`.  (Default value = :code:`'window'`).
     """   # noqa: E501
+    cdef freud._msd.MSD * thisptr
     cdef freud.box.Box _box
     cdef _particle_msd
     cdef str mode
@@ -156,6 +107,10 @@ cdef class MSD(_Compute):
         if mode not in ['window', 'direct']:
             raise ValueError("Invalid mode")
         self.mode = mode
+        self.thisptr = new freud._msd.MSD(mode == 'window')
+
+    def __dealloc__(self):
+        del self.thisptr
 
     def compute(self, positions, images=None, reset=True):
         """Calculate the MSD for the positions provided.
@@ -187,6 +142,11 @@ cdef class MSD(_Compute):
                 the new computation; if False, will accumulate data (Default
                 value: True).
         """  # noqa: E501
+        cdef:
+            const float[:, :, ::1] l_positions
+            unsigned int num_frames
+            unsigned int num_particles
+
         if reset:
             self._particle_msd = []
 
@@ -206,28 +166,15 @@ cdef class MSD(_Compute):
                     unwrapped_positions[i, :, :], images[i, :, :])
             positions = unwrapped_positions
 
-        if self.mode == 'window':
-            # First compute the first term r^2(k+m) - r^2(k)
-            N = positions.shape[0]
-            D = np.square(positions).sum(axis=2)
-            D = np.append(D, np.zeros(positions.shape[:2]), axis=0)
-            Q = 2*D.sum(axis=0)
-            S1 = np.zeros(positions.shape[:2])
-            for m in range(N):
-                Q -= (D[m-1, :] + D[N-m, :])
-                S1[m, :] = Q/(N-m)
-
-            # The second term can be computed via autocorrelation
-            corrs = []
-            for i in range(positions.shape[2]):
-                corrs.append(_autocorrelation(positions[:, :, i]))
-            S2 = np.sum(corrs, axis=0)
-
-            self._particle_msd.append(S1 - 2*S2)
-        elif self.mode == 'direct':
-            self._particle_msd.append(
-                np.linalg.norm(
-                    positions - positions[[0], :, :], axis=-1)**2)
+        l_positions = positions
+        num_frames = positions.shape[0]
+        num_particles = positions.shape[1]
+        with nogil:
+            self.thisptr.compute(<vec3[float]*> &l_positions[0, 0, 0],
+                                 num_frames, num_particles)
+        self._particle_msd.append(freud.util.make_managed_numpy_array(
+            &self.thisptr.getParticleMSD(),
+            freud.util.arr_type_t.DOUBLE).copy())
 
         return self
 
@@ -280,3 +227,215 @@ cdef class MSD(_Compute):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class StreamingMSD(_Compute):
+    r"""Accumulate the windowed mean squared displacement frame by frame.
+
+    This class computes the same quantity as the :code:`'window'` mode of
+    :class:`MSD`, but frames are provided one at a time (or in chunks), so
+    trajectories that do not fit in memory can be analyzed. The MSD is
+    accumulated with a multiple-tau correlator :cite:`Ramirez2010`, which
+    gives logarithmically spaced lags with memory independent of the length
+    of the trajectory.
+
+    The correlator holds a hierarchy of levels of :code:`points_per_level`
+    frames. Level 0 holds the most recent frames, and every
+    :code:`level_factor`-th frame of each level is also added to the next
+    level, so level :math:`l` holds frames :math:`\text{level_factor}^l`
+    apart. The lags of level :math:`l` are multiples of
+    :math:`\text{level_factor}^l`, and are averaged over the time origins
+    that are multiples of :math:`\text{level_factor}^l`. Displacements are
+    computed exactly, so for lags below :code:`points_per_level` the result
+    is identical to :class:`MSD`, and at longer lags only fewer time origins
+    are averaged over.
+
+    The correlator holds :math:`\text{points_per_level} \times N_{levels}`
+    frames, where :math:`N_{levels}` grows logarithmically with the number of
+    frames.
+
+    .. note::
+        The MSD is only well-defined when the box is constant over the
+        course of the simulation. Additionally, the number of particles must be
+        constant over the course of the simulation.
+
+    Args:
+        box (:class:`freud.box.Box`, optional):
+            If not provided, the class will assume that all positions provided
+            in calls to :meth:`~compute` are already unwrapped. (Default value
+            = :code:`None`).
+        points_per_level (unsigned int, optional):
+            Number of frames held in each level of the correlator. (Default
+            value = 16).
+        level_factor (unsigned int, optional):
+            Ratio of the frame spacings of consecutive levels, which must be
+            at least 2 and less than :code:`points_per_level`. (Default value
+            = 2).
+    """
+    cdef freud._msd.StreamingMSD * thisptr
+    cdef freud.box.Box _box
+
+    def __cinit__(self, box=None, points_per_level=16, level_factor=2):
+        if box is not None:
+            self._box = freud.util._convert_box(box)
+        else:
+            self._box = None
+        self.thisptr = new freud._msd.StreamingMSD(points_per_level,
+                                                   level_factor)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, positions, images=None, reset=True):
+        r"""Add frames of a trajectory to the MSD.
+
+        Example::
+
+            >>> import freud
+            >>> import numpy as np
+            >>> msd = freud.msd.StreamingMSD()
+            >>> for frame in range(100):
+            ...     positions = np.random.rand(10, 3)
+            ...     _ = msd.compute(positions, reset=False)
+            >>> msd.lags[:4]
+            array([0, 1, 2, 3], dtype=uint32)
+
+        Args:
+            positions ((:math:`N_{particles}`, 3) or (:math:`N_{frames}`, :math:`N_{particles}`, 3) :class:`numpy.ndarray` or :class:`freud.locality.GSDTrajectory`):
+                The particle positions of one frame or of consecutive frames
+                of the trajectory. If neither box nor images are provided, the
+                positions are assumed to be unwrapped already. If a
+                :class:`freud.locality.GSDTrajectory` is given, its frames are
+                streamed from the file in C++ and unwrapped with the box and
+                images stored in the file.
+            images ((:math:`N_{particles}`, 3) or (:math:`N_{frames}`, :math:`N_{particles}`, 3) :class:`numpy.ndarray`, optional):
+                The particle images to unwrap with if provided. Must be
+                provided along with a simulation box (in the constructor) if
+                particle positions need to be unwrapped. If neither are
+                provided, positions are assumed to be unwrapped already.
+                (Default value = :code:`None`).
+            reset (bool):
+                Whether to erase the previously added frames before adding
+                these frames; if False, the frames continue the trajectory
+                (Default value: True).
+        """  # noqa: E501
+        cdef:
+            const float[:, :, ::1] l_positions
+            unsigned int num_frames
+            unsigned int num_particles
+            unsigned int frame
+            freud.locality.GSDTrajectory trajectory
+
+        if reset:
+            self.thisptr.reset()
+
+        if isinstance(positions, freud.locality.GSDTrajectory):
+            trajectory = positions
+            with nogil:
+                self.thisptr.updateTrajectory(
+                    dereference(trajectory.thisptr), trajectory.first,
+                    trajectory.last, trajectory.stride)
+            return self
+
+        positions = np.asarray(positions)
+        if positions.ndim == 2:
+            positions = positions[np.newaxis]
+            if images is not None:
+                images = np.asarray(images)[np.newaxis]
+        positions = freud.util._convert_array(
+            positions, shape=(None, None, 3))
+        if images is not None:
+            images = freud.util._convert_array(
+                images, shape=positions.shape, dtype=np.int32)
+
+        # Make sure we aren't modifying the provided array
+        if self._box is not None and images is not None:
+            unwrapped_positions = positions.copy()
+            for i in range(positions.shape[0]):
+                unwrapped_positions[i, :, :] = self._box.unwrap(
+                    unwrapped_positions[i, :, :], images[i, :, :])
+            positions = unwrapped_positions
+
+        l_positions = positions
+        num_frames = positions.shape[0]
+        num_particles = positions.shape[1]
+        with nogil:
+            for frame in range(num_frames):
+                self.thisptr.update(<vec3[float]*> &l_positions[frame, 0, 0],
+                                    num_particles)
+        return self
+
+    @property
+    def box(self):
+        """:class:`freud.box.Box`: Box used in the calculation."""
+        return self._box
+
+    @property
+    def points_per_level(self):
+        """unsigned int: Number of frames held in each level."""
+        return self.thisptr.getPointsPerLevel()
+
+    @property
+    def level_factor(self):
+        """unsigned int: Ratio of the frame spacings of consecutive levels."""
+        return self.thisptr.getLevelFactor()
+
+    @_Compute._computed_property
+    def num_frames(self):
+        """unsigned int: Number of frames added since the last reset."""
+        return self.thisptr.getNumFrames()
+
+    @_Compute._computed_property
+    def lags(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The lags,
+        in frames, at which the MSD is accumulated."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getLags(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def msd(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The mean
+        squared displacement at each lag."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getMSD(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def counts(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The number
+        of pairs of frames averaged over at each lag."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    def __repr__(self):
+        return ("freud.msd.{cls}(box={box}, points_per_level={p}, "
+                "level_factor={m})").format(
+                    cls=type(self).__name__, box=self._box,
+                    p=self.points_per_level, m=self.level_factor)
+
+    def plot(self, ax=None):
+        """Plot MSD.
+
+        Args:
+            ax (:class:`matplotlib.axes.Axes`, optional): Axis to plot on. If
+                :code:`None`, make a new figure and axis.
+                (Default value = :code:`None`)
+
+        Returns:
+            (:class:`matplotlib.axes.Axes`): Axis with the plot.
+        """
+        import freud.plot
+        return freud.plot.line_plot(self.lags, self.msd,
+                                    title="MSD",
+                                    xlabel="Window size",
+                                    ylabel="MSD",
+                                    ax=ax)
+
+    def _repr_png_(self):
+        try:
+            import freud.plot
+            return freud.plot._ax_to_bytes(self.plot())
+        except (AttributeError, ImportError):
+            return None
@@ -82,8 +82,9 @@ cdef class Cubatic(_Compute):
         cdef const float[:, ::1] l_orientations = orientations
         cdef unsigned int num_particles = l_orientations.shape[0]
 
-        self.thisptr.compute(
-            <quat[float]*> &l_orientations[0, 0], num_particles)
+        with nogil:
+            self.thisptr.compute(
+                <quat[float]*> &l_orientations[0, 0], num_particles)
         return self
 
     @property
@@ -159,7 +160,7 @@ cdef class Cubatic(_Compute):
                                        seed=self.seed)
 
 
-cdef class Nematic(_Compute):
+cdef class Nematic(_PairCompute):
     r"""Compute the nematic order parameter for a system of particles.
 
     Note:
@@ -184,6 +185,7 @@ cdef class Nematic(_Compute):
 
     """
     cdef freud._order.Nematic *thisptr
+    cdef bint _has_particle_order
 
     def __cinit__(self):
         self.thisptr = new freud._order.Nematic()
@@ -191,9 +193,13 @@ cdef class Nematic(_Compute):
     def __dealloc__(self):
         del self.thisptr
 
-    def compute(self, orientations):
+    def compute(self, orientations, system=None, neighbors=None):
         r"""Calculates the per-particle and global order parameter.
 
+        If a system is given, the local order parameter of each particle is
+        also computed from the average of its tensor with the tensors of its
+        neighbors.
+
         Example::
 
             >>> orientations = np.array([[1, 0, 0]] * 100)
@@ -206,7 +212,25 @@ cdef class Nematic(_Compute):
         Args:
             orientations (:math:`\left(N_{particles}, 3 \right)` :class:`numpy.ndarray`):
                 Orientation vectors for which to calculate the order parameter.
+            system (optional):
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`, with one
+                point per orientation, used to compute
+                :attr:`particle_order` (Default value: None).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation of
+                :attr:`particle_order`, or a dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
         """   # noqa: E501
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
         if orientations.shape[1] == 4:
             raise ValueError('In freud versions >=3.0.0, Nematic.compute() takes '
                              '3d orientation vectors instead of 4d quaternions.')
@@ -220,8 +244,57 @@ cdef class Nematic(_Compute):
         cdef const float[:, ::1] l_orientations = orientations
         cdef unsigned int num_particles = l_orientations.shape[0]
 
-        self.thisptr.compute(<vec3[float]*> &l_orientations[0, 0],
-                             num_particles)
+        with nogil:
+            self.thisptr.compute(<vec3[float]*> &l_orientations[0, 0],
+                                 num_particles)
+        self._has_particle_order = False
+        if system is not None:
+            nq, nlist, qargs, l_query_points, num_query_points = \
+                self._preprocess_arguments(system, neighbors=neighbors)
+            with nogil:
+                self.thisptr.computeLocal(nlist.get_ptr(), nq.get_ptr(),
+                                          dereference(qargs.thisptr))
+            self._has_particle_order = True
+        return self
+
+    def compute_frames(self, orientations):
+        r"""Calculates the global order parameter of several frames.
+
+        The order parameter and director of every frame are available from
+        :attr:`frame_order` and :attr:`frame_directors`. All other
+        properties describe the last frame.
+
+        Example::
+
+            >>> orientations = np.tile([1, 0, 0], (10, 100, 1))
+            >>> nematic = freud.order.Nematic()
+            >>> nematic.compute_frames(orientations)
+            freud.order.Nematic()
+            >>> print(nematic.frame_order.shape)
+            (10,)
+
+        Args:
+            orientations (:math:`\left(N_{frames}, N_{particles}, 3 \right)` :class:`numpy.ndarray`):
+                Orientation vectors of each frame for which to calculate the
+                order parameter.
+        """   # noqa: E501
+        orientations = freud.util._convert_array(
+            orientations, shape=(None, None, 3))
+        if orientations.shape[0] == 0 or orientations.shape[1] == 0:
+            raise ValueError('Nematic.compute_frames() requires at least one '
+                             'frame with at least one orientation.')
+        if not np.all(np.any(orientations, axis=-1)):
+            warnings.warn('Including zero vector in the orientations array '
+                          'may lead to undefined behavior.',
+                          UserWarning)
+        cdef const float[:, :, ::1] l_orientations = orientations
+        cdef unsigned int num_frames = l_orientations.shape[0]
+        cdef unsigned int num_particles = l_orientations.shape[1]
+
+        with nogil:
+            self.thisptr.computeFrames(<vec3[float]*> &l_orientations[0, 0, 0],
+                                       num_frames, num_particles)
+        self._has_particle_order = False
         return self
 
     @_Compute._computed_property
@@ -245,6 +318,37 @@ cdef class Nematic(_Compute):
             &self.thisptr.getParticleTensor(),
             freud.util.arr_type_t.FLOAT)
 
+    @_Compute._computed_property
+    def particle_order(self):
+        """:math:`\left(N_{particles} \right)` :class:`numpy.ndarray`: The
+        local nematic order parameter of each particle. Only available when
+        a system was passed to :meth:`compute`."""
+        if not self._has_particle_order:
+            raise AttributeError(
+                "The particle order is only available when compute() is "
+                "called with a system.")
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getParticleOrder(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def frame_order(self):
+        """:math:`\left(N_{frames} \right)` :class:`numpy.ndarray`: The
+        nematic order parameter of each frame of the last call to
+        :meth:`compute_frames`, or of the single frame of :meth:`compute`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getFrameOrder(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def frame_directors(self):
+        """:math:`\left(N_{frames}, 3 \right)` :class:`numpy.ndarray`: The
+        nematic director of each frame of the last call to
+        :meth:`compute_frames`, or of the single frame of :meth:`compute`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getFrameDirectors(),
+            freud.util.arr_type_t.FLOAT)
+
     @_Compute._computed_property
     def nematic_tensor(self):
         """:math:`\\left(3, 3 \\right)` :class:`numpy.ndarray`: 3x3 matrix
@@ -349,8 +453,9 @@ cdef class Hexatic(_PairCompute):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(), dereference(qargs.thisptr))
         return self
 
     @property
@@ -610,12 +715,13 @@ cdef class Steinhardt(_PairCompute):
         """:math:`\\left(N_{particles}, 2l+1\\right)` :class:`numpy.ndarray`:
         The raw array of :math:`q_{lm}(i)`. The array is provided in the
         order given by fsph: :math:`m = 0, 1, ..., l, -1, ..., -l`."""
-        qlm_arrays = self.thisptr.getQlm()
-        # Since Cython does not really support const iteration, we must iterate
-        # using range and not use the for array in qlm_arrays style for loop.
-        qlm_list = [freud.util.make_managed_numpy_array(
-            &qlm_arrays[i], freud.util.arr_type_t.COMPLEX_FLOAT)
-            for i in range(qlm_arrays.size())]
+        # The harmonics of all l are stored in one packed array, which is
+        # split into views for each l.
+        qlm = freud.util.make_managed_numpy_array(
+            &self.thisptr.getQlm(), freud.util.arr_type_t.COMPLEX_FLOAT)
+        offsets = list(self.thisptr.getMsOffsets()) + [qlm.shape[1]]
+        qlm_list = [qlm[:, offsets[i]:offsets[i + 1]]
+                    for i in range(len(offsets) - 1)]
         return qlm_list if len(qlm_list) > 1 else qlm_list[0]
 
     def compute(self, system, neighbors=None):
@@ -649,9 +755,10 @@ cdef class Steinhardt(_PairCompute):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
 
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(),
-                             dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(),
+                                 dereference(qargs.thisptr))
         return self
 
     def __repr__(self):
@@ -750,6 +857,7 @@ cdef class SolidLiquid(_PairCompute):
             :code:`True`).
     """  # noqa: E501
     cdef freud._order.SolidLiquid * thisptr
+    cdef freud.locality.NeighborQuery _nq
 
     def __cinit__(self, l, q_threshold, solid_threshold, normalize_q=True):
         self.thisptr = new freud._order.SolidLiquid(
@@ -781,9 +889,39 @@ cdef class SolidLiquid(_PairCompute):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(),
-                             dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(),
+                                 dereference(qargs.thisptr))
+        self._nq = nq
+        return self
+
+    def threshold(self, q_threshold=None, solid_threshold=None):
+        r"""Reclassify the last computed system with new thresholds.
+
+        The neighbor list, :math:`q_{lm}` and bond dot products
+        :math:`q_l(i, j)` from the last call to :meth:`compute` are reused,
+        so only the solid-like bonds, the solid-like particles and the
+        clusters are recomputed. This makes sweeps over thresholds on the
+        same system much cheaper than repeated calls to :meth:`compute`.
+
+        Args:
+            q_threshold (float, optional):
+                New value of the dot product threshold (Default value:
+                :code:`None`, which keeps the current value).
+            solid_threshold (unsigned int, optional):
+                New minimum number of solid-like bonds (Default value:
+                :code:`None`, which keeps the current value).
+        """
+        if not self._called_compute:
+            raise AttributeError(
+                "The compute method must be called before calling threshold.")
+        if q_threshold is None:
+            q_threshold = self.q_threshold
+        if solid_threshold is None:
+            solid_threshold = self.solid_threshold
+        self.thisptr.threshold(self._nq.get_ptr(), q_threshold,
+                               solid_threshold)
         return self
 
     @property
@@ -919,7 +1057,8 @@ cdef class RotationalAutocorrelation(_Compute):
     correlation with an initial state. As such, the output can be treated as an
     order parameter measuring degrees of rotational (de)correlation. For
     analysis of a trajectory, the compute call needs to be
-    done at each trajectory frame.
+    done at each trajectory frame. To compute the autocorrelation of a
+    trajectory at many lags, use :class:`StreamingRotationalAutocorrelation`.
 
     Args:
         l (int):
@@ -955,10 +1094,11 @@ cdef class RotationalAutocorrelation(_Compute):
         cdef const float[:, ::1] l_orientations = orientations
         cdef unsigned int nP = orientations.shape[0]
 
-        self.thisptr.compute(
-            <quat[float]*> &l_ref_orientations[0, 0],
-            <quat[float]*> &l_orientations[0, 0],
-            nP)
+        with nogil:
+            self.thisptr.compute(
+                <quat[float]*> &l_ref_orientations[0, 0],
+                <quat[float]*> &l_orientations[0, 0],
+                nP)
         return self
 
     @_Compute._computed_property
@@ -985,6 +1125,154 @@ cdef class RotationalAutocorrelation(_Compute):
                                                      sph_l=self.l)
 
 
+cdef class StreamingRotationalAutocorrelation(_Compute):
+    r"""Accumulate the rotational autocorrelation of a trajectory frame by frame.
+
+    This class computes the same quantity as
+    :class:`RotationalAutocorrelation`, averaged over all pairs of frames of
+    a trajectory separated by a given lag. Frames are provided one at a time
+    (or in chunks), and the autocorrelation is accumulated with a
+    multiple-tau correlator :cite:`Ramirez2010`, which gives logarithmically
+    spaced lags with memory independent of the length of the trajectory.
+
+    The hyperspherical harmonic expansion of each orientation is computed
+    once per frame, and the autocorrelation of two frames is the real part of
+    the inner product of their expansions. The correlator holds the
+    expansions of :code:`points_per_level` frames in each of its levels.
+    Level 0 holds the most recent frames, and every :code:`level_factor`-th
+    frame of each level is also added to the next level, so level :math:`l`
+    holds frames :math:`\text{level_factor}^l` apart. For lags below
+    :code:`points_per_level` the autocorrelation is averaged over all time
+    origins, and at longer lags only fewer time origins are averaged over.
+
+    .. note::
+        Each stored frame holds :math:`(l + 1)^2` complex values per
+        orientation, so the memory grows quickly with :math:`l`.
+
+    Args:
+        l (int):
+            Order of the hyperspherical harmonic. Must be a positive, even
+            integer.
+        points_per_level (unsigned int, optional):
+            Number of frames held in each level of the correlator. (Default
+            value = 16).
+        level_factor (unsigned int, optional):
+            Ratio of the frame spacings of consecutive levels, which must be
+            at least 2 and less than :code:`points_per_level`. (Default value
+            = 2).
+    """
+    cdef freud._order.StreamingRotationalAutocorrelation * thisptr
+
+    def __cinit__(self, l, points_per_level=16, level_factor=2):
+        if l % 2 or l < 0:
+            raise ValueError(
+                "The quantum number must be a positive, even integer.")
+        self.thisptr = new freud._order.StreamingRotationalAutocorrelation(
+            l, points_per_level, level_factor)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, orientations, reset=True):
+        r"""Add frames of a trajectory to the autocorrelation.
+
+        Example::
+
+            >>> import freud
+            >>> import numpy as np
+            >>> ra = freud.order.StreamingRotationalAutocorrelation(2)
+            >>> for frame in range(100):
+            ...     orientations = np.tile([1.0, 0.0, 0.0, 0.0], (10, 1))
+            ...     _ = ra.compute(orientations, reset=False)
+            >>> ra.lags[:4]
+            array([0, 1, 2, 3], dtype=uint32)
+
+        Args:
+            orientations ((:math:`N_{orientations}`, 4) or (:math:`N_{frames}`, :math:`N_{orientations}`, 4) :class:`numpy.ndarray`):
+                Orientations of one frame or of consecutive frames of the
+                trajectory.
+            reset (bool):
+                Whether to erase the previously added frames before adding
+                these frames; if False, the frames continue the trajectory
+                (Default value: True).
+        """  # noqa: E501
+        cdef:
+            const float[:, :, ::1] l_orientations
+            unsigned int num_frames
+            unsigned int num_orientations
+            unsigned int frame
+
+        if reset:
+            self.thisptr.reset()
+
+        orientations = np.asarray(orientations)
+        if orientations.ndim == 2:
+            orientations = orientations[np.newaxis]
+        orientations = freud.util._convert_array(
+            orientations, shape=(None, None, 4))
+
+        l_orientations = orientations
+        num_frames = orientations.shape[0]
+        num_orientations = orientations.shape[1]
+        with nogil:
+            for frame in range(num_frames):
+                self.thisptr.update(
+                    <quat[float]*> &l_orientations[frame, 0, 0],
+                    num_orientations)
+        return self
+
+    @property
+    def l(self):  # noqa: E743
+        """int: The azimuthal quantum number, which defines the order of the
+        hyperspherical harmonic."""
+        return self.thisptr.getL()
+
+    @property
+    def points_per_level(self):
+        """unsigned int: Number of frames held in each level."""
+        return self.thisptr.getPointsPerLevel()
+
+    @property
+    def level_factor(self):
+        """unsigned int: Ratio of the frame spacings of consecutive levels."""
+        return self.thisptr.getLevelFactor()
+
+    @_Compute._computed_property
+    def num_frames(self):
+        """unsigned int: Number of frames added since the last reset."""
+        return self.thisptr.getNumFrames()
+
+    @_Compute._computed_property
+    def lags(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The
+        lags, in frames, at which the autocorrelation is accumulated."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getLags(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def order(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`:
+        Autocorrelation of the system at each lag."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRotationalAutocorrelation(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def counts(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The
+        number of pairs of frames averaged over at each lag."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    def __repr__(self):
+        return ("freud.order.{cls}(l={sph_l}, points_per_level={p}, "
+                "level_factor={m})").format(
+                    cls=type(self).__name__, sph_l=self.l,
+                    p=self.points_per_level, m=self.level_factor)
+
+
 cdef class ContinuousCoordination(_PairCompute):
     r"""Computes the continuous local coordination number.
 
@@ -1071,13 +1359,14 @@ cdef class ContinuousCoordination(_PairCompute):
         if system is None and voronoi is None:
             raise ValueError("Must specify system or voronoi.")
         if voronoi is None:
-            voronoi = freud.locality.Voronoi()
+            voronoi = freud.locality.Voronoi(compute_polytopes=False)
             voronoi.compute(system)
         elif not hasattr(voronoi, "nlist"):
             raise RuntimeError(
                 "Must call compute on Voronoi object prior to computing coordination.")
         cpp_voronoi = voronoi
-        self.thisptr.compute(cpp_voronoi.thisptr)
+        with nogil:
+            self.thisptr.compute(cpp_voronoi.thisptr)
         return self
 
     @_Compute._computed_property
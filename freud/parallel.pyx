@@ -40,6 +40,148 @@ def set_num_threads(nthreads=None):
     freud._parallel.setNumThreads(cNthreads)
 
 
+def get_thread_pinning():
+    r"""Get whether threads are pinned to CPUs.
+
+    Returns:
+        bool: Whether threads are pinned to CPUs.
+    """
+    return freud._parallel.getThreadPinning()
+
+
+def set_thread_pinning(pin):
+    r"""Set whether threads are pinned to CPUs.
+
+    When enabled, each thread used for parallel computation is pinned to its
+    own CPU, and consecutive threads are placed on alternating NUMA nodes.
+    Since the memory of large arrays is zeroed in parallel before it is first
+    used, this spreads the arrays across the memory of all NUMA nodes and keeps
+    each thread close to the data it initialized, which reduces cross-socket
+    memory traffic on multi-socket machines. Pinning is only supported on
+    Linux and has no effect on other platforms.
+
+    Args:
+        pin (bool):
+            Whether to pin threads to CPUs.
+    """
+    freud._parallel.setThreadPinning(bool(pin))
+
+
+def get_deterministic_reductions():
+    r"""Get whether parallel reductions are independent of the number of threads.
+
+    Returns:
+        bool: Whether parallel reductions are deterministic.
+    """
+    return freud._parallel.getDeterministicReductions()
+
+
+def set_deterministic_reductions(deterministic):
+    r"""Set whether parallel reductions are independent of the number of threads.
+
+    Sums of floating point numbers computed in parallel (e.g. the system
+    averages of :class:`freud.order.Steinhardt`, the tensor of
+    :class:`freud.order.Nematic` or weighted histograms) depend on how the
+    terms were split between threads, so by default they may differ in the
+    last bits between runs with different numbers of threads. When
+    reductions are deterministic, parallel loops are split into a fixed set
+    of at most 64 chunks whose bounds only depend on the length of the loop,
+    each chunk accumulates its own partial sums, and the partial sums are
+    combined pairwise in a fixed order. Results are then bitwise identical
+    for any number of threads, at the cost of memory for up to 64 partial
+    sums and of running loops nested within a chunk serially.
+
+    Args:
+        deterministic (bool):
+            Whether parallel reductions should be deterministic.
+    """
+    freud._parallel.setDeterministicReductions(bool(deterministic))
+
+
+def get_memory_budget():
+    r"""Get the memory that a single compute may use.
+
+    Returns:
+        int: The budget in bytes, or :code:`None` if there is no budget.
+    """
+    cdef size_t nbytes = freud._parallel.getMemoryBudget()
+    return None if nbytes == 0 else nbytes
+
+
+def set_memory_budget(nbytes=None):
+    r"""Set the memory that a single compute may use.
+
+    Computes whose memory grows with the number of threads or with the
+    system size check their estimated peak memory against the budget
+    before allocating, and switch to a leaner strategy when it does not
+    fit: :class:`freud.diffraction.StaticStructureFactorDebye` and
+    :class:`freud.pmft.PMFTXYZ` run with fewer thread local copies,
+    :class:`freud.density.GaussianDensity` deposits the Gaussians directly
+    instead of convolving with FFTs, and neighbor lists built from queries
+    that only find the nearest image of each point store no vectors,
+    distances or weights (they are recomputed when accessed). Results are
+    unchanged. The budget is not a hard limit: allocations that no strategy
+    avoids, such as the outputs, are still made. The estimates are available
+    from the :code:`estimate_memory` methods of these computes.
+
+    Args:
+        nbytes (int, optional):
+            The budget in bytes. If :code:`None`, memory is not limited.
+            (Default value = :code:`None`).
+    """
+    if nbytes is not None and nbytes <= 0:
+        raise ValueError("The memory budget must be positive.")
+    freud._parallel.setMemoryBudget(0 if nbytes is None else nbytes)
+
+
+def get_instruction_set():
+    r"""Get the instruction set that vectorized kernels are run with.
+
+    Returns:
+        str: One of :code:`"baseline"`, :code:`"avx2"` or :code:`"avx512"`.
+    """
+    return freud._parallel.getInstructionSetName(
+        freud._parallel.getInstructionSet()).decode()
+
+
+def get_supported_instruction_set():
+    r"""Get the most capable instruction set supported by this CPU.
+
+    Returns:
+        str: One of :code:`"baseline"`, :code:`"avx2"` or :code:`"avx512"`.
+    """
+    return freud._parallel.getInstructionSetName(
+        freud._parallel.getSupportedInstructionSet()).decode()
+
+
+def set_instruction_set(name=None):
+    r"""Set the instruction set that vectorized kernels are run with.
+
+    The innermost loops of freud (such as the distance evaluations of
+    neighbor queries) are compiled for several x86 instruction sets, and by
+    default the most capable one supported by the CPU is used. The
+    :code:`FREUD_INSTRUCTION_SET` environment variable selects a lower
+    instruction set when freud is imported. All instruction sets give
+    identical results; lower ones are only useful for benchmarking. Only
+    :code:`"baseline"` is supported on other architectures.
+
+    Args:
+        name (str, optional):
+            One of :code:`"baseline"`, :code:`"avx2"` or :code:`"avx512"`. If
+            :code:`None`, use the most capable supported instruction set.
+            (Default value = :code:`None`).
+
+    Raises:
+        ValueError: If the instruction set is unknown or not supported.
+    """
+    if name is None:
+        freud._parallel.setInstructionSet(
+            freud._parallel.getSupportedInstructionSet())
+        return
+    freud._parallel.setInstructionSet(
+        freud._parallel.getInstructionSetFromName(name.encode()))
+
+
 class NumThreads:
     r"""Context manager for managing the number of threads to use.
 
@@ -60,3 +202,133 @@ class NumThreads:
 
     def __exit__(self, *args):
         set_num_threads(self.restore_N)
+
+
+cdef class ExecutionContext:
+    r"""Context manager limiting the number of threads of the computations
+    started on the current thread.
+
+    Unlike :class:`NumThreads`, which sets the number of threads used by all
+    computations of the process, the computations started within this context
+    run in a separate pool of threads that is only used by the thread that
+    entered the context. Analyses running concurrently on different threads
+    (e.g. in a :class:`concurrent.futures.ThreadPoolExecutor` or a Dask
+    worker) can thus each be given their own budget of cores instead of
+    competing for the same threads. Contexts may be nested, and must be exited
+    on the thread that entered them. The number of threads is still limited
+    by :func:`set_num_threads`.
+
+    Args:
+        N (int, optional): Number of threads to use in this context. If
+            :code:`None`, use all available threads.
+            (Default value = :code:`None`).
+    """
+    cdef freud._parallel.ExecutionContext * thisptr
+    cdef unsigned int _N
+
+    def __cinit__(self, N=None):
+        if N is None or N < 0:
+            N = 0
+        self._N = N
+        self.thisptr = NULL
+
+    def __dealloc__(self):
+        if self.thisptr != NULL:
+            del self.thisptr
+
+    def __enter__(self):
+        if self.thisptr != NULL:
+            raise RuntimeError("This ExecutionContext has already been entered.")
+        self.thisptr = new freud._parallel.ExecutionContext(self._N)
+        return self
+
+    def __exit__(self, *args):
+        del self.thisptr
+        self.thisptr = NULL
+
+    @property
+    def num_threads(self):
+        """int: Number of threads of the context, or 0 to use all available
+        threads."""
+        return self._N
+
+
+def _read_profile():
+    r"""Read the timers and counters recorded on the current thread."""
+    cdef freud._parallel.Profile profile = freud._parallel.getProfile()
+    cdef dict timer_records = profile.timers
+    cdef dict counter_records = profile.counters
+    timers = {name.decode(): (timer["seconds"], timer["calls"])
+              for name, timer in timer_records.items()}
+    counters = {name.decode(): value
+                for name, value in counter_records.items()}
+    return timers, counters
+
+
+cdef class Profile:
+    r"""Context manager recording where the computations started on the
+    current thread spend their time.
+
+    While any profile is active, the main stages of computations (e.g.
+    building neighbor lists, traversing neighbors while binning bonds, and
+    reducing histograms over threads) are timed, and counters record the
+    amount of work done in them (e.g. the number of bonds found). When the
+    context is exited, :attr:`timers` and :attr:`counters` hold the records of
+    the computations started on the thread that entered the context, so the
+    cost of each stage can be seen without an external profiler. Timers of
+    nested stages are included in the time of the stages containing them.
+
+    Recording only happens if freud was built with the CMake option
+    :code:`FREUD_PROFILING` (the default); otherwise the records are empty.
+
+    Example::
+
+        with freud.parallel.Profile() as profile:
+            rdf.compute(system)
+        print(profile.timers["BondHistogramCompute::accumulate"]["time"])
+    """
+    cdef bint _active
+    cdef dict _start_timers
+    cdef dict _start_counters
+    cdef dict _timers
+    cdef dict _counters
+
+    def __cinit__(self):
+        self._active = False
+        self._timers = {}
+        self._counters = {}
+
+    def __enter__(self):
+        if self._active:
+            raise RuntimeError("This Profile has already been entered.")
+        self._active = True
+        self._start_timers, self._start_counters = _read_profile()
+        freud._parallel.enableProfiling()
+        return self
+
+    def __exit__(self, *args):
+        freud._parallel.disableProfiling()
+        self._active = False
+        timers, counters = _read_profile()
+        self._timers = {}
+        for name, (seconds, calls) in timers.items():
+            start_seconds, start_calls = self._start_timers.get(name, (0, 0))
+            if calls > start_calls:
+                self._timers[name] = {"time": seconds - start_seconds,
+                                      "calls": calls - start_calls}
+        self._counters = {}
+        for name, value in counters.items():
+            start_value = self._start_counters.get(name, 0)
+            if value != start_value:
+                self._counters[name] = value - start_value
+
+    @property
+    def timers(self):
+        """dict: Total time in seconds (key :code:`"time"`) and number of
+        calls (key :code:`"calls"`) of each timed stage, by name."""
+        return self._timers
+
+    @property
+    def counters(self):
+        """dict: Value of each counter, by name."""
+        return self._counters
@@ -39,6 +39,7 @@ refer to the supplementary information of :cite:`vanAnders:2014aa`.
 """
 
 from cython.operator cimport dereference
+from libcpp.vector cimport vector
 
 from freud.locality cimport _SpatialHistogram
 from freud.util cimport _Compute, quat, vec3
@@ -117,6 +118,23 @@ cdef class _PMFT(_SpatialHistogram):
             result = -np.log(np.copy(self._pcf))
         return result
 
+    @_Compute._computed_property
+    def pmft_standard_error(self):
+        """:class:`np.ndarray`: The standard error of the PMFT estimated from
+        the batches of sampled query points, or :code:`None` if the query
+        points were not sampled.
+
+        The error of the pair correlation function is propagated to first
+        order, so it is infinite in bins without any bonds."""
+        if self.histptr.getNumBatches() == 0:
+            return None
+        pcf_error = freud.util.make_managed_numpy_array(
+            &self.pmftptr.getPCFStandardError(),
+            freud.util.arr_type_t.FLOAT)
+        with np.errstate(divide='ignore', invalid='ignore'):
+            result = np.where(self._pcf > 0, pcf_error / self._pcf, np.inf)
+        return result
+
     @_Compute._computed_property
     def _pcf(self):
         """:class:`np.ndarray`: The discrete pair correlation function."""
@@ -205,6 +223,7 @@ cdef class PMFTR12(_PMFT):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
                 system, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_orientations)
 
         orientations = _gen_angle_array(
             orientations, shape=(nq.points.shape[0], ))
@@ -216,12 +235,97 @@ cdef class PMFTR12(_PMFT):
         cdef const float[::1] l_orientations = orientations
         cdef const float[::1] l_query_orientations = query_orientations
 
-        self.pmftr12ptr.accumulate(nq.get_ptr(),
-                                   <float*> &l_orientations[0],
-                                   <vec3[float]*> &l_query_points[0, 0],
-                                   <float*> &l_query_orientations[0],
-                                   num_query_points, nlist.get_ptr(),
-                                   dereference(qargs.thisptr))
+        with nogil:
+            self.pmftr12ptr.accumulate(nq.get_ptr(),
+                                       <float*> &l_orientations[0],
+                                       <vec3[float]*> &l_query_points[0, 0],
+                                       <float*> &l_query_orientations[0],
+                                       num_query_points, nlist.get_ptr(),
+                                       dereference(qargs.thisptr))
+        return self
+
+    def compute_frames(self, systems, orientations, query_points=None,
+                       query_orientations=None, neighbors=None, reset=True):
+        r"""Calculates the PMFT averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but the frames are computed concurrently, so the
+        neighbor finding data structure of one frame is built while the
+        bonds of other frames are binned.
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame.
+            orientations (iterable):
+                Orientations associated with the system points of each frame,
+                as accepted by :py:meth:`compute`.
+            query_points (iterable, optional):
+                Query points of each frame. Uses the points of each system if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations (iterable, optional):
+                Query orientations of each frame, as accepted by
+                :py:meth:`compute`. Uses :code:`orientations` if :code:`None`
+                (Default value = :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used for all frames (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        nqs, query_points_list, qargs = self._preprocess_frames(
+            systems, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_orientations)
+        orientations = list(orientations)
+        if query_orientations is not None:
+            query_orientations = list(query_orientations)
+        if len(orientations) != len(nqs) or (
+                query_orientations is not None and
+                len(query_orientations) != len(nqs)):
+            raise ValueError("Orientations must be provided for every frame.")
+        orientations_list = [
+            _gen_angle_array(o, shape=(frame_nq.points.shape[0], ))
+            for frame_nq, o in zip(nqs, orientations)]
+        if query_orientations is None:
+            query_orientations_list = orientations_list
+        else:
+            query_orientations_list = [
+                _gen_angle_array(o, shape=(qp.shape[0], ))
+                for qp, o in zip(query_points_list, query_orientations)]
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality._QueryArgs l_qargs = qargs
+            const float[:, ::1] l_query_points
+            const float[::1] l_orientations
+            const float[::1] l_query_orientations
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const float*] orientation_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            vector[const float*] query_orientation_ptrs
+            vector[unsigned int] num_query_points
+
+        for nq, l_orientations, l_query_points, l_query_orientations in zip(
+                nqs, orientations_list, query_points_list,
+                query_orientations_list):
+            nq_ptrs.push_back(nq.get_ptr())
+            orientation_ptrs.push_back(&l_orientations[0])
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+            query_orientation_ptrs.push_back(&l_query_orientations[0])
+            num_query_points.push_back(l_query_points.shape[0])
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.pmftr12ptr.accumulateFrames(
+                nq_ptrs, orientation_ptrs, query_point_ptrs,
+                query_orientation_ptrs, num_query_points,
+                dereference(l_qargs.thisptr))
         return self
 
     def __repr__(self):
@@ -314,6 +418,7 @@ cdef class PMFTXYT(_PMFT):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
                 system, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_orientations)
 
         orientations = _gen_angle_array(
             orientations, shape=(nq.points.shape[0], ))
@@ -325,12 +430,97 @@ cdef class PMFTXYT(_PMFT):
         cdef const float[::1] l_orientations = orientations
         cdef const float[::1] l_query_orientations = query_orientations
 
-        self.pmftxytptr.accumulate(nq.get_ptr(),
-                                   <float*> &l_orientations[0],
-                                   <vec3[float]*> &l_query_points[0, 0],
-                                   <float*> &l_query_orientations[0],
-                                   num_query_points, nlist.get_ptr(),
-                                   dereference(qargs.thisptr))
+        with nogil:
+            self.pmftxytptr.accumulate(nq.get_ptr(),
+                                       <float*> &l_orientations[0],
+                                       <vec3[float]*> &l_query_points[0, 0],
+                                       <float*> &l_query_orientations[0],
+                                       num_query_points, nlist.get_ptr(),
+                                       dereference(qargs.thisptr))
+        return self
+
+    def compute_frames(self, systems, orientations, query_points=None,
+                       query_orientations=None, neighbors=None, reset=True):
+        r"""Calculates the PMFT averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but the frames are computed concurrently, so the
+        neighbor finding data structure of one frame is built while the
+        bonds of other frames are binned.
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame.
+            orientations (iterable):
+                Orientations associated with the system points of each frame,
+                as accepted by :py:meth:`compute`.
+            query_points (iterable, optional):
+                Query points of each frame. Uses the points of each system if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations (iterable, optional):
+                Query orientations of each frame, as accepted by
+                :py:meth:`compute`. Uses :code:`orientations` if :code:`None`
+                (Default value = :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used for all frames (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        nqs, query_points_list, qargs = self._preprocess_frames(
+            systems, query_points, neighbors)
+        self._check_half_list_query_data(qargs, query_orientations)
+        orientations = list(orientations)
+        if query_orientations is not None:
+            query_orientations = list(query_orientations)
+        if len(orientations) != len(nqs) or (
+                query_orientations is not None and
+                len(query_orientations) != len(nqs)):
+            raise ValueError("Orientations must be provided for every frame.")
+        orientations_list = [
+            _gen_angle_array(o, shape=(frame_nq.points.shape[0], ))
+            for frame_nq, o in zip(nqs, orientations)]
+        if query_orientations is None:
+            query_orientations_list = orientations_list
+        else:
+            query_orientations_list = [
+                _gen_angle_array(o, shape=(qp.shape[0], ))
+                for qp, o in zip(query_points_list, query_orientations)]
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality._QueryArgs l_qargs = qargs
+            const float[:, ::1] l_query_points
+            const float[::1] l_orientations
+            const float[::1] l_query_orientations
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const float*] orientation_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            vector[const float*] query_orientation_ptrs
+            vector[unsigned int] num_query_points
+
+        for nq, l_orientations, l_query_points, l_query_orientations in zip(
+                nqs, orientations_list, query_points_list,
+                query_orientations_list):
+            nq_ptrs.push_back(nq.get_ptr())
+            orientation_ptrs.push_back(&l_orientations[0])
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+            query_orientation_ptrs.push_back(&l_query_orientations[0])
+            num_query_points.push_back(l_query_points.shape[0])
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.pmftxytptr.accumulateFrames(
+                nq_ptrs, orientation_ptrs, query_point_ptrs,
+                query_orientation_ptrs, num_query_points,
+                dereference(l_qargs.thisptr))
         return self
 
     def __repr__(self):
@@ -383,7 +573,7 @@ cdef class PMFTXY(_PMFT):
             del self.pmftxyptr
 
     def compute(self, system, query_orientations, query_points=None,
-                neighbors=None, reset=True):
+                neighbors=None, reset=True, sampling=None):
         r"""Calculates the PMFT.
 
         .. note::
@@ -415,6 +605,12 @@ cdef class PMFTXY(_PMFT):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            sampling (dict, optional):
+                Arguments for accumulating only a random fraction of the
+                query points, with the keys ``fraction``, ``stratified``,
+                ``seed`` and ``num_batches`` as described in
+                :meth:`freud.density.RDF.compute`, or :code:`None` to
+                accumulate all query points (Default value: None).
         """  # noqa: E501
         if reset:
             self._reset()
@@ -425,6 +621,7 @@ cdef class PMFTXY(_PMFT):
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
+            freud.locality._QuerySampling l_sampling
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
@@ -434,11 +631,87 @@ cdef class PMFTXY(_PMFT):
             query_orientations, shape=(num_query_points, ))
         cdef const float[::1] l_query_orientations = query_orientations
 
-        self.pmftxyptr.accumulate(nq.get_ptr(),
-                                  <float*> &l_query_orientations[0],
-                                  <vec3[float]*> &l_query_points[0, 0],
-                                  num_query_points, nlist.get_ptr(),
-                                  dereference(qargs.thisptr))
+        if sampling is not None:
+            l_sampling = freud.locality._QuerySampling(**sampling)
+            with nogil:
+                self.pmftxyptr.accumulateSampled(
+                    nq.get_ptr(), <float*> &l_query_orientations[0],
+                    <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                    nlist.get_ptr(), dereference(qargs.thisptr),
+                    l_sampling.sampling)
+            return self
+
+        with nogil:
+            self.pmftxyptr.accumulate(nq.get_ptr(),
+                                      <float*> &l_query_orientations[0],
+                                      <vec3[float]*> &l_query_points[0, 0],
+                                      num_query_points, nlist.get_ptr(),
+                                      dereference(qargs.thisptr))
+        return self
+
+    def compute_frames(self, systems, query_orientations, query_points=None,
+                       neighbors=None, reset=True):
+        r"""Calculates the PMFT averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but the frames are computed concurrently, so the
+        neighbor finding data structure of one frame is built while the
+        bonds of other frames are binned.
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame.
+            query_orientations (iterable):
+                Query orientations of each frame, as accepted by
+                :py:meth:`compute`.
+            query_points (iterable, optional):
+                Query points of each frame. Uses the points of each system if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used for all frames (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        nqs, query_points_list, qargs = self._preprocess_frames(
+            systems, query_points, neighbors)
+        query_orientations = list(query_orientations)
+        if len(query_orientations) != len(nqs):
+            raise ValueError(
+                "Query orientations must be provided for every frame.")
+        query_orientations_list = [
+            _gen_angle_array(o, shape=(qp.shape[0], ))
+            for qp, o in zip(query_points_list, query_orientations)]
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality._QueryArgs l_qargs = qargs
+            const float[:, ::1] l_query_points
+            const float[::1] l_query_orientations
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const float*] query_orientation_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            vector[unsigned int] num_query_points
+
+        for nq, l_query_points, l_query_orientations in zip(
+                nqs, query_points_list, query_orientations_list):
+            nq_ptrs.push_back(nq.get_ptr())
+            query_orientation_ptrs.push_back(&l_query_orientations[0])
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+            num_query_points.push_back(l_query_points.shape[0])
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.pmftxyptr.accumulateFrames(
+                nq_ptrs, query_orientation_ptrs, query_point_ptrs,
+                num_query_points, dereference(l_qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -528,6 +801,19 @@ cdef class PMFTXYZ(_PMFT):
         if type(self) is PMFTXYZ:
             del self.pmftxyzptr
 
+    def estimate_memory(self):
+        r"""Estimate the peak memory of :meth:`compute`.
+
+        Each thread bins its bonds into its own copy of the histogram. If the
+        copies would exceed the budget set by
+        :func:`freud.parallel.set_memory_budget`, fewer threads are used and
+        the estimate accounts for the copies of those threads.
+
+        Returns:
+            int: The estimated memory in bytes.
+        """
+        return self.pmftxyzptr.estimateMemory()
+
     def compute(self, system, query_orientations, query_points=None,
                 equiv_orientations=None, neighbors=None, reset=True):
         r"""Calculates the PMFT.
@@ -598,14 +884,97 @@ cdef class PMFTXYZ(_PMFT):
         cdef const float[:, ::1] l_equiv_orientations = equiv_orientations
         cdef unsigned int num_equiv_orientations = \
             l_equiv_orientations.shape[0]
-        self.pmftxyzptr.accumulate(
-            nq.get_ptr(),
-            <quat[float]*> &l_query_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points,
-            <quat[float]*> &l_equiv_orientations[0, 0],
-            num_equiv_orientations, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.pmftxyzptr.accumulate(
+                nq.get_ptr(),
+                <quat[float]*> &l_query_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points,
+                <quat[float]*> &l_equiv_orientations[0, 0],
+                num_equiv_orientations, nlist.get_ptr(),
+                dereference(qargs.thisptr))
+        return self
+
+    def compute_frames(self, systems, query_orientations, query_points=None,
+                       equiv_orientations=None, neighbors=None, reset=True):
+        r"""Calculates the PMFT averaged over several frames.
+
+        This is equivalent to calling :py:meth:`compute` on each frame with
+        ``reset=False``, but the frames are computed concurrently, so the
+        neighbor finding data structure of one frame is built while the
+        bonds of other frames are binned.
+
+        Args:
+            systems (iterable):
+                Objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, one per
+                frame.
+            query_orientations (iterable):
+                Query orientations of each frame, each a
+                (:math:`N_{query\_points}`, 4) :class:`numpy.ndarray`.
+            query_points (iterable, optional):
+                Query points of each frame. Uses the points of each system if
+                :code:`None` (Default value = :code:`None`).
+            equiv_orientations ((:math:`N_{faces}`, 4) :class:`numpy.ndarray`, optional):
+                Orientations to be treated as equivalent in all frames, as
+                accepted by :py:meth:`compute` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used for all frames (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        nqs, query_points_list, qargs = self._preprocess_frames(
+            systems, query_points, neighbors)
+        query_points_list = [
+            qp - self.shiftvec.reshape(1, 3) for qp in query_points_list]
+        query_orientations = list(query_orientations)
+        if len(query_orientations) != len(nqs):
+            raise ValueError(
+                "Query orientations must be provided for every frame.")
+        query_orientations_list = [
+            freud.util._convert_array(
+                np.atleast_1d(o), shape=(qp.shape[0], 4))
+            for qp, o in zip(query_points_list, query_orientations)]
+
+        if equiv_orientations is None:
+            equiv_orientations = np.array([[1, 0, 0, 0]], dtype=np.float32)
+        else:
+            equiv_orientations = freud.util._convert_array(
+                equiv_orientations, shape=(None, 4))
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality._QueryArgs l_qargs = qargs
+            const float[:, ::1] l_query_points
+            const float[:, ::1] l_query_orientations
+            const float[:, ::1] l_equiv_orientations = equiv_orientations
+            unsigned int num_equiv_orientations = \
+                l_equiv_orientations.shape[0]
+            vector[const freud._locality.NeighborQuery*] nq_ptrs
+            vector[const quat[float]*] query_orientation_ptrs
+            vector[const vec3[float]*] query_point_ptrs
+            vector[unsigned int] num_query_points
+
+        for nq, l_query_points, l_query_orientations in zip(
+                nqs, query_points_list, query_orientations_list):
+            nq_ptrs.push_back(nq.get_ptr())
+            query_orientation_ptrs.push_back(
+                <quat[float]*> &l_query_orientations[0, 0])
+            query_point_ptrs.push_back(<vec3[float]*> &l_query_points[0, 0])
+            num_query_points.push_back(l_query_points.shape[0])
+
+        if reset:
+            self._reset()
+
+        with nogil:
+            self.pmftxyzptr.accumulateFrames(
+                nq_ptrs, query_orientation_ptrs, query_point_ptrs,
+                num_query_points, <quat[float]*> &l_equiv_orientations[0, 0],
+                num_equiv_orientations, dereference(l_qargs.thisptr))
         return self
 
     def __repr__(self):
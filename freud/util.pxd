@@ -7,6 +7,7 @@ from cpython cimport Py_INCREF
 from cython.operator cimport dereference
 from libcpp cimport bool
 from libcpp.complex cimport complex
+from libcpp.memory cimport shared_ptr
 
 from freud._util cimport ManagedArray, PyArray_SetBaseObject, quat, vec3
 import numpy as np
@@ -41,9 +42,12 @@ cdef class _ManagedArrayContainer:
     cdef int var_typenum
     cdef arr_ptr_t thisptr
     cdef arr_type_t data_type
+    cdef void *_source
 
     cdef void set_as_base(self, arr)
     cdef void *get(self)
+    cdef void set_output(self, np.ndarray out, shared_ptr[void] owner)
+    cdef void clear_output(self)
 
     @staticmethod
     cdef inline _ManagedArrayContainer init(
@@ -81,6 +85,7 @@ cdef class _ManagedArrayContainer:
             obj.thisptr.bool_ptr = new ManagedArray[bool](
                 dereference(<const ManagedArray[bool] *>array))
 
+        obj._source = <void *>array
         return obj
 
 
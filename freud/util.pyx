@@ -1,18 +1,38 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+import threading
+from concurrent.futures import ThreadPoolExecutor
 from functools import wraps
 
 import numpy as np
 
 import freud.box
 
+from cpython cimport Py_DECREF
+
+from freud._util cimport MemoryPool, makeExternalOwner
+
 cimport numpy as np
 
 # numpy must be initialized. When using numpy from C or Cython you must
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+_default_executor = None
+_default_executor_lock = threading.Lock()
+
+
+def _get_default_executor():
+    """Return the thread pool used by :meth:`_Compute.compute_async` when no
+    executor is given, creating it on first use."""
+    global _default_executor
+    with _default_executor_lock:
+        if _default_executor is None:
+            _default_executor = ThreadPoolExecutor(
+                thread_name_prefix="freud-compute")
+        return _default_executor
+
 
 cdef class _ManagedArrayContainer:
     """Class responsible for synchronizing ownership between two ManagedArray
@@ -46,6 +66,7 @@ cdef class _ManagedArrayContainer:
         self.data_type = arr_type
         self.var_typenum = typenum
         self.thisptr.null_ptr = NULL
+        self._source = NULL
 
     @property
     def shape(self):
@@ -101,6 +122,50 @@ cdef class _ManagedArrayContainer:
         elif self.data_type == arr_type_t.BOOL:
             return self.thisptr.bool_ptr.get()
 
+    cdef void set_output(self, np.ndarray out):
+        """Make the ManagedArray this container was initialized from write
+        its data into out whenever it is prepared with out.size elements.
+
+        The caller must ensure that out is a C-contiguous, writeable array of
+        the dtype of the data, and that the source ManagedArray is alive."""
+        Py_INCREF(out)
+        cdef shared_ptr[void] owner = makeExternalOwner(
+            _release_output, <void*> out)
+        if self.data_type == arr_type_t.UNSIGNED_INT:
+            (<ManagedArray[uint] *> self._source).setOutput(
+                <uint *> np.PyArray_DATA(out), out.size, owner)
+        elif self.data_type == arr_type_t.FLOAT:
+            (<ManagedArray[float] *> self._source).setOutput(
+                <float *> np.PyArray_DATA(out), out.size, owner)
+        elif self.data_type == arr_type_t.DOUBLE:
+            (<ManagedArray[double] *> self._source).setOutput(
+                <double *> np.PyArray_DATA(out), out.size, owner)
+        elif self.data_type == arr_type_t.COMPLEX_FLOAT:
+            (<ManagedArray[fcomplex] *> self._source).setOutput(
+                <fcomplex *> np.PyArray_DATA(out), out.size, owner)
+        elif self.data_type == arr_type_t.COMPLEX_DOUBLE:
+            (<ManagedArray[dcomplex] *> self._source).setOutput(
+                <dcomplex *> np.PyArray_DATA(out), out.size, owner)
+        elif self.data_type == arr_type_t.BOOL:
+            (<ManagedArray[bool] *> self._source).setOutput(
+                <bool *> np.PyArray_DATA(out), out.size, owner)
+
+    cdef void clear_output(self):
+        """Stop writing the source ManagedArray into the array of
+        set_output."""
+        if self.data_type == arr_type_t.UNSIGNED_INT:
+            (<ManagedArray[uint] *> self._source).clearOutput()
+        elif self.data_type == arr_type_t.FLOAT:
+            (<ManagedArray[float] *> self._source).clearOutput()
+        elif self.data_type == arr_type_t.DOUBLE:
+            (<ManagedArray[double] *> self._source).clearOutput()
+        elif self.data_type == arr_type_t.COMPLEX_FLOAT:
+            (<ManagedArray[fcomplex] *> self._source).clearOutput()
+        elif self.data_type == arr_type_t.COMPLEX_DOUBLE:
+            (<ManagedArray[dcomplex] *> self._source).clearOutput()
+        elif self.data_type == arr_type_t.BOOL:
+            (<ManagedArray[bool] *> self._source).clearOutput()
+
     def __array__(self):
         """Convert the underlying data array into a read-only numpy array.
 
@@ -123,6 +188,65 @@ cdef class _ManagedArrayContainer:
             else self.shape + (self.element_size, ))
 
 
+cdef void _release_output(void *out) noexcept with gil:
+    Py_DECREF(<object> out)
+
+
+cdef _set_outputs(compute, out):
+    """Make a compute write its properties straight into the arrays of out.
+
+    A property is written into its array if it is a view of a C++ array of the
+    compute with the dtype of the array, and if the array is C-contiguous,
+    writeable and does not overlap another array of out. The C++ array then
+    uses the memory of the array whenever the compute prepares it with as many
+    elements as the array has, see ManagedArray::setOutput.
+
+    Returns:
+        list: The containers of the C++ arrays writing into out.
+    """
+    cdef _ManagedArrayContainer container
+    containers = []
+    adopted = []
+    for name, array in out.items():
+        if not isinstance(array, np.ndarray) or not (
+                array.flags.c_contiguous and array.flags.writeable
+                and array.flags.aligned):
+            continue
+        if any(np.may_share_memory(array, other) for other in adopted):
+            continue
+        prop = getattr(type(compute), name, None)
+        if not isinstance(prop, property):
+            continue
+        # Read the property without the check of _computed_property, so that
+        # the first compute can write into out too.
+        getter = getattr(prop.fget, "__wrapped__", prop.fget)
+        try:
+            value = getter(compute)
+        except Exception:
+            # The properties of some computes are only valid after computing.
+            continue
+        source = None
+        while isinstance(value, np.ndarray):
+            source = value
+            value = value.base
+        if source is None or not isinstance(value, _ManagedArrayContainer):
+            continue
+        container = value
+        if container.element_size != 1 or source.dtype != array.dtype:
+            continue
+        container.set_output(array)
+        containers.append(container)
+        adopted.append(array)
+    return containers
+
+
+cdef _clear_outputs(containers):
+    """Undo :func:`_set_outputs`."""
+    cdef _ManagedArrayContainer container
+    for container in containers:
+        container.clear_output()
+
+
 cdef class _Compute(object):
     r"""Parent class for all compute classes in freud.
 
@@ -143,6 +267,14 @@ cdef class _Compute(object):
             def cluster_idx(self):
                 return ...
 
+    The compute method of every class accepts an optional keyword argument
+    :code:`out`, a dictionary mapping names of properties to arrays into
+    which the properties are written. Wherever the dtype and size of an array
+    match the property, the compute writes the property straight into the
+    array, and the property is a view of the array until the next compute.
+    Other properties are copied into their arrays after computing (see
+    :meth:`copy_property`).
+
     Attributes:
         _called_compute (bool):
             Flag representing whether the compute method has been called.
@@ -161,9 +293,19 @@ cdef class _Compute(object):
             compute = attribute
 
             @wraps(compute)
-            def compute_wrapper(*args, **kwargs):
-                return_value = compute(*args, **kwargs)
+            def compute_wrapper(*args, out=None, **kwargs):
+                if out is None:
+                    return_value = compute(*args, **kwargs)
+                    self._called_compute = True
+                    return return_value
+                containers = _set_outputs(self, out)
+                try:
+                    return_value = compute(*args, **kwargs)
+                finally:
+                    _clear_outputs(containers)
                 self._called_compute = True
+                for name, array in out.items():
+                    self.copy_property(name, array)
                 return return_value
             return compute_wrapper
         elif attr == 'plot':
@@ -192,10 +334,126 @@ cdef class _Compute(object):
             return prop(self, *args, **kwargs)
         return wrapper
 
+    def copy_property(self, name, out=None):
+        r"""Copy a computed property into an array.
+
+        Every access of a property returns a new read-only view of the
+        results, which keeps them alive after the next compute. The next
+        compute must then allocate new arrays for its results instead of
+        overwriting the previous ones. In loops over many frames, copying the
+        results into preallocated arrays with this method avoids holding
+        views, so every compute writes its results into the memory of the
+        previous one. The :code:`out` argument of :meth:`compute` goes further
+        and writes the results straight into the preallocated arrays, calling
+        this method only for properties it could not write in place.
+
+        Example::
+
+            >>> box, points = freud.data.make_random_system(10, 100, seed=0)
+            >>> ql = freud.order.Steinhardt(6)
+            >>> out = np.empty(len(points), dtype=np.float32)
+            >>> ql.compute((box, points), {'num_neighbors': 12},
+            ...            out={'particle_order': out})
+            freud.order.Steinhardt(...)
+            >>> ql.copy_property('particle_order', out) is out
+            True
+
+        Args:
+            name (str): Name of the property.
+            out (:class:`numpy.ndarray`, optional):
+                Array into which the property is copied, of the same shape as
+                the property. If :code:`None`, a new array is allocated
+                (Default value = :code:`None`).
+
+        Returns:
+            :class:`numpy.ndarray`: The copy of the property. If :code:`out`
+            is provided, a reference to it is returned.
+        """
+        value = getattr(self, name)
+        if out is None:
+            return np.array(value)
+        if not isinstance(out, np.ndarray):
+            raise TypeError("The output array must be a numpy.ndarray.")
+        if out.shape != np.shape(value):
+            raise ValueError(
+                "The output array for {} has shape {}; expected shape "
+                "{}.".format(name, out.shape, np.shape(value)))
+        value = np.asarray(value)
+        # Properties that the compute wrote into out need no copy.
+        if (out.ctypes.data != value.ctypes.data or out.strides != value.strides
+                or out.dtype != value.dtype):
+            np.copyto(out, value)
+        return out
+
+    def compute_async(self, *args, executor=None, **kwargs):
+        r"""Run :meth:`compute` on a background thread.
+
+        The C++ part of every compute runs without holding the global
+        interpreter lock, so computes running on other threads overlap with
+        Python code such as reading the next frame of a trajectory or writing
+        the previous results. The arguments are the same as those of
+        :meth:`compute`.
+
+        A compute object must not be used while one of its computes is
+        pending. To overlap several computes, use one compute object per
+        pending computation.
+
+        Example::
+
+            >>> box, points = freud.data.make_random_system(10, 100, seed=0)
+            >>> rdf = freud.density.RDF(bins=50, r_max=3)
+            >>> future = rdf.compute_async(system=(box, points))
+            >>> future.result()
+            freud.density.RDF(...)
+
+        Args:
+            executor (:class:`concurrent.futures.Executor`, optional):
+                Executor that runs the compute. If :code:`None`, a thread pool
+                shared by all freud computes is used (Default value =
+                :code:`None`).
+
+        Returns:
+            :class:`concurrent.futures.Future`: Future whose result is this
+            compute object once the compute has finished.
+        """
+        if executor is None:
+            executor = _get_default_executor()
+        return executor.submit(self.compute, *args, **kwargs)
+
     def __str__(self):
         return repr(self)
 
 
+def set_memory_pool_capacity(capacity):
+    r"""Set the number of bytes of freed result arrays that freud keeps for
+    reuse.
+
+    The memory of result arrays that are no longer referenced is kept in a
+    pool, from which later computes allocate their results. Arrays are
+    allocated in size classes, so the memory of an array may be up to twice
+    its size. Once the pool holds more than its capacity, freed memory is
+    returned to the system instead. The default capacity is 256 MiB.
+
+    Args:
+        capacity (int): Capacity of the pool in bytes. A capacity of 0
+            disables reuse.
+
+    Returns:
+        int: The previous capacity of the pool in bytes.
+    """
+    if capacity < 0:
+        raise ValueError("The capacity of the memory pool must be nonnegative.")
+    cdef size_t previous = MemoryPool.get().getCapacity()
+    MemoryPool.get().setCapacity(capacity)
+    return previous
+
+
+def release_memory_pool():
+    r"""Return the memory of all freed result arrays kept for reuse to the
+    system (see :func:`set_memory_pool_capacity`)."""
+    MemoryPool.get().release()
+
+
 def _convert_array(array, shape=None, dtype=np.float32, requirements=("C", ),
                    allow_copy=True):
     """Function which takes a given array, checks the dimensions and shape,
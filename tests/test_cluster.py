@@ -130,6 +130,32 @@ class TestCluster:
         npt.assert_allclose(props.inertia_tensors[1], i_tensor_2, rtol=1e-5, atol=1e-5)
         npt.assert_allclose(props.radii_of_gyration, [0, rg_2], rtol=1e-5, atol=1e-5)
 
+    def test_cluster_props_interleaved_weighted(self):
+        """Tests centers of mass when the points of clusters are interleaved."""
+        box = freud.box.Box.square(L=10)
+        positions = np.array(
+            [[0, 1, 0], [3, 0, 0], [0, 2, 0], [3, 1, 0], [0, 4, 0], [3, 3, 0]]
+        )
+        cluster_idx = np.array([0, 1, 0, 1, 0, 1])
+        masses = np.array([1, 2, 3, 4, 5, 6])
+
+        props = freud.cluster.ClusterProperties()
+        props.compute((box, positions), cluster_idx, masses=masses)
+
+        for c in range(2):
+            in_cluster = cluster_idx == c
+            com = np.average(positions[in_cluster], axis=0, weights=masses[in_cluster])
+            rg = np.sqrt(
+                np.average(
+                    np.sum((positions[in_cluster] - com) ** 2, axis=1),
+                    weights=masses[in_cluster],
+                )
+            )
+            npt.assert_allclose(props.centers_of_mass[c], com, rtol=1e-5, atol=1e-5)
+            npt.assert_allclose(props.radii_of_gyration[c], rg, rtol=1e-5, atol=1e-5)
+        npt.assert_equal(props.sizes, [3, 3])
+        npt.assert_allclose(props.cluster_masses, [9, 12])
+
     def test_cluster_com_periodic(self):
         "Tests center of mass for symmetric, box-spanning clusters."
         box = freud.Box.cube(3)
@@ -206,6 +232,89 @@ class TestCluster:
         plt.close("all")
 
 
+class TestClusterTracker:
+    def test_matches_cluster(self):
+        box = freud.box.Box.cube(20)
+        rng = np.random.default_rng(0)
+        points = box.wrap(box.make_absolute(rng.random((2000, 3))))
+        tracker = freud.cluster.ClusterTracker()
+        clust = freud.cluster.Cluster()
+        query_args = {"r_max": 1.2, "exclude_ii": True}
+        for frame in range(10):
+            if frame > 0:
+                points = box.wrap(
+                    points + rng.normal(scale=0.05, size=points.shape)
+                ).astype(np.float32)
+            previous_idx = np.copy(tracker.cluster_idx) if frame > 0 else None
+            tracker.compute((box, points), neighbors=query_args)
+            clust.compute((box, points), neighbors=query_args)
+            assert tracker.num_frames == frame + 1
+            assert tracker.num_clusters == clust.num_clusters
+            if frame == 0:
+                npt.assert_equal(tracker.cluster_idx, clust.cluster_idx)
+                continue
+            # Both label the same partition of the points.
+            pairs = np.unique(
+                np.stack([tracker.cluster_idx, clust.cluster_idx]), axis=1
+            )
+            assert pairs.shape[1] == clust.num_clusters
+            npt.assert_equal(
+                tracker.cluster_sizes,
+                np.bincount(tracker.cluster_idx, minlength=tracker.max_cluster_id),
+            )
+            # Points outside the relabeled clusters keep their ids.
+            assert np.sum(tracker.cluster_idx != previous_idx) <= (
+                tracker.num_relabeled_points
+            )
+            assert (
+                tracker.num_clusters
+                == len(np.unique(previous_idx))
+                + len(tracker.splits)
+                - len(tracker.merges)
+            )
+
+    def test_merge_and_split(self):
+        box = freud.box.Box.cube(20)
+        apart = np.array(
+            [[0, 0, 0], [0.5, 0, 0], [5, 0, 0], [5.5, 0, 0]], dtype=np.float32
+        )
+        together = np.array(
+            [[0, 0, 0], [0.5, 0, 0], [1, 0, 0], [1.5, 0, 0]], dtype=np.float32
+        )
+        query_args = {"r_max": 0.6, "exclude_ii": True}
+        tracker = freud.cluster.ClusterTracker()
+
+        tracker.compute((box, apart), neighbors=query_args)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 1, 1])
+        assert tracker.num_added_bonds == 2
+
+        tracker.compute((box, together), neighbors=query_args)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 0, 0])
+        npt.assert_equal(tracker.merges, [[1, 0]])
+        assert len(tracker.splits) == 0
+        assert tracker.num_added_bonds == 1
+        assert tracker.num_removed_bonds == 0
+
+        tracker.compute((box, apart), neighbors=query_args)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 2, 2])
+        npt.assert_equal(tracker.splits, [[2, 0]])
+        assert len(tracker.merges) == 0
+        assert tracker.max_cluster_id == 3
+        npt.assert_equal(tracker.cluster_sizes, [2, 0, 2])
+
+        # Without changed bonds, nothing is relabeled.
+        tracker.compute((box, apart), neighbors=query_args)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 2, 2])
+        assert tracker.num_relabeled_points == 0
+
+        tracker.compute((box, together), neighbors=query_args, reset=True)
+        assert tracker.num_frames == 1
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 0, 0])
+
+        with pytest.raises(ValueError):
+            tracker.compute((box, together[:3]), neighbors=query_args)
+
+
 class TestClusterManagedArray(ManagedArrayTestBase):
     def build_object(self):
         self.obj = freud.cluster.Cluster()
@@ -476,6 +476,68 @@ class TestCorrelationFunction:
             npt.assert_allclose(ocf.correlation, expected, atol=1e-6)
 
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_mesh_lattice(self, is2D):
+        # On a lattice of cell centers the mesh resolves all distances exactly.
+        L = 10
+        r_max = 4.5
+        bins = 47
+        dims = 2 if is2D else 3
+        box = freud.box.Box.square(L) if is2D else freud.box.Box.cube(L)
+        grid = np.arange(L) + 0.5 - L / 2
+        points = np.zeros((L**dims, 3), dtype=np.float32)
+        points[:, :dims] = np.stack(
+            np.meshgrid(*([grid] * dims)), axis=-1
+        ).reshape(-1, dims)
+        values = np.random.rand(len(points)) + 1j * np.random.rand(len(points))
+
+        bond_cf = freud.density.CorrelationFunction(bins, r_max)
+        bond_cf.compute((box, points), values, neighbors={"r_max": r_max})
+        mesh_cf = freud.density.CorrelationFunction(bins, r_max, mesh=L)
+        mesh_cf.compute((box, points), values)
+
+        npt.assert_array_equal(mesh_cf.bin_counts, bond_cf.bin_counts)
+        npt.assert_allclose(mesh_cf.correlation, bond_cf.correlation, atol=1e-6)
+
+    def test_mesh_repr(self):
+        cf = freud.density.CorrelationFunction(100, 4, mesh=(16, 16))
+        assert cf.mesh == (16, 16, 1)
+        assert str(cf) == str(eval(repr(cf)))
+        assert freud.density.CorrelationFunction(100, 4).mesh is None
+
+    def test_sampling(self):
+        box, points = freud.data.make_random_system(10, 1000, seed=4)
+        values = np.random.default_rng(4).random(len(points))
+        cf = freud.density.CorrelationFunction(20, 3)
+        cf.compute((box, points), values)
+        assert cf.correlation_standard_error is None
+
+        sampled = freud.density.CorrelationFunction(20, 3)
+        sampled.compute((box, points), values, sampling={"fraction": 1})
+        npt.assert_equal(sampled.bin_counts, cf.bin_counts)
+        npt.assert_allclose(sampled.correlation, cf.correlation, rtol=1e-6)
+        assert np.all(sampled.correlation_standard_error[5:] > 0)
+
+        with pytest.raises(ValueError):
+            freud.density.CorrelationFunction(20, 3, mesh=8).compute(
+                (box, points), values, sampling={"fraction": 0.5}
+            )
+
+    def test_mesh_invalid(self):
+        box, points = freud.data.make_random_system(10, 100)
+        values = np.random.rand(len(points))
+        cf = freud.density.CorrelationFunction(10, 3, mesh=8)
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, {"r_max": 3, "exclude_ii": True}
+        ).toNeighborList()
+        with pytest.raises(ValueError):
+            cf.compute((box, points), values, neighbors=nlist)
+        with pytest.raises(ValueError):
+            freud.density.CorrelationFunction(10, 3, mesh=(8, 0, 8))
+        with pytest.raises(ValueError):
+            freud.density.CorrelationFunction(10, 3, mesh=[8])
+
+
 class TestCorrelationFunctionManagedArray(ManagedArrayTestBase):
     def build_object(self):
         self.obj = freud.density.CorrelationFunction(50, 3)
@@ -152,6 +152,64 @@ class TestGaussianDensity:
             gd.compute(system, values)
             assert np.isclose(np.sum(gd.density), np.sum(values), rtol=1e-4)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_fft(self, is2D):
+        """Ensure FFT convolution matches the direct sum for a large cutoff."""
+        width = 50
+        box_size = 10
+        sigma = 0.75
+        r_max = 6 * sigma
+        system = freud.data.make_random_system(box_size, 100, is2D=is2D, seed=0)
+        values = np.random.default_rng(0).random(100)
+        gd = freud.density.GaussianDensity(width, r_max, sigma)
+        gd_fft = freud.density.GaussianDensity(width, r_max, sigma, use_fft=True)
+        assert not gd.use_fft
+        assert gd_fft.use_fft
+        gd.compute(system, values)
+        gd_fft.compute(system, values)
+        npt.assert_allclose(
+            gd_fft.density, gd.density, atol=1e-2 * np.max(gd.density)
+        )
+        assert np.isclose(np.sum(gd_fft.density), np.sum(gd.density), rtol=1e-4)
+
+    @pytest.mark.parametrize("is2D", [False, True])
+    @pytest.mark.parametrize("use_fft", [False, True])
+    @pytest.mark.parametrize("tilt", [0, 0.3])
+    def test_channels(self, is2D, use_fft, tilt):
+        """Ensure each channel matches a separate compute with its values."""
+        if use_fft and tilt:
+            pytest.skip("FFT convolution requires an orthorhombic box.")
+        width = 20
+        num_channels = 4
+        box, points = freud.data.make_random_system(10, 100, is2D=is2D, seed=0)
+        box = freud.box.Box.from_box(box)
+        box.xy = tilt
+        points = box.wrap(points)
+        values = np.random.default_rng(0).random((100, num_channels))
+        gd = freud.density.GaussianDensity(width, 2.5, 0.75, use_fft=use_fft)
+        gd.compute((box, points), values)
+        expected_shape = (width, width) if is2D else (width, width, width)
+        assert gd.density.shape == (num_channels,) + expected_shape
+
+        single = freud.density.GaussianDensity(width, 2.5, 0.75, use_fft=use_fft)
+        for channel in range(num_channels):
+            single.compute((box, points), values[:, channel])
+            npt.assert_allclose(gd.density[channel], single.density, atol=1e-6)
+
+        # A single column still has a channel dimension.
+        gd.compute((box, points), values[:, :1])
+        assert gd.density.shape == (1,) + expected_shape
+
+    def test_fft_invalid_box(self):
+        gd = freud.density.GaussianDensity(20, 2, 1, use_fft=True)
+        points = np.zeros((1, 3), dtype=np.float32)
+        with pytest.raises(ValueError):
+            gd.compute((freud.box.Box(10, 10, 10, 0.5, 0, 0), points))
+        box = freud.box.Box.cube(10)
+        box.periodic = [True, True, False]
+        with pytest.raises(ValueError):
+            gd.compute((box, points))
+
     def test_repr(self):
         gd = freud.density.GaussianDensity(100, 10.0, 0.1)
         assert str(gd) == str(eval(repr(gd)))
@@ -75,6 +75,33 @@ class TestLocalDensity:
         neighbors = self.ld.num_neighbors
         npt.assert_array_less(np.fabs(neighbors - 1130.973355292), 200)
 
+    def test_neighbor_list_matches_query(self):
+        """Test that counting neighbors from a ball query agrees with counting
+        them from the equivalent neighbor list."""
+        r_max = self.r_max + 0.5 * self.diameter
+        nq = freud.locality.AABBQuery(self.box, self.pos)
+        neighbors = {"mode": "ball", "r_max": r_max, "exclude_ii": True}
+        nlist = nq.query(self.pos, neighbors).toNeighborList()
+
+        self.ld.compute(nq, neighbors=neighbors)
+        num_neighbors = np.copy(self.ld.num_neighbors)
+        self.ld.compute(nq, neighbors=nlist)
+        npt.assert_allclose(num_neighbors, self.ld.num_neighbors, rtol=1e-5, atol=1e-3)
+
+    def test_point_particles(self):
+        """Test that point particles within r_max count fully."""
+        box, points = freud.data.make_random_system(30, 20000, is2D=True, seed=1)
+        r_max = 5
+        nq = freud.locality.AABBQuery(box, points)
+        neighbors = {"mode": "ball", "r_max": r_max, "exclude_ii": True}
+        nlist = nq.query(points, neighbors).toNeighborList()
+
+        ld = freud.density.LocalDensity(r_max, 0)
+        ld.compute(nq, neighbors=neighbors)
+        assert np.all(np.isfinite(ld.num_neighbors))
+        # A neighbor within rounding of r_max may be counted differently.
+        npt.assert_allclose(ld.num_neighbors, nlist.neighbor_counts, atol=1)
+
     def test_repr(self):
         assert str(self.ld) == str(eval(repr(self.ld)))
 
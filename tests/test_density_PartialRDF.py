@@ -0,0 +1,65 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+class TestPartialRDF:
+    def test_generic(self):
+        prdf = freud.density.PartialRDF(num_types=3, bins=10, r_max=2)
+        assert prdf.num_types == 3
+        assert prdf.nbins == 10
+        npt.assert_allclose(prdf.bin_edges, np.linspace(0, 2, 11), atol=1e-6)
+        npt.assert_allclose(prdf.bounds, (0, 2))
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            freud.density.PartialRDF(num_types=0, bins=10, r_max=2)
+        with pytest.raises(ValueError):
+            freud.density.PartialRDF(num_types=2, bins=10, r_max=2, r_min=3)
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        prdf = freud.density.PartialRDF(num_types=2, bins=10, r_max=2)
+        with pytest.raises(ValueError):
+            prdf.compute((box, points), np.full(100, 2))
+        with pytest.raises(ValueError):
+            prdf.compute((box, points), np.zeros(100), query_points=points)
+
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_matches_rdf(self, is2D):
+        num_types, bins, r_max = 3, 20, 2.5
+        box, points = freud.data.make_random_system(10, 600, is2D=is2D, seed=1)
+        types = np.random.default_rng(1).integers(num_types, size=len(points))
+        prdf = freud.density.PartialRDF(num_types, bins, r_max)
+        prdf.compute((box, points), types)
+        assert prdf.rdf.shape == (num_types, num_types, bins)
+        assert prdf.bin_counts.shape == (num_types, num_types, bins)
+
+        for a in range(num_types):
+            for b in range(num_types):
+                rdf = freud.density.RDF(bins, r_max)
+                rdf.compute(
+                    (box, points[types == b]),
+                    query_points=points[types == a],
+                    neighbors={"r_max": r_max, "exclude_ii": a == b},
+                )
+                npt.assert_equal(prdf.bin_counts[a, b], rdf.bin_counts)
+                npt.assert_allclose(prdf.rdf[a, b], rdf.rdf, rtol=1e-5)
+                npt.assert_allclose(prdf.n_r[a, b], rdf.n_r, rtol=1e-5)
+
+    def test_query_points(self):
+        box, points = freud.data.make_random_system(10, 300, seed=2)
+        query_points = points[:100] + 0.1
+        types = np.arange(300) % 2
+        query_types = np.zeros(100, dtype=np.int64)
+        prdf = freud.density.PartialRDF(2, 10, 2)
+        prdf.compute((box, points), types, query_points, query_types)
+        npt.assert_equal(prdf.bin_counts[1], 0)
+        rdf = freud.density.RDF(10, 2).compute(
+            (box, points[types == 1]), query_points=query_points
+        )
+        npt.assert_equal(prdf.bin_counts[0, 1], rdf.bin_counts)
+        npt.assert_allclose(prdf.rdf[0, 1], rdf.rdf, rtol=1e-5)
@@ -34,6 +34,29 @@ class TestRDF:
         npt.assert_allclose(rdf.bin_centers, r_list, rtol=1e-4, atol=1e-4)
         npt.assert_allclose((rdf.bin_edges + dr / 2)[:-1], r_list, rtol=1e-4, atol=1e-4)
 
+    def test_log_bins(self):
+        r_min, r_max, bins = 0.1, 4, 30
+        rdf = freud.density.RDF(bins=bins, r_max=r_max, r_min=r_min, log_bins=True)
+        npt.assert_allclose(
+            rdf.bin_edges, np.geomspace(r_min, r_max, bins + 1), rtol=1e-5
+        )
+        assert "log_bins=True" in repr(rdf)
+
+        box, points = freud.data.make_random_system(10, 500, seed=0)
+        query_args = {"r_max": r_max, "exclude_ii": True}
+        rdf.compute((box, points), neighbors=query_args)
+        aq = freud.locality.AABBQuery(box, points)
+        nlist = aq.query(points, query_args).toNeighborList()
+        expected_counts, _ = np.histogram(nlist.distances, bins=rdf.bin_edges)
+        npt.assert_equal(rdf.bin_counts, expected_counts)
+
+        volumes = 4 / 3 * np.pi * np.diff(rdf.bin_edges**3)
+        expected_rdf = expected_counts * box.volume / (len(points) ** 2 * volumes)
+        npt.assert_allclose(rdf.rdf, expected_rdf, rtol=1e-4)
+
+        with pytest.raises(ValueError):
+            freud.density.RDF(bins=bins, r_max=r_max, log_bins=True)
+
     def test_attribute_access(self):
         r_max = 10.0
         bins = 10
@@ -162,6 +185,71 @@ class TestRDF:
             avg_counts = rdf.rdf * ndens * bin_volumes
             npt.assert_allclose(rdf.n_r, np.cumsum(avg_counts), rtol=tolerance)
 
+    def test_compute_frames(self):
+        r_max = 3
+        bins = 20
+        frames = [freud.data.make_random_system(10, 500, seed=i) for i in range(4)]
+        query_points = [
+            freud.data.make_random_system(10, 100, seed=10 + i)[1] for i in range(4)
+        ]
+
+        for qps in (None, query_points):
+            rdf = freud.density.RDF(bins, r_max)
+            for i, frame in enumerate(frames):
+                rdf.compute(
+                    frame,
+                    query_points=None if qps is None else qps[i],
+                    reset=False,
+                )
+            rdf_frames = freud.density.RDF(bins, r_max)
+            rdf_frames.compute_frames(frames, query_points=qps)
+
+            npt.assert_equal(rdf_frames.bin_counts, rdf.bin_counts)
+            npt.assert_allclose(rdf_frames.rdf, rdf.rdf)
+            npt.assert_allclose(rdf_frames.n_r, rdf.n_r)
+
+        # Neighbor lists cannot be shared between frames.
+        box, points = frames[0]
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, {"r_max": r_max, "exclude_ii": True})
+            .toNeighborList()
+        )
+        with pytest.raises(ValueError):
+            rdf_frames.compute_frames(frames, neighbors=nlist)
+        with pytest.raises(ValueError):
+            rdf_frames.compute_frames(frames, query_points=query_points[:2])
+
+    def test_compressed_neighbor_list(self):
+        r_max = 3
+        bins = 20
+        box, points = freud.data.make_random_system(10, 500, seed=0)
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, {"r_max": r_max, "exclude_ii": True})
+            .toNeighborList()
+        )
+        cnlist = freud.locality.CompressedNeighborList(nlist, r_max)
+        assert len(cnlist) == cnlist.num_bonds == len(nlist)
+        assert cnlist.nbytes < nlist.distances.nbytes * 2
+
+        # Decompressing restores the bonds up to the quantization of vectors.
+        decompressed = cnlist.to_neighbor_list()
+        nlist.sort()
+        npt.assert_equal(decompressed[:], nlist[:])
+        npt.assert_allclose(decompressed.vectors, nlist.vectors, atol=r_max / 32767)
+        npt.assert_allclose(decompressed.distances, nlist.distances, atol=1e-3)
+
+        # Quantization may only move bonds lying on a bin edge.
+        rdf = freud.density.RDF(bins, r_max).compute((box, points), neighbors=nlist)
+        compressed_rdf = freud.density.RDF(bins, r_max).compute(
+            (box, points), neighbors=cnlist
+        )
+        npt.assert_allclose(compressed_rdf.bin_counts, rdf.bin_counts, atol=5)
+
+        with pytest.raises(RuntimeError):
+            compressed_rdf.compute((box, points[:10]), neighbors=cnlist)
+
     def test_repr(self):
         rdf = freud.density.RDF(r_max=10, bins=100, r_min=0.5)
         assert str(rdf) == str(eval(repr(rdf)))
@@ -221,6 +309,22 @@ class TestRDF:
 
             npt.assert_allclose(rdf.n_r, supposed_n_r, atol=1e-5, rtol=1e-6)
 
+    def test_n_r_precision(self):
+        """The cumulative n_r matches a double precision sum of the bin counts.
+
+        With this many bins, a running sum in float drifts by several 1e-5
+        relative to the double precision reference.
+        """
+        r_max = 4.9
+        bins = 100000
+        num_frames = 4
+        rdf = freud.density.RDF(bins, r_max)
+        for seed in range(num_frames):
+            system = freud.data.make_random_system(10, 1000, seed=seed)
+            rdf.compute(system, reset=False)
+        expected = np.cumsum(rdf.bin_counts.astype(np.float64)) / (1000 * num_frames)
+        npt.assert_allclose(rdf.n_r, expected, rtol=1e-6)
+
     def test_empty_histogram(self):
         r_max = 0.5
         bins = 10
@@ -234,6 +338,65 @@ class TestRDF:
         npt.assert_array_equal(rdf.rdf, np.zeros(bins))
         npt.assert_array_equal(rdf.n_r, np.zeros(bins))
 
+    @pytest.mark.parametrize("use_nlist", [False, True])
+    def test_sampling(self, use_nlist):
+        r_max = 2.5
+        box, points = freud.data.make_random_system(12, 3000, seed=3)
+        qargs = {"r_max": r_max, "exclude_ii": True}
+        neighbors = (
+            freud.locality.AABBQuery(box, points).query(points, qargs).toNeighborList()
+            if use_nlist
+            else qargs
+        )
+        rdf = freud.density.RDF(25, r_max).compute((box, points), neighbors=neighbors)
+        assert rdf.rdf_standard_error is None
+
+        # Sampling all query points reproduces the full RDF.
+        sampled = freud.density.RDF(25, r_max)
+        sampled.compute((box, points), neighbors=neighbors, sampling={"fraction": 1})
+        npt.assert_equal(sampled.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(sampled.rdf, rdf.rdf, rtol=1e-6)
+
+        for stratified in (True, False):
+            sampled.compute(
+                (box, points),
+                neighbors=neighbors,
+                sampling={"fraction": 0.2, "stratified": stratified, "seed": 1},
+            )
+            assert sampled.bin_counts.sum() < 0.3 * rdf.bin_counts.sum()
+            error = sampled.rdf_standard_error
+            assert np.all(error[5:] > 0)
+            # The sampled RDF is consistent with the full RDF within its error.
+            chi2 = np.mean(((sampled.rdf[5:] - rdf.rdf[5:]) / error[5:]) ** 2)
+            assert chi2 < 3
+
+    def test_sampling_invalid(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        rdf = freud.density.RDF(10, 2)
+        for sampling in (
+            {"fraction": 0},
+            {"fraction": 1.5},
+            {"fraction": 0.5, "num_batches": 1},
+            {"fraction": 0.05, "num_batches": 10},
+        ):
+            with pytest.raises(ValueError):
+                rdf.compute((box, points), sampling=sampling)
+        rdf.compute((box, points), sampling={"fraction": 0.5})
+        with pytest.raises(ValueError):
+            rdf.compute((box, points), reset=False)
+        with pytest.raises(ValueError):
+            rdf.compute(
+                (box, points),
+                reset=False,
+                sampling={"fraction": 0.5, "num_batches": 5},
+            )
+        with pytest.raises(ValueError):
+            rdf.compute(
+                (box, points),
+                neighbors={"r_max": 2, "half_list": True},
+                sampling={"fraction": 0.5},
+            )
+
     @pytest.mark.skipif(
         NumpyVersion(np.__version__) < "1.15.0", reason="Requires numpy>=1.15.0."
     )
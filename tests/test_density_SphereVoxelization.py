@@ -104,6 +104,29 @@ class TestSphereVoxelization:
             assert num_ones > 0
             assert num_zeros + num_ones == np.prod(vox.voxels.shape)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_voxel_centers(self, is2D):
+        # Voxels are filled exactly when their center lies within r_max of a
+        # periodic image of a point.
+        L = 8.0
+        width = (20, 18) if is2D else (20, 18, 16)
+        r_max = 1.9
+        box, points = freud.data.make_random_system(L, 5, is2D=is2D, seed=1)
+        vox = freud.density.SphereVoxelization(width, r_max)
+        vox.compute((box, points))
+
+        centers = np.meshgrid(
+            *[(np.arange(w) + 0.5) * L / w - L / 2 for w in width], indexing="ij"
+        )
+        centers = np.stack(centers, axis=-1).reshape(-1, len(width))
+        if is2D:
+            centers = np.hstack([centers, np.zeros((len(centers), 1))])
+        deltas = (centers[:, np.newaxis, :] - points[np.newaxis, :, :]).reshape(-1, 3)
+        distances = np.linalg.norm(box.wrap(deltas), axis=-1)
+        distances = distances.reshape(len(centers), len(points))
+        expected = np.any(distances < r_max, axis=1).reshape(width)
+        np.testing.assert_array_equal(vox.voxels, expected)
+
     def test_change_box_dimension(self):
         width = 100
         r_max = 10.0
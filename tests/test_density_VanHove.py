@@ -0,0 +1,96 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+def _random_walk(box, num_particles, num_frames, seed):
+    rng = np.random.default_rng(seed)
+    positions = box.make_absolute(rng.random((num_particles, 3)))
+    steps = rng.normal(scale=0.2, size=(num_frames, num_particles, 3))
+    steps[0] = 0
+    return (positions + np.cumsum(steps, axis=0)).astype(np.float32)
+
+
+class TestVanHove:
+    def test_generic(self):
+        vh = freud.density.VanHove(lags=[0, 2, 4], bins=10, r_max=2)
+        npt.assert_equal(vh.lags, [0, 2, 4])
+        assert vh.nbins == 10
+        npt.assert_allclose(vh.bin_edges, np.linspace(0, 2, 11), atol=1e-6)
+        npt.assert_allclose(vh.bounds, (0, 2))
+        with pytest.raises(AttributeError):
+            vh.distinct
+
+        box = freud.box.Box.cube(8)
+        vh.compute((box, _random_walk(box, 100, 6, seed=0)))
+        npt.assert_equal(vh.num_origins, [6, 4, 2])
+        assert vh.distinct.shape == (3, 10)
+        assert vh.self_part.shape == (3, 10)
+        assert vh.bin_counts.shape == (3, 10)
+        assert vh.self_bin_counts.shape == (3, 10)
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            freud.density.VanHove(lags=[], bins=10, r_max=2)
+        with pytest.raises(ValueError):
+            freud.density.VanHove(lags=[0], bins=0, r_max=2)
+        with pytest.raises(ValueError):
+            freud.density.VanHove(lags=[0], bins=10, r_max=2, r_min=3)
+
+    def test_matches_rdf(self):
+        box = freud.box.Box.cube(8)
+        num_frames, r_max, bins = 8, 2.5, 20
+        positions = _random_walk(box, 200, num_frames, seed=1)
+        lags = [0, 1, 3]
+        vh = freud.density.VanHove(lags, bins, r_max)
+        vh.compute((box, positions))
+
+        for lag_index, lag in enumerate(lags):
+            # The distinct pairs of all time origins, excluding each particle
+            # with itself, as found by RDF with the frames of the lag.
+            rdf = freud.density.RDF(bins, r_max)
+            for origin in range(num_frames - lag):
+                rdf.compute(
+                    (box, box.wrap(positions[origin])),
+                    query_points=box.wrap(positions[origin + lag]),
+                    neighbors={"r_max": r_max, "exclude_ii": True},
+                    reset=False,
+                )
+            npt.assert_equal(vh.bin_counts[lag_index], rdf.bin_counts)
+            npt.assert_allclose(vh.distinct[lag_index], rdf.rdf, rtol=1e-5)
+
+            displacements = np.linalg.norm(
+                positions[lag:] - positions[: num_frames - lag], axis=-1
+            )
+            counts, _ = np.histogram(displacements, bins=vh.bin_edges)
+            # Displacements on a bin edge may round into either bin.
+            npt.assert_allclose(vh.self_bin_counts[lag_index], counts, atol=1)
+            assert vh.self_bin_counts[lag_index].sum() == counts.sum()
+
+        # Every displacement at lag zero is in the first bin.
+        shell = 4 / 3 * np.pi * vh.bin_edges[1] ** 3
+        npt.assert_allclose(vh.self_part[0, 0], 1 / shell, rtol=1e-5)
+        npt.assert_equal(vh.self_part[0, 1:], 0)
+
+    def test_images(self):
+        box = freud.box.Box.cube(8)
+        positions = _random_walk(box, 100, 5, seed=2)
+        images = box.get_images(positions.reshape(-1, 3)).reshape(positions.shape)
+        wrapped = box.wrap(positions.reshape(-1, 3)).reshape(positions.shape)
+        vh = freud.density.VanHove([0, 1, 2], 10, 2).compute((box, positions))
+        vh_images = freud.density.VanHove([0, 1, 2], 10, 2).compute(
+            (box, wrapped), images=images
+        )
+        npt.assert_equal(vh_images.bin_counts, vh.bin_counts)
+        npt.assert_equal(vh_images.self_bin_counts, vh.self_bin_counts)
+
+    def test_repr(self):
+        vh = freud.density.VanHove(lags=[0, 1], bins=10, r_max=2)
+        assert repr(vh) == (
+            "freud.density.VanHove(lags=[0, 1], bins=10, r_max=2.0, r_min=0.0)"
+        )
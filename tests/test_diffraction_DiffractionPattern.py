@@ -130,6 +130,32 @@ class TestDiffractionPattern:
         # normalization by the number of points
         npt.assert_allclose(dp.diffraction[center_index], len(positions))
 
+    def test_multiple_views(self):
+        box, positions = freud.data.UnitCell.fcc().generate_system(
+            4, sigma_noise=1e-2, seed=0
+        )
+        views = rowan.random.rand(4)
+        dp = freud.diffraction.DiffractionPattern(grid_size=64, output_size=48)
+        dp.compute((box, positions), view_orientation=views)
+
+        # Several views are averaged as if computed one at a time.
+        dp_sequential = freud.diffraction.DiffractionPattern(
+            grid_size=64, output_size=48
+        )
+        for i, view in enumerate(views):
+            dp_sequential.compute((box, positions), view, reset=i == 0)
+        npt.assert_allclose(dp.diffraction, dp_sequential.diffraction, rtol=1e-6)
+        npt.assert_allclose(dp.k_vectors, dp_sequential.k_vectors)
+
+    def test_radial_average(self):
+        box, positions = freud.data.UnitCell.fcc().generate_system(4)
+        dp = freud.diffraction.DiffractionPattern(grid_size=64, output_size=33)
+        dp.compute((box, positions), zoom=2)
+        assert dp.radial_average.shape == (17,)
+        assert dp.radial_k_values.shape == (17,)
+        npt.assert_allclose(dp.radial_average[0], len(positions))
+        npt.assert_allclose(dp.radial_k_values[1], dp.k_values[17])
+
     def test_repr(self):
         dp = freud.diffraction.DiffractionPattern()
         assert str(dp) == str(eval(repr(dp)))
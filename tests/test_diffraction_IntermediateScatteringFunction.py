@@ -0,0 +1,93 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+def _random_walk(box, num_particles, num_frames, seed):
+    rng = np.random.default_rng(seed)
+    positions = box.make_absolute(rng.random((num_particles, 3)))
+    steps = rng.normal(scale=0.1, size=(num_frames, num_particles, 3))
+    steps[0] = 0
+    return (positions + np.cumsum(steps, axis=0)).astype(np.float32)
+
+
+class TestIntermediateScatteringFunction:
+    def test_attribute_access(self):
+        isf = freud.diffraction.IntermediateScatteringFunction(
+            bins=10, k_max=5, points_per_level=8, level_factor=2
+        )
+        assert isf.nbins == 10
+        npt.assert_allclose(isf.bounds, (0, 5))
+        assert isf.points_per_level == 8
+        assert isf.level_factor == 2
+        assert not isf.self_part
+        with pytest.raises(AttributeError):
+            isf.F_kt
+        box = freud.box.Box.cube(8)
+        isf.compute((box, _random_walk(box, 50, 5, seed=0)))
+        assert isf.num_frames == 5
+        npt.assert_equal(isf.lags, np.arange(5))
+        npt.assert_equal(isf.counts, np.arange(5, 0, -1))
+        assert isf.F_kt.shape == (5, 10)
+        assert isf.F_s_kt.shape == (0, 10)
+
+    def test_invalid_arguments(self):
+        with pytest.raises(ValueError):
+            freud.diffraction.IntermediateScatteringFunction(
+                bins=10, k_max=5, grid_size=1
+            )
+        with pytest.raises(ValueError):
+            freud.diffraction.IntermediateScatteringFunction(
+                bins=10, k_max=5, level_factor=1
+            )
+        box = freud.box.Box.cube(8)
+        positions = _random_walk(box, 50, 2, seed=0)
+        isf = freud.diffraction.IntermediateScatteringFunction(bins=10, k_max=5)
+        isf.compute((box, positions[0]))
+        with pytest.raises(ValueError):
+            isf.compute((freud.box.Box.cube(9), positions[1]), reset=False)
+        with pytest.raises(ValueError):
+            isf.compute((box, positions[1, :40]), reset=False)
+
+    def test_lag_zero_matches_structure_factor(self):
+        box = freud.box.Box.cube(8)
+        positions = _random_walk(box, 200, 6, seed=1)
+        isf = freud.diffraction.IntermediateScatteringFunction(
+            bins=10, k_max=6, k_min=1, num_sampled_k_points=2000, self_part=True
+        )
+        isf.compute((box, positions))
+        sf = freud.diffraction.StaticStructureFactorDirect(
+            bins=10, k_max=6, k_min=1, num_sampled_k_points=2000
+        )
+        sf.compute_frames([(box, frame) for frame in positions])
+        npt.assert_allclose(isf.k_points, sf.k_points)
+        npt.assert_allclose(isf.F_kt[0], sf.S_k, rtol=1e-4, atol=1e-4)
+        npt.assert_allclose(isf.F_s_kt[0], 1, rtol=1e-5)
+
+    def test_self_part_matches_direct_sum(self):
+        box = freud.box.Box.cube(8)
+        num_frames = 12
+        positions = _random_walk(box, 100, num_frames, seed=2)
+        isf = freud.diffraction.IntermediateScatteringFunction(
+            bins=4, k_max=4, k_min=2, points_per_level=16, self_part=True
+        )
+        for frame in positions:
+            isf.compute((box, frame), reset=False)
+
+        k_points = isf.k_points
+        k_bins = np.digitize(np.linalg.norm(k_points, axis=1), isf.bin_edges) - 1
+        for lag in isf.lags:
+            displacements = positions[lag:] - positions[: num_frames - lag]
+            phases = np.einsum("kd,tnd->tkn", k_points, displacements)
+            cosines = np.cos(phases).mean(axis=(0, 2))
+            expected = [cosines[k_bins == b].mean() for b in range(4)]
+            npt.assert_allclose(isf.F_s_kt[lag], expected, rtol=1e-3, atol=1e-4)
+
+    def test_repr(self):
+        isf = freud.diffraction.IntermediateScatteringFunction(bins=10, k_max=5)
+        assert "IntermediateScatteringFunction(bins=10" in repr(isf)
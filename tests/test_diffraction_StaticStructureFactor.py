@@ -225,6 +225,20 @@ class StaticStructureFactorTest:
         sf.compute((box, points), reset=True)
         assert np.isclose(sf.S_k[0], N * 2)
 
+    def test_long_accumulation_precision(self):
+        """Averaging many identical frames reproduces the single frame value.
+
+        The frames are summed in double precision. Summing 2000 frames in
+        float drifts by about 1e-5 relative to the single frame value.
+        """
+        num_frames = 2000
+        box, points = freud.data.make_random_system(5, 20, seed=0)
+        sf = self.build_structure_factor_object(20, 10, 0, 1000)
+        expected = sf.compute((box, points)).S_k.copy()
+        for _ in range(num_frames):
+            sf.compute((box, points), reset=False)
+        npt.assert_allclose(sf.S_k, expected, rtol=1e-6)
+
 
 class TestStaticStructureFactorDebye(StaticStructureFactorTest):
     @pytest.fixture
@@ -387,6 +401,34 @@ class TestStaticStructureFactorDebye(StaticStructureFactorTest):
         # compare
         npt.assert_allclose(sf.S_k, sf2, rtol=1e-5, atol=1e-5)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_distance_bin_width(self, is2D):
+        """Validate the binned approximation against the exact Debye sum."""
+        L = 10
+        N = 200
+        k_max = 10
+        distance_bin_width = 0.001
+        box, points = freud.data.make_random_system(L, N, is2D=is2D, seed=0)
+        sf_exact = freud.diffraction.StaticStructureFactorDebye(100, k_max)
+        sf_exact.compute((box, points))
+        sf_binned = freud.diffraction.StaticStructureFactorDebye(
+            100, k_max, distance_bin_width=distance_bin_width
+        )
+        sf_binned.compute((box, points))
+        assert sf_exact.distance_bin_width is None
+        assert sf_binned.distance_bin_width == pytest.approx(distance_bin_width)
+
+        # Each term of the sum changes by at most k * distance_bin_width / 2,
+        # but the errors of different pairs largely cancel.
+        npt.assert_allclose(sf_binned.S_k[0], N, rtol=1e-6)
+        npt.assert_allclose(sf_binned.S_k, sf_exact.S_k, atol=1e-2)
+
+    def test_distance_bin_width_invalid(self):
+        with pytest.raises(ValueError):
+            freud.diffraction.StaticStructureFactorDebye(100, 10, distance_bin_width=0)
+        with pytest.raises(ValueError):
+            freud.diffraction.StaticStructureFactorDebye(100, 10, distance_bin_width=-1)
+
 
 class TestStaticStructureFactorDirect(StaticStructureFactorTest):
     @pytest.fixture
@@ -464,6 +506,66 @@ class TestStaticStructureFactorDirect(StaticStructureFactorTest):
             bins, k_max, k_min, num_sampled_k_points
         )
 
+    @pytest.mark.parametrize("partial", [False, True])
+    def test_compute_frames(self, partial):
+        """Ensure computing several frames at once matches accumulation."""
+        boxes = [freud.box.Box.cube(10)] * 3 + [freud.box.Box.cube(11)] * 2
+        frames = [
+            freud.data.make_random_system(box.Lx, 200, seed=i)
+            for i, box in enumerate(boxes)
+        ]
+        query_points = [points[:50] for _, points in frames] if partial else None
+        N_total = 200 if partial else None
+        sf_accumulated = freud.diffraction.StaticStructureFactorDirect(50, 10)
+        for i, frame in enumerate(frames):
+            sf_accumulated.compute(
+                frame,
+                query_points=None if query_points is None else query_points[i],
+                N_total=N_total,
+                reset=False,
+            )
+        sf_frames = freud.diffraction.StaticStructureFactorDirect(50, 10)
+        sf_frames.compute_frames(frames, query_points=query_points, N_total=N_total)
+        npt.assert_allclose(sf_frames.S_k, sf_accumulated.S_k, rtol=1e-5, atol=1e-5)
+        assert sf_frames.min_valid_k == pytest.approx(sf_accumulated.min_valid_k)
+
+    def test_compute_frames_invalid(self):
+        frames = [freud.data.make_random_system(10, 200, seed=i) for i in range(2)]
+        sf = freud.diffraction.StaticStructureFactorDirect(50, 10)
+        with pytest.raises(ValueError):
+            sf.compute_frames(frames, query_points=[frames[0][1]])
+        with pytest.raises(ValueError):
+            sf.compute_frames(
+                frames, query_points=[frames[0][1]], N_total=200
+            )
+        with pytest.raises(ValueError):
+            sf.compute_frames(
+                frames,
+                query_points=[frames[0][1][:10], frames[1][1][:20]],
+                N_total=200,
+            )
+
+    def test_grid_size(self):
+        """Ensure the particle-mesh method agrees with the direct sum."""
+        box, points = freud.data.UnitCell.fcc().generate_system(4, sigma_noise=0.01)
+        system = freud.AABBQuery.from_system((box, points))
+        sf_direct = freud.diffraction.StaticStructureFactorDirect(100, 10)
+        sf_mesh = freud.diffraction.StaticStructureFactorDirect(100, 10, grid_size=64)
+        assert sf_direct.grid_size is None
+        assert sf_mesh.grid_size == 64
+        sf_direct.compute(system)
+        sf_mesh.compute(system)
+        assert sf_mesh.k_points.shape == sf_direct.k_points.shape
+        npt.assert_allclose(sf_mesh.S_k, sf_direct.S_k, rtol=1e-3, atol=1e-3)
+
+    def test_grid_size_invalid(self):
+        with pytest.raises(ValueError):
+            freud.diffraction.StaticStructureFactorDirect(100, 10, grid_size=1)
+        box, points = freud.data.UnitCell.fcc().generate_system(4)
+        sf = freud.diffraction.StaticStructureFactorDirect(100, 10, grid_size=16)
+        with pytest.raises(ValueError):
+            sf.compute((box, points))
+
     def test_against_dynasor(self, sf_params_kmin_zero):
         """Validate the direct method agains dynasor package."""
         dsf_reciprocal = pytest.importorskip("dsf.reciprocal")
@@ -156,6 +156,28 @@ class TestAngularSeparationNeighbor:
         npt.assert_allclose(ang.angles[0], np.pi / 3, atol=1e-6)
         npt.assert_allclose(ang.angles[1], 0, atol=1e-6)
 
+    def test_query_points_ne_points(self):
+        box, points = freud.data.make_random_system(10, 30, is2D=True)
+        orientations = np.tile([1, 0, 0, 0], (len(points), 1)).astype(np.float32)
+        qargs = {"num_neighbors": 2}
+
+        ang = freud.environment.AngularSeparationNeighbor()
+        for num_query_points in (len(points) // 3, 3 * len(points)):
+            _, query_points = freud.data.make_random_system(
+                10, num_query_points, is2D=True, seed=1
+            )
+            query_orientations = np.tile(
+                [1, 0, 0, 0], (num_query_points, 1)
+            ).astype(np.float32)
+            with pytest.raises(ValueError):
+                ang.compute(
+                    (box, points),
+                    orientations,
+                    query_points,
+                    query_orientations,
+                    neighbors=qargs,
+                )
+
     def test_repr(self):
         ang = freud.environment.AngularSeparationNeighbor()
         assert str(ang) == str(eval(repr(ang)))
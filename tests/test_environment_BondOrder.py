@@ -2,6 +2,7 @@
 # This file is from the freud project, released under the BSD 3-Clause License.
 
 import numpy as np
+import numpy.testing as npt
 import pytest
 import rowan
 import util
@@ -137,6 +138,39 @@ class TestBondOrder:
             assert np.count_nonzero(bod.bond_order) == 12
             assert len(np.unique(bod.bond_order)) == 2
 
+    def test_compute_frames(self):
+        L = 10
+        num_points = 100
+        frames = [
+            freud.data.make_random_system(L, num_points, seed=i) for i in range(3)
+        ]
+        np.random.seed(0)
+        orientations = [rowan.random.rand(num_points) for _ in range(3)]
+        neighbors = {"r_max": 2}
+
+        for mode in ["bod", "lbod", "obcd", "oocd"]:
+            bo = freud.environment.BondOrder((7, 5), mode=mode)
+            for frame, frame_orientations in zip(frames, orientations):
+                bo.compute(frame, frame_orientations, neighbors=neighbors, reset=False)
+            bo_frames = freud.environment.BondOrder((7, 5), mode=mode)
+            bo_frames.compute_frames(frames, orientations, neighbors=neighbors)
+
+            npt.assert_equal(bo_frames.bin_counts, bo.bin_counts)
+            npt.assert_allclose(bo_frames.bond_order, bo.bond_order)
+            # Every bond is binned.
+            assert np.sum(bo.bin_counts) == sum(
+                len(
+                    freud.locality.AABBQuery(*frame)
+                    .query(frame[1], dict(exclude_ii=True, **neighbors))
+                    .toNeighborList()
+                )
+                for frame in frames
+            )
+
+        bo = freud.environment.BondOrder((7, 5))
+        with pytest.raises(ValueError):
+            bo.compute_frames(frames, orientations[:2], neighbors=neighbors)
+
 
 class TestBondOrderManagedArray(ManagedArrayTestBase):
     def build_object(self):
@@ -164,6 +164,25 @@ class TestLocalBondProjection:
         npt.assert_allclose(ang.projections[2], 1.5, atol=1e-6)
         npt.assert_allclose(ang.normed_projections[2], 1, atol=1e-6)
 
+    def test_compute_projections(self):
+        box, points = freud.data.make_random_system(10, 100)
+        ors = rowan.random.rand(len(points))
+        proj_vecs = np.random.rand(5, 3)
+        equiv_quats = rowan.random.rand(6)
+        query_args = dict(num_neighbors=8)
+
+        ang = freud.environment.LocalBondProjection()
+        ang.compute((box, points), ors, proj_vecs, None, equiv_quats, query_args)
+        ang_normed = freud.environment.LocalBondProjection(compute_projections=False)
+        assert not ang_normed.compute_projections
+        ang_normed.compute((box, points), ors, proj_vecs, None, equiv_quats, query_args)
+
+        npt.assert_array_equal(ang_normed.normed_projections, ang.normed_projections)
+        with pytest.raises(AttributeError):
+            ang_normed.projections
+
     def test_repr(self):
         ang = freud.environment.LocalBondProjection()
         assert str(ang) == str(eval(repr(ang)))
+        ang = freud.environment.LocalBondProjection(compute_projections=False)
+        assert str(ang) == str(eval(repr(ang)))
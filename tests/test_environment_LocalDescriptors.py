@@ -160,6 +160,26 @@ class TestLocalDescriptors:
 
         assert sphs.shape[0] == N * num_neighbors
 
+    def test_particle_local_more_query_points(self):
+        N = 100
+        L = 10
+
+        box, positions = freud.data.make_random_system(L, N)
+        _, query_points = freud.data.make_random_system(L, 2 * N, seed=1)
+        orientations = np.tile([1, 0, 0, 0], (N, 1)).astype(np.float32)
+        qargs = {"num_neighbors": 4}
+
+        # Particle orientations are only given for the points.
+        comp = freud.environment.LocalDescriptors(4, True, mode="particle_local")
+        with pytest.raises(ValueError):
+            comp.compute(
+                (box, positions), query_points, orientations, neighbors=qargs
+            )
+
+        comp = freud.environment.LocalDescriptors(4, True, mode="global")
+        comp.compute((box, positions), query_points, neighbors=qargs)
+        assert comp.sph.shape[0] == 2 * N * 4
+
     def test_unknown_modes(self):
         N = 1000
         l_max = 8
@@ -229,6 +229,26 @@ class TestCluster:
         assert_ragged_array(env_cluster.point_environments)
         assert_ragged_array(env_cluster.cluster_environments)
 
+    def test_repeated_compute(self):
+        """Assert that computing twice does not accumulate environments."""
+        N = 100
+        L = 10
+        sys = freud.data.make_random_system(L, N, seed=0)
+        env_cluster = freud.environment.EnvironmentCluster()
+        qargs = dict(num_neighbors=6)
+        env_cluster.compute(sys, threshold=0.8, cluster_neighbors=qargs)
+        point_environments = env_cluster.point_environments
+        cluster_environments = env_cluster.cluster_environments
+        env_cluster.compute(sys, threshold=0.8, cluster_neighbors=qargs)
+        assert len(env_cluster.point_environments) == N
+        assert len(env_cluster.cluster_environments) == env_cluster.num_clusters
+        for env, expected in zip(env_cluster.point_environments, point_environments):
+            npt.assert_array_equal(env, expected)
+        for env, expected in zip(
+            env_cluster.cluster_environments, cluster_environments
+        ):
+            npt.assert_array_equal(env, expected)
+
     def _make_global_neighborlist(self, box, points):
         """Get neighborlist where all particles are neighbors."""
         # pairwise distances after wrapping
@@ -515,6 +535,50 @@ class TestEnvironmentMotifMatch:
         env_mm.compute(sys, motif, threshold=0.8, env_neighbors=qargs)
         assert_ragged_array(env_mm.point_environments)
 
+    def test_compute_motifs(self):
+        """Test that matching several motifs agrees with matching each one."""
+        square = np.array([[1, 0, 0], [0, 1, 0], [-1, 0, 0], [0, -1, 0]])
+        rotated = np.array([[1, 1, 0], [-1, 1, 0], [-1, -1, 0], [1, -1, 0]])
+        line = np.array([[1, 0, 0], [-1, 0, 0]])
+        points = np.concatenate(
+            [square, rotated + [[4, 0, 0]], [[0, 0, 0], [4, 0, 0]]]
+        )
+        box = freud.box.Box.square(12)
+        query_args = dict(num_neighbors=4)
+
+        motif_match = freud.environment.EnvironmentMotifMatch()
+        motifs = [line, rotated, square]
+        motif_match.compute_motifs(
+            (box, points), motifs, 0.1, env_neighbors=query_args
+        )
+        motif_indices = motif_match.motif_indices
+        assert motif_indices[-2] == 2
+        assert motif_indices[-1] == 1
+        npt.assert_array_equal(motif_indices[:-2], -1)
+        npt.assert_array_equal(motif_match.matches, motif_indices >= 0)
+        point_environments = motif_match.point_environments
+
+        # Each point matches the first motif it matches alone, with the same
+        # environment.
+        for index, motif in enumerate(motifs):
+            motif_match.compute(
+                (box, points), motif, 0.1, env_neighbors=query_args
+            )
+            npt.assert_array_equal(motif_match.matches, motif_indices == index)
+            for i in np.flatnonzero(motif_indices == index):
+                npt.assert_allclose(
+                    motif_match.point_environments[i], point_environments[i]
+                )
+
+        # The precedence of the motifs is their order.
+        motif_match.compute_motifs(
+            (box, points), [square, square], 0.1, env_neighbors=query_args
+        )
+        npt.assert_array_equal(motif_match.motif_indices[-2:], [0, -1])
+
+        with pytest.raises(ValueError):
+            motif_match.compute_motifs((box, points), [], 0.1)
+
 
 class TestEnvironmentRMSDMinimizer:
     def test_api(self):
@@ -531,3 +595,17 @@ class TestEnvironmentRMSDMinimizer:
         match.compute((box, points), motif, neighbors=query_args)
         assert np.all(match.rmsds[:-1] > 0)
         assert np.isclose(match.rmsds[-1], 0, atol=1e-6)
+
+    def test_exact_assignment(self):
+        """Exact assignment never gives a larger RMSD than greedy pairing."""
+        motif = [[1, 0, 0], [-1, 0, 0], [0, 1, 0], [0, -1, 0], [0, 0, 1], [0, 0, -1]]
+        system = freud.data.make_random_system(5, 100, seed=0)
+        query_args = dict(num_neighbors=6, exclude_ii=True)
+
+        greedy = freud.environment._EnvironmentRMSDMinimizer()
+        greedy.compute(system, motif, neighbors=query_args)
+        exact = freud.environment._EnvironmentRMSDMinimizer()
+        exact.compute(system, motif, neighbors=query_args, exact_assignment=True)
+
+        assert np.all(exact.rmsds <= greedy.rmsds + 1e-6)
+        assert np.any(exact.rmsds < greedy.rmsds - 1e-6)
@@ -2,6 +2,7 @@
 # This file is from the freud project, released under the BSD 3-Clause License.
 
 import numpy as np
+import numpy.testing as npt
 import pytest
 
 import freud
@@ -81,6 +82,34 @@ class TestInterface:
         assert test_twelve.point_count == 12
         assert len(test_twelve.point_ids) == 12
 
+    @pytest.mark.parametrize("num_query_points", [50, 2000])
+    @pytest.mark.parametrize(
+        "query_args",
+        [dict(r_max=1.2), dict(r_max=1.2, r_min=0.3), dict(num_neighbors=3)],
+    )
+    def test_matches_neighbor_list(self, num_query_points, query_args):
+        """Test that the interface is the set of bonded points, whichever set
+        of points is smaller."""
+        box, points = freud.data.make_random_system(10, 500, seed=0)
+        _, query_points = freud.data.make_random_system(10, num_query_points, seed=1)
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(query_points, query_args)
+            .toNeighborList()
+        )
+
+        inter = freud.interface.Interface()
+        inter.compute((box, points), query_points, neighbors=query_args)
+        npt.assert_array_equal(inter.point_ids, np.unique(nlist.point_indices))
+        npt.assert_array_equal(
+            inter.query_point_ids, np.unique(nlist.query_point_indices)
+        )
+        assert inter.point_count == len(np.unique(nlist.point_indices))
+        assert inter.query_point_count == len(np.unique(nlist.query_point_indices))
+
+        inter.compute((box, points), query_points, neighbors=nlist)
+        npt.assert_array_equal(inter.point_ids, np.unique(nlist.point_indices))
+
     def test_repr(self):
         inter = freud.interface.Interface()
         assert str(inter) == str(eval(repr(inter)))
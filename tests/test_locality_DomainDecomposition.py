@@ -0,0 +1,142 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import threading
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+class _ThreadComm:
+    """Minimal stand-in for an MPI communicator whose ranks are threads."""
+
+    def __init__(self, size):
+        self.size = size
+        self._barrier = threading.Barrier(size)
+        self._values = [None] * size
+
+    def rank_comm(self, rank):
+        comm = self
+
+        class _RankComm:
+            def allreduce(self, value):
+                comm._values[rank] = value
+                comm._barrier.wait()
+                total = sum(comm._values[1:], comm._values[0])
+                comm._barrier.wait()
+                return total
+
+        return _RankComm()
+
+    def run(self, func):
+        results = [None] * self.size
+        errors = []
+
+        def target(rank):
+            try:
+                results[rank] = func(rank, self.rank_comm(rank))
+            except Exception as e:  # pragma: no cover
+                errors.append(e)
+                self._barrier.abort()
+
+        threads = [
+            threading.Thread(target=target, args=(rank,))
+            for rank in range(self.size)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        if errors:
+            raise errors[0]
+        return results
+
+
+class TestDomainDecomposition:
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_ghosts(self, is2D):
+        box, points = freud.data.make_random_system(10, 500, is2D=is2D, seed=0)
+        domains = (3, 2, 1) if is2D else (3, 2, 2)
+        r_max = 1.5
+        dd = freud.locality.DomainDecomposition(domains, r_max)
+        dd.compute((box, points))
+        assert dd.num_domains == np.prod(domains)
+        assert dd.domains == domains
+        assert np.all(np.diff(dd.ghost_domains.astype(np.int64)) >= 0)
+        npt.assert_equal(
+            np.bincount(dd.ghost_domains, minlength=dd.num_domains),
+            dd.ghost_counts,
+        )
+
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, {"r_max": r_max, "exclude_ii": True})
+            .toNeighborList()
+        )
+        for domain in range(dd.num_domains):
+            owned, ghosts = dd.domain_indices(domain)
+            npt.assert_equal(dd.point_domains[owned], domain)
+            assert not np.any(dd.point_domains[ghosts] == domain)
+            held = np.zeros(len(points), dtype=bool)
+            held[owned] = True
+            held[ghosts] = True
+            bonds = np.isin(nlist.query_point_indices, owned)
+            assert np.all(held[nlist.point_indices[bonds]])
+
+    def test_invalid(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        with pytest.raises(ValueError):
+            freud.locality.DomainDecomposition((0, 1, 1), 1)
+        with pytest.raises(ValueError):
+            freud.locality.DomainDecomposition((2, 2, 2), -1)
+        with pytest.raises(ValueError):
+            freud.locality.DomainDecomposition((4, 1, 1), 3).compute((box, points))
+        box2D, points2D = freud.data.make_random_system(10, 100, is2D=True)
+        with pytest.raises(ValueError):
+            freud.locality.DomainDecomposition((1, 1, 2), 1).compute(
+                (box2D, points2D)
+            )
+
+    def test_rdf(self):
+        box, points = freud.data.make_random_system(10, 1000, seed=1)
+        r_max = 2.5
+        dd = freud.locality.DomainDecomposition((2, 2, 1), r_max)
+        dd.compute((box, points))
+        rdf = freud.density.RDF(bins=25, r_max=r_max).compute((box, points))
+
+        def compute_domain(rank, comm):
+            owned, ghosts = dd.domain_indices(rank)
+            local_rdf = freud.density.RDF(bins=25, r_max=r_max)
+            local_rdf.compute(
+                (box, points[np.concatenate((owned, ghosts))]),
+                query_points=points[owned],
+                neighbors={"r_max": r_max, "exclude_ii": True},
+            )
+            return local_rdf.reduce_domains(comm)
+
+        for local_rdf in _ThreadComm(dd.num_domains).run(compute_domain):
+            npt.assert_equal(local_rdf.bin_counts, rdf.bin_counts)
+            npt.assert_allclose(local_rdf.rdf, rdf.rdf, rtol=1e-6)
+            npt.assert_allclose(local_rdf.n_r, rdf.n_r, rtol=1e-6)
+
+    def test_static_structure_factor(self):
+        box, points = freud.data.make_random_system(10, 1000, seed=2)
+        dd = freud.locality.DomainDecomposition((2, 2, 2), 0)
+        dd.compute((box, points))
+        sf = freud.diffraction.StaticStructureFactorDirect(
+            bins=20, k_max=8, num_sampled_k_points=2000
+        ).compute((box, points))
+
+        def compute_domain(rank, comm):
+            owned, _ = dd.domain_indices(rank)
+            local_sf = freud.diffraction.StaticStructureFactorDirect(
+                bins=20, k_max=8, num_sampled_k_points=2000
+            )
+            return local_sf.compute((box, points[owned]), comm=comm)
+
+        for local_sf in _ThreadComm(dd.num_domains).run(compute_domain):
+            npt.assert_allclose(local_sf.k_points, sf.k_points)
+            npt.assert_allclose(local_sf.S_k, sf.S_k, rtol=1e-4, atol=1e-4)
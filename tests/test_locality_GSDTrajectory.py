@@ -0,0 +1,107 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import gsd
+import gsd.hoomd
+import numpy as np
+import numpy.testing as npt
+import pytest
+from packaging import version
+
+import freud
+
+try:
+    GSD_VERSION = gsd.version.__version__
+except AttributeError:
+    GSD_VERSION = gsd.version.version
+
+
+def _write_trajectory(filename, num_frames=6, num_points=200, L=10):
+    """Write a random walk in a periodic box, returning the box and the
+    unwrapped positions of each frame."""
+    np.random.seed(0)
+    box = freud.box.Box.cube(L)
+    unwrapped = np.cumsum(
+        np.random.normal(scale=0.5, size=(num_frames, num_points, 3)), axis=0
+    ).astype(np.float32)
+    unwrapped += np.random.uniform(-L / 2, L / 2, size=(1, num_points, 3))
+    new_api = version.parse(GSD_VERSION) >= version.parse("2.9.0")
+    with gsd.hoomd.open(filename, mode="w" if new_api else "wb") as traj:
+        for frame_unwrapped in unwrapped:
+            frame = gsd.hoomd.Frame() if new_api else gsd.hoomd.Snapshot()
+            frame.configuration.box = [L, L, L, 0, 0, 0]
+            frame.particles.N = num_points
+            frame.particles.position = box.wrap(frame_unwrapped)
+            frame.particles.image = box.get_images(frame_unwrapped)
+            traj.append(frame)
+    return box, unwrapped
+
+
+class TestGSDTrajectory:
+    @pytest.fixture
+    def trajectory(self, tmp_path):
+        filename = str(tmp_path / "trajectory.gsd")
+        box, unwrapped = _write_trajectory(filename)
+        return freud.locality.GSDTrajectory(filename), box, unwrapped
+
+    def test_frames(self, trajectory):
+        traj, box, unwrapped = trajectory
+        assert len(traj) == len(unwrapped)
+        for i, (frame_box, points) in enumerate(traj):
+            assert frame_box == box
+            npt.assert_allclose(points, box.wrap(unwrapped[i]), atol=1e-5)
+
+        frame_box, points = traj[-1]
+        npt.assert_allclose(points, box.wrap(unwrapped[-1]), atol=1e-5)
+        with pytest.raises(IndexError):
+            traj[len(unwrapped)]
+
+        view = traj[1::2]
+        assert len(view) == 3
+        assert (view.first, view.last, view.stride) == (1, 6, 2)
+        npt.assert_allclose(view[1][1], box.wrap(unwrapped[3]), atol=1e-5)
+        assert len(view[1:]) == 2
+        assert len(traj[4:2]) == 0
+
+    def test_invalid_file(self, tmp_path):
+        with pytest.raises(RuntimeError):
+            freud.locality.GSDTrajectory(str(tmp_path / "missing.gsd"))
+        filename = tmp_path / "invalid.gsd"
+        filename.write_bytes(b"\0" * 512)
+        with pytest.raises(RuntimeError):
+            freud.locality.GSDTrajectory(str(filename))
+
+    def test_rdf(self, trajectory):
+        traj, _, _ = trajectory
+        rdf = freud.density.RDF(bins=20, r_max=3)
+        rdf.compute_frames(list(traj[::2]))
+        rdf_stream = freud.density.RDF(bins=20, r_max=3)
+        rdf_stream.compute_frames(traj[::2])
+        npt.assert_equal(rdf_stream.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(rdf_stream.rdf, rdf.rdf)
+
+        box, points = traj[0]
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, {"r_max": 3})
+            .toNeighborList()
+        )
+        with pytest.raises(ValueError):
+            rdf_stream.compute_frames(traj, neighbors=nlist)
+
+    def test_static_structure_factor(self, trajectory):
+        traj, _, _ = trajectory
+        sf = freud.diffraction.StaticStructureFactorDirect(bins=20, k_max=5)
+        sf.compute_frames(list(traj))
+        sf_stream = freud.diffraction.StaticStructureFactorDirect(bins=20, k_max=5)
+        sf_stream.compute_frames(traj)
+        npt.assert_allclose(sf_stream.S_k, sf.S_k, rtol=1e-5)
+
+    def test_streaming_msd(self, trajectory):
+        traj, box, unwrapped = trajectory
+        msd = freud.msd.StreamingMSD()
+        msd.compute(unwrapped)
+        msd_stream = freud.msd.StreamingMSD()
+        msd_stream.compute(traj)
+        npt.assert_equal(msd_stream.lags, msd.lags)
+        npt.assert_allclose(msd_stream.msd, msd.msd, rtol=1e-4, atol=1e-4)
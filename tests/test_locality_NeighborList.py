@@ -128,6 +128,22 @@ class TestNeighborList:
         # should be able to further filter
         self.nlist.filter_r(2.5)
 
+    def test_filter_held_arrays(self):
+        # Filtering must not modify arrays obtained before the filter, whether
+        # the bonds are compacted in place or copied
+        nlist = self.nq.query(self.nq.points, self.query_args).toNeighborList()
+        distances = nlist.distances
+        expected_distances = np.copy(distances)
+        filt = np.arange(len(nlist)) % 3 != 0
+        nlist.filter(filt)
+        self.nlist.filter(filt)
+        npt.assert_equal(distances, expected_distances)
+        npt.assert_equal(nlist.distances, expected_distances[filt])
+        npt.assert_equal(nlist, self.nlist)
+
+        with pytest.raises(ValueError):
+            nlist.filter(np.ones(len(nlist) - 1, dtype=bool))
+
     def test_find_first_index(self):
         nlist = self.nlist
         for idx, i in enumerate(nlist.query_point_indices):
@@ -217,6 +233,50 @@ class TestNeighborList:
                 4, 4, query_point_indices, point_indices, vectors, weights[:-1]
             )
 
+    def test_from_arrays_no_copy(self):
+        bonds = np.array([[0, 1], [0, 2], [1, 3], [2, 0], [3, 0]], dtype=np.uint32)
+        vectors = np.random.rand(len(bonds), 3).astype(np.float32)
+        weights = np.random.rand(len(bonds)).astype(np.float32)
+        nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, bonds[:, 0], bonds[:, 1], vectors, weights, copy=False
+        )
+
+        # The NeighborList is a view of the arrays, which it keeps alive.
+        assert np.shares_memory(nlist[:], bonds)
+        assert np.shares_memory(nlist.vectors, vectors)
+        assert np.shares_memory(nlist.weights, weights)
+        expected_bonds = bonds.copy()
+        del bonds, vectors, weights
+        npt.assert_equal(nlist[:], expected_bonds)
+
+        # Distances are computed from the vectors.
+        npt.assert_allclose(
+            nlist.distances, np.linalg.norm(nlist.vectors, axis=-1), rtol=1e-6
+        )
+        npt.assert_equal(nlist.neighbor_counts, [2, 1, 1, 1])
+
+        # Sorting does not modify the borrowed arrays.
+        vectors = np.ones((len(expected_bonds), 3), dtype=np.float32)
+        vectors[0] *= 2
+        bonds = expected_bonds.copy()
+        nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, bonds[:, 0], bonds[:, 1], vectors, copy=False
+        )
+        nlist.sort(by_distance=True)
+        npt.assert_equal(bonds, expected_bonds)
+        npt.assert_allclose(nlist.distances[-1], 2 * np.sqrt(3), rtol=1e-6)
+        npt.assert_allclose(nlist.weights, 1)
+
+        # Separate index arrays are interleaved, and errors are still raised.
+        nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, list(bonds[:, 0]), list(bonds[:, 1]), vectors, copy=False
+        )
+        npt.assert_equal(nlist[:], expected_bonds)
+        with pytest.raises(ValueError):
+            freud.locality.NeighborList.from_arrays(
+                4, 4, bonds[:, 1], bonds[:, 0], vectors, copy=False
+            )
+
     def test_all_pairs(self):
         N = 100
         L = 10
@@ -357,3 +417,26 @@ class TestNeighborList:
         npt.assert_allclose(nlist.query_point_indices, qp_indices)
         npt.assert_allclose(nlist.point_indices, np.array([1, 3, 0, 2]))
         npt.assert_allclose(nlist.distances, np.array([1, 2, 3, 4]))
+
+    def test_sort_random(self):
+        # Enough bonds to sort in several blocks, with repeated distances
+        np.random.seed(0)
+        num_bonds = 100000
+        qp_indices = np.sort(np.random.randint(0, 1000, num_bonds))
+        point_indices = np.random.randint(0, 1000, num_bonds)
+        vecs = np.zeros((num_bonds, 3), dtype=np.float32)
+        vecs[:, 0] = np.random.randint(1, 20, num_bonds) / 4
+        nlist = freud.locality.NeighborList.from_arrays(
+            1000, 1000, qp_indices, point_indices, vecs
+        )
+
+        nlist.sort()
+        order = np.lexsort((vecs[:, 0], point_indices, qp_indices))
+        npt.assert_equal(nlist.point_indices, point_indices[order])
+        npt.assert_equal(nlist.vectors, vecs[order])
+
+        nlist.sort(by_distance=True)
+        order = np.lexsort((point_indices, vecs[:, 0], qp_indices))
+        npt.assert_equal(nlist.query_point_indices, qp_indices[order])
+        npt.assert_equal(nlist.distances, vecs[order, 0])
+        npt.assert_equal(nlist.point_indices, point_indices[order])
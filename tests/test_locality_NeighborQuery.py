@@ -334,6 +334,63 @@ class NeighborQueryTest:
 
         npt.assert_equal(set(result_list), set(list_nlist))
 
+    @pytest.mark.parametrize("chunk_size", [1, 100, 10**6])
+    def test_query_chunks(self, chunk_size):
+        """Test that the chunks of a query hold the bonds of its NeighborList."""
+        L = 10
+        N = 400
+
+        box, ref_points = freud.data.make_random_system(L, N, seed=0)
+        _, points = freud.data.make_random_system(L, N, seed=1)
+        nq = self.build_query_object(box, ref_points, L / 10)
+
+        for query_args in [
+            dict(mode="ball", r_max=2),
+            dict(mode="nearest", num_neighbors=6),
+        ]:
+            result = nq.query(points, query_args)
+            chunks = list(result.chunks(chunk_size))
+            assert all(len(chunk[0]) <= chunk_size for chunk in chunks)
+            query_point_indices, point_indices, distances = (
+                np.concatenate(column) for column in zip(*chunks)
+            )
+            nlist = result.toNeighborList()
+            npt.assert_equal(query_point_indices, nlist.query_point_indices)
+            npt.assert_equal(point_indices, nlist.point_indices)
+            npt.assert_allclose(distances, nlist.distances)
+
+        with pytest.raises(ValueError):
+            next(nq.query(points, dict(r_max=2)).chunks(0))
+
+    @pytest.mark.parametrize(
+        "columns", [(), ("vectors",), ("distances",), ("weights",), None]
+    )
+    def test_query_to_nlist_columns(self, columns):
+        """Test that columns that are not stored are computed on access."""
+        L = 10
+        N = 400
+
+        box, ref_points = freud.data.make_random_system(L, N, seed=0)
+        _, points = freud.data.make_random_system(L, N, seed=1)
+        nq = self.build_query_object(box, ref_points, L / 10)
+        query_args = dict(mode="ball", r_max=2)
+
+        nlist = nq.query(points, query_args).toNeighborList()
+        lazy_nlist = nq.query(points, query_args).toNeighborList(columns=columns)
+        npt.assert_equal(lazy_nlist[:], nlist[:])
+        npt.assert_allclose(lazy_nlist.vectors, nlist.vectors, atol=1e-6)
+        npt.assert_allclose(lazy_nlist.distances, nlist.distances, atol=1e-6)
+        npt.assert_equal(lazy_nlist.weights, nlist.weights)
+
+        # Filtering keeps the columns that are computed later consistent.
+        lazy_nlist = nq.query(points, query_args).toNeighborList(columns=columns)
+        lazy_nlist.filter_r(1.5)
+        nlist.filter_r(1.5)
+        npt.assert_allclose(lazy_nlist.vectors, nlist.vectors, atol=1e-6)
+
+        with pytest.raises(ValueError):
+            nq.query(points, query_args).toNeighborList(columns=("angles",))
+
     def test_reciprocal(self):
         """Test that, for a random set of points, for each (i, j) neighbor
         pair there also exists a (j, i) neighbor pair for one set of points"""
@@ -348,6 +405,55 @@ class NeighborQueryTest:
 
         assert ij == ji
 
+    def test_half_list(self):
+        """Test that half lists find each pair of points once, and that
+        computes accepting them count both directions of each pair."""
+        L, r_max, N = (10, 2.01, 1024)
+
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        nq = self.build_query_object(box, points, r_max)
+        query_args = dict(mode="ball", r_max=r_max, exclude_ii=True)
+        half_args = dict(query_args, half_list=True)
+
+        nlist = nq.query(points, query_args).toNeighborList(sort_by_distance=True)
+        half_nlist = nq.query(points, half_args).toNeighborList()
+        assert np.all(half_nlist.query_point_indices < half_nlist.point_indices)
+        ij = {(i, j) for (i, j) in nlist[:]}
+        half_ij = {(i, j) for (i, j) in half_nlist[:]}
+        assert half_ij == {(i, j) for (i, j) in ij if i < j}
+
+        rdf = freud.density.RDF(bins=20, r_max=r_max).compute(nq, neighbors=query_args)
+        half_rdf = freud.density.RDF(bins=20, r_max=r_max).compute(
+            nq, neighbors=half_args
+        )
+        npt.assert_equal(half_rdf.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(half_rdf.rdf, rdf.rdf)
+
+        with pytest.raises(RuntimeError):
+            nq.query(points, dict(num_neighbors=4, half_list=True)).toNeighborList()
+        with pytest.raises(ValueError):
+            nq.query(points[:10], half_args).toNeighborList()
+
+        # Query points with the same length as the points are not enough.
+        _, other_points = freud.data.make_random_system(L, N, seed=1)
+        with pytest.raises(ValueError):
+            nq.query(other_points, half_args).toNeighborList()
+        nq.query(points.copy(), half_args).toNeighborList()
+
+        # Computes cannot mirror the bonds onto separate query data.
+        with pytest.raises(ValueError):
+            freud.density.RDF(bins=20, r_max=r_max).compute(
+                nq, query_points=other_points, neighbors=half_args
+            )
+        orientations = np.zeros(N)
+        with pytest.raises(ValueError):
+            freud.pmft.PMFTR12(r_max=r_max, bins=4).compute(
+                (freud.box.Box.square(L), points * [1, 1, 0]),
+                orientations,
+                query_orientations=orientations + 1,
+                neighbors=half_args,
+            )
+
     def test_reciprocal_twoset(self):
         """Test that, for a random set of points, for each (i, j) neighbor
         pair there also exists a (j, i) neighbor pair for two sets of
@@ -417,6 +523,59 @@ class NeighborQueryTest:
         assert exhaustive_ijs == ijs
         assert exhaustive_counts_list == counts_list
 
+    def test_update_points(self):
+        L, r_max, N = (10, 1.5, 500)
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        nq = self.build_query_object(box, points, r_max)
+        query_args = dict(mode="ball", r_max=r_max, exclude_ii=True)
+        np.random.seed(0)
+        for frame in range(6):
+            if frame == 3:
+                # Random points require partitioning the points again.
+                _, points = freud.data.make_random_system(L, N, seed=frame)
+            elif frame == 4:
+                # Changing the number of points or the box.
+                _, points = freud.data.make_random_system(L + 1, N // 2, seed=frame)
+                box = freud.box.Box.cube(L + 1)
+            else:
+                # Small displacements crossing the periodic boundaries.
+                points = box.wrap(
+                    points + np.random.normal(scale=0.1, size=points.shape)
+                )
+            assert nq.update_points(points, box if frame == 4 else None) is nq
+            assert nq.box == box
+            npt.assert_equal(nq.points, points)
+            reference = self.build_query_object(box, points, r_max)
+            assert nlist_equal(
+                nq.query(points, query_args).toNeighborList()[:],
+                reference.query(points, query_args).toNeighborList()[:],
+            )
+
+        with pytest.raises(ValueError):
+            nq.update_points(np.zeros((0, 3)))
+        with pytest.raises(ValueError):
+            nq.update_points(points, freud.box.Box.square(L + 1))
+        npt.assert_equal(nq.points, points)
+
+    def test_neighbor_lists(self):
+        L, N = (10, 500)
+        r_maxs = [1.2, 2.5, 1.5]
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        nq = self.build_query_object(box, points, max(r_maxs))
+        query_args = dict(mode="ball", r_max=3, exclude_ii=True)
+        nlists = nq.query(points, query_args).toNeighborLists(r_maxs)
+        assert len(nlists) == len(r_maxs)
+        for r_max, nlist in zip(r_maxs, nlists):
+            query_args["r_max"] = r_max
+            reference = nq.query(points, query_args).toNeighborList()
+            npt.assert_equal(nlist[:], reference[:])
+            npt.assert_allclose(nlist.distances, reference.distances)
+
+        with pytest.raises(ValueError):
+            nq.query(points, query_args).toNeighborLists([])
+        with pytest.raises(ValueError):
+            nq.query(points, query_args).toNeighborLists([1, -1])
+
     @pytest.mark.parametrize("seed", range(10))
     def test_exhaustive_search_asymmetric(self, seed):
         L, r_max, N = (10, 1.999, 32)
@@ -603,15 +762,36 @@ class TestNeighborQueryAABB(NeighborQueryTest):
     def build_query_object(cls, box, ref_points, r_max=None):
         return freud.locality.AABBQuery(box, ref_points)
 
-    def test_too_large_r_max_raises(self):
-        """Test that specifying too large an r_max value raises an error."""
-        L = 5
-
-        box = freud.box.Box.square(L)
-        points = [[0, 0, 0], [1, 1, 0], [1, -1, 0]]
+    @pytest.mark.parametrize("is2D", [True, False])
+    def test_r_max_beyond_half_box(self, is2D):
+        """Test that r_max larger than the box finds all periodic images."""
+        L = 3
+        r_max = 2.2 * L
+        box, points = freud.data.make_random_system(L, 10, is2D=is2D, seed=0)
         aq = freud.locality.AABBQuery(box, points)
-        with pytest.raises(RuntimeError):
-            list(aq.query(points, dict(r_max=L)))
+        nlist = aq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+
+        # Find the bonds to every periodic image within r_max by brute force.
+        shells = range(-3, 4)
+        images = np.unique(
+            [[i, j, 0 if is2D else k] for i in shells for j in shells for k in shells],
+            axis=0,
+        )
+        image_vectors = images @ box.to_matrix().T
+        expected = []
+        for i, point in enumerate(points):
+            deltas = points[np.newaxis, :, :] + image_vectors[:, np.newaxis, :] - point
+            distances = np.linalg.norm(deltas, axis=-1)
+            distances[np.all(images == 0, axis=1), i] = np.inf
+            expected.extend(distances[distances < r_max])
+        npt.assert_allclose(
+            np.sort(nlist.distances), np.sort(expected), rtol=1e-5, atol=1e-5
+        )
+
+        half_nlist = aq.query(
+            points, dict(r_max=r_max, exclude_ii=True, half_list=True)
+        ).toNeighborList()
+        assert 2 * len(half_nlist) == len(nlist)
 
     def test_chaining(self):
         N = 500
@@ -654,6 +834,45 @@ class TestNeighborQueryAABB(NeighborQueryTest):
         else:
             original_nlist = nlist
 
+    @pytest.mark.parametrize("exclude_ii", [True, False])
+    def test_query_nearest_dense(self, exclude_ii):
+        """Test that the dense nearest neighbor query matches the bonds of a
+        nearest neighbor query."""
+        N = 200
+        L = 10
+        k = 8
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+        query_args = dict(num_neighbors=k, exclude_ii=exclude_ii)
+
+        point_indices, distances = aq.query_nearest(points, query_args)
+        assert point_indices.shape == (N, k)
+        assert distances.shape == (N, k)
+        assert np.all(np.diff(distances, axis=1) >= 0)
+
+        nlist = aq.query(points, query_args).toNeighborList()
+        for i in range(N):
+            bonds = nlist.query_point_indices == i
+            npt.assert_allclose(
+                distances[i], np.sort(nlist.distances[bonds]), rtol=1e-6
+            )
+            assert set(point_indices[i]) == set(nlist.point_indices[bonds])
+
+    def test_query_nearest_dense_missing(self):
+        """Test the padding of rows with fewer than num_neighbors neighbors."""
+        box = freud.box.Box.cube(10)
+        points = [[0, 0, 0], [1, 0, 0], [0, 2, 0]]
+        aq = freud.locality.AABBQuery(box, points)
+        point_indices, distances = aq.query_nearest(
+            points, dict(num_neighbors=3, exclude_ii=True)
+        )
+        npt.assert_equal(point_indices[:, :2], [[1, 2], [0, 2], [0, 1]])
+        npt.assert_allclose(
+            distances[:, :2], [[1, 2], [1, np.sqrt(5)], [2, np.sqrt(5)]], rtol=1e-6
+        )
+        npt.assert_equal(point_indices[:, 2], len(points))
+        assert np.all(np.isinf(distances[:, 2]))
+
 
 class TestNeighborQueryLinkCell(NeighborQueryTest):
     @classmethod
@@ -691,6 +910,26 @@ class TestNeighborQueryLinkCell(NeighborQueryTest):
         nlist2 = lc.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
         assert nlist_equal(nlist1, nlist2)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_inhomogeneous(self, is2D):
+        """Check queries of dense cells, whose points are split into blocks."""
+        L = 12
+        box = freud.box.Box.square(L) if is2D else freud.box.Box.cube(L)
+        np.random.seed(0)
+        # A dense slab in a dilute vapor
+        points = np.random.uniform(-L / 2, L / 2, (2500, 3)).astype(np.float32)
+        points[:2000, 1] /= 6
+        if is2D:
+            points[:, 2] = 0
+        query_args = dict(r_max=0.4, exclude_ii=True)
+        for cell_width in (0.5, 2.5):
+            lc = freud.locality.LinkCell(box, points, cell_width)
+            aq = freud.locality.AABBQuery(box, points)
+            assert nlist_equal(
+                lc.query(points, query_args).toNeighborList(),
+                aq.query(points, query_args).toNeighborList(),
+            )
+
 
 class TestMultipleMethods:
     """Check that different methods of making a NeighborList give the same
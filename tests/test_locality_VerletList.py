@@ -0,0 +1,70 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+def _sorted_bonds(nlist):
+    return sorted(map(tuple, nlist[:]))
+
+
+class TestVerletList:
+    def test_matches_query(self):
+        L, N, r_max = 10, 200, 1.5
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        vl = freud.locality.VerletList(r_max, skin=0.4)
+        vl.compute((box, points))
+        assert vl.rebuilt
+        assert vl.num_rebuilds == 1
+
+        nq = freud.AABBQuery(box, points)
+        ref = nq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+        assert _sorted_bonds(vl.nlist) == _sorted_bonds(ref)
+
+    def test_reuse_and_rebuild(self):
+        L, N, r_max, skin = 10, 200, 1.5, 0.4
+        box, points = freud.data.make_random_system(L, N, seed=1)
+        vl = freud.locality.VerletList(r_max, skin)
+        vl.compute((box, points))
+
+        # Small displacements reuse the cached candidate bonds.
+        rng = np.random.default_rng(2)
+        moved = box.wrap(points + rng.uniform(-0.1, 0.1, points.shape))
+        vl.compute((box, moved))
+        assert not vl.rebuilt
+        assert vl.num_rebuilds == 1
+        nq = freud.AABBQuery(box, moved)
+        ref = nq.query(moved, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+        assert _sorted_bonds(vl.nlist) == _sorted_bonds(ref)
+        npt.assert_allclose(
+            np.sort(vl.nlist.distances), np.sort(ref.distances), rtol=1e-5
+        )
+
+        # Moving a single point beyond half the skin forces a rebuild.
+        moved[0] += [0.3, 0, 0]
+        moved = box.wrap(moved)
+        vl.compute((box, moved))
+        assert vl.rebuilt
+        assert vl.num_rebuilds == 2
+
+        # Changing the box forces a rebuild.
+        vl.compute((freud.box.Box.cube(L + 1), moved))
+        assert vl.rebuilt
+
+        vl.reset()
+        vl.compute((freud.box.Box.cube(L + 1), moved))
+        assert vl.rebuilt
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            freud.locality.VerletList(0, 0.1)
+        with pytest.raises(ValueError):
+            freud.locality.VerletList(1, -0.1)
+
+    def test_repr(self):
+        vl = freud.locality.VerletList(1.5, 0.25)
+        assert str(vl) == str(eval(repr(vl)))
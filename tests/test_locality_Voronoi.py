@@ -325,9 +325,27 @@ class TestVoronoi:
         nlist = vor.nlist
         assert not np.any(np.all(np.isclose(nlist.vectors, [0, 0, 0]), axis=-1))
 
+    @pytest.mark.parametrize("is2D", [True, False])
+    def test_without_polytopes(self, is2D):
+        """Check that skipping the polytopes leaves the other outputs unchanged."""
+        box, points = freud.data.make_random_system(10, 1000, is2D=is2D, seed=32)
+        vor = freud.locality.Voronoi().compute((box, points))
+        light = freud.locality.Voronoi(compute_polytopes=False).compute((box, points))
+
+        assert vor.compute_polytopes
+        assert not light.compute_polytopes
+        with pytest.raises(AttributeError):
+            light.polytopes
+        npt.assert_allclose(light.volumes, vor.volumes)
+        npt.assert_array_equal(light.nlist[:], vor.nlist[:])
+        npt.assert_allclose(light.nlist.weights, vor.nlist.weights)
+        npt.assert_allclose(light.nlist.vectors, vor.nlist.vectors)
+
     def test_repr(self):
         vor = freud.locality.Voronoi()
         assert str(vor) == str(eval(repr(vor)))
+        vor = freud.locality.Voronoi(compute_polytopes=False)
+        assert str(vor) == str(eval(repr(vor)))
 
     def test_attributes(self):
         # Test that the class attributes are protected
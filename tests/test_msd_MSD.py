@@ -81,6 +81,14 @@ class TestMSD:
             npt.assert_allclose(solution, simple, atol=1e-6)
             npt.assert_allclose(solution_particle, simple_particle, atol=1e-5)
 
+    @pytest.mark.parametrize("mode", ["window", "direct"])
+    def test_double_precision(self, mode):
+        np.random.seed(0)
+        positions = np.random.rand(20, 5, 3).astype(np.float32) * 100
+        msd = freud.msd.MSD(mode=mode).compute(positions)
+        assert msd.msd.dtype == np.float64
+        assert msd.particle_msd.dtype == np.float64
+
     def test_repr(self):
         msd = freud.msd.MSD()
         assert str(msd) == str(eval(repr(msd)))
@@ -0,0 +1,113 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import matplotlib
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+matplotlib.use("agg")
+
+
+class TestStreamingMSD:
+    def test_attribute_access(self):
+        msd = freud.msd.StreamingMSD()
+        assert msd.points_per_level == 16
+        assert msd.level_factor == 2
+        with pytest.raises(AttributeError):
+            msd.msd
+        with pytest.raises(AttributeError):
+            msd.lags
+        with pytest.raises(AttributeError):
+            msd.plot()
+        assert msd._repr_png_() is None
+
+        msd.compute(np.zeros((10, 3)))
+        assert msd.num_frames == 1
+        npt.assert_equal(msd.lags, [0])
+        npt.assert_equal(msd.msd, [0])
+        npt.assert_equal(msd.counts, [1])
+        msd.box
+        msd._repr_png_()
+
+    def test_invalid_arguments(self):
+        with pytest.raises(ValueError):
+            freud.msd.StreamingMSD(level_factor=1)
+        with pytest.raises(ValueError):
+            freud.msd.StreamingMSD(points_per_level=2, level_factor=2)
+
+        msd = freud.msd.StreamingMSD()
+        msd.compute(np.zeros((10, 3)))
+        with pytest.raises(ValueError):
+            msd.compute(np.zeros((5, 3)), reset=False)
+
+    def test_short_lags_match_window_mode(self):
+        """Lags below points_per_level average over all time origins."""
+        np.random.seed(0)
+        positions = np.cumsum(np.random.normal(size=(12, 20, 3)), axis=0)
+        window = freud.msd.MSD().compute(positions).msd
+
+        msd = freud.msd.StreamingMSD(points_per_level=16)
+        for frame in positions:
+            msd.compute(frame, reset=False)
+        npt.assert_equal(msd.lags, np.arange(12))
+        npt.assert_allclose(msd.msd, window, rtol=1e-5, atol=1e-5)
+        npt.assert_equal(msd.counts, [12] + list(range(11, 0, -1)))
+
+    def test_multiple_tau(self):
+        """Compare long lags against displacements of the coarse origins."""
+        np.random.seed(1)
+        num_frames = 200
+        positions = np.cumsum(np.random.normal(size=(num_frames, 10, 3)), axis=0)
+        points_per_level = 4
+        level_factor = 2
+
+        msd = freud.msd.StreamingMSD(
+            points_per_level=points_per_level, level_factor=level_factor
+        )
+        # Frames may be provided in chunks.
+        msd.compute(positions[:50])
+        msd.compute(positions[50:], reset=False)
+        assert msd.num_frames == num_frames
+        assert np.all(np.diff(msd.lags) > 0)
+
+        spacing = 1
+        j_min = 1
+        expected_lags = [0]
+        expected_msd = [0]
+        while j_min * spacing < num_frames:
+            origins = positions[::spacing]
+            for j in range(j_min, points_per_level):
+                if j >= len(origins):
+                    break
+                expected_lags.append(j * spacing)
+                displacements = origins[j:] - origins[:-j]
+                expected_msd.append(np.mean(np.sum(displacements**2, axis=-1)))
+            spacing *= level_factor
+            j_min = (points_per_level - 1) // level_factor + 1
+        npt.assert_equal(msd.lags, expected_lags)
+        npt.assert_allclose(msd.msd, expected_msd, rtol=1e-5)
+
+    def test_unwrap(self):
+        box = freud.box.Box.cube(10)
+        np.random.seed(2)
+        unwrapped = np.cumsum(np.random.normal(size=(20, 5, 3)), axis=0).astype(
+            np.float32
+        )
+        images = box.get_images(unwrapped.reshape(-1, 3)).reshape(unwrapped.shape)
+        wrapped = box.wrap(unwrapped.reshape(-1, 3)).reshape(unwrapped.shape)
+
+        msd = freud.msd.StreamingMSD(box=box)
+        msd.compute(wrapped, images)
+        reference = freud.msd.StreamingMSD().compute(unwrapped)
+        npt.assert_allclose(msd.msd, reference.msd, rtol=1e-4, atol=1e-4)
+
+    def test_repr(self):
+        msd = freud.msd.StreamingMSD()
+        assert str(msd) == str(eval(repr(msd)))
+        msd2 = freud.msd.StreamingMSD(
+            box=freud.box.Box(1, 2, 3, 4, 5, 6), points_per_level=8, level_factor=4
+        )
+        assert str(msd2) == str(eval(repr(msd2)))
@@ -108,6 +108,25 @@ class TestCubatic:
             op_max, 0.2, err_msg="per particle order parameter value is too high"
         )
 
+    def test_replicates(self):
+        """Check that each replicate has its own random number stream."""
+        np.random.seed(30)
+        orientations = rowan.random.rand(100)
+
+        orders = []
+        for n_replicates in (1, 4, 16):
+            cubatic = freud.order.Cubatic(5.0, 0.001, 0.95, n_replicates, seed=7)
+            cubatic.compute(orientations)
+            repeat = freud.order.Cubatic(5.0, 0.001, 0.95, n_replicates, seed=7)
+            repeat.compute(orientations)
+            npt.assert_equal(cubatic.order, repeat.order)
+            npt.assert_equal(cubatic.orientation, repeat.orientation)
+            orders.append(cubatic.order)
+
+        # Adding replicates keeps the existing ones, so the best order found
+        # cannot decrease.
+        assert orders[0] <= orders[1] <= orders[2]
+
     def test_valid_inputs(self):
         with pytest.raises(ValueError):
             # t_initial must be greater than t_final
@@ -116,3 +116,51 @@ class TestNematicOrder:
     def test_repr(self):
         op = freud.order.Nematic()
         assert str(op) == str(eval(repr(op)))
+
+    def test_compute_frames(self):
+        np.random.seed(0)
+        orientations = np.random.normal(size=(5, 200, 3)).astype(np.float32)
+        orientations[2] = [0, 0, 1]
+
+        op = freud.order.Nematic()
+        op.compute_frames(orientations)
+        assert op.frame_order.shape == (5,)
+        assert op.frame_directors.shape == (5, 3)
+        npt.assert_allclose(op.frame_order[2], 1, rtol=1e-6)
+
+        frame_op = freud.order.Nematic()
+        for frame, frame_orientations in enumerate(orientations):
+            frame_op.compute(frame_orientations)
+            npt.assert_allclose(op.frame_order[frame], frame_op.order, rtol=1e-5)
+            npt.assert_allclose(
+                np.abs(np.dot(op.frame_directors[frame], frame_op.director)),
+                1,
+                rtol=1e-4,
+            )
+        npt.assert_allclose(op.order, frame_op.order, rtol=1e-5)
+        npt.assert_allclose(op.particle_tensor, frame_op.particle_tensor)
+        npt.assert_allclose(frame_op.frame_order, [frame_op.order])
+
+    def test_particle_order(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        np.random.seed(0)
+        orientations = np.random.normal(size=(len(points), 3))
+        neighbors = {"num_neighbors": 4, "exclude_ii": True}
+
+        op = freud.order.Nematic()
+        op.compute(orientations)
+        with pytest.raises(AttributeError):
+            op.particle_order
+        op.compute(orientations, (box, points), neighbors)
+
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, neighbors)
+            .toNeighborList()
+        )
+        for i in range(len(points)):
+            neighbor_indices = nlist.point_indices[nlist.query_point_indices == i]
+            tensor = op.particle_tensor[np.append(neighbor_indices, i)].mean(axis=0)
+            npt.assert_allclose(
+                op.particle_order[i], np.linalg.eigvalsh(tensor)[-1], atol=1e-5
+            )
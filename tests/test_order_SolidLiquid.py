@@ -74,6 +74,41 @@ class TestSolidLiquid:
             assert comp_default.cluster_sizes[0] == len(positions)
             npt.assert_array_equal(comp_default.num_connections, 12)
 
+    def test_threshold(self):
+        """Check that rethresholding matches a fresh compute."""
+        N = 1000
+        L = 10
+
+        box, positions = freud.data.make_random_system(L, N, seed=1)
+        query_args = dict(r_max=1.6, exclude_ii=True)
+
+        comp = freud.order.SolidLiquid(6, q_threshold=0.1, solid_threshold=2)
+        with pytest.raises(AttributeError):
+            comp.threshold(0.2, 3)
+        comp.compute((box, positions), neighbors=query_args)
+        ql_ij = comp.ql_ij.copy()
+
+        for q_threshold in (0.05, 0.2, 0.4):
+            for solid_threshold in (1, 3, 5):
+                comp.threshold(q_threshold, solid_threshold)
+                fresh = freud.order.SolidLiquid(
+                    6, q_threshold=q_threshold, solid_threshold=solid_threshold
+                ).compute((box, positions), neighbors=query_args)
+
+                npt.assert_allclose(comp.q_threshold, q_threshold)
+                assert comp.solid_threshold == solid_threshold
+                npt.assert_array_equal(comp.ql_ij, ql_ij)
+                npt.assert_array_equal(comp.num_connections, fresh.num_connections)
+                npt.assert_array_equal(comp.cluster_idx, fresh.cluster_idx)
+                npt.assert_array_equal(comp.cluster_sizes, fresh.cluster_sizes)
+
+        comp.threshold(solid_threshold=2)
+        assert comp.solid_threshold == 2
+        npt.assert_allclose(comp.q_threshold, 0.4)
+
+        with pytest.raises(ValueError):
+            comp.threshold(q_threshold=-1)
+
     def test_nlist_lifetime(self):
         def _get_nlist(sys):
             sl = freud.order.SolidLiquid(2, 0.5, 0.2)
@@ -0,0 +1,107 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+import rowan
+
+import freud
+
+
+def _random_walk(num_frames, num_orientations, seed):
+    """Generate a trajectory of orientations rotating by small random steps."""
+    np.random.seed(seed)
+    axes = np.random.normal(size=(num_frames, num_orientations, 3))
+    axes /= np.linalg.norm(axes, axis=-1)[..., np.newaxis]
+    angles = np.random.normal(scale=0.2, size=(num_frames, num_orientations))
+    steps = rowan.from_axis_angle(axes, angles)
+    orientations = np.empty((num_frames, num_orientations, 4))
+    orientations[0] = steps[0]
+    for frame in range(1, num_frames):
+        orientations[frame] = rowan.normalize(
+            rowan.multiply(orientations[frame - 1], steps[frame])
+        )
+    return orientations
+
+
+class TestStreamingRotationalAutocorrelation:
+    def test_attribute_access(self):
+        ra = freud.order.StreamingRotationalAutocorrelation(2)
+        assert ra.l == 2
+        assert ra.points_per_level == 16
+        assert ra.level_factor == 2
+        with pytest.raises(AttributeError):
+            ra.order
+        with pytest.raises(AttributeError):
+            ra.lags
+
+        ra.compute(rowan.random.rand(10))
+        assert ra.num_frames == 1
+        npt.assert_equal(ra.lags, [0])
+        npt.assert_allclose(ra.order, [1], rtol=1e-5)
+        npt.assert_equal(ra.counts, [1])
+
+    def test_invalid_arguments(self):
+        with pytest.raises(ValueError):
+            freud.order.StreamingRotationalAutocorrelation(3)
+        with pytest.raises(ValueError):
+            freud.order.StreamingRotationalAutocorrelation(2, level_factor=1)
+        with pytest.raises(ValueError):
+            freud.order.StreamingRotationalAutocorrelation(
+                2, points_per_level=2, level_factor=2
+            )
+
+        ra = freud.order.StreamingRotationalAutocorrelation(2)
+        ra.compute(rowan.random.rand(10))
+        with pytest.raises(ValueError):
+            ra.compute(rowan.random.rand(5), reset=False)
+
+    @pytest.mark.parametrize("sph_l", [2, 4, 6])
+    def test_matches_pairwise_compute(self, sph_l):
+        """Compare each lag against RotationalAutocorrelation of the origins."""
+        num_frames = 100
+        points_per_level = 4
+        level_factor = 2
+        orientations = _random_walk(num_frames, 20, seed=sph_l)
+
+        ra = freud.order.StreamingRotationalAutocorrelation(
+            sph_l, points_per_level=points_per_level, level_factor=level_factor
+        )
+        # Frames may be provided in chunks.
+        ra.compute(orientations[:30])
+        ra.compute(orientations[30:], reset=False)
+        assert ra.num_frames == num_frames
+
+        pairwise = freud.order.RotationalAutocorrelation(sph_l)
+        spacing = 1
+        j_min = 0
+        expected_lags = []
+        expected_order = []
+        expected_counts = []
+        while j_min * spacing < num_frames:
+            origins = orientations[::spacing]
+            for j in range(j_min, points_per_level):
+                if j >= len(origins):
+                    break
+                expected_lags.append(j * spacing)
+                expected_order.append(
+                    np.mean(
+                        [
+                            pairwise.compute(origins[k], origins[k + j]).order
+                            for k in range(len(origins) - j)
+                        ]
+                    )
+                )
+                expected_counts.append(len(origins) - j)
+            spacing *= level_factor
+            j_min = (points_per_level - 1) // level_factor + 1
+        npt.assert_equal(ra.lags, expected_lags)
+        npt.assert_allclose(ra.order, expected_order, atol=1e-5)
+        npt.assert_equal(ra.counts, expected_counts)
+
+    def test_repr(self):
+        ra = freud.order.StreamingRotationalAutocorrelation(
+            4, points_per_level=8, level_factor=4
+        )
+        assert str(ra) == str(eval(repr(ra)))
@@ -1,6 +1,11 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+import numpy as np
+import numpy.testing as npt
+import pytest
+import rowan
+
 import freud
 
 
@@ -13,6 +18,7 @@ class TestParallel:
 
     def teardown_method(self):
         freud.parallel.set_num_threads(0)
+        freud.parallel.set_thread_pinning(False)
 
     def test_set(self):
         """Test setting the number of threads."""
@@ -33,3 +39,164 @@ class TestParallel:
         # After the context manager, the number of threads should revert
         # to its previous value.
         assert freud.parallel.get_num_threads() == 1
+
+    def test_thread_pinning(self):
+        """Test that pinning threads does not change results."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        rdf = freud.density.RDF(bins=50, r_max=3)
+        rdf.compute((box, points))
+        expected = rdf.rdf
+
+        assert not freud.parallel.get_thread_pinning()
+        freud.parallel.set_thread_pinning(True)
+        assert freud.parallel.get_thread_pinning()
+        rdf.compute((box, points))
+        npt.assert_allclose(rdf.rdf, expected)
+
+        freud.parallel.set_thread_pinning(False)
+        assert not freud.parallel.get_thread_pinning()
+
+    def test_memory_budget(self):
+        """Test that computes within a small memory budget are unchanged."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        orientations = rowan.random.rand(len(points), seed=0)
+        pmft = freud.pmft.PMFTXYZ(3, 3, 3, 20)
+        sf = freud.diffraction.StaticStructureFactorDebye(50, 10)
+        gd = freud.density.GaussianDensity(32, 2, 0.5, use_fft=True)
+        aq = freud.locality.AABBQuery(box, points)
+
+        def compute():
+            nlist = aq.query(points, {"r_max": 2, "exclude_ii": True}).toNeighborList()
+            return (
+                pmft.compute((box, points), orientations).bin_counts.copy(),
+                sf.compute((box, points)).S_k.copy(),
+                gd.compute((box, points)).density.copy(),
+                nlist.distances.copy(),
+            )
+
+        expected = compute()
+        unlimited = (pmft.estimate_memory(), sf.estimate_memory(box))
+        assert freud.parallel.get_memory_budget() is None
+        try:
+            freud.parallel.set_memory_budget(1024)
+            assert freud.parallel.get_memory_budget() == 1024
+            assert pmft.estimate_memory() <= unlimited[0]
+            assert sf.estimate_memory(box) <= unlimited[1]
+            results = compute()
+        finally:
+            freud.parallel.set_memory_budget()
+        assert freud.parallel.get_memory_budget() is None
+
+        npt.assert_array_equal(results[0], expected[0])
+        npt.assert_allclose(results[1], expected[1], rtol=1e-5, atol=1e-6)
+        npt.assert_allclose(results[2], expected[2], rtol=1e-4, atol=1e-5)
+        npt.assert_allclose(results[3], expected[3], rtol=1e-5)
+        with pytest.raises(ValueError):
+            freud.parallel.set_memory_budget(0)
+
+    def test_deterministic_reductions(self):
+        """Test that deterministic reductions do not depend on the threads."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        orientations = np.random.default_rng(0).normal(size=(1000, 3))
+        orientations /= np.linalg.norm(orientations, axis=-1)[:, np.newaxis]
+
+        def compute():
+            ql = freud.order.Steinhardt([4, 6])
+            ql.compute((box, points), neighbors={"r_max": 1.5})
+            nematic = freud.order.Nematic()
+            nematic.compute(orientations)
+            return np.concatenate([ql.order, nematic.nematic_tensor.ravel()])
+
+        assert not freud.parallel.get_deterministic_reductions()
+        try:
+            freud.parallel.set_deterministic_reductions(True)
+            assert freud.parallel.get_deterministic_reductions()
+            expected = compute()
+            for num_threads in [1, 2, 3]:
+                with freud.parallel.ExecutionContext(num_threads):
+                    npt.assert_array_equal(compute(), expected)
+        finally:
+            freud.parallel.set_deterministic_reductions(False)
+        assert not freud.parallel.get_deterministic_reductions()
+
+        # Deterministic reductions only change rounding.
+        npt.assert_allclose(compute(), expected, rtol=1e-5, atol=1e-6)
+
+    def test_instruction_set(self):
+        """Test that every supported instruction set gives identical results."""
+        supported = freud.parallel.get_supported_instruction_set()
+        assert freud.parallel.get_instruction_set() in ("baseline", "avx2", "avx512")
+        names = ["baseline", "avx2", "avx512"]
+        names = names[: names.index(supported) + 1]
+
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        rdf = freud.density.RDF(bins=50, r_max=3)
+        results = []
+        try:
+            for name in names:
+                freud.parallel.set_instruction_set(name)
+                assert freud.parallel.get_instruction_set() == name
+                results.append(rdf.compute((box, points)).rdf.copy())
+            for result in results[1:]:
+                npt.assert_array_equal(result, results[0])
+
+            with pytest.raises(ValueError):
+                freud.parallel.set_instruction_set("sse")
+            if supported != "avx512":
+                with pytest.raises(ValueError):
+                    freud.parallel.set_instruction_set("avx512")
+        finally:
+            freud.parallel.set_instruction_set()
+        assert freud.parallel.get_instruction_set() == supported
+
+    def test_ExecutionContext(self):
+        """Test that computations within execution contexts are unchanged."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        rdf = freud.density.RDF(bins=50, r_max=3)
+        rdf.compute((box, points))
+        expected = rdf.rdf
+
+        with freud.parallel.ExecutionContext(2) as context:
+            assert context.num_threads == 2
+            rdf.compute((box, points))
+            npt.assert_allclose(rdf.rdf, expected)
+            # Contexts may be nested.
+            with freud.parallel.ExecutionContext(1):
+                rdf.compute((box, points))
+                npt.assert_allclose(rdf.rdf, expected)
+
+    def test_ExecutionContext_threads(self):
+        """Test execution contexts entered concurrently on several threads."""
+        import concurrent.futures
+
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        expected = freud.density.RDF(bins=50, r_max=3).compute((box, points)).rdf
+
+        def compute(num_threads):
+            with freud.parallel.ExecutionContext(num_threads):
+                return freud.density.RDF(bins=50, r_max=3).compute((box, points)).rdf
+
+        with concurrent.futures.ThreadPoolExecutor(max_workers=2) as executor:
+            results = list(executor.map(compute, [1, 2, 1, 2]))
+        for result in results:
+            npt.assert_allclose(result, expected)
+
+    def test_Profile(self):
+        """Test that profiles record the stages of computations."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        rdf = freud.density.RDF(bins=50, r_max=3)
+        with freud.parallel.Profile() as profile:
+            rdf.compute((box, points))
+            rdf.rdf
+        # Builds without profiling record nothing.
+        if profile.timers:
+            timer = profile.timers["BondHistogramCompute::accumulate"]
+            assert timer["calls"] == 1
+            assert timer["time"] >= 0
+            assert profile.counters["BondHistogramCompute::accumulate::query_points"] == 1000
+
+        # Only computations within the context are recorded.
+        with freud.parallel.Profile() as profile:
+            pass
+        assert profile.timers == {}
+        assert profile.counters == {}
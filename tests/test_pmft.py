@@ -65,6 +65,45 @@ class PMFTTestBase:
         """Create a PMFT object."""
         return cls.pmft_cls(*cls.limits, bins=cls.bins)
 
+    def make_random_orientations(self, num_points, seed):
+        np.random.seed(seed)
+        if self.ndim == 2:
+            return np.random.rand(num_points).astype(np.float32) * TWO_PI
+        return rowan.random.rand(num_points).astype(np.float32)
+
+    def test_compute_frames(self):
+        num_points = 100
+        frames = [
+            freud.data.make_random_system(
+                self.L, num_points, is2D=self.ndim == 2, seed=i
+            )
+            for i in range(3)
+        ]
+        orientations = [
+            self.make_random_orientations(num_points, seed=i) for i in range(3)
+        ]
+
+        pmft = self.make_pmft()
+        for frame, frame_orientations in zip(frames, orientations):
+            pmft.compute(frame, frame_orientations, reset=False)
+        pmft_frames = self.make_pmft()
+        pmft_frames.compute_frames(frames, orientations)
+
+        npt.assert_equal(pmft_frames.bin_counts, pmft.bin_counts)
+        npt.assert_allclose(pmft_frames._pcf, pmft._pcf)
+        assert pmft_frames.box == pmft.box
+
+    def test_compute_frames_invalid(self):
+        (box, points), orientations = self.make_two_particle_system()
+        pmft = self.make_pmft()
+        with pytest.raises(ValueError):
+            pmft.compute_frames([(box, points)] * 2, [orientations])
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, {"r_max": 1}
+        ).toNeighborList()
+        with pytest.raises(ValueError):
+            pmft.compute_frames([(box, points)], [orientations], neighbors=nlist)
+
     def test_box(self):
         (box, points), orientations = self.make_two_particle_system()
         pmft = self.make_pmft()
@@ -411,6 +450,23 @@ class TestPMFTXY(PMFT2DTestBase):
             ).astype(np.int32)
         )
 
+    def test_sampling(self):
+        box, points = freud.data.make_random_system(20, 2000, is2D=True, seed=5)
+        orientations = np.random.default_rng(5).random(len(points)) * 2 * np.pi
+        pmft = freud.pmft.PMFTXY(3, 3, 20)
+        pmft.compute((box, points), orientations)
+        assert pmft.pmft_standard_error is None
+
+        sampled = freud.pmft.PMFTXY(3, 3, 20)
+        sampled.compute((box, points), orientations, sampling={"fraction": 1})
+        npt.assert_equal(sampled.bin_counts, pmft.bin_counts)
+        npt.assert_allclose(sampled.pmft, pmft.pmft, rtol=1e-5, atol=1e-6)
+
+        sampled.compute((box, points), orientations, sampling={"fraction": 0.5})
+        error = sampled.pmft_standard_error
+        assert error.shape == pmft.pmft.shape
+        assert np.all(error[sampled.bin_counts > 0] > 0)
+
     def test_repr_png(self):
         L = 16.0
         box = freud.box.Box.square(L)
@@ -728,6 +784,26 @@ class TestPMFTXYZ(PMFTTestBase):
         npt.assert_equal(infcheck_noshift, 0)
         npt.assert_equal(infcheck_shift, 1)
 
+    def test_symmetric_equiv_orientations(self):
+        """Equivalent orientations that permute the bins give the sum of the
+        permuted bin counts of the identity."""
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        orientations = rowan.random.rand(len(points))
+        angles = np.pi / 2 * np.arange(4)
+        equiv_orientations = rowan.from_axis_angle([0, 0, 1], angles)
+
+        pmft = freud.pmft.PMFTXYZ(2, 2, 2, 10)
+        pmft.compute((box, points), orientations)
+        base_bin_counts = np.copy(pmft.bin_counts)
+
+        pmft.compute(
+            (box, points), orientations, equiv_orientations=equiv_orientations
+        )
+        expected_bin_counts = sum(
+            np.rot90(base_bin_counts, k, axes=(0, 1)) for k in range(4)
+        )
+        npt.assert_array_equal(pmft.bin_counts, expected_bin_counts)
+
     def test_query_args_nn(self):
         """Test that using nn based query args works."""
         L = 8
@@ -2,6 +2,7 @@
 # This file is from the freud project, released under the BSD 3-Clause License.
 
 from collections import namedtuple
+from concurrent.futures import ThreadPoolExecutor
 
 import numpy as np
 import numpy.testing as npt
@@ -120,3 +121,89 @@ class TestCommon:
         npt.assert_allclose(box.xz, 5, rtol=1e-6, err_msg="TiltXZFail")
         npt.assert_allclose(box.yz, 6, rtol=1e-6, err_msg="TiltYZFail")
         assert box.dimensions == 3
+
+    def test_compute_async(self):
+        frames = [freud.data.make_random_system(10, 500, seed=i) for i in range(4)]
+        rdfs = [freud.density.RDF(bins=20, r_max=3) for _ in frames]
+        futures = [rdf.compute_async(frame) for rdf, frame in zip(rdfs, frames)]
+        for future, rdf, frame in zip(futures, rdfs, frames):
+            assert future.result() is rdf
+            expected = freud.density.RDF(bins=20, r_max=3).compute(frame)
+            npt.assert_equal(rdf.bin_counts, expected.bin_counts)
+
+        with ThreadPoolExecutor(max_workers=2) as executor:
+            future = freud.density.RDF(bins=20, r_max=3).compute_async(
+                frames[0], neighbors={"r_max": 3}, executor=executor
+            )
+            npt.assert_equal(future.result().bin_counts, rdfs[0].bin_counts)
+
+        with pytest.raises(ValueError):
+            freud.density.RDF(bins=20, r_max=3).compute_async(
+                frames[0], neighbors=1
+            ).result()
+
+    def test_copy_property(self):
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        ql = freud.order.Steinhardt([4, 6])
+        with pytest.raises(AttributeError):
+            ql.copy_property("particle_order")
+
+        out = np.empty((len(points), 2), dtype=np.float32)
+        ql_out = np.empty((len(points), 2), dtype=np.float32)
+        for seed in range(3):
+            box, points = freud.data.make_random_system(10, 200, seed=seed)
+            ql.compute(
+                (box, points),
+                {"num_neighbors": 12},
+                out={"particle_order": out, "ql": ql_out},
+            )
+            npt.assert_equal(out, ql.particle_order)
+            npt.assert_equal(ql_out, ql.ql)
+
+        assert ql.copy_property("particle_order", out) is out
+        copy = ql.copy_property("particle_order")
+        npt.assert_equal(copy, out)
+        assert copy.flags.writeable
+
+        with pytest.raises(ValueError):
+            ql.copy_property("particle_order", np.empty(len(points)))
+        with pytest.raises(TypeError):
+            ql.copy_property("particle_order", out.tolist())
+
+    def test_memory_pool(self):
+        previous = freud.util.set_memory_pool_capacity(0)
+        try:
+            assert freud.util.set_memory_pool_capacity(1 << 20) == 0
+            rdf = freud.density.RDF(bins=20, r_max=3)
+            for seed in range(3):
+                rdf.compute(freud.data.make_random_system(10, 100, seed=seed))
+            freud.util.release_memory_pool()
+            with pytest.raises(ValueError):
+                freud.util.set_memory_pool_capacity(-1)
+        finally:
+            freud.util.set_memory_pool_capacity(previous)
+
+    def test_compute_out_in_place(self):
+        ql = freud.order.Steinhardt(6)
+        out = np.empty(200, dtype=np.float32)
+        address = out.ctypes.data
+        for seed in range(3):
+            system = freud.data.make_random_system(10, 200, seed=seed)
+            ql.compute(system, {"num_neighbors": 12}, out={"particle_order": out})
+            assert out.ctypes.data == address
+            assert ql.particle_order.ctypes.data == address
+            expected = freud.order.Steinhardt(6).compute(
+                system, {"num_neighbors": 12}
+            )
+            npt.assert_equal(out, expected.particle_order)
+
+        # Without out, the compute no longer writes into the array.
+        ql.compute(system, {"num_neighbors": 12})
+        assert not np.shares_memory(ql.particle_order, out)
+        npt.assert_equal(out, expected.particle_order)
+
+        # Arrays of another dtype are copied into.
+        out = np.empty(200, dtype=np.float64)
+        ql.compute(system, {"num_neighbors": 12}, out={"particle_order": out})
+        assert not np.shares_memory(ql.particle_order, out)
+        npt.assert_allclose(out, expected.particle_order)